@@ -49,6 +49,26 @@ const char* CameraDevice::kFrameNumberKey    = "FrameNumber";
 const char* CameraDevice::kAnwKey            = "Anw";
 const char* CameraDevice::kFailingPhysicalCameraId= "FailingPhysicalCameraId";
 
+namespace {
+
+// Copy result metadata into a buffer with room for the extra entries the NDK adds
+// to results, so that adding them doesn't reallocate and copy the result again.
+CameraMetadata copyResultMetadata(const CameraMetadata& metadata, size_t extraEntries,
+        size_t extraData) {
+    const camera_metadata_t* buffer = metadata.getAndLock();
+    if (buffer == nullptr) {
+        metadata.unlock(buffer);
+        return CameraMetadata();
+    }
+    CameraMetadata copy(get_camera_metadata_entry_count(buffer) + extraEntries,
+            get_camera_metadata_data_count(buffer) + extraData);
+    copy.append(buffer);
+    metadata.unlock(buffer);
+    return copy;
+}
+
+} // anonymous namespace
+
 /**
  * CameraDevice Implementation
  */
@@ -1218,7 +1238,9 @@ void CameraDevice::CallbackHandler::onMessageReceived(
                         String8 physicalId8(physicalResultInfo[i].mPhysicalCameraId);
                         physicalCameraIds.push_back(physicalId8.c_str());
 
-                        CameraMetadata clone = physicalResultInfo[i].mPhysicalCameraMetadata;
+                        CameraMetadata clone = copyResultMetadata(
+                                physicalResultInfo[i].mPhysicalCameraMetadata, /*extraEntries*/1,
+                                calculate_camera_metadata_entry_data_size(TYPE_INT64, 1));
                         clone.update(ANDROID_SYNC_FRAME_NUMBER,
                                 &physicalResult->mFrameNumber, /*data_count*/1);
                         sp<ACameraMetadata> metadata =
@@ -1754,7 +1776,9 @@ CameraDevice::ServiceCallback::onResultReceived(
         return ret;
     }
 
-    CameraMetadata metadataCopy = metadata;
+    CameraMetadata metadataCopy = copyResultMetadata(metadata, /*extraEntries*/2,
+            calculate_camera_metadata_entry_data_size(TYPE_INT32, 2) +
+            calculate_camera_metadata_entry_data_size(TYPE_INT64, 1));
     metadataCopy.update(ANDROID_LENS_INFO_SHADING_MAP_SIZE, dev->mShadingMapSize, /*data_count*/2);
     metadataCopy.update(ANDROID_SYNC_FRAME_NUMBER, &frameNumber, /*data_count*/1);
 
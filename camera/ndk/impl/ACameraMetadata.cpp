@@ -83,6 +83,9 @@ ACameraMetadata::init() {
         filterDurations(ANDROID_HEIC_AVAILABLE_HEIC_STALL_DURATIONS);
         filterDurations(ANDROID_DEPTH_AVAILABLE_DYNAMIC_DEPTH_MIN_FRAME_DURATIONS);
         filterDurations(ANDROID_DEPTH_AVAILABLE_DYNAMIC_DEPTH_STALL_DURATIONS);
+        // Characteristics are looked up often and not modified after this point; keep them
+        // sorted so that lookups use a binary search.
+        mData->sort();
     }
     // TODO: filter request/result keys
 }
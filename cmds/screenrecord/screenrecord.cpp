@@ -129,6 +129,8 @@ static uint32_t gVideoHeight = 0;
 static uint32_t gBitRate = 20000000;     // 20Mbps
 static uint32_t gTimeLimitSec = kMaxTimeLimitSec;
 static uint32_t gBframes = 0;
+static float gMaxFps = 0.0f;            // max frame rate fed to the encoder, 0 for no limit
+static bool gWantStats = false;         // report performance counters on stderr
 static std::optional<PhysicalDisplayId> gPhysicalDisplayId;
 // Set by signal handler to stop recording.
 static volatile bool gStopRequested = false;
@@ -252,6 +254,13 @@ static status_t prepareEncoder(float displayFps, sp<MediaCodec>* pCodec,
             displayFps = perfPointValue;
         }
     }
+    if (gMaxFps > 0.0f) {
+        // Frames beyond the limit are dropped before they reach the encoder.
+        format->setFloat(KEY_MAX_FPS_TO_ENCODER, gMaxFps);
+        if (gMaxFps < displayFps) {
+            displayFps = gMaxFps;
+        }
+    }
     format->setFloat(KEY_FRAME_RATE, displayFps);
 
     err = codec->configure(format, NULL, NULL,
@@ -593,6 +602,11 @@ static status_t runEncoder(const sp<MediaCodec>& encoder, AMediaMuxer* muxer, FI
     int64_t endWhenNsec = startWhenNsec + seconds_to_nanoseconds(gTimeLimitSec);
     Vector<int64_t> timestampsMonotonicUs;
     bool firstFrame = true;
+    // Performance counters, reported with --stats.
+    int64_t totalLatencyUs = 0;
+    int64_t maxLatencyUs = 0;
+    int64_t totalWriteUs = 0;
+    int64_t maxWriteUs = 0;
 
     assert((rawFp == NULL && muxer != NULL) || (rawFp != NULL && muxer == NULL));
 
@@ -647,9 +661,15 @@ static status_t runEncoder(const sp<MediaCodec>& encoder, AMediaMuxer* muxer, FI
                 // use the current time.  This isn't great -- we could get
                 // decoded data in clusters -- but we're not expecting
                 // to hit this anyway.
+                int64_t nowUsec = systemTime(SYSTEM_TIME_MONOTONIC) / 1000;
                 if (ptsUsec == 0) {
-                    ptsUsec = systemTime(SYSTEM_TIME_MONOTONIC) / 1000;
+                    ptsUsec = nowUsec;
                 }
+                // The virtual display timestamps the frames on the monotonic clock, so
+                // this is the time spent from composition to encoded output.
+                int64_t latencyUs = nowUsec - ptsUsec;
+                totalLatencyUs += latencyUs;
+                maxLatencyUs = std::max(maxLatencyUs, latencyUs);
 
                 if (muxer == NULL) {
                     fwrite(buffers[bufIndex]->data(), 1, size, rawFp);
@@ -659,6 +679,9 @@ static status_t runEncoder(const sp<MediaCodec>& encoder, AMediaMuxer* muxer, FI
                     if ((flags & MediaCodec::BUFFER_FLAG_CODECCONFIG) == 0) {
                         fflush(rawFp);
                     }
+                    int64_t writeUs = systemTime(SYSTEM_TIME_MONOTONIC) / 1000 - nowUsec;
+                    totalWriteUs += writeUs;
+                    maxWriteUs = std::max(maxWriteUs, writeUs);
                 } else {
                     // The MediaMuxer docs are unclear, but it appears that we
                     // need to pass either the full set of BufferInfo flags, or
@@ -683,6 +706,9 @@ static status_t runEncoder(const sp<MediaCodec>& encoder, AMediaMuxer* muxer, FI
                             "Failed writing data to muxer (err=%d)\n", err);
                         return err;
                     }
+                    int64_t writeUs = systemTime(SYSTEM_TIME_MONOTONIC) / 1000 - nowUsec;
+                    totalWriteUs += writeUs;
+                    maxWriteUs = std::max(maxWriteUs, writeUs);
                     if (gOutputFormat == FORMAT_MP4) {
                         timestampsMonotonicUs.add(ptsUsec);
                     }
@@ -757,6 +783,17 @@ static status_t runEncoder(const sp<MediaCodec>& encoder, AMediaMuxer* muxer, FI
                         systemTime(CLOCK_MONOTONIC) - startWhenNsec));
         fflush(stdout);
     }
+    if (gWantStats) {
+        // On stderr, so that it doesn't mix with the stream when writing to stdout.
+        int64_t elapsedUsec = (systemTime(CLOCK_MONOTONIC) - startWhenNsec) / 1000;
+        uint32_t numFrames = std::max(debugNumFrames, 1u);
+        fprintf(stderr, "Stats: %u frames in %.2fs (%.2f fps), "
+                "encoder latency avg %.2fms max %.2fms, write avg %.2fms max %.2fms\n",
+                debugNumFrames, elapsedUsec / 1E6,
+                elapsedUsec > 0 ? debugNumFrames * 1E6 / elapsedUsec : 0.0,
+                totalLatencyUs / 1E3 / numFrames, maxLatencyUs / 1E3,
+                totalWriteUs / 1E3 / numFrames, maxWriteUs / 1E3);
+    }
     if (metaLegacyTrackIdx >= 0 && metaTrackIdx >= 0 && !timestampsMonotonicUs.isEmpty()) {
         err = writeWinscopeMetadataLegacy(timestampsMonotonicUs, metaLegacyTrackIdx, muxer);
         if (err != NO_ERROR) {
@@ -1279,6 +1316,8 @@ int main(int argc, char* const argv[]) {
         { "persistent-surface", no_argument,        NULL, 'p' },
         { "bframes",            required_argument,  NULL, 'B' },
         { "display-id",         required_argument,  NULL, 'd' },
+        { "max-fps",            required_argument,  NULL, 'F' },
+        { "stats",              no_argument,        NULL, 'S' },
         { NULL,                 0,                  NULL, 0 }
     };
 
@@ -1398,6 +1437,16 @@ int main(int argc, char* const argv[]) {
 
             fprintf(stderr, "Invalid physical display ID\n");
             return 2;
+        case 'F':
+            gMaxFps = strtof(optarg, NULL);
+            if (!(gMaxFps > 0.0f)) {
+                fprintf(stderr, "Invalid max fps '%s'\n", optarg);
+                return 2;
+            }
+            break;
+        case 'S':
+            gWantStats = true;
+            break;
         default:
             if (ic != '?') {
                 fprintf(stderr, "getopt_long returned unexpected value 0x%x\n", ic);
@@ -18,6 +18,7 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -66,6 +67,9 @@
 
 #include <android/hardware/media/omx/1.0/IOmx.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "AudioPlayer.h"
 
 using namespace android;
@@ -82,6 +86,8 @@ static bool gForceToUseHardwareCodec;
 static bool gPlaybackAudio;
 static bool gWriteMP4;
 static bool gDisplayHistogram;
+static bool gBenchmark;  // print machine readable statistics as JSON.
+static long gNumWarmupRepetitions;  // passes that are excluded from the statistics.
 static bool gVerbose = false;
 static bool showProgress = true;
 static String8 gWriteMP4Filename;
@@ -134,6 +140,111 @@ static void displayDecodeHistogram(Vector<int64_t> *decodeTimesUs) {
     }
 }
 
+static int64_t timevalToUs(const struct timeval &tv) {
+    return (int64_t)tv.tv_usec + tv.tv_sec * 1000000ll;
+}
+
+// Collects the statistics reported in benchmark mode (-j). Only the passes after the
+// warmup passes are measured, and the result is printed as a single line JSON object,
+// so that the output of a run over a set of files can be consumed by a script.
+struct BenchmarkStats {
+    BenchmarkStats()
+        : mStarted(false),
+          mStartUs(0),
+          mStartCpuUs(0),
+          mNumFrames(0),
+          mTotalBytes(0) {
+    }
+
+    void start() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+
+        mStarted = true;
+        mStartUs = getNowUs();
+        mStartCpuUs = timevalToUs(usage.ru_utime) + timevalToUs(usage.ru_stime);
+    }
+
+    bool started() const {
+        return mStarted;
+    }
+
+    void addFrame(int64_t latencyUs, size_t size) {
+        mLatenciesUs.push_back(latencyUs);
+        ++mNumFrames;
+        mTotalBytes += size;
+    }
+
+    void dump(const char *filename, const char *mime, long numPasses);
+
+private:
+    bool mStarted;
+    int64_t mStartUs;
+    int64_t mStartCpuUs;
+    int64_t mNumFrames;
+    int64_t mTotalBytes;
+    std::vector<int64_t> mLatenciesUs;
+
+    // Nearest-rank percentile, mLatenciesUs must be sorted.
+    int64_t percentile(int p) const {
+        if (mLatenciesUs.empty()) {
+            return 0;
+        }
+        size_t rank = (mLatenciesUs.size() * p + 99) / 100;
+        return mLatenciesUs[rank > 0 ? rank - 1 : 0];
+    }
+};
+
+static void printJSONString(const char *s) {
+    putchar('"');
+    for (; *s != '\0'; ++s) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if (c < 0x20) {
+            printf("\\u%04x", c);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+void BenchmarkStats::dump(const char *filename, const char *mime, long numPasses) {
+    int64_t wallUs = mStarted ? getNowUs() - mStartUs : 0;
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    int64_t cpuUs = mStarted
+            ? timevalToUs(usage.ru_utime) + timevalToUs(usage.ru_stime) - mStartCpuUs : 0;
+
+    std::sort(mLatenciesUs.begin(), mLatenciesUs.end());
+    int64_t sumUs = 0;
+    for (int64_t latencyUs : mLatenciesUs) {
+        sumUs += latencyUs;
+    }
+
+    printf("{\"file\": ");
+    printJSONString(filename);
+    printf(", \"mime\": ");
+    printJSONString(mime);
+    printf(", \"warmup_passes\": %ld, \"passes\": %ld", gNumWarmupRepetitions, numPasses);
+    printf(", \"frames\": %" PRId64 ", \"bytes\": %" PRId64, mNumFrames, mTotalBytes);
+    printf(", \"wall_time_us\": %" PRId64, wallUs);
+    printf(", \"fps\": %.2f", wallUs > 0 ? mNumFrames * 1E6 / wallUs : 0.0);
+    printf(", \"latency_us\": {\"min\": %" PRId64 ", \"avg\": %.2f, \"p50\": %" PRId64
+           ", \"p90\": %" PRId64 ", \"p99\": %" PRId64 ", \"max\": %" PRId64 "}",
+           mLatenciesUs.empty() ? 0 : mLatenciesUs.front(),
+           mLatenciesUs.empty() ? 0.0 : (double)sumUs / mLatenciesUs.size(),
+           percentile(50), percentile(90), percentile(99),
+           mLatenciesUs.empty() ? 0 : mLatenciesUs.back());
+    printf(", \"cpu_time_us\": %" PRId64, cpuUs);
+    printf(", \"cpu_load\": %.2f", wallUs > 0 ? (double)cpuUs / wallUs : 0.0);
+    // ru_maxrss is in kilobytes and covers the whole process, not just this file.
+    printf(", \"peak_rss_kb\": %ld}\n", usage.ru_maxrss);
+    fflush(stdout);
+}
+
 static void displayAVCProfileLevelIfPossible(const sp<MetaData>& meta) {
     uint32_t type;
     const void *data;
@@ -186,7 +297,7 @@ static void dumpSource(const sp<MediaSource> &source, const String8 &filename) {
     out = NULL;
 }
 
-static void playSource(sp<MediaSource> &source) {
+static void playSource(sp<MediaSource> &source, const char *filename) {
     sp<MetaData> meta = source->getFormat();
 
     const char *mime;
@@ -321,16 +432,22 @@ static void playSource(sp<MediaSource> &source) {
     int n = 0;
     int64_t startTime = getNowUs();
 
-    long numIterationsLeft = gNumRepetitions;
+    long numIterationsLeft = gNumRepetitions + (gBenchmark ? gNumWarmupRepetitions : 0);
     MediaSource::ReadOptions options;
 
     int64_t sumDecodeUs = 0;
     int64_t totalBytes = 0;
 
     Vector<int64_t> decodeTimesUs;
+    BenchmarkStats stats;
 
     while (numIterationsLeft-- > 0) {
         long numFrames = 0;
+        bool measuring = gBenchmark && numIterationsLeft < gNumRepetitions;
+
+        if (measuring && !stats.started()) {
+            stats.start();
+        }
 
         MediaBufferBase *buffer;
 
@@ -345,7 +462,9 @@ static void playSource(sp<MediaSource> &source) {
                 CHECK(buffer == NULL);
 
                 if (err == INFO_FORMAT_CHANGED) {
-                    printf("format changed.\n");
+                    if (!gBenchmark) {
+                        printf("format changed.\n");
+                    }
                     continue;
                 }
 
@@ -353,6 +472,10 @@ static void playSource(sp<MediaSource> &source) {
             }
 
             if (buffer->range_length() > 0) {
+                if (measuring) {
+                    stats.addFrame(delayDecodeUs, buffer->range_length());
+                }
+
                 if (gDisplayHistogram && n > 0) {
                     // Ignore the first time since it includes some setup
                     // cost.
@@ -396,6 +519,12 @@ static void playSource(sp<MediaSource> &source) {
         options.setSeekTo(0);
     }
 
+    if (gBenchmark) {
+        stats.dump(filename, mime, gNumRepetitions);
+        rawSource->stop();
+        return;
+    }
+
     rawSource->stop();
     printf("\n");
 
@@ -652,6 +781,8 @@ static void usage(const char *me) {
     fprintf(stderr, "       -d(ump) output_filename (raw stream data to a file)\n");
     fprintf(stderr, "       -D(ump) output_filename (decoded PCM data to a file)\n");
     fprintf(stderr, "       -v be more verbose\n");
+    fprintf(stderr, "       -j benchmark decoding, print statistics as JSON (one line per file)\n");
+    fprintf(stderr, "       -W number of warmup passes excluded from the benchmark statistics\n");
 }
 
 static void dumpCodecDetails(bool queryDecoders) {
@@ -805,11 +936,13 @@ int main(int argc, char **argv) {
     gPlaybackAudio = false;
     gWriteMP4 = false;
     gDisplayHistogram = false;
+    gBenchmark = false;
+    gNumWarmupRepetitions = 1;
 
     sp<android::ALooper> looper;
 
     int res;
-    while ((res = getopt(argc, argv, "vhaqn:lm:b:itsrow:kN:xSTd:D:P:")) >= 0) {
+    while ((res = getopt(argc, argv, "vhaqn:lm:b:itsrow:kN:xSTd:D:P:jW:")) >= 0) {
         switch (res) {
             case 'a':
             {
@@ -942,6 +1075,26 @@ int main(int argc, char **argv) {
                 break;
             }
 
+            case 'j':
+            {
+                gBenchmark = true;
+                showProgress = false;
+                break;
+            }
+
+            case 'W':
+            {
+                char *end;
+                long x = strtol(optarg, &end, 10);
+
+                if (*end != '\0' || end == optarg || x < 0) {
+                    x = 0;
+                }
+
+                gNumWarmupRepetitions = x;
+                break;
+            }
+
             case '?':
             case 'h':
             default:
@@ -1267,7 +1420,7 @@ int main(int argc, char **argv) {
                 }
 
                 int64_t thumbTimeUs;
-                if (meta->findInt64(kKeyThumbnailTime, &thumbTimeUs)) {
+                if (!gBenchmark && meta->findInt64(kKeyThumbnailTime, &thumbTimeUs)) {
                     printf("thumbnailTime: %" PRId64 " us (%.2f secs)\n",
                            thumbTimeUs, thumbTimeUs / 1E6);
                 }
@@ -1290,7 +1443,7 @@ int main(int argc, char **argv) {
         } else if (seekTest) {
             performSeekTest(mediaSource);
         } else {
-            playSource(mediaSource);
+            playSource(mediaSource, filename);
         }
     }
 
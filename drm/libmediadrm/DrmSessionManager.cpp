@@ -61,14 +61,13 @@ static std::vector<Byte> toStdVec(const Vector<uint8_t> &vector) {
 }
 
 static std::vector<MediaResourceParcel> toResourceVec(
-        const Vector<uint8_t> &sessionId, int64_t value) {
+        std::vector<uint8_t> sessionId, int64_t value) {
     using Type = aidl::android::media::MediaResourceType;
     using SubType = aidl::android::media::MediaResourceSubType;
     std::vector<MediaResourceParcel> resources;
-    MediaResourceParcel resource{
+    resources.push_back(MediaResourceParcel{
             Type::kDrmSession, SubType::kUnspecifiedSubType,
-            toStdVec<>(sessionId), value};
-    resources.push_back(resource);
+            std::move(sessionId), value});
     return resources;
 }
 
@@ -90,8 +89,12 @@ bool isEqualSessionId(const Vector<uint8_t> &sessionId1, const Vector<uint8_t> &
 }
 
 sp<DrmSessionManager> DrmSessionManager::Instance() {
-    static sp<DrmSessionManager> drmSessionManager = new DrmSessionManager();
-    drmSessionManager->init();
+    // Instance() is called for every session operation; only take the init lock once.
+    static sp<DrmSessionManager> drmSessionManager = []() {
+        sp<DrmSessionManager> manager = new DrmSessionManager();
+        manager->init();
+        return manager;
+    }();
     return drmSessionManager;
 }
 
@@ -137,27 +140,29 @@ void DrmSessionManager::addSession(int pid,
     }
 
     static int64_t clientId = 0;
-    mSessionMap[toStdVec(sessionId)] = (SessionInfo){pid, uid, clientId};
+    std::vector<uint8_t> key = toStdVec(sessionId);
+    mSessionMap[key] = (SessionInfo){pid, uid, clientId};
     ClientInfoParcel clientInfo{.pid = static_cast<int32_t>(pid),
                                 .uid = static_cast<int32_t>(uid),
                                 .id = clientId++};
-    mService->addResource(clientInfo, drm, toResourceVec(sessionId, INT64_MAX));
+    mService->addResource(clientInfo, drm, toResourceVec(std::move(key), INT64_MAX));
 }
 
 void DrmSessionManager::useSession(const Vector<uint8_t> &sessionId) {
     ALOGV("useSession(%s)", GetSessionIdString(sessionId).string());
 
+    std::vector<uint8_t> key = toStdVec(sessionId);
     Mutex::Autolock lock(mLock);
-    auto it = mSessionMap.find(toStdVec(sessionId));
+    auto it = mSessionMap.find(key);
     if (mService == NULL || it == mSessionMap.end()) {
         return;
     }
 
-    auto info = it->second;
+    const SessionInfo& info = it->second;
     ClientInfoParcel clientInfo{.pid = static_cast<int32_t>(info.pid),
                                 .uid = static_cast<int32_t>(info.uid),
                                 .id = info.clientId};
-    mService->addResource(clientInfo, NULL, toResourceVec(sessionId, -1));
+    mService->addResource(clientInfo, NULL, toResourceVec(std::move(key), -1));
 }
 
 void DrmSessionManager::removeSession(const Vector<uint8_t> &sessionId) {
@@ -192,7 +197,7 @@ bool DrmSessionManager::reclaimSession(int callingPid) {
 
     // cannot update mSessionMap because we do not know which sessionId is reclaimed;
     // we rely on IResourceManagerClient to removeSession in reclaimResource
-    Vector<uint8_t> placeHolder;
+    std::vector<uint8_t> placeHolder;
     bool success;
     uid_t uid = AIBinder_getCallingUid();
     ClientInfoParcel clientInfo{.pid = static_cast<int32_t>(callingPid),
@@ -28,6 +28,10 @@
 #include <media/stagefright/MediaErrors.h>
 #include <utils/Log.h>
 
+#include <algorithm>
+#include <future>
+#include <vector>
+
 android::CasFactory* createCasFactory() {
     return new android::clearkeycas::ClearKeyCasFactory();
 }
@@ -423,22 +427,66 @@ ssize_t ClearKeyCasSession::decrypt(
         contentKey = mKeyInfo[keyIndex].contentKey;
     }
 
-    uint8_t *src = (uint8_t*)srcPtr;
+    const AES_KEY* key = (scramblingControl != DescramblerPlugin::kScrambling_Unscrambled) ?
+            &contentKey : nullptr;
+    const uint8_t *src = (const uint8_t*)srcPtr;
     uint8_t *dst = (uint8_t*)dstPtr;
 
+    size_t totalSize = 0;
+    for (size_t i = 0; i < numSubSamples; i++) {
+        totalSize += subSamples[i].mNumBytesOfClearData
+                + subSamples[i].mNumBytesOfEncryptedData;
+    }
+
+    if (key == nullptr || totalSize < kMinParallelDecryptSize || numSubSamples < 2) {
+        decryptSubSamples(key, numSubSamples, subSamples, src, dst);
+        return totalSize;
+    }
+
+    // Split the subsamples into ranges of roughly equal size, and descramble
+    // all but the last range on worker threads.
+    size_t numThreads = std::min(kMaxDecryptThreads, numSubSamples);
+    size_t rangeSize = (totalSize + numThreads - 1) / numThreads;
+    std::vector<std::future<void>> tasks;
+    size_t rangeStart = 0;
+    size_t rangeBytes = 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < numSubSamples; i++) {
+        rangeBytes += subSamples[i].mNumBytesOfClearData
+                + subSamples[i].mNumBytesOfEncryptedData;
+        if (rangeBytes >= rangeSize && i + 1 < numSubSamples) {
+            tasks.push_back(std::async(std::launch::async,
+                    &ClearKeyCasSession::decryptSubSamples, this, key,
+                    i + 1 - rangeStart, subSamples + rangeStart, src + offset, dst + offset));
+            offset += rangeBytes;
+            rangeStart = i + 1;
+            rangeBytes = 0;
+        }
+    }
+    decryptSubSamples(key, numSubSamples - rangeStart, subSamples + rangeStart,
+            src + offset, dst + offset);
+    for (auto& task : tasks) {
+        task.get();
+    }
+    return totalSize;
+}
+
+void ClearKeyCasSession::decryptSubSamples(
+        const AES_KEY* key, size_t numSubSamples,
+        const DescramblerPlugin::SubSample *subSamples,
+        const uint8_t *src, uint8_t *dst) const {
     for (size_t i = 0; i < numSubSamples; i++) {
         size_t numBytesinSubSample = subSamples[i].mNumBytesOfClearData
                 + subSamples[i].mNumBytesOfEncryptedData;
         if (src != dst) {
             memcpy(dst, src, numBytesinSubSample);
         }
-        status_t err = OK;
         // Don't decrypt if len < AES_BLOCK_SIZE.
         // The last chunk shorter than AES_BLOCK_SIZE is not encrypted.
-        if (scramblingControl != DescramblerPlugin::kScrambling_Unscrambled
+        if (key != nullptr
                 && subSamples[i].mNumBytesOfEncryptedData >= AES_BLOCK_SIZE) {
-            err = decryptPayload(
-                    contentKey,
+            decryptPayload(
+                    *key,
                     numBytesinSubSample,
                     subSamples[i].mNumBytesOfClearData,
                     (char *)dst);
@@ -447,7 +495,6 @@ ssize_t ClearKeyCasSession::decrypt(
         dst += numBytesinSubSample;
         src += numBytesinSubSample;
     }
-    return dst - (uint8_t *)dstPtr;
 }
 
 // Decryption of a TS payload
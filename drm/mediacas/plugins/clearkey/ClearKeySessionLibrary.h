@@ -64,6 +64,16 @@ private:
     CasPlugin* getPlugin() const { return mPlugin; }
     status_t decryptPayload(
             const AES_KEY& key, size_t length, size_t offset, char* buffer) const;
+    // Copy and, if key is not null, descramble consecutive subsamples of a unit.
+    void decryptSubSamples(
+            const AES_KEY* key, size_t numSubSamples,
+            const DescramblerPlugin::SubSample *subSamples,
+            const uint8_t *src, uint8_t *dst) const;
+
+    // Units at least this large are descrambled on several threads. Every
+    // subsample is an independent CTS block chain, so they can be split freely.
+    static constexpr size_t kMinParallelDecryptSize = 256 * 1024;
+    static constexpr size_t kMaxDecryptThreads = 4;
 
     DISALLOW_EVIL_CONSTRUCTORS(ClearKeyCasSession);
 };
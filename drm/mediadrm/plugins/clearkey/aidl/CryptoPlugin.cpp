@@ -142,7 +142,9 @@ using ::aidl::android::hardware::drm::Status;
         size_t bytesDecrypted{};
         std::vector<int32_t> clearDataLengths;
         std::vector<int32_t> encryptedDataLengths;
-        for (auto ss : in_args.subSamples) {
+        clearDataLengths.reserve(in_args.subSamples.size());
+        encryptedDataLengths.reserve(in_args.subSamples.size());
+        for (const auto& ss : in_args.subSamples) {
             clearDataLengths.push_back(ss.numBytesOfClearData);
             encryptedDataLengths.push_back(ss.numBytesOfEncryptedData);
         }
@@ -1001,7 +1001,7 @@ ConversionResult<AudioDeviceDescription> legacy2aidl_audio_devices_t_AudioDevice
 
 AudioDeviceAddress::Tag suggestDeviceAddressTag(const AudioDeviceDescription& description) {
     using Tag = AudioDeviceAddress::Tag;
-    if (std::string connection = description.connection;
+    if (const auto& connection = description.connection;
             connection == GET_DEVICE_DESC_CONNECTION(BT_A2DP) ||
             // Note: BT LE Broadcast uses a "group id".
             (description.type != AudioDeviceType::OUT_BROADCAST &&
@@ -1019,30 +1019,34 @@ AudioDeviceAddress::Tag suggestDeviceAddressTag(const AudioDeviceDescription& de
 
 ::android::status_t aidl2legacy_AudioDevice_audio_device(
         const AudioDevice& aidl,
-        audio_devices_t* legacyType, char* legacyAddress) {
-    std::string stringAddress;
+        audio_devices_t* legacyType, String8* legacyAddress) {
+    char addressBuffer[AUDIO_DEVICE_MAX_ADDRESS_LEN];
     RETURN_STATUS_IF_ERROR(aidl2legacy_AudioDevice_audio_device(
-                    aidl, legacyType, &stringAddress));
-    return aidl2legacy_string(stringAddress, legacyAddress, AUDIO_DEVICE_MAX_ADDRESS_LEN);
+                    aidl, legacyType, addressBuffer));
+    *legacyAddress = String8(addressBuffer);
+    return OK;
 }
 
 ::android::status_t aidl2legacy_AudioDevice_audio_device(
         const AudioDevice& aidl,
-        audio_devices_t* legacyType, String8* legacyAddress) {
-    std::string stringAddress;
+        audio_devices_t* legacyType, std::string* legacyAddress) {
+    char addressBuffer[AUDIO_DEVICE_MAX_ADDRESS_LEN];
     RETURN_STATUS_IF_ERROR(aidl2legacy_AudioDevice_audio_device(
-                    aidl, legacyType, &stringAddress));
-    *legacyAddress = VALUE_OR_RETURN_STATUS(aidl2legacy_string_view_String8(stringAddress));
+                    aidl, legacyType, addressBuffer));
+    *legacyAddress = addressBuffer;
     return OK;
 }
 
+// The address is formatted directly into the caller's legacy buffer, which must be
+// AUDIO_DEVICE_MAX_ADDRESS_LEN long, so that converting port configs and device
+// descriptors does not build an intermediate std::string.
 ::android::status_t aidl2legacy_AudioDevice_audio_device(
         const AudioDevice& aidl,
-        audio_devices_t* legacyType, std::string* legacyAddress) {
+        audio_devices_t* legacyType, char* addressBuffer) {
     using Tag = AudioDeviceAddress::Tag;
     *legacyType = VALUE_OR_RETURN_STATUS(
             aidl2legacy_AudioDeviceDescription_audio_devices_t(aidl.type));
-    char addressBuffer[AUDIO_DEVICE_MAX_ADDRESS_LEN]{};
+    addressBuffer[0] = '\0';
     // 'aidl.address' can be empty even when the connection type is not.
     // This happens for device ports that act as "blueprints". In this case
     // we pass an empty string using the 'id' variant.
@@ -1077,7 +1081,6 @@ AudioDeviceAddress::Tag suggestDeviceAddressTag(const AudioDeviceDescription& de
                             addressBuffer, AUDIO_DEVICE_MAX_ADDRESS_LEN));
         } break;
     }
-    *legacyAddress = addressBuffer;
     return OK;
 }
 
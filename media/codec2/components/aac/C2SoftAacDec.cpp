@@ -375,16 +375,19 @@ status_t C2SoftAacDec::initDecoder() {
     int32_t effectType = mIntf->getDrcEffectType();
     ALOGV("AAC decoder using MPEG-D DRC effect type %d", effectType);
     aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_SET_EFFECT, effectType);
+    mDrcEffectType = effectType;
 
     // AAC_UNIDRC_ALBUM_MODE
     int32_t albumMode = mIntf->getDrcAlbumMode();
     ALOGV("AAC decoder using MPEG-D DRC album mode %d", albumMode);
     aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_ALBUM_MODE, albumMode);
+    mDrcAlbumMode = albumMode;
 
     // AAC_PCM_MAX_OUTPUT_CHANNELS
     u_int32_t maxChannelCount = mIntf->getMaxChannelCount();
     ALOGV("AAC decoder using maximum output channel count %d", maxChannelCount);
     aacDecoder_SetParam(mAACDecoder, AAC_PCM_MAX_OUTPUT_CHANNELS, maxChannelCount);
+    mMaxOutputChannelCount = maxChannelCount;
 
     return status;
 }
@@ -669,20 +672,31 @@ void C2SoftAacDec::process(
         ALOGV("AAC decoder using encoder-side DRC reference level of %d", encTargetLevel);
         mDrcWrap.setParam(DRC_PRES_MODE_WRAP_ENCODER_TARGET, (unsigned)encTargetLevel);
 
+        // The parameters below make the decoder reconfigure its DRC or downmix, so only pass
+        // them on when they change.
         // AAC_UNIDRC_SET_EFFECT
         int32_t effectType = mIntf->getDrcEffectType();
-        ALOGV("AAC decoder using MPEG-D DRC effect type %d", effectType);
-        aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_SET_EFFECT, effectType);
+        if (effectType != mDrcEffectType) {
+            ALOGV("AAC decoder using MPEG-D DRC effect type %d", effectType);
+            aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_SET_EFFECT, effectType);
+            mDrcEffectType = effectType;
+        }
 
         // AAC_UNIDRC_ALBUM_MODE
         int32_t albumMode = mIntf->getDrcAlbumMode();
-        ALOGV("AAC decoder using MPEG-D DRC album mode %d", albumMode);
-        aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_ALBUM_MODE, albumMode);
+        if (albumMode != mDrcAlbumMode) {
+            ALOGV("AAC decoder using MPEG-D DRC album mode %d", albumMode);
+            aacDecoder_SetParam(mAACDecoder, AAC_UNIDRC_ALBUM_MODE, albumMode);
+            mDrcAlbumMode = albumMode;
+        }
 
         // AAC_PCM_MAX_OUTPUT_CHANNELS
         int32_t maxChannelCount = mIntf->getMaxChannelCount();
-        ALOGV("AAC decoder using maximum output channel count %d", maxChannelCount);
-        aacDecoder_SetParam(mAACDecoder, AAC_PCM_MAX_OUTPUT_CHANNELS, maxChannelCount);
+        if (maxChannelCount != mMaxOutputChannelCount) {
+            ALOGV("AAC decoder using maximum output channel count %d", maxChannelCount);
+            aacDecoder_SetParam(mAACDecoder, AAC_PCM_MAX_OUTPUT_CHANNELS, maxChannelCount);
+            mMaxOutputChannelCount = maxChannelCount;
+        }
 
         mDrcWrap.update();
 
@@ -67,6 +67,10 @@ private:
     std::list<Info> mBuffersInfo;
 
     CDrcPresModeWrapper mDrcWrap;
+    // last values passed to the decoder
+    int32_t mDrcEffectType;
+    int32_t mDrcAlbumMode;
+    int32_t mMaxOutputChannelCount;
 
     enum {
         NONE,
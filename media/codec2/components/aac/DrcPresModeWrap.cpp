@@ -61,6 +61,7 @@ void
 CDrcPresModeWrapper::setDecoderHandle(const HANDLE_AACDECODER handle)
 {
     mHandleDecoder = handle;
+    mDataUpdate = true;
 }
 
 void
@@ -125,26 +126,32 @@ CDrcPresModeWrapper::submitStreamData(CStreamInfo* pStreamInfo)
 void
 CDrcPresModeWrapper::setParam(const DRC_PRES_MODE_WRAP_PARAM param, const int value)
 {
+    int *dest;
     switch (param) {
     case DRC_PRES_MODE_WRAP_DESIRED_TARGET:
-        mDesTarget = value;
+        dest = &mDesTarget;
         break;
     case DRC_PRES_MODE_WRAP_DESIRED_ATT_FACTOR:
-        mDesAttFactor = value;
+        dest = &mDesAttFactor;
         break;
     case DRC_PRES_MODE_WRAP_DESIRED_BOOST_FACTOR:
-        mDesBoostFactor = value;
+        dest = &mDesBoostFactor;
         break;
     case DRC_PRES_MODE_WRAP_DESIRED_HEAVY:
-        mDesHeavy = value;
+        dest = &mDesHeavy;
         break;
     case DRC_PRES_MODE_WRAP_ENCODER_TARGET:
-        mEncoderTarget = value;
+        dest = &mEncoderTarget;
         break;
     default:
-        break;
+        return;
+    }
+    // the parameters are set again for every frame, only recompute the DRC settings
+    // in update() when one of them changes
+    if (*dest != value) {
+        *dest = value;
+        mDataUpdate = true;
     }
-    mDataUpdate = true;
 }
 
 void
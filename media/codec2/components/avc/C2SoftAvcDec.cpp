@@ -202,6 +202,13 @@ public:
                 .withConstValue(new C2StreamPixelFormatInfo::output(
                                      0u, HAL_PIXEL_FORMAT_YCBCR_420_888))
                 .build());
+
+        addParameter(
+                DefineParam(mLowLatencyMode, C2_PARAMKEY_LOW_LATENCY_MODE)
+                .withDefault(new C2GlobalLowLatencyModeTuning(false))
+                .withFields({C2F(mLowLatencyMode, value).oneOf({C2_FALSE, C2_TRUE})})
+                .withSetter(Setter<decltype(*mLowLatencyMode)>::NonStrictValueWithNoDeps)
+                .build());
     }
     static C2R SizeSetter(bool mayBlock, const C2P<C2StreamPictureSizeInfo::output> &oldMe,
                           C2P<C2StreamPictureSizeInfo::output> &me) {
@@ -296,6 +303,8 @@ public:
         return mColorAspects;
     }
 
+    bool getLowLatencyMode() const { return mLowLatencyMode->value; }
+
 private:
     std::shared_ptr<C2StreamProfileLevelInfo::input> mProfileLevel;
     std::shared_ptr<C2StreamPictureSizeInfo::output> mSize;
@@ -306,21 +315,9 @@ private:
     std::shared_ptr<C2StreamColorAspectsTuning::output> mDefaultColorAspects;
     std::shared_ptr<C2StreamColorAspectsInfo::output> mColorAspects;
     std::shared_ptr<C2StreamPixelFormatInfo::output> mPixelFormat;
+    std::shared_ptr<C2GlobalLowLatencyModeTuning> mLowLatencyMode;
 };
 
-static size_t getCpuCoreCount() {
-    long cpuCoreCount = 1;
-#if defined(_SC_NPROCESSORS_ONLN)
-    cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
-#else
-    // _SC_NPROC_ONLN must be defined...
-    cpuCoreCount = sysconf(_SC_NPROC_ONLN);
-#endif
-    CHECK(cpuCoreCount >= 1);
-    ALOGV("Number of CPU cores: %ld", cpuCoreCount);
-    return (size_t)cpuCoreCount;
-}
-
 static void *ivd_aligned_malloc(void *ctxt, WORD32 alignment, WORD32 size) {
     (void) ctxt;
     return memalign(alignment, size);
@@ -471,7 +468,10 @@ status_t C2SoftAvcDec::setParams(size_t stride, IVD_VIDEO_DECODE_MODE_T dec_mode
     ps_set_dyn_params_ip->e_sub_cmd = IVD_CMD_CTL_SETPARAMS;
     ps_set_dyn_params_ip->u4_disp_wd = (UWORD32) stride;
     ps_set_dyn_params_ip->e_frm_skip_mode = IVD_SKIP_NONE;
-    ps_set_dyn_params_ip->e_frm_out_mode = IVD_DISPLAY_FRAME_OUT;
+    // In low latency mode, pictures are output as soon as they are decoded instead of
+    // being held for display reordering.
+    ps_set_dyn_params_ip->e_frm_out_mode =
+        mIntf->getLowLatencyMode() ? IVD_DECODE_FRAME_OUT : IVD_DISPLAY_FRAME_OUT;
     ps_set_dyn_params_ip->e_vid_dec_mode = dec_mode;
     ps_set_dyn_params_op->u4_size = sizeof(ih264d_ctl_set_config_op_t);
     IV_API_CALL_STATUS_T status = ivdec_api_function(mDecHandle,
@@ -510,7 +510,7 @@ void C2SoftAvcDec::getVersion() {
 
 status_t C2SoftAvcDec::initDecoder() {
     if (OK != createDecoder()) return UNKNOWN_ERROR;
-    mNumCores = MIN(getCpuCoreCount(), MAX_NUM_CORES);
+    mNumCores = acquireThreadShare(MAX_NUM_CORES);
     mStride = ALIGN128(mWidth);
     mSignalledError = false;
     resetPlugin();
@@ -677,6 +677,7 @@ void C2SoftAvcDec::resetPlugin() {
 }
 
 status_t C2SoftAvcDec::deleteDecoder() {
+    releaseThreadShare();
     if (mDecHandle) {
         ivdext_delete_ip_t s_delete_ip = {};
         ivdext_delete_op_t s_delete_op = {};
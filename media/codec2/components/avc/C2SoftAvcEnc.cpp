@@ -567,19 +567,6 @@ namespace {
 // From external/libavc/encoder/ih264e_bitstream.h
 constexpr uint32_t MIN_STREAM_SIZE = 0x800;
 
-static size_t GetCPUCoreCount() {
-    long cpuCoreCount = 1;
-#if defined(_SC_NPROCESSORS_ONLN)
-    cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
-#else
-    // _SC_NPROC_ONLN must be defined...
-    cpuCoreCount = sysconf(_SC_NPROC_ONLN);
-#endif
-    CHECK(cpuCoreCount >= 1);
-    ALOGV("Number of CPU cores: %ld", cpuCoreCount);
-    return (size_t)cpuCoreCount;
-}
-
 }  // namespace
 
 C2SoftAvcEnc::C2SoftAvcEnc(
@@ -1351,6 +1338,7 @@ c2_status_t C2SoftAvcEnc::initEncoder() {
     logVersion();
 
     /* set processor details */
+    mNumCores = acquireThreadShare(CODEC_MAX_CORES);
     setNumCores();
 
     /* Video control Set Frame dimensions */
@@ -1406,6 +1394,7 @@ c2_status_t C2SoftAvcEnc::releaseEncoder() {
     iv_retrieve_mem_rec_op_t s_retrieve_mem_op;
     iv_mem_rec_t *ps_mem_rec;
 
+    releaseThreadShare();
     if (!mStarted) {
         return C2_OK;
     }
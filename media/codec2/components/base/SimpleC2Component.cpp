@@ -23,6 +23,10 @@
 #include <media/stagefright/foundation/AMessage.h>
 
 #include <inttypes.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
 
 #include <C2Config.h>
 #include <C2Debug.h>
@@ -30,6 +34,7 @@
 #include <Codec2BufferUtils.h>
 #include <Codec2CommonUtils.h>
 #include <SimpleC2Component.h>
+#include <cpustats/SessionCpuUsage.h>
 
 namespace android {
 constexpr uint8_t kNeutralUVBitDepth8 = 128;
@@ -567,7 +572,7 @@ void SimpleC2Component::WorkHandler::onMessageReceived(const sp<AMessage> &msg)
     switch (msg->what()) {
         case kWhatProcess: {
             if (mRunning) {
-                if (thiz->processQueue()) {
+                if (thiz->processQueueBatch()) {
                     (new AMessage(kWhatProcess, this))->post();
                 }
             } else {
@@ -585,6 +590,7 @@ void SimpleC2Component::WorkHandler::onMessageReceived(const sp<AMessage> &msg)
             break;
         }
         case kWhatStop: {
+            thiz->logCpuUsage();
             int32_t err = thiz->onStop();
             thiz->mOutputBlockPool.reset();
             Reply(msg, &err);
@@ -598,6 +604,7 @@ void SimpleC2Component::WorkHandler::onMessageReceived(const sp<AMessage> &msg)
             break;
         }
         case kWhatRelease: {
+            thiz->logCpuUsage();
             thiz->onRelease();
             thiz->mOutputBlockPool.reset();
             mRunning = false;
@@ -676,7 +683,8 @@ SimpleC2Component::SimpleC2Component(
     : mDummyReadView(DummyReadView()),
       mIntf(intf),
       mLooper(new ALooper),
-      mHandler(new WorkHandler) {
+      mHandler(new WorkHandler),
+      mCpuUsage(new SessionCpuUsage) {
     mLooper->setName(intf->getName().c_str());
     (void)mLooper->registerHandler(mHandler);
     mLooper->start(false, false, ANDROID_PRIORITY_VIDEO);
@@ -685,6 +693,53 @@ SimpleC2Component::SimpleC2Component(
 SimpleC2Component::~SimpleC2Component() {
     mLooper->unregisterHandler(mHandler->id());
     (void)mLooper->stop();
+    releaseThreadShare();
+}
+
+namespace {
+
+// Components of this process holding a share of the CPU cores.
+std::mutex sThreadShareLock;
+size_t sThreadShareHolders = 0;
+
+}  // namespace
+
+// static
+size_t SimpleC2Component::GetCPUCoreCount() {
+    long cpuCoreCount = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+    cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    // _SC_NPROC_ONLN must be defined...
+    cpuCoreCount = sysconf(_SC_NPROC_ONLN);
+#endif
+    CHECK(cpuCoreCount >= 1);
+    ALOGV("Number of CPU cores: %ld", cpuCoreCount);
+    return (size_t)cpuCoreCount;
+}
+
+size_t SimpleC2Component::acquireThreadShare(size_t maxThreads) {
+    const size_t coreCount = GetCPUCoreCount();
+    size_t threads = coreCount;
+    if (property_get_bool("debug.codec2.soft.share_cores", true)) {
+        std::lock_guard<std::mutex> lock(sThreadShareLock);
+        if (!mHoldsThreadShare) {
+            ++sThreadShareHolders;
+            mHoldsThreadShare = true;
+        }
+        threads = std::max(coreCount / sThreadShareHolders, (size_t)1);
+        ALOGV("%s: %zu threads for %zu holders", mIntf->getName().c_str(), threads,
+                sThreadShareHolders);
+    }
+    return std::max(std::min(threads, maxThreads), (size_t)1);
+}
+
+void SimpleC2Component::releaseThreadShare() {
+    std::lock_guard<std::mutex> lock(sThreadShareLock);
+    if (mHoldsThreadShare) {
+        --sThreadShareHolders;
+        mHoldsThreadShare = false;
+    }
 }
 
 c2_status_t SimpleC2Component::setListener_vb(
@@ -881,8 +936,7 @@ void SimpleC2Component::finish(
     }
     if (work) {
         fillWork(work);
-        std::shared_ptr<C2Component::Listener> listener = mExecState.lock()->mListener;
-        listener->onWorkDone_nb(shared_from_this(), vec(work));
+        sendDoneWork(std::move(work));
         ALOGV("returning pending work");
     }
 }
@@ -907,12 +961,74 @@ void SimpleC2Component::cloneAndSend(
     work->worklets.emplace_back(new C2Worklet);
     if (work) {
         fillWork(work);
-        std::shared_ptr<C2Component::Listener> listener = mExecState.lock()->mListener;
-        listener->onWorkDone_nb(shared_from_this(), vec(work));
+        sendDoneWork(std::move(work));
         ALOGV("cloned and sending work");
     }
 }
 
+void SimpleC2Component::sendDoneWork(std::unique_ptr<C2Work> work) {
+    if (mBatchingThread.load() == std::this_thread::get_id()) {
+        mDoneWorks.push_back(std::move(work));
+        return;
+    }
+    std::shared_ptr<C2Component::Listener> listener = mExecState.lock()->mListener;
+    listener->onWorkDone_nb(shared_from_this(), vec(work));
+}
+
+void SimpleC2Component::sendDoneWorks(std::list<std::unique_ptr<C2Work>> works) {
+    if (works.empty()) {
+        return;
+    }
+    if (mHoldDoneWorks) {
+        mHeldWorks.splice(mHeldWorks.end(), works);
+        return;
+    }
+    std::shared_ptr<C2Component::Listener> listener = mExecState.lock()->mListener;
+    listener->onWorkDone_nb(shared_from_this(), std::move(works));
+}
+
+void SimpleC2Component::updateLowLatencyMode() {
+    C2GlobalLowLatencyModeTuning lowLatency;
+    c2_status_t err = intf()->query_vb({ &lowLatency }, {}, C2_DONT_BLOCK, nullptr);
+    mLowLatency = (err == C2_OK && lowLatency.value);
+}
+
+void SimpleC2Component::logCpuUsage() {
+    const CentralTendencyStatistics &stats = mCpuUsage->stretchNs();
+    if (stats.n() == 0) {
+        return;
+    }
+    ALOGD("%s: %u works used %.1f ms of CPU (%.1f Mcycles), "
+            "us per work: mean=%.0f stddev=%.0f max=%.0f",
+            mIntf->getName().c_str(), stats.n(), mCpuUsage->totalNs() * 1e-6,
+            mCpuUsage->totalCycles() * 1e-6,
+            stats.mean() * 1e-3, stats.stddev() * 1e-3, stats.maximum() * 1e-3);
+    mCpuUsage->reset();
+}
+
+bool SimpleC2Component::processQueueBatch() {
+    if (mLowLatency) {
+        return processQueue();
+    }
+    const uint64_t generation = mWorkQueue.lock()->generation();
+    const int64_t deadlineUs = ALooper::GetNowUs() + kMaxBatchDurationUs;
+    bool hasQueuedWork = true;
+    mHoldDoneWorks = true;
+    for (size_t i = 0; i < kMaxBatchedWorks && hasQueuedWork; ++i) {
+        hasQueuedWork = processQueue();
+        // Do not hold finished works across a flush, or once the latency budget is spent.
+        if (mLowLatency || ALooper::GetNowUs() >= deadlineUs
+                || mWorkQueue.lock()->generation() != generation) {
+            break;
+        }
+    }
+    mHoldDoneWorks = false;
+    std::list<std::unique_ptr<C2Work>> works;
+    works.swap(mHeldWorks);
+    sendDoneWorks(std::move(works));
+    return hasQueuedWork;
+}
+
 bool SimpleC2Component::processQueue() {
     std::unique_ptr<C2Work> work;
     uint64_t generation;
@@ -978,6 +1094,7 @@ bool SimpleC2Component::processQueue() {
             }
             return err;
         }();
+        updateLowLatencyMode();
         if (err != C2_OK) {
             Mutexed<ExecState>::Locked state(mExecState);
             std::shared_ptr<C2Component::Listener> listener = state->mListener;
@@ -988,7 +1105,11 @@ bool SimpleC2Component::processQueue() {
     }
 
     if (!work) {
+        mBatchingThread = std::this_thread::get_id();
         c2_status_t err = drain(drainMode, mOutputBlockPool);
+        mBatchingThread = std::thread::id();
+        sendDoneWorks(std::move(mDoneWorks));
+        mDoneWorks.clear();
         if (err != C2_OK) {
             Mutexed<ExecState>::Locked state(mExecState);
             std::shared_ptr<C2Component::Listener> listener = state->mListener;
@@ -1009,6 +1130,7 @@ bool SimpleC2Component::processQueue() {
             std::vector<std::unique_ptr<C2SettingResult>> failures;
             c2_status_t err = intf()->config_vb(updates, C2_MAY_BLOCK, &failures);
             ALOGD("applied %zu configUpdates => %s (%d)", updates.size(), asString(err), err);
+            updateLowLatencyMode();
         }
     }
 
@@ -1020,7 +1142,15 @@ bool SimpleC2Component::processQueue() {
         ALOGD("Encountered null input buffer. Clearing the input buffer");
         work->input.buffers.clear();
     }
+    if (!mLowLatency) {
+        mBatchingThread = std::this_thread::get_id();
+    }
+    mCpuUsage->begin();
     process(work, mOutputBlockPool);
+    mCpuUsage->end();
+    mBatchingThread = std::thread::id();
+    std::list<std::unique_ptr<C2Work>> doneWorks;
+    doneWorks.swap(mDoneWorks);
     ALOGV("processed frame #%" PRIu64, work->input.ordinal.frameIndex.peeku());
     Mutexed<WorkQueue>::Locked queue(mWorkQueue);
     if (queue->generation() != generation) {
@@ -1029,19 +1159,15 @@ bool SimpleC2Component::processQueue() {
         work->result = C2_NOT_FOUND;
         queue.unlock();
 
-        Mutexed<ExecState>::Locked state(mExecState);
-        std::shared_ptr<C2Component::Listener> listener = state->mListener;
-        state.unlock();
-        listener->onWorkDone_nb(shared_from_this(), vec(work));
+        doneWorks.push_back(std::move(work));
+        sendDoneWorks(std::move(doneWorks));
         return hasQueuedWork;
     }
     if (work->workletsProcessed != 0u) {
         queue.unlock();
-        Mutexed<ExecState>::Locked state(mExecState);
         ALOGV("returning this work");
-        std::shared_ptr<C2Component::Listener> listener = state->mListener;
-        state.unlock();
-        listener->onWorkDone_nb(shared_from_this(), vec(work));
+        doneWorks.push_back(std::move(work));
+        sendDoneWorks(std::move(doneWorks));
     } else {
         ALOGV("queue pending work");
         work->input.buffers.clear();
@@ -1055,6 +1181,7 @@ bool SimpleC2Component::processQueue() {
         (void)queue->pending().insert({ frameIndex, std::move(work) });
 
         queue.unlock();
+        sendDoneWorks(std::move(doneWorks));
         if (unexpected) {
             ALOGD("unexpected pending work");
             unexpected->result = C2_CORRUPTED;
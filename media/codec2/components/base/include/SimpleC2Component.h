@@ -17,7 +17,9 @@
 #ifndef SIMPLE_C2_COMPONENT_H_
 #define SIMPLE_C2_COMPONENT_H_
 
+#include <atomic>
 #include <list>
+#include <thread>
 #include <unordered_map>
 
 #include <C2Component.h>
@@ -67,6 +69,8 @@ void convertRGBA1010102ToYUV420Planar16(uint16_t* dstY, uint16_t* dstU, uint16_t
                                         size_t height, C2Color::matrix_t colorMatrix,
                                         C2Color::range_t colorRange);
 
+class SessionCpuUsage;
+
 class SimpleC2Component
         : public C2Component, public std::enable_shared_from_this<SimpleC2Component> {
 public:
@@ -190,6 +194,27 @@ protected:
     C2ReadView mDummyReadView;
     int getHalPixelFormatForBitDepth10(bool allowRGBA1010102);
 
+    /**
+     * Returns the number of online CPU cores.
+     */
+    static size_t GetCPUCoreCount();
+
+    /**
+     * Takes a share of the CPU cores for the internal threads of the codec library, and
+     * returns the number of threads to use (at least 1 and at most |maxThreads|).
+     *
+     * The cores are divided among the components of the process holding a share, so that
+     * concurrent sessions do not each run one thread per core. The share is held until
+     * releaseThreadShare() or the destruction of the component; acquiring it again
+     * replaces the previous share.
+     */
+    size_t acquireThreadShare(size_t maxThreads);
+
+    /**
+     * Releases the share taken by acquireThreadShare(), if any.
+     */
+    void releaseThreadShare();
+
 private:
     const std::shared_ptr<C2ComponentInterface> mIntf;
 
@@ -272,7 +297,39 @@ private:
     class BlockingBlockPool;
     std::shared_ptr<BlockingBlockPool> mOutputBlockPool;
 
+    // Works completed by finish() or cloneAndSend() on the looper thread while process() or
+    // drain() runs are collected here, and returned with a single onWorkDone_nb() call when
+    // it returns. mBatchingThread is the looper thread while collecting.
+    std::atomic<std::thread::id> mBatchingThread{std::thread::id()};
+    std::list<std::unique_ptr<C2Work>> mDoneWorks;
+    // Works are not held back by process() in low latency mode.
+    bool mLowLatency = false;
+
+    // While processQueueBatch() runs, works returned by processQueue() are held here and
+    // returned together when the batch ends.
+    bool mHoldDoneWorks = false;
+    std::list<std::unique_ptr<C2Work>> mHeldWorks;
+
+    void sendDoneWork(std::unique_ptr<C2Work> work);
+    void sendDoneWorks(std::list<std::unique_ptr<C2Work>> works);
+    void updateLowLatencyMode();
+
+    /**
+     * Processes up to kMaxBatchedWorks queued works (or for up to kMaxBatchDurationUs) in one
+     * looper message, returning their finished works with a single listener callback.
+     * Returns true if there is more queued work.
+     */
+    bool processQueueBatch();
+    static constexpr size_t kMaxBatchedWorks = 8;
+    static constexpr int64_t kMaxBatchDurationUs = 1000;
+
     std::vector<int> mBitDepth10HalPixelFormats;
+    bool mHoldsThreadShare = false;
+
+    // CPU used by process() on the looper thread for this component instance. Threads
+    // internal to the codec library are not included.
+    std::unique_ptr<SessionCpuUsage> mCpuUsage;
+    void logCpuUsage();
     SimpleC2Component() = delete;
 };
 
@@ -16,6 +16,8 @@
 
 //#define LOG_NDEBUG 0
 #define LOG_TAG "C2SoftFlacDec"
+#include <algorithm>
+
 #include <log/log.h>
 
 #include <media/stagefright/foundation/MediaDefs.h>
@@ -91,9 +93,30 @@ public:
                 })
                 .withSetter((Setter<decltype(*mPcmEncodingInfo)>::StrictValueWithNoDeps))
                 .build());
+
+        addParameter(
+                DefineParam(mLargeFrame, C2_PARAMKEY_OUTPUT_LARGE_FRAME)
+                .withDefault(new C2LargeFrame::output(0u, 0, 0))
+                .withFields({
+                    C2F(mLargeFrame, maxSize).inRange(0, kMaxLargeFrameSize),
+                    C2F(mLargeFrame, thresholdSize).inRange(0, kMaxLargeFrameSize)})
+                .withSetter(LargeFrameSetter)
+                .build());
+    }
+
+    static C2R LargeFrameSetter(bool mayBlock, C2P<C2LargeFrame::output> &me) {
+        (void)mayBlock;
+        if (me.v.thresholdSize > me.v.maxSize) {
+            me.set().thresholdSize = me.v.maxSize;
+        }
+        return C2R::Ok();
     }
 
     int32_t getPcmEncodingInfo() const { return mPcmEncodingInfo->value; }
+    uint32_t getLargeFrameMaxSize() const { return mLargeFrame->maxSize; }
+    uint32_t getLargeFrameThresholdSize() const { return mLargeFrame->thresholdSize; }
+
+    static constexpr uint32_t kMaxLargeFrameSize = 4 * 1024 * 1024;
 
 private:
     std::shared_ptr<C2StreamSampleRateInfo::output> mSampleRate;
@@ -101,6 +124,7 @@ private:
     std::shared_ptr<C2StreamBitrateInfo::input> mBitrate;
     std::shared_ptr<C2StreamMaxBufferSizeInfo::input> mInputMaxBufSize;
     std::shared_ptr<C2StreamPcmEncodingInfo::output> mPcmEncodingInfo;
+    std::shared_ptr<C2LargeFrame::output> mLargeFrame;
 };
 
 C2SoftFlacDec::C2SoftFlacDec(
@@ -109,7 +133,8 @@ C2SoftFlacDec::C2SoftFlacDec(
         const std::shared_ptr<IntfImpl> &intfImpl)
     : SimpleC2Component(std::make_shared<SimpleInterface<IntfImpl>>(name, id, intfImpl)),
       mIntf(intfImpl),
-      mFLACDecoder(nullptr) {
+      mFLACDecoder(nullptr),
+      mLargeFrameSize(0) {
 }
 
 C2SoftFlacDec::~C2SoftFlacDec() {
@@ -127,6 +152,7 @@ c2_status_t C2SoftFlacDec::onStop() {
     mHasStreamInfo = false;
     mSignalledError = false;
     mSignalledOutputEos = false;
+    resetLargeFrame();
     return C2_OK;
 }
 
@@ -165,6 +191,24 @@ status_t C2SoftFlacDec::initDecoder() {
     return OK;
 }
 
+void C2SoftFlacDec::resetLargeFrame() {
+    mLargeFrameView.reset();
+    mLargeFrameBlock.reset();
+    mLargeFrameSize = 0;
+    mLargeFrameInfos.clear();
+}
+
+std::shared_ptr<C2Buffer> C2SoftFlacDec::takeLargeFrame() {
+    std::shared_ptr<C2Buffer> buffer = createLinearBuffer(mLargeFrameBlock, 0, mLargeFrameSize);
+    c2_status_t err = buffer->setInfo(
+            C2AccessUnitInfos::output::AllocShared(mLargeFrameInfos, 0u /* stream */));
+    if (err != C2_OK) {
+        ALOGW("failed to attach access unit infos: %d", err);
+    }
+    resetLargeFrame();
+    return buffer;
+}
+
 static void fillEmptyWork(const std::unique_ptr<C2Work> &work) {
     work->worklets.front()->output.flags = work->input.flags;
     work->worklets.front()->output.buffers.clear();
@@ -208,6 +252,9 @@ void C2SoftFlacDec::process(
     if (inSize == 0) {
         fillEmptyWork(work);
         if (eos) {
+            if (mLargeFrameBlock) {
+                outputLargeFrame(work);
+            }
             mSignalledOutputEos = true;
             ALOGV("signalled EOS");
         }
@@ -237,6 +284,9 @@ void C2SoftFlacDec::process(
         mInputBufferCount++;
         fillEmptyWork(work);
         if (eos) {
+            if (mLargeFrameBlock) {
+                outputLargeFrame(work);
+            }
             mSignalledOutputEos = true;
             ALOGV("signalled EOS");
         }
@@ -281,6 +331,15 @@ void C2SoftFlacDec::process(
             mStreamInfo.max_blocksize * mStreamInfo.channels * sampleSize
           : kMaxBlockSize * FLACDecoder::kMaxChannels * sampleSize;
 
+    if (mIntf->getLargeFrameMaxSize() > 0) {
+        processLargeFrame(work, pool, input, inSize, outSize, outputFloat);
+        return;
+    }
+    if (mLargeFrameBlock) {
+        // Large frame output was disabled; deliver what is pending ahead of this frame.
+        sendLargeFrame(work);
+    }
+
     std::shared_ptr<C2LinearBlock> block;
     C2MemoryUsage usage = { C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE };
     c2_status_t err = pool->fetchLinearBlock(outSize, usage, &block);
@@ -317,6 +376,85 @@ void C2SoftFlacDec::process(
     }
 }
 
+void C2SoftFlacDec::processLargeFrame(
+        const std::unique_ptr<C2Work> &work,
+        const std::shared_ptr<C2BlockPool> &pool,
+        uint8_t *input, size_t inSize, size_t outSize, bool outputFloat) {
+    bool eos = (work->input.flags & C2FrameData::FLAG_END_OF_STREAM) != 0;
+    if (mLargeFrameBlock && mLargeFrameSize + outSize > mLargeFrameBlock->capacity()) {
+        // This frame may not fit in the pending output buffer.
+        sendLargeFrame(work);
+    }
+    if (!mLargeFrameBlock) {
+        size_t capacity = std::max<size_t>(mIntf->getLargeFrameMaxSize(), outSize);
+        C2MemoryUsage usage = { C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE };
+        c2_status_t err = pool->fetchLinearBlock(capacity, usage, &mLargeFrameBlock);
+        if (err != C2_OK) {
+            ALOGE("fetchLinearBlock for large frame output failed with status %d", err);
+            mLargeFrameBlock.reset();
+            work->result = C2_NO_MEMORY;
+            return;
+        }
+        mLargeFrameView = std::make_unique<C2WriteView>(mLargeFrameBlock->map().get());
+        if (mLargeFrameView->error()) {
+            ALOGE("write view map failed %d", mLargeFrameView->error());
+            resetLargeFrame();
+            work->result = C2_CORRUPTED;
+            return;
+        }
+    }
+
+    size_t frameSize = outSize;
+    status_t decoderErr = mFLACDecoder->decodeOneFrame(
+            input, inSize, mLargeFrameView->data() + mLargeFrameSize, &frameSize, outputFloat);
+    if (decoderErr != OK) {
+        ALOGE("process: FLACDecoder decodeOneFrame returns error %d", decoderErr);
+        mSignalledError = true;
+        work->result = C2_CORRUPTED;
+        return;
+    }
+    mInputBufferCount++;
+    mLargeFrameInfos.emplace_back(
+            (uint32_t)work->input.flags, frameSize, work->input.ordinal.timestamp.peekll());
+    mLargeFrameSize += frameSize;
+    ALOGV("large frame attr. size %zu frames %zu", mLargeFrameSize, mLargeFrameInfos.size());
+
+    fillEmptyWork(work);
+    uint32_t thresholdSize = mIntf->getLargeFrameThresholdSize();
+    if (thresholdSize == 0) {
+        thresholdSize = mIntf->getLargeFrameMaxSize();
+    }
+    if (eos || mLargeFrameSize >= thresholdSize) {
+        outputLargeFrame(work);
+    }
+    if (eos) {
+        mSignalledOutputEos = true;
+        ALOGV("signalled EOS");
+    }
+}
+
+void C2SoftFlacDec::outputLargeFrame(const std::unique_ptr<C2Work> &work) {
+    C2WorkOrdinalStruct ordinal = work->input.ordinal;
+    ordinal.timestamp = mLargeFrameInfos.front().timestamp;
+    work->worklets.front()->output.buffers.clear();
+    work->worklets.front()->output.buffers.push_back(takeLargeFrame());
+    work->worklets.front()->output.ordinal = ordinal;
+}
+
+void C2SoftFlacDec::sendLargeFrame(const std::unique_ptr<C2Work> &work) {
+    C2WorkOrdinalStruct ordinal = work->input.ordinal;
+    ordinal.timestamp = mLargeFrameInfos.front().timestamp;
+    std::shared_ptr<C2Buffer> buffer = takeLargeFrame();
+    cloneAndSend(work->input.ordinal.frameIndex.peeku(), work,
+            [buffer, ordinal](const std::unique_ptr<C2Work> &clone) {
+                clone->worklets.front()->output.flags = C2FrameData::FLAG_INCOMPLETE;
+                clone->worklets.front()->output.buffers.clear();
+                clone->worklets.front()->output.buffers.push_back(buffer);
+                clone->worklets.front()->output.ordinal = ordinal;
+                clone->workletsProcessed = 1u;
+            });
+}
+
 c2_status_t C2SoftFlacDec::drain(
         uint32_t drainMode,
         const std::shared_ptr<C2BlockPool> &pool) {
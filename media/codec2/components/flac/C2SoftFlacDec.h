@@ -17,6 +17,9 @@
 #ifndef ANDROID_C2_SOFT_FLAC_DEC_H_
 #define ANDROID_C2_SOFT_FLAC_DEC_H_
 
+#include <memory>
+#include <vector>
+
 #include <SimpleC2Component.h>
 
 #include "FLACDecoder.h"
@@ -56,8 +59,25 @@ private:
     bool mHasStreamInfo;
     size_t mInputBufferCount;
 
+    // Large frame output: decoded frames accumulated in one output buffer.
+    std::shared_ptr<C2LinearBlock> mLargeFrameBlock;
+    std::unique_ptr<C2WriteView> mLargeFrameView;
+    size_t mLargeFrameSize;
+    std::vector<C2AccessUnitInfosStruct> mLargeFrameInfos;
+
     status_t initDecoder();
 
+    void processLargeFrame(
+            const std::unique_ptr<C2Work> &work,
+            const std::shared_ptr<C2BlockPool> &pool,
+            uint8_t *input, size_t inSize, size_t outSize, bool outputFloat);
+    // Attaches the pending large frame to the output of work.
+    void outputLargeFrame(const std::unique_ptr<C2Work> &work);
+    // Sends the pending large frame in a clone of work, ahead of it.
+    void sendLargeFrame(const std::unique_ptr<C2Work> &work);
+    std::shared_ptr<C2Buffer> takeLargeFrame();
+    void resetLargeFrame();
+
     C2_DO_NOT_COPY(C2SoftFlacDec);
 };
 
@@ -476,19 +476,6 @@ c2_status_t C2SoftGav1Dec::onFlush_sm() {
   return C2_OK;
 }
 
-static int GetCPUCoreCount() {
-  int cpuCoreCount = 1;
-#if defined(_SC_NPROCESSORS_ONLN)
-  cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
-#else
-  // _SC_NPROC_ONLN must be defined...
-  cpuCoreCount = sysconf(_SC_NPROC_ONLN);
-#endif
-  CHECK(cpuCoreCount >= 1);
-  ALOGV("Number of CPU cores: %d", cpuCoreCount);
-  return cpuCoreCount;
-}
-
 bool C2SoftGav1Dec::initDecoder() {
   mSignalledError = false;
   mSignalledOutputEos = false;
@@ -505,7 +492,7 @@ bool C2SoftGav1Dec::initDecoder() {
   }
 
   libgav1::DecoderSettings settings = {};
-  settings.threads = GetCPUCoreCount();
+  settings.threads = acquireThreadShare(SIZE_MAX);
 
   ALOGV("Using libgav1 AV1 software decoder.");
   Libgav1StatusCode status = mCodecCtx->Init(&settings);
@@ -517,7 +504,10 @@ bool C2SoftGav1Dec::initDecoder() {
   return true;
 }
 
-void C2SoftGav1Dec::destroyDecoder() { mCodecCtx = nullptr; }
+void C2SoftGav1Dec::destroyDecoder() {
+  releaseThreadShare();
+  mCodecCtx = nullptr;
+}
 
 void fillEmptyWork(const std::unique_ptr<C2Work> &work) {
   uint32_t flags = 0;
@@ -32,6 +32,18 @@ namespace android {
 constexpr size_t kMinInputBufferSize = 2 * 1024 * 1024;
 constexpr size_t kMaxDimension = 1920;
 constexpr char COMPONENT_NAME[] = "c2.android.mpeg2.decoder";
+// Picture height, in macroblock rows, decoded by each thread.
+constexpr uint32_t kMinMbRowsPerThread = 8;
+
+enum : C2Param::type_index_t {
+    kParamIndexMpeg2DecNumThreads = C2Param::TYPE_INDEX_VENDOR_START,
+};
+
+// Maximum number of decoding threads (vendor.mpeg2-dec.num-threads.value). 0, the default,
+// picks a number suited to the picture size.
+typedef C2GlobalParam<C2Tuning, C2Uint32Value, kParamIndexMpeg2DecNumThreads>
+        C2Mpeg2DecNumThreadsTuning;
+constexpr char C2_PARAMKEY_MPEG2_DEC_NUM_THREADS[] = "mpeg2-dec.num-threads";
 
 class C2SoftMpeg2Dec::IntfImpl : public SimpleInterface<void>::BaseParams {
 public:
@@ -184,6 +196,13 @@ public:
                 .withConstValue(new C2StreamPixelFormatInfo::output(
                                      0u, HAL_PIXEL_FORMAT_YCBCR_420_888))
                 .build());
+
+        addParameter(
+                DefineParam(mNumThreads, C2_PARAMKEY_MPEG2_DEC_NUM_THREADS)
+                .withDefault(new C2Mpeg2DecNumThreadsTuning(0u))
+                .withFields({C2F(mNumThreads, value).inRange(0, MAX_NUM_CORES)})
+                .withSetter(Setter<decltype(*mNumThreads)>::NonStrictValueWithNoDeps)
+                .build());
     }
 
     static C2R SizeSetter(bool mayBlock, const C2P<C2StreamPictureSizeInfo::output> &oldMe,
@@ -279,6 +298,8 @@ public:
         return mColorAspects;
     }
 
+    uint32_t getNumThreads() const { return mNumThreads->value; }
+
 private:
     std::shared_ptr<C2StreamProfileLevelInfo::input> mProfileLevel;
     std::shared_ptr<C2StreamPictureSizeInfo::output> mSize;
@@ -289,21 +310,9 @@ private:
     std::shared_ptr<C2StreamColorAspectsTuning::output> mDefaultColorAspects;
     std::shared_ptr<C2StreamColorAspectsInfo::output> mColorAspects;
     std::shared_ptr<C2StreamPixelFormatInfo::output> mPixelFormat;
+    std::shared_ptr<C2Mpeg2DecNumThreadsTuning> mNumThreads;
 };
 
-static size_t getCpuCoreCount() {
-    long cpuCoreCount = 1;
-#if defined(_SC_NPROCESSORS_ONLN)
-    cpuCoreCount = sysconf(_SC_NPROCESSORS_ONLN);
-#else
-    // _SC_NPROC_ONLN must be defined...
-    cpuCoreCount = sysconf(_SC_NPROC_ONLN);
-#endif
-    CHECK(cpuCoreCount >= 1);
-    ALOGV("Number of CPU cores: %ld", cpuCoreCount);
-    return (size_t)cpuCoreCount;
-}
-
 static void *ivd_aligned_malloc(WORD32 alignment, WORD32 size) {
     return memalign(alignment, size);
 }
@@ -495,6 +504,15 @@ status_t C2SoftMpeg2Dec::createDecoder() {
 }
 
 status_t C2SoftMpeg2Dec::setNumCores() {
+    // libmpeg2 splits each picture into bands of macroblock rows, so small pictures do not
+    // gain from many threads.
+    size_t maxThreads = mIntf->getNumThreads();
+    if (maxThreads == 0) {
+        maxThreads = c2_max(((mHeight + 15) / 16) / kMinMbRowsPerThread, 1u);
+    }
+    mNumCores = acquireThreadShare(c2_min(maxThreads, (size_t)MAX_NUM_CORES));
+    ALOGV("using %zu threads for %ux%u", mNumCores, mWidth, mHeight);
+
     ivdext_ctl_set_num_cores_ip_t s_set_num_cores_ip;
     ivdext_ctl_set_num_cores_op_t s_set_num_cores_op;
 
@@ -571,7 +589,6 @@ status_t C2SoftMpeg2Dec::initDecoder() {
 
     if (OK != createDecoder()) return UNKNOWN_ERROR;
 
-    mNumCores = MIN(getCpuCoreCount(), MAX_NUM_CORES);
     mStride = ALIGN128(mWidth);
     mSignalledError = false;
     resetPlugin();
@@ -738,6 +755,7 @@ void C2SoftMpeg2Dec::resetPlugin() {
 }
 
 status_t C2SoftMpeg2Dec::deleteDecoder() {
+    releaseThreadShare();
     if (mMemRecords) {
         iv_mem_rec_t *ps_mem_rec = mMemRecords;
 
@@ -987,6 +1005,7 @@ void C2SoftMpeg2Dec::process(
 
                 ALOGI("Configuring decoder out: mWidth %d , mHeight %d ",
                        mWidth, mHeight);
+                (void) setNumCores();
                 C2StreamPictureSizeInfo::output size(0u, mWidth, mHeight);
                 std::vector<std::unique_ptr<C2SettingResult>> failures;
                 c2_status_t err =
@@ -18,6 +18,8 @@
 #define LOG_TAG "C2SoftOpusEnc"
 #include <utils/Log.h>
 
+#include <algorithm>
+
 #include <C2PlatformSupport.h>
 #include <SimpleC2Interface.h>
 #include <media/stagefright/foundation/MediaDefs.h>
@@ -35,10 +37,16 @@ namespace android {
 namespace {
 
 constexpr char COMPONENT_NAME[] = "c2.android.opus.encoder";
+constexpr bool kHostIsLittleEndian = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
 
 }  // namespace
 
 static const int kMaxNumChannelsSupported = 2;
+// Largest input buffer the client may ask for, one second of 48 kHz stereo audio. Large
+// inputs are encoded frame by frame within a single process() call.
+static const uint32_t kMaxInputBufferSize = 48000 * 2 * sizeof(int16_t);
+// Worst case size of an Opus packet (a 1275 byte frame plus its length) per channel.
+static const size_t kMaxPacketSizePerChannel = 1277;
 
 class C2SoftOpusEnc::IntfImpl : public SimpleInterface<void>::BaseParams {
 public:
@@ -106,7 +114,16 @@ public:
 
         addParameter(
                 DefineParam(mInputMaxBufSize, C2_PARAMKEY_INPUT_MAX_BUFFER_SIZE)
-                .withConstValue(new C2StreamMaxBufferSizeInfo::input(0u, 3840))
+                .withDefault(new C2StreamMaxBufferSizeInfo::input(0u, 3840))
+                .withFields({C2F(mInputMaxBufSize, value).inRange(3840, kMaxInputBufferSize)})
+                .withSetter(Setter<decltype(*mInputMaxBufSize)>::NonStrictValueWithNoDeps)
+                .build());
+
+        addParameter(
+                DefineParam(mInbandFec, C2_PARAMKEY_INBAND_FEC)
+                .withDefault(new C2StreamInbandFecTuning::output(0u, 0))
+                .withFields({C2F(mInbandFec, value).inRange(0, 100)})
+                .withSetter(Setter<decltype(*mInbandFec)>::NonStrictValueWithNoDeps)
                 .build());
     }
 
@@ -115,6 +132,7 @@ public:
     uint32_t getBitrate() const { return mBitrate->value; }
     uint32_t getBitrateMode() const { return mBitrateMode->value; }
     uint32_t getComplexity() const { return mComplexity->value; }
+    uint32_t getInbandFecPacketLoss() const { return mInbandFec->value; }
 
 private:
     std::shared_ptr<C2StreamSampleRateInfo::input> mSampleRate;
@@ -123,6 +141,7 @@ private:
     std::shared_ptr<C2StreamBitrateModeTuning::output> mBitrateMode;
     std::shared_ptr<C2StreamComplexityTuning::output> mComplexity;
     std::shared_ptr<C2StreamMaxBufferSizeInfo::input> mInputMaxBufSize;
+    std::shared_ptr<C2StreamInbandFecTuning::output> mInbandFec;
 };
 
 C2SoftOpusEnc::C2SoftOpusEnc(const char* name, c2_node_id_t id,
@@ -152,6 +171,7 @@ c2_status_t C2SoftOpusEnc::configureEncoder() {
     uint32_t bitrate = mIntf->getBitrate();
     uint32_t bitrateMode = mIntf->getBitrateMode();
     int complexity = mIntf->getComplexity();
+    uint32_t fecPacketLoss = mIntf->getInbandFecPacketLoss();
     mNumSamplesPerFrame = mSampleRate / (1000 / mFrameDurationMs);
     mNumPcmBytesPerInputFrame =
         mChannelCount * mNumSamplesPerFrame * sizeof(int16_t);
@@ -233,6 +253,18 @@ c2_status_t C2SoftOpusEnc::configureEncoder() {
         return C2_BAD_VALUE;
     }
 
+    // In-band FEC, only used by the SILK and hybrid modes when a packet loss is expected
+    if (opus_multistream_encoder_ctl(
+            mEncoder, OPUS_SET_INBAND_FEC(fecPacketLoss > 0 ? 1 : 0)) != OPUS_OK) {
+        ALOGE("failed to set inband fec");
+        return C2_BAD_VALUE;
+    }
+    if (opus_multistream_encoder_ctl(
+            mEncoder, OPUS_SET_PACKET_LOSS_PERC(fecPacketLoss)) != OPUS_OK) {
+        ALOGE("failed to set packet loss percentage");
+        return C2_BAD_VALUE;
+    }
+
     // Set seek preroll to 80 ms
     mSeekPreRoll = 80000000;
     return C2_OK;
@@ -367,8 +399,12 @@ void C2SoftOpusEnc::process(const std::unique_ptr<C2Work>& work,
         mIsFirstFrame = false;
     }
 
+    // All the frames of the input are encoded into a single block.
+    size_t numFrames = (mFilledLen + inSize) / mNumPcmBytesPerInputFrame + 1;
+    size_t outCapacity = std::max(
+            (size_t)kMaxPayload, numFrames * kMaxPacketSizePerChannel * mChannelCount);
     C2MemoryUsage usage = {C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE};
-    err = pool->fetchLinearBlock(kMaxPayload, usage, &mOutputBlock);
+    err = pool->fetchLinearBlock(outCapacity, usage, &mOutputBlock);
     if (err != C2_OK) {
         ALOGE("fetchLinearBlock for Output failed with status %d", err);
         work->result = C2_NO_MEMORY;
@@ -472,7 +508,14 @@ void C2SoftOpusEnc::process(const std::unique_ptr<C2Work>& work,
     while (inPos < inSize) {
         const uint8_t* pcmBytes = inPtr + inPos;
         int filledSamples = mFilledLen / sizeof(int16_t);
-        if ((inPos + (mNumPcmBytesPerInputFrame - mFilledLen)) <= inSize) {
+        // Whole frames of native (little endian) samples are encoded straight from the input.
+        const bool direct = kHostIsLittleEndian && mFilledLen == 0
+                && (inPos + mNumPcmBytesPerInputFrame) <= inSize
+                && (reinterpret_cast<uintptr_t>(pcmBytes) % alignof(int16_t)) == 0;
+        if (direct) {
+            processSize = mNumPcmBytesPerInputFrame;
+            mBufferAvailable = true;
+        } else if ((inPos + (mNumPcmBytesPerInputFrame - mFilledLen)) <= inSize) {
             processSize = mNumPcmBytesPerInputFrame - mFilledLen;
             mBufferAvailable = true;
         } else {
@@ -486,22 +529,27 @@ void C2SoftOpusEnc::process(const std::unique_ptr<C2Work>& work,
         }
         const unsigned nInputSamples = processSize / sizeof(int16_t);
 
-        for (unsigned i = 0; i < nInputSamples; i++) {
-            int32_t data = pcmBytes[2 * i + 1] << 8 | pcmBytes[2 * i];
-            data = ((data & 0xFFFF) ^ 0x8000) - 0x8000;
-            mInputBufferPcm16[i + filledSamples] = data;
+        if (!direct) {
+            for (unsigned i = 0; i < nInputSamples; i++) {
+                int32_t data = pcmBytes[2 * i + 1] << 8 | pcmBytes[2 * i];
+                data = ((data & 0xFFFF) ^ 0x8000) - 0x8000;
+                mInputBufferPcm16[i + filledSamples] = data;
+            }
         }
         inPos += processSize;
         mFilledLen += processSize;
         if (!mBufferAvailable) break;
+        const int16_t* pcm16 =
+            direct ? reinterpret_cast<const int16_t*>(pcmBytes) : mInputBufferPcm16;
         uint8_t* outPtr = wView.data() + mBytesEncoded;
+        int outSpace = (int)std::min(wView.capacity() - mBytesEncoded, (size_t)INT32_MAX);
         int encodedBytes =
-            opus_multistream_encode(mEncoder, mInputBufferPcm16,
-                                    mNumSamplesPerFrame, outPtr, kMaxPayload - mBytesEncoded);
+            opus_multistream_encode(mEncoder, pcm16,
+                                    mNumSamplesPerFrame, outPtr, outSpace);
         ALOGV("encoded %i Opus bytes from %zu PCM bytes", encodedBytes,
               processSize);
 
-        if (encodedBytes < 0 || encodedBytes > (kMaxPayload - mBytesEncoded)) {
+        if (encodedBytes < 0 || encodedBytes > outSpace) {
             ALOGE("opus_encode failed, encodedBytes : %d", encodedBytes);
             mSignalledError = true;
             work->result = C2_CORRUPTED;
@@ -263,6 +263,7 @@ c2_status_t C2SoftXaacDec::onInit() {
     mOutputDrainBufferWritePos = 0;
     mDRCFlag = 0;
     mMpegDDRCPresent = 0;
+    mBypassMpegDDrc = false;
     mMemoryVec.clear();
     mDrcMemoryVec.clear();
 
@@ -897,6 +898,11 @@ status_t C2SoftXaacDec::initXAACDrc() {
 
     RETURN_IF_FATAL(err_code, "IA_ENHAACPLUS_DEC_DRC_EFFECT_TYPE");
 
+    // With DRC off and no target loudness the MPEG-D DRC stage leaves the samples unchanged,
+    // e.g. when transcoding, so do not run it on every frame.
+    mBypassMpegDDrc = (effectType == C2Config::DRC_EFFECT_OFF && targetRefLevel == -1);
+    ALOGV("MPEG-D DRC stage %s", mBypassMpegDDrc ? "bypassed" : "enabled");
+
     return IA_NO_ERROR;
 }
 
@@ -1323,7 +1329,7 @@ IA_ERRORCODE C2SoftXaacDec::decodeXAACStream(uint8_t* inBuffer,
       int32_t preroll_frame_offset = 0;
 
         do {
-            if (ui_exec_done != 1) {
+            if (ui_exec_done != 1 && !mBypassMpegDDrc) {
                 VOID* p_array;        // ITTIAM:buffer to handle gain payload
                 WORD32 buf_size = 0;  // ITTIAM:gain payload length
                 WORD32 bit_str_fmt = 1;
@@ -1376,7 +1382,7 @@ IA_ERRORCODE C2SoftXaacDec::decodeXAACStream(uint8_t* inBuffer,
                                         outBytes);
             RETURN_IF_FATAL(err_code,  "IA_API_CMD_GET_OUTPUT_BYTES");
 
-            if (mMpegDDRCPresent == 1) {
+            if (mMpegDDRCPresent == 1 && !mBypassMpegDDrc) {
                 memcpy(mDrcInBuf, mOutputBuffer + preroll_frame_offset, *outBytes);
                 preroll_frame_offset += *outBytes;
                 err_code = ia_drc_dec_api(mMpegDDrcHandle, IA_API_CMD_SET_INPUT_BYTES, 0, outBytes);
@@ -89,6 +89,8 @@ private:
     int8_t* mDrcOutBuf;
     int32_t mMpegDDRCPresent;
     int32_t mDRCFlag;
+    // Neither DRC nor loudness normalization is requested, the MPEG-D DRC stage is skipped.
+    bool mBypassMpegDDrc;
 
     Vector<void*> mMemoryVec;
     Vector<void*> mDrcMemoryVec;
@@ -284,6 +284,13 @@ enum C2ParamIndexKind : C2Param::type_index_t {
 
     // allow tunnel peek behavior to be unspecified for app compatibility
     kParamIndexTunnelPeekMode, // tunnel mode, enum
+
+    // multiple access units per output buffer
+    kParamIndexLargeFrame, // struct
+    kParamIndexAccessUnitInfos, // struct[]
+
+    // in-band forward error correction for audio encoders
+    kParamIndexInbandFec, // uint32
 };
 
 }
@@ -2054,6 +2061,16 @@ typedef C2StreamParam<C2Info, C2SimpleValueStruct<C2Config::aac_sbr_mode_t>, kPa
         C2StreamAacSbrModeTuning;
 constexpr char C2_PARAMKEY_AAC_SBR_MODE[] = "coding.aac-sbr-mode";
 
+/**
+ * In-band forward error correction. Used during encoding.
+ *
+ * The value is the expected packet loss rate (in percent) the encoder protects the stream
+ * against by embedding redundant data of the previous frame into each frame. 0 disables in-band
+ * FEC. Only codecs supporting in-band FEC (e.g. Opus) advertise this parameter.
+ */
+typedef C2StreamParam<C2Tuning, C2Uint32Value, kParamIndexInbandFec> C2StreamInbandFecTuning;
+constexpr char C2_PARAMKEY_INBAND_FEC[] = "coding.inband-fec";
+
 /**
  * DRC Compression. Used during decoding.
  */
@@ -2146,6 +2163,60 @@ typedef C2StreamParam<C2Info, C2Uint32Value, kParamIndexAudioFrameSize>
         C2StreamAudioFrameSizeInfo;
 constexpr char C2_PARAMKEY_AUDIO_FRAME_SIZE[] = "raw.audio-frame-size";
 
+/**
+ * Large frame output.
+ *
+ * Audio decoders can expose this parameter to deliver multiple decoded access units in each
+ * output buffer. A buffer is completed when it holds at least thresholdSize bytes, or before
+ * the next access unit would make it exceed maxSize bytes; it is always completed at the end
+ * of stream. maxSize of 0 disables large frame output, which is the default.
+ *
+ * Each output buffer then carries a C2AccessUnitInfos::output info with the flags, size and
+ * timestamp of each access unit it contains, in order.
+ */
+struct C2LargeFrameStruct {
+    uint32_t maxSize;       ///< maximum output buffer size in bytes, 0 to disable
+    uint32_t thresholdSize; ///< size in bytes at which an output buffer is completed
+
+    C2LargeFrameStruct()
+        : maxSize(0), thresholdSize(0) { }
+
+    C2LargeFrameStruct(uint32_t maxSize_, uint32_t thresholdSize_)
+        : maxSize(maxSize_), thresholdSize(thresholdSize_) { }
+
+    DEFINE_AND_DESCRIBE_C2STRUCT(LargeFrame)
+    C2FIELD(maxSize,       "max-size")
+    C2FIELD(thresholdSize, "threshold-size")
+};
+
+typedef C2StreamParam<C2Tuning, C2LargeFrameStruct, kParamIndexLargeFrame>
+        C2LargeFrame;
+constexpr char C2_PARAMKEY_OUTPUT_LARGE_FRAME[] = "output.large-frame";
+
+/**
+ * Access unit of a large frame output buffer.
+ */
+struct C2AccessUnitInfosStruct {
+    uint32_t flags;     ///< C2FrameData flags of the access unit
+    uint32_t size;      ///< size in bytes of the access unit in the buffer
+    int64_t timestamp;  ///< timestamp of the access unit
+
+    C2AccessUnitInfosStruct()
+        : flags(0), size(0), timestamp(0) { }
+
+    C2AccessUnitInfosStruct(uint32_t flags_, uint32_t size_, int64_t timestamp_)
+        : flags(flags_), size(size_), timestamp(timestamp_) { }
+
+    DEFINE_AND_DESCRIBE_C2STRUCT(AccessUnitInfos)
+    C2FIELD(flags,     "flags")
+    C2FIELD(size,      "size")
+    C2FIELD(timestamp, "timestamp")
+};
+
+typedef C2StreamParam<C2Info, C2SimpleArrayStruct<C2AccessUnitInfosStruct>,
+        kParamIndexAccessUnitInfos> C2AccessUnitInfos;
+constexpr char C2_PARAMKEY_OUTPUT_ACCESS_UNIT_INFOS[] = "output.access-unit-infos";
+
 /* --------------------------------------- AAC components --------------------------------------- */
 
 /**
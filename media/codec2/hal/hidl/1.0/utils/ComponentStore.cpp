@@ -26,6 +26,7 @@
 #include <media/stagefright/bqhelper/GraphicBufferSource.h>
 #include <utils/Errors.h>
 
+#include <C2DmaBufAllocator.h>
 #include <C2PlatformSupport.h>
 #include <util/C2InterfaceHelper.h>
 
@@ -471,6 +472,17 @@ Return<void> ComponentStore::debug(
             }
         }
 
+        // Dump CPU mapping statistics of dmabuf allocations.
+        {
+            C2DmaBufAllocator::MapStats stats = C2DmaBufAllocator::GetMapStats();
+            out << indent << "Dmabuf mappings:" << std::endl << std::endl;
+            out << indent << indent << "map cache: "
+                    << (stats.cacheEnabled ? "enabled" : "disabled") << std::endl;
+            out << indent << indent << "mmap: " << stats.mmaps
+                    << ", munmap: " << stats.munmaps
+                    << ", cached maps: " << stats.cachedMaps << std::endl << std::endl;
+        }
+
         out << "End of dump -- C2ComponentStore: "
                 << mStore->getName() << std::endl;
     }
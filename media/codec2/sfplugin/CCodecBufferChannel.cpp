@@ -25,6 +25,7 @@
 #include <atomic>
 #include <list>
 #include <numeric>
+#include <optional>
 #include <regex>
 
 #include <C2AllocatorGralloc.h>
@@ -54,6 +55,7 @@
 #include <media/stagefright/SurfaceUtils.h>
 #include <media/MediaCodecBuffer.h>
 #include <mediadrm/ICrypto.h>
+#include <mediautils/TraceFlow.h>
 #include <server_configurable_flags/get_flags.h>
 #include <system/window.h>
 
@@ -149,7 +151,10 @@ void CCodecBufferChannel::QueueSync::stop() {
 
 // Input
 
-CCodecBufferChannel::Input::Input() : extraBuffers("extra") {}
+CCodecBufferChannel::Input::Input()
+    : extraBuffers("extra"),
+      numQueuedBuffers(0),
+      numCopiedBuffers(0) {}
 
 // CCodecBufferChannel
 
@@ -269,6 +274,7 @@ status_t CCodecBufferChannel::queueInputBufferInternal(
         if (!input->buffers->releaseBuffer(buffer, &c2buffer, false)) {
             return -ENOENT;
         }
+        ++input->numQueuedBuffers;
         // TODO: we want to delay copying buffers.
         if (input->extraBuffers.numComponentBuffers() < input->numExtraSlots) {
             copy = input->buffers->cloneAndReleaseBuffer(buffer);
@@ -277,6 +283,7 @@ status_t CCodecBufferChannel::queueInputBufferInternal(
                 if (!input->extraBuffers.releaseSlot(copy, &c2buffer, false)) {
                     return UNKNOWN_ERROR;
                 }
+                ++input->numCopiedBuffers;
                 bool released = input->buffers->releaseBuffer(buffer, nullptr, true);
                 ALOGV("[%s] queueInputBuffer: buffer copied; %sreleased",
                       mName, released ? "" : "not ");
@@ -288,7 +295,7 @@ status_t CCodecBufferChannel::queueInputBufferInternal(
         }
         if (input->frameReassembler) {
             usesFrameReassembler = true;
-            input->frameReassembler.process(buffer, &items);
+            input->frameReassembler.process(buffer, &items, c2buffer);
         } else {
             int32_t cvo = 0;
             if (buffer->meta()->findInt32("cvo", &cvo)) {
@@ -353,8 +360,17 @@ status_t CCodecBufferChannel::queueInputBufferInternal(
     }
     c2_status_t err = C2_OK;
     if (!items.empty()) {
-        ScopedTrace trace(ATRACE_TAG, android::base::StringPrintf(
-                "CCodecBufferChannel::queue(%s@ts=%lld)", mName, (long long)timeUs).c_str());
+        // Only format the trace name when tracing, as this runs for every frame.
+        std::optional<ScopedTrace> trace;
+        if (ATRACE_ENABLED()) {
+            trace.emplace(ATRACE_TAG, android::base::StringPrintf(
+                    "CCodecBufferChannel::queue(%s@ts=%lld)", mName, (long long)timeUs).c_str());
+        }
+        for (const std::unique_ptr<C2Work> &work : items) {
+            // ended in onWorkDone() for the work carrying the same client timestamp
+            mediautils::traceFlowBegin(
+                    ATRACE_TAG, mName, work->input.ordinal.customOrdinal.peekll());
+        }
         {
             Mutexed<PipelineWatcher>::Locked watcher(mPipelineWatcher);
             PipelineWatcher::Clock::time_point now = PipelineWatcher::Clock::now();
@@ -1642,7 +1658,8 @@ status_t CCodecBufferChannel::start(
         watcher->inputDelay(inputDelayValue)
                 .pipelineDelay(pipelineDelayValue)
                 .outputDelay(outputDelayValue)
-                .smoothnessFactor(kSmoothnessFactor);
+                .smoothnessFactor(kSmoothnessFactor)
+                .adaptive(property_get_bool("debug.stagefright.ccodec_adaptive_pipeline", false));
         watcher->flush();
     }
 
@@ -1754,6 +1771,17 @@ status_t CCodecBufferChannel::requestInitialInputBuffers(
 void CCodecBufferChannel::stop() {
     mSync.stop();
     mFirstValidFrameIndex = mFrameIndex.load(std::memory_order_relaxed);
+
+    Mutexed<Input>::Locked input(mInput);
+    if (input->numQueuedBuffers > 0) {
+        ALOGD("[%s] %llu input buffers queued, %llu copied to extra slots (%.1f%% zero-copy)",
+              mName, (unsigned long long)input->numQueuedBuffers,
+              (unsigned long long)input->numCopiedBuffers,
+              100. * (input->numQueuedBuffers - input->numCopiedBuffers)
+                      / input->numQueuedBuffers);
+    }
+    input->numQueuedBuffers = 0;
+    input->numCopiedBuffers = 0;
 }
 
 void CCodecBufferChannel::stopUseOutputSurface(bool pushBlankBuffer) {
@@ -2144,8 +2172,12 @@ bool CCodecBufferChannel::handleWork(
         // When using input surface we need to restore the original input timestamp.
         timestamp = work->input.ordinal.customOrdinal;
     }
-    ScopedTrace trace(ATRACE_TAG, android::base::StringPrintf(
-            "CCodecBufferChannel::onWorkDone(%s@ts=%lld)", mName, timestamp.peekll()).c_str());
+    std::optional<ScopedTrace> trace;
+    if (ATRACE_ENABLED()) {
+        trace.emplace(ATRACE_TAG, android::base::StringPrintf(
+                "CCodecBufferChannel::onWorkDone(%s@ts=%lld)", mName, timestamp.peekll()).c_str());
+    }
+    mediautils::traceFlowEnd(ATRACE_TAG, mName, work->input.ordinal.customOrdinal.peekll());
     ALOGV("[%s] onWorkDone: input %lld, codec %lld => output %lld => %lld",
           mName,
           work->input.ordinal.customOrdinal.peekll(),
@@ -317,6 +317,10 @@ private:
         c2_cntr64_t lastFlushIndex;
 
         FrameReassembler frameReassembler;
+
+        // non-empty input buffers queued, and those copied to extra slots, since start
+        uint64_t numQueuedBuffers;
+        uint64_t numCopiedBuffers;
     };
     Mutexed<Input> mInput;
     struct Output {
@@ -18,6 +18,8 @@
 #define LOG_TAG "CCodecConfig"
 
 #include <initializer_list>
+#include <mutex>
+#include <tuple>
 
 #include <cutils/properties.h>
 #include <log/log.h>
@@ -229,6 +231,67 @@ AString QueryMediaType(
     }
 }
 
+/**
+ * Parameter and struct descriptors of a component. These are fixed for a component, but
+ * querying them takes an IPC per struct, so they are kept for the lifetime of the process.
+ */
+struct ComponentReflection {
+    std::vector<std::shared_ptr<C2ParamDescriptor>> paramDescs;
+
+    std::mutex lock;
+    std::map<C2Param::CoreIndex, std::shared_ptr<const C2StructDescriptor>> structDescs;
+};
+
+/**
+ * Reflector serving struct descriptors from a ComponentReflection, and falling back to the
+ * component store reflector for the ones not described yet.
+ */
+class CachingParamReflector : public C2ParamReflector {
+public:
+    CachingParamReflector(
+            const std::shared_ptr<C2ParamReflector> &base,
+            const std::shared_ptr<ComponentReflection> &cache)
+        : mBase(base), mCache(cache) { }
+
+    virtual std::unique_ptr<C2StructDescriptor> describe(
+            C2Param::CoreIndex coreIndex) const override {
+        {
+            std::lock_guard<std::mutex> lock(mCache->lock);
+            auto it = mCache->structDescs.find(coreIndex);
+            if (it != mCache->structDescs.end()) {
+                return std::make_unique<C2StructDescriptor>(*it->second);
+            }
+        }
+        std::unique_ptr<C2StructDescriptor> desc = mBase->describe(coreIndex);
+        if (desc) {
+            std::lock_guard<std::mutex> lock(mCache->lock);
+            mCache->structDescs.emplace(
+                    coreIndex, std::make_shared<const C2StructDescriptor>(*desc));
+        }
+        return desc;
+    }
+
+private:
+    std::shared_ptr<C2ParamReflector> mBase;
+    std::shared_ptr<ComponentReflection> mCache;
+};
+
+/**
+ * ComponentReflection objects of the components configured in this process, by component
+ * name, coding media type and domain.
+ */
+struct ComponentReflections {
+    typedef std::tuple<std::string, std::string, uint32_t> Key;
+
+    std::mutex lock;
+    std::map<Key, std::shared_ptr<ComponentReflection>> map;
+
+    static ComponentReflections &Get() {
+        static ComponentReflections *sReflections = new ComponentReflections;
+        return *sReflections;
+    }
+};
+
 }  // namespace
 
 /**
@@ -339,6 +402,29 @@ CCodecConfig::CCodecConfig()
       mPushBlankBuffersOnStop(false) { }
 
 void CCodecConfig::initializeStandardParams() {
+    // The mappings only depend on the coding media type. Instances get their own copy, as the
+    // mappers for a key may be updated for a specific configuration.
+    struct StandardParamsCache {
+        std::mutex lock;
+        std::map<std::string, std::shared_ptr<const StandardParams>> map;
+    };
+    static StandardParamsCache *sCache = new StandardParamsCache;
+    {
+        std::lock_guard<std::mutex> lock(sCache->lock);
+        auto it = sCache->map.find(mCodingMediaType);
+        if (it != sCache->map.end()) {
+            mStandardParams = std::make_shared<StandardParams>(*it->second);
+            return;
+        }
+    }
+
+    buildStandardParams();
+
+    std::lock_guard<std::mutex> lock(sCache->lock);
+    sCache->map.emplace(mCodingMediaType, std::make_shared<const StandardParams>(*mStandardParams));
+}
+
+void CCodecConfig::buildStandardParams() {
     typedef Domain D;
     mStandardParams = std::make_shared<StandardParams>();
     std::function<void(const ConfigMapper &)> add =
@@ -716,6 +802,12 @@ void CCodecConfig::initializeStandardParams() {
         .limitTo(D::AUDIO & D::READ)
         .withMappers(pcmEncodingMapper, pcmEncodingReverse));
 
+    add(ConfigMapper(KEY_BUFFER_BATCH_MAX_OUTPUT_SIZE, C2_PARAMKEY_OUTPUT_LARGE_FRAME, "max-size")
+        .limitTo(D::AUDIO & D::DECODER & (D::CONFIG | D::PARAM | D::READ)));
+    add(ConfigMapper(KEY_BUFFER_BATCH_THRESHOLD_OUTPUT_SIZE, C2_PARAMKEY_OUTPUT_LARGE_FRAME,
+                     "threshold-size")
+        .limitTo(D::AUDIO & D::DECODER & (D::CONFIG | D::PARAM | D::READ)));
+
     add(ConfigMapper(KEY_IS_ADTS, C2_PARAMKEY_AAC_PACKAGING, "value")
         .limitTo(D::AUDIO & D::CODED)
         .withMappers([](C2Value v) -> C2Value {
@@ -958,6 +1050,9 @@ void CCodecConfig::initializeStandardParams() {
             }
         }));
 
+    add(ConfigMapper("inband-fec-packet-loss", C2_PARAMKEY_INBAND_FEC, "value")
+        .limitTo(D::AUDIO & D::ENCODER & (D::CONFIG | D::READ)));
+
     add(ConfigMapper("android._encoding-quality-level", C2_PARAMKEY_ENCODING_QUALITY_LEVEL, "value")
         .limitTo(D::ENCODER & (D::CONFIG | D::PARAM)));
     add(ConfigMapper(KEY_QUALITY, C2_PARAMKEY_QUALITY, "value")
@@ -1091,11 +1186,36 @@ status_t CCodecConfig::initialize(
         mCodingMediaType = "";
     }
 
-    c2err = configurable->querySupportedParams(&mParamDescs);
-    if (c2err != C2_OK) {
-        ALOGD("Query supported params failed after returning %zu values => %s",
-                mParamDescs.size(), asString(c2err));
-        return UNKNOWN_ERROR;
+    // parameter and struct descriptors are only queried for the first instance of a component
+    const bool useReflectionCache =
+        property_get_bool("debug.stagefright.ccodec_reflection_cache", true);
+    const ComponentReflections::Key reflectionKey{
+            configurable->getName(), mCodingMediaType, uint32_t(mDomain)};
+    std::shared_ptr<ComponentReflection> reflection;
+    if (useReflectionCache) {
+        ComponentReflections &reflections = ComponentReflections::Get();
+        std::lock_guard<std::mutex> lock(reflections.lock);
+        auto it = reflections.map.find(reflectionKey);
+        if (it != reflections.map.end()) {
+            reflection = it->second;
+        }
+    }
+    if (reflection) {
+        mParamDescs = reflection->paramDescs;
+    } else {
+        c2err = configurable->querySupportedParams(&mParamDescs);
+        if (c2err != C2_OK) {
+            ALOGD("Query supported params failed after returning %zu values => %s",
+                    mParamDescs.size(), asString(c2err));
+            return UNKNOWN_ERROR;
+        }
+        if (useReflectionCache) {
+            reflection = std::make_shared<ComponentReflection>();
+            reflection->paramDescs = mParamDescs;
+            ComponentReflections &reflections = ComponentReflections::Get();
+            std::lock_guard<std::mutex> lock(reflections.lock);
+            reflection = reflections.map.emplace(reflectionKey, reflection).first->second;
+        }
     }
     for (const std::shared_ptr<C2ParamDescriptor> &desc : mParamDescs) {
         mSupportedIndices.emplace(desc->index());
@@ -1106,6 +1226,9 @@ status_t CCodecConfig::initialize(
         ALOGE("Null param reflector");
         return UNKNOWN_ERROR;
     }
+    if (reflection) {
+        mReflector = std::make_shared<CachingParamReflector>(reflector, reflection);
+    }
 
     // enumerate all fields
     mParamUpdater = std::make_shared<ReflectedParamUpdater>();
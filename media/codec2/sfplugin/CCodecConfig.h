@@ -374,9 +374,13 @@ struct CCodecConfig {
 
 private:
 
-    /// initializes the standard MediaCodec to Codec 2.0 params mapping
+    /// initializes the standard MediaCodec to Codec 2.0 params mapping, from the mapping
+    /// built for a previous instance with the same coding media type if any
     void initializeStandardParams();
 
+    /// builds the standard MediaCodec to Codec 2.0 params mapping
+    void buildStandardParams();
+
     /// Gets SDK format from codec 2.0 reflected configuration
     /// \param domain input/output bitmask
     sp<AMessage> getFormatForDomain(
@@ -86,12 +86,22 @@ FrameReassembler::operator bool() const {
 
 c2_status_t FrameReassembler::process(
         const sp<MediaCodecBuffer> &buffer,
-        std::list<std::unique_ptr<C2Work>> *items) {
+        std::list<std::unique_ptr<C2Work>> *items,
+        const std::shared_ptr<C2Buffer> &source) {
     int64_t timeUs;
     if (!buffer->meta()->findInt64("timeUs", &timeUs)) {
         return C2_BAD_VALUE;
     }
 
+    // Whole frames may be shared from |source| only if it holds exactly the data of |buffer|.
+    std::optional<C2ConstLinearBlock> sourceBlock;
+    const size_t sourceSize = buffer->size();
+    if (source && source->data().type() == C2BufferData::LINEAR
+            && source->data().linearBlocks().size() == 1u
+            && source->data().linearBlocks().front().size() == sourceSize) {
+        sourceBlock = source->data().linearBlocks().front();
+    }
+
     items->splice(items->end(), mPendingWork);
 
     // Fill mCurrentBlock
@@ -150,7 +160,12 @@ c2_status_t FrameReassembler::process(
         LOG_ALWAYS_FATAL_IF(
                 mCurrentBlock,
                 "There's remaining data but the pending block is not filled & finished");
-        std::unique_ptr<C2Work> work(new C2Work);
+        if (sourceBlock && buffer->size() >= frameSizeBytes) {
+            size_t offset = sourceBlock->offset() + (sourceSize - buffer->size());
+            queueBlock(sourceBlock->subBlock(offset, frameSizeBytes), source, items);
+            buffer->setRange(buffer->offset() + frameSizeBytes, buffer->size() - frameSizeBytes);
+            continue;
+        }
         c2_status_t err = mBlockPool->fetchLinearBlock(frameSizeBytes, mUsage, &mCurrentBlock);
         if (err != C2_OK) {
             return err;
@@ -209,10 +224,32 @@ void FrameReassembler::finishCurrentBlock(std::list<std::unique_ptr<C2Work>> *it
                 mWriteView->capacity() - mWriteView->size());
         mWriteView->setSize(mWriteView->capacity());
     }
+    queueBlock(mCurrentBlock->share(0, mCurrentBlock->capacity(), C2Fence()), nullptr, items);
+    mCurrentBlock.reset();
+    mWriteView.reset();
+}
+
+void FrameReassembler::queueBlock(
+        const C2ConstLinearBlock &block,
+        const std::shared_ptr<C2Buffer> &owner,
+        std::list<std::unique_ptr<C2Work>> *items) {
+    std::shared_ptr<C2Buffer> buffer = C2Buffer::CreateLinearBuffer(block);
+    if (owner) {
+        // The client may reuse the memory of |owner| once it is destroyed; keep it alive
+        // until the component is done with this frame.
+        std::shared_ptr<C2Buffer> *ref = new std::shared_ptr<C2Buffer>(owner);
+        c2_status_t err = buffer->registerOnDestroyNotify(
+                [](const C2Buffer *, void *arg) {
+                    delete static_cast<std::shared_ptr<C2Buffer> *>(arg);
+                },
+                ref);
+        if (err != C2_OK) {
+            delete ref;
+        }
+    }
     std::unique_ptr<C2Work> work{std::make_unique<C2Work>()};
     work->input.ordinal = mCurrentOrdinal;
-    work->input.buffers.push_back(C2Buffer::CreateLinearBuffer(
-            mCurrentBlock->share(0, mCurrentBlock->capacity(), C2Fence())));
+    work->input.buffers.push_back(buffer);
     work->worklets.clear();
     work->worklets.emplace_back(new C2Worklet);
     items->push_back(std::move(work));
@@ -220,8 +257,6 @@ void FrameReassembler::finishCurrentBlock(std::list<std::unique_ptr<C2Work>> *it
     ++mCurrentOrdinal.frameIndex;
     mCurrentOrdinal.timestamp += mFrameSize.value() * 1000000 / mSampleRate;
     mCurrentOrdinal.customOrdinal = mCurrentOrdinal.timestamp;
-    mCurrentBlock.reset();
-    mWriteView.reset();
 }
 
 }  // namespace android
@@ -47,9 +47,18 @@ public:
 
     explicit operator bool() const;
 
+    /**
+     * Splits |buffer| into frames of the encoder frame size, and appends the completed ones
+     * to |items|.
+     *
+     * If |source| is the C2Buffer holding the data of |buffer| in a single linear block,
+     * whole frames are shared from it with the component instead of being copied. |source|
+     * is then kept alive until the component releases the last of these frames.
+     */
     c2_status_t process(
             const sp<MediaCodecBuffer> &buffer,
-            std::list<std::unique_ptr<C2Work>> *items);
+            std::list<std::unique_ptr<C2Work>> *items,
+            const std::shared_ptr<C2Buffer> &source = nullptr);
 
 private:
     std::shared_ptr<C2BlockPool> mBlockPool;
@@ -68,6 +77,10 @@ private:
     uint32_t bytesPerSample() const;
 
     void finishCurrentBlock(std::list<std::unique_ptr<C2Work>> *items);
+    void queueBlock(
+            const C2ConstLinearBlock &block,
+            const std::shared_ptr<C2Buffer> &owner,
+            std::list<std::unique_ptr<C2Work>> *items);
 };
 
 }  // namespace android
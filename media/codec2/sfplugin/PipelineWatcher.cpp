@@ -17,6 +17,7 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "PipelineWatcher"
 
+#include <algorithm>
 #include <numeric>
 
 #include <log/log.h>
@@ -42,9 +43,27 @@ PipelineWatcher &PipelineWatcher::outputDelay(uint32_t value) {
 
 PipelineWatcher &PipelineWatcher::smoothnessFactor(uint32_t value) {
     mSmoothnessFactor = value;
+    mAdaptiveSmoothness = value;
+    resetWindow();
     return *this;
 }
 
+PipelineWatcher &PipelineWatcher::adaptive(bool value) {
+    mAdaptive = value;
+    mAdaptiveSmoothness = mSmoothnessFactor;
+    resetWindow();
+    return *this;
+}
+
+uint32_t PipelineWatcher::smoothness() const {
+    return mAdaptive ? mAdaptiveSmoothness : mSmoothnessFactor;
+}
+
+void PipelineWatcher::resetWindow() {
+    mWindowSize = 0;
+    mWindowMinFrames = SIZE_MAX;
+}
+
 void PipelineWatcher::onWorkQueued(
         uint64_t frameIndex,
         std::vector<std::shared_ptr<C2Buffer>> &&buffers,
@@ -91,17 +110,53 @@ void PipelineWatcher::onWorkDone(uint64_t frameIndex) {
               (unsigned long long)frameIndex);
         return;
     }
+    Clock::duration latency = Clock::now() - it->second.queuedAt;
+    mAverageLatency = mAverageLatency == Clock::duration::zero()
+            ? latency : (mAverageLatency * 7 + latency) / 8;
     (void)mFramesInPipeline.erase(it);
+
+    if (!mAdaptive || !mThrottled) {
+        return;
+    }
+    if (mFramesInPipeline.empty()) {
+        // The component ran dry while the client was held back.
+        if (mAdaptiveSmoothness < mSmoothnessFactor) {
+            ++mAdaptiveSmoothness;
+            ALOGV("onWorkDone: pipeline drained; smoothness raised to %u", mAdaptiveSmoothness);
+        }
+        resetWindow();
+        return;
+    }
+    mWindowMinFrames = std::min(mWindowMinFrames, mFramesInPipeline.size());
+    if (++mWindowSize < kAdaptiveWindow) {
+        return;
+    }
+    // There was always more work than the component holds for its delays plus the
+    // one in progress, so one extra work item can go.
+    if (mAdaptiveSmoothness > 0
+            && mWindowMinFrames > mInputDelay + mPipelineDelay + mOutputDelay + 1) {
+        --mAdaptiveSmoothness;
+        ALOGV("onWorkDone: at least %zu frames in pipeline; smoothness lowered to %u",
+              mWindowMinFrames, mAdaptiveSmoothness);
+    }
+    resetWindow();
 }
 
 void PipelineWatcher::flush() {
     ALOGV("flush");
     mFramesInPipeline.clear();
+    mThrottled = false;
+    resetWindow();
 }
 
 bool PipelineWatcher::pipelineFull() const {
+    mThrottled = isPipelineFull(smoothness());
+    return mThrottled;
+}
+
+bool PipelineWatcher::isPipelineFull(uint32_t smoothnessFactor) const {
     if (mFramesInPipeline.size() >=
-            mInputDelay + mPipelineDelay + mOutputDelay + mSmoothnessFactor) {
+            mInputDelay + mPipelineDelay + mOutputDelay + smoothnessFactor) {
         ALOGV("pipelineFull: too many frames in pipeline (%zu)", mFramesInPipeline.size());
         return true;
     }
@@ -117,14 +172,14 @@ bool PipelineWatcher::pipelineFull() const {
                 return true;
             });
     if (sizeWithInputReleased >=
-            mPipelineDelay + mOutputDelay + mSmoothnessFactor) {
+            mPipelineDelay + mOutputDelay + smoothnessFactor) {
         ALOGV("pipelineFull: too many frames in pipeline, with input released (%zu)",
               sizeWithInputReleased);
         return true;
     }
 
     size_t sizeWithInputsPending = mFramesInPipeline.size() - sizeWithInputReleased;
-    if (sizeWithInputsPending > mPipelineDelay + mInputDelay + mSmoothnessFactor) {
+    if (sizeWithInputsPending > mPipelineDelay + mInputDelay + smoothnessFactor) {
         ALOGV("pipelineFull: too many inputs pending (%zu) in pipeline, with inputs released (%zu)",
               sizeWithInputsPending, sizeWithInputReleased);
         return true;
@@ -17,9 +17,12 @@
 #ifndef PIPELINE_WATCHER_H_
 #define PIPELINE_WATCHER_H_
 
+#include <stdint.h>
+
 #include <chrono>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <C2Work.h>
 
@@ -37,7 +40,13 @@ public:
         : mInputDelay(0),
           mPipelineDelay(0),
           mOutputDelay(0),
-          mSmoothnessFactor(0) {}
+          mSmoothnessFactor(0),
+          mAdaptive(false),
+          mAdaptiveSmoothness(0),
+          mThrottled(false),
+          mWindowSize(0),
+          mWindowMinFrames(SIZE_MAX),
+          mAverageLatency(Clock::duration::zero()) {}
     ~PipelineWatcher() = default;
 
     /**
@@ -64,6 +73,17 @@ public:
      */
     PipelineWatcher &smoothnessFactor(uint32_t value);
 
+    /**
+     * In adaptive mode, the smoothness factor is only an upper bound: the
+     * number of extra work items in the pipeline starts there, shrinks while
+     * the component always has work left when it finishes one, and grows when
+     * the component runs dry while the client is held back by pipelineFull().
+     *
+     * \param value true to enable adaptive mode
+     * \return  this object
+     */
+    PipelineWatcher &adaptive(bool value);
+
     /**
      * Client queued a work item to the component.
      *
@@ -117,12 +137,38 @@ public:
      */
     Clock::duration elapsed(const Clock::time_point &now, size_t n) const;
 
+    /**
+     * \return  the smoothness factor currently in effect.
+     */
+    uint32_t smoothness() const;
+
+    /**
+     * \return  moving average of the time from queueing a work item to its
+     *          completion.
+     */
+    Clock::duration averageLatency() const { return mAverageLatency; }
+
 private:
+    // number of completed work items to observe before shrinking the pipeline
+    static constexpr size_t kAdaptiveWindow = 32;
+
     uint32_t mInputDelay;
     uint32_t mPipelineDelay;
     uint32_t mOutputDelay;
     uint32_t mSmoothnessFactor;
 
+    bool mAdaptive;
+    uint32_t mAdaptiveSmoothness;
+    // true if the last pipelineFull() call held the client back
+    mutable bool mThrottled;
+    // completed work items, and fewest left in the pipeline after one, while throttled
+    size_t mWindowSize;
+    size_t mWindowMinFrames;
+    Clock::duration mAverageLatency;
+
+    void resetWindow();
+    bool isPipelineFull(uint32_t smoothnessFactor) const;
+
     struct Frame {
         Frame(std::vector<std::shared_ptr<C2Buffer>> &&b,
               const Clock::time_point &q)
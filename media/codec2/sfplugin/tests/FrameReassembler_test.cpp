@@ -45,6 +45,7 @@ public:
     }
 
     status_t initStatus() const { return mInitStatus; }
+    const std::shared_ptr<C2BlockPool> &pool() const { return mPool; }
 
     void testPushSameSize(
             size_t encoderFrameSize,
@@ -378,4 +379,53 @@ TEST_F(FrameReassemblerTest, PushBigChunk) {
     }
 }
 
+// Push a buffer backed by a linear block; whole frames should be shared from it.
+TEST_F(FrameReassemblerTest, ShareWholeFramesFromSource) {
+    ASSERT_EQ(OK, initStatus());
+    constexpr size_t kFrameSize = 1024;
+    constexpr size_t kFrameSizeInBytes = kFrameSize * 2 /* bytes/sample */;
+    constexpr size_t kInputSize = kFrameSizeInBytes * 5 / 2;
+
+    FrameReassembler frameReassembler;
+    frameReassembler.init(pool(), kUsage, kFrameSize, 48000, 1, PCM_16);
+    ASSERT_TRUE(frameReassembler) << "FrameReassembler init failed";
+
+    std::shared_ptr<C2LinearBlock> block;
+    ASSERT_EQ(C2_OK, pool()->fetchLinearBlock(kInputSize, kUsage, &block));
+    C2WriteView writeView = block->map().get();
+    ASSERT_EQ(C2_OK, writeView.error());
+    sp<MediaCodecBuffer> buffer = new MediaCodecBuffer(new AMessage, new ABuffer(kInputSize));
+    for (size_t i = 0; i < kInputSize; ++i) {
+        writeView.base()[i] = buffer->base()[i] = (i & 0xFF);
+    }
+    buffer->setRange(0, kInputSize);
+    buffer->meta()->setInt64("timeUs", 0);
+    buffer->meta()->setInt32("eos", 1);
+    std::shared_ptr<C2Buffer> source =
+        C2Buffer::CreateLinearBuffer(block->share(0, kInputSize, C2Fence()));
+    std::weak_ptr<C2Buffer> weakSource = source;
+
+    std::list<std::unique_ptr<C2Work>> items;
+    ASSERT_EQ(C2_OK, frameReassembler.process(buffer, &items, source));
+    source.reset();
+    ASSERT_EQ(3u, items.size());
+
+    size_t outputIndex = 0;
+    for (const std::unique_ptr<C2Work> &work : items) {
+        ASSERT_EQ(1u, work->input.buffers.size());
+        C2ReadView view = work->input.buffers.front()->data().linearBlocks().front().map().get();
+        ASSERT_EQ(C2_OK, view.error());
+        ASSERT_EQ(kFrameSizeInBytes, view.capacity());
+        for (size_t j = 0; j < view.capacity(); ++j, ++outputIndex) {
+            uint8_t expected = outputIndex < kInputSize ? (outputIndex & 0xFF) : 0;
+            ASSERT_EQ(expected, view.data()[j]) << "output index = " << outputIndex;
+        }
+    }
+
+    // The source must stay alive while the shared frames are in use.
+    EXPECT_FALSE(weakSource.expired());
+    items.clear();
+    EXPECT_TRUE(weakSource.expired());
+}
+
 } // namespace android
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PipelineWatcher.h"
+
+#include <gtest/gtest.h>
+
+namespace android {
+
+class PipelineWatcherTest : public ::testing::Test {
+protected:
+    void queue(uint64_t frameIndex) {
+        mWatcher.onWorkQueued(frameIndex, {}, PipelineWatcher::Clock::now());
+    }
+
+    // Queues work while the pipeline has room, and returns the number of work items queued.
+    size_t fill() {
+        size_t count = 0;
+        while (!mWatcher.pipelineFull()) {
+            queue(mNextIndex++);
+            ++count;
+        }
+        return count;
+    }
+
+    PipelineWatcher mWatcher;
+    uint64_t mNextIndex = 0;
+    uint64_t mNextDone = 0;
+};
+
+TEST_F(PipelineWatcherTest, FixedSmoothness) {
+    mWatcher.inputDelay(0).pipelineDelay(1).outputDelay(0).smoothnessFactor(4);
+    EXPECT_EQ(5u, fill());
+    EXPECT_EQ(4u, mWatcher.smoothness());
+
+    // Without adaptive mode, draining the pipeline does not change anything.
+    while (mNextDone < mNextIndex) {
+        mWatcher.onWorkDone(mNextDone++);
+    }
+    EXPECT_EQ(4u, mWatcher.smoothness());
+    EXPECT_EQ(5u, fill());
+}
+
+TEST_F(PipelineWatcherTest, AdaptiveShrinksWithSlackAndGrowsWhenDrained) {
+    mWatcher.inputDelay(0).pipelineDelay(0).outputDelay(0).smoothnessFactor(4).adaptive(true);
+    EXPECT_EQ(4u, fill());
+
+    // The client keeps the pipeline full: one work item completes, one is queued.
+    // There is always more work pending than the component needs, so the
+    // smoothness goes down until only the work item in progress is left after
+    // each completion.
+    for (int i = 0; i < 1000; ++i) {
+        mWatcher.onWorkDone(mNextDone++);
+        fill();
+    }
+    EXPECT_EQ(2u, mWatcher.smoothness());
+    EXPECT_GT(mWatcher.averageLatency(), PipelineWatcher::Clock::duration::zero());
+
+    // The component ran dry while the client was held back.
+    while (mNextDone < mNextIndex) {
+        mWatcher.onWorkDone(mNextDone++);
+    }
+    EXPECT_EQ(3u, mWatcher.smoothness());
+
+    // Never above the configured smoothness factor.
+    for (int i = 0; i < 10; ++i) {
+        fill();
+        while (mNextDone < mNextIndex) {
+            mWatcher.onWorkDone(mNextDone++);
+        }
+    }
+    EXPECT_EQ(4u, mWatcher.smoothness());
+}
+
+TEST_F(PipelineWatcherTest, AdaptiveIgnoresDrainWhenNotThrottled) {
+    mWatcher.inputDelay(0).pipelineDelay(0).outputDelay(0).smoothnessFactor(4).adaptive(true);
+    for (int i = 0; i < 1000; ++i) {
+        mWatcher.onWorkDone(mNextDone++);
+        fill();
+    }
+    const uint32_t smoothness = mWatcher.smoothness();
+
+    // The client is slow: it queues one work item at a time, and the pipeline drains.
+    mWatcher.flush();
+    mNextDone = mNextIndex;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_FALSE(mWatcher.pipelineFull());
+        queue(mNextIndex++);
+        mWatcher.onWorkDone(mNextDone++);
+    }
+    EXPECT_EQ(smoothness, mWatcher.smoothness());
+}
+
+}  // namespace android
@@ -286,6 +286,11 @@ public:
         return std::make_shared<C2PooledBlockPool>(mLinearAllocator, mBlockPoolId++);
     }
 
+    std::shared_ptr<C2BasicLinearBlockPool> makeRecyclingLinearBlockPool(
+            const C2BasicLinearBlockPool::RecycleLimits &limits) {
+        return std::make_shared<C2BasicLinearBlockPool>(mLinearAllocator, limits);
+    }
+
     void allocateGraphic(uint32_t width, uint32_t height) {
         c2_status_t err = mGraphicAllocator->newGraphicAllocation(
                 width,
@@ -432,6 +437,58 @@ TEST_F(C2BufferTest, BlockPoolTest) {
     }
 }
 
+TEST_F(C2BufferTest, RecyclingBlockPoolTest) {
+    constexpr C2MemoryUsage kUsage = { C2MemoryUsage::CPU_READ, C2MemoryUsage::CPU_WRITE };
+    std::shared_ptr<C2BasicLinearBlockPool> blockPool(
+            makeRecyclingLinearBlockPool({ 2u /* maxBlocks */, 1024u * 1024u /* maxBytes */ }));
+
+    std::shared_ptr<C2LinearBlock> block;
+    ASSERT_EQ(C2_OK, blockPool->fetchLinearBlock(1000u, kUsage, &block));
+    ASSERT_TRUE(block);
+    // The block has the requested capacity, not the one of its size class.
+    ASSERT_EQ(1000u, block->capacity());
+    const C2Handle *handle = block->handle();
+    block.reset();
+
+    C2BasicLinearBlockPool::Stats stats = blockPool->getStats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.retainedBlocks);
+    EXPECT_EQ(1024u, stats.retainedBytes);
+
+    // A fetch in the same size class reuses the allocation.
+    ASSERT_EQ(C2_OK, blockPool->fetchLinearBlock(900u, kUsage, &block));
+    ASSERT_EQ(900u, block->capacity());
+    EXPECT_EQ(handle, block->handle());
+    C2WriteView writeView = block->map().get();
+    ASSERT_EQ(C2_OK, writeView.error());
+    ASSERT_EQ(900u, writeView.capacity());
+
+    stats = blockPool->getStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(0u, stats.retainedBlocks);
+
+    // Only maxBlocks allocations are kept.
+    std::vector<std::shared_ptr<C2LinearBlock>> blocks(3);
+    for (std::shared_ptr<C2LinearBlock> &b : blocks) {
+        ASSERT_EQ(C2_OK, blockPool->fetchLinearBlock(4096u, kUsage, &b));
+    }
+    blocks.clear();
+    stats = blockPool->getStats();
+    EXPECT_EQ(2u, stats.retainedBlocks);
+    EXPECT_EQ(8192u, stats.retainedBytes);
+
+    blockPool->trim();
+    stats = blockPool->getStats();
+    EXPECT_EQ(0u, stats.retainedBlocks);
+    EXPECT_EQ(0u, stats.retainedBytes);
+
+    // Blocks may outlive the pool.
+    blockPool.reset();
+    writeView.data()[0] = 0;
+    block.reset();
+}
+
 void fillPlane(const C2Rect rect, const C2PlaneInfo info, uint8_t *addr, uint8_t value) {
     for (uint32_t row = 0; row < rect.height / info.rowSampling; ++row) {
         int32_t rowOffset = (row + rect.top / info.rowSampling) * info.rowInc;
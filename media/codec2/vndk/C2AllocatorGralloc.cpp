@@ -21,6 +21,7 @@
 #include <mutex>
 
 #include <aidl/android/hardware/graphics/common/PlaneLayoutComponentType.h>
+#include <android-base/properties.h>
 #include <android/hardware/graphics/common/1.2/types.h>
 #include <cutils/native_handle.h>
 #include <gralloctypes/Gralloc4.h>
@@ -58,6 +59,13 @@ static bool isAtLeastT() {
     return android_get_device_api_level() >= __ANDROID_API_T__;
 }
 
+// Whether an allocation stays locked after a read-only view is unmapped, so that the next
+// view with the same rect and usage reuses the lock and its layout.
+static bool isReadLockCacheEnabled() {
+    static bool sEnabled = base::GetBoolProperty("media.c2.gralloc.read-lock-cache", true);
+    return sEnabled;
+}
+
 C2MemoryUsage C2AndroidMemoryUsage::FromGrallocUsage(uint64_t usage) {
     // gralloc does not support WRITE_PROTECTED
     return C2MemoryUsage(
@@ -380,6 +388,19 @@ private:
     bool mLocked;
     C2Allocator::id_t mAllocatorId;
     std::mutex mMappedLock;
+
+    // A read-only lock kept after unmap(), and the result of the map() that took it.
+    struct CachedLock {
+        bool cacheable = false;  // the current lock may be kept after unmap()
+        bool held = false;       // the buffer is still locked while not mapped
+        C2Rect rect;
+        uint64_t grallocUsage = 0;
+        C2PlanarLayout layout = {};
+        uint8_t *addr[C2PlanarLayout::MAX_NUM_PLANES] = {};
+    };
+    CachedLock mCachedLock;
+
+    c2_status_t unlock_l();
 };
 
 C2AllocationGralloc::C2AllocationGralloc(
@@ -405,10 +426,9 @@ C2AllocationGralloc::C2AllocationGralloc(
 }
 
 C2AllocationGralloc::~C2AllocationGralloc() {
-    if (mBuffer && mLocked) {
-        // implementation ignores addresss and rect
-        uint8_t* addr[C2PlanarLayout::MAX_NUM_PLANES] = {};
-        unmap(addr, C2Rect(), nullptr);
+    if (mBuffer && (mLocked || mCachedLock.held)) {
+        std::lock_guard<std::mutex> lock(mMappedLock);
+        (void)unlock_l();
     }
     if (mBuffer) {
         status_t err = GraphicBufferMapper::get().freeBuffer(mBuffer);
@@ -451,6 +471,26 @@ c2_status_t C2AllocationGralloc::map(
         return C2_BAD_VALUE;
     }
 
+    if (mCachedLock.held) {
+        const C2Rect &cached = mCachedLock.rect;
+        if (grallocUsage == mCachedLock.grallocUsage
+                && c2Rect.left == cached.left && c2Rect.top == cached.top
+                && c2Rect.width == cached.width && c2Rect.height == cached.height) {
+            ALOGV("reusing read lock");
+            *layout = mCachedLock.layout;
+            for (size_t i = 0; i < C2PlanarLayout::MAX_NUM_PLANES; ++i) {
+                addr[i] = mCachedLock.addr[i];
+            }
+            mCachedLock.held = false;
+            mLocked = true;
+            return C2_OK;
+        }
+        c2_status_t err = unlock_l();
+        if (err != C2_OK) {
+            return err;
+        }
+    }
+
     if (!mBuffer) {
         status_t err = GraphicBufferMapper::get().importBuffer(
                             mHidlHandle.getNativeHandle(), mWidth, mHeight, mLayerCount,
@@ -900,6 +940,18 @@ c2_status_t C2AllocationGralloc::map(
               i, plane.colInc, plane.rowInc, plane.rootIx, plane.offset);
     }
 
+    // Only read locks are kept: after a CPU write, the buffer must be unlocked to flush it.
+    mCachedLock.cacheable = isReadLockCacheEnabled()
+            && (usage.expected & C2MemoryUsage::CPU_WRITE) == 0;
+    if (mCachedLock.cacheable) {
+        mCachedLock.rect = c2Rect;
+        mCachedLock.grallocUsage = grallocUsage;
+        mCachedLock.layout = *layout;
+        for (size_t i = 0; i < C2PlanarLayout::MAX_NUM_PLANES; ++i) {
+            mCachedLock.addr[i] = addr[i];
+        }
+    }
+
     return C2_OK;
 }
 
@@ -911,6 +963,19 @@ c2_status_t C2AllocationGralloc::unmap(
     (void)fence;
 
     std::lock_guard<std::mutex> lock(mMappedLock);
+    if (mLocked && mCachedLock.cacheable) {
+        // Keep the buffer locked for the next read-only view; the CPU did not write to it,
+        // so there is nothing to flush and no release fence to return.
+        mCachedLock.held = true;
+        mLocked = false;
+        return C2_OK;
+    }
+    return unlock_l();
+}
+
+c2_status_t C2AllocationGralloc::unlock_l() {
+    mCachedLock.held = false;
+    mCachedLock.cacheable = false;
     // TODO: fence
     status_t err = GraphicBufferMapper::get().unlock(mBuffer);
     if (err) {
@@ -21,6 +21,7 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <vector>
 
 #include <C2AllocatorBlob.h>
 #include <C2AllocatorGralloc.h>
@@ -329,27 +330,157 @@ C2ConstLinearBlock C2LinearBlock::share(size_t offset_, size_t size_, C2Fence fe
     return ConstLinearBlockBuddy(mImpl, C2LinearRange(*this, offset_, size_), fence);
 }
 
+/**
+ * Free lists of a recycling C2BasicLinearBlockPool.
+ *
+ * Blocks fetched from a recycling pool hold their allocation through a shared pointer whose
+ * deleter returns the allocation here, if the pool is still alive and within its limits.
+ */
+class C2BasicLinearBlockPool::Recycler
+        : public std::enable_shared_from_this<C2BasicLinearBlockPool::Recycler> {
+public:
+    explicit Recycler(const RecycleLimits &limits) : mLimits(limits) { }
+
+    static uint32_t SizeClass(uint32_t capacity) {
+        uint32_t sizeClass = 1u;
+        while (sizeClass < capacity && sizeClass < (1u << 31)) {
+            sizeClass <<= 1;
+        }
+        return sizeClass < capacity ? capacity : sizeClass;
+    }
+
+    /**
+     * Returns a kept allocation of |sizeClass| bytes for |usage|, wrapped so that it comes
+     * back to this recycler when released, or nullptr if there is none.
+     */
+    std::shared_ptr<C2LinearAllocation> take(uint32_t sizeClass, C2MemoryUsage usage) {
+        std::shared_ptr<C2LinearAllocation> alloc;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            auto it = mFreeLists.find(Key(sizeClass, usage));
+            if (it == mFreeLists.end() || it->second.empty()) {
+                ++mStats.misses;
+                return nullptr;
+            }
+            alloc = std::move(it->second.back());
+            it->second.pop_back();
+            --mStats.retainedBlocks;
+            mStats.retainedBytes -= sizeClass;
+            ++mStats.hits;
+        }
+        return wrap(std::move(alloc), sizeClass, usage);
+    }
+
+    std::shared_ptr<C2LinearAllocation> wrap(
+            std::shared_ptr<C2LinearAllocation> alloc, uint32_t sizeClass, C2MemoryUsage usage) {
+        C2LinearAllocation *raw = alloc.get();
+        std::weak_ptr<Recycler> weakThis = shared_from_this();
+        return std::shared_ptr<C2LinearAllocation>(
+                raw, [weakThis, alloc, sizeClass, usage](C2LinearAllocation *) mutable {
+                    if (std::shared_ptr<Recycler> thiz = weakThis.lock()) {
+                        thiz->put(std::move(alloc), sizeClass, usage);
+                    }
+                });
+    }
+
+    Stats getStats() {
+        std::lock_guard<std::mutex> lock(mLock);
+        return mStats;
+    }
+
+    void trim() {
+        std::map<std::pair<uint32_t, uint64_t>,
+                 std::vector<std::shared_ptr<C2LinearAllocation>>> freeLists;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            std::swap(freeLists, mFreeLists);
+            mStats.retainedBlocks = 0;
+            mStats.retainedBytes = 0;
+        }
+        // |freeLists| is destroyed without the lock, as freeing may be slow.
+    }
+
+private:
+    static std::pair<uint32_t, uint64_t> Key(uint32_t sizeClass, C2MemoryUsage usage) {
+        // C2MemoryUsage::CPU_READ and CPU_WRITE are also part of expected.
+        return { sizeClass, usage.expected };
+    }
+
+    void put(std::shared_ptr<C2LinearAllocation> alloc, uint32_t sizeClass, C2MemoryUsage usage) {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mStats.retainedBlocks < mLimits.maxBlocks
+                && mStats.retainedBytes + sizeClass <= mLimits.maxBytes) {
+            mFreeLists[Key(sizeClass, usage)].push_back(std::move(alloc));
+            ++mStats.retainedBlocks;
+            mStats.retainedBytes += sizeClass;
+        }
+        // Otherwise |alloc| is freed on return.
+    }
+
+    const RecycleLimits mLimits;
+    std::mutex mLock;
+    std::map<std::pair<uint32_t, uint64_t>,
+             std::vector<std::shared_ptr<C2LinearAllocation>>> mFreeLists;
+    Stats mStats{};
+};
+
 C2BasicLinearBlockPool::C2BasicLinearBlockPool(
         const std::shared_ptr<C2Allocator> &allocator)
   : mAllocator(allocator) { }
 
+C2BasicLinearBlockPool::C2BasicLinearBlockPool(
+        const std::shared_ptr<C2Allocator> &allocator, const RecycleLimits &limits)
+  : mAllocator(allocator),
+    mRecycler((limits.maxBlocks > 0 && limits.maxBytes > 0)
+            ? std::make_shared<Recycler>(limits) : nullptr) { }
+
 c2_status_t C2BasicLinearBlockPool::fetchLinearBlock(
         uint32_t capacity,
         C2MemoryUsage usage,
         std::shared_ptr<C2LinearBlock> *block /* nonnull */) {
     block->reset();
 
-    std::shared_ptr<C2LinearAllocation> alloc;
-    c2_status_t err = mAllocator->newLinearAllocation(capacity, usage, &alloc);
-    if (err != C2_OK) {
-        return err;
+    if (!mRecycler) {
+        std::shared_ptr<C2LinearAllocation> alloc;
+        c2_status_t err = mAllocator->newLinearAllocation(capacity, usage, &alloc);
+        if (err != C2_OK) {
+            return err;
+        }
+
+        *block = _C2BlockFactory::CreateLinearBlock(alloc);
+
+        return C2_OK;
+    }
+
+    const uint32_t sizeClass = Recycler::SizeClass(capacity);
+    std::shared_ptr<C2LinearAllocation> alloc = mRecycler->take(sizeClass, usage);
+    if (!alloc) {
+        c2_status_t err = mAllocator->newLinearAllocation(sizeClass, usage, &alloc);
+        if (err != C2_OK) {
+            return err;
+        }
+        alloc = mRecycler->wrap(std::move(alloc), sizeClass, usage);
     }
 
-    *block = _C2BlockFactory::CreateLinearBlock(alloc);
+    // The block only exposes the requested capacity of the size class.
+    *block = _C2BlockFactory::CreateLinearBlock(alloc, nullptr, 0, capacity);
+    if (!*block) {
+        return C2_NO_MEMORY;
+    }
 
     return C2_OK;
 }
 
+C2BasicLinearBlockPool::Stats C2BasicLinearBlockPool::getStats() const {
+    return mRecycler ? mRecycler->getStats() : Stats{};
+}
+
+void C2BasicLinearBlockPool::trim() {
+    if (mRecycler) {
+        mRecycler->trim();
+    }
+}
+
 struct C2_HIDE C2PooledBlockPoolData : _C2BlockPoolData {
 
     virtual type_t getType() const override {
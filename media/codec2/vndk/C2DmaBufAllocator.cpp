@@ -23,11 +23,14 @@
 #include <C2DmaBufAllocator.h>
 #include <C2ErrnoUtils.h>
 
+#include <linux/dma-buf.h>
 #include <linux/ion.h>
+#include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <unistd.h>  // getpagesize, size_t, close, dup
 #include <utils/Log.h>
 
+#include <atomic>
 #include <list>
 
 #include <android-base/properties.h>
@@ -40,6 +43,17 @@ namespace {
 
     // max padding after ion/dmabuf allocations in bytes
     constexpr uint32_t MAX_PADDING = 0x8000; // 32KB
+
+    std::atomic<uint64_t> sMmapCount{0};
+    std::atomic<uint64_t> sMunmapCount{0};
+    std::atomic<uint64_t> sCachedMapCount{0};
+
+    // Whether an allocation keeps its CPU mapping from one view to the next.
+    bool IsMapCacheEnabled() {
+        // NOTE: read this property directly, like media.c2.dmabuf.padding.
+        static bool sEnabled = base::GetBoolProperty("media.c2.dmabuf.map-cache", true);
+        return sEnabled;
+    }
 }
 
 /* =========================== BUFFER HANDLE =========================== */
@@ -142,6 +156,7 @@ class C2DmaBufAllocation : public C2LinearAllocation {
                                     int prot, int flags, void** base, void** addr) {
         c2_status_t err = C2_OK;
         *base = mmap(nullptr, mapSize, prot, flags, mHandle.bufferFd(), mapOffset);
+        ++sMmapCount;
         ALOGV("mmap(size = %zu, prot = %d, flags = %d, mapFd = %d, offset = %zu) "
               "returned (%d)",
               mapSize, prot, flags, mHandle.bufferFd(), mapOffset, errno);
@@ -164,6 +179,26 @@ class C2DmaBufAllocation : public C2LinearAllocation {
     };
     Mutexed<std::list<Mapping>> mMappings;
 
+    // Mapping of the whole allocation kept across views, if the map cache is enabled.
+    // Each view of it brackets its CPU access with DMA_BUF_IOCTL_SYNC.
+    struct CachedMapping {
+        void* base = nullptr;
+        size_t size = 0;
+        int prot = PROT_NONE;
+        struct View {
+            void* addr;
+            size_t size;
+            uint64_t syncFlags;
+        };
+        std::list<View> views;
+    };
+    Mutexed<CachedMapping> mCachedMapping;
+
+    // Returns C2_OMITTED if the request cannot be served from the cached mapping.
+    c2_status_t mapCached(size_t offset, size_t size, int prot, void** addr);
+    c2_status_t unmapCached(void* addr, size_t size);
+    void syncCpuAccess(uint64_t flags);
+
     // TODO: we could make this encapsulate shared_ptr and copiable
     C2_DO_NOT_COPY(C2DmaBufAllocation);
 };
@@ -192,6 +227,13 @@ c2_status_t C2DmaBufAllocation::map(size_t offset, size_t size, C2MemoryUsage us
         prot |= PROT_WRITE;
     }
 
+    if (IsMapCacheEnabled()) {
+        c2_status_t err = mapCached(offset, size, prot, addr);
+        if (err != C2_OMITTED) {
+            return err;
+        }
+    }
+
     size_t alignmentBytes = offset % PAGE_SIZE;
     size_t mapOffset = offset - alignmentBytes;
     size_t mapSize = size + alignmentBytes;
@@ -205,7 +247,79 @@ c2_status_t C2DmaBufAllocation::map(size_t offset, size_t size, C2MemoryUsage us
     return err;
 }
 
+c2_status_t C2DmaBufAllocation::mapCached(size_t offset, size_t size, int prot, void** addr) {
+    if (offset > mHandle.size() || size > mHandle.size() - offset) {
+        return C2_OMITTED;
+    }
+    Mutexed<CachedMapping>::Locked cached(mCachedMapping);
+    if (cached->base && (cached->prot & prot) != prot) {
+        if (!cached->views.empty()) {
+            // The mapping lacks access needed here, but is in use.
+            return C2_OMITTED;
+        }
+        munmap(cached->base, cached->size);
+        ++sMunmapCount;
+        prot |= cached->prot;
+        cached->base = nullptr;
+    }
+    if (!cached->base) {
+        void* base = nullptr;
+        void* unused = nullptr;
+        c2_status_t err = mapInternal(mHandle.size(), 0, 0, prot, MAP_SHARED, &base, &unused);
+        if (err != C2_OK) {
+            return err;
+        }
+        cached->base = base;
+        cached->size = mHandle.size();
+        cached->prot = prot;
+    } else {
+        ++sCachedMapCount;
+    }
+
+    uint64_t syncFlags = 0;
+    if (prot & PROT_READ) {
+        syncFlags |= DMA_BUF_SYNC_READ;
+    }
+    if (prot & PROT_WRITE) {
+        syncFlags |= DMA_BUF_SYNC_WRITE;
+    }
+    syncCpuAccess(DMA_BUF_SYNC_START | syncFlags);
+    *addr = (uint8_t*)cached->base + offset;
+    cached->views.push_back({*addr, size, syncFlags});
+    return C2_OK;
+}
+
+c2_status_t C2DmaBufAllocation::unmapCached(void* addr, size_t size) {
+    Mutexed<CachedMapping>::Locked cached(mCachedMapping);
+    for (auto it = cached->views.begin(); it != cached->views.end(); ++it) {
+        if (it->addr == addr && it->size == size) {
+            syncCpuAccess(DMA_BUF_SYNC_END | it->syncFlags);
+            (void)cached->views.erase(it);
+            return C2_OK;
+        }
+    }
+    return C2_NOT_FOUND;
+}
+
+void C2DmaBufAllocation::syncCpuAccess(uint64_t flags) {
+    struct dma_buf_sync sync = { flags };
+    int ret;
+    do {
+        ret = ioctl(mHandle.bufferFd(), DMA_BUF_IOCTL_SYNC, &sync);
+    } while (ret < 0 && (errno == EINTR || errno == EAGAIN));
+    if (ret < 0) {
+        ALOGV("DMA_BUF_IOCTL_SYNC(%#llx) failed (%d)", (unsigned long long)flags, errno);
+    }
+}
+
 c2_status_t C2DmaBufAllocation::unmap(void* addr, size_t size, C2Fence* fence) {
+    if (IsMapCacheEnabled() && unmapCached(addr, size) == C2_OK) {
+        if (fence) {
+            *fence = C2Fence();  // not using fences
+        }
+        // The cached mapping stays until the allocation is destroyed.
+        return C2_OK;
+    }
     Mutexed<std::list<Mapping>>::Locked mappings(mMappings);
     if (mappings->empty()) {
         ALOGD("tried to unmap unmapped buffer");
@@ -217,6 +331,7 @@ c2_status_t C2DmaBufAllocation::unmap(void* addr, size_t size, C2Fence* fence) {
             continue;
         }
         int err = munmap(it->addr, it->size);
+        ++sMunmapCount;
         if (err != 0) {
             ALOGD("munmap failed");
             return c2_map_errno<EINVAL>(errno);
@@ -260,9 +375,19 @@ C2DmaBufAllocation::~C2DmaBufAllocation() {
         ALOGD("Dangling mappings!");
         for (const Mapping& map : *mappings) {
             int err = munmap(map.addr, map.size);
+            ++sMunmapCount;
             if (err) ALOGD("munmap failed");
         }
     }
+    Mutexed<CachedMapping>::Locked cached(mCachedMapping);
+    if (cached->base) {
+        if (!cached->views.empty()) {
+            ALOGD("Dangling views of cached mapping!");
+        }
+        int err = munmap(cached->base, cached->size);
+        ++sMunmapCount;
+        if (err) ALOGD("munmap failed");
+    }
     if (mInit == C2_OK) {
         native_handle_close(&mHandle);
     }
@@ -440,4 +565,9 @@ bool C2DmaBufAllocator::CheckHandle(const C2Handle* const o) {
     return C2HandleBuf::IsValid(o);
 }
 
+// static
+C2DmaBufAllocator::MapStats C2DmaBufAllocator::GetMapStats() {
+    return {IsMapCacheEnabled(), sMmapCount.load(), sMunmapCount.load(), sCachedMapCount.load()};
+}
+
 }  // namespace android
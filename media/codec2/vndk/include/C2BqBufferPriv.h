@@ -103,6 +103,12 @@ public:
 
     virtual void getConsumerUsage(uint64_t *consumerUsage);
 
+    /**
+     * Returns the total time fetchGraphicBlock() spent waiting for a buffer, in microseconds,
+     * and the number of fetches that could not return a buffer in time.
+     */
+    virtual void getStallStats(uint64_t *stallUs, uint64_t *stallCount);
+
     /**
      * Invalidate the class.
      *
@@ -24,8 +24,35 @@
 
 class C2BasicLinearBlockPool : public C2BlockPool {
 public:
+    /**
+     * Bounds of the allocations kept by a recycling pool.
+     *
+     * A recycling pool keeps the allocation of a block when the last reference to the block is
+     * dropped, and reuses it for a later fetch of the same size class and usage instead of
+     * allocating. Size classes are powers of two; the fetched block still has the requested
+     * capacity.
+     *
+     * Recycling is only correct if no one else still uses the memory once the last block
+     * reference is dropped in this process, e.g. if the blocks are not sent to another
+     * process.
+     */
+    struct RecycleLimits {
+        size_t maxBlocks;   ///< maximum number of allocations kept
+        size_t maxBytes;    ///< maximum total capacity of the allocations kept
+    };
+
+    struct Stats {
+        uint64_t hits;          ///< fetches served from a kept allocation
+        uint64_t misses;        ///< fetches that allocated
+        size_t retainedBlocks;  ///< allocations currently kept
+        size_t retainedBytes;   ///< total capacity of the allocations currently kept
+    };
+
     explicit C2BasicLinearBlockPool(const std::shared_ptr<C2Allocator> &allocator);
 
+    C2BasicLinearBlockPool(
+            const std::shared_ptr<C2Allocator> &allocator, const RecycleLimits &limits);
+
     virtual ~C2BasicLinearBlockPool() override = default;
 
     virtual C2Allocator::id_t getAllocatorId() const override {
@@ -43,8 +70,22 @@ public:
 
     // TODO: fetchCircularBlock
 
+    /**
+     * Returns the recycling statistics of this pool. All values are 0 for a pool that does not
+     * recycle.
+     */
+    Stats getStats() const;
+
+    /**
+     * Frees the allocations kept for recycling.
+     */
+    void trim();
+
 private:
+    class Recycler;
+
     const std::shared_ptr<C2Allocator> mAllocator;
+    const std::shared_ptr<Recycler> mRecycler;
 };
 
 class C2BasicGraphicBlockPool : public C2BlockPool {
@@ -84,6 +84,21 @@ class C2DmaBufAllocator : public C2Allocator {
     void setUsageMapper(const UsageMapperFn& mapper, uint64_t minUsage, uint64_t maxUsage,
                         uint64_t blockSize);
 
+    /**
+     * Process-wide CPU mapping statistics of dmabuf allocations.
+     *
+     * If the map cache is enabled (media.c2.dmabuf.map-cache, default true), each allocation
+     * keeps the mapping of its first view until it is destroyed, and later views reuse it.
+     */
+    struct MapStats {
+        bool cacheEnabled;
+        uint64_t mmaps;         ///< mmap calls
+        uint64_t munmaps;       ///< munmap calls
+        uint64_t cachedMaps;    ///< views served from a kept mapping
+    };
+
+    static MapStats GetMapStats();
+
     static bool system_uncached_supported(void) {
         static int cached_result = -1;
 
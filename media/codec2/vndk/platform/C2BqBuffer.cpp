@@ -17,6 +17,7 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "C2BqBuffer"
 #include <android/hardware_buffer.h>
+#include <cutils/properties.h>
 #include <utils/Log.h>
 
 #include <ui/BufferQueueDefs.h>
@@ -383,7 +384,21 @@ private:
         ALOGV("tries to dequeue buffer");
 
         C2SyncVariables *syncVar = mSyncMem ? mSyncMem->mem(): nullptr;
-        { // Call dequeueBuffer().
+        bool reusingPending = false;
+        if (mPending.slot >= 0) {
+            if (mPending.width == width && mPending.height == height
+                    && mPending.format == format && mPending.usage == usage.expected) {
+                // Wait again for the slot dequeued by the previous fetch.
+                slot = mPending.slot;
+                fence = mPending.fence;
+                bufferNeedsReallocation = mPending.needsRealloc;
+                mPending = PendingSlot();
+                reusingPending = true;
+            } else {
+                cancelPendingSlot_l();
+            }
+        }
+        if (!reusingPending) { // Call dequeueBuffer().
             c2_status_t c2Status;
             if (syncVar) {
                 uint32_t waitId;
@@ -437,9 +452,26 @@ private:
                 mBuffers[slot].clear();
             }
 
+            int64_t waitStartUs = getTimestampNow();
             status_t status = fence->wait(kFenceWaitTimeMs);
+            mStallUs += getTimestampNow() - waitStartUs;
             if (status == -ETIME) {
-                // fence is not signalled yet.
+                // fence is not signalled yet. Keep the slot dequeued, so that the next fetch
+                // waits for the same fence rather than cancelling and dequeuing again.
+                ++mStallCount;
+                if (mKeepPendingSlot) {
+                    mPending.slot = slot;
+                    mPending.fence = fence;
+                    mPending.needsRealloc = bufferNeedsReallocation;
+                    mPending.width = width;
+                    mPending.height = height;
+                    mPending.format = format;
+                    mPending.usage = usage.expected;
+                    if (c2Fence) {
+                        *c2Fence = C2Fence();
+                    }
+                    return C2_BLOCKING;
+                }
                 if (syncVar) {
                     (void)mProducer->cancelBuffer(slot, hFenceWrapper.getHandle()).isOk();
                     syncVar->lock();
@@ -573,6 +605,26 @@ private:
         return C2_BAD_VALUE;
     }
 
+    // Returns the pending slot to the producer.
+    void cancelPendingSlot_l() {
+        if (mPending.slot < 0) {
+            return;
+        }
+        if (mProducer) {
+            HFenceWrapper hFenceWrapper{};
+            if (b2h(mPending.fence, &hFenceWrapper)) {
+                (void)mProducer->cancelBuffer(mPending.slot, hFenceWrapper.getHandle()).isOk();
+            }
+            C2SyncVariables *syncVar = mSyncMem ? mSyncMem->mem() : nullptr;
+            if (syncVar) {
+                syncVar->lock();
+                syncVar->notifyQueuedLocked();
+                syncVar->unlock();
+            }
+        }
+        mPending = PendingSlot();
+    }
+
 public:
     Impl(const std::shared_ptr<C2Allocator> &allocator)
         : mInit(C2_OK), mProducerId(0), mGeneration(0),
@@ -581,6 +633,9 @@ public:
     }
 
     ~Impl() {
+        if (!mInvalidated) {
+            cancelPendingSlot_l();
+        }
         mIgbpValidityToken.reset();
         for (int i = 0; i < NUM_BUFFER_SLOTS; ++i) {
             mBuffers[i].clear();
@@ -615,6 +670,8 @@ public:
                           "%zu consecutive failures",
                           (long long)(now - mLastDqTs), mDqFailure);
                 }
+                ALOGV("stalled %lld us in fetches so far, %llu fetches blocked",
+                      (long long)mStallUs, (unsigned long long)mStallCount);
                 mLastDqLogTs = now;
             }
         }
@@ -635,9 +692,15 @@ public:
         }
         c2_status_t status = fetchFromIgbp_l(width, height, format, usage, block, fence);
         if (status == C2_BLOCKING) {
+            bool pending = (mPending.slot >= 0);
+            if (!fence && !pending) {
+                ++mStallCount;
+                mStallUs += kMaxIgbpRetryDelayUs;
+            }
             lock.unlock();
-            if (!fence) {
-                // in order not to drain cpu from component's spinning
+            if (!fence && !pending) {
+                // in order not to drain cpu from component's spinning.
+                // With a pending slot, the next fetch blocks on its fence instead.
                 ::usleep(kMaxIgbpRetryDelayUs);
             }
         }
@@ -694,6 +757,8 @@ public:
         {
             sp<GraphicBuffer> buffers[NUM_BUFFER_SLOTS];
             std::scoped_lock<std::mutex> lock(mMutex);
+            // The pending slot is not owned by a block, so it cannot be migrated.
+            cancelPendingSlot_l();
             int32_t oldGeneration = mGeneration;
             if (producer) {
                 mProducer = producer;
@@ -750,6 +815,12 @@ public:
         *consumeUsage = mConsumerUsage;
     }
 
+    void getStallStats(uint64_t *stallUs, uint64_t *stallCount) {
+        std::scoped_lock<std::mutex> lock(mMutex);
+        *stallUs = mStallUs;
+        *stallCount = mStallCount;
+    }
+
     void invalidate() {
         mInvalidated = true;
         mIgbpValidityToken.reset();
@@ -768,6 +839,25 @@ private:
     int64_t mLastDqTs;
     int64_t mLastDqLogTs;
 
+    // Time spent and fetches blocked waiting for a buffer.
+    int64_t mStallUs = 0;
+    uint64_t mStallCount = 0;
+
+    // A slot dequeued by a fetch whose fence did not signal in time. It stays dequeued for the
+    // next fetch with the same parameters, which waits on its fence again.
+    struct PendingSlot {
+        int slot = -1;
+        sp<Fence> fence;
+        bool needsRealloc = false;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t format = 0;
+        uint64_t usage = 0;
+    };
+    PendingSlot mPending;
+    const bool mKeepPendingSlot =
+            property_get_bool("debug.codec2.bqpool_keep_pending_slot", true);
+
     const std::shared_ptr<C2Allocator> mAllocator;
 
     std::mutex mMutex;
@@ -1113,6 +1203,14 @@ void C2BufferQueueBlockPool::getConsumerUsage(uint64_t *consumeUsage) {
     }
 }
 
+void C2BufferQueueBlockPool::getStallStats(uint64_t *stallUs, uint64_t *stallCount) {
+    if (mImpl) {
+        mImpl->getStallStats(stallUs, stallCount);
+    } else {
+        *stallUs = *stallCount = 0;
+    }
+}
+
 void C2BufferQueueBlockPool::invalidate() {
     if (mImpl) {
         mImpl->invalidate();
@@ -120,6 +120,9 @@ class ANDROID_API EndianOutput : public Output {
         virtual status_t write(const double* buf, size_t offset, size_t count);
 
     protected:
+        // Size of the stack buffer used to convert values before writing them out.
+        static const size_t kConversionBufferSize = 4096;
+
         template<typename T>
         inline status_t writeHelper(const T* buf, size_t offset, size_t count);
 
@@ -132,33 +135,29 @@ template<typename T>
 inline status_t EndianOutput::writeHelper(const T* buf, size_t offset, size_t count) {
     assert(offset <= count);
     status_t res = OK;
-    size_t size = sizeof(T);
-    switch(mEndian) {
-        case BIG: {
-            for (size_t i = offset; i < count; ++i) {
-                T tmp = convertToBigEndian<T>(buf[offset + i]);
-                if ((res = mOutput->write(reinterpret_cast<uint8_t*>(&tmp), 0, size))
-                        != OK) {
-                    return res;
-                }
-                mOffset += size;
+    if (mEndian != BIG && mEndian != LITTLE) {
+        return BAD_VALUE;
+    }
+
+    // Convert values in batches to avoid calling into the output for every value.
+    const size_t batchCount = kConversionBufferSize / sizeof(T);
+    T tmp[batchCount];
+    for (size_t i = offset; i < count; i += batchCount) {
+        size_t n = (count - i < batchCount) ? count - i : batchCount;
+        if (mEndian == BIG) {
+            for (size_t j = 0; j < n; ++j) {
+                tmp[j] = convertToBigEndian<T>(buf[offset + i + j]);
             }
-            break;
-        }
-        case LITTLE: {
-            for (size_t i = offset; i < count; ++i) {
-                T tmp = convertToLittleEndian<T>(buf[offset + i]);
-                if ((res = mOutput->write(reinterpret_cast<uint8_t*>(&tmp), 0, size))
-                        != OK) {
-                    return res;
-                }
-                mOffset += size;
+        } else {
+            for (size_t j = 0; j < n; ++j) {
+                tmp[j] = convertToLittleEndian<T>(buf[offset + i + j]);
             }
-            break;
         }
-        default: {
-            return BAD_VALUE;
+        size_t size = n * sizeof(T);
+        if ((res = mOutput->write(reinterpret_cast<uint8_t*>(tmp), 0, size)) != OK) {
+            return res;
         }
+        mOffset += size;
     }
     return res;
 }
@@ -40,6 +40,10 @@ status_t FileOutput::open() {
         ALOGE("%s: Could not open file %s", __FUNCTION__, mPath.string());
         return BAD_VALUE;
     }
+    // Use a large buffer to limit the number of write syscalls for big images.
+    if (::setvbuf(mFp, NULL, _IOFBF, kBufferSize) != 0) {
+        ALOGW("%s: Could not set buffer size for file %s", __FUNCTION__, mPath.string());
+    }
     mOpen = true;
     return OK;
 }
@@ -266,6 +266,7 @@ aaudio_result_t AudioStreamInternal::configureDataInformation(int32_t callbackFr
 
     mClockModel.setSampleRate(getSampleRate());
     mClockModel.setFramesPerBurst(framesPerHardwareBurst);
+    mClockModel.setAdaptive(AAudioProperty_isClockModelAdaptive());
 
     if (isDataCallbackSet()) {
         mCallbackFrames = callbackFrames;
@@ -929,3 +930,15 @@ int32_t AudioStreamInternal::getBufferCapacity() const {
 bool AudioStreamInternal::isClockModelInControl() const {
     return isActive() && mAudioEndpoint->isFreeRunning() && mClockModel.isRunning();
 }
+
+aaudio_result_t AudioStreamInternal::getClockModelEstimates(double *driftPpm,
+                                                            int64_t *jitterNanos,
+                                                            int64_t *safeWindowNanos) const {
+    if (!mClockModel.isEstimateValid()) {
+        return AAUDIO_ERROR_UNAVAILABLE;
+    }
+    *driftPpm = mClockModel.getDriftPpm();
+    *jitterNanos = mClockModel.getJitterNanos();
+    *safeWindowNanos = mClockModel.getSafeWindowNanos();
+    return AAUDIO_OK;
+}
@@ -90,6 +90,21 @@ public:
         return mServiceStreamHandleInfo.getServiceLifetimeId();
     }
 
+    /**
+     * Estimates made by the timing model from the hardware timestamps.
+     * They are updated by the thread that processes the commands, so they are
+     * approximate when read from another thread.
+     *
+     * @param driftPpm drift of the hardware clock, positive if fast
+     * @param jitterNanos standard deviation of the timestamp lateness
+     * @param safeWindowNanos late edge of the timing window, which an app can use
+     *        as a lower bound for its buffer size
+     * @return AAUDIO_OK, or AAUDIO_ERROR_UNAVAILABLE if too few timestamps were processed
+     */
+    aaudio_result_t getClockModelEstimates(double *driftPpm,
+                                           int64_t *jitterNanos,
+                                           int64_t *safeWindowNanos) const;
+
 protected:
     aaudio_result_t requestStart_l() REQUIRES(mStreamLock) override;
     aaudio_result_t requestStop_l() REQUIRES(mStreamLock) override;
@@ -63,10 +63,44 @@ aaudio_result_t AudioStreamInternalPlay::open(const AudioStreamBuilder &builder)
         // Sample rate is constrained to common values by now and should not overflow.
         int32_t numFrames = kRampMSec * getSampleRate() / AAUDIO_MILLIS_PER_SECOND;
         mFlowGraph.setRampLengthInFrames(numFrames);
+
+        // The mixer in the service tunes its own buffer.
+        mBufferSizeTuningEnabled = !mInService && AAudioProperty_isBufferSizeTuningEnabled();
     }
     return result;
 }
 
+aaudio_result_t AudioStreamInternalPlay::setBufferSize(int32_t requestedFrames) {
+    // The app is tuning the buffer so stop tuning it automatically.
+    mBufferSizeTuningEnabled = false;
+    return AudioStreamInternal::setBufferSize(requestedFrames);
+}
+
+void AudioStreamInternalPlay::tuneBufferSize(int64_t callbackNanos) {
+    const BufferSizeTuner::Decision decision = mBufferSizeTuner.onCallback(
+            AudioClock::getNanoseconds(), getXRunCount(), callbackNanos);
+    if (decision == BufferSizeTuner::Decision::NONE) {
+        return;
+    }
+    const int32_t previousSize = getBufferSize();
+    const aaudio_result_t result =
+            AudioStreamInternal::setBufferSize(mBufferSizeTuner.getBufferSize());
+    if (result < 0) {
+        ALOGW("%s() setBufferSize() returned %d, stop tuning", __func__, result);
+        mBufferSizeTuningEnabled = false;
+        return;
+    }
+    mBufferSizeTuner.setBufferSize(result);
+    ALOGD("%s() %s buffer from %d to %d frames, XRuns = %d",
+          __func__, BufferSizeTuner::toString(decision), previousSize, result, getXRunCount());
+    android::mediametrics::LogItem(mMetricsId)
+            .set(AMEDIAMETRICS_PROP_EVENT, AMEDIAMETRICS_PROP_EVENT_VALUE_TUNEBUFFERSIZE)
+            .set(AMEDIAMETRICS_PROP_BUFFERSIZEFRAMES, result)
+            .set(AMEDIAMETRICS_PROP_UNDERRUN, (int32_t) getXRunCount())
+            .set(AMEDIAMETRICS_PROP_STATUSMESSAGE, BufferSizeTuner::toString(decision))
+            .record();
+}
+
 // This must be called under mStreamLock.
 aaudio_result_t AudioStreamInternalPlay::requestPause_l()
 {
@@ -292,11 +326,22 @@ void *AudioStreamInternalPlay::callbackLoop() {
     aaudio_data_callback_result_t callbackResult = AAUDIO_CALLBACK_RESULT_CONTINUE;
     if (!isDataCallbackSet()) return nullptr;
     int64_t timeoutNanos = calculateReasonableTimeout(mCallbackFrames);
+    if (mBufferSizeTuningEnabled) {
+        mBufferSizeTuner.reset(getFramesPerBurst(),
+                AAUDIO_NANOS_PER_SECOND * getFramesPerBurst() / getSampleRate(),
+                getBufferSize(), getBufferCapacity() - getFramesPerBurst(),
+                getXRunCount(), AudioClock::getNanoseconds());
+    }
 
     // result might be a frame count
     while (mCallbackEnabled.load() && isActive() && (result >= 0)) {
         // Call application using the AAudio callback interface.
+        const int64_t callbackStartNanos =
+                mBufferSizeTuningEnabled ? AudioClock::getNanoseconds() : 0;
         callbackResult = maybeCallDataCallback(mCallbackBuffer.get(), mCallbackFrames);
+        if (mBufferSizeTuningEnabled) {
+            tuneBufferSize(AudioClock::getNanoseconds() - callbackStartNanos);
+        }
 
         if (callbackResult == AAUDIO_CALLBACK_RESULT_CONTINUE) {
             // Write audio data to stream. This is a BLOCKING WRITE!
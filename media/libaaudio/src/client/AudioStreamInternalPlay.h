@@ -23,6 +23,7 @@
 #include "binding/AAudioServiceInterface.h"
 #include "client/AAudioFlowGraph.h"
 #include "client/AudioStreamInternal.h"
+#include "utility/BufferSizeTuner.h"
 
 using android::sp;
 
@@ -38,6 +39,8 @@ public:
 
     aaudio_result_t requestPause_l() override;
 
+    aaudio_result_t setBufferSize(int32_t requestedFrames) override;
+
     aaudio_result_t requestFlush_l() override;
 
     bool isFlushSupported() const override {
@@ -94,8 +97,16 @@ private:
     aaudio_result_t writeNowWithConversion(const void *buffer,
                                            int32_t numFrames);
 
+    // Called by the callback thread after each data callback.
+    void tuneBufferSize(int64_t callbackNanos);
+
     AAudioFlowGraph          mFlowGraph;
 
+    // Set at open from AAudioProperty_isBufferSizeTuningEnabled(),
+    // cleared if the app sets the buffer size itself.
+    std::atomic<bool>        mBufferSizeTuningEnabled{false};
+    BufferSizeTuner          mBufferSizeTuner;  // only used by the callback thread
+
 };
 
 } /* namespace aaudio */
@@ -20,6 +20,7 @@
 
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
+#include <math.h>
 #include <stdint.h>
 #include <algorithm>
 
@@ -69,10 +70,13 @@ void IsochronousClockModel::start(int64_t nanoTime) {
 }
 
 void IsochronousClockModel::stop(int64_t nanoTime) {
-    ALOGD("stop(nanos = %lld) max lateness = %d micros, DSP stalled %d times",
+    ALOGD("stop(nanos = %lld) max lateness = %d micros, DSP stalled %d times"
+          ", drift = %.1f ppm, jitter = %d micros",
           (long long) nanoTime,
           (int) (mMaxMeasuredLatenessNanos / 1000),
-          mDspStallCount
+          mDspStallCount,
+          getDriftPpm(),
+          (int) (getJitterNanos() / 1000)
     );
     setPositionAndTime(convertTimeToPosition(nanoTime), nanoTime);
     // TODO should we set position?
@@ -129,6 +133,7 @@ void IsochronousClockModel::processTimestamp(int64_t framePosition, int64_t nano
         } else {
 //            ALOGD("processTimestamp() - advance to STATE_RUNNING");
             mState = STATE_RUNNING;
+            resetEstimates(framePosition, nanoTime);
         }
         break;
     case STATE_RUNNING:
@@ -162,6 +167,7 @@ void IsochronousClockModel::processTimestamp(int64_t framePosition, int64_t nano
                 // Assume the timestamp is valid and let subsequent EARLY timestamps
                 // move the window quickly to the correct place.
                 setPositionAndTime(framePosition, nanoTime); // JUMP!
+                resetEstimates(framePosition, nanoTime);
                 mDspStallCount++;
                 // Throttle the warnings but do not silence them.
                 // They indicate a bug that needs to be fixed!
@@ -197,7 +203,7 @@ void IsochronousClockModel::processTimestamp(int64_t framePosition, int64_t nano
 #endif
             mMaxMeasuredLatenessNanos = (int32_t) latenessNanos;
         }
-
+        updateEstimates(framePosition, nanoTime, latenessNanos);
         break;
     default:
         break;
@@ -231,6 +237,87 @@ void IsochronousClockModel::driftForward(int64_t latenessNanos,
 #endif
 }
 
+void IsochronousClockModel::resetEstimates(int64_t framePosition, int64_t nanoTime) {
+    mEstimateFramePosition = framePosition;
+    mEstimateNanoTime = nanoTime;
+    mEstimateLastNanoTime = nanoTime;
+    mEstimateCount = 0;
+}
+
+// The offset between the time of each timestamp and the time predicted from its position,
+// both relative to a reference timestamp, grows linearly with the drift of the hardware clock.
+// The slope is estimated by a linear regression using exponentially weighted (co)variances,
+// so the estimate follows slow changes of the drift.
+// The lateness relative to the model, whose spread is the jitter, is estimated the same way.
+void IsochronousClockModel::updateEstimates(int64_t framePosition,
+                                            int64_t nanoTime,
+                                            int64_t latenessNanos) {
+    const int64_t elapsedNanos = nanoTime - mEstimateNanoTime;
+    const double elapsedSeconds = (double) elapsedNanos / AAUDIO_NANOS_PER_SECOND;
+    const double offsetNanos = (double) (elapsedNanos
+            - convertDeltaPositionToTime(framePosition - mEstimateFramePosition));
+    mEstimateLastNanoTime = nanoTime;
+    if (mEstimateCount == 0) {
+        mMeanElapsedSeconds = elapsedSeconds;
+        mMeanOffsetNanos = offsetNanos;
+        mVarElapsed = 0.0;
+        mCovElapsedOffset = 0.0;
+        mMeanLatenessNanos = (double) latenessNanos;
+        mVarLatenessNanos2 = 0.0;
+    } else {
+        const double deltaElapsed = elapsedSeconds - mMeanElapsedSeconds;
+        const double deltaOffset = offsetNanos - mMeanOffsetNanos;
+        mMeanElapsedSeconds += kEstimateWeight * deltaElapsed;
+        mMeanOffsetNanos += kEstimateWeight * deltaOffset;
+        mVarElapsed = (1.0 - kEstimateWeight)
+                * (mVarElapsed + kEstimateWeight * deltaElapsed * deltaElapsed);
+        mCovElapsedOffset = (1.0 - kEstimateWeight)
+                * (mCovElapsedOffset + kEstimateWeight * deltaElapsed * deltaOffset);
+
+        const double deltaLateness = latenessNanos - mMeanLatenessNanos;
+        mMeanLatenessNanos += kEstimateWeight * deltaLateness;
+        mVarLatenessNanos2 = (1.0 - kEstimateWeight)
+                * (mVarLatenessNanos2 + kEstimateWeight * deltaLateness * deltaLateness);
+    }
+    if (mEstimateCount < kEstimateMinTimestamps) {
+        mEstimateCount++;
+    }
+}
+
+bool IsochronousClockModel::isEstimateValid() const {
+    if (mState != STATE_RUNNING
+            || mEstimateCount < kEstimateMinTimestamps
+            || (mEstimateLastNanoTime - mEstimateNanoTime) < kEstimateMinNanos
+            || mVarElapsed <= 0.0) {
+        return false;
+    }
+    // A late offset per second of elapsed time means a slow hardware clock.
+    const double driftPpm = -mCovElapsedOffset / mVarElapsed / 1000.0;
+    return fabs(driftPpm) <= kMaxDriftPpm;
+}
+
+double IsochronousClockModel::getDriftPpm() const {
+    return isEstimateValid() ? -mCovElapsedOffset / mVarElapsed / 1000.0 : 0.0;
+}
+
+int64_t IsochronousClockModel::getJitterNanos() const {
+    return mEstimateCount > 0 ? (int64_t) sqrt(mVarLatenessNanos2) : 0;
+}
+
+// The model only moves the marker when a timestamp is outside the window,
+// so on a slow hardware clock the stream falls behind the marker as time passes.
+int64_t IsochronousClockModel::getDriftMarginNanos(int64_t nanoTime) const {
+    if (!mAdaptive) {
+        return 0;
+    }
+    const double driftPpm = getDriftPpm();
+    if (driftPpm >= 0.0) {
+        return 0;
+    }
+    const int64_t nanosDelta = std::max(nanoTime - mMarkerNanoTime, (int64_t) 0);
+    return (int64_t) (nanosDelta * -driftPpm * 1e-6);
+}
+
 void IsochronousClockModel::setSampleRate(int32_t sampleRate) {
     mSampleRate = sampleRate;
     update();
@@ -294,15 +381,27 @@ int64_t IsochronousClockModel::convertTimeToPosition(int64_t nanoTime) const {
 }
 
 int32_t IsochronousClockModel::getLateTimeOffsetNanos() const {
-    return mMaxMeasuredLatenessNanos + kExtraLatenessNanos;
+    int64_t latenessNanos = mMaxMeasuredLatenessNanos;
+    if (mAdaptive && isEstimateValid()) {
+        // The worst lateness ever seen may be an outlier, so use the spread of
+        // the recent lateness, but never less than the burst period over which
+        // timestamps are sampled.
+        const int64_t expectedLatenessNanos = (int64_t) (mMeanLatenessNanos
+                + kJitterSigmas * sqrt(mVarLatenessNanos2));
+        latenessNanos = std::min(latenessNanos,
+                std::max(expectedLatenessNanos, mBurstPeriodNanos));
+    }
+    return (int32_t) (latenessNanos + kExtraLatenessNanos);
 }
 
 int64_t IsochronousClockModel::convertPositionToLatestTime(int64_t framePosition) const {
-    return convertPositionToTime(framePosition) + getLateTimeOffsetNanos();
+    const int64_t time = convertPositionToTime(framePosition);
+    return time + getLateTimeOffsetNanos() + getDriftMarginNanos(time);
 }
 
 int64_t IsochronousClockModel::convertLatestTimeToPosition(int64_t nanoTime) const {
-    return convertTimeToPosition(nanoTime - getLateTimeOffsetNanos());
+    return convertTimeToPosition(nanoTime - getLateTimeOffsetNanos()
+            - getDriftMarginNanos(nanoTime));
 }
 
 void IsochronousClockModel::dump() const {
@@ -312,6 +411,9 @@ void IsochronousClockModel::dump() const {
     ALOGD("mFramesPerBurst      = %6d", mFramesPerBurst);
     ALOGD("mMaxMeasuredLatenessNanos = %6" PRId64, mMaxMeasuredLatenessNanos);
     ALOGD("mState               = %6d", mState);
+    ALOGD("mAdaptive            = %6d", mAdaptive);
+    ALOGD("drift ppm            = %6.1f", getDriftPpm());
+    ALOGD("jitter micros        = %6d", (int) (getJitterNanos() / AAUDIO_NANOS_PER_MICROSECOND));
 }
 
 void IsochronousClockModel::dumpHistogram() const {
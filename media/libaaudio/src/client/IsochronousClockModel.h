@@ -123,6 +123,47 @@ public:
      */
     int64_t convertDeltaTimeToPosition(int64_t nanosDelta) const;
 
+    /**
+     * Enable the adaptive window. Its late edge is based on the estimated jitter
+     * rather than on the worst lateness ever measured, and is extended for the
+     * estimated drift of a slow hardware clock. The estimates are always made.
+     */
+    void setAdaptive(bool adaptive) {
+        mAdaptive = adaptive;
+    }
+
+    bool isAdaptive() const {
+        return mAdaptive;
+    }
+
+    /**
+     * @return true if enough timestamps have been processed for the estimates to be used
+     */
+    bool isEstimateValid() const;
+
+    /**
+     * Drift of the hardware clock relative to CLOCK_MONOTONIC.
+     * Positive when the hardware runs fast, i.e. consumes or produces frames early.
+     *
+     * @return drift in parts per million, or 0 if the estimate is not valid
+     */
+    double getDriftPpm() const;
+
+    /**
+     * @return standard deviation of the timestamp lateness in nanoseconds
+     */
+    int64_t getJitterNanos() const;
+
+    /**
+     * Late edge of the window, relative to the estimated position of the stream.
+     * An app can keep the buffer size above the frames equivalent of this, plus one burst.
+     *
+     * @return time in nanoseconds
+     */
+    int64_t getSafeWindowNanos() const {
+        return getLateTimeOffsetNanos();
+    }
+
     void dump() const;
 
     void dumpHistogram() const;
@@ -134,6 +175,9 @@ private:
                       int64_t framePosition);
     int32_t getLateTimeOffsetNanos() const;
     void update();
+    void resetEstimates(int64_t framePosition, int64_t nanoTime);
+    void updateEstimates(int64_t framePosition, int64_t nanoTime, int64_t latenessNanos);
+    int64_t getDriftMarginNanos(int64_t nanoTime) const;
 
     enum clock_model_state_t {
         STATE_STOPPED,
@@ -158,6 +202,16 @@ private:
     static constexpr int32_t   kShifterForDrift = 6; // divide by 2^N
     static constexpr int32_t   kVeryLateCountsNeededToTriggerJump = 2;
 
+    // Weight of each timestamp in the exponentially weighted estimates.
+    static constexpr double    kEstimateWeight = 1.0 / 2048;
+    // Timestamps and time needed before the estimates are used.
+    static constexpr int32_t   kEstimateMinTimestamps = 1024;
+    static constexpr int64_t   kEstimateMinNanos = 10 * AAUDIO_NANOS_PER_SECOND;
+    // Larger estimates are treated as a bad clock and ignored.
+    static constexpr double    kMaxDriftPpm = 500.0;
+    // The adaptive late edge is this many standard deviations above the mean lateness.
+    static constexpr double    kJitterSigmas = 4.0;
+
     static constexpr int32_t   kHistogramBinWidthMicros = 50;
     static constexpr int32_t   kHistogramBinCount       = 128;
 
@@ -178,6 +232,20 @@ private:
 
     clock_model_state_t mState{STATE_STOPPED};   // State machine handles startup sequence.
 
+    bool                mAdaptive = false;
+
+    // Online estimates, see updateEstimates().
+    int64_t             mEstimateFramePosition{0}; // Reference for the drift estimate.
+    int64_t             mEstimateNanoTime{0};
+    int64_t             mEstimateLastNanoTime{0};
+    int32_t             mEstimateCount{0};
+    double              mMeanElapsedSeconds{0.0};  // Weighted means and (co)variances
+    double              mMeanOffsetNanos{0.0};     // of the offset versus elapsed time.
+    double              mVarElapsed{0.0};
+    double              mCovElapsedOffset{0.0};
+    double              mMeanLatenessNanos{0.0};
+    double              mVarLatenessNanos2{0.0};
+
     int32_t             mTimestampCount = 0;  // For logging.
     int32_t             mDspStallCount = 0;  // For logging.
 
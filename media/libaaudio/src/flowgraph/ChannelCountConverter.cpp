@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <string.h>
 #include <unistd.h>
 #include "FlowGraphNode.h"
 #include "ChannelCountConverter.h"
@@ -34,6 +35,17 @@ int32_t ChannelCountConverter::onProcess(int32_t numFrames) {
     float *outputBuffer = output.getBuffer();
     int32_t inputChannelCount = input.getSamplesPerFrame();
     int32_t outputChannelCount = output.getSamplesPerFrame();
+    if (inputChannelCount == outputChannelCount) {
+        memcpy(outputBuffer, inputBuffer, numFrames * outputChannelCount * sizeof(float));
+        return numFrames;
+    }
+    if (inputChannelCount == 2 && outputChannelCount == 1) {
+        // Discard the second channel.
+        for (int i = 0; i < numFrames; i++) {
+            outputBuffer[i] = inputBuffer[2 * i];
+        }
+        return numFrames;
+    }
     for (int i = 0; i < numFrames; i++) {
         int inputChannel = 0;
         for (int outputChannel = 0; outputChannel < outputChannelCount; outputChannel++) {
@@ -41,7 +53,7 @@ int32_t ChannelCountConverter::onProcess(int32_t numFrames) {
             // Wrap if we run out of inputs.
             // Discard if we run out of outputs.
             outputBuffer[outputChannel] = inputBuffer[inputChannel];
-            inputChannel = (inputChannel == inputChannelCount)
+            inputChannel = (inputChannel + 1 == inputChannelCount)
                     ? 0 : inputChannel + 1;
         }
         inputBuffer += inputChannelCount;
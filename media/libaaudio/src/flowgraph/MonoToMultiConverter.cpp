@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <string.h>
 #include <unistd.h>
 #include "FlowGraphNode.h"
 #include "MonoToMultiConverter.h"
@@ -25,16 +26,39 @@ MonoToMultiConverter::MonoToMultiConverter(int32_t outputChannelCount)
         , output(*this, outputChannelCount) {
 }
 
+// A constant channel count lets the compiler vectorize the inner loop.
+template <int32_t CHANNELS>
+static void monoToMulti(const float * __restrict inputBuffer,
+                        float * __restrict outputBuffer, int32_t numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        // read one, write many
+        const float sample = inputBuffer[i];
+        for (int channel = 0; channel < CHANNELS; channel++) {
+            outputBuffer[channel] = sample;
+        }
+        outputBuffer += CHANNELS;
+    }
+}
+
 int32_t MonoToMultiConverter::onProcess(int32_t numFrames) {
     const float *inputBuffer = input.getBuffer();
     float *outputBuffer = output.getBuffer();
     int32_t channelCount = output.getSamplesPerFrame();
-    for (int i = 0; i < numFrames; i++) {
-        // read one, write many
-        float sample = *inputBuffer++;
-        for (int channel = 0; channel < channelCount; channel++) {
-            *outputBuffer++ = sample;
+    switch (channelCount) {
+    case 1: memcpy(outputBuffer, inputBuffer, numFrames * sizeof(float)); break;
+    case 2: monoToMulti<2>(inputBuffer, outputBuffer, numFrames); break;
+    case 4: monoToMulti<4>(inputBuffer, outputBuffer, numFrames); break;
+    case 6: monoToMulti<6>(inputBuffer, outputBuffer, numFrames); break;
+    case 8: monoToMulti<8>(inputBuffer, outputBuffer, numFrames); break;
+    default:
+        for (int i = 0; i < numFrames; i++) {
+            // read one, write many
+            float sample = *inputBuffer++;
+            for (int channel = 0; channel < channelCount; channel++) {
+                *outputBuffer++ = sample;
+            }
         }
+        break;
     }
     return numFrames;
 }
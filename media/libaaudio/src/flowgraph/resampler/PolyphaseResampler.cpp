@@ -36,25 +36,53 @@ PolyphaseResampler::PolyphaseResampler(const MultiChannelResampler::Builder &bui
                          builder.getNormalizedCutoff());
 }
 
-void PolyphaseResampler::readFrame(float *frame) {
-    // Clear accumulator for mixing.
-    std::fill(mSingleFrame.begin(), mSingleFrame.end(), 0.0);
+// Multiply input times windowed sinc function, for a constant channel count.
+// The accumulators are kept in registers and the channel loop is vectorized.
+template <int CHANNELS>
+static void innerProduct(const float * __restrict xFrame,
+                         const float * __restrict coefficients,
+                         int numTaps,
+                         float *frame) {
+    float sum[CHANNELS] = {};
+    for (int i = 0; i < numTaps; i++) {
+        const float coefficient = coefficients[i];
+        for (int channel = 0; channel < CHANNELS; channel++) {
+            sum[channel] += xFrame[channel] * coefficient;
+        }
+        xFrame += CHANNELS;
+    }
+    for (int channel = 0; channel < CHANNELS; channel++) {
+        frame[channel] = sum[channel];
+    }
+}
 
-    // Multiply input times windowed sinc function.
-    float *coefficients = &mCoefficients[mCoefficientCursor];
+void PolyphaseResampler::readFrame(float *frame) {
+    const float *coefficients = &mCoefficients[mCoefficientCursor];
     float *xFrame = &mX[static_cast<size_t>(mCursor) * static_cast<size_t>(getChannelCount())];
-    for (int i = 0; i < mNumTaps; i++) {
-        float coefficient = *coefficients++;
-        for (int channel = 0; channel < getChannelCount(); channel++) {
-            mSingleFrame[channel] += *xFrame++ * coefficient;
-        }
+    switch (getChannelCount()) {
+        case 2: innerProduct<2>(xFrame, coefficients, mNumTaps, frame); break;
+        case 4: innerProduct<4>(xFrame, coefficients, mNumTaps, frame); break;
+        case 6: innerProduct<6>(xFrame, coefficients, mNumTaps, frame); break;
+        case 8: innerProduct<8>(xFrame, coefficients, mNumTaps, frame); break;
+        default: {
+            // Clear accumulator for mixing.
+            std::fill(mSingleFrame.begin(), mSingleFrame.end(), 0.0);
+
+            // Multiply input times windowed sinc function.
+            for (int i = 0; i < mNumTaps; i++) {
+                float coefficient = *coefficients++;
+                for (int channel = 0; channel < getChannelCount(); channel++) {
+                    mSingleFrame[channel] += *xFrame++ * coefficient;
+                }
+            }
+
+            // Copy accumulator to output.
+            for (int channel = 0; channel < getChannelCount(); channel++) {
+                frame[channel] = mSingleFrame[channel];
+            }
+        } break;
     }
 
     // Advance and wrap through coefficients.
     mCoefficientCursor = (mCoefficientCursor + mNumTaps) % mCoefficients.size();
-
-    // Copy accumulator to output.
-    for (int channel = 0; channel < getChannelCount(); channel++) {
-        frame[channel] = mSingleFrame[channel];
-    }
 }
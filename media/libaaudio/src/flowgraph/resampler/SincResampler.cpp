@@ -35,7 +35,51 @@ SincResampler::SincResampler(const MultiChannelResampler::Builder &builder)
                          builder.getNormalizedCutoff());
 }
 
+template <int CHANNELS>
+void SincResampler::readFrameForChannels(float *frame) {
+    // Determine indices into coefficients table.
+    const double tablePhase = getIntegerPhase() * mPhaseScaler;
+    const int indexLow = static_cast<int>(floor(tablePhase));
+    const int indexHigh = indexLow + 1; // OK because using a guard row.
+    assert (indexHigh < mNumRows);
+    const float * __restrict coefficientsLow = &mCoefficients[static_cast<size_t>(indexLow)
+                                            * static_cast<size_t>(getNumTaps())];
+    const float * __restrict coefficientsHigh = &mCoefficients[static_cast<size_t>(indexHigh)
+                                             * static_cast<size_t>(getNumTaps())];
+    const float * __restrict xFrame = &mX[static_cast<size_t>(mCursor) * CHANNELS];
+
+    // The accumulators are kept in registers and the channel loop is vectorized.
+    float low[CHANNELS] = {};
+    float high[CHANNELS] = {};
+    for (int tap = 0; tap < mNumTaps; tap++) {
+        const float coefficientLow = coefficientsLow[tap];
+        const float coefficientHigh = coefficientsHigh[tap];
+        for (int channel = 0; channel < CHANNELS; channel++) {
+            const float sample = xFrame[channel];
+            low[channel] += sample * coefficientLow;
+            high[channel] += sample * coefficientHigh;
+        }
+        xFrame += CHANNELS;
+    }
+
+    // Interpolate and copy to output.
+    const float fraction = tablePhase - indexLow;
+    for (int channel = 0; channel < CHANNELS; channel++) {
+        frame[channel] = low[channel] + (fraction * (high[channel] - low[channel]));
+    }
+}
+
+template void SincResampler::readFrameForChannels<2>(float *frame);
+
 void SincResampler::readFrame(float *frame) {
+    switch (getChannelCount()) {
+        case 1: readFrameForChannels<1>(frame); return;
+        case 4: readFrameForChannels<4>(frame); return;
+        case 6: readFrameForChannels<6>(frame); return;
+        case 8: readFrameForChannels<8>(frame); return;
+        default: break;
+    }
+
     // Clear accumulator for mixing.
     std::fill(mSingleFrame.begin(), mSingleFrame.end(), 0.0);
     std::fill(mSingleFrame2.begin(), mSingleFrame2.end(), 0.0);
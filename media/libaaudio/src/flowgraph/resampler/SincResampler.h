@@ -39,6 +39,9 @@ public:
     void readFrame(float *frame) override;
 
 protected:
+    // readFrame() for a constant channel count, which lets the compiler vectorize it.
+    template <int CHANNELS>
+    void readFrameForChannels(float *frame);
 
     std::vector<float> mSingleFrame2; // for interpolation
     int32_t            mNumRows = 0;
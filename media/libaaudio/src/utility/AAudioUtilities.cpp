@@ -632,6 +632,14 @@ int32_t AAudioProperty_getOutputMMapOffsetMicros() {
     return AAudioProperty_getMMapOffsetMicros(__func__, AAUDIO_PROP_OUTPUT_MMAP_OFFSET_USEC);
 }
 
+bool AAudioProperty_isClockModelAdaptive() {
+    return property_get_bool(AAUDIO_PROP_CLOCK_MODEL_ADAPTIVE, true);
+}
+
+bool AAudioProperty_isBufferSizeTuningEnabled() {
+    return property_get_bool(AAUDIO_PROP_BUFFER_SIZE_TUNING, false);
+}
+
 int32_t AAudioProperty_getLogMask() {
     return property_get_int32(AAUDIO_PROP_LOG_MASK, 0);
 }
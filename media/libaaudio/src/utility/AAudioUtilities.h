@@ -166,6 +166,25 @@ int32_t AAudioProperty_getInputMMapOffsetMicros();
 int32_t AAudioProperty_getOutputMMapOffsetMicros();
 #define AAUDIO_PROP_OUTPUT_MMAP_OFFSET_USEC   "aaudio.out_mmap_offset_usec"
 
+/**
+ * Read a system property that enables the adaptive timing window of the MMAP clock model,
+ * which is based on the measured drift and jitter of the hardware timestamps.
+ *
+ * @return true if the adaptive window is enabled, the default
+ */
+bool AAudioProperty_isClockModelAdaptive();
+#define AAUDIO_PROP_CLOCK_MODEL_ADAPTIVE   "aaudio.clock_model_adaptive"
+
+/**
+ * Read a system property that enables automatic tuning of the buffer size of
+ * output MMAP streams that use a data callback, based on their XRun count.
+ * Tuning stops if the app sets the buffer size.
+ *
+ * @return true if tuning is enabled, false by default
+ */
+bool AAudioProperty_isBufferSizeTuningEnabled();
+#define AAUDIO_PROP_BUFFER_SIZE_TUNING   "aaudio.buffer_size_tuning"
+
 // These are powers of two that can be combined as a bit mask.
 // AAUDIO_LOG_CLOCK_MODEL_HISTOGRAM must be enabled before the stream is opened.
 #define AAUDIO_LOG_CLOCK_MODEL_HISTOGRAM   1
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILITY_BUFFER_SIZE_TUNER_H
+#define UTILITY_BUFFER_SIZE_TUNER_H
+
+#include <algorithm>
+#include <stdint.h>
+
+/**
+ * Find the lowest stable buffer size of an output stream, one burst at a time.
+ *
+ * The buffer grows by a burst whenever the XRun count increases.
+ * After a period without XRuns it shrinks by a burst, but only if the data callback
+ * leaves enough of the burst period to refill a smaller buffer, and never down to
+ * a size that has already underrun.
+ *
+ * Note that this has no interior locks. It should be called from the callback thread.
+ */
+class BufferSizeTuner {
+
+public:
+    enum class Decision {
+        NONE,
+        GROW,     // XRuns occurred
+        SHRINK,   // stable for kStablePeriodNanos
+    };
+
+    // Time without XRuns before the buffer is shrunk.
+    static constexpr int64_t kStablePeriodNanos = 2LL * 1000 * 1000 * 1000;
+    // The callback must take less than this fraction of the burst period to shrink.
+    static constexpr int32_t kMaxCallbackLoadPercent = 50;
+    // Never shrink below this many bursts.
+    static constexpr int32_t kMinimumBursts = 1;
+
+    BufferSizeTuner() = default;
+
+    /**
+     * @param framesPerBurst size of a burst in frames
+     * @param burstNanos duration of a burst
+     * @param bufferSize current buffer size in frames
+     * @param maximumSize largest buffer size that can be set in frames
+     * @param xRunCount current XRun count of the stream
+     * @param nowNanos current time
+     */
+    void reset(int32_t framesPerBurst, int64_t burstNanos,
+               int32_t bufferSize, int32_t maximumSize,
+               int32_t xRunCount, int64_t nowNanos) {
+        mFramesPerBurst = std::max(framesPerBurst, 1);
+        mBurstNanos = burstNanos;
+        mBufferSize = bufferSize;
+        mMaximumSize = maximumSize;
+        mLowestStableSize = 0;
+        mPreviousXRunCount = xRunCount;
+        mStableStartNanos = nowNanos;
+        mMaxCallbackNanos = 0;
+    }
+
+    /**
+     * Called once per data callback.
+     *
+     * @param nowNanos current time
+     * @param xRunCount current XRun count of the stream
+     * @param callbackNanos time spent in the data callback
+     * @return decision, if not NONE then getBufferSize() returns the new size
+     */
+    Decision onCallback(int64_t nowNanos, int32_t xRunCount, int64_t callbackNanos) {
+        mMaxCallbackNanos = std::max(mMaxCallbackNanos, callbackNanos);
+        const int32_t xRuns = xRunCount - mPreviousXRunCount;
+        mPreviousXRunCount = xRunCount;
+
+        if (xRuns > 0) {
+            restartStablePeriod(nowNanos);
+            // This size is not stable so never return to it.
+            mLowestStableSize = mBufferSize + mFramesPerBurst;
+            if (mBufferSize + mFramesPerBurst <= mMaximumSize) {
+                mBufferSize += mFramesPerBurst;
+                return Decision::GROW;
+            }
+            return Decision::NONE;
+        }
+
+        if (nowNanos - mStableStartNanos < kStablePeriodNanos) {
+            return Decision::NONE;
+        }
+        const bool callbackIsFast =
+                mMaxCallbackNanos * 100 < mBurstNanos * kMaxCallbackLoadPercent;
+        const int32_t smallerSize = mBufferSize - mFramesPerBurst;
+        restartStablePeriod(nowNanos);
+        if (callbackIsFast
+                && smallerSize >= kMinimumBursts * mFramesPerBurst
+                && smallerSize >= mLowestStableSize) {
+            mBufferSize = smallerSize;
+            return Decision::SHRINK;
+        }
+        return Decision::NONE;
+    }
+
+    /**
+     * Report the size that was actually set, which may be rounded by the stream.
+     */
+    void setBufferSize(int32_t bufferSize) {
+        mBufferSize = bufferSize;
+    }
+
+    int32_t getBufferSize() const {
+        return mBufferSize;
+    }
+
+    static const char *toString(Decision decision) {
+        switch (decision) {
+            case Decision::GROW: return "grow";
+            case Decision::SHRINK: return "shrink";
+            default: return "none";
+        }
+    }
+
+private:
+    void restartStablePeriod(int64_t nowNanos) {
+        mStableStartNanos = nowNanos;
+        mMaxCallbackNanos = 0;
+    }
+
+    int32_t mFramesPerBurst = 1;
+    int64_t mBurstNanos = 0;
+    int32_t mBufferSize = 0;
+    int32_t mMaximumSize = 0;
+    int32_t mLowestStableSize = 0;
+    int32_t mPreviousXRunCount = 0;
+    int64_t mStableStartNanos = 0;
+    int64_t mMaxCallbackNanos = 0;
+};
+
+#endif //UTILITY_BUFFER_SIZE_TUNER_H
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark the AAudioFlowGraph for common client to device configurations,
+ * as run in the data callback of a stream.
+ */
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "client/AAudioFlowGraph.h"
+
+constexpr int32_t kFramesPerBurst = 192;    // 4 ms at 48 kHz
+
+static size_t bytesPerSample(audio_format_t format) {
+    return format == AUDIO_FORMAT_PCM_24_BIT_PACKED ? 3 : audio_bytes_per_sample(format);
+}
+
+// state.range(0) is the source channel count, state.range(1) the sink channel count,
+// state.range(2) is nonzero for an exclusive (MMAP) stream, which adds the volume ramps.
+template <audio_format_t SOURCE_FORMAT, audio_format_t SINK_FORMAT>
+static void BM_FlowGraph(benchmark::State& state) {
+    const int32_t sourceChannelCount = state.range(0);
+    const int32_t sinkChannelCount = state.range(1);
+    const bool isExclusive = state.range(2) != 0;
+
+    AAudioFlowGraph flowGraph;
+    if (flowGraph.configure(SOURCE_FORMAT, sourceChannelCount, SINK_FORMAT, sinkChannelCount,
+            false /* useMonoBlend */, 0.f /* audioBalance */, isExclusive)
+            != AAUDIO_OK) {
+        state.SkipWithError("configure failed");
+        return;
+    }
+    std::vector<uint8_t> source(
+            kFramesPerBurst * sourceChannelCount * bytesPerSample(SOURCE_FORMAT), 0x10);
+    std::vector<uint8_t> sink(kFramesPerBurst * sinkChannelCount * bytesPerSample(SINK_FORMAT));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(source.data());
+        flowGraph.process(source.data(), sink.data(), kFramesPerBurst);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kFramesPerBurst);
+}
+
+static void ChannelArgs(benchmark::internal::Benchmark* b) {
+    for (int exclusive = 0; exclusive <= 1; ++exclusive) {
+        b->Args({1, 2, exclusive})->Args({1, 8, exclusive})->Args({2, 2, exclusive})
+                ->Args({6, 6, exclusive})->Args({8, 8, exclusive});
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_FLOAT)
+        ->Apply(ChannelArgs);
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_FLOAT)
+        ->Apply(ChannelArgs);
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_16_BIT)
+        ->Apply(ChannelArgs);
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_16_BIT, AUDIO_FORMAT_PCM_16_BIT)
+        ->Apply(ChannelArgs);
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_24_BIT_PACKED)
+        ->Apply(ChannelArgs);
+BENCHMARK_TEMPLATE(BM_FlowGraph, AUDIO_FORMAT_PCM_FLOAT, AUDIO_FORMAT_PCM_32_BIT)
+        ->Apply(ChannelArgs);
+
+BENCHMARK_MAIN();
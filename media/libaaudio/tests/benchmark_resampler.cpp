@@ -0,0 +1,79 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Benchmark the flowgraph MultiChannelResampler for each quality and channel count.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "flowgraph/resampler/MultiChannelResampler.h"
+
+using namespace RESAMPLER_OUTER_NAMESPACE::resampler;
+
+constexpr int32_t kOutputFrames = 192;    // 4 ms at 48 kHz
+
+// state.range(0) is the channel count, state.range(1) the quality,
+// state.range(2) the input rate and state.range(3) the output rate.
+static void BM_Resampler(benchmark::State& state) {
+    const int32_t channelCount = state.range(0);
+    const auto quality = static_cast<MultiChannelResampler::Quality>(state.range(1));
+    const int32_t inputRate = state.range(2);
+    const int32_t outputRate = state.range(3);
+
+    std::unique_ptr<MultiChannelResampler> resampler(
+            MultiChannelResampler::make(channelCount, inputRate, outputRate, quality));
+    std::vector<float> input(channelCount);
+    std::vector<float> output(kOutputFrames * channelCount);
+
+    float phase = 0.f;
+    for (auto _ : state) {
+        for (int32_t i = 0; i < kOutputFrames; i++) {
+            while (resampler->isWriteNeeded()) {
+                // A simple ramp; the signal does not affect the cost.
+                for (int32_t channel = 0; channel < channelCount; channel++) {
+                    input[channel] = phase;
+                }
+                phase = phase > 0.5f ? -0.5f : phase + 0.01f;
+                resampler->writeNextFrame(input.data());
+            }
+            resampler->readNextFrame(&output[i * channelCount]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kOutputFrames);
+}
+
+static void ResamplerArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t channelCount : {1, 2, 4, 6, 8}) {
+        for (int64_t quality = (int64_t)MultiChannelResampler::Quality::Fastest;
+                quality <= (int64_t)MultiChannelResampler::Quality::Best; quality++) {
+            for (const auto& [inputRate, outputRate] :
+                    {std::pair<int64_t, int64_t>{44100, 48000}, {48000, 44100},
+                     {16000, 48000}}) {
+                b->Args({channelCount, quality, inputRate, outputRate});
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_Resampler)->Apply(ResamplerArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Unit tests for BufferSizeTuner
+
+#include <gtest/gtest.h>
+
+#include "utility/BufferSizeTuner.h"
+
+using Decision = BufferSizeTuner::Decision;
+
+constexpr int32_t kFramesPerBurst = 96;
+constexpr int64_t kBurstNanos = 2 * 1000 * 1000; // 96 frames at 48 kHz
+constexpr int32_t kMaximumSize = 16 * kFramesPerBurst;
+
+// Run callbacks every burst for the duration, returning the last decision other than NONE.
+static Decision runCallbacks(BufferSizeTuner &tuner, int64_t *nowNanos, int64_t durationNanos,
+                             int32_t xRunCount, int64_t callbackNanos) {
+    Decision last = Decision::NONE;
+    const int64_t endNanos = *nowNanos + durationNanos;
+    for (; *nowNanos < endNanos; *nowNanos += kBurstNanos) {
+        Decision decision = tuner.onCallback(*nowNanos, xRunCount, callbackNanos);
+        if (decision != Decision::NONE) {
+            last = decision;
+        }
+    }
+    return last;
+}
+
+TEST(test_buffer_size_tuner, grow_on_xrun) {
+    BufferSizeTuner tuner;
+    int64_t nowNanos = 0;
+    tuner.reset(kFramesPerBurst, kBurstNanos, 2 * kFramesPerBurst, kMaximumSize, 0, nowNanos);
+
+    ASSERT_EQ(Decision::GROW, tuner.onCallback(nowNanos, 1, 0));
+    ASSERT_EQ(3 * kFramesPerBurst, tuner.getBufferSize());
+    // The same XRun count does not grow again.
+    ASSERT_EQ(Decision::NONE, tuner.onCallback(nowNanos + kBurstNanos, 1, 0));
+    ASSERT_EQ(3 * kFramesPerBurst, tuner.getBufferSize());
+}
+
+TEST(test_buffer_size_tuner, grow_limited_to_maximum) {
+    BufferSizeTuner tuner;
+    tuner.reset(kFramesPerBurst, kBurstNanos, kMaximumSize, kMaximumSize, 0, 0);
+    ASSERT_EQ(Decision::NONE, tuner.onCallback(0, 1, 0));
+    ASSERT_EQ(kMaximumSize, tuner.getBufferSize());
+}
+
+TEST(test_buffer_size_tuner, shrink_when_stable) {
+    BufferSizeTuner tuner;
+    int64_t nowNanos = 0;
+    tuner.reset(kFramesPerBurst, kBurstNanos, 4 * kFramesPerBurst, kMaximumSize, 0, nowNanos);
+
+    // Nothing happens before the stable period.
+    ASSERT_EQ(Decision::NONE, runCallbacks(tuner, &nowNanos,
+            BufferSizeTuner::kStablePeriodNanos / 2, 0, 0));
+    ASSERT_EQ(Decision::SHRINK, runCallbacks(tuner, &nowNanos,
+            BufferSizeTuner::kStablePeriodNanos, 0, 0));
+    ASSERT_EQ(3 * kFramesPerBurst, tuner.getBufferSize());
+
+    // Shrink to the minimum and stay there.
+    runCallbacks(tuner, &nowNanos, 10 * BufferSizeTuner::kStablePeriodNanos, 0, 0);
+    ASSERT_EQ(BufferSizeTuner::kMinimumBursts * kFramesPerBurst, tuner.getBufferSize());
+}
+
+TEST(test_buffer_size_tuner, no_shrink_with_slow_callback) {
+    BufferSizeTuner tuner;
+    int64_t nowNanos = 0;
+    tuner.reset(kFramesPerBurst, kBurstNanos, 4 * kFramesPerBurst, kMaximumSize, 0, nowNanos);
+    ASSERT_EQ(Decision::NONE, runCallbacks(tuner, &nowNanos,
+            4 * BufferSizeTuner::kStablePeriodNanos, 0, kBurstNanos * 3 / 4));
+    ASSERT_EQ(4 * kFramesPerBurst, tuner.getBufferSize());
+}
+
+TEST(test_buffer_size_tuner, no_shrink_to_unstable_size) {
+    BufferSizeTuner tuner;
+    int64_t nowNanos = 0;
+    tuner.reset(kFramesPerBurst, kBurstNanos, 2 * kFramesPerBurst, kMaximumSize, 0, nowNanos);
+
+    ASSERT_EQ(Decision::GROW, tuner.onCallback(nowNanos, 1, 0));
+    ASSERT_EQ(3 * kFramesPerBurst, tuner.getBufferSize());
+    // 2 bursts underran so the tuner must not go back.
+    ASSERT_EQ(Decision::NONE, runCallbacks(tuner, &nowNanos,
+            10 * BufferSizeTuner::kStablePeriodNanos, 1, 0));
+    ASSERT_EQ(3 * kFramesPerBurst, tuner.getBufferSize());
+}
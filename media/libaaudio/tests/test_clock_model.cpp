@@ -208,3 +208,39 @@ TEST_F(ClockModelTestFixture, clock_fast_drift) {
 TEST_F(ClockModelTestFixture, clock_jump_forward_500) {
     checkDriftingClock(SAMPLE_RATE, NUM_LOOPS_DRIFT, 0.500);
 }
+
+// The drift estimate should converge on the offset of the hardware sample rate.
+TEST_F(ClockModelTestFixture, clock_drift_estimate) {
+    checkDriftingClock(0.99998 * SAMPLE_RATE, NUM_LOOPS_DRIFT);
+    ASSERT_TRUE(model.isEstimateValid());
+    EXPECT_NEAR(-20.0, model.getDriftPpm(), 5.0);
+    // Timestamps are sampled randomly over a burst.
+    EXPECT_LT(0, model.getJitterNanos());
+    EXPECT_GT((int64_t) NANOS_PER_BURST, model.getJitterNanos());
+
+    model.start(0);
+    EXPECT_FALSE(model.isEstimateValid());
+    EXPECT_EQ(0.0, model.getDriftPpm());
+}
+
+// The adaptive window must still track drifting clocks,
+// and is never wider than the window based on the worst lateness.
+TEST_F(ClockModelTestFixture, clock_adaptive_slow_drift) {
+    model.setAdaptive(true);
+    checkDriftingClock(0.99998 * SAMPLE_RATE, NUM_LOOPS_DRIFT);
+    const int64_t adaptiveWindowNanos = model.getSafeWindowNanos();
+    model.setAdaptive(false);
+    EXPECT_GE(model.getSafeWindowNanos(), adaptiveWindowNanos);
+    EXPECT_LE((int64_t) NANOS_PER_BURST, adaptiveWindowNanos);
+}
+
+TEST_F(ClockModelTestFixture, clock_adaptive_fast_drift) {
+    model.setAdaptive(true);
+    checkDriftingClock(1.00002 * SAMPLE_RATE, NUM_LOOPS_DRIFT);
+    EXPECT_NEAR(20.0, model.getDriftPpm(), 5.0);
+}
+
+TEST_F(ClockModelTestFixture, clock_adaptive_jump_forward_500) {
+    model.setAdaptive(true);
+    checkDriftingClock(SAMPLE_RATE, NUM_LOOPS_DRIFT, 0.500);
+}
@@ -18,6 +18,7 @@
 //#define LOG_NDEBUG 0
 #define LOG_TAG "AudioRecord"
 
+#include <algorithm>
 #include <inttypes.h>
 #include <android-base/macros.h>
 #include <android-base/stringprintf.h>
@@ -1216,6 +1217,10 @@ ssize_t AudioRecord::read(void* buffer, size_t userSize, bool blocking)
     ssize_t read = 0;
     Buffer audioBuffer;
 
+    if (blocking) {
+        sleepUntilFramesReady(userSize / mFrameSize);
+    }
+
     while (userSize >= mFrameSize) {
         audioBuffer.frameCount = userSize / mFrameSize;
 
@@ -1247,6 +1252,33 @@ ssize_t AudioRecord::read(void* buffer, size_t userSize, bool blocking)
     return read;
 }
 
+void AudioRecord::sleepUntilFramesReady(size_t frames)
+{
+    // The last few ms are left to obtainBuffer(), which wakes up as soon as the server
+    // writes, so that the sleep doesn't add latency when the estimate is late.
+    static constexpr int64_t kReadSleepMarginUs = 10000;
+    sp<AudioRecordClientProxy> proxy;
+    uint32_t sampleRate;
+    {
+        AutoMutex lock(mLock);
+        if (!mActive || mProxy == 0 || (mFlags & AUDIO_INPUT_FLAG_FAST)) {
+            return;
+        }
+        proxy = mProxy;
+        sampleRate = mSampleRate;
+    }
+    // Don't wait for more than half the buffer, so the server doesn't overrun it meanwhile.
+    frames = std::min(frames, proxy->frameCount() / 2);
+    const size_t ready = proxy->framesReady();
+    if (sampleRate == 0 || ready >= frames) {
+        return;
+    }
+    const int64_t waitUs = (int64_t)(frames - ready) * 1000000 / sampleRate - kReadSleepMarginUs;
+    if (waitUs >= kReadSleepMarginUs) {
+        usleep(waitUs);
+    }
+}
+
 // -------------------------------------------------------------------------
 
 nsecs_t AudioRecord::processAudioBuffer()
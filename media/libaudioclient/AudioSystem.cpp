@@ -30,6 +30,7 @@
 #include <media/IAudioFlinger.h>
 #include <media/PolicyAidlConversion.h>
 #include <media/TypeConverter.h>
+#include <mediautils/ServiceUtilities.h>
 #include <math.h>
 
 #include <system/audio.h>
@@ -896,14 +897,23 @@ const sp<IAudioPolicyService> AudioSystem::get_audio_policy_service() {
         ap->setAudioPortCallbacksEnabled(apc->isAudioPortCbEnabled());
         ap->setAudioVolumeGroupCallbacksEnabled(apc->isAudioVolumeGroupCbEnabled());
         IPCThreadState::self()->restoreCallingIdentity(token);
+        apc->setCacheEnabled(apc->isAudioPortCbEnabled());
     }
 
     return ap;
 }
 
+sp<AudioSystem::AudioPolicyServiceClient> AudioSystem::getAudioPolicyServiceClient() {
+    Mutex::Autolock _l(gLockAPS);
+    return gAudioPolicyServiceClient;
+}
+
 void AudioSystem::clearAudioPolicyService() {
     Mutex::Autolock _l(gLockAPS);
     gAudioPolicyService.clear();
+    if (gAudioPolicyServiceClient != 0) {
+        gAudioPolicyServiceClient->setCacheEnabled(false);
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -1369,6 +1379,12 @@ status_t AudioSystem::getDevicesForAttributes(const audio_attributes_t& aa,
     const sp<IAudioPolicyService>& aps = AudioSystem::get_audio_policy_service();
     if (aps == 0) return PERMISSION_DENIED;
 
+    const sp<AudioPolicyServiceClient> apc = getAudioPolicyServiceClient();
+    if (apc != 0 && apc->getCachedDevicesForAttributes(aa, forVolume, devices)) {
+        return OK;
+    }
+    const uint32_t cacheGeneration = apc != 0 ? apc->getCacheGeneration() : 0;
+
     media::AudioAttributesInternal aaAidl = VALUE_OR_RETURN_STATUS(
              legacy2aidl_audio_attributes_t_AudioAttributesInternal(aa));
     std::vector<AudioDevice> retAidl;
@@ -1378,6 +1394,9 @@ status_t AudioSystem::getDevicesForAttributes(const audio_attributes_t& aa,
             convertContainer<AudioDeviceTypeAddrVector>(
                     retAidl,
                     aidl2legacy_AudioDeviceTypeAddress));
+    if (apc != 0) {
+        apc->cacheDevicesForAttributes(cacheGeneration, aa, forVolume, *devices);
+    }
     return OK;
 }
 
@@ -1564,6 +1583,15 @@ status_t AudioSystem::listAudioPorts(audio_port_role_t role,
     const sp<IAudioPolicyService>& aps = AudioSystem::get_audio_policy_service();
     if (aps == 0) return PERMISSION_DENIED;
 
+    const sp<AudioPolicyServiceClient> apc = getAudioPolicyServiceClient();
+    std::vector<audio_port_v7> cachedPorts;
+    if (apc != 0 && apc->getCachedAudioPorts(role, type, &cachedPorts, generation)) {
+        std::copy_n(cachedPorts.begin(), std::min<size_t>(*num_ports, cachedPorts.size()), ports);
+        *num_ports = cachedPorts.size();
+        return OK;
+    }
+    const uint32_t cacheGeneration = apc != 0 ? apc->getCacheGeneration() : 0;
+
     media::AudioPortRole roleAidl = VALUE_OR_RETURN_STATUS(
             legacy2aidl_audio_port_role_t_AudioPortRole(role));
     media::AudioPortType typeAidl = VALUE_OR_RETURN_STATUS(
@@ -1579,6 +1607,11 @@ status_t AudioSystem::listAudioPorts(audio_port_role_t role,
     *generation = VALUE_OR_RETURN_STATUS(convertIntegral<unsigned int>(generationAidl));
     RETURN_STATUS_IF_ERROR(convertRange(portsAidl.begin(), portsAidl.end(), ports,
                                         aidl2legacy_AudioPortFw_audio_port_v7));
+    // Only a complete list can answer later queries, whatever their size.
+    if (apc != 0 && portsAidl.size() == *num_ports) {
+        apc->cacheAudioPorts(cacheGeneration, role, type,
+                std::vector<audio_port_v7>(ports, ports + *num_ports), *generation);
+    }
     return OK;
 }
 
@@ -1681,6 +1714,7 @@ status_t AudioSystem::addAudioPortCallback(const sp<AudioPortCallback>& callback
     int ret = gAudioPolicyServiceClient->addAudioPortCallback(callback);
     if (ret == 1) {
         aps->setAudioPortCallbacksEnabled(true);
+        gAudioPolicyServiceClient->setCacheEnabled(true);
     }
     return (ret < 0) ? INVALID_OPERATION : NO_ERROR;
 }
@@ -1696,6 +1730,7 @@ status_t AudioSystem::removeAudioPortCallback(const sp<AudioPortCallback>& callb
     }
     int ret = gAudioPolicyServiceClient->removeAudioPortCallback(callback);
     if (ret == 0) {
+        gAudioPolicyServiceClient->setCacheEnabled(false);
         aps->setAudioPortCallbacksEnabled(false);
     }
     return (ret < 0) ? INVALID_OPERATION : NO_ERROR;
@@ -2757,6 +2792,7 @@ int AudioSystem::AudioPolicyServiceClient::removeAudioPortCallback(
 
 
 Status AudioSystem::AudioPolicyServiceClient::onAudioPortListUpdate() {
+    invalidateCache();
     Mutex::Autolock _l(mLock);
     for (size_t i = 0; i < mAudioPortCallbacks.size(); i++) {
         mAudioPortCallbacks[i]->onAudioPortListUpdate();
@@ -2765,6 +2801,7 @@ Status AudioSystem::AudioPolicyServiceClient::onAudioPortListUpdate() {
 }
 
 Status AudioSystem::AudioPolicyServiceClient::onAudioPatchListUpdate() {
+    invalidateCache();
     Mutex::Autolock _l(mLock);
     for (size_t i = 0; i < mAudioPortCallbacks.size(); i++) {
         mAudioPortCallbacks[i]->onAudioPatchListUpdate();
@@ -2772,6 +2809,82 @@ Status AudioSystem::AudioPolicyServiceClient::onAudioPatchListUpdate() {
     return Status::ok();
 }
 
+void AudioSystem::AudioPolicyServiceClient::setCacheEnabled(bool enabled) {
+    Mutex::Autolock _l(mCacheLock);
+    mCacheEnabled = enabled;
+    // Updates may have been missed while the callbacks were disabled.
+    mCacheGeneration++;
+    mDevicesForAttributesCache.clear();
+    mAudioPortsCache.clear();
+}
+
+uint32_t AudioSystem::AudioPolicyServiceClient::getCacheGeneration() {
+    Mutex::Autolock _l(mCacheLock);
+    return mCacheGeneration;
+}
+
+void AudioSystem::AudioPolicyServiceClient::invalidateCache() {
+    Mutex::Autolock _l(mCacheLock);
+    mCacheGeneration++;
+    mDevicesForAttributesCache.clear();
+    mAudioPortsCache.clear();
+}
+
+bool AudioSystem::AudioPolicyServiceClient::getCachedDevicesForAttributes(
+        const audio_attributes_t& aa, bool forVolume, AudioDeviceTypeAddrVector* devices) {
+    Mutex::Autolock _l(mCacheLock);
+    for (const auto& entry : mDevicesForAttributesCache) {
+        if (entry.forVolume == forVolume && entry.attributes == aa) {
+            *devices = entry.devices;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioSystem::AudioPolicyServiceClient::cacheDevicesForAttributes(
+        uint32_t cacheGeneration, const audio_attributes_t& aa, bool forVolume,
+        const AudioDeviceTypeAddrVector& devices) {
+    // Routing updates, which follow changes of preferred devices, are only sent to services.
+    static const bool routingUpdatesReceived = isServiceUid(getuid());
+    if (!routingUpdatesReceived) return;
+    Mutex::Autolock _l(mCacheLock);
+    if (!mCacheEnabled || cacheGeneration != mCacheGeneration) return;
+    if (mDevicesForAttributesCache.size() >= kMaxCachedDevicesForAttributes) {
+        mDevicesForAttributesCache.erase(mDevicesForAttributesCache.begin());
+    }
+    mDevicesForAttributesCache.push_back({aa, forVolume, devices});
+}
+
+bool AudioSystem::AudioPolicyServiceClient::getCachedAudioPorts(
+        audio_port_role_t role, audio_port_type_t type, std::vector<audio_port_v7>* ports,
+        unsigned int* generation) {
+    Mutex::Autolock _l(mCacheLock);
+    for (const auto& entry : mAudioPortsCache) {
+        if (entry.role == role && entry.type == type) {
+            *ports = entry.ports;
+            *generation = entry.generation;
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioSystem::AudioPolicyServiceClient::cacheAudioPorts(
+        uint32_t cacheGeneration, audio_port_role_t role, audio_port_type_t type,
+        const std::vector<audio_port_v7>& ports, unsigned int generation) {
+    Mutex::Autolock _l(mCacheLock);
+    if (!mCacheEnabled || cacheGeneration != mCacheGeneration) return;
+    for (auto& entry : mAudioPortsCache) {
+        if (entry.role == role && entry.type == type) {
+            entry.ports = ports;
+            entry.generation = generation;
+            return;
+        }
+    }
+    mAudioPortsCache.push_back({role, type, ports, generation});
+}
+
 // ----------------------------------------------------------------------------
 int AudioSystem::AudioPolicyServiceClient::addAudioVolumeGroupCallback(
         const sp<AudioVolumeGroupCallback>& callback) {
@@ -2875,6 +2988,7 @@ Status AudioSystem::AudioPolicyServiceClient::onRecordingConfigurationUpdate(
 }
 
 Status AudioSystem::AudioPolicyServiceClient::onRoutingUpdated() {
+    invalidateCache();
     routing_callback cb = NULL;
     {
         Mutex::Autolock _l(AudioSystem::gLock);
@@ -2901,6 +3015,7 @@ Status AudioSystem::AudioPolicyServiceClient::onVolumeRangeInitRequest() {
 }
 
 void AudioSystem::AudioPolicyServiceClient::binderDied(const wp<IBinder>& who __unused) {
+    setCacheEnabled(false);
     {
         Mutex::Autolock _l(mLock);
         for (size_t i = 0; i < mAudioPortCallbacks.size(); i++) {
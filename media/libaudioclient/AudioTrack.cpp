@@ -219,6 +219,9 @@ void AudioTrack::MediaMetrics::gather(const AudioTrack *track)
     mMetricsItem->setCString(MM_PREFIX "attributes", toString(track->mAttributes).c_str());
     mMetricsItem->setCString(MM_PREFIX "logSessionId", track->mLogSessionId.c_str());
     mMetricsItem->setInt32(MM_PREFIX "underrunFrames", (int32_t)track->getUnderrunFrames());
+    mMetricsItem->setInt32(MM_PREFIX "writeWakeupFrames", (int32_t)track->mWriteWakeupFrames);
+    mMetricsItem->setInt64(MM_PREFIX "writeWaitCount", track->mWriteWaitCount.load());
+    mMetricsItem->setInt64(MM_PREFIX "writeWaitUs", track->mWriteWaitNs.load() / 1000);
 }
 
 // hand the user a snapshot of the metrics.
@@ -1479,6 +1482,34 @@ ssize_t AudioTrack::setStartThresholdInFrames(size_t startThresholdInFrames)
     return final;
 }
 
+ssize_t AudioTrack::getWriteWakeupThresholdInFrames() const
+{
+    AutoMutex lock(mLock);
+    if (mOutput == AUDIO_IO_HANDLE_NONE || mProxy.get() == 0) {
+        return NO_INIT;
+    }
+    return (ssize_t) mWriteWakeupFrames;
+}
+
+ssize_t AudioTrack::setWriteWakeupThresholdInFrames(size_t writeWakeupThresholdInFrames)
+{
+    if (writeWakeupThresholdInFrames > INT32_MAX) {
+        return BAD_VALUE;
+    }
+    AutoMutex lock(mLock);
+    if (mOutput == AUDIO_IO_HANDLE_NONE || mProxy.get() == 0) {
+        return NO_INIT;
+    }
+    // With a callback, the minimum also sets the notification period.
+    if (mTransfer != TRANSFER_SYNC) {
+        return INVALID_OPERATION;
+    }
+    // The server wakes up the client with at most half of the buffer available.
+    mWriteWakeupFrames = std::min(writeWakeupThresholdInFrames, mFrameCount / 2);
+    mProxy->setMinimum(std::max<size_t>(mNotificationFramesAct, mWriteWakeupFrames));
+    return (ssize_t) mWriteWakeupFrames;
+}
+
 status_t AudioTrack::setLoop(uint32_t loopStart, uint32_t loopEnd, int loopCount)
 {
     if (mSharedBuffer == 0 || isOffloadedOrDirect()) {
@@ -2043,7 +2074,7 @@ status_t AudioTrack::createTrack_l()
     playbackRateTemp.mSpeed = effectiveSpeed;
     playbackRateTemp.mPitch = effectivePitch;
     mProxy->setPlaybackRate(playbackRateTemp);
-    mProxy->setMinimum(mNotificationFramesAct);
+    mProxy->setMinimum(std::max<size_t>(mNotificationFramesAct, mWriteWakeupFrames));
 
     if (mDualMonoMode != AUDIO_DUAL_MONO_MODE_OFF) {
         setDualMonoMode_l(mDualMonoMode);
@@ -2337,8 +2368,14 @@ ssize_t AudioTrack::write(const void* buffer, size_t userSize, bool blocking)
     while (userSize >= mFrameSize) {
         audioBuffer.frameCount = userSize / mFrameSize;
 
+        // The elapsed time is only measured when obtainBuffer() waits.
+        struct timespec elapsed = {};
         status_t err = obtainBuffer(&audioBuffer,
-                blocking ? &ClientProxy::kForever : &ClientProxy::kNonBlocking);
+                blocking ? &ClientProxy::kForever : &ClientProxy::kNonBlocking, &elapsed);
+        if (elapsed.tv_sec != 0 || elapsed.tv_nsec != 0) {
+            mWriteWaitCount++;
+            mWriteWaitNs += audio_utils_ns_from_timespec(&elapsed);
+        }
         if (err < 0) {
             if (written > 0) {
                 break;
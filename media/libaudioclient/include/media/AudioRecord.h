@@ -674,6 +674,10 @@ private:
 
             void     updateRoutedDeviceId_l();
 
+            // For blocking read(): sleeps until about |frames| frames should be ready, so that
+            // a large read wakes up once rather than once per period written by the server.
+            void     sleepUntilFramesReady(size_t frames);
+
     sp<AudioRecordThread>   mAudioRecordThread;
     mutable Mutex           mLock;
 
@@ -872,14 +872,57 @@ private:
         binder::Status onRoutingUpdated();
         binder::Status onVolumeRangeInitRequest();
 
+        // Client side cache of audio policy queries, so that repeated queries do not cost
+        // an IPC. The results are only cached while the audio port callbacks are enabled,
+        // as these callbacks are what invalidates the cache.
+        // A result is stored with the cache generation read before the query, and dropped
+        // if the generation changed in the meantime.
+        // Called once the audio port callbacks are enabled or disabled in audio policy.
+        void setCacheEnabled(bool enabled);
+        uint32_t getCacheGeneration();
+        void invalidateCache();
+        bool getCachedDevicesForAttributes(const audio_attributes_t& aa, bool forVolume,
+                                           AudioDeviceTypeAddrVector* devices);
+        void cacheDevicesForAttributes(uint32_t cacheGeneration, const audio_attributes_t& aa,
+                                       bool forVolume, const AudioDeviceTypeAddrVector& devices);
+        bool getCachedAudioPorts(audio_port_role_t role, audio_port_type_t type,
+                                 std::vector<audio_port_v7>* ports, unsigned int* generation);
+        void cacheAudioPorts(uint32_t cacheGeneration, audio_port_role_t role,
+                             audio_port_type_t type, const std::vector<audio_port_v7>& ports,
+                             unsigned int generation);
+
     private:
+        // Bounds the cache size, for clients querying many different attributes.
+        static constexpr size_t kMaxCachedDevicesForAttributes = 16;
+
+        struct DevicesForAttributesEntry {
+            audio_attributes_t attributes;
+            bool forVolume;
+            AudioDeviceTypeAddrVector devices;
+        };
+
+        struct AudioPortsEntry {
+            audio_port_role_t role;
+            audio_port_type_t type;
+            std::vector<audio_port_v7> ports;
+            unsigned int generation;
+        };
+
         Mutex                               mLock;
         Vector <sp <AudioPortCallback> >    mAudioPortCallbacks;
         Vector <sp <AudioVolumeGroupCallback> > mAudioVolumeGroupCallback;
+
+        // mCacheLock is not held while calling out, and can be taken with mLock held.
+        Mutex                               mCacheLock;
+        bool                                mCacheEnabled = false;
+        uint32_t                            mCacheGeneration = 0;
+        std::vector<DevicesForAttributesEntry> mDevicesForAttributesCache;
+        std::vector<AudioPortsEntry>        mAudioPortsCache;
     };
 
     static audio_io_handle_t getOutput(audio_stream_type_t stream);
     static const sp<AudioFlingerClient> getAudioFlingerClient();
+    static sp<AudioPolicyServiceClient> getAudioPolicyServiceClient();
     static sp<AudioIoDescriptor> getIoDescriptor(audio_io_handle_t ioHandle);
 
     // Invokes all registered error callbacks with the given error code.
@@ -29,6 +29,7 @@
 #include <utils/threads.h>
 #include <android/content/AttributionSourceState.h>
 
+#include <atomic>
 #include <chrono>
 #include <string>
 
@@ -550,6 +551,22 @@ public:
      */
             ssize_t     setStartThresholdInFrames(size_t startThresholdInFrames);
 
+    /* Returns the write wakeup threshold in frames, 0 if not set,
+     * or a negative value if the AudioTrack is not initialized.
+     */
+            ssize_t     getWriteWakeupThresholdInFrames() const;
+
+    /* Sets the number of frames that must be free in the buffer before a blocking write(),
+     * waiting on a full buffer, is woken up by the server. This coalesces the wakeups of
+     * clients writing small chunks, at the cost of a lower buffer fill level.
+     * Only for TRANSFER_SYNC tracks. 0 restores the default.
+     *
+     * May be clamped internally, to at most half of the buffer. Returns the actual value set,
+     * or a negative value if the AudioTrack is not initialized, if the transfer mode is not
+     * TRANSFER_SYNC or if the input is greater than INT_MAX.
+     */
+            ssize_t     setWriteWakeupThresholdInFrames(size_t writeWakeupThresholdInFrames);
+
     /* Return the static buffer specified in constructor or set(), or 0 for streaming mode */
             sp<IMemory> sharedBuffer() const { return mSharedBuffer; }
 
@@ -1423,6 +1440,11 @@ public:
                                                     // delivered for static tracks).
                                                     // -1 indicates no previous restore point.
 
+    size_t                  mWriteWakeupFrames = 0; // see setWriteWakeupThresholdInFrames()
+    // Number of times a blocking write() waited for the server, and the total wait time.
+    std::atomic<int64_t>    mWriteWaitCount{0};
+    std::atomic<int64_t>    mWriteWaitNs{0};
+
     audio_output_flags_t    mFlags;                 // same as mOrigFlags, except for bits that may
                                                     // be denied by client or server, such as
                                                     // AUDIO_OUTPUT_FLAG_FAST.  mLock must be
@@ -452,6 +452,54 @@ TEST_F(AudioSystemTest, VolumeIndexForAttributes) {
     }
 }
 
+class CountingAudioPortCallback : public AudioSystem::AudioPortCallback {
+  public:
+    void onAudioPortListUpdate() override { mPortListUpdates++; }
+    void onAudioPatchListUpdate() override { mPatchListUpdates++; }
+    void onServiceDied() override {}
+
+    std::atomic<int> mPortListUpdates = 0;
+    std::atomic<int> mPatchListUpdates = 0;
+};
+
+TEST_F(AudioSystemTest, CachedQueriesWithPortCallback) {
+    std::vector<struct audio_port_v7> ports;
+    ASSERT_EQ(OK, listAudioPorts(ports));
+
+    // With port callbacks enabled, the results may come from the client side cache.
+    const auto callback = sp<CountingAudioPortCallback>::make();
+    ASSERT_EQ(OK, AudioSystem::addAudioPortCallback(callback));
+    audio_attributes_t attributes = AUDIO_ATTRIBUTES_INITIALIZER;
+    attributes.usage = AUDIO_USAGE_MEDIA;
+    for (int i = 0; i < 3; ++i) {
+        std::vector<struct audio_port_v7> cachedPorts;
+        EXPECT_EQ(OK, listAudioPorts(cachedPorts));
+        if (callback->mPortListUpdates == 0 && callback->mPatchListUpdates == 0) {
+            ASSERT_EQ(ports.size(), cachedPorts.size());
+            for (size_t j = 0; j < ports.size(); ++j) {
+                EXPECT_EQ(ports[j].id, cachedPorts[j].id);
+            }
+        }
+
+        // A count smaller than the list only returns a prefix, with the total count.
+        unsigned int numPorts = 1;
+        struct audio_port_v7 port;
+        unsigned int generation;
+        EXPECT_EQ(OK, AudioSystem::listAudioPorts(AUDIO_PORT_ROLE_NONE, AUDIO_PORT_TYPE_NONE,
+                                                  &numPorts, &port, &generation));
+        EXPECT_EQ(cachedPorts.size(), numPorts);
+
+        AudioDeviceTypeAddrVector devices;
+        AudioDeviceTypeAddrVector cachedDevices;
+        EXPECT_EQ(OK, AudioSystem::getDevicesForAttributes(attributes, &devices, false));
+        EXPECT_EQ(OK, AudioSystem::getDevicesForAttributes(attributes, &cachedDevices, false));
+        if (callback->mPatchListUpdates == 0) {
+            EXPECT_EQ(devices, cachedDevices);
+        }
+    }
+    EXPECT_EQ(OK, AudioSystem::removeAudioPortCallback(callback));
+}
+
 TEST_F(AudioSystemTest, DevicesRoleForCapturePreset) {
     std::vector<struct audio_port_v7> ports;
     status_t status = listAudioPorts(ports);
@@ -16,11 +16,14 @@
 
 //#define LOG_NDEBUG 0
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "audio_test_utils.h"
 
 using namespace android;
+using android::content::AttributionSourceState;
 
 TEST(AudioTrackTest, TestPlayTrack) {
     const auto ap = sp<AudioPlayback>::make(44100 /* sampleRate */, AUDIO_FORMAT_PCM_16_BIT,
@@ -154,6 +157,39 @@ TEST(AudioTrackTest, TestAudioCbNotifier) {
     ap->stop();
 }
 
+TEST(AudioTrackTest, WriteWakeupThreshold) {
+    AttributionSourceState attributionSource;
+    attributionSource.packageName = "AudioTrackTest";
+    attributionSource.uid = VALUE_OR_FATAL(legacy2aidl_uid_t_int32_t(getuid()));
+    attributionSource.pid = VALUE_OR_FATAL(legacy2aidl_pid_t_int32_t(getpid()));
+    attributionSource.token = sp<BBinder>::make();
+    const auto track = sp<AudioTrack>::make(attributionSource);
+    EXPECT_EQ(NO_INIT, track->setWriteWakeupThresholdInFrames(0));
+    ASSERT_EQ(OK, track->set(AUDIO_STREAM_MUSIC, 44100 /* sampleRate */, AUDIO_FORMAT_PCM_16_BIT,
+                             AUDIO_CHANNEL_OUT_STEREO, 0 /* frameCount */, AUDIO_OUTPUT_FLAG_NONE,
+                             nullptr /* callback */, 0 /* notificationFrames */,
+                             nullptr /* sharedBuffer */, false /* canCallJava */,
+                             AUDIO_SESSION_NONE, AudioTrack::TRANSFER_SYNC, nullptr /* offloadInfo */,
+                             attributionSource));
+    ASSERT_EQ(OK, track->initCheck());
+    EXPECT_EQ(0, track->getWriteWakeupThresholdInFrames());
+
+    const ssize_t halfBuffer = track->frameCount() / 2;
+    EXPECT_EQ(std::min<ssize_t>(64, halfBuffer), track->setWriteWakeupThresholdInFrames(64));
+    EXPECT_EQ(std::min<ssize_t>(64, halfBuffer), track->getWriteWakeupThresholdInFrames());
+    // Clamped to half of the buffer.
+    EXPECT_EQ(halfBuffer, track->setWriteWakeupThresholdInFrames(track->frameCount()));
+    EXPECT_EQ(BAD_VALUE, track->setWriteWakeupThresholdInFrames((size_t)INT32_MAX + 1));
+
+    // A blocking write still completes with the threshold set.
+    std::vector<int16_t> data(track->frameCount() * 2 /* channels */ * 4);
+    EXPECT_EQ(OK, track->start());
+    EXPECT_EQ((ssize_t)(data.size() * sizeof(int16_t)),
+              track->write(data.data(), data.size() * sizeof(int16_t)));
+    track->stop();
+    EXPECT_EQ(0, track->setWriteWakeupThresholdInFrames(0));
+}
+
 class AudioTrackCreateTest
     : public ::testing::TestWithParam<std::tuple<uint32_t, audio_format_t, audio_channel_mask_t,
                                                  audio_output_flags_t, audio_session_t>> {
@@ -39,10 +39,17 @@ status_t EffectBufferHalAidl::allocate(size_t size, sp<EffectBufferHalInterface>
 status_t EffectBufferHalAidl::mirror(void* external, size_t size,
                                      sp<EffectBufferHalInterface>* buffer) {
     sp<EffectBufferHalAidl> tempBuffer = new EffectBufferHalAidl(size);
-    status_t status = tempBuffer.get()->init();
-    if (status != OK) {
-        ALOGE("%s init failed %d", __func__, status);
-        return status;
+    if (external == nullptr) {
+        status_t status = tempBuffer.get()->init();
+        if (status != OK) {
+            ALOGE("%s init failed %d", __func__, status);
+            return status;
+        }
+    } else {
+        // The audio data is exchanged with the AIDL effect through its data FMQs, never through
+        // the memory of this buffer. So a mirror uses the external memory directly, and
+        // update() and commit() have nothing to copy.
+        tempBuffer->mAudioBuffer.raw = external;
     }
 
     tempBuffer->setExternalData(external);
@@ -58,6 +65,9 @@ EffectBufferHalAidl::EffectBufferHalAidl(size_t size)
 }
 
 EffectBufferHalAidl::~EffectBufferHalAidl() {
+    if (mMemory.fd.get() >= 0 && mAudioBuffer.raw != nullptr) {
+        munmap(mAudioBuffer.raw, mBufferSize);
+    }
 }
 
 status_t EffectBufferHalAidl::init() {
@@ -112,7 +122,7 @@ void EffectBufferHalAidl::commit() {
 }
 
 void EffectBufferHalAidl::copy(void* dst, const void* src, size_t n) const {
-    if (!dst || !src) {
+    if (!dst || !src || dst == src) {
         return;
     }
     std::memcpy(dst, src, std::min(n, mBufferSize));
@@ -212,7 +212,7 @@ status_t EffectHalAidl::process() {
         return INVALID_OPERATION;
     }
 
-    ALOGD("%s %s consumed %zu produced %zu", __func__, mDesc.common.name.c_str(), floatsToWrite,
+    ALOGV("%s %s consumed %zu produced %zu", __func__, mDesc.common.name.c_str(), floatsToWrite,
           floatsToRead);
     return OK;
 }
@@ -491,6 +491,7 @@ status_t StreamHalAidl::sendCommand(
     {
         std::lock_guard l(mLock);
         mLastReply = *reply;
+        mLastReplyTimeNs = systemTime();
     }
     switch (reply->status) {
         case STATUS_OK: return OK;
@@ -506,16 +507,23 @@ status_t StreamHalAidl::sendCommand(
 
 status_t StreamHalAidl::updateCountersIfNeeded(
         ::aidl::android::hardware::audio::core::StreamDescriptor::Reply* reply) {
-    if (mWorkerTid.load(std::memory_order_acquire) == gettid()) {
-        if (const auto state = getState(); state != StreamDescriptor::State::ACTIVE &&
+    const bool isWorker = mWorkerTid.load(std::memory_order_acquire) == gettid();
+    bool needStatus = false;
+    {
+        std::lock_guard l(mLock);
+        // In the active states the counters are updated by the reply of each burst.
+        if (const auto state = mLastReply.state; isWorker &&
+                state != StreamDescriptor::State::ACTIVE &&
                 state != StreamDescriptor::State::DRAINING &&
                 state != StreamDescriptor::State::TRANSFERRING) {
-            return sendCommand(makeHalCommand<HalCommand::Tag::getStatus>(), reply);
+            needStatus = systemTime() - mLastReplyTimeNs >= kCountersMaxAgeNs;
+        }
+        if (!needStatus && reply != nullptr) {
+            *reply = mLastReply;
         }
     }
-    if (reply != nullptr) {
-        std::lock_guard l(mLock);
-        *reply = mLastReply;
+    if (needStatus) {
+        return sendCommand(makeHalCommand<HalCommand::Tag::getStatus>(), reply);
     }
     return OK;
 }
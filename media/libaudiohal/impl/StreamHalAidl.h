@@ -30,6 +30,7 @@
 #include <media/audiohal/EffectHalInterface.h>
 #include <media/audiohal/StreamHalInterface.h>
 #include <media/AudioParameter.h>
+#include <utils/Timers.h>
 
 #include "ConversionHelperAidl.h"
 #include "StreamPowerLog.h"
@@ -246,9 +247,15 @@ class StreamHalAidl : public virtual StreamHalInterface, public ConversionHelper
     status_t updateCountersIfNeeded(
             ::aidl::android::hardware::audio::core::StreamDescriptor::Reply* reply = nullptr);
 
+    // The thread loop typically queries the position, the latency and the xruns one after
+    // the other. A reply younger than this is reused for the counters instead of making
+    // another getStatus round trip.
+    static constexpr nsecs_t kCountersMaxAgeNs = 1000000;  // 1 ms
+
     const std::shared_ptr<::aidl::android::hardware::audio::core::IStreamCommon> mStream;
     std::mutex mLock;
     ::aidl::android::hardware::audio::core::StreamDescriptor::Reply mLastReply GUARDED_BY(mLock);
+    nsecs_t mLastReplyTimeNs GUARDED_BY(mLock) = 0;
     // mStreamPowerLog is used for audio signal power logging.
     StreamPowerLog mStreamPowerLog;
     std::atomic<pid_t> mWorkerTid = -1;
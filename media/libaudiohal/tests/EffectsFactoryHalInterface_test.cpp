@@ -20,7 +20,9 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <utility>
+#include <vector>
 #define LOG_TAG "EffectsFactoryHalInterfaceTest"
 
 #include <aidl/android/media/audio/common/AudioUuid.h>
@@ -142,6 +144,29 @@ TEST(libAudioHalTest, getHalVersion) {
     EXPECT_NE(0, version.getMajorVersion());
 }
 
+TEST(libAudioHalTest, mirrorBuffer) {
+    auto factory = EffectsFactoryHalInterface::create();
+    ASSERT_NE(nullptr, factory);
+
+    constexpr size_t kSamples = 480;
+    std::vector<float> external(kSamples);
+    sp<EffectBufferHalInterface> buffer;
+    ASSERT_EQ(OK, factory->mirrorBuffer(external.data(), kSamples * sizeof(float), &buffer));
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(external.data(), buffer->externalData());
+    ASSERT_NE(nullptr, buffer->audioBuffer()->raw);
+
+    // The effect sees the external data after update(), whether or not it is copied.
+    std::iota(external.begin(), external.end(), 0.f);
+    buffer->update();
+    EXPECT_EQ(0, memcmp(external.data(), buffer->audioBuffer()->f32, kSamples * sizeof(float)));
+
+    // And the external data has the effect output after commit().
+    std::fill(buffer->audioBuffer()->f32, buffer->audioBuffer()->f32 + kSamples, 1.f);
+    buffer->commit();
+    EXPECT_EQ(std::vector<float>(kSamples, 1.f), external);
+}
+
 class EffectParamCombination {
   public:
     template <typename P, typename V>
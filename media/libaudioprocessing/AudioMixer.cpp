@@ -19,6 +19,7 @@
 //#define LOG_NDEBUG 0
 
 #include <sstream>
+#include <vector>
 #include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
@@ -140,6 +141,8 @@ bool AudioMixer::setChannelMasks(int name,
 void AudioMixer::Track::unprepareForDownmix() {
     ALOGV("AudioMixer::unprepareForDownmix(%p)", this);
 
+    // the fused provider refers to the downmixer, release it first.
+    mFusedBufferProvider.reset(nullptr);
     if (mPostDownmixReformatBufferProvider.get() != nullptr) {
         // release any buffers held by the mPostDownmixReformatBufferProvider
         // before deallocating the mDownmixerBufferProvider.
@@ -220,6 +223,8 @@ status_t AudioMixer::Track::prepareForDownmix()
 void AudioMixer::Track::unprepareForReformat() {
     ALOGV("AudioMixer::unprepareForReformat(%p)", this);
     bool requiresReconfigure = false;
+    // the fused provider refers to the reformatters, release it first.
+    mFusedBufferProvider.reset(nullptr);
     if (mReformatBufferProvider.get() != nullptr) {
         mReformatBufferProvider.reset(nullptr);
         requiresReconfigure = true;
@@ -346,17 +351,32 @@ void AudioMixer::Track::reconfigureBufferProviders()
         mAdjustChannelsBufferProvider->setBufferProvider(bufferProvider);
         bufferProvider = mAdjustChannelsBufferProvider.get();
     }
-    if (mReformatBufferProvider.get() != nullptr) {
-        mReformatBufferProvider->setBufferProvider(bufferProvider);
-        bufferProvider = mReformatBufferProvider.get();
-    }
-    if (mDownmixerBufferProvider.get() != nullptr) {
-        mDownmixerBufferProvider->setBufferProvider(bufferProvider);
-        bufferProvider = mDownmixerBufferProvider.get();
+    // The reformat and downmix providers are all CopyBufferProviders.
+    std::vector<CopyBufferProvider *> copyStages;
+    for (const auto &provider : { mReformatBufferProvider.get(),
+            mDownmixerBufferProvider.get(), mPostDownmixReformatBufferProvider.get() }) {
+        if (provider != nullptr) {
+            copyStages.push_back(static_cast<CopyBufferProvider *>(provider));
+        }
     }
-    if (mPostDownmixReformatBufferProvider.get() != nullptr) {
-        mPostDownmixReformatBufferProvider->setBufferProvider(bufferProvider);
-        bufferProvider = mPostDownmixReformatBufferProvider.get();
+    if (copyStages.size() > 1) {
+        // Run the conversions in one pass, the fused provider is released
+        // whenever one of its stages is removed.
+        if (mFusedBufferProvider.get() == nullptr) {
+            for (CopyBufferProvider *provider : copyStages) {
+                provider->setBufferProvider(nullptr); // only used through copyFrames().
+            }
+            mFusedBufferProvider.reset(
+                    new FusedCopyBufferProvider(copyStages, kCopyBufferFrameCount));
+        }
+        mFusedBufferProvider->setBufferProvider(bufferProvider);
+        bufferProvider = mFusedBufferProvider.get();
+    } else {
+        mFusedBufferProvider.reset(nullptr);
+        for (CopyBufferProvider *provider : copyStages) {
+            provider->setBufferProvider(bufferProvider);
+            bufferProvider = provider;
+        }
     }
     if (mTimestretchBufferProvider.get() != nullptr) {
         mTimestretchBufferProvider->setBufferProvider(bufferProvider);
@@ -539,6 +559,8 @@ void AudioMixer::setBufferProvider(int name, AudioBufferProvider* bufferProvider
     // reset order from downstream to upstream buffer providers.
     if (track->mTimestretchBufferProvider.get() != nullptr) {
         track->mTimestretchBufferProvider->reset();
+    } else if (track->mFusedBufferProvider.get() != nullptr) {
+        track->mFusedBufferProvider->reset();
     } else if (track->mPostDownmixReformatBufferProvider.get() != nullptr) {
         track->mPostDownmixReformatBufferProvider->reset();
     } else if (track->mDownmixerBufferProvider != nullptr) {
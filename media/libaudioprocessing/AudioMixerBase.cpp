@@ -518,6 +518,9 @@ bool AudioMixerBase::TrackBase::setResampler(uint32_t trackSampleRate, uint32_t
                         mMixerInFormat,
                         resamplerChannelCount,
                         devSampleRate, quality));
+                // Design the filter now rather than in the first process call,
+                // which matters for a FastMixer running with a tight deadline.
+                mResampler->setSampleRate(trackSampleRate);
             }
             return true;
         }
@@ -737,6 +740,24 @@ void AudioMixerBase::process__validate()
         }
     }
 
+    // large track sets are split into partitions mixed concurrently.
+    if (mSubmixExecutor != nullptr && mEnabled.size() >= mSubmixTrackThreshold
+            && (mHook == &AudioMixerBase::process__genericResampling
+                    || mHook == &AudioMixerBase::process__genericNoResampling)) {
+        const size_t partitions = std::min(mSubmixExecutor->partitions(), mEnabled.size());
+        if (mSubmixPartitions.size() < partitions) {
+            mSubmixPartitions.resize(partitions);
+        }
+        for (auto &p : mSubmixPartitions) {
+            if (p.outTemp.get() == nullptr) {
+                p.outTemp.reset(new int32_t[MAX_NUM_CHANNELS * mFrameCount]);
+                p.resampleTemp.reset(new int32_t[MAX_NUM_CHANNELS * mFrameCount]);
+            }
+            p.names.reserve(mEnabled.size());
+        }
+        mHook = &AudioMixerBase::process__parallelSubmix;
+    }
+
     ALOGV("mixer configuration change: %zu "
         "all16BitsStereoNoResample=%d, resampling=%d, volumeRamp=%d",
         mEnabled.size(), all16BitsStereoNoResample, resampling, volumeRamp);
@@ -1186,41 +1207,122 @@ void AudioMixerBase::process__genericResampling()
         // clear temp buffer
         memset(outTemp, 0, sizeof(*outTemp) * t1->mMixerChannelCount * mFrameCount);
         for (const int name : group) {
-            const std::shared_ptr<TrackBase> &t = mTracks[name];
-            int32_t *aux = NULL;
-            if (CC_UNLIKELY(t->needs & NEEDS_AUX)) {
-                aux = t->auxBuffer;
-            }
+            mixTrack(mTracks[name], outTemp, mResampleTemp.get() /* naked ptr */);
+        }
+        convertMixerFormat(t1->mainBuffer, t1->mMixerFormat,
+                outTemp, t1->mMixerInFormat, numFrames * t1->mMixerChannelCount);
+    }
+}
 
-            // this is a little goofy, on the resampling case we don't
-            // acquire/release the buffers because it's done by
-            // the resampler.
-            if (t->needs & NEEDS_RESAMPLE) {
-                (t.get()->*t->hook)(outTemp, numFrames, mResampleTemp.get() /* naked ptr */, aux);
-            } else {
+void AudioMixerBase::mixTrack(
+        const std::shared_ptr<TrackBase> &t, int32_t *outTemp, int32_t *resampleTemp)
+{
+    const size_t numFrames = mFrameCount;
+    int32_t *aux = NULL;
+    if (CC_UNLIKELY(t->needs & NEEDS_AUX)) {
+        aux = t->auxBuffer;
+    }
 
-                size_t outFrames = 0;
+    // this is a little goofy, on the resampling case we don't
+    // acquire/release the buffers because it's done by
+    // the resampler.
+    if (t->needs & NEEDS_RESAMPLE) {
+        (t.get()->*t->hook)(outTemp, numFrames, resampleTemp, aux);
+    } else {
 
-                while (outFrames < numFrames) {
-                    t->buffer.frameCount = numFrames - outFrames;
-                    t->bufferProvider->getNextBuffer(&t->buffer);
-                    t->mIn = t->buffer.raw;
-                    // t->mIn == nullptr can happen if the track was flushed just after having
-                    // been enabled for mixing.
-                    if (t->mIn == nullptr) break;
+        size_t outFrames = 0;
+
+        while (outFrames < numFrames) {
+            t->buffer.frameCount = numFrames - outFrames;
+            t->bufferProvider->getNextBuffer(&t->buffer);
+            t->mIn = t->buffer.raw;
+            // t->mIn == nullptr can happen if the track was flushed just after having
+            // been enabled for mixing.
+            if (t->mIn == nullptr) break;
 
-                    (t.get()->*t->hook)(
-                            outTemp + outFrames * t->mMixerChannelCount, t->buffer.frameCount,
-                            mResampleTemp.get() /* naked ptr */,
-                            aux != nullptr ? aux + outFrames : nullptr);
-                    outFrames += t->buffer.frameCount;
+            (t.get()->*t->hook)(
+                    outTemp + outFrames * t->mMixerChannelCount, t->buffer.frameCount,
+                    resampleTemp, aux != nullptr ? aux + outFrames : nullptr);
+            outFrames += t->buffer.frameCount;
 
-                    t->bufferProvider->releaseBuffer(&t->buffer);
+            t->bufferProvider->releaseBuffer(&t->buffer);
+        }
+    }
+}
+
+void AudioMixerBase::setSubmixExecutor(SubmixExecutor *executor, size_t trackThreshold)
+{
+    if (executor == nullptr || executor->partitions() < 2 || trackThreshold < 2) {
+        executor = nullptr;
+        trackThreshold = 0;
+    }
+    mSubmixExecutor = executor;
+    mSubmixTrackThreshold = trackThreshold;
+    mSubmixPartitions.clear();
+    invalidate();
+}
+
+void AudioMixerBase::SubmixJob::mix(size_t partition)
+{
+    SubmixPartition &p = mMixer->mSubmixPartitions[partition];
+    for (const int name : p.names) {
+        mMixer->mixTrack(mMixer->mTracks[name], p.outTemp.get(), p.resampleTemp.get());
+    }
+}
+
+// parallel sub-mix of large groups, partitions are mixed by the SubmixExecutor
+void AudioMixerBase::process__parallelSubmix()
+{
+    ALOGVV("process__parallelSubmix\n");
+    SubmixJob job(this);
+
+    for (const auto &pair : mGroups) {
+        const auto &group = pair.second;
+        const std::shared_ptr<TrackBase> &t1 = mTracks[group[0]];
+        const size_t sampleCount = t1->mMixerChannelCount * mFrameCount;
+        const size_t count = group.size() < mSubmixTrackThreshold ? 1
+                : std::min(mSubmixPartitions.size(), group.size());
+
+        for (size_t i = 0; i < count; ++i) {
+            mSubmixPartitions[i].names.clear();
+            memset(mSubmixPartitions[i].outTemp.get(), 0, sizeof(int32_t) * sampleCount);
+        }
+        // Tracks with an aux send may share the aux buffer, so they are all
+        // mixed on the calling thread in partition 0.
+        size_t next = 0;
+        for (const int name : group) {
+            if (mTracks[name]->needs & NEEDS_AUX) {
+                mSubmixPartitions[0].names.push_back(name);
+            } else {
+                mSubmixPartitions[next].names.push_back(name);
+                next = (next + 1) % count;
+            }
+        }
+
+        if (count > 1) {
+            mSubmixExecutor->run(&job, count);
+        } else {
+            job.mix(0);
+        }
+
+        // sum the partial sub-mixes into partition 0.
+        int32_t * const outTemp = mSubmixPartitions[0].outTemp.get();
+        for (size_t i = 1; i < count; ++i) {
+            const int32_t * const partial = mSubmixPartitions[i].outTemp.get();
+            if (t1->mMixerInFormat == AUDIO_FORMAT_PCM_FLOAT) {
+                float * const dst = reinterpret_cast<float *>(outTemp);
+                const float * const src = reinterpret_cast<const float *>(partial);
+                for (size_t j = 0; j < sampleCount; ++j) {
+                    dst[j] += src[j];
+                }
+            } else {
+                for (size_t j = 0; j < sampleCount; ++j) {
+                    outTemp[j] += partial[j];
                 }
             }
         }
         convertMixerFormat(t1->mainBuffer, t1->mMixerFormat,
-                outTemp, t1->mMixerInFormat, numFrames * t1->mMixerChannelCount);
+                outTemp, t1->mMixerInFormat, sampleCount);
     }
 }
 
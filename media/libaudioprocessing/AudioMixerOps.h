@@ -21,6 +21,8 @@
 #include <audio_utils/primitives.h>
 #include <system/audio.h>
 
+#include "AudioMixerOpsSimd.h"
+
 namespace android {
 
 // Hack to make static_assert work in a constexpr
@@ -372,6 +374,67 @@ void stereoVolumeHelper(TO*& out, const TI*& in, const TV *vol, F f) {
     stereoVolumeHelperWithChannelMask<MIXTYPE, MASK, TO, TI, TV, F>(out, in, vol, f);
 }
 
+/*
+ * Compile-time selection of the SIMD kernels in AudioMixerOpsSimd.h.
+ *
+ * volumeMulti and volumeRampMulti use the SIMD kernels for <float, float, float>
+ * when there is no aux. The remaining MIXTYPE (expansion from mono or stereo input)
+ * and any non-canonical channel count use the scalar path.
+ */
+constexpr inline bool mixTypeAccumulates(int mixtype) {
+    return mixtype == MIXTYPE_MULTI
+            || mixtype == MIXTYPE_MULTI_MONOVOL
+            || mixtype == MIXTYPE_MULTI_STEREOVOL;
+}
+
+template <int MIXTYPE, int NCHAN, typename TO, typename TI, typename TV>
+constexpr inline bool useSimdVolumeMulti() {
+    if constexpr (!MIXER_OPS_USE_SIMD
+            || !std::is_same_v<TO, float>
+            || !std::is_same_v<TI, float>
+            || !std::is_same_v<std::decay_t<TV>, float>) {
+        return false;
+    } else if constexpr (MIXTYPE == MIXTYPE_MULTI || MIXTYPE == MIXTYPE_MULTI_SAVEONLY) {
+        return NCHAN <= 2;
+    } else if constexpr (MIXTYPE == MIXTYPE_MULTI_MONOVOL
+            || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_MONOVOL) {
+        return true;
+    } else if constexpr (MIXTYPE == MIXTYPE_MULTI_STEREOVOL
+            || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_STEREOVOL) {
+        return canonicalChannelMaskFromCount(NCHAN) != AUDIO_CHANNEL_NONE;
+    } else /* constexpr */ {
+        return false;
+    }
+}
+
+template <int MIXTYPE, int NCHAN, typename TO, typename TI, typename TV>
+constexpr inline bool useSimdVolumeRampMulti() {
+    return useSimdVolumeMulti<MIXTYPE, NCHAN, TO, TI, TV>() && (NCHAN <= 2 || NCHAN % 4 == 0);
+}
+
+/*
+ * Computes the NCHAN per-channel float gains that MIXTYPE applies for the volume array vol.
+ * The stereo volume case reuses stereoVolumeHelper so the channel affinity is identical.
+ */
+template <int MIXTYPE, int NCHAN, typename TV>
+inline void channelVolumes(float *chanVol, const TV *vol) {
+    if constexpr (MIXTYPE == MIXTYPE_MULTI || MIXTYPE == MIXTYPE_MULTI_SAVEONLY) {
+        for (int i = 0; i < NCHAN; ++i) {
+            chanVol[i] = vol[i];
+        }
+    } else if constexpr (MIXTYPE == MIXTYPE_MULTI_MONOVOL
+            || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_MONOVOL) {
+        for (int i = 0; i < NCHAN; ++i) {
+            chanVol[i] = vol[0];
+        }
+    } else /* constexpr */ {
+        const float unused[NCHAN]{};
+        const float *in = unused;
+        stereoVolumeHelper<MIXTYPE_MULTI_SAVEONLY_STEREOVOL, NCHAN>(
+                chanVol, in, vol, [] (const auto &, const auto &b) { return b; });
+    }
+}
+
 /*
  * The volumeRampMulti and volumeRamp functions take a MIXTYPE
  * which indicates the per-frame mixing and accumulation strategy.
@@ -435,6 +498,30 @@ inline void volumeRampMulti(TO* out, size_t frameCount,
 {
 #ifdef ALOGVV
     ALOGVV("volumeRampMulti, MIXTYPE:%d\n", MIXTYPE);
+#endif
+#if MIXER_OPS_USE_SIMD
+    if constexpr (useSimdVolumeRampMulti<MIXTYPE, NCHAN, TO, TI, TV>()) {
+        if (aux == NULL) {
+            mixer_simd::volumeRampMulti<NCHAN, mixTypeAccumulates(MIXTYPE)>(
+                    out, frameCount, in,
+                    [vol] (float *frameVol) { channelVolumes<MIXTYPE, NCHAN>(frameVol, vol); },
+                    [vol, volinc] () {
+                        if constexpr (MIXTYPE == MIXTYPE_MULTI
+                                || MIXTYPE == MIXTYPE_MULTI_SAVEONLY) {
+                            for (int i = 0; i < NCHAN; ++i) {
+                                vol[i] += volinc[i];
+                            }
+                        } else if constexpr (MIXTYPE == MIXTYPE_MULTI_MONOVOL
+                                || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_MONOVOL) {
+                            vol[0] += volinc[0];
+                        } else /* constexpr */ {
+                            vol[0] += volinc[0];
+                            vol[1] += volinc[1];
+                        }
+                    });
+            return;
+        }
+    }
 #endif
     if (aux != NULL) {
         do {
@@ -529,6 +616,17 @@ inline void volumeMulti(TO* out, size_t frameCount,
 {
 #ifdef ALOGVV
     ALOGVV("volumeMulti MIXTYPE:%d\n", MIXTYPE);
+#endif
+#if MIXER_OPS_USE_SIMD
+    if constexpr (useSimdVolumeMulti<MIXTYPE, NCHAN, TO, TI, TV>()) {
+        if (aux == NULL) {
+            float chanVol[NCHAN];
+            channelVolumes<MIXTYPE, NCHAN>(chanVol, vol);
+            mixer_simd::volumeMulti<NCHAN, mixTypeAccumulates(MIXTYPE)>(
+                    out, frameCount, in, chanVol);
+            return;
+        }
+    }
 #endif
     if (aux != NULL) {
         do {
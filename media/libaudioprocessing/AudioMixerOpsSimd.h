@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_MIXER_OPS_SIMD_H
+#define ANDROID_AUDIO_MIXER_OPS_SIMD_H
+
+#include <numeric>
+#include <stddef.h>
+
+/*
+ * SIMD kernels for the <float, float, float> mixer paths of AudioMixerOps.h.
+ *
+ * Only the float output, float input, float volume case is accelerated, as this is
+ * what the AudioMixer uses for high precision audio (see the comment on MixMul).
+ * The kernels are selected at compile time per MIXTYPE and NCHAN by volumeMulti and
+ * volumeRampMulti; any configuration not handled here falls back to the scalar loop.
+ *
+ * Multiplication and accumulation are kept as separate operations (no fused multiply-add)
+ * so that the results are bit-exact with the scalar path.
+ *
+ * Define USE_NEON=false or USE_SSE=false to disable the kernels for benchmarking.
+ */
+
+#if (defined(__aarch64__) || defined(__ARM_NEON__)) && !(defined(USE_NEON) && !USE_NEON)
+#define MIXER_OPS_USE_NEON (true)
+#define MIXER_OPS_USE_SSE (false)
+#include <arm_neon.h>
+#elif (defined(__SSE2__) || defined(__x86_64__)) && !(defined(USE_SSE) && !USE_SSE)
+#define MIXER_OPS_USE_NEON (false)
+#define MIXER_OPS_USE_SSE (true)
+#include <emmintrin.h>
+#else
+#define MIXER_OPS_USE_NEON (false)
+#define MIXER_OPS_USE_SSE (false)
+#endif
+
+#define MIXER_OPS_USE_SIMD (MIXER_OPS_USE_NEON || MIXER_OPS_USE_SSE)
+
+namespace android {
+namespace mixer_simd {
+
+#if MIXER_OPS_USE_SIMD
+
+// Number of float lanes in a vector register.
+constexpr size_t kLanes = 4;
+
+#if MIXER_OPS_USE_NEON
+using vfloat = float32x4_t;
+inline vfloat vload(const float *p) { return vld1q_f32(p); }
+inline void vstore(float *p, vfloat v) { vst1q_f32(p, v); }
+inline vfloat vdup(float f) { return vdupq_n_f32(f); }
+inline vfloat vmul(vfloat a, vfloat b) { return vmulq_f32(a, b); }
+inline vfloat vadd(vfloat a, vfloat b) { return vaddq_f32(a, b); }
+#else
+using vfloat = __m128;
+inline vfloat vload(const float *p) { return _mm_loadu_ps(p); }
+inline void vstore(float *p, vfloat v) { _mm_storeu_ps(p, v); }
+inline vfloat vdup(float f) { return _mm_set1_ps(f); }
+inline vfloat vmul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+inline vfloat vadd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+#endif
+
+// out = in * gain, or out += in * gain if ACCUMULATE, for one vector of samples.
+template <bool ACCUMULATE>
+inline void mulStore(float *out, const float *in, vfloat gain) {
+    vfloat v = vmul(vload(in), gain);
+    if constexpr (ACCUMULATE) {
+        v = vadd(vload(out), v);
+    }
+    vstore(out, v);
+}
+
+/*
+ * Applies a constant per-channel gain to frameCount interleaved frames of NCHAN channels.
+ *
+ * The channel gains repeat every NCHAN samples but a vector holds kLanes samples,
+ * so the gains are laid out over lcm(NCHAN, kLanes) samples and processed as a block.
+ */
+template <int NCHAN, bool ACCUMULATE>
+inline void volumeMulti(float *out, size_t frameCount, const float *in, const float *chanVol) {
+    constexpr size_t PATTERN = std::lcm(static_cast<size_t>(NCHAN), kLanes);
+    constexpr size_t FRAMES_PER_BLOCK = PATTERN / NCHAN;
+    constexpr size_t VECTORS_PER_BLOCK = PATTERN / kLanes;
+
+    float pattern[PATTERN];
+    for (size_t i = 0; i < PATTERN; ++i) {
+        pattern[i] = chanVol[i % NCHAN];
+    }
+    vfloat gains[VECTORS_PER_BLOCK];
+    for (size_t i = 0; i < VECTORS_PER_BLOCK; ++i) {
+        gains[i] = vload(pattern + i * kLanes);
+    }
+
+    for (size_t blocks = frameCount / FRAMES_PER_BLOCK; blocks > 0; --blocks) {
+        for (size_t i = 0; i < VECTORS_PER_BLOCK; ++i) {
+            mulStore<ACCUMULATE>(out, in, gains[i]);
+            out += kLanes;
+            in += kLanes;
+        }
+    }
+    for (size_t i = 0; i < (frameCount % FRAMES_PER_BLOCK) * NCHAN; ++i) {
+        if constexpr (ACCUMULATE) {
+            out[i] += in[i] * pattern[i];
+        } else {
+            out[i] = in[i] * pattern[i];
+        }
+    }
+}
+
+/*
+ * Applies a per-frame ramped gain to frameCount interleaved frames of NCHAN channels.
+ *
+ * GAINS(float *frameVol) fills the NCHAN channel gains for the current frame and
+ * STEP() advances the ramp by one frame.  The ramp itself is accumulated in scalar,
+ * exactly as the scalar path does, so the final volumes are identical.
+ *
+ * NCHAN must be 1, 2 or a multiple of kLanes.
+ */
+template <int NCHAN, bool ACCUMULATE, typename GAINS, typename STEP>
+inline void volumeRampMulti(float *out, size_t frameCount, const float *in,
+        GAINS gains, STEP step) {
+    static_assert(NCHAN == 1 || NCHAN == 2 || NCHAN % kLanes == 0);
+    if constexpr (NCHAN % kLanes == 0) {
+        float frameVol[NCHAN];
+        for (; frameCount > 0; --frameCount) {
+            gains(frameVol);
+            step();
+            for (size_t i = 0; i < NCHAN; i += kLanes) {
+                mulStore<ACCUMULATE>(out, in, vload(frameVol + i));
+                out += kLanes;
+                in += kLanes;
+            }
+        }
+    } else {
+        constexpr size_t FRAMES_PER_VECTOR = kLanes / NCHAN;
+        float vectorVol[kLanes];
+        for (; frameCount >= FRAMES_PER_VECTOR; frameCount -= FRAMES_PER_VECTOR) {
+            for (size_t i = 0; i < kLanes; i += NCHAN) {
+                gains(vectorVol + i);
+                step();
+            }
+            mulStore<ACCUMULATE>(out, in, vload(vectorVol));
+            out += kLanes;
+            in += kLanes;
+        }
+        for (; frameCount > 0; --frameCount) {
+            gains(vectorVol);
+            step();
+            for (size_t i = 0; i < NCHAN; ++i) {
+                if constexpr (ACCUMULATE) {
+                    *out++ += *in++ * vectorVol[i];
+                } else {
+                    *out++ = *in++ * vectorVol[i];
+                }
+            }
+        }
+    }
+}
+
+#endif // MIXER_OPS_USE_SIMD
+
+} // namespace mixer_simd
+} // namespace android
+
+#endif /* ANDROID_AUDIO_MIXER_OPS_SIMD_H */
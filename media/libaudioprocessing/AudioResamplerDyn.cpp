@@ -23,6 +23,11 @@
 #include <dlfcn.h>
 #include <math.h>
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include <cutils/compiler.h>
 #include <cutils/properties.h>
 #include <utils/Log.h>
@@ -181,8 +186,7 @@ template<typename TC, typename TI, typename TO>
 AudioResamplerDyn<TC, TI, TO>::AudioResamplerDyn(
         int inChannelCount, int32_t sampleRate, src_quality quality)
     : AudioResampler(inChannelCount, sampleRate, quality),
-      mResampleFunc(0), mFilterSampleRate(0), mFilterQuality(DEFAULT_QUALITY),
-    mCoefBuffer(NULL)
+      mResampleFunc(0), mFilterSampleRate(0), mFilterQuality(DEFAULT_QUALITY)
 {
     mVolumeSimd[0] = mVolumeSimd[1] = 0;
     // The AudioResampler base class assumes we are always ready for 1:1 resampling.
@@ -207,7 +211,6 @@ AudioResamplerDyn<TC, TI, TO>::AudioResamplerDyn(
 template<typename TC, typename TI, typename TO>
 AudioResamplerDyn<TC, TI, TO>::~AudioResamplerDyn()
 {
-    free(mCoefBuffer);
 }
 
 template<typename TC, typename TI, typename TO>
@@ -256,31 +259,61 @@ void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
 }
 
 template<typename TC, typename TI, typename TO>
-void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
-        double stopBandAtten, double fcr) {
-    // compute the normalized transition bandwidth
-    const double tbw = firKaiserTbw(c.mHalfNumCoefs, stopBandAtten);
-    const int phases = c.mL;
-    const int halfLength = c.mHalfNumCoefs;
+std::shared_ptr<const typename AudioResamplerDyn<TC, TI, TO>::FilterBank>
+AudioResamplerDyn<TC, TI, TO>::getFilterBank(
+        int phases, int halfLength, double stopBandAtten, double fcr)
+{
+    // The coefficients do not depend on the channel count or the absolute sample rates,
+    // only on the design parameters, so many tracks (e.g. 44.1 kHz to 48 kHz) share one bank.
+    // Entries expire when the last resampler using them releases the bank.
+    using Key = std::tuple<int /* phases */, int /* halfLength */,
+            double /* stopBandAtten */, double /* fcr */>;
+    static std::mutex lock;
+    static auto& cache = *new std::map<Key, std::weak_ptr<const FilterBank>>; // never freed
+
+    const Key key{phases, halfLength, stopBandAtten, fcr};
+    std::lock_guard _l(lock);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        if (auto bank = it->second.lock()) {
+            return bank;
+        }
+    }
+    // prune expired entries, the cache only holds filters in use.
+    for (auto iter = cache.begin(); iter != cache.end(); ) {
+        iter = iter->second.expired() ? cache.erase(iter) : std::next(iter);
+    }
 
-    // create buffer
-    TC *coefs = nullptr;
+    auto bank = std::make_shared<FilterBank>();
     int ret = posix_memalign(
-            reinterpret_cast<void **>(&coefs),
+            reinterpret_cast<void **>(&bank->mCoefs),
             CACHE_LINE_SIZE /* alignment */,
             (phases + 1) * halfLength * sizeof(TC));
     LOG_ALWAYS_FATAL_IF(ret != 0, "Cannot allocate buffer memory, ret %d", ret);
-    c.mFirCoefs = coefs;
-    free(mCoefBuffer);
-    mCoefBuffer = coefs;
+
+    // compute the normalized transition bandwidth
+    bank->mTransitionBandwidth = firKaiserTbw(halfLength, stopBandAtten);
 
     // square the computed minimum passband value (extra safety).
     double attenuation =
             computeWindowedSincMinimumPassbandValue(stopBandAtten);
     attenuation *= attenuation;
+    bank->mAttenuation = attenuation;
 
     // design filter
-    firKaiserGen(coefs, phases, halfLength, stopBandAtten, fcr, attenuation);
+    firKaiserGen(bank->mCoefs, phases, halfLength, stopBandAtten, fcr, attenuation);
+
+    cache[key] = bank;
+    return bank;
+}
+
+template<typename TC, typename TI, typename TO>
+void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
+        double stopBandAtten, double fcr) {
+    mFilterBank = getFilterBank(c.mL, c.mHalfNumCoefs, stopBandAtten, fcr);
+    c.mFirCoefs = mFilterBank->mCoefs;
+    const double tbw = mFilterBank->mTransitionBandwidth;
+    const double attenuation = mFilterBank->mAttenuation;
 
     // update the design criteria
     mNormalizedCutoffFrequency = fcr;
@@ -298,15 +331,15 @@ void AudioResamplerDyn<TC, TI, TO>::createKaiserFir(Constants &c,
 
     // test the filter and report results.
     // Since this is a polyphase filter, normalized fp and fs must be scaled.
-    const double fp = (fcr - halfbw) / phases;
-    const double fs = (fcr + halfbw) / phases;
+    const double fp = (fcr - halfbw) / c.mL;
+    const double fs = (fcr + halfbw) / c.mL;
 
     double passMin, passMax, passRipple;
     double stopMax, stopRipple;
 
     const int32_t passSteps = 1000;
 
-    testFir(coefs, c.mL, c.mHalfNumCoefs, fp, fs, passSteps, passSteps * c.mL /*stopSteps*/,
+    testFir(c.mFirCoefs, c.mL, c.mHalfNumCoefs, fp, fs, passSteps, passSteps * c.mL /*stopSteps*/,
             passMin, passMax, passRipple, stopMax, stopRipple);
     ALOGD("passband(%lf, %lf): %.8lf %.8lf %.8lf\n", 0., fp, passMin, passMax, passRipple);
     ALOGD("stopband(%lf, %lf): %.8lf %.3lf\n", fs, 0.5, stopMax, stopRipple);
@@ -761,6 +794,47 @@ resample_exit:
     return outputIndex / OUTPUT_CHANNELS;
 }
 
+template<typename TC, typename TI, typename TO>
+void AudioResamplerDyn<TC, TI, TO>::resampleBatch(BatchTrack* tracks, size_t count,
+        size_t outFrameCount)
+{
+    constexpr size_t kPending = SIZE_MAX;
+    for (size_t i = 0; i < count; ++i) {
+        tracks[i].framesResampled = kPending;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (tracks[i].framesResampled != kPending) continue; // already part of a group.
+
+        // Tracks after i with the same design form a group; any such track
+        // is still pending, as it would otherwise have joined an earlier group.
+        const AudioResamplerDyn* const leader = tracks[i].resampler;
+        const auto sameGroup = [leader](const AudioResamplerDyn* r) {
+            return r->mFilterBank == leader->mFilterBank
+                    && r->mPhaseIncrement == leader->mPhaseIncrement;
+        };
+        for (size_t j = i; j < count; ++j) {
+            if (sameGroup(tracks[j].resampler)) {
+                tracks[j].framesResampled = 0;
+            }
+        }
+
+        for (size_t offset = 0; offset < outFrameCount; offset += kBatchFrames) {
+            const size_t frames = std::min(kBatchFrames, outFrameCount - offset);
+            for (size_t j = i; j < count; ++j) {
+                BatchTrack& track = tracks[j];
+                AudioResamplerDyn* const r = track.resampler;
+                // a track that returned a short count has run out of data.
+                if (track.framesResampled != offset || !sameGroup(r)) continue;
+                // TO is 32 bits for all instantiations, so the offset is in int32_t units.
+                const size_t outputChannels = std::max(r->mChannelCount, 2);
+                track.framesResampled += (r->*(r->mResampleFunc))(
+                        reinterpret_cast<TO*>(track.out + offset * outputChannels),
+                        frames, track.provider);
+            }
+        }
+    }
+}
+
 /* instantiate templates used by AudioResampler::create */
 template class AudioResamplerDyn<float, float, float>;
 template class AudioResamplerDyn<int16_t, int16_t, int32_t>;
@@ -17,6 +17,7 @@
 #ifndef ANDROID_AUDIO_RESAMPLER_DYN_H
 #define ANDROID_AUDIO_RESAMPLER_DYN_H
 
+#include <memory>
 #include <stdint.h>
 #include <sys/types.h>
 #include <android/log.h>
@@ -60,6 +61,26 @@ public:
         mInBuffer.reset();
     }
 
+    // A track to be resampled by resampleBatch().
+    struct BatchTrack {
+        AudioResamplerDyn* resampler;
+        int32_t* out;                     // output buffer, as for resample()
+        AudioBufferProvider* provider;
+        size_t framesResampled;           // set by resampleBatch(), as returned by resample()
+    };
+
+    // Resamples up to outFrameCount frames for each of the count tracks.
+    //
+    // Tracks that share a filter bank and phase increment (e.g. many 44.1 kHz tracks to a
+    // 48 kHz sink) are processed together, interleaved in slices of kBatchFrames output
+    // frames, so the polyphase coefficients used by one track are still in cache for the
+    // next. The output is identical to calling resample() for each track.
+    // A track stops early if its provider runs out of data.
+    static void resampleBatch(BatchTrack* tracks, size_t count, size_t outFrameCount);
+
+    // Output frames per track processed before moving to the next track of a batch.
+    static constexpr size_t kBatchFrames = 64;
+
     // Make available key design criteria for testing
     int getHalfLength() const {
         return mConstants.mHalfNumCoefs;
@@ -147,6 +168,21 @@ private:
         size_t mStateCount; // size of state in units of TI.
     };
 
+    // A polyphase filter bank and its design criteria.
+    // Filter banks are shared by all resamplers of the same coefficient type TC
+    // and design, see getFilterBank().
+    struct FilterBank {
+        ~FilterBank() { free(mCoefs); }
+        TC*    mCoefs = nullptr;       // (phases + 1) * halfLength coefficients
+        double mTransitionBandwidth = 0.;
+        double mAttenuation = 0.;
+    };
+
+    // Returns the filter bank for the design from a process-wide cache,
+    // generating it if no resampler currently holds it.
+    static std::shared_ptr<const FilterBank> getFilterBank(
+            int phases, int halfLength, double stopBandAtten, double fcr);
+
     void createKaiserFir(Constants &c, double stopBandAtten,
             int inSampleRate, int outSampleRate, double tbwCheat);
 
@@ -166,7 +202,7 @@ private:
      resample_ABP_t mResampleFunc;     // called function for resampling
             int32_t mFilterSampleRate; // designed filter sample rate.
         src_quality mFilterQuality;    // designed filter quality.
-              void* mCoefBuffer;       // if a filter is created, this is not null
+    std::shared_ptr<const FilterBank> mFilterBank; // if a filter is created, this is not null
 
     // Property selected design parameters.
               // This will enable fixed high quality resampling.
@@ -140,6 +140,48 @@ void CopyBufferProvider::setBufferProvider(AudioBufferProvider *p) {
     PassthruBufferProvider::setBufferProvider(p);
 }
 
+FusedCopyBufferProvider::FusedCopyBufferProvider(
+        const std::vector<CopyBufferProvider *> &stages, size_t bufferFrameCount) :
+        CopyBufferProvider(
+                stages.front()->getInputFrameSize(),
+                stages.back()->getOutputFrameSize(),
+                bufferFrameCount),
+        mStages(stages)
+{
+    ALOGV("FusedCopyBufferProvider(%p)(%zu stages) %zu %zu",
+            this, mStages.size(), mInputFrameSize, mOutputFrameSize);
+    size_t scratchFrameSize = 0;
+    for (size_t i = 0; i + 1 < mStages.size(); ++i) {
+        LOG_ALWAYS_FATAL_IF(mStages[i]->getOutputFrameSize()
+                != mStages[i + 1]->getInputFrameSize(),
+                "stage %zu output frame size %zu != stage %zu input frame size %zu",
+                i, mStages[i]->getOutputFrameSize(),
+                i + 1, mStages[i + 1]->getInputFrameSize());
+        scratchFrameSize = std::max(scratchFrameSize, mStages[i]->getOutputFrameSize());
+    }
+    const size_t scratchFloats =
+            (kBlockFrames * scratchFrameSize + sizeof(float) - 1) / sizeof(float);
+    for (auto &scratch : mScratch) {
+        scratch.resize(scratchFloats);
+    }
+}
+
+void FusedCopyBufferProvider::copyFrames(void *dst, const void *src, size_t frames)
+{
+    const size_t lastStage = mStages.size() - 1;
+    for (size_t offset = 0; offset < frames; offset += kBlockFrames) {
+        const size_t count = std::min(kBlockFrames, frames - offset);
+        const void *in = (const uint8_t *)src + offset * mInputFrameSize;
+        for (size_t i = 0; i < lastStage; ++i) {
+            void *out = mScratch[i & 1].data();
+            mStages[i]->copyFrames(out, in, count);
+            in = out;
+        }
+        mStages[lastStage]->copyFrames(
+                (uint8_t *)dst + offset * mOutputFrameSize, in, count);
+    }
+}
+
 DownmixerBufferProvider::DownmixerBufferProvider(
         audio_channel_mask_t inputChannelMask,
         audio_channel_mask_t outputChannelMask, audio_format_t format,
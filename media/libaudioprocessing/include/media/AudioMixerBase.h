@@ -137,6 +137,32 @@ public:
 
     size_t      getUnreleasedFrames(int name) const;
 
+    // Runs the partitions of a parallel sub-mix, see setSubmixExecutor().
+    // Implemented by the owner of the mixer, which owns and schedules the helper threads.
+    class SubmixExecutor {
+    public:
+        class Job {
+        public:
+            virtual ~Job() = default;
+            virtual void mix(size_t partition) = 0;
+        };
+
+        virtual ~SubmixExecutor() = default;
+
+        // Maximum number of partitions run() can mix concurrently, including the caller.
+        virtual size_t partitions() const = 0;
+
+        // Calls job->mix(i) for each partition i in [0, count), partition 0 on the
+        // calling thread, and returns once all partitions have been mixed.
+        virtual void run(Job *job, size_t count) = 0;
+    };
+
+    // Mix groups of at least trackThreshold enabled tracks as partial sub-mixes
+    // on the executor, which must outlive the mixer or be reset first.
+    // The partial sub-mixes are summed before writing the main buffer.
+    // A nullptr executor or a trackThreshold below 2 disables the parallel sub-mix.
+    void        setSubmixExecutor(SubmixExecutor *executor, size_t trackThreshold);
+
     std::string trackNames() const;
 
   protected:
@@ -350,6 +376,10 @@ public:
     void process__nop();
     void process__genericNoResampling();
     void process__genericResampling();
+    void process__parallelSubmix();
+
+    // Mixes mFrameCount frames of track t into outTemp, which is not cleared.
+    void mixTrack(const std::shared_ptr<TrackBase> &t, int32_t *outTemp, int32_t *resampleTemp);
     void process__oneTrack16BitsStereoNoResampling();
 
     template <int MIXTYPE, typename TO, typename TI, typename TA>
@@ -382,6 +412,25 @@ public:
 
     // track smart pointers, by name, in increasing order of name.
     std::map<int /* name */, std::shared_ptr<TrackBase>> mTracks;
+
+    // parallel sub-mix, see setSubmixExecutor().
+    class SubmixJob : public SubmixExecutor::Job {
+    public:
+        explicit SubmixJob(AudioMixerBase *mixer) : mMixer(mixer) {}
+        void mix(size_t partition) override;
+    private:
+        AudioMixerBase * const mMixer;
+    };
+
+    struct SubmixPartition {
+        std::vector<int /* name */> names;      // tracks of the current group to mix
+        std::unique_ptr<int32_t[]> outTemp;     // partial sub-mix
+        std::unique_ptr<int32_t[]> resampleTemp;
+    };
+
+    SubmixExecutor *mSubmixExecutor = nullptr;
+    size_t mSubmixTrackThreshold = 0;
+    std::vector<SubmixPartition> mSubmixPartitions;
 };
 
 }  // namespace android
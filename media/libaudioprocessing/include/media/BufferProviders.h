@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include <sys/types.h>
+#include <vector>
 
 #include <audio_utils/ChannelMix.h>
 #include <media/AudioBufferProvider.h>
@@ -87,6 +88,9 @@ public:
     // of the internal buffers.
     virtual void copyFrames(void *dst, const void *src, size_t frames) = 0;
 
+    size_t getInputFrameSize() const { return mInputFrameSize; }
+    size_t getOutputFrameSize() const { return mOutputFrameSize; }
+
 protected:
     const size_t         mInputFrameSize;
     const size_t         mOutputFrameSize;
@@ -97,6 +101,27 @@ private:
     size_t               mConsumed;
 };
 
+// FusedCopyBufferProvider derives from CopyBufferProvider to run a chain of
+// CopyBufferProvider stages (e.g. reformat, downmix, post downmix reformat) as a single
+// provider. Only the stages' copyFrames() are used: upstream data is converted a block of
+// kBlockFrames at a time through two small scratch buffers that stay in cache, and only the
+// last stage writes to the local buffer. This avoids a full period copy and a
+// getNextBuffer()/releaseBuffer() round trip per stage.
+// The stages are not owned and must outlive the FusedCopyBufferProvider.
+class FusedCopyBufferProvider : public CopyBufferProvider {
+public:
+    FusedCopyBufferProvider(const std::vector<CopyBufferProvider *> &stages,
+            size_t bufferFrameCount);
+    //Overrides
+    void copyFrames(void *dst, const void *src, size_t frames) override;
+
+protected:
+    static constexpr size_t kBlockFrames = 64;
+
+    const std::vector<CopyBufferProvider *> mStages;
+    std::vector<float>   mScratch[2];   // intermediate data, in float for alignment
+};
+
 // DownmixerBufferProvider derives from CopyBufferProvider to provide
 // position dependent downmixing by an Audio Effect.
 class DownmixerBufferProvider : public CopyBufferProvider {
@@ -23,7 +23,9 @@
 
 using namespace android;
 
-template <int MIXTYPE, int NCHAN>
+// AUX selects the aux send path, which always uses the scalar kernels.
+// Without aux, the <float, float, float> kernels are vectorized (see AudioMixerOpsSimd.h).
+template <int MIXTYPE, int NCHAN, bool AUX = true>
 static void BM_VolumeRampMulti(benchmark::State& state) {
     constexpr size_t FRAME_COUNT = 1000;
     constexpr size_t SAMPLE_COUNT = FRAME_COUNT * NCHAN;
@@ -44,12 +46,13 @@ static void BM_VolumeRampMulti(benchmark::State& state) {
     while (state.KeepRunning()) {
         benchmark::DoNotOptimize(out);
         benchmark::DoNotOptimize(in);
-        volumeRampMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, aux, vol, volinc, &vola, volainc);
+        volumeRampMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, AUX ? aux : nullptr,
+                vol, volinc, &vola, volainc);
         benchmark::ClobberMemory();
     }
 }
 
-template <int MIXTYPE, int NCHAN>
+template <int MIXTYPE, int NCHAN, bool AUX = true>
 static void BM_VolumeMulti(benchmark::State& state) {
     constexpr size_t FRAME_COUNT = 1000;
     constexpr size_t SAMPLE_COUNT = FRAME_COUNT * NCHAN;
@@ -67,7 +70,7 @@ static void BM_VolumeMulti(benchmark::State& state) {
     while (state.KeepRunning()) {
         benchmark::DoNotOptimize(out);
         benchmark::DoNotOptimize(in);
-        volumeMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, aux, vol, vola);
+        volumeMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, AUX ? aux : nullptr, vol, vola);
         benchmark::ClobberMemory();
     }
 }
@@ -101,4 +104,19 @@ BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_SAVEONLY_MONOVOL, 8);
 BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_STEREOVOL, 8);
 BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_SAVEONLY_STEREOVOL, 8);
 
+// The same configurations without aux, which select the SIMD kernels when available.
+BENCHMARK_TEMPLATE(BM_VolumeRampMulti, MIXTYPE_MULTI, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeRampMulti, MIXTYPE_MULTI_SAVEONLY, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeRampMulti, MIXTYPE_MULTI_STEREOVOL, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeRampMulti, MIXTYPE_MULTI_MONOVOL, 8, false);
+BENCHMARK_TEMPLATE(BM_VolumeRampMulti, MIXTYPE_MULTI_STEREOVOL, 8, false);
+
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_SAVEONLY, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_STEREOVOL, 2, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_MONOVOL, 5, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_STEREOVOL, 6, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_STEREOVOL, 8, false);
+BENCHMARK_TEMPLATE(BM_VolumeMulti, MIXTYPE_MULTI_SAVEONLY_STEREOVOL, 8, false);
+
 BENCHMARK_MAIN();
@@ -164,6 +164,76 @@ TEST(mixerops, stereovolume_24) {
         MixerOpsBasicTest<MIXTYPE_MULTI_STEREOVOL, 24>::testStereoVolume();
     }
 }
+// Checks the ramped and constant volume paths without aux, which use the SIMD kernels
+// when available, against a per-sample reference computed from the channel volumes.
+template <int MIXTYPE, int NCHAN>
+static void testVolumeNoAux() {
+    constexpr size_t FRAME_COUNT = 1001; // odd, so the SIMD remainder path is exercised.
+    constexpr size_t SAMPLE_COUNT = FRAME_COUNT * NCHAN;
+    constexpr bool ACCUMULATE = mixTypeAccumulates(MIXTYPE);
+
+    float in[SAMPLE_COUNT];
+    float out[SAMPLE_COUNT];
+    float expected[SAMPLE_COUNT];
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        in[i] = (float)(i % 97) / 97.f - 0.5f;
+        out[i] = expected[i] = (float)(i % 13) / 13.f;
+    }
+
+    const float volinc[2] = {1e-4f, -2e-4f};
+    float vol[2] = {0.25f, 0.75f};
+    float volRef[2] = {0.25f, 0.75f};
+    float vola = 0.f;
+    volumeRampMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, (float *)nullptr,
+            vol, volinc, &vola, 0.f);
+    for (size_t i = 0; i < FRAME_COUNT; ++i) {
+        float chanVol[NCHAN];
+        channelVolumes<MIXTYPE, NCHAN>(chanVol, volRef);
+        for (size_t j = 0; j < NCHAN; ++j) {
+            const float value = in[i * NCHAN + j] * chanVol[j];
+            expected[i * NCHAN + j] = ACCUMULATE ? expected[i * NCHAN + j] + value : value;
+        }
+        if constexpr (MIXTYPE == MIXTYPE_MULTI || MIXTYPE == MIXTYPE_MULTI_SAVEONLY) {
+            for (size_t j = 0; j < NCHAN; ++j) volRef[j] += volinc[j];
+        } else if constexpr (MIXTYPE == MIXTYPE_MULTI_MONOVOL
+                || MIXTYPE == MIXTYPE_MULTI_SAVEONLY_MONOVOL) {
+            volRef[0] += volinc[0];
+        } else {
+            volRef[0] += volinc[0];
+            volRef[1] += volinc[1];
+        }
+    }
+    EXPECT_EQ(volRef[0], vol[0]);
+    EXPECT_EQ(volRef[1], vol[1]);
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        ASSERT_FLOAT_EQ(expected[i], out[i]) << "ramp sample " << i;
+    }
+
+    float chanVol[NCHAN];
+    channelVolumes<MIXTYPE, NCHAN>(chanVol, vol);
+    volumeMulti<MIXTYPE, NCHAN>(out, FRAME_COUNT, in, (float *)nullptr, vol, vola);
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        const float value = in[i] * chanVol[i % NCHAN];
+        expected[i] = ACCUMULATE ? expected[i] + value : value;
+        ASSERT_FLOAT_EQ(expected[i], out[i]) << "constant sample " << i;
+    }
+}
+
+TEST(mixerops, volume_noaux) {
+    testVolumeNoAux<MIXTYPE_MULTI, 1>();
+    testVolumeNoAux<MIXTYPE_MULTI, 2>();
+    testVolumeNoAux<MIXTYPE_MULTI_SAVEONLY, 2>();
+    testVolumeNoAux<MIXTYPE_MULTI_MONOVOL, 3>();
+    testVolumeNoAux<MIXTYPE_MULTI_SAVEONLY_MONOVOL, 8>();
+    testVolumeNoAux<MIXTYPE_MULTI_STEREOVOL, 2>();
+    testVolumeNoAux<MIXTYPE_MULTI_STEREOVOL, 6>();
+    testVolumeNoAux<MIXTYPE_MULTI_STEREOVOL, 8>();
+    testVolumeNoAux<MIXTYPE_MULTI_SAVEONLY_STEREOVOL, 5>();
+    if constexpr (FCC_LIMIT >= 12) {
+        testVolumeNoAux<MIXTYPE_MULTI_STEREOVOL, 12>();
+    }
+}
+
 TEST(mixerops, channel_equivalence) {
     // we must match the constexpr function with the system determined channel mask from count.
     for (size_t i = 0; i < FCC_LIMIT; ++i) {
@@ -28,6 +28,7 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -601,3 +602,118 @@ TEST(audioflinger_resampler, generalresponse) {
         }
     }
 }
+
+TEST(audioflinger_resampler, filtersharing) {
+    using ResamplerType = android::AudioResamplerDyn<float, float, float>;
+    auto createResampler = [](size_t channels, unsigned inputFreq, unsigned outputFreq) {
+        std::unique_ptr<ResamplerType> rdyn(
+                static_cast<ResamplerType *>(
+                        android::AudioResampler::create(
+                                AUDIO_FORMAT_PCM_FLOAT,
+                                channels,
+                                outputFreq,
+                                android::AudioResampler::DYN_HIGH_QUALITY)));
+        rdyn->setSampleRate(inputFreq);
+        return rdyn;
+    };
+
+    // resamplers with the same filter design share the coefficients,
+    // independent of the channel count.
+    auto r1 = createResampler(2 /* channels */, 44100, 48000);
+    auto r2 = createResampler(2 /* channels */, 44100, 48000);
+    auto r3 = createResampler(1 /* channels */, 44100, 48000);
+    ASSERT_NE(nullptr, r1->getFilterCoefs());
+    EXPECT_EQ(r1->getFilterCoefs(), r2->getFilterCoefs());
+    EXPECT_EQ(r1->getFilterCoefs(), r3->getFilterCoefs());
+
+    // a different design does not share.
+    auto r4 = createResampler(2 /* channels */, 22050, 48000);
+    EXPECT_NE(r1->getFilterCoefs(), r4->getFilterCoefs());
+
+    // the shared coefficients remain valid after other users are released.
+    const float *coefs = r1->getFilterCoefs();
+    const int phases = r1->getPhases();
+    const int halfLength = r1->getHalfLength();
+    r1.reset();
+    r3.reset();
+    ASSERT_EQ(coefs, r2->getFilterCoefs());
+    constexpr int32_t passSteps = 1000;
+    const double fcr = r2->getNormalizedCutoffFrequency();
+    const double tbw = r2->getNormalizedTransitionBandwidth();
+    double passMin, passMax, passRipple, stopMax, stopRipple;
+    android::testFir(coefs, phases, halfLength,
+            (fcr - tbw * 0.5) / phases, (fcr + tbw * 0.5) / phases,
+            passSteps, phases * passSteps /* stopSteps */,
+            passMin, passMax, passRipple,
+            stopMax, stopRipple);
+    EXPECT_GT(stopRipple, 60.);
+}
+
+TEST(audioflinger_resampler, resamplebatch) {
+    using ResamplerType = android::AudioResamplerDyn<float, float, float>;
+    constexpr unsigned outputFreq = 48000;
+    constexpr size_t outputFrames = 1000; // not a multiple of kBatchFrames
+    struct Config {
+        size_t channels;
+        unsigned inputFreq;
+        double time;      // input duration, short inputs run out of data
+    };
+    // tracks from different groups are interleaved
+    const std::vector<Config> configs = {
+        {2 /* channels */, 44100, 0.1},
+        {1 /* channels */, 22050, 0.1},
+        {2 /* channels */, 44100, 0.01},
+        {6 /* channels */, 44100, 0.1},
+    };
+
+    auto createTrack = [&](const Config& config, SignalProvider& provider) {
+        provider.setChirp<float>(config.channels,
+                0., config.inputFreq / 2., config.inputFreq, config.time);
+        std::unique_ptr<ResamplerType> rdyn(
+                static_cast<ResamplerType *>(
+                        android::AudioResampler::create(
+                                AUDIO_FORMAT_PCM_FLOAT,
+                                config.channels,
+                                outputFreq,
+                                android::AudioResampler::DYN_HIGH_QUALITY)));
+        rdyn->setSampleRate(config.inputFreq);
+        rdyn->setVolume(android::AudioResampler::UNITY_GAIN_FLOAT,
+                android::AudioResampler::UNITY_GAIN_FLOAT);
+        return rdyn;
+    };
+    auto outputSamples = [](const Config& config) {
+        return std::max(config.channels, (size_t)2) * outputFrames;
+    };
+
+    std::vector<ResamplerType::BatchTrack> tracks;
+    std::vector<std::unique_ptr<ResamplerType>> resamplers;
+    std::vector<std::unique_ptr<SignalProvider>> providers;
+    std::vector<std::vector<float>> outputs;
+    std::vector<std::vector<float>> references;
+    std::vector<size_t> referenceFrames;
+    for (const auto& config : configs) {
+        // reference
+        SignalProvider provider;
+        auto rdyn = createTrack(config, provider);
+        references.emplace_back(outputSamples(config));
+        referenceFrames.push_back(rdyn->resample(
+                reinterpret_cast<int32_t *>(references.back().data()), outputFrames, &provider));
+
+        // batched
+        providers.emplace_back(std::make_unique<SignalProvider>());
+        resamplers.emplace_back(createTrack(config, *providers.back()));
+        outputs.emplace_back(outputSamples(config));
+        tracks.push_back({resamplers.back().get(),
+                reinterpret_cast<int32_t *>(outputs.back().data()),
+                providers.back().get(), 0 /* framesResampled */});
+    }
+
+    ResamplerType::resampleBatch(tracks.data(), tracks.size(), outputFrames);
+
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        EXPECT_EQ(referenceFrames[i], tracks[i].framesResampled);
+        EXPECT_EQ(0, memcmp(references[i].data(), outputs[i].data(),
+                outputs[i].size() * sizeof(float))) << "track " << i;
+    }
+    EXPECT_LT(tracks[2].framesResampled, outputFrames); // short input
+}
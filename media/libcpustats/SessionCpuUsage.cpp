@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "SessionCpuUsage"
+//#define LOG_NDEBUG 0
+
+#include <errno.h>
+#include <sched.h>
+#include <time.h>
+
+#include <utils/Log.h>
+
+#include <cpustats/SessionCpuUsage.h>
+
+namespace android {
+
+void SessionCpuUsage::begin()
+{
+    if (mInStretch) {
+        ALOGW("begin() called twice without end()");
+    }
+    int rc = clock_gettime(CLOCK_THREAD_CPUTIME_ID, &mStartTs);
+    if (rc) {
+        ALOGE("clock_gettime(CLOCK_THREAD_CPUTIME_ID) errno=%d", errno);
+        mInStretch = false;
+        return;
+    }
+    mInStretch = true;
+}
+
+void SessionCpuUsage::end()
+{
+    if (!mInStretch) {
+        return;
+    }
+    mInStretch = false;
+    struct timespec ts;
+    int rc = clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    if (rc) {
+        ALOGE("clock_gettime(CLOCK_THREAD_CPUTIME_ID) errno=%d", errno);
+        return;
+    }
+    long long delta = (ts.tv_sec - mStartTs.tv_sec) * 1000000000LL +
+            (ts.tv_nsec - mStartTs.tv_nsec);
+    mTotalNs += delta;
+    mStretchNs.sample((double) delta);
+
+    if (!mCpukHzKnown) {
+        return;
+    }
+    // the thread may have migrated during the stretch, so this is an estimate
+    int cpuNum = sched_getcpu();
+    uint32_t kHz = cpuNum >= 0 ? mCpuUsage.getCpukHz(cpuNum) : 0;
+    if (kHz == 0) {
+        // don't keep trying (and logging) at every stretch
+        mCpukHzKnown = false;
+        mTotalCycles = 0.0;
+        return;
+    }
+    mTotalCycles += delta * kHz * 0.000001;
+    ALOGV("end %lld ns on CPU %d at %u kHz", delta, cpuNum, kHz);
+}
+
+void SessionCpuUsage::reset()
+{
+    mInStretch = false;
+    mTotalNs = 0;
+    mTotalCycles = 0.0;
+    mStretchNs.reset();
+}
+
+}   // namespace android
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SESSION_CPU_USAGE_H
+#define _SESSION_CPU_USAGE_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <cpustats/CentralTendencyStatistics.h>
+#include <cpustats/ThreadCpuUsage.h>
+
+namespace android {
+
+// Track the CPU usage of one session, such as a track, a codec instance or a
+// camera stream, whose work is done in stretches on one or more threads.
+// Call begin() and end() around each stretch of work, on the thread doing it.
+// Stretches must not overlap; a session served by a single looper or worker
+// thread satisfies this naturally, and the thread may change between stretches.
+// Besides the thread CPU time, the CPU cycles are estimated from the frequency
+// of the CPU the thread ran on at the end of the stretch, so that cost can be
+// compared across CPU frequencies and big/little cores.
+// This class is not thread-safe; the accessors must not be called
+// concurrently with begin() or end().
+
+class SessionCpuUsage
+{
+
+public:
+    SessionCpuUsage() :
+        mInStretch(false),
+        // mStartTs
+        mTotalNs(0),
+        mTotalCycles(0.0),
+        mCpukHzKnown(true)
+        { }
+
+    ~SessionCpuUsage() { }
+
+    // Start a stretch of work for this session on the current thread.
+    void begin();
+
+    // End the stretch of work started by the most recent begin(), which must
+    // have been called on the current thread.
+    void end();
+
+    // Return the thread CPU ns used by all stretches so far.
+    long long totalNs() const   { return mTotalNs; }
+
+    // Return the estimated CPU cycles used by all stretches so far, or 0 if the
+    // CPU frequency can't be read on this device.
+    double totalCycles() const  { return mTotalCycles; }
+
+    // Return statistics on the thread CPU ns used per stretch.
+    const CentralTendencyStatistics& stretchNs() const { return mStretchNs; }
+
+    // Reset all of the above.
+    void reset();
+
+private:
+    bool mInStretch;                // whether begin() was called without a matching end()
+    struct timespec mStartTs;       // thread CPU time at begin(), valid only if mInStretch
+    long long mTotalNs;             // thread CPU ns of all stretches
+    double mTotalCycles;            // estimated CPU cycles of all stretches
+    CentralTendencyStatistics mStretchNs;
+    bool mCpukHzKnown;              // false once reading the CPU frequency failed
+    ThreadCpuUsage mCpuUsage;       // for reading the current CPU clock frequency in kHz
+};
+
+}   // namespace android
+
+#endif //  _SESSION_CPU_USAGE_H
@@ -24,16 +24,27 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include <algorithm>
+
 namespace android {
 
 FileSource::FileSource(const char *filename)
     : mFd(-1),
       mOffset(0),
       mLength(-1),
-      mName("<null>") {
+      mName("<null>"),
+      mMapBase(MAP_FAILED),
+      mMapSize(0),
+      mMapData(NULL),
+      mLastReadEnd(-1),
+      mNumSequentialReads(0),
+      mNumRandomReads(0),
+      mAdvisedSequential(false),
+      mWillNeedEnd(0) {
 
     if (filename) {
         mName = String8::format("FileSource(%s)", filename);
@@ -43,6 +54,7 @@ FileSource::FileSource(const char *filename)
 
     if (mFd >= 0) {
         mLength = lseek64(mFd, 0, SEEK_END);
+        mapFile();
     } else {
         ALOGE("Failed to open file '%s'. (%s)", filename, strerror(errno));
     }
@@ -52,7 +64,15 @@ FileSource::FileSource(int fd, int64_t offset, int64_t length)
     : mFd(fd),
       mOffset(offset),
       mLength(length),
-      mName("<null>") {
+      mName("<null>"),
+      mMapBase(MAP_FAILED),
+      mMapSize(0),
+      mMapData(NULL),
+      mLastReadEnd(-1),
+      mNumSequentialReads(0),
+      mNumRandomReads(0),
+      mAdvisedSequential(false),
+      mWillNeedEnd(0) {
     ALOGV("fd=%d (%s), offset=%lld, length=%lld",
             fd, nameForFd(fd).c_str(), (long long) offset, (long long) length);
 
@@ -87,9 +107,14 @@ FileSource::FileSource(int fd, int64_t offset, int64_t length)
             (long long) mOffset,
             (long long) mLength);
 
+    mapFile();
 }
 
 FileSource::~FileSource() {
+    if (mMapBase != MAP_FAILED) {
+        munmap(mMapBase, mMapSize);
+        mMapBase = MAP_FAILED;
+    }
     if (mFd >= 0) {
         ::close(mFd);
         mFd = -1;
@@ -121,7 +146,89 @@ ssize_t FileSource::readAt(off64_t offset, void *data, size_t size) {
     return readAt_l(offset, data, size);
 }
 
+// Reads within this distance of the end of the previous read count as sequential.
+static const off64_t kMaxSequentialGap = 64 * 1024;
+// Number of sequential reads after which the mapping is advised as read sequentially,
+// and of other reads in a row after which it no longer is.
+static const size_t kMinSequentialReads = 8;
+static const size_t kMinRandomReads = 8;
+// How far ahead of sequential reads to ask the kernel to read.
+static const off64_t kWillNeedSize = 1024 * 1024;
+// Mappings are limited on 32-bit processes to leave room in the address space.
+static const int64_t kMaxMapLength = sizeof(void *) > 4 ? INT64_MAX : 64 * 1024 * 1024;
+
+void FileSource::mapFile() {
+    struct stat s;
+    if (mFd < 0 || mLength <= 0 || mLength > kMaxMapLength
+            || fstat(mFd, &s) != 0 || !S_ISREG(s.st_mode)
+            || mOffset + mLength > s.st_size) {
+        return;
+    }
+
+    off64_t pageSize = sysconf(_SC_PAGESIZE);
+    off64_t mapOffset = mOffset - mOffset % pageSize;
+    size_t mapSize = mLength + (mOffset - mapOffset);
+    void *base = mmap64(NULL, mapSize, PROT_READ, MAP_SHARED, mFd, mapOffset);
+    if (base == MAP_FAILED) {
+        ALOGV("mmap failed (%s), reading with read()", strerror(errno));
+        return;
+    }
+    mMapBase = base;
+    mMapSize = mapSize;
+    mMapData = (const uint8_t *)base + (mOffset - mapOffset);
+}
+
+ssize_t FileSource::readFromMap_l(off64_t offset, void *data, size_t size) {
+    if (offset < 0 || offset >= mLength) {
+        return 0;
+    }
+    if ((uint64_t)size > (uint64_t)(mLength - offset)) {
+        size = mLength - offset;
+    }
+
+    if (mLastReadEnd >= 0 && offset >= mLastReadEnd
+            && offset - mLastReadEnd <= kMaxSequentialGap) {
+        ++mNumSequentialReads;
+        mNumRandomReads = 0;
+    } else if (++mNumRandomReads >= kMinRandomReads) {
+        // Tolerate a few jumps, e.g. between the tracks of an interleaved file.
+        mNumSequentialReads = 0;
+    }
+    mLastReadEnd = offset + size;
+
+    if (mNumSequentialReads >= kMinSequentialReads) {
+        if (!mAdvisedSequential) {
+            madvise(mMapBase, mMapSize, MADV_SEQUENTIAL);
+            mAdvisedSequential = true;
+        }
+        // Keep the kernel reading ahead of us, half a window at a time.
+        if (mLastReadEnd + kWillNeedSize / 2 > mWillNeedEnd) {
+            off64_t start = std::max(mWillNeedEnd, mLastReadEnd);
+            off64_t end = std::min(mLastReadEnd + kWillNeedSize, (off64_t)mLength);
+            if (start < end) {
+                const uint8_t *first = mMapData + start;
+                first -= (first - (const uint8_t *)mMapBase) % sysconf(_SC_PAGESIZE);
+                madvise((void *)first, mMapData + end - first, MADV_WILLNEED);
+            }
+            mWillNeedEnd = end;
+        }
+    } else if (mAdvisedSequential) {
+        // Random access, e.g. a seek or an extractor parsing an index; stop the
+        // aggressive readahead.
+        madvise(mMapBase, mMapSize, MADV_NORMAL);
+        mAdvisedSequential = false;
+        mWillNeedEnd = 0;
+    }
+
+    memcpy(data, mMapData + offset, size);
+    return size;
+}
+
 ssize_t FileSource::readAt_l(off64_t offset, void *data, size_t size) {
+    if (mMapData != NULL) {
+        return readFromMap_l(offset, data, size);
+    }
+
     off64_t result = lseek64(mFd, offset + mOffset, SEEK_SET);
     if (result == -1) {
         ALOGE("seek to %lld failed", (long long)(offset + mOffset));
@@ -44,6 +44,10 @@ struct PageCache {
 
     void appendPage(Page *page);
     size_t releaseFromStart(size_t maxBytes);
+    size_t releaseFromEnd(size_t maxBytes);
+
+    // Frees the pages kept for reuse.
+    void freeUnusedPages();
 
     size_t totalSize() const {
         return mTotalSize;
@@ -136,6 +140,35 @@ size_t PageCache::releaseFromStart(size_t maxBytes) {
     return bytesReleased;
 }
 
+size_t PageCache::releaseFromEnd(size_t maxBytes) {
+    size_t bytesReleased = 0;
+
+    while (maxBytes > 0 && !mActivePages.empty()) {
+        List<Page *>::iterator it = --mActivePages.end();
+
+        Page *page = *it;
+
+        if (maxBytes < page->mSize) {
+            break;
+        }
+
+        mActivePages.erase(it);
+
+        maxBytes -= page->mSize;
+        bytesReleased += page->mSize;
+
+        releasePage(page);
+    }
+
+    mTotalSize -= bytesReleased;
+    return bytesReleased;
+}
+
+void PageCache::freeUnusedPages() {
+    freePages(&mFreePages);
+    mFreePages.clear();
+}
+
 void PageCache::copy(size_t from, void *data, size_t size) {
     ALOGV("copy from %zu size %zu", from, size);
 
@@ -188,6 +221,7 @@ NuCachedSource2::NuCachedSource2(
       mLooper(new ALooper),
       mCache(new PageCache(kPageSize)),
       mCacheOffset(0),
+      mRetainedBytes(0),
       mFinalStatus(OK),
       mLastAccessPos(0),
       mFetching(true),
@@ -234,6 +268,12 @@ NuCachedSource2::~NuCachedSource2() {
 
     delete mCache;
     mCache = NULL;
+
+    for (List<RetainedRange>::iterator it = mRetainedRanges.begin();
+            it != mRetainedRanges.end(); ++it) {
+        delete it->mCache;
+    }
+    mRetainedRanges.clear();
 }
 
 // static
@@ -537,6 +577,10 @@ ssize_t NuCachedSource2::readAt(off64_t offset, void *data, size_t size) {
         return size;
     }
 
+    if (readFromRetainedRange_l(offset, data, size)) {
+        return size;
+    }
+
     sp<AMessage> msg = new AMessage(kWhatRead, mReflector);
     msg->setInt64("offset", offset);
     msg->setPointer("data", data);
@@ -599,6 +643,9 @@ size_t NuCachedSource2::approxDataRemaining_l(off64_t offset, status_t *finalSta
     return 0;
 }
 
+// How far before a read outside the cache to start fetching.
+static const off64_t kSeekPadding = 256 * 1024;
+
 ssize_t NuCachedSource2::readInternal(off64_t offset, void *data, size_t size) {
     CHECK_LE(size, (size_t)mHighwaterThresholdBytes);
 
@@ -613,7 +660,14 @@ ssize_t NuCachedSource2::readInternal(off64_t offset, void *data, size_t size) {
         return ERROR_END_OF_STREAM;
     }
 
-    if (!mFetching) {
+    if (readFromRetainedRange_l(offset, data, size)) {
+        return size;
+    }
+
+    // Restarting the prefetcher releases the cache up to the read, which would
+    // discard all of it for a read outside; the seek below keeps it instead.
+    if (!mFetching && offset >= mCacheOffset
+            && offset <= (off64_t)(mCacheOffset + mCache->totalSize())) {
         mLastAccessPos = offset;
         restartPrefetcherIfNecessary_l(
                 false, // ignoreLowWaterThreshold
@@ -622,13 +676,20 @@ ssize_t NuCachedSource2::readInternal(off64_t offset, void *data, size_t size) {
 
     if (offset < mCacheOffset
             || offset >= (off64_t)(mCacheOffset + mCache->totalSize())) {
-        static const off64_t kPadding = 256 * 1024;
-
         // In the presence of multiple decoded streams, once of them will
         // trigger this seek request, the other one will request data "nearby"
         // soon, adjust the seek position so that that subsequent request
         // does not trigger another seek.
-        off64_t seekOffset = (offset > kPadding) ? offset - kPadding : 0;
+        off64_t seekOffset = (offset > kSeekPadding) ? offset - kSeekPadding : 0;
+
+        // Don't back up out of a retained range holding the data.
+        for (List<RetainedRange>::iterator it = mRetainedRanges.begin();
+                it != mRetainedRanges.end(); ++it) {
+            if (offset >= it->mOffset && seekOffset < it->mOffset
+                    && offset <= (off64_t)(it->mOffset + it->mCache->totalSize())) {
+                seekOffset = it->mOffset;
+            }
+        }
 
         seekInternal_l(seekOffset);
     }
@@ -663,6 +724,7 @@ ssize_t NuCachedSource2::readInternal(off64_t offset, void *data, size_t size) {
 }
 
 status_t NuCachedSource2::seekInternal_l(off64_t offset) {
+    off64_t lastAccessPos = mLastAccessPos;
     mLastAccessPos = offset;
 
     if (offset >= mCacheOffset
@@ -672,10 +734,25 @@ status_t NuCachedSource2::seekInternal_l(off64_t offset) {
 
     ALOGI("new range: offset= %lld", (long long)offset);
 
-    mCacheOffset = offset;
+    // Continue from a range kept by an earlier seek if there is one, and keep
+    // the current range in its place.
+    off64_t cacheOffset = offset;
+    PageCache *cache = takeRetainedRange_l(offset, &cacheOffset);
+
+    if (retainRange_l(mCacheOffset, mCache, lastAccessPos)) {
+        if (cache == NULL) {
+            cache = new PageCache(kPageSize);
+        }
+    } else if (cache == NULL) {
+        size_t totalSize = mCache->totalSize();
+        CHECK_EQ(mCache->releaseFromStart(totalSize), totalSize);
+        cache = mCache;
+    } else {
+        delete mCache;
+    }
 
-    size_t totalSize = mCache->totalSize();
-    CHECK_EQ(mCache->releaseFromStart(totalSize), totalSize);
+    mCache = cache;
+    mCacheOffset = cacheOffset;
 
     mNumRetriesLeft = kMaxNumRetries;
     mFetching = true;
@@ -683,6 +760,79 @@ status_t NuCachedSource2::seekInternal_l(off64_t offset) {
     return OK;
 }
 
+bool NuCachedSource2::readFromRetainedRange_l(off64_t offset, void *data, size_t size) {
+    for (List<RetainedRange>::iterator it = mRetainedRanges.begin();
+            it != mRetainedRanges.end(); ++it) {
+        if (offset >= it->mOffset
+                && offset + size <= it->mOffset + it->mCache->totalSize()) {
+            it->mCache->copy(offset - it->mOffset, data, size);
+
+            RetainedRange range = *it;
+            mRetainedRanges.erase(it);
+            mRetainedRanges.push_front(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Takes ownership of |cache| holding the data from |offset| on, and keeps part of
+// it around |lastAccessPos| if it fits within kMaxRetainedBytes. Returns false if
+// nothing was kept, in which case |cache| still belongs to the caller.
+bool NuCachedSource2::retainRange_l(
+        off64_t offset, PageCache *cache, off64_t lastAccessPos) {
+    // Like restartPrefetcherIfNecessary_l(), keep a bit of what was read last.
+    static const off64_t kGrayArea = 1024 * 1024;
+    if (lastAccessPos - kGrayArea > offset) {
+        offset += cache->releaseFromStart(lastAccessPos - kGrayArea - offset);
+    }
+    if (cache->totalSize() > (size_t)kMaxRetainedBytes) {
+        cache->releaseFromEnd(cache->totalSize() - kMaxRetainedBytes);
+    }
+    if (cache->totalSize() == 0 || cache->totalSize() > (size_t)kMaxRetainedBytes) {
+        return false;
+    }
+    cache->freeUnusedPages();
+
+    RetainedRange range;
+    range.mOffset = offset;
+    range.mCache = cache;
+    mRetainedRanges.push_front(range);
+    mRetainedBytes += cache->totalSize();
+
+    while (mRetainedRanges.size() > (size_t)kMaxNumRetainedRanges
+            || mRetainedBytes > (size_t)kMaxRetainedBytes) {
+        List<RetainedRange>::iterator it = --mRetainedRanges.end();
+        ALOGV("dropping range at %lld, size %zu",
+                (long long)it->mOffset, it->mCache->totalSize());
+        mRetainedBytes -= it->mCache->totalSize();
+        delete it->mCache;
+        mRetainedRanges.erase(it);
+    }
+
+    ALOGV("retained range at %lld, size %zu", (long long)offset, cache->totalSize());
+    return true;
+}
+
+// Removes and returns the retained range holding |offset|, or its end, if any.
+PageCache *NuCachedSource2::takeRetainedRange_l(off64_t offset, off64_t *cacheOffset) {
+    for (List<RetainedRange>::iterator it = mRetainedRanges.begin();
+            it != mRetainedRanges.end(); ++it) {
+        if (offset >= it->mOffset
+                && offset <= (off64_t)(it->mOffset + it->mCache->totalSize())) {
+            PageCache *cache = it->mCache;
+            *cacheOffset = it->mOffset;
+            mRetainedBytes -= cache->totalSize();
+            mRetainedRanges.erase(it);
+
+            ALOGV("continuing range at %lld, size %zu",
+                    (long long)*cacheOffset, cache->totalSize());
+            return cache;
+        }
+    }
+    return NULL;
+}
+
 void NuCachedSource2::resumeFetchingIfNecessary() {
     Mutex::Autolock autoLock(mLock);
 
@@ -58,6 +58,21 @@ protected:
 private:
     String8 mName;
 
+    // Local files are read through a mapping of [mOffset, mOffset + mLength) when possible,
+    // which saves the system calls of the many small reads done while parsing.
+    void *mMapBase;
+    size_t mMapSize;
+    const uint8_t *mMapData;
+    // Access pattern of the reads from the mapping, used to advise the kernel.
+    off64_t mLastReadEnd;
+    size_t mNumSequentialReads;
+    size_t mNumRandomReads;
+    bool mAdvisedSequential;
+    off64_t mWillNeedEnd;
+
+    void mapFile();
+    ssize_t readFromMap_l(off64_t offset, void *data, size_t size);
+
     FileSource(const FileSource &);
     FileSource &operator=(const FileSource &);
 };
@@ -21,6 +21,7 @@
 #include <media/DataSource.h>
 #include <media/stagefright/foundation/ABase.h>
 #include <media/stagefright/foundation/AHandlerReflector.h>
+#include <utils/List.h>
 
 namespace android {
 
@@ -88,6 +89,11 @@ private:
         kDefaultHighWaterThreshold      = 20 * 1024 * 1024,
         kDefaultLowWaterThreshold       = 4 * 1024 * 1024,
 
+        // Ranges of the cache left by seeks are kept, up to this many
+        // bytes in total, for when the reads come back to them.
+        kMaxRetainedBytes               = 8 * 1024 * 1024,
+        kMaxNumRetainedRanges           = 4,
+
         // Read data after a 15 sec timeout whether we're actively
         // fetching or not.
         kDefaultKeepAliveIntervalUs     = 15000000,
@@ -113,6 +119,14 @@ private:
 
     PageCache *mCache;
     off64_t mCacheOffset;
+
+    struct RetainedRange {
+        off64_t mOffset;
+        PageCache *mCache;
+    };
+    // Most recently used first.
+    List<RetainedRange> mRetainedRanges;
+    size_t mRetainedBytes;
     status_t mFinalStatus;
     off64_t mLastAccessPos;
     sp<AMessage> mAsyncResult;
@@ -140,6 +154,10 @@ private:
 
     size_t approxDataRemaining_l(off64_t offset, status_t *finalStatus) const;
 
+    bool readFromRetainedRange_l(off64_t offset, void *data, size_t size);
+    bool retainRange_l(off64_t offset, PageCache *cache, off64_t lastAccessPos);
+    PageCache *takeRetainedRange_l(off64_t offset, off64_t *cacheOffset);
+
     void restartPrefetcherIfNecessary_l(
             bool ignoreLowWaterThreshold = false, bool force = false);
 
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "PartitionedConvolver"
+//#define LOG_NDEBUG 0
+
+#include <algorithm>
+#include <string.h>
+
+#include <log/log.h>
+
+#include "PartitionedConvolver.h"
+
+namespace android {
+
+PartitionedConvolver::PartitionedConvolver(size_t blockSize, size_t tailThreads)
+    : mBlockSize(blockSize),
+      mSpectrumSize(blockSize + 1),
+      mTailThreads(tailThreads),
+      mTimeInput(Eigen::VectorXf::Zero(2 * blockSize)),
+      mTimeOutput(2 * blockSize),
+      mAccumulator(blockSize + 1),
+      mOutputBlock(blockSize) {
+    LOG_ALWAYS_FATAL_IF(blockSize == 0 || (blockSize & (blockSize - 1)) != 0,
+                        "%s: blockSize %zu is not a power of 2", __func__, blockSize);
+    mFft.SetFlag(Eigen::FFT<float>::HalfSpectrum);
+    if (mTailThreads > 0) {
+        mWorkers.reset(new TailWorker[mTailThreads]);
+        for (size_t i = 0; i < mTailThreads; ++i) {
+            TailWorker* worker = &mWorkers[i];
+            worker->firstPartition = worker->endPartition = 0;
+            worker->accumulator = Eigen::VectorXcf::Zero(mSpectrumSize);
+            worker->thread = std::thread(&PartitionedConvolver::tailThreadLoop, this, worker);
+        }
+    }
+}
+
+PartitionedConvolver::~PartitionedConvolver() {
+    stopWorkers();
+}
+
+bool PartitionedConvolver::setImpulseResponse(const float* impulseResponse, size_t length) {
+    if (length == 0) {
+        ALOGE("%s: empty impulse response", __func__);
+        return false;
+    }
+    // The workers read mFilter, so they must be idle.
+    waitForTail();
+
+    const size_t partitions = (length + mBlockSize - 1) / mBlockSize;
+    mFilter.resize(partitions);
+    Eigen::VectorXf segment(2 * mBlockSize);
+    for (size_t p = 0; p < partitions; ++p) {
+        // Each partition is zero padded to the FFT size, as required by overlap-save.
+        const size_t offset = p * mBlockSize;
+        const size_t count = std::min(mBlockSize, length - offset);
+        segment.setZero();
+        memcpy(segment.data(), impulseResponse + offset, count * sizeof(float));
+        mFft.fwd(mFilter[p], segment);
+    }
+    mFdl.assign(partitions, Eigen::VectorXcf::Zero(mSpectrumSize));
+
+    // Split the tail partitions evenly among the workers.
+    const size_t headEnd = std::min(kHeadPartitions, partitions);
+    const size_t tailPartitions = partitions - headEnd;
+    for (size_t i = 0; i < mTailThreads; ++i) {
+        mWorkers[i].firstPartition = headEnd + tailPartitions * i / mTailThreads;
+        mWorkers[i].endPartition = headEnd + tailPartitions * (i + 1) / mTailThreads;
+    }
+    ALOGV("%s: length %zu partitions %zu tailThreads %zu",
+            __func__, length, partitions, mTailThreads);
+    reset();
+    return true;
+}
+
+void PartitionedConvolver::reset() {
+    waitForTail();
+    mTailValid = false;
+    for (auto& spectrum : mFdl) {
+        spectrum.setZero();
+    }
+    mFdlIndex = 0;
+    mTimeInput.setZero();
+    std::fill(mOutputBlock.begin(), mOutputBlock.end(), 0.f);
+    mPosition = 0;
+}
+
+void PartitionedConvolver::process(const float* in, float* out, size_t frameCount) {
+    if (mFilter.empty()) {
+        memset(out, 0, frameCount * sizeof(float));
+        return;
+    }
+    while (frameCount > 0) {
+        // The current block is received in the upper half of mTimeInput, while the output of
+        // the previous block is delivered. As both advance together, in may alias out.
+        const size_t count = std::min(frameCount, mBlockSize - mPosition);
+        memcpy(mTimeInput.data() + mBlockSize + mPosition, in, count * sizeof(float));
+        memcpy(out, mOutputBlock.data() + mPosition, count * sizeof(float));
+        in += count;
+        out += count;
+        frameCount -= count;
+        mPosition += count;
+        if (mPosition == mBlockSize) {
+            processBlock();
+            mPosition = 0;
+        }
+    }
+}
+
+void PartitionedConvolver::processBlock() {
+    const size_t partitions = mFilter.size();
+    mFdlIndex = (mFdlIndex + 1) % partitions;
+    mFft.fwd(mFdl[mFdlIndex], mTimeInput);
+
+    mAccumulator.setZero();
+    if (mTailThreads == 0) {
+        accumulate(mAccumulator, 0, partitions, mFdlIndex);
+    } else {
+        accumulate(mAccumulator, 0, std::min(kHeadPartitions, partitions), mFdlIndex);
+        // The tail of this block was started at the end of the previous one.
+        waitForTail();
+        if (mTailValid) {
+            for (size_t i = 0; i < mTailThreads; ++i) {
+                mAccumulator += mWorkers[i].accumulator;
+            }
+        }
+    }
+
+    // Overlap-save: only the second half of the circular convolution is valid.
+    mFft.inv(mTimeOutput, mAccumulator);
+    memcpy(mOutputBlock.data(), mTimeOutput.data() + mBlockSize, mBlockSize * sizeof(float));
+    memcpy(mTimeInput.data(), mTimeInput.data() + mBlockSize, mBlockSize * sizeof(float));
+
+    if (mTailThreads > 0 && partitions > kHeadPartitions) {
+        startTail();
+    }
+}
+
+void PartitionedConvolver::accumulate(Eigen::VectorXcf& accumulator, size_t first, size_t end,
+                                      size_t newestIndex) const {
+    const size_t partitions = mFilter.size();
+    for (size_t p = first; p < end; ++p) {
+        const size_t index = (newestIndex + partitions - p) % partitions;
+        accumulator.array() += mFdl[index].array() * mFilter[p].array();
+    }
+}
+
+void PartitionedConvolver::startTail() {
+    std::lock_guard l(mLock);
+    // The next block's spectrum will be stored at mFdlIndex + 1; the tail partitions
+    // never read it, so the workers may overlap with the next fwd().
+    mTailIndex = (mFdlIndex + 1) % mFilter.size();
+    mTailPending = mTailThreads;
+    ++mTailGeneration;
+    mTailValid = true;
+    mCondition.notify_all();
+}
+
+void PartitionedConvolver::waitForTail() {
+    if (mTailThreads == 0) return;
+    std::unique_lock l(mLock);
+    mCondition.wait(l, [this] { return mTailPending == 0; });
+}
+
+void PartitionedConvolver::stopWorkers() {
+    if (mTailThreads == 0) return;
+    {
+        std::lock_guard l(mLock);
+        mExit = true;
+        mCondition.notify_all();
+    }
+    for (size_t i = 0; i < mTailThreads; ++i) {
+        mWorkers[i].thread.join();
+    }
+}
+
+void PartitionedConvolver::tailThreadLoop(TailWorker* worker) {
+    uint64_t generation = 0;
+    while (true) {
+        size_t tailIndex;
+        {
+            std::unique_lock l(mLock);
+            mCondition.wait(l, [&] { return mExit || mTailGeneration != generation; });
+            if (mExit) return;
+            generation = mTailGeneration;
+            tailIndex = mTailIndex;
+        }
+        worker->accumulator.setZero();
+        accumulate(worker->accumulator, worker->firstPartition, worker->endPartition, tailIndex);
+        {
+            std::lock_guard l(mLock);
+            if (--mTailPending == 0) {
+                mCondition.notify_all();
+            }
+        }
+    }
+}
+
+}  // namespace android
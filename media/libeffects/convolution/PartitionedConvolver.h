@@ -0,0 +1,124 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_PARTITIONED_CONVOLVER_H
+#define ANDROID_PARTITIONED_CONVOLVER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/FFT>
+
+namespace android {
+
+/**
+ * PartitionedConvolver convolves a mono signal with a long impulse response, such as a room
+ * response for reverb or a head related transfer function for virtualization.
+ *
+ * It uses uniformly partitioned overlap-save convolution: the impulse response is split into
+ * partitions of blockSize frames, each transformed once with an FFT of 2 * blockSize, and
+ * every input block is multiplied against all of them in the frequency domain.
+ * The cost per frame grows with log(blockSize) and with the number of partitions, rather than
+ * with the impulse response length as for a direct FIR.
+ *
+ * The output is delayed by getLatencyFrames() == blockSize frames, independent of the
+ * frame count given to process().
+ *
+ * The partitions past the first kHeadPartitions only depend on previous input blocks.
+ * If tailThreads is not 0, they are computed by worker threads while the caller is busy
+ * elsewhere, between two blocks. The result is the same with or without worker threads.
+ *
+ * This class is not thread-safe, but thread-compatible.
+ */
+class PartitionedConvolver {
+public:
+    // Partitions computed inline by process(), before the worker threads.
+    static constexpr size_t kHeadPartitions = 4;
+
+    // blockSize must be a power of 2.
+    explicit PartitionedConvolver(size_t blockSize, size_t tailThreads = 0);
+    ~PartitionedConvolver();
+
+    PartitionedConvolver(const PartitionedConvolver&) = delete;
+    PartitionedConvolver& operator=(const PartitionedConvolver&) = delete;
+
+    // Sets the impulse response, and clears the convolution state.
+    // Returns false if the length is 0.
+    bool setImpulseResponse(const float* impulseResponse, size_t length);
+
+    // Clears the convolution state, keeping the impulse response.
+    void reset();
+
+    // Convolves frameCount mono frames. in and out may be the same buffer.
+    void process(const float* in, float* out, size_t frameCount);
+
+    size_t getBlockSize() const { return mBlockSize; }
+    size_t getLatencyFrames() const { return mBlockSize; }
+    size_t getPartitionCount() const { return mFilter.size(); }
+
+private:
+    // A tail worker, accumulating a contiguous range of partitions.
+    struct TailWorker {
+        size_t firstPartition;
+        size_t endPartition;
+        Eigen::VectorXcf accumulator;
+        std::thread thread;
+    };
+
+    void processBlock();
+
+    // Adds the products of the partitions [first, end) to accumulator, for the output block
+    // whose input spectrum is at newestIndex in mFdl.
+    void accumulate(Eigen::VectorXcf& accumulator, size_t first, size_t end,
+                    size_t newestIndex) const;
+
+    void startTail();
+    void waitForTail();
+    void stopWorkers();
+    void tailThreadLoop(TailWorker* worker);
+
+    const size_t mBlockSize;
+    const size_t mSpectrumSize;   // mBlockSize + 1 bins, including Nyquist
+    const size_t mTailThreads;
+
+    Eigen::FFT<float> mFft;
+    std::vector<Eigen::VectorXcf> mFilter;   // spectra of the impulse response partitions
+    std::vector<Eigen::VectorXcf> mFdl;      // frequency domain delay line of input spectra
+    size_t mFdlIndex = 0;                    // position of the newest input spectrum in mFdl
+
+    Eigen::VectorXf mTimeInput;      // previous and current input blocks
+    Eigen::VectorXf mTimeOutput;
+    Eigen::VectorXcf mAccumulator;
+    std::vector<float> mOutputBlock; // output of the previous block, being delivered
+    size_t mPosition = 0;            // frames of the current block received
+
+    std::unique_ptr<TailWorker[]> mWorkers;
+    std::mutex mLock;
+    std::condition_variable mCondition;
+    uint64_t mTailGeneration = 0;    // incremented to start the workers on the next tail
+    size_t mTailIndex = 0;           // newestIndex for the tail being computed
+    size_t mTailPending = 0;         // workers still running for the current generation
+    bool mTailValid = false;         // false until a tail was started after a reset
+    bool mExit = false;
+};
+
+}  // namespace android
+
+#endif  // ANDROID_PARTITIONED_CONVOLVER_H
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "PartitionedConvolver.h"
+
+using namespace android;
+
+namespace {
+
+std::vector<float> randomSignal(size_t length, unsigned seed) {
+    std::minstd_rand gen(seed);
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+    std::vector<float> signal(length);
+    for (auto& sample : signal) {
+        sample = dis(gen);
+    }
+    return signal;
+}
+
+// Direct convolution, delayed by latency frames.
+std::vector<float> directConvolution(const std::vector<float>& in, const std::vector<float>& ir,
+                                     size_t latency) {
+    std::vector<float> out(in.size());
+    for (size_t n = latency; n < in.size(); ++n) {
+        double sum = 0;
+        for (size_t k = 0; k < ir.size() && k <= n - latency; ++k) {
+            sum += (double)ir[k] * in[n - latency - k];
+        }
+        out[n] = sum;
+    }
+    return out;
+}
+
+}  // namespace
+
+// Parameters: block size, impulse response length, tail threads, frames per process() call.
+class PartitionedConvolverTest
+    : public ::testing::TestWithParam<std::tuple<size_t, size_t, size_t, size_t>> {};
+
+TEST_P(PartitionedConvolverTest, matchesDirectConvolution) {
+    const auto [blockSize, irLength, tailThreads, chunk] = GetParam();
+    const std::vector<float> ir = randomSignal(irLength, 1);
+    const std::vector<float> in = randomSignal(8 * blockSize + irLength, 2);
+    const std::vector<float> expected = directConvolution(in, ir, blockSize);
+
+    PartitionedConvolver convolver(blockSize, tailThreads);
+    ASSERT_TRUE(convolver.setImpulseResponse(ir.data(), ir.size()));
+    EXPECT_EQ((irLength + blockSize - 1) / blockSize, convolver.getPartitionCount());
+    EXPECT_EQ(blockSize, convolver.getLatencyFrames());
+
+    // Process in place, to check that in may alias out.
+    std::vector<float> out = in;
+    for (size_t i = 0; i < out.size(); i += chunk) {
+        const size_t count = std::min(chunk, out.size() - i);
+        convolver.process(&out[i], &out[i], count);
+    }
+    for (size_t n = 0; n < out.size(); ++n) {
+        ASSERT_NEAR(expected[n], out[n], 1e-3f) << "frame " << n;
+    }
+
+    // After a reset the output starts over.
+    convolver.reset();
+    std::vector<float> again(in.size());
+    convolver.process(in.data(), again.data(), in.size());
+    for (size_t n = 0; n < again.size(); ++n) {
+        ASSERT_NEAR(expected[n], again[n], 1e-3f) << "frame " << n;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        PartitionedConvolverAll, PartitionedConvolverTest,
+        ::testing::Combine(::testing::Values(64, 256),      // block size
+                           ::testing::Values(1, 300, 2000), // impulse response length
+                           ::testing::Values(0, 1, 3),      // tail threads
+                           ::testing::Values(37, 256)));    // frames per process()
+
+TEST(PartitionedConvolverSimple, emptyImpulseResponse) {
+    PartitionedConvolver convolver(64);
+    const float ir = 1.f;
+    EXPECT_FALSE(convolver.setImpulseResponse(&ir, 0));
+
+    // Without an impulse response the output is silent.
+    std::vector<float> out(100, 1.f);
+    convolver.process(out.data(), out.data(), out.size());
+    for (float sample : out) {
+        EXPECT_EQ(0.f, sample);
+    }
+}
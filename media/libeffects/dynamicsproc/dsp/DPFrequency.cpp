@@ -91,7 +91,9 @@ void ChannelBuffer::initBuffers(unsigned int blockSize, unsigned int overlapSize
 void ChannelBuffer::computeBinStartStop(BandParams &bp, size_t binStart) {
 
     bp.binStart = binStart;
-    bp.binStop = (int)(0.5 + bp.freqCutoffHz * mBlockSize / mSamplingRate);
+    //only the half spectrum is computed, so bands stop at the Nyquist bin.
+    bp.binStop = std::min((size_t)(0.5 + bp.freqCutoffHz * mBlockSize / mSamplingRate),
+            (size_t)mBlockSize / 2);
 }
 
 //== LinkedLimiters Helper
@@ -152,6 +154,10 @@ void DPFrequency::configure(size_t blockSize, size_t overlapSize,
     mHalfFFTSize = 1 + mBlockSize / 2; //including Nyquist bin
     mOverlapSize = std::min(overlapSize, mBlockSize/2);
 
+    //the input is real, so the upper half of the spectrum is redundant and never computed.
+    mFftServer.SetFlag(Eigen::FFT<float>::HalfSpectrum);
+    mWindowedInput.resize(mBlockSize);
+
     int channelcount = getChannelCount();
     mSamplingRate = samplingRate;
     mChannelBuffers.resize(channelcount);
@@ -480,16 +486,15 @@ size_t DPFrequency::processFirstStages(ChannelBuffer &cb) {
     Eigen::Map<Eigen::VectorXf> eWindow(&mVWindow[0], mVWindow.size());
     Eigen::Map<Eigen::VectorXf> eInput(&cb.input[0], cb.input.size());
 
-    Eigen::VectorXf eWin = eInput.cwiseProduct(eWindow); //apply window
+    mWindowedInput = eInput.cwiseProduct(eWindow); //apply window, without allocating
 
     //##fft
     //Note: we are using eigen with the default scaling, which ensures that
     //  IFFT( FFT(x) ) = x.
     // TODO: optimize by using the noscale option, and compensate with dB scale offsets
-    mFftServer.fwd(cb.complexTemp, eWin);
+    mFftServer.fwd(cb.complexTemp, mWindowedInput);
 
-    size_t cSize = cb.complexTemp.size();
-    size_t maxBin = std::min(cSize/2, mHalfFFTSize);
+    const size_t maxBin = mBlockSize / 2; //excluding Nyquist bin
 
     //== EqPre (always runs)
     for (size_t k = 0; k < maxBin; k++) {
@@ -510,7 +515,7 @@ size_t DPFrequency::processFirstStages(ChannelBuffer &cb) {
                 fEnergySum += std::norm(cb.complexTemp[k]) * preGainSquared; //mag squared
             }
 
-            //Eigen FFT is full spectrum, even if the source was real data.
+            //Only the half spectrum is computed from the real data.
             // Each half spectrum has half the energy. This is taken into account with the * 2
             // factor in the energy computations.
             // energy = sqrt(sum_components_squared) number_points
@@ -656,14 +661,13 @@ size_t DPFrequency::processLastStages(ChannelBuffer &cb) {
 
     //apply to all if != 1.0
     if (!compareEquality(outputGainFactor, 1.0f)) {
-        size_t cSize = cb.complexTemp.size();
-        size_t maxBin = std::min(cSize/2, mHalfFFTSize);
+        const size_t maxBin = mBlockSize / 2; //excluding Nyquist bin
         for (size_t k = 0; k < maxBin; k++) {
             cb.complexTemp[k] *= outputGainFactor;
         }
     }
 
-    //##ifft directly to output.
+    //##ifft directly to output, from the half spectrum.
     Eigen::Map<Eigen::VectorXf> eOutput(&cb.output[0], cb.output.size());
     mFftServer.inv(eOutput, cb.complexTemp);
 
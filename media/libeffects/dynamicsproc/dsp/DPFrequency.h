@@ -153,6 +153,7 @@ private:
     FloatVec mVWindow;  //window class.
     float mWindowRms;
     Eigen::FFT<float> mFftServer;
+    Eigen::VectorXf mWindowedInput; //temp vector for the windowed input of one channel
 };
 
 } //namespace dp_fx
@@ -20,6 +20,7 @@
 
 #include <assert.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "Processors.h"
@@ -62,12 +63,12 @@ void Ramp::process(float *out, const float *in, size_t frameCount) {
     size_t i = 0;
 #if USE_NEON
     size_t sampleCount = frameCount * mChannelCount;
-    float32x2_t allZero = vdup_n_f32(0.0f);
-    while (i + 1 < sampleCount) {
-        vst1_f32(out, vmax_f32(vld1_f32(in), allZero));
-        in += 2;
-        out += 2;
-        i += 2;
+    float32x4_t allZero = vdupq_n_f32(0.0f);
+    while (i + 3 < sampleCount) {
+        vst1q_f32(out, vmaxq_f32(vld1q_f32(in), allZero));
+        in += 4;
+        out += 4;
+        i += 4;
     }
 #endif // USE_NEON
     for (; i < frameCount * mChannelCount; ++i) {
@@ -100,17 +101,47 @@ void SlowEnvelope::process(float* out, const float* in, size_t frameCount) {
         mLpfInBuffer[i] = fabs(in[i]);
     }
     mLpf->process(mLpfOutBuffer.data(), mLpfInBuffer.data(), frameCount);
-    for (size_t i = 0; i < sampleCount; ++i) {
-        out[i] = in[i] * pow(mLpfOutBuffer[i] + mEnvOffset, mNormalizationPower);
+    for (size_t frame = 0; frame < frameCount;) {
+        if (mFramesUntilGainUpdate == 0) {
+            updateGain(&mLpfOutBuffer[frame * mChannelCount]);
+        }
+        const size_t frames = std::min(frameCount - frame, mFramesUntilGainUpdate);
+        const size_t end = (frame + frames) * mChannelCount;
+        for (size_t i = frame * mChannelCount; i < end; i += mChannelCount) {
+            for (size_t c = 0; c < mChannelCount; ++c) {
+                const float delta = mLpfOutBuffer[i + c] + mEnvOffset - mGainEnvelope[c];
+                out[i + c] = in[i + c] * (mGain[c] + mGainSlope[c] * delta);
+            }
+        }
+        frame += frames;
+        mFramesUntilGainUpdate -= frames;
+    }
+}
+
+void SlowEnvelope::updateGain(const float* envelope) {
+    if (mGain.size() != mChannelCount) {
+        mGainEnvelope.resize(mChannelCount);
+        mGain.resize(mChannelCount);
+        mGainSlope.resize(mChannelCount);
+    }
+    for (size_t c = 0; c < mChannelCount; ++c) {
+        // The envelope of |in| is non-negative, and mEnvOffset keeps it away from 0.
+        const float value = envelope[c] + mEnvOffset;
+        mGainEnvelope[c] = value;
+        mGain[c] = pow(value, mNormalizationPower);
+        mGainSlope[c] = mNormalizationPower * mGain[c] / value;
     }
+    mFramesUntilGainUpdate = kGainUpdateFrames;
 }
 
 void SlowEnvelope::setNormalizationPower(float normalizationPower) {
     mNormalizationPower = normalizationPower;
+    mFramesUntilGainUpdate = 0;
 }
 
 void SlowEnvelope::clear() {
     mLpf->clear();
+    mFramesUntilGainUpdate = 0;
 }
 
 // Implementation of distortion
@@ -41,8 +41,17 @@ private:
 };
 
 
+// A class providing a process function that partially normalizes a waveform by a slow envelope,
+// out = in * pow(envelope(|in|) + envOffset, normalizationPower).
+//
+// As the envelope is low pass filtered at a few Hz, the pow() is only evaluated every
+// kGainUpdateFrames frames, and the gain is extended with its first order expansion in between.
+// The update frames only depend on the frames processed since clear(), not on the frame count
+// given to each process() call.
 class SlowEnvelope {
 public:
+    static constexpr size_t kGainUpdateFrames = 8;
+
     SlowEnvelope(float cornerFrequency, float sampleRate,
                  float normalizationPower, float envOffset,
                  size_t channelCount);
@@ -54,12 +63,19 @@ public:
     void clear();
 
 private:
+    void updateGain(const float *envelope);
+
     const std::shared_ptr<HapticBiquadFilter> mLpf;
     std::vector<float> mLpfInBuffer;
     std::vector<float> mLpfOutBuffer;
     float mNormalizationPower;
     const float mEnvOffset;
-    const float mChannelCount;
+    const size_t mChannelCount;
+    // Per channel envelope + offset at the last update, the gain and its derivative there.
+    std::vector<float> mGainEnvelope;
+    std::vector<float> mGain;
+    std::vector<float> mGainSlope;
+    size_t mFramesUntilGainUpdate = 0;
 };
 
 
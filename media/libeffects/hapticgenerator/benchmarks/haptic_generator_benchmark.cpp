@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Processors.h"
+
+using namespace android::audio_effect::haptic_generator;
+
+constexpr float kSampleRate = 48000.f;
+
+static std::vector<float> randomSignal(size_t sampleCount) {
+    std::minstd_rand gen(42);
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+    std::vector<float> signal(sampleCount);
+    for (auto& sample : signal) {
+        sample = dis(gen);
+    }
+    return signal;
+}
+
+// Arguments: frame count per process() call, haptic channel count.
+template <typename Processor>
+static void runProcessor(benchmark::State& state, Processor& processor) {
+    const size_t frameCount = state.range(0);
+    const size_t channelCount = state.range(1);
+    const std::vector<float> in = randomSignal(frameCount * channelCount);
+    std::vector<float> out(frameCount * channelCount);
+    for (auto _ : state) {
+        processor.process(out.data(), in.data(), frameCount);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * frameCount);
+}
+
+static void BM_Ramp(benchmark::State& state) {
+    Ramp ramp(state.range(1));
+    runProcessor(state, ramp);
+}
+
+static void BM_SlowEnvelope(benchmark::State& state) {
+    SlowEnvelope slowEnv(5.0f /*envCornerFrequency*/, kSampleRate,
+                         -0.8f /*normalizationPower*/, 0.01f /*envOffset*/, state.range(1));
+    runProcessor(state, slowEnv);
+}
+
+static void BM_Distortion(benchmark::State& state) {
+    Distortion distortion(300.0f /*cornerFrequency*/, kSampleRate, 0.3f /*inputGain*/,
+                          0.1f /*cubeThreshold*/, 1.5f /*outputGain*/, state.range(1));
+    runProcessor(state, distortion);
+}
+
+static void BM_BiquadFilter(benchmark::State& state) {
+    auto filter = createLPF2(500.0f /*cornerFrequency*/, kSampleRate, state.range(1));
+    runProcessor(state, *filter);
+}
+
+static void HapticArgs(benchmark::internal::Benchmark* b) {
+    for (int frameCount : {48, 192, 960}) {
+        for (int channelCount : {1, 2}) {
+            b->Args({frameCount, channelCount});
+        }
+    }
+}
+
+BENCHMARK(BM_Ramp)->Apply(HapticArgs);
+BENCHMARK(BM_SlowEnvelope)->Apply(HapticArgs);
+BENCHMARK(BM_Distortion)->Apply(HapticArgs);
+BENCHMARK(BM_BiquadFilter)->Apply(HapticArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "PartitionedConvolver.h"
+
+using android::PartitionedConvolver;
+
+// Same frame count as reverb_benchmark, for comparison with the time domain reverb.
+constexpr size_t kFrameCount = 2048;
+
+constexpr int kSampleRate = 44100;
+
+/*******************************************************************
+ * Stereo convolution with one impulse response per channel.
+ * The first parameter is the impulse response length in ms.
+ * The second parameter is the block size in frames.
+ * The third parameter is the number of tail threads per channel.
+ * With tail threads, CPU is the time of the calling effect thread; the wall clock time
+ * includes waiting for the tail, which in a real audio callback is hidden by the idle time
+ * between callbacks.
+ *******************************************************************/
+
+static void BM_CONVOLUTION(benchmark::State& state) {
+    const size_t irFrames = state.range(0) * kSampleRate / 1000;
+    const size_t blockSize = state.range(1);
+    const size_t tailThreads = state.range(2);
+    constexpr size_t kChannelCount = 2;
+
+    // Initialize the input and the decaying impulse responses with deterministic
+    // pseudo-random values
+    std::minstd_rand gen(irFrames);
+    std::uniform_real_distribution<> dis(-1.0f, 1.0f);
+    std::vector<float> input(kFrameCount);
+    std::vector<float> output(kFrameCount);
+    for (auto& in : input) {
+        in = dis(gen);
+    }
+    std::vector<float> ir(irFrames);
+
+    std::vector<std::unique_ptr<PartitionedConvolver>> convolvers;
+    for (size_t ch = 0; ch < kChannelCount; ++ch) {
+        for (size_t i = 0; i < irFrames; ++i) {
+            ir[i] = dis(gen) * (1.f - (float)i / irFrames);
+        }
+        convolvers.push_back(std::make_unique<PartitionedConvolver>(blockSize, tailThreads));
+        convolvers.back()->setImpulseResponse(ir.data(), ir.size());
+    }
+
+    // Run the test
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(input.data());
+        benchmark::DoNotOptimize(output.data());
+
+        for (auto& convolver : convolvers) {
+            convolver->process(input.data(), output.data(), kFrameCount);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+
+static void CONVOLUTIONArgs(benchmark::internal::Benchmark* b) {
+    for (int irMs : {100, 500, 2000}) {
+        for (int blockSize : {128, 512}) {
+            for (int tailThreads : {0, 1, 2}) {
+                b->Args({irMs, blockSize, tailThreads});
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_CONVOLUTION)->Apply(CONVOLUTIONArgs);
+
+BENCHMARK_MAIN();
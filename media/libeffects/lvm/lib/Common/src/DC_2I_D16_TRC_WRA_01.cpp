@@ -37,23 +37,19 @@
  */
 void DC_Mc_D16_TRC_WRA_01(Biquad_FLOAT_Instance_t* pInstance, LVM_FLOAT* pDataIn,
                           LVM_FLOAT* pDataOut, LVM_INT16 NrFrames, LVM_INT16 NrChannels) {
-    LVM_FLOAT* ChDC;
-    LVM_FLOAT Diff;
-    LVM_INT32 j;
-    LVM_INT32 i;
     PFilter_FLOAT_State_Mc pBiquadState = (PFilter_FLOAT_State_Mc)pInstance;
+    LVM_FLOAT* const ChDC = &pBiquadState->ChDC[0];
 
-    ChDC = &pBiquadState->ChDC[0];
-    for (j = NrFrames - 1; j >= 0; j--) {
-        /* Subtract DC and saturate */
-        for (i = NrChannels - 1; i >= 0; i--) {
-            Diff = *(pDataIn++) - (ChDC[i]);
-            *(pDataOut++) = LVM_Clamp(Diff);
-            if (Diff < 0) {
-                ChDC[i] -= DC_FLOAT_STEP;
-            } else {
-                ChDC[i] += DC_FLOAT_STEP;
-            }
+    for (LVM_INT32 j = 0; j < NrFrames; j++) {
+        /* Subtract DC and saturate, channel i of the frame uses ChDC[NrChannels - 1 - i] */
+        /* The step is selected without a branch so all channels are processed in parallel */
+        for (LVM_INT32 i = 0; i < NrChannels; i++) {
+            LVM_FLOAT* const pDC = &ChDC[NrChannels - 1 - i];
+            const LVM_FLOAT Diff = pDataIn[i] - *pDC;
+            pDataOut[i] = LVM_Clamp(Diff);
+            *pDC += (Diff < 0) ? -DC_FLOAT_STEP : DC_FLOAT_STEP;
         }
+        pDataIn += NrChannels;
+        pDataOut += NrChannels;
     }
 }
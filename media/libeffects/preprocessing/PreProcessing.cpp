@@ -16,6 +16,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 #define LOG_TAG "PreProcessing"
 //#define LOG_NDEBUG 0
 #include <audio_effects/effect_aec.h>
@@ -125,6 +126,10 @@ struct preproc_session_s {
     uint32_t revProcessedMsk;  // bit field containing IDs of pre processors with reverse
                                // channel already processed in current round
     webrtc::StreamConfig revConfig;     // reverse stream configuration.
+    // Input and output of the last ProcessStream() call, shared with the other sessions
+    // on the same input stream with the same configuration. See Session_FindSharedOutput().
+    std::vector<int16_t> lastInput;
+    std::vector<int16_t> lastOutput;
 };
 
 #ifdef DUAL_MIC_TEST
@@ -886,6 +891,8 @@ int Session_ReleaseEffect(preproc_session_t* session, preproc_effect_t* fx) {
         // Scoped_refptr will handle reference counting here
         session->apm = nullptr;
         session->id = 0;
+        session->lastInput.clear();
+        session->lastOutput.clear();
     }
 
     return 0;
@@ -916,6 +923,7 @@ int Session_SetConfig(preproc_session_t* session, effect_config_t* config) {
     session->revChannelCount = inCnl;
     session->revConfig.set_sample_rate_hz(session->samplingRate);
     session->revConfig.set_num_channels(inCnl);
+    session->lastInput.clear();
 
     session->state = PREPROC_SESSION_STATE_CONFIG;
     return 0;
@@ -983,6 +991,7 @@ void Session_SetProcEnabled(preproc_session_t* session, uint32_t procId, bool en
     if (HasReverseStream(procId)) {
         session->revProcessedMsk = 0;
     }
+    session->lastInput.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -1026,6 +1035,49 @@ int PreProc_Init() {
     return sInitStatus;
 }
 
+bool Session_ConfigMatches(const preproc_session_t* session, const preproc_session_t* other) {
+    const webrtc::AudioProcessing::Config& a = session->config;
+    const webrtc::AudioProcessing::Config& b = other->config;
+    return session->enabledMsk == other->enabledMsk &&
+           session->samplingRate == other->samplingRate &&
+           session->inChannelCount == other->inChannelCount &&
+           session->outChannelCount == other->outChannelCount &&
+           a.gain_controller1.enabled == b.gain_controller1.enabled &&
+           a.gain_controller1.target_level_dbfs == b.gain_controller1.target_level_dbfs &&
+           a.gain_controller1.compression_gain_db == b.gain_controller1.compression_gain_db &&
+           a.gain_controller1.enable_limiter == b.gain_controller1.enable_limiter &&
+           a.gain_controller2.enabled == b.gain_controller2.enabled &&
+           a.gain_controller2.fixed_digital.gain_db == b.gain_controller2.fixed_digital.gain_db &&
+           a.noise_suppression.enabled == b.noise_suppression.enabled &&
+           a.noise_suppression.level == b.noise_suppression.level;
+}
+
+// Several capture clients on the same input stream, e.g. a voice assistant and a VoIP call,
+// each get their own session with the same pre processors. When another session on the same
+// input with the same configuration has just processed this exact input buffer, its output is
+// returned so that ProcessStream() runs once for all of them.
+// Sessions with a reverse stream (AEC) are never shared, as the echo path and delay are
+// specific to each session.
+const preproc_session_t* Session_FindSharedOutput(const preproc_session_t* session,
+                                                  const int16_t* in, size_t inSamples,
+                                                  size_t outSamples) {
+    if (session->revEnabledMsk != 0) {
+        return NULL;
+    }
+    for (size_t i = 0; i < PREPROC_NUM_SESSIONS; i++) {
+        const preproc_session_t* other = &sSessions[i];
+        if (other == session || other->id == 0 || other->io != session->io ||
+            other->revEnabledMsk != 0 || other->lastInput.size() != inSamples ||
+            other->lastOutput.size() != outSamples || !Session_ConfigMatches(session, other)) {
+            continue;
+        }
+        if (memcmp(other->lastInput.data(), in, inSamples * sizeof(int16_t)) == 0) {
+            return other;
+        }
+    }
+    return NULL;
+}
+
 const effect_descriptor_t* PreProc_GetDescriptor(const effect_uuid_t* uuid) {
     size_t i;
     for (i = 0; i < PREPROC_NUM_EFFECTS; i++) {
@@ -1075,6 +1127,19 @@ int PreProcessingFx_Process(effect_handle_t self, audio_buffer_t* inBuffer,
     //         inBuffer->frameCount, session->enabledMsk, session->processedMsk);
     if ((session->processedMsk & session->enabledMsk) == session->enabledMsk) {
         effect->session->processedMsk = 0;
+        const size_t inSamples = session->frameCount * session->inputConfig.num_channels();
+        const size_t outSamples = session->frameCount * session->outputConfig.num_channels();
+        if (const preproc_session_t* shared =
+                    Session_FindSharedOutput(session, inBuffer->s16, inSamples, outSamples);
+            shared != NULL) {
+            // Keep a copy, so that this session can in turn be shared with later ones.
+            session->lastInput = shared->lastInput;
+            session->lastOutput = shared->lastOutput;
+            memcpy(outBuffer->s16, shared->lastOutput.data(), outSamples * sizeof(int16_t));
+            return 0;
+        }
+        // The input is saved first, as inBuffer and outBuffer may be the same buffer.
+        session->lastInput.assign(inBuffer->s16, inBuffer->s16 + inSamples);
         if (int status = effect->session->apm->ProcessStream(
                     (const int16_t* const)inBuffer->s16,
                     (const webrtc::StreamConfig)effect->session->inputConfig,
@@ -1082,8 +1147,10 @@ int PreProcessingFx_Process(effect_handle_t self, audio_buffer_t* inBuffer,
                     (int16_t* const)outBuffer->s16);
             status != 0) {
             ALOGE("Process Stream failed with error %d\n", status);
+            session->lastInput.clear();
             return status;
         }
+        session->lastOutput.assign(outBuffer->s16, outBuffer->s16 + outSamples);
         return 0;
     } else {
         return -ENODATA;
@@ -320,6 +320,60 @@ INSTANTIATE_TEST_SUITE_P(
                            ::testing::Range(0, (int)EffectTestHelper::kNumLoopCounts),
                            ::testing::Range(0, (int)kNumPreProcParams)));
 
+// Two sessions with the same configuration on the same input share the processing,
+// and must both get the output of a session processing the same input on its own.
+TEST(SharedSessionTest, SameOutputAsSingleSession) {
+    constexpr size_t kSampleRate = 48000;
+    constexpr size_t kFrameCount = kSampleRate * EffectTestHelper::kTenMilliSecVal;
+    constexpr size_t kBufferCount = 8;
+    constexpr uint32_t kNsLevel = 2;
+
+    std::vector<int16_t> input(kFrameCount * kBufferCount);
+    std::minstd_rand gen(kSampleRate);
+    std::uniform_int_distribution<int16_t> dis(INT16_MIN, INT16_MAX);
+    for (auto& in : input) {
+        in = dis(gen);
+    }
+
+    EffectTestHelper reference(&kNSUuid, AUDIO_CHANNEL_IN_MONO, kSampleRate, 1 /* loopCount */,
+                               1 /* sessionId */, 1 /* ioId */);
+    ASSERT_NO_FATAL_FAILURE(reference.createEffect());
+    ASSERT_NO_FATAL_FAILURE(reference.setConfig(false /* configReverse */));
+    ASSERT_NO_FATAL_FAILURE(reference.setParam(NS_PARAM_LEVEL, kNsLevel));
+    std::vector<int16_t> referenceOutput(input.size());
+    for (size_t i = 0; i < kBufferCount; ++i) {
+        ASSERT_NO_FATAL_FAILURE(reference.process(&input[kFrameCount * i],
+                                                  &referenceOutput[kFrameCount * i], false));
+    }
+    ASSERT_NO_FATAL_FAILURE(reference.releaseEffect());
+
+    EffectTestHelper first(&kNSUuid, AUDIO_CHANNEL_IN_MONO, kSampleRate, 1 /* loopCount */,
+                           1 /* sessionId */, 2 /* ioId */);
+    EffectTestHelper second(&kNSUuid, AUDIO_CHANNEL_IN_MONO, kSampleRate, 1 /* loopCount */,
+                            2 /* sessionId */, 2 /* ioId */);
+    for (auto* effect : {&first, &second}) {
+        ASSERT_NO_FATAL_FAILURE(effect->createEffect());
+        ASSERT_NO_FATAL_FAILURE(effect->setConfig(false /* configReverse */));
+        ASSERT_NO_FATAL_FAILURE(effect->setParam(NS_PARAM_LEVEL, kNsLevel));
+    }
+    std::vector<int16_t> firstOutput(input.size());
+    std::vector<int16_t> secondOutput(input.size());
+    for (size_t i = 0; i < kBufferCount; ++i) {
+        ASSERT_NO_FATAL_FAILURE(
+                first.process(&input[kFrameCount * i], &firstOutput[kFrameCount * i], false));
+        // Process in place, as the output of the first session is shared.
+        std::copy(&input[kFrameCount * i], &input[kFrameCount * (i + 1)],
+                  &secondOutput[kFrameCount * i]);
+        ASSERT_NO_FATAL_FAILURE(second.process(&secondOutput[kFrameCount * i],
+                                               &secondOutput[kFrameCount * i], false));
+    }
+    ASSERT_NO_FATAL_FAILURE(first.releaseEffect());
+    ASSERT_NO_FATAL_FAILURE(second.releaseEffect());
+
+    EXPECT_EQ(referenceOutput, firstOutput);
+    EXPECT_EQ(referenceOutput, secondOutput);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int status = RUN_ALL_TESTS();
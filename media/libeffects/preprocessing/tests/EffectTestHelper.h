@@ -52,13 +52,16 @@ static float computeSnr(const T* ref, const T* tst, size_t count) {
 
 class EffectTestHelper {
   public:
-    EffectTestHelper(const effect_uuid_t* uuid, size_t chMask, size_t sampleRate, size_t loopCount)
+    EffectTestHelper(const effect_uuid_t* uuid, size_t chMask, size_t sampleRate, size_t loopCount,
+                     int32_t sessionId = 1, int32_t ioId = 1)
         : mUuid(uuid),
           mChMask(chMask),
           mChannelCount(audio_channel_count_from_in_mask(mChMask)),
           mSampleRate(sampleRate),
           mFrameCount(mSampleRate * kTenMilliSecVal),
-          mLoopCount(loopCount) {}
+          mLoopCount(loopCount),
+          mSessionId(sessionId),
+          mIoId(ioId) {}
     void createEffect();
     void releaseEffect();
     void setConfig(bool configReverse);
@@ -106,5 +109,7 @@ class EffectTestHelper {
     const size_t mSampleRate;
     const size_t mFrameCount;
     const size_t mLoopCount;
+    const int32_t mSessionId;
+    const int32_t mIoId;
     effect_handle_t mEffectHandle{};
 };
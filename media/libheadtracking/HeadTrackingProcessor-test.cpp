@@ -106,6 +106,29 @@ TEST(HeadTrackingProcessor, Prediction) {
     EXPECT_EQ(processor->getHeadToStagePose(), Pose3f());
 }
 
+TEST(HeadTrackingProcessor, BatchedHeadPoses) {
+    std::vector<HeadTrackingProcessor::WorldToHeadSample> samples;
+    for (int64_t i = 0; i < 8; ++i) {
+        samples.push_back({i, Pose3f({1.f * i, 2, 3}, Quaternionf::UnitRandom()),
+                           Twist3f({4, 5, 6}, quaternionToRotationVector(
+                                   Quaternionf::UnitRandom()) / 10)});
+    }
+
+    std::unique_ptr<HeadTrackingProcessor> batched = createHeadTrackingProcessor(
+            Options{.predictionDuration = 2.f}, HeadTrackingMode::WORLD_RELATIVE);
+    std::unique_ptr<HeadTrackingProcessor> single = createHeadTrackingProcessor(
+            Options{.predictionDuration = 2.f}, HeadTrackingMode::WORLD_RELATIVE);
+
+    batched->setWorldToHeadPoses(samples);
+    for (const auto& sample : samples) {
+        single->setWorldToHeadPose(sample.timestamp, sample.worldToHead, sample.headTwist);
+    }
+    batched->calculate(8);
+    single->calculate(8);
+    ASSERT_EQ(batched->getActualMode(), single->getActualMode());
+    EXPECT_EQ(batched->getHeadToStagePose(), single->getHeadToStagePose());
+}
+
 TEST(HeadTrackingProcessor, SmoothModeSwitch) {
     const Pose3f targetHeadToWorld = Pose3f({4, 0, 0}, rotateZ(M_PI / 2));
 
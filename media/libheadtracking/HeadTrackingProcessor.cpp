@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 #include <inttypes.h>
+#include <chrono>
 
 #include <android-base/stringprintf.h>
 #include <audio_utils/SimpleLog.h>
+#include <audio_utils/Statistics.h>
 #include "media/HeadTrackingProcessor.h"
 #include "media/QuaternionUtil.h"
 
@@ -60,11 +62,21 @@ class HeadTrackingProcessorImpl : public HeadTrackingProcessor {
 
     void setWorldToHeadPose(int64_t timestamp, const Pose3f& worldToHead,
                             const Twist3f& headTwist) override {
-        const Pose3f predictedWorldToHead = mPosePredictor.predict(
-                timestamp, worldToHead, headTwist, mOptions.predictionDuration);
+        mHeadPoseBias.setInput(predictHead(timestamp, worldToHead, headTwist));
+    }
+
+    void setWorldToHeadPoses(const std::vector<WorldToHeadSample>& samples) override {
+        if (samples.empty()) return;
+        const auto start = std::chrono::steady_clock::now();
+        // Prediction and stillness detection need every sample; the bias only needs the last.
+        Pose3f predictedWorldToHead;
+        for (const auto& sample : samples) {
+            predictedWorldToHead =
+                    predictHead(sample.timestamp, sample.worldToHead, sample.headTwist);
+        }
         mHeadPoseBias.setInput(predictedWorldToHead);
-        mHeadStillnessDetector.setInput(timestamp, predictedWorldToHead);
-        mWorldToHeadTimestamp = timestamp;
+        mBatchSizes.add(samples.size());
+        mBatchUs.add(elapsedUs(start));
     }
 
     void setWorldToScreenPose(int64_t timestamp, const Pose3f& worldToScreen) override {
@@ -89,6 +101,7 @@ class HeadTrackingProcessorImpl : public HeadTrackingProcessor {
     }
 
     void calculate(int64_t timestamp) override {
+        const auto start = std::chrono::steady_clock::now();
         bool screenStable = true;
 
         // Handle the screen first, since it might: trigger a recentering of the head.
@@ -134,6 +147,7 @@ class HeadTrackingProcessorImpl : public HeadTrackingProcessor {
         }
         mRateLimiter.setTarget(mModeSelector.getHeadToStagePose());
         mHeadToStagePose = mRateLimiter.calculatePose(timestamp);
+        mCalculateUs.add(elapsedUs(start));
     }
 
     Pose3f getHeadToStagePose() const override { return mHeadToStagePose; }
@@ -192,12 +206,32 @@ class HeadTrackingProcessorImpl : public HeadTrackingProcessor {
         ss += mModeSelector.toString(level + 1);
         ss += mRateLimiter.toString(level + 1);
         ss += mPosePredictor.toString(level + 1);
+        StringAppendF(&ss, "%s calculate us: %s\n", prefixSpace.c_str(),
+                      mCalculateUs.toString().c_str());
+        StringAppendF(&ss, "%s head batch us: %s\n", prefixSpace.c_str(),
+                      mBatchUs.toString().c_str());
+        StringAppendF(&ss, "%s head batch size: %s\n", prefixSpace.c_str(),
+                      mBatchSizes.toString().c_str());
         ss.append(prefixSpace + "ReCenterHistory:\n");
         ss += mLocalLog.dumpToString((prefixSpace + " ").c_str(), mMaxLocalLogLine);
         return ss;
     }
 
   private:
+    // Runs one head sample through the predictor and stillness detector, returns the prediction.
+    Pose3f predictHead(int64_t timestamp, const Pose3f& worldToHead, const Twist3f& headTwist) {
+        const Pose3f predictedWorldToHead = mPosePredictor.predict(
+                timestamp, worldToHead, headTwist, mOptions.predictionDuration);
+        mHeadStillnessDetector.setInput(timestamp, predictedWorldToHead);
+        mWorldToHeadTimestamp = timestamp;
+        return predictedWorldToHead;
+    }
+
+    static double elapsedUs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+
     const Options mOptions;
     float mPhysicalToLogicalAngle = 0;
     // We store the physical to logical angle as "pending" until the next world-to-screen sample it
@@ -214,6 +248,10 @@ class HeadTrackingProcessorImpl : public HeadTrackingProcessor {
     ModeSelector mModeSelector;
     PoseRateLimiter mRateLimiter;
     PosePredictor mPosePredictor;
+    // Processing time statistics, for the dump.
+    audio_utils::Statistics<double> mCalculateUs;
+    audio_utils::Statistics<double> mBatchUs;
+    audio_utils::Statistics<double> mBatchSizes;
     static constexpr std::size_t mMaxLocalLogLine = 10;
     SimpleLog mLocalLog{mMaxLocalLogLine};
 };
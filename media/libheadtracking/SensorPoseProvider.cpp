@@ -45,6 +45,9 @@ using android::base::StringAppendF;
 // Note: Instead of a fixed number, the SensorEventQueue's fd could be used instead.
 constexpr int kIdent = 19;
 
+// Maximum number of sensor events read from the queue per looper wakeup.
+constexpr size_t kMaxEventsPerRead = 16;
+
 static inline Looper* ALooper_to_Looper(ALooper* alooper) {
     return reinterpret_cast<Looper*>(alooper);
 }
@@ -293,25 +296,24 @@ class SensorPoseProviderImpl : public SensorPoseProvider {
                     continue;
             }
 
-            // Process an event.
-            ASensorEvent event;
-            ssize_t actual = mQueue->read(&event, 1);
+            // Process the pending events, draining up to kMaxEventsPerRead per wakeup so that
+            // high rate sensors do not cost a poll for every sample.
+            ASensorEvent events[kMaxEventsPerRead];
+            ssize_t actual = mQueue->read(events, kMaxEventsPerRead);
             if (actual > 0) {
-                mQueue->sendAck(&event, actual);
+                mQueue->sendAck(events, actual);
             }
-            ssize_t size = mQueue->filterEvents(&event, actual);
+            ssize_t size = mQueue->filterEvents(events, actual);
 
-            if (size < 0 || size > 1) {
+            if (size < 0 || size > static_cast<ssize_t>(kMaxEventsPerRead)) {
                 ALOGE("%s: Unexpected return value from SensorEventQueue::filterEvents: %zd",
                         __func__, size);
                 break;
             }
-            if (size == 0) {
-                // No events.
-                continue;
-            }
 
-            handleEvent(event);
+            for (ssize_t i = 0; i < size; ++i) {
+                handleEvent(events[i]);
+            }
         }
         ALOGD("%s: Exiting sensor event loop", __func__);
     }
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <limits>
+#include <vector>
 
 #include "HeadTrackingMode.h"
 #include "Pose.h"
@@ -59,6 +60,20 @@ class HeadTrackingProcessor {
     virtual void setWorldToHeadPose(int64_t timestamp, const Pose3f& worldToHead,
                                     const Twist3f& headTwist) = 0;
 
+    /** A timestamped world-to-head pose and head twist, as given to setWorldToHeadPose(). */
+    struct WorldToHeadSample {
+        int64_t timestamp;
+        Pose3f worldToHead;
+        Twist3f headTwist;
+    };
+
+    /**
+     * Sets a block of world-to-head samples, in timestamp order.
+     * Equivalent to calling setWorldToHeadPose() for each sample, but the drift compensation is
+     * only updated for the last one.
+     */
+    virtual void setWorldToHeadPoses(const std::vector<WorldToHeadSample>& samples) = 0;
+
     /**
      * Sets the world-to-screen pose.
      */
@@ -317,11 +317,18 @@ HeifDecoderImpl::HeifDecoderImpl() :
     mAvailableLines(0),
     mNumSlices(1),
     mSliceHeight(0),
-    mAsyncDecodeDone(false) {
+    mAsyncDecodeDone(false),
+    mAsyncDecodeCanceled(false),
+    mRegionBottom(0) {
 }
 
 HeifDecoderImpl::~HeifDecoderImpl() {
     if (mThread != nullptr) {
+        {
+            // Don't decode the slices that can no longer be read.
+            Mutex::Autolock autolock(mLock);
+            mAsyncDecodeCanceled = true;
+        }
         mThread->join();
     }
 }
@@ -520,6 +527,12 @@ bool HeifDecoderImpl::decodeAsync() {
     }
 
     for (size_t i = 1; i < mNumSlices; i++) {
+        {
+            Mutex::Autolock autolock(mLock);
+            if (mAsyncDecodeCanceled) {
+                break;
+            }
+        }
         sp<MediaMetadataRetriever> retriever = weakRetriever.promote();
         if (retriever == nullptr) {
             return false;
@@ -548,6 +561,12 @@ bool HeifDecoderImpl::decodeAsync() {
             mScanlineReady.signal();
         }
     }
+    {
+        // Wake up readers waiting for scanlines past the last slice.
+        Mutex::Autolock autolock(mLock);
+        mAsyncDecodeDone = true;
+        mScanlineReady.signal();
+    }
     // Hold on to mDataSource in case the client wants to redecode.
 
     {
@@ -581,7 +600,12 @@ bool HeifDecoderImpl::decode(HeifFrameInfo* frameInfo) {
     // scanline processing in parallel with decode. If this fails
     // we fallback to decoding the full frame.
     if (mHasImage) {
-        if (mSliceHeight >= 512 &&
+        if (mRegionBottom > 0) {
+            // Decode the slices up to the bottom of the region only.
+            mNumSlices = (mRegionBottom + mSliceHeight - 1) / mSliceHeight;
+            ALOGV("mSliceHeight %u, mNumSlices %zu, region bottom %u",
+                    mSliceHeight, mNumSlices, mRegionBottom);
+        } else if (mSliceHeight >= 512 &&
                 mImageInfo.mWidth >= 3000 &&
                 mImageInfo.mHeight >= 2000 ) {
             // Try decoding in slices only if the image has tiles and is big enough.
@@ -589,7 +613,7 @@ bool HeifDecoderImpl::decode(HeifFrameInfo* frameInfo) {
             ALOGV("mSliceHeight %u, mNumSlices %zu", mSliceHeight, mNumSlices);
         }
 
-        if (mNumSlices > 1) {
+        if (isSliceDecoding()) {
             // get first slice and metadata
             sp<IMemory> frameMemory = retriever->getImageRectAtIndex(
                     -1, mOutputColor, 0, 0, mImageInfo.mWidth, mSliceHeight);
@@ -619,6 +643,7 @@ bool HeifDecoderImpl::decode(HeifFrameInfo* frameInfo) {
             mThread.clear();
             mNumSlices = 1;
             mSliceHeight = 0;
+            mRegionBottom = 0;
             mAvailableLines = 0;
             mFrameMemory.clear();
         }
@@ -731,6 +756,22 @@ bool HeifDecoderImpl::decodeSequence(int frameIndex, HeifFrameInfo* frameInfo) {
     return true;
 }
 
+bool HeifDecoderImpl::setDecodeRegion(uint32_t top, uint32_t bottom) {
+    ALOGV("%s: top %u, bottom %u", __FUNCTION__, top, bottom);
+    // The region can only be decoded in slices of rows of tiles, which are decoded in
+    // order from the top. Decoding stops after the slice containing |bottom|.
+    if (!mHasImage || mFrameDecoded || mSliceHeight == 0 || mSliceHeight >= mImageInfo.mHeight
+            || top >= bottom || bottom > mImageInfo.mHeight) {
+        return false;
+    }
+    mRegionBottom = (bottom < mImageInfo.mHeight) ? bottom : 0;
+    return true;
+}
+
+bool HeifDecoderImpl::isSliceDecoding() const {
+    return mNumSlices > 1 || mRegionBottom > 0;
+}
+
 bool HeifDecoderImpl::getScanlineInner(uint8_t* dst) {
     if (mFrameMemory == nullptr || mFrameMemory->unsecurePointer() == nullptr) {
         return false;
@@ -751,7 +792,7 @@ bool HeifDecoderImpl::getScanline(uint8_t* dst) {
         return false;
     }
 
-    if (mNumSlices > 1) {
+    if (isSliceDecoding()) {
         Mutex::Autolock autolock(mLock);
 
         while (!mAsyncDecodeDone && mCurScanline >= mAvailableLines) {
@@ -50,6 +50,8 @@ public:
 
     bool decodeSequence(int frameIndex, HeifFrameInfo* frameInfo) override;
 
+    bool setDecodeRegion(uint32_t top, uint32_t bottom) override;
+
     bool getScanline(uint8_t* dst) override;
 
     size_t skipScanlines(size_t count) override;
@@ -82,8 +84,12 @@ private:
     size_t mNumSlices;
     uint32_t mSliceHeight;
     bool mAsyncDecodeDone;
+    bool mAsyncDecodeCanceled;
+    // Bottom of the region set by setDecodeRegion(), or 0 to decode the whole picture.
+    uint32_t mRegionBottom;
 
     bool decodeAsync();
+    bool isSliceDecoding() const;
     bool getScanlineInner(uint8_t* dst);
     bool reinit(HeifFrameInfo* frameInfo);
 };
@@ -151,6 +151,16 @@ struct HeifDecoder {
      */
     virtual bool decodeSequence(int frameIndex, HeifFrameInfo* frameInfo) = 0;
 
+    /*
+     * Restricts the following decode() to the scanlines [top, bottom) of the
+     * primary picture, returning whether it is supported. Must be called before
+     * decode().
+     *
+     * Decoding stops once the scanlines up to |bottom| are available; reading
+     * past the region with getScanline() may then fail.
+     */
+    virtual bool setDecodeRegion(uint32_t /*top*/, uint32_t /*bottom*/) { return false; }
+
     /*
      * Read the next scanline (in top-down order), returns true upon success
      * and false otherwise.
@@ -17,6 +17,9 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#include <map>
+#include <mutex>
+
 #include <binder/Parcel.h>
 #include <media/stagefright/MediaCodecList.h>
 #include <media/IMediaCodecList.h>
@@ -43,23 +46,43 @@ public:
     {
     }
 
+    // A remote codec list does not change once created, so the codec count, the codec infos
+    // and the global settings are only fetched once per proxy.
+
     virtual size_t countCodecs() const
     {
+        std::lock_guard<std::mutex> lock(mCacheLock);
+        if (mCount >= 0) {
+            return static_cast<size_t>(mCount);
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
-        remote()->transact(COUNT_CODECS, data, &reply);
-        return static_cast<size_t>(reply.readInt32());
+        status_t err = remote()->transact(COUNT_CODECS, data, &reply);
+        int32_t count = reply.readInt32();
+        if (err == OK) {
+            mCount = count;
+        }
+        return static_cast<size_t>(count);
     }
 
     virtual sp<MediaCodecInfo> getCodecInfo(size_t index) const
     {
+        std::lock_guard<std::mutex> lock(mCacheLock);
+        auto it = mInfos.find(index);
+        if (it != mInfos.end()) {
+            return it->second;
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
         data.writeInt32(index);
         remote()->transact(GET_CODEC_INFO, data, &reply);
         status_t err = reply.readInt32();
         if (err == OK) {
-            return MediaCodecInfo::FromParcel(reply);
+            sp<MediaCodecInfo> info = MediaCodecInfo::FromParcel(reply);
+            if (info != NULL) {
+                mInfos.emplace(index, info);
+            }
+            return info;
         } else {
             return NULL;
         }
@@ -67,12 +90,17 @@ public:
 
     virtual const sp<AMessage> getGlobalSettings() const
     {
+        std::lock_guard<std::mutex> lock(mCacheLock);
+        if (mGlobalSettings != NULL) {
+            return mGlobalSettings->dup();
+        }
         Parcel data, reply;
         data.writeInterfaceToken(IMediaCodecList::getInterfaceDescriptor());
         remote()->transact(GET_GLOBAL_SETTINGS, data, &reply);
         status_t err = reply.readInt32();
         if (err == OK) {
-            return AMessage::FromParcel(reply);
+            mGlobalSettings = AMessage::FromParcel(reply);
+            return mGlobalSettings == NULL ? NULL : mGlobalSettings->dup();
         } else {
             return NULL;
         }
@@ -102,6 +130,12 @@ public:
         remote()->transact(FIND_CODEC_BY_NAME, data, &reply);
         return static_cast<ssize_t>(reply.readInt32());
     }
+
+private:
+    mutable std::mutex mCacheLock;
+    mutable int32_t mCount = -1;
+    mutable std::map<size_t, sp<MediaCodecInfo>> mInfos;
+    mutable sp<AMessage> mGlobalSettings;
 };
 
 IMPLEMENT_META_INTERFACE(MediaCodecList, "android.media.IMediaCodecList");
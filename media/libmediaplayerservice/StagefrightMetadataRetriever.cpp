@@ -45,7 +45,9 @@ namespace android {
 StagefrightMetadataRetriever::StagefrightMetadataRetriever()
     : mParsedMetaData(false),
       mAlbumArt(NULL),
-      mLastDecodedIndex(-1) {
+      mLastDecodedIndex(-1),
+      mFrameOption(-1),
+      mFrameColorFormat(-1) {
     ALOGV("StagefrightMetadataRetriever()");
 }
 
@@ -64,6 +66,7 @@ status_t StagefrightMetadataRetriever::setDataSource(
     ALOGV("setDataSource(%s)", uri);
 
     clearMetadata();
+    clearDecoder();
     mSource = PlayerServiceDataSourceFactory::getInstance()->CreateFromURI(
             httpService, uri, headers);
 
@@ -93,6 +96,7 @@ status_t StagefrightMetadataRetriever::setDataSource(
     ALOGV("setDataSource(%d, %" PRId64 ", %" PRId64 ")", fd, offset, length);
 
     clearMetadata();
+    clearDecoder();
     mSource = new PlayerServiceFileSource(fd, offset, length);
 
     status_t err;
@@ -118,6 +122,7 @@ status_t StagefrightMetadataRetriever::setDataSource(
     ALOGV("setDataSource(DataSource)");
 
     clearMetadata();
+    clearDecoder();
     mSource = source;
     mExtractor = MediaExtractorFactory::Create(mSource, mime);
 
@@ -155,8 +160,7 @@ sp<IMemory> StagefrightMetadataRetriever::getImageRectAtIndex(
 
 sp<IMemory> StagefrightMetadataRetriever::getImageInternal(
         int index, int colorFormat, bool metaOnly, bool thumbnail, FrameRect* rect) {
-    mDecoder.clear();
-    mLastDecodedIndex = -1;
+    clearDecoder();
 
     if (mExtractor.get() == NULL) {
         ALOGE("no extractor.");
@@ -310,6 +314,17 @@ sp<IMemory> StagefrightMetadataRetriever::getFrameAtTime(
     ALOGV("getFrameAtTime: %" PRId64 " us option: %d colorFormat: %d, metaOnly: %d",
             timeUs, option, colorFormat, metaOnly);
 
+    // Reuse the codec of the previous frame extraction, so that extracting a series of
+    // thumbnails does not create and tear down a codec for each of them.
+    if (!metaOnly && mDecoder != NULL && option != MediaSource::ReadOptions::SEEK_FRAME_INDEX
+            && option == mFrameOption && colorFormat == mFrameColorFormat) {
+        sp<IMemory> frame = mDecoder->extractFrameAtTime(timeUs);
+        if (frame != nullptr) {
+            return frame;
+        }
+        ALOGV("failed to extract frame with the previous decoder, recreating it.");
+    }
+
     return getFrameInternal(timeUs, option, colorFormat, metaOnly);
 }
 
@@ -317,7 +332,8 @@ sp<IMemory> StagefrightMetadataRetriever::getFrameAtIndex(
         int frameIndex, int colorFormat, bool metaOnly) {
     ALOGV("getFrameAtIndex: frameIndex %d, colorFormat: %d, metaOnly: %d",
             frameIndex, colorFormat, metaOnly);
-    if (mDecoder != NULL && frameIndex == mLastDecodedIndex + 1) {
+    if (mDecoder != NULL && mFrameOption == MediaSource::ReadOptions::SEEK_FRAME_INDEX
+            && frameIndex == mLastDecodedIndex + 1) {
         sp<IMemory> frame = mDecoder->extractFrame();
         if (frame != nullptr) {
             mLastDecodedIndex = frameIndex;
@@ -331,8 +347,7 @@ sp<IMemory> StagefrightMetadataRetriever::getFrameAtIndex(
 
 sp<IMemory> StagefrightMetadataRetriever::getFrameInternal(
         int64_t timeUs, int option, int colorFormat, bool metaOnly) {
-    mDecoder.clear();
-    mLastDecodedIndex = -1;
+    clearDecoder();
 
     if (mExtractor.get() == NULL) {
         ALOGE("no extractor.");
@@ -420,9 +435,12 @@ sp<IMemory> StagefrightMetadataRetriever::getFrameInternal(
         if (decoder->init(timeUs, option, colorFormat) == OK) {
             sp<IMemory> frame = decoder->extractFrame();
             if (frame != nullptr) {
-                // keep the decoder if seeking by frame index
+                // keep the decoder for the next frame, to be reused for sequential
+                // frame indices or for seeking to another time
+                mDecoder = decoder;
+                mFrameOption = option;
+                mFrameColorFormat = colorFormat;
                 if (option == MediaSource::ReadOptions::SEEK_FRAME_INDEX) {
-                    mDecoder = decoder;
                     mLastDecodedIndex = timeUs;
                 }
                 return frame;
@@ -788,4 +806,11 @@ void StagefrightMetadataRetriever::clearMetadata() {
     mAlbumArt = NULL;
 }
 
+void StagefrightMetadataRetriever::clearDecoder() {
+    mDecoder.clear();
+    mLastDecodedIndex = -1;
+    mFrameOption = -1;
+    mFrameColorFormat = -1;
+}
+
 }  // namespace android
@@ -63,10 +63,15 @@ private:
 
     sp<FrameDecoder> mDecoder;
     int mLastDecodedIndex;
+    // Seek option and color format of mDecoder if it is a video frame decoder, or -1.
+    int mFrameOption;
+    int mFrameColorFormat;
     void parseMetaData();
     void parseColorAspects(const sp<MetaData>& meta);
     // Delete album art and clear metadata.
     void clearMetadata();
+    // Release the decoder kept from the previous frame extraction.
+    void clearDecoder();
 
     sp<IMemory> getFrameInternal(
             int64_t timeUs, int option, int colorFormat, bool metaOnly);
@@ -52,6 +52,12 @@ static const int kInitialMarkMs        = 5000;  // 5secs
 //static const int kPausePlaybackMarkMs  = 2000;  // 2secs
 static const int kResumePlaybackMarkMs = 15000;  // 15secs
 
+// Local playback reads ahead up to this duration of each A/V track, and resumes reading
+// when less than half of it is left.
+static const int64_t kReadAheadDurationUs = 1000000LL;  // 1sec
+// Bounds the number of buffers read ahead, should the duration not progress.
+static const size_t kMaxReadAheadBuffers = 256;
+
 NuPlayer::GenericSource::GenericSource(
         const sp<AMessage> &notify,
         bool uidValid,
@@ -342,6 +348,8 @@ bool NuPlayer::GenericSource::isStreaming() const {
 
 NuPlayer::GenericSource::~GenericSource() {
     ALOGV("~GenericSource");
+    stopReader(&mAudioTrack);
+    stopReader(&mVideoTrack);
     if (mLooper != NULL) {
         mLooper->unregisterHandler(id());
         mLooper->stop();
@@ -359,6 +367,9 @@ void NuPlayer::GenericSource::prepareAsync() {
         mLooper->start();
 
         mLooper->registerHandler(this);
+
+        startReader(&mAudioTrack, "generic-audio");
+        startReader(&mVideoTrack, "generic-video");
     }
 
     sp<AMessage> msg = new AMessage(kWhatPrepareAsync, this);
@@ -664,14 +675,21 @@ void NuPlayer::GenericSource::onMessageReceived(const sp<AMessage> &msg) {
           }
 
 
-          if (track->mSource != NULL) {
-              track->mSource->stop();
+          {
+              // The reader of the track may be reading from the previous source.
+              mLock.unlock();
+              Mutex::Autolock readLock(track->mReadLock);
+              mLock.lock();
+
+              if (track->mSource != NULL) {
+                  track->mSource->stop();
+              }
+              track->mSource = source;
+              track->mSource->start();
+              track->mIndex = trackIndex;
+              ++mAudioDataGeneration;
+              ++mVideoDataGeneration;
           }
-          track->mSource = source;
-          track->mSource->start();
-          track->mIndex = trackIndex;
-          ++mAudioDataGeneration;
-          ++mVideoDataGeneration;
 
           int64_t timeUs, actualTimeUs;
           const bool formatChange = true;
@@ -695,12 +713,6 @@ void NuPlayer::GenericSource::onMessageReceived(const sp<AMessage> &msg) {
           break;
       }
 
-      case kWhatReadBuffer:
-      {
-          onReadBuffer(msg);
-          break;
-      }
-
       case kWhatPollBuffering:
       {
           int32_t generation;
@@ -867,7 +879,7 @@ status_t NuPlayer::GenericSource::dequeueAccessUnit(
     // start pulling in more buffers if cache is running low
     // so that decoder has less chance of being starved
     if (!mIsStreaming) {
-        if (track->mPackets->getAvailableBufferCount(&finalResult) < 2) {
+        if (needsReadAhead_l(track, kReadAheadDurationUs / 2)) {
             postReadBuffer(audio? MEDIA_TRACK_TYPE_AUDIO : MEDIA_TRACK_TYPE_VIDEO);
         }
     } else {
@@ -1129,9 +1141,9 @@ status_t NuPlayer::GenericSource::seekTo(int64_t seekTimeUs, MediaPlayerSeekMode
     msg->setInt64("seekTimeUs", seekTimeUs);
     msg->setInt32("mode", mode);
 
-    // Need to call readBuffer on |mLooper| to ensure the calls to
-    // IMediaSource::read* are serialized. Note that IMediaSource::read*
-    // is called without |mLock| acquired and MediaSource is not thread safe.
+    // Need to call readBuffer on |mLooper| to serialize the seek with track changes.
+    // IMediaSource::read* is called without |mLock| acquired and MediaSource is not
+    // thread safe, so reads of a track are serialized with its reader by mReadLock.
     sp<AMessage> response;
     status_t err = msg->postAndAwaitResponse(&response);
     if (err == OK && response != NULL) {
@@ -1309,21 +1321,72 @@ int32_t NuPlayer::GenericSource::getDataGeneration(media_track_type type) const
     return generation;
 }
 
+NuPlayer::GenericSource::Reader::Reader(const sp<GenericSource> &source)
+    : mSource(source) {
+}
+
+void NuPlayer::GenericSource::Reader::onMessageReceived(const sp<AMessage> &msg) {
+    CHECK_EQ(msg->what(), (uint32_t)kWhatReadBuffer);
+    sp<GenericSource> source = mSource.promote();
+    if (source != NULL) {
+        source->onReadBuffer(msg);
+    }
+}
+
+void NuPlayer::GenericSource::startReader(Track *track, const char *name) {
+    track->mReadLooper = new ALooper;
+    track->mReadLooper->setName(name);
+    track->mReadLooper->start();
+
+    track->mReader = new Reader(this);
+    track->mReadLooper->registerHandler(track->mReader);
+}
+
+void NuPlayer::GenericSource::stopReader(Track *track) {
+    if (track->mReadLooper != NULL) {
+        track->mReadLooper->unregisterHandler(track->mReader->id());
+        track->mReadLooper->stop();
+    }
+}
+
+bool NuPlayer::GenericSource::needsReadAhead_l(Track *track, int64_t durationUs) {
+    status_t finalResult;
+    size_t count = track->mPackets->getAvailableBufferCount(&finalResult);
+    if (finalResult != OK) {
+        return false;
+    }
+    if (count < 2) {
+        return true;
+    }
+    return count < kMaxReadAheadBuffers
+            && track->mPackets->getBufferedDurationUs(&finalResult) < durationUs;
+}
+
 void NuPlayer::GenericSource::postReadBuffer(media_track_type trackType) {
     if ((mPendingReadBufferTypes & (1 << trackType)) == 0) {
+        Track *track = (trackType == MEDIA_TRACK_TYPE_AUDIO) ? &mAudioTrack : &mVideoTrack;
         mPendingReadBufferTypes |= (1 << trackType);
-        sp<AMessage> msg = new AMessage(kWhatReadBuffer, this);
+        sp<AMessage> msg = new AMessage(kWhatReadBuffer, track->mReader);
         msg->setInt32("trackType", trackType);
         msg->post();
     }
 }
 
 void NuPlayer::GenericSource::onReadBuffer(const sp<AMessage>& msg) {
+    Mutex::Autolock _l(mLock);
     int32_t tmpType;
     CHECK(msg->findInt32("trackType", &tmpType));
     media_track_type trackType = (media_track_type)tmpType;
     mPendingReadBufferTypes &= ~(1 << trackType);
     readBuffer(trackType);
+
+    // Keep filling the track up to kReadAheadDurationUs, one batch of buffers at a time
+    // so that seeks and track changes on mLooper get in between.
+    Track *track = (trackType == MEDIA_TRACK_TYPE_AUDIO) ? &mAudioTrack : &mVideoTrack;
+    if (!mIsStreaming && track->mSource != NULL
+            && needsReadAhead_l(track, kReadAheadDurationUs)) {
+        postReadBuffer(trackType);
+    }
 }
 
 void NuPlayer::GenericSource::readBuffer(
@@ -1350,6 +1413,11 @@ void NuPlayer::GenericSource::readBuffer(
             TRESPASS();
     }
 
+    // The track may be read on its reader looper and on mLooper at the same time.
+    mLock.unlock();
+    Mutex::Autolock readLock(track->mReadLock);
+    mLock.lock();
+
     if (track->mSource == NULL) {
         return;
     }
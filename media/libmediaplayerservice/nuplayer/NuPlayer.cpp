@@ -1550,6 +1550,39 @@ status_t NuPlayer::onInstantiateSecureDecoders() {
     return OK;
 }
 
+void NuPlayer::precreateCodecs() {
+    // Allocating the codecs while the client has not started yet hides their creation
+    // from the start-up latency. This holds codec resources without playing, so it is
+    // opt-in.
+    if (!property_get_bool("media.stagefright.nuplayer.precreate-codecs", false)) {
+        return;
+    }
+    // Secure decoders are instantiated during prepare already, and protected content
+    // needs the crypto plugin to pick a codec.
+    if ((mSourceFlags & (Source::FLAG_SECURE | Source::FLAG_PROTECTED)) || mIsDrmProtected) {
+        return;
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        const bool audio = (i == 0);
+        sp<PrecreatedCodec> *codec = audio ? &mPrecreatedAudioCodec : &mPrecreatedVideoCodec;
+        if (*codec != NULL || (audio ? mAudioDecoder : mVideoDecoder) != NULL) {
+            continue;
+        }
+
+        sp<AMessage> format = mSource->getFormat(audio);
+        status_t err;
+        if (format == NULL || (format->findInt32("err", &err) && err)) {
+            continue;
+        }
+        AString mime;
+        if (!format->findString("mime", &mime)) {
+            continue;
+        }
+        *codec = new PrecreatedCodec(format, mPID, mUID);
+    }
+}
+
 void NuPlayer::onStart(int64_t startPositionUs, MediaPlayerSeekMode mode) {
     ALOGV("onStart: mCrypto: %p (%d)", mCrypto.get(),
             (mCrypto != NULL ? mCrypto->getStrongCount() : 0));
@@ -2001,17 +2034,27 @@ status_t NuPlayer::instantiateDecoder(
         } else {
             mSource->setOffloadAudio(false /* offload */);
 
-            *decoder = new Decoder(notify, mSource, mPID, mUID, mRenderer);
+            sp<Decoder> audioDecoder = new Decoder(notify, mSource, mPID, mUID, mRenderer);
+            if (mPrecreatedAudioCodec != NULL) {
+                audioDecoder->setPrecreatedCodec(mPrecreatedAudioCodec);
+            }
+            *decoder = audioDecoder;
             ALOGV("instantiateDecoder audio Decoder");
         }
+        mPrecreatedAudioCodec.clear();
         mAudioDecoderError = false;
     } else {
         sp<AMessage> notify = new AMessage(kWhatVideoNotify, this);
         ++mVideoDecoderGeneration;
         notify->setInt32("generation", mVideoDecoderGeneration);
 
-        *decoder = new Decoder(
+        sp<Decoder> videoDecoder = new Decoder(
                 notify, mSource, mPID, mUID, mRenderer, mSurface, mCCDecoder);
+        if (mPrecreatedVideoCodec != NULL) {
+            videoDecoder->setPrecreatedCodec(mPrecreatedVideoCodec);
+            mPrecreatedVideoCodec.clear();
+        }
+        *decoder = videoDecoder;
         mVideoDecoderError = false;
 
         // enable FRC if high-quality AV sync is requested, even if not
@@ -2411,6 +2454,9 @@ void NuPlayer::performReset() {
     mRenderer.clear();
     ++mRendererGeneration;
 
+    mPrecreatedAudioCodec.clear();
+    mPrecreatedVideoCodec.clear();
+
     if (mSource != NULL) {
         mSource->stop();
 
@@ -2552,6 +2598,7 @@ void NuPlayer::onSourceNotify(const sp<AMessage> &msg) {
                 processDeferredActions();
             } else {
                 mPrepared = true;
+                precreateCodecs();
             }
 
             sp<NuPlayerDriver> driver = mDriver.promote();
@@ -2962,6 +3009,7 @@ void NuPlayer::sendIMSRxNotice(const sp<AMessage> &msg) {
             int32_t highestSeqNum, baseSeqNum, prevExpected;
             int32_t numBufRecv, prevNumBufRecv;
             int32_t latestRtpTime, jbTimeMs, rtpRtcpSrTimeGapMs;
+            int32_t jbPeakMs, recoveredPackets, retransmissionDelayMs;
             int64_t recvTimeUs;
             CHECK(msg->findInt32("feedback-type", &feedbackType));
             CHECK(msg->findInt32("bit-rate", &bitrate));
@@ -2974,6 +3022,9 @@ void NuPlayer::sendIMSRxNotice(const sp<AMessage> &msg) {
             CHECK(msg->findInt64("recv-time-us", &recvTimeUs));
             CHECK(msg->findInt32("rtp-jitter-time-ms", &jbTimeMs));
             CHECK(msg->findInt32("rtp-rtcpsr-time-gap-ms", &rtpRtcpSrTimeGapMs));
+            CHECK(msg->findInt32("rtp-jitter-peak-ms", &jbPeakMs));
+            CHECK(msg->findInt32("rtp-recovered-packets", &recoveredPackets));
+            CHECK(msg->findInt32("rtp-retransmission-delay-ms", &retransmissionDelayMs));
             in.writeInt32(feedbackType);
             in.writeInt32(bitrate);
             in.writeInt32(highestSeqNum);
@@ -2986,6 +3037,9 @@ void NuPlayer::sendIMSRxNotice(const sp<AMessage> &msg) {
             in.writeInt32(recvTimeUs & 0xFFFFFFFF);
             in.writeInt32(jbTimeMs);
             in.writeInt32(rtpRtcpSrTimeGapMs);
+            in.writeInt32(jbPeakMs);
+            in.writeInt32(recoveredPackets);
+            in.writeInt32(retransmissionDelayMs);
             break;
         }
         case ARTPSource::RTP_CVO:
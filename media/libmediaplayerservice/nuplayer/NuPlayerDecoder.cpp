@@ -105,6 +105,51 @@ NuPlayer::Decoder::~Decoder() {
     releaseAndResetMediaBuffers();
 }
 
+NuPlayer::PrecreatedCodec::PrecreatedCodec(
+        const sp<AMessage> &format, pid_t pid, uid_t uid) {
+    CHECK(format->findString("mime", &mMime));
+
+    mLooper = new ALooper;
+    mLooper->setName("NPDecoder-CL");
+    mLooper->start(false, false, ANDROID_PRIORITY_AUDIO);
+
+    // MediaCodec::CreateByType() blocks until the component is allocated, and must not
+    // run on the codec looper itself.
+    sp<AMessage> codecFormat = format->dup();
+    mThread = std::thread([this, codecFormat, pid, uid] {
+        mCodec = MediaCodec::CreateByType(
+                mLooper, mMime.c_str(), false /* encoder */, NULL /* err */, pid, uid,
+                codecFormat);
+        ALOGV("precreated %s decoder: %p", mMime.c_str(), mCodec.get());
+    });
+}
+
+NuPlayer::PrecreatedCodec::~PrecreatedCodec() {
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    if (mCodec != NULL) {
+        ALOGV("releasing unused precreated %s decoder", mMime.c_str());
+        mCodec->release();
+        mCodec.clear();
+    }
+    mLooper->stop();
+}
+
+sp<MediaCodec> NuPlayer::PrecreatedCodec::take(sp<ALooper> *looper) {
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    *looper = mLooper;
+    sp<MediaCodec> codec = mCodec;
+    mCodec.clear();
+    return codec;
+}
+
+void NuPlayer::Decoder::setPrecreatedCodec(const sp<PrecreatedCodec> &codec) {
+    mPrecreatedCodec = codec;
+}
+
 sp<AMessage> NuPlayer::Decoder::getStats() {
 
     Mutex::Autolock autolock(mStatsLock);
@@ -300,10 +345,21 @@ void NuPlayer::Decoder::onConfigure(const sp<AMessage> &format) {
     mComponentName.append(" decoder");
     ALOGV("[%s] onConfigure (surface=%p)", mComponentName.c_str(), mSurface.get());
 
-    mCodec = MediaCodec::CreateByType(
-            mCodecLooper, mime.c_str(), false /* encoder */, NULL /* err */, mPid, mUid, format);
     int32_t secure = 0;
-    if (format->findInt32("secure", &secure) && secure != 0) {
+    format->findInt32("secure", &secure);
+    if (mPrecreatedCodec != NULL) {
+        if (!secure && !strcasecmp(mPrecreatedCodec->mime().c_str(), mime.c_str())) {
+            mCodec = mPrecreatedCodec->take(&mCodecLooper);
+            ALOGV("[%s] using precreated codec %p", mComponentName.c_str(), mCodec.get());
+        }
+        mPrecreatedCodec.clear();
+    }
+    if (mCodec == NULL) {
+        mCodec = MediaCodec::CreateByType(
+                mCodecLooper, mime.c_str(), false /* encoder */, NULL /* err */, mPid, mUid,
+                format);
+    }
+    if (secure != 0) {
         if (mCodec != NULL) {
             mCodec->getName(&mComponentName);
             mComponentName.append(".secure");
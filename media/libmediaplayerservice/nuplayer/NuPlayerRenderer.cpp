@@ -57,6 +57,9 @@ namespace android {
    #Set size of buffers for pcm audio sink in msec (example: 1000 msec)
    adb shell setprop media.stagefright.audio.sink 1000
 
+   #Queue up to this many video frames to the surface per wakeup (example: 4 frames)
+   adb shell setprop media.stagefright.video.render-ahead 4
+
  * These configurations take effect for the next track played (not the current track).
  */
 
@@ -69,6 +72,11 @@ static inline int32_t getAudioSinkPcmMsSetting() {
             "media.stagefright.audio.sink", 500 /* default_value */);
 }
 
+static inline int32_t getVideoRenderAheadFramesSetting() {
+    return property_get_int32(
+            "media.stagefright.video.render-ahead", 1 /* default_value */);
+}
+
 // Maximum time in paused state when offloading audio decompression. When elapsed, the AudioSink
 // is closed to allow the audio DSP to power down.
 static const int64_t kOffloadPauseMaxUs = 10000000LL;
@@ -82,6 +90,12 @@ static const int64_t kMaxAllowedAudioSinkDelayUs = 1500000LL;
 
 static const int64_t kMinimumAudioClockUpdatePeriodUs = 20 /* msec */ * 1000;
 
+// Audio queue drains are not deferred for less than this, 10 msec.
+static const int64_t kMinAudioQueueDrainDelayUs = 10000LL;
+
+// Video frames are not queued to the surface more than this ahead of their display time.
+static const int64_t kMaxVideoRenderAheadUs = 100000LL;
+
 // Default video frame display duration when only video exists.
 // Used to set max media time in MediaClock.
 static const int64_t kDefaultVideoFrameIntervalUs = 100000LL;
@@ -158,6 +172,7 @@ NuPlayer::Renderer::Renderer(
       mTotalBuffersQueued(0),
       mLastAudioBufferDrained(0),
       mUseAudioCallback(false),
+      mVideoRenderAheadFrames(std::max(getVideoRenderAheadFramesSetting(), 1)),
       mWakeLock(new AWakeLock()) {
     CHECK(mediaClock != NULL);
     mPlaybackRate = mPlaybackSettings.mSpeed;
@@ -1270,6 +1285,32 @@ int64_t NuPlayer::Renderer::getPendingAudioPlayoutDurationUs(int64_t nowUs) {
     return pendingUs;
 }
 
+// While the audio sink holds more than half of its buffer, the buffers queued by the
+// decoder are left in the audio queue, and written together once the sink gets down to
+// that level. This saves a wakeup and a short write per buffer in non-offloaded playback.
+int64_t NuPlayer::Renderer::getAudioQueueDrainDelayUs_l() {
+    if (mPaused || mUseVirtualAudioSink || offloadingAudio() || mNumFramesWritten == 0) {
+        return 0;
+    }
+    const int64_t bufferDurationUs = mAudioSink->getBufferDurationInUs();
+    if (bufferDurationUs <= 0) {
+        return 0;
+    }
+    // Keep filling the sink until it starts playing out, as it may wait for a full buffer.
+    const int64_t nowUs = ALooper::GetNowUs();
+    if (mAudioSink->getPlayedOutDurationUs(nowUs) <= 0) {
+        return 0;
+    }
+    int64_t delayUs = getPendingAudioPlayoutDurationUs(nowUs) - bufferDurationUs / 2;
+    if (delayUs < kMinAudioQueueDrainDelayUs) {
+        return 0;
+    }
+    if (mPlaybackRate > 1.0f) {
+        delayUs /= mPlaybackRate;
+    }
+    return delayUs;
+}
+
 int64_t NuPlayer::Renderer::getRealTimeUs(int64_t mediaTimeUs, int64_t nowUs) {
     int64_t realUs;
     if (mMediaClock->getRealTimeFor(mediaTimeUs, &realUs) != OK) {
@@ -1462,7 +1503,8 @@ void NuPlayer::Renderer::onDrainVideoQueue() {
     }
 
     // Always render the first video frame while keeping stats on A/V sync.
-    if (!mVideoSampleReceived) {
+    const bool firstFrame = !mVideoSampleReceived;
+    if (firstFrame) {
         realTimeUs = nowUs;
         tooLate = false;
     }
@@ -1475,6 +1517,10 @@ void NuPlayer::Renderer::onDrainVideoQueue() {
 
     mVideoSampleReceived = true;
 
+    if (!tooLate && !firstFrame) {
+        renderVideoFramesAhead(nowUs);
+    }
+
     if (!mPaused) {
         if (!mVideoRenderingStarted) {
             mVideoRenderingStarted = true;
@@ -1485,6 +1531,44 @@ void NuPlayer::Renderer::onDrainVideoQueue() {
     }
 }
 
+// Frames due shortly after the one just rendered are queued to the surface right away
+// with their display time, so that the renderer wakes up once for several frames.
+void NuPlayer::Renderer::renderVideoFramesAhead(int64_t nowUs) {
+    for (int32_t i = 1; i < mVideoRenderAheadFrames && !mPaused && !mVideoQueue.empty(); ++i) {
+        QueueEntry *entry = &*mVideoQueue.begin();
+        if (entry->mBuffer == NULL) {
+            break;
+        }
+
+        int64_t realTimeUs;
+        int64_t mediaTimeUs = -1;
+        if (mFlags & FLAG_REAL_TIME) {
+            CHECK(entry->mBuffer->meta()->findInt64("timeUs", &realTimeUs));
+        } else {
+            CHECK(entry->mBuffer->meta()->findInt64("timeUs", &mediaTimeUs));
+            if (mMediaClock->getRealTimeFor(mediaTimeUs, &realTimeUs) != OK) {
+                break;
+            }
+        }
+        realTimeUs = mVideoScheduler->schedule(realTimeUs * 1000) / 1000;
+        if (realTimeUs < nowUs || realTimeUs - nowUs > kMaxVideoRenderAheadUs) {
+            break;
+        }
+        ALOGV("rendering video %lld us ahead", (long long)(realTimeUs - nowUs));
+
+        if (!(mFlags & FLAG_REAL_TIME)
+                && mLastAudioMediaTimeUs != -1
+                && mediaTimeUs > mLastAudioMediaTimeUs) {
+            mMediaClock->updateMaxTimeMedia(mediaTimeUs + kDefaultVideoFrameIntervalUs);
+        }
+
+        entry->mNotifyConsumed->setInt64("timestampNs", realTimeUs * 1000LL);
+        entry->mNotifyConsumed->setInt32("render", true);
+        entry->mNotifyConsumed->post();
+        mVideoQueue.erase(mVideoQueue.begin());
+    }
+}
+
 void NuPlayer::Renderer::notifyVideoRenderingStart() {
     sp<AMessage> notify = mNotify->dup();
     notify->setInt32("what", kWhatVideoRenderingStart);
@@ -1575,7 +1659,7 @@ void NuPlayer::Renderer::onQueueBuffer(const sp<AMessage> &msg) {
     if (audio) {
         Mutex::Autolock autoLock(mLock);
         mAudioQueue.push_back(entry);
-        postDrainAudioQueue_l();
+        postDrainAudioQueue_l(getAudioQueueDrainDelayUs_l());
     } else {
         mVideoQueue.push_back(entry);
         postDrainVideoQueue();
@@ -125,6 +125,7 @@ void NuPlayer::RTPSource::prepareAsync() {
         mRTPConn->addStream(sockRtp, sockRtcp, desc, i + 1, notify, false);
         mRTPConn->setSelfID(info->mSelfID);
         mRTPConn->setStaticJitterTimeMs(info->mJbTimeMs);
+        mRTPConn->setAdaptiveJitterBuffer(info->mAdaptiveJb);
         mRTPConn->setRtpSockOptEcn(info->mRtpSockOptEcn);
         mRTPConn->setIsIPv6(info->mLocalIp);
 
@@ -679,6 +680,7 @@ status_t NuPlayer::RTPSource::setParameter(const String8 &key, const String8 &va
         mTracks.push(newTrackInfo);
         info = &mTracks.editTop();
         info->mJbTimeMs = kStaticJitterTimeMs;
+        info->mAdaptiveJb = false;
     }
 
     if (key == "rtp-param-mime-type") {
@@ -726,6 +728,8 @@ status_t NuPlayer::RTPSource::setParameter(const String8 &key, const String8 &va
     } else if (key == "rtp-param-jitter-buffer-time") {
         // clamping min at 40, max at 3000
         info->mJbTimeMs = std::min(std::max(40, atoi(value)), 3000);
+    } else if (key == "rtp-param-jitter-buffer-adaptive") {
+        info->mAdaptiveJb = atoi(value) != 0;
     }
 
     return OK;
@@ -118,10 +118,29 @@ private:
         kWhatSecureDecodersInstantiated,
     };
 
+    // Reads ahead the buffers of the audio or the video track on a looper of its own, so
+    // that a slow read of one track does not hold back the other.
+    struct Reader : public AHandler {
+        explicit Reader(const sp<GenericSource> &source);
+
+    protected:
+        virtual void onMessageReceived(const sp<AMessage> &msg);
+
+    private:
+        wp<GenericSource> mSource;
+
+        DISALLOW_EVIL_CONSTRUCTORS(Reader);
+    };
+
     struct Track {
         size_t mIndex;
         sp<IMediaSource> mSource;
         sp<AnotherPacketSource> mPackets;
+        // Serializes the reads of |mSource|, done by |mReader| and on mLooper. Always
+        // acquired before mLock.
+        Mutex mReadLock;
+        sp<ALooper> mReadLooper;
+        sp<Reader> mReader;
     };
 
     Vector<sp<IMediaSource> > mSources;
@@ -205,6 +224,9 @@ private:
             MediaBufferBase *mbuf,
             media_track_type trackType);
 
+    void startReader(Track *track, const char *name);
+    void stopReader(Track *track);
+    bool needsReadAhead_l(Track *track, int64_t durationUs);
     void postReadBuffer(media_track_type trackType);
     void onReadBuffer(const sp<AMessage>& msg);
     // When |mode| is MediaPlayerSeekMode::SEEK_CLOSEST, the buffer read shall
@@ -119,6 +119,7 @@ private:
     struct Decoder;
     struct DecoderBase;
     struct DecoderPassThrough;
+    struct PrecreatedCodec;
     struct CCDecoder;
     struct GenericSource;
     struct HTTPLiveSource;
@@ -182,6 +183,9 @@ private:
     sp<DecoderBase> mAudioDecoder;
     Mutex mDecoderLock;  // guard |mAudioDecoder| and |mVideoDecoder|.
     sp<CCDecoder> mCCDecoder;
+    // Codecs created once the source is prepared, for the decoders instantiated on start.
+    sp<PrecreatedCodec> mPrecreatedAudioCodec;
+    sp<PrecreatedCodec> mPrecreatedVideoCodec;
     sp<Renderer> mRenderer;
     sp<ALooper> mRendererLooper;
     int32_t mAudioDecoderGeneration;
@@ -296,6 +300,7 @@ private:
             bool audio, sp<DecoderBase> *decoder, bool checkAudioModeChange = true);
 
     status_t onInstantiateSecureDecoders();
+    void precreateCodecs();
 
     void updateVideoSize(
             const sp<AMessage> &inputFormat,
@@ -17,6 +17,8 @@
 #ifndef NUPLAYER_DECODER_H_
 #define NUPLAYER_DECODER_H_
 
+#include <thread>
+
 #include "NuPlayer.h"
 
 #include "NuPlayerDecoderBase.h"
@@ -25,6 +27,29 @@ namespace android {
 
 class MediaCodecBuffer;
 
+// A codec created on its own thread from the format of a prepared source, ahead of
+// the decoder that is going to use it.
+struct NuPlayer::PrecreatedCodec : public RefBase {
+    PrecreatedCodec(const sp<AMessage> &format, pid_t pid, uid_t uid);
+
+    const AString &mime() const { return mMime; }
+
+    // Waits for the creation to finish, and hands over the codec (NULL if the
+    // creation failed) and the looper it runs on.
+    sp<MediaCodec> take(sp<ALooper> *looper);
+
+protected:
+    virtual ~PrecreatedCodec();
+
+private:
+    AString mMime;
+    sp<ALooper> mLooper;
+    sp<MediaCodec> mCodec;
+    std::thread mThread;
+
+    DISALLOW_EVIL_CONSTRUCTORS(PrecreatedCodec);
+};
+
 struct NuPlayer::Decoder : public DecoderBase {
     Decoder(const sp<AMessage> &notify,
             const sp<Source> &source,
@@ -41,6 +66,10 @@ struct NuPlayer::Decoder : public DecoderBase {
 
     virtual status_t releaseCrypto();
 
+    // Uses |codec| instead of creating one in onConfigure() if it is for the same mime
+    // type. Must be called before configure().
+    void setPrecreatedCodec(const sp<PrecreatedCodec> &codec);
+
 protected:
     virtual ~Decoder();
 
@@ -77,6 +106,7 @@ private:
     sp<AMessage> mOutputFormat;
     sp<MediaCodec> mCodec;
     sp<ALooper> mCodecLooper;
+    sp<PrecreatedCodec> mPrecreatedCodec;
 
     List<sp<AMessage> > mPendingInputMessages;
 
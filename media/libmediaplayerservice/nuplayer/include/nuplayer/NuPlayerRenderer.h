@@ -225,6 +225,8 @@ private:
     int32_t mTotalBuffersQueued;
     int32_t mLastAudioBufferDrained;
     bool mUseAudioCallback;
+    // Number of video frames released per drain of the video queue, when due shortly.
+    const int32_t mVideoRenderAheadFrames;
 
     sp<AWakeLock> mWakeLock;
 
@@ -273,6 +275,7 @@ private:
     void drainAudioQueueUntilLastEOS();
     int64_t getPendingAudioPlayoutDurationUs(int64_t nowUs);
     void postDrainAudioQueue_l(int64_t delayUs = 0);
+    int64_t getAudioQueueDrainDelayUs_l();
 
     void clearAnchorTime();
     void clearAudioFirstAnchorTime_l();
@@ -283,6 +286,7 @@ private:
     int64_t getRealTimeUs(int64_t mediaTimeUs, int64_t nowUs);
 
     void onDrainVideoQueue();
+    void renderVideoFramesAhead(int64_t nowUs);
     void postDrainVideoQueue();
 
     void prepareForMediaRenderingStart_l();
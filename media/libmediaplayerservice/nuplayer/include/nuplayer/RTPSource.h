@@ -117,6 +117,8 @@ private:
 
         /* RTP jitter buffer time in milliseconds */
         uint32_t mJbTimeMs;
+        /* Sizes the jitter buffer from the measured jitter, up to mJbTimeMs */
+        bool mAdaptiveJb;
         /* Unique ID indicates itself */
         uint32_t mSelfID;
         /* extmap:<value> for CVO will be set to here */
@@ -76,6 +76,45 @@ ssize_t PipeReader::read(void *buffer, size_t count)
     return actual;
 }
 
+ssize_t PipeReader::obtain(Span spans[2], size_t count)
+{
+    if (CC_UNLIKELY(!mNegotiated)) {
+        return NEGOTIATE;
+    }
+    audio_utils_iovec iovec[2];
+    size_t lost;
+    ssize_t actual = mFifoReader.obtain(iovec, count, NULL /*timeout*/, &lost);
+    if (actual == -EOVERFLOW || lost > 0) {
+        mFramesOverrun += lost;
+        ++mOverruns;
+        return OVERRUN;
+    }
+    if (actual <= 0) {
+        return actual;
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        spans[i].mData = (const uint8_t *) mPipe.mBuffer + iovec[i].mOffset * mFrameSize;
+        spans[i].mFrames = iovec[i].mLength;
+    }
+    return actual;
+}
+
+ssize_t PipeReader::release(size_t count)
+{
+    // The obtained frames are intact unless the writer is now more than the pipe size
+    // ahead of the frames, which available() reports as lost.
+    size_t lost;
+    ssize_t avail = mFifoReader.available(&lost);
+    if (avail == -EOVERFLOW || lost > 0) {
+        mFramesOverrun += lost;
+        ++mOverruns;
+        return OVERRUN;
+    }
+    mFifoReader.release(count);
+    mFramesRead += count;
+    return count;
+}
+
 ssize_t PipeReader::flush()
 {
     if (CC_UNLIKELY(!mNegotiated)) {
@@ -51,6 +51,24 @@ public:
 
     // NBAIO_Source end
 
+    // Zero-copy access to the pipe buffer, for readers which would otherwise copy the
+    // data again, e.g. to a file or an analyzer.
+    struct Span {
+        const void *mData;
+        size_t      mFrames;
+    };
+
+    // Obtains up to count frames as at most two spans of the pipe buffer, without copying.
+    // The writer is not throttled, so the frames may be overwritten while they are obtained;
+    // release() tells whether that happened.
+    // Returns the number of frames obtained, 0 if none are available, OVERRUN, or NEGOTIATE.
+    ssize_t obtain(Span spans[2], size_t count);
+
+    // Releases count <= the number of frames last obtained, and counts them as read.
+    // Returns count, or OVERRUN if the writer overwrote any of the frames while they were
+    // obtained; they must then be discarded.
+    ssize_t release(size_t count);
+
 #if 0   // until necessary
     Pipe& pipe() const { return mPipe; }
 #endif
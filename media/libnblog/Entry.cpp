@@ -45,6 +45,17 @@ int Entry::copyEntryDataAt(size_t offset) const
     }
 }
 
+size_t Entry::copyTo(uint8_t *dst) const
+{
+    dst[offsetof(entry, type)] = mEvent;
+    dst[offsetof(entry, length)] = mLength;
+    if (mLength != 0) {
+        memcpy(dst + offsetof(entry, data), mData, mLength);
+    }
+    dst[offsetof(entry, data) + mLength + offsetof(ending, length)] = mLength;
+    return mLength + kOverhead;
+}
+
 EntryIterator::EntryIterator()   // Dummy initialization.
     : mPtr(nullptr)
 {
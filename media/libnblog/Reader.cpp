@@ -20,6 +20,7 @@
 #include <memory>
 #include <stddef.h>
 #include <string>
+#include <unistd.h>
 #include <unordered_set>
 
 #include <audio_utils/fifo.h>
@@ -229,6 +230,31 @@ const uint8_t *Reader::findLastValidEntry(const uint8_t *front, const uint8_t *b
 
 // TODO for future compatibility, would prefer to have a dump() go to string, and then go
 // to fd only when invoked through binder.
+void DumpReader::dumpBinaryHeader(int fd, size_t logCount)
+{
+    if (fd < 0) return;
+    ExportHeader header;
+    header.logCount = logCount;
+    (void)write(fd, &header, sizeof(header));
+}
+
+void DumpReader::dumpBinary(int fd)
+{
+    if (fd < 0) return;
+    std::unique_ptr<Snapshot> snapshot = getSnapshot(false /*flush*/);
+    ExportLogHeader header;
+    header.nameLength = name().size();
+    if (snapshot != nullptr) {
+        header.dataLength = snapshot->end() - snapshot->begin();
+        header.lost = snapshot->lost();
+    }
+    (void)write(fd, &header, sizeof(header));
+    (void)write(fd, name().data(), header.nameLength);
+    if (header.dataLength > 0) {
+        (void)write(fd, (const uint8_t *)snapshot->begin(), header.dataLength);
+    }
+}
+
 void DumpReader::dump(int fd, size_t indent)
 {
     if (fd < 0) return;
@@ -17,9 +17,11 @@
 #define LOG_TAG "NBLog"
 //#define LOG_NDEBUG 0
 
+#include <algorithm>
 #include <stdarg.h>
 #include <stddef.h>
 #include <sys/prctl.h>
+#include <unistd.h>
 
 #include <audio_utils/fifo.h>
 #include <binder/IMemory.h>
@@ -154,17 +156,9 @@ void Writer::log(const Entry &etr, bool trusted)
         log(etr.mEvent, etr.mData, etr.mLength);
         return;
     }
-    const size_t need = etr.mLength + Entry::kOverhead; // mEvent, mLength, data[mLength], mLength
-                                                        // need = number of bytes written to FIFO
-
-    // FIXME optimize this using memcpy for the data part of the Entry.
-    // The Entry could have a method copyTo(ptr, offset, size) to optimize the copy.
-    // checks size of a single log Entry: type, length, data pointer and ending
+    // format the Entry as mEvent, mLength, data[mLength], mLength
     uint8_t temp[Entry::kMaxLength + Entry::kOverhead];
-    // write this data to temp array
-    for (size_t i = 0; i < need; i++) {
-        temp[i] = etr.copyEntryDataAt(i);
-    }
+    const size_t need = etr.copyTo(temp);   // number of bytes written to FIFO
     // write to circular buffer
     mFifoWriter->write(temp, need);
 }
@@ -320,5 +314,54 @@ void LockedWriter::log(const Entry &entry, bool trusted) {
     Writer::log(entry, trusted);
 }
 
+// ---------------------------------------------------------------------------
+
+ShardedWriter::ShardedWriter(const std::vector<sp<IMemory>>& shared, size_t size)
+    : Writer(shared.empty() ? sp<IMemory>() : shared[0], size),
+      mBusy(new std::atomic_flag[std::max(shared.size(), (size_t)1)])
+{
+    for (size_t i = 1; i < shared.size(); ++i) {
+        mShards.emplace_back(new Writer(shared[i], size));
+    }
+    for (size_t i = 0; i < shardCount(); ++i) {
+        mBusy[i].clear();
+    }
+}
+
+bool ShardedWriter::setEnabled(bool enabled)
+{
+    for (const auto &shard : mShards) {
+        shard->setEnabled(enabled);
+    }
+    return Writer::setEnabled(enabled);
+}
+
+sp<IMemory> ShardedWriter::getShardIMemory(size_t shard) const
+{
+    if (shard == 0) {
+        return getIMemory();
+    }
+    return shard < shardCount() ? mShards[shard - 1]->getIMemory() : nullptr;
+}
+
+void ShardedWriter::log(const Entry &entry, bool trusted)
+{
+    if (!trusted) {
+        Writer::log(entry, trusted);    // validates the entry and logs it again as trusted
+        return;
+    }
+    const size_t shard = (size_t)gettid() % shardCount();
+    if (mBusy[shard].test_and_set(std::memory_order_acquire)) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (shard == 0) {
+        Writer::log(entry, trusted);
+    } else {
+        mShards[shard - 1]->log(entry, trusted);
+    }
+    mBusy[shard].clear(std::memory_order_release);
+}
+
 }   // namespace NBLog
 }   // namespace android
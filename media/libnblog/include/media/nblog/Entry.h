@@ -62,6 +62,10 @@ public:
     // [type][length][data ... ][length]
     int     copyEntryDataAt(size_t offset) const;
 
+    // copies the formatted Entry to dst, which must have room for mLength + kOverhead bytes.
+    // Returns the number of bytes copied.
+    size_t  copyTo(uint8_t *dst) const;
+
 private:
     friend class Writer;
     Event       mEvent;     // event type
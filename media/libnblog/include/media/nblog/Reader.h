@@ -107,6 +107,29 @@ private:
     EntryIterator         mEnd;
 };
 
+// Binary export of logs, parsed and merged offline by host tools.
+// The layout is that of a host and device with the same endianness, so that a host tool
+// can mmap the file and use the entries in place:
+//    ExportHeader
+//    for each of ExportHeader::logCount logs:
+//        ExportLogHeader
+//        name[ExportLogHeader::nameLength], not zero terminated
+//        entries[ExportLogHeader::dataLength], as laid out in shared memory, see Entry
+struct ExportHeader {
+    static constexpr uint32_t kMagic = 0x474c424e; // "NBLG"
+    static constexpr uint32_t kVersion = 1;
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t logCount = 0;
+    uint32_t reserved = 0;
+};
+
+struct ExportLogHeader {
+    uint32_t nameLength = 0;
+    uint32_t dataLength = 0;
+    uint64_t lost = 0;          // bytes lost by the reader, see Snapshot::lost()
+};
+
 // TODO move this to MediaLogService?
 class DumpReader : public NBLog::Reader {
 public:
@@ -115,6 +138,11 @@ public:
     DumpReader(const sp<IMemory>& iMemory, size_t size, const std::string &name)
         : Reader(iMemory, size, name) {}
     void dump(int fd, size_t indent = 0);
+
+    // Writes the ExportHeader for logCount logs, each then written by dumpBinary().
+    static void dumpBinaryHeader(int fd, size_t logCount);
+    // Writes the log in the binary export format, without consuming it.
+    void dumpBinary(int fd);
 private:
     void handleAuthor(const AbstractEntry& fmtEntry __unused, String8* body __unused) {}
     EntryIterator handleFormat(const FormatEntry &fmtEntry, String8 *timestamp, String8 *body);
@@ -17,8 +17,11 @@
 #ifndef ANDROID_MEDIA_NBLOG_WRITER_H
 #define ANDROID_MEDIA_NBLOG_WRITER_H
 
+#include <atomic>
+#include <memory>
 #include <stdarg.h>
 #include <stddef.h>
+#include <vector>
 
 #include <binder/IMemory.h>
 #include <media/nblog/Events.h>
@@ -113,6 +116,8 @@ private:
     // total tag length is mPidTagSize and process name is not zero terminated
     char   *mPidTag{};
     size_t  mPidTagSize = 0;
+
+    friend class ShardedWriter;     // for log(const Entry &, bool) of its shards
 };
 
 // ---------------------------------------------------------------------------
@@ -133,6 +138,40 @@ private:
     mutable Mutex   mLock;
 };
 
+// ---------------------------------------------------------------------------
+
+// Similar to LockedWriter, but a writing thread never blocks on another one.
+// The log is split into shards, each with its own shared memory, which are registered
+// as separate logs.  A thread always writes to the same shard, selected by its tid,
+// so a shard has a single writer unless there are more threads than shards.
+// A thread which finds its shard busy drops the entry and counts it, rather than
+// waiting for the other writer.
+// All entries are timestamped, so host tools merge the shards offline,
+// see DumpReader::dumpBinary().
+class ShardedWriter : public Writer {
+public:
+    ShardedWriter() = default;
+    // Each element of shared is the memory of one shard, of Timeline::sharedSize(size) bytes.
+    // The first shard is the one returned by getIMemory().
+    ShardedWriter(const std::vector<sp<IMemory>>& shared, size_t size);
+
+    bool    setEnabled(bool enabled) override;
+
+    size_t  shardCount() const { return mShards.size() + 1; }
+    sp<IMemory> getShardIMemory(size_t shard) const;
+
+    // entries dropped because the shard of the writing thread was busy
+    int64_t dropped() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    void log(const Entry &entry, bool trusted = false) override;
+
+    // the first shard is this Writer, the others are in mShards
+    std::vector<std::unique_ptr<Writer>> mShards;
+    std::unique_ptr<std::atomic_flag[]>  mBusy;     // shardCount() flags, set while writing
+    std::atomic<int64_t> mDropped{};
+};
+
 }   // namespace NBLog
 }   // namespace android
 
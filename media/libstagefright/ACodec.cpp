@@ -22,6 +22,7 @@
 #endif
 
 #include <inttypes.h>
+#include <mutex>
 #include <utils/Trace.h>
 
 #include <android/hardware/media/omx/1.0/IGraphicBufferSource.h>
@@ -134,6 +135,26 @@ static inline status_t makeNoSideEffectStatus(status_t err) {
     }
 }
 
+// The ashmem allocator service is shared by all codecs in the process, so that configuring a
+// codec does not look it up again for each port. It is looked up again after a transport error.
+static std::mutex sAshmemAllocatorLock;
+static sp<TAllocator> sAshmemAllocator;
+
+static sp<TAllocator> getAshmemAllocator() {
+    std::lock_guard<std::mutex> lock(sAshmemAllocatorLock);
+    if (sAshmemAllocator == nullptr) {
+        sAshmemAllocator = TAllocator::getService("ashmem");
+    }
+    return sAshmemAllocator;
+}
+
+static void invalidateAshmemAllocator(const sp<TAllocator> &allocator) {
+    std::lock_guard<std::mutex> lock(sAshmemAllocatorLock);
+    if (sAshmemAllocator == allocator) {
+        sAshmemAllocator.clear();
+    }
+}
+
 static OMX_VIDEO_CONTROLRATETYPE getVideoBitrateMode(const sp<AMessage> &msg) {
     int32_t tmp;
     if (msg->findInt32("bitrate-mode", &tmp)) {
@@ -939,7 +960,7 @@ status_t ACodec::allocateBuffersOnPort(OMX_U32 portIndex) {
             }
 
             if (mode != IOMX::kPortModePresetSecureBuffer) {
-                mAllocator[portIndex] = TAllocator::getService("ashmem");
+                mAllocator[portIndex] = getAshmemAllocator();
                 if (mAllocator[portIndex] == nullptr) {
                     ALOGE("hidl allocator on port %d is null",
                             (int)portIndex);
@@ -991,6 +1012,7 @@ status_t ACodec::allocateBuffersOnPort(OMX_U32 portIndex) {
                         ALOGE("hidl's AshmemAllocator failed at the "
                                 "transport: %s",
                                 transStatus.description().c_str());
+                        invalidateAshmemAllocator(mAllocator[portIndex]);
                         return NO_MEMORY;
                     }
                     if (!success) {
@@ -258,8 +258,13 @@ status_t ANetworkSession::Session::readMore() {
         CHECK_EQ(mMode, MODE_DATAGRAM);
 
         status_t err;
+        // Only allocate a new buffer once the previous one was handed off, so the
+        // final recvfrom() returning EAGAIN does not cost an allocation per wakeup.
+        sp<ABuffer> buf;
         do {
-            sp<ABuffer> buf = new ABuffer(kMaxUDPSize);
+            if (buf == NULL) {
+                buf = new ABuffer(kMaxUDPSize);
+            }
 
             struct sockaddr_in remoteAddr;
             socklen_t remoteAddrLen = sizeof(remoteAddr);
@@ -300,6 +305,7 @@ status_t ANetworkSession::Session::readMore() {
 
                 notify->setBuffer("data", buf);
                 notify->post();
+                buf.clear();
             }
         } while (err == OK);
 
@@ -1192,7 +1198,7 @@ status_t ANetworkSession::connectUDPSession(
 
 status_t ANetworkSession::sendRequest(
         int32_t sessionID, const void *data, ssize_t size,
-        bool timeValid, int64_t timeUs) {
+        bool timeValid, int64_t timeUs, bool flush) {
     Mutex::Autolock autoLock(mLock);
 
     ssize_t index = mSessions.indexOfKey(sessionID);
@@ -1205,7 +1211,9 @@ status_t ANetworkSession::sendRequest(
 
     status_t err = session->sendRequest(data, size, timeValid, timeUs);
 
-    interrupt();
+    if (flush) {
+        interrupt();
+    }
 
     return err;
 }
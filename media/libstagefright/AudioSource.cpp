@@ -187,6 +187,14 @@ void AudioSource::releaseQueuedFrames_l() {
     }
 }
 
+void AudioSource::releaseBufferPool_l() {
+    ALOGV("releaseBufferPool_l: %zu buffers", mBufferPool.size());
+    while (!mBufferPool.empty()) {
+        (*mBufferPool.begin())->release();
+        mBufferPool.erase(mBufferPool.begin());
+    }
+}
+
 void AudioSource::waitOutstandingEncodingFrames_l() {
     ALOGV("waitOutstandingEncodingFrames_l: %" PRId64, mNumClientOwnedBuffers);
     while (mNumClientOwnedBuffers > 0) {
@@ -212,6 +220,7 @@ status_t AudioSource::reset() {
     mRecord->stop();
     waitOutstandingEncodingFrames_l();
     releaseQueuedFrames_l();
+    releaseBufferPool_l();
 
     return OK;
 }
@@ -341,7 +350,13 @@ void AudioSource::signalBufferReturned(MediaBufferBase *buffer) {
     Mutex::Autolock autoLock(mLock);
     --mNumClientOwnedBuffers;
     buffer->setObserver(0);
-    buffer->release();
+    if (mBufferPool.size() < kMaxPooledBuffers) {
+        MediaBuffer *pooled = static_cast<MediaBuffer *>(buffer);
+        pooled->meta_data().clear();
+        mBufferPool.push_back(pooled);
+    } else {
+        buffer->release();
+    }
     mFrameEncodingCompletionCondition.signal();
     return;
 }
@@ -429,9 +444,8 @@ size_t AudioSource::onMoreData(const AudioRecord::Buffer& audioBuffer) {
         } else {
             numLostBytes = 0;
         }
-        MediaBuffer *lostAudioBuffer = new MediaBuffer(bufferSize);
+        MediaBuffer *lostAudioBuffer = acquireBuffer_l(bufferSize);
         memset(lostAudioBuffer->data(), 0, bufferSize);
-        lostAudioBuffer->set_range(0, bufferSize);
         mNumFramesLost += bufferSize / mRecord->frameSize();
         queueInputBuffer_l(lostAudioBuffer, timeUs);
     }
@@ -441,14 +455,30 @@ size_t AudioSource::onMoreData(const AudioRecord::Buffer& audioBuffer) {
         return audioBuffer.size();
     }
 
-    MediaBuffer *buffer = new MediaBuffer(audioBuffer.size());
+    MediaBuffer *buffer = acquireBuffer_l(audioBuffer.size());
     memcpy((uint8_t *) buffer->data(),
             audioBuffer.data(), audioBuffer.size());
-    buffer->set_range(0, audioBuffer.size());
     queueInputBuffer_l(buffer, timeUs);
     return audioBuffer.size();
 }
 
+MediaBuffer *AudioSource::acquireBuffer_l(size_t size) {
+    // AudioRecord callbacks are normally of the same size, so any pooled
+    // buffer that is large enough can be reused.
+    for (List<MediaBuffer *>::iterator it = mBufferPool.begin();
+            it != mBufferPool.end(); ++it) {
+        if ((*it)->size() >= size) {
+            MediaBuffer *buffer = *it;
+            mBufferPool.erase(it);
+            buffer->set_range(0, size);
+            return buffer;
+        }
+    }
+    MediaBuffer *buffer = new MediaBuffer(size);
+    buffer->set_range(0, size);
+    return buffer;
+}
+
 void AudioSource::queueInputBuffer_l(MediaBuffer *buffer, int64_t timeUs) {
     const size_t bufferSize = buffer->range_length();
     const size_t frameSize = mRecord->frameSize();
@@ -129,12 +129,16 @@ CameraSource::CameraSource(
       mEos(false),
       mNumFramesEncoded(0),
       mTimeBetweenFrameCaptureUs(0),
+      mNumFramesBeingEncoded(0),
+      mReaderWaiting(false),
       mFirstFrameTimeUs(0),
       mStopSystemTimeUs(-1),
       mNumFramesDropped(0),
+      mNumFramesDroppedNoMemoryBase(0),
       mNumGlitches(0),
       mGlitchDurationThresholdUs(200000),
-      mCollectStats(false) {
+      mCollectStats(false),
+      mMemoryBaseSize(0) {
     mVideoSize.width  = -1;
     mVideoSize.height = -1;
 
@@ -467,6 +471,10 @@ status_t CameraSource::init(
 void CameraSource::createVideoBufferMemoryHeap(size_t size, uint32_t bufferCount) {
     mMemoryHeapBase = new MemoryHeapBase(size * bufferCount, 0,
             "StageFright-CameraSource-BufferHeap");
+    mMemoryBaseSize = size;
+    mFramesBeingEncoded.clear();
+    mFramesBeingEncoded.resize(bufferCount);
+    mNumFramesBeingEncoded = 0;
     for (uint32_t i = 0; i < bufferCount; i++) {
         mMemoryBases.push_back(new MemoryBase(mMemoryHeapBase, i * size, size));
     }
@@ -773,12 +781,12 @@ status_t CameraSource::reset() {
             isTokenValid = true;
         }
         releaseQueuedFrames();
-        while (!mFramesBeingEncoded.empty()) {
+        while (mNumFramesBeingEncoded > 0) {
             if (NO_ERROR !=
                 mFrameCompleteCondition.waitRelative(mLock,
                         mTimeBetweenFrameCaptureUs * 1000LL + CAMERA_SOURCE_TIMEOUT_NS)) {
                 ALOGW("Timed out waiting for outstanding frames being encoded: %zu",
-                    mFramesBeingEncoded.size());
+                    mNumFramesBeingEncoded);
             }
         }
         stopCameraRecording();
@@ -792,6 +800,11 @@ status_t CameraSource::reset() {
                     mLastFrameTimestampUs - mFirstFrameTimeUs);
         }
 
+        if (mNumFramesDroppedNoMemoryBase > 0) {
+            ALOGW("%d camera frames dropped waiting for a free memory base",
+                    mNumFramesDroppedNoMemoryBase);
+        }
+
         if (mNumGlitches > 0) {
             ALOGW("%d long delays between neighboring video frames", mNumGlitches);
         }
@@ -861,22 +874,36 @@ void CameraSource::releaseOneRecordingFrame(const sp<IMemory>& frame) {
     releaseRecordingFrame(frame);
 }
 
+ssize_t CameraSource::frameSlot_l(const void *data) const {
+    if (mMemoryHeapBase == nullptr || mMemoryBaseSize == 0) {
+        return -1;
+    }
+    const uint8_t *base = (const uint8_t *)mMemoryHeapBase->getBase();
+    const uint8_t *ptr = (const uint8_t *)data;
+    if (ptr < base) {
+        return -1;
+    }
+    size_t offset = ptr - base;
+    if (offset % mMemoryBaseSize != 0 ||
+            offset / mMemoryBaseSize >= mFramesBeingEncoded.size()) {
+        return -1;
+    }
+    return offset / mMemoryBaseSize;
+}
+
 void CameraSource::signalBufferReturned(MediaBufferBase *buffer) {
     ALOGV("signalBufferReturned: %p", buffer->data());
     Mutex::Autolock autoLock(mLock);
-    for (List<sp<IMemory> >::iterator it = mFramesBeingEncoded.begin();
-         it != mFramesBeingEncoded.end(); ++it) {
-        if ((*it)->unsecurePointer() ==  buffer->data()) {
-            releaseOneRecordingFrame((*it));
-            mFramesBeingEncoded.erase(it);
-            ++mNumFramesEncoded;
-            buffer->setObserver(0);
-            buffer->release();
-            mFrameCompleteCondition.signal();
-            return;
-        }
-    }
-    CHECK(!"signalBufferReturned: bogus buffer");
+    ssize_t slot = frameSlot_l(buffer->data());
+    CHECK(slot >= 0 && mFramesBeingEncoded[slot] != nullptr);
+
+    releaseOneRecordingFrame(mFramesBeingEncoded[slot]);
+    mFramesBeingEncoded[slot].clear();
+    --mNumFramesBeingEncoded;
+    ++mNumFramesEncoded;
+    buffer->setObserver(0);
+    buffer->release();
+    mFrameCompleteCondition.signal();
 }
 
 status_t CameraSource::read(
@@ -897,9 +924,11 @@ status_t CameraSource::read(
     {
         Mutex::Autolock autoLock(mLock);
         while (mStarted && !mEos && mFramesReceived.empty()) {
-            if (NO_ERROR !=
-                mFrameAvailableCondition.waitRelative(mLock,
-                    mTimeBetweenFrameCaptureUs * 1000LL + CAMERA_SOURCE_TIMEOUT_NS)) {
+            mReaderWaiting = true;
+            status_t err = mFrameAvailableCondition.waitRelative(mLock,
+                    mTimeBetweenFrameCaptureUs * 1000LL + CAMERA_SOURCE_TIMEOUT_NS);
+            mReaderWaiting = false;
+            if (NO_ERROR != err) {
                 if (mCameraRecordingProxy != 0 &&
                     !IInterface::asBinder(mCameraRecordingProxy)->isBinderAlive()) {
                     ALOGW("camera recording proxy is gone");
@@ -920,7 +949,10 @@ status_t CameraSource::read(
 
         frameTime = *mFrameTimes.begin();
         mFrameTimes.erase(mFrameTimes.begin());
-        mFramesBeingEncoded.push_back(frame);
+        ssize_t slot = frameSlot_l(frame->unsecurePointer());
+        CHECK(slot >= 0 && mFramesBeingEncoded[slot] == nullptr);
+        mFramesBeingEncoded[slot] = frame;
+        ++mNumFramesBeingEncoded;
         // TODO: Using unsecurePointer() has some associated security pitfalls
         //       (see declaration for details).
         //       Either document why it is safe in this case or address the
@@ -1043,20 +1075,27 @@ bool CameraSource::BufferQueueListener::threadLoop() {
 }
 
 void CameraSource::processBufferQueueFrame(BufferItem& buffer) {
+    if (!queueBufferQueueFrame(buffer)) {
+        // Hand the buffer back to the camera without holding mLock, so that
+        // read() and signalBufferReturned() are not held up by it.
+        mVideoBufferConsumer->releaseBuffer(buffer);
+    }
+}
+
+bool CameraSource::queueBufferQueueFrame(BufferItem& buffer) {
     Mutex::Autolock autoLock(mLock);
 
     int64_t timestampUs = buffer.mTimestamp / 1000;
     if (shouldSkipFrameLocked(timestampUs)) {
-        mVideoBufferConsumer->releaseBuffer(buffer);
-        return;
+        return false;
     }
 
     while (mMemoryBases.empty()) {
         if (mMemoryBaseAvailableCond.waitRelative(mLock, kMemoryBaseAvailableTimeoutNs) ==
                 TIMED_OUT) {
             ALOGW("Waiting on an available memory base timed out. Dropping a recording frame.");
-            mVideoBufferConsumer->releaseBuffer(buffer);
-            return;
+            ++mNumFramesDroppedNoMemoryBase;
+            return false;
         }
     }
 
@@ -1086,7 +1125,10 @@ void CameraSource::processBufferQueueFrame(BufferItem& buffer) {
     mFrameTimes.push_back(timeUs);
     ALOGV("initial delay: %" PRId64 ", current time stamp: %" PRId64,
         mStartTimeUs, timeUs);
-    mFrameAvailableCondition.signal();
+    if (mReaderWaiting) {
+        mFrameAvailableCondition.signal();
+    }
+    return true;
 }
 
 MetadataBufferType CameraSource::metaDataStoredInVideoBuffers() const {
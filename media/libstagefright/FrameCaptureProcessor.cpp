@@ -28,6 +28,11 @@
 
 namespace android {
 
+struct FrameCaptureProcessor::CaptureBatch : public RefBase {
+    std::vector<CaptureRequest> mRequests;
+    std::vector<sp<Fence>> mFences;
+};
+
 //static
 Mutex FrameCaptureProcessor::sLock;
 //static
@@ -116,6 +121,20 @@ status_t FrameCaptureProcessor::capture(
     return PostAndAwaitResponse(msg, &response);
 }
 
+status_t FrameCaptureProcessor::captureBatch(
+        const std::vector<CaptureRequest> &requests, std::vector<sp<Fence>> *fences) {
+    sp<CaptureBatch> batch = new CaptureBatch;
+    batch->mRequests = requests;
+    sp<AMessage> msg = new AMessage(kWhatCaptureBatch, this);
+    msg->setObject("batch", batch);
+    sp<AMessage> response;
+    status_t err = PostAndAwaitResponse(msg, &response);
+    if (err == OK) {
+        *fences = std::move(batch->mFences);
+    }
+    return err;
+}
+
 status_t FrameCaptureProcessor::onCreate() {
     mRE = renderengine::RenderEngine::create(
             renderengine::RenderEngineCreationArgs::Builder()
@@ -133,8 +152,9 @@ status_t FrameCaptureProcessor::onCreate() {
     return OK;
 }
 
-status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
-        const Rect &sourceCrop, const sp<GraphicBuffer> &buffer) {
+status_t FrameCaptureProcessor::drawLayer(const sp<Layer> &layer,
+        const Rect &sourceCrop, const sp<GraphicBuffer> &buffer,
+        bool useFramebufferCache, sp<Fence> *fence) {
     renderengine::DisplaySettings clientCompositionDisplay;
     std::vector<const renderengine::LayerSettings*> clientCompositionLayers;
 
@@ -158,13 +178,21 @@ status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
     base::unique_fd drawFence;
     mRE->useProtectedContext(false);
     status_t err = mRE->drawLayers(clientCompositionDisplay, clientCompositionLayers, buffer.get(),
-            /*useFramebufferCache=*/false, std::move(bufferFence), &drawFence);
+            useFramebufferCache, std::move(bufferFence), &drawFence);
 
-    sp<Fence> fence = new Fence(std::move(drawFence));
+    *fence = new Fence(std::move(drawFence));
 
     if (err != OK) {
         ALOGE("drawLayers returned err %d", err);
-    } else {
+    }
+    return err;
+}
+
+status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
+        const Rect &sourceCrop, const sp<GraphicBuffer> &buffer) {
+    sp<Fence> fence;
+    status_t err = drawLayer(layer, sourceCrop, buffer, false /*useFramebufferCache*/, &fence);
+    if (err == OK) {
         err = fence->wait(500);
         if (err != OK) {
             ALOGW("wait for fence returned err %d", err);
@@ -175,6 +203,39 @@ status_t FrameCaptureProcessor::onCapture(const sp<Layer> &layer,
     return err;
 }
 
+status_t FrameCaptureProcessor::onCaptureBatch(const sp<CaptureBatch> &batch) {
+    for (const CaptureRequest &request : batch->mRequests) {
+        sp<Fence> fence;
+        status_t err = drawLayer(request.layer, request.sourceCrop, request.outBuffer,
+                true /*useFramebufferCache*/, &fence);
+        if (err != OK) {
+            // The caller may release the layers on error, wait for the ones drawn so far.
+            mCleanupFence = batch->mFences.empty() ? nullptr : batch->mFences.back();
+            onCleanup();
+            batch->mFences.clear();
+            return err;
+        }
+        batch->mFences.push_back(fence);
+    }
+
+    // Release the GL resources once the last capture is drawn, without holding up
+    // the caller.
+    mCleanupFence = batch->mFences.empty() ? nullptr : batch->mFences.back();
+    (new AMessage(kWhatCleanup, this))->post();
+    return OK;
+}
+
+void FrameCaptureProcessor::onCleanup() {
+    if (mCleanupFence != nullptr) {
+        status_t err = mCleanupFence->wait(500);
+        if (err != OK) {
+            ALOGW("wait for fence returned err %d", err);
+        }
+        mCleanupFence.clear();
+    }
+    mRE->cleanupPostRender(renderengine::RenderEngine::CleanupMode::CLEAN_ALL);
+}
+
 void FrameCaptureProcessor::onMessageReceived(const sp<AMessage> &msg) {
     switch (msg->what()) {
         case kWhatCreate:
@@ -206,6 +267,23 @@ void FrameCaptureProcessor::onMessageReceived(const sp<AMessage> &msg) {
 
             break;
         }
+        case kWhatCaptureBatch:
+        {
+            sp<AReplyToken> replyID;
+            CHECK(msg->senderAwaitsResponse(&replyID));
+
+            sp<RefBase> batchObj;
+            CHECK(msg->findObject("batch", &batchObj));
+            sp<CaptureBatch> batch = static_cast<CaptureBatch*>(batchObj.get());
+
+            PostReplyWithError(replyID, onCaptureBatch(batch));
+            break;
+        }
+        case kWhatCleanup:
+        {
+            onCleanup();
+            break;
+        }
         default:
             TRESPASS();
     }
@@ -20,6 +20,7 @@
 #include "include/FrameDecoder.h"
 #include "include/FrameCaptureLayer.h"
 #include "include/HevcUtils.h"
+#include <algorithm>
 #include <binder/MemoryBase.h>
 #include <binder/MemoryHeapBase.h>
 #include <gui/Surface.h>
@@ -351,6 +352,71 @@ sp<IMemory> FrameDecoder::extractFrame(FrameRect *rect) {
     return mFrameMemory;
 }
 
+sp<IMemory> FrameDecoder::extractFrameAtTime(int64_t frameTimeUs) {
+    if (mDecoder == NULL) {
+        ALOGE("decoder is not initialized");
+        return NULL;
+    }
+    status_t err = onSeek(frameTimeUs, &mReadOptions);
+    if (err != OK) {
+        return NULL;
+    }
+    // Drop what is left of the previous extraction, including a queued EOS.
+    err = mDecoder->flush();
+    if (err != OK) {
+        ALOGW("flush returned error %d (%s)", err, asString(err));
+        return NULL;
+    }
+    mHaveMoreInputs = true;
+    mFirstSample = true;
+    mFrameMemory.clear();
+
+    err = extractInternal();
+    if (err != OK) {
+        return NULL;
+    }
+
+    return mFrameMemory;
+}
+
+status_t FrameDecoder::extractFrames(
+        const std::vector<int64_t> &frameTimesUs, std::vector<sp<IMemory>> *frames) {
+    if (mDecoder == NULL) {
+        ALOGE("decoder is not initialized");
+        return NO_INIT;
+    }
+    std::vector<size_t> order(frameTimesUs.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&frameTimesUs](size_t a, size_t b) {
+        return frameTimesUs[a] < frameTimesUs[b];
+    });
+
+    frames->assign(frameTimesUs.size(), sp<IMemory>());
+    bool extractedAny = false;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (i > 0 && frameTimesUs[order[i]] == frameTimesUs[order[i - 1]]) {
+            (*frames)[order[i]] = (*frames)[order[i - 1]];
+            continue;
+        }
+        sp<IMemory> frame = extractFrameAtTime(frameTimesUs[order[i]]);
+        if (frame == NULL) {
+            ALOGW("failed to extract frame at %" PRId64 " us", frameTimesUs[order[i]]);
+        } else {
+            extractedAny = true;
+        }
+        (*frames)[order[i]] = frame;
+    }
+
+    return (extractedAny || frameTimesUs.empty()) ? OK : UNKNOWN_ERROR;
+}
+
+status_t FrameDecoder::onSeek(
+        int64_t /*frameTimeUs*/, MediaSource::ReadOptions * /*options*/) {
+    return ERROR_UNSUPPORTED;
+}
+
 status_t FrameDecoder::extractInternal() {
     status_t err = OK;
     bool done = false;
@@ -524,16 +590,7 @@ sp<AMessage> VideoFrameDecoder::onGetFormatAndSeekOptions(
     mIsAvc = !strcasecmp(mime, MEDIA_MIMETYPE_VIDEO_AVC);
     mIsHevc = !strcasecmp(mime, MEDIA_MIMETYPE_VIDEO_HEVC);
 
-    if (frameTimeUs < 0) {
-        int64_t thumbNailTime = -1ll;
-        if (!trackMeta()->findInt64(kKeyThumbnailTime, &thumbNailTime)
-                || thumbNailTime < 0) {
-            thumbNailTime = 0;
-        }
-        options->setSeekTo(thumbNailTime, mSeekMode);
-    } else {
-        options->setSeekTo(frameTimeUs, mSeekMode);
-    }
+    setSeekTo(frameTimeUs, options);
 
     sp<AMessage> videoFormat;
     if (convertMetaDataToMessage(trackMeta(), &videoFormat) != OK) {
@@ -577,6 +634,31 @@ sp<AMessage> VideoFrameDecoder::onGetFormatAndSeekOptions(
     return videoFormat;
 }
 
+void VideoFrameDecoder::setSeekTo(
+        int64_t frameTimeUs, MediaSource::ReadOptions *options) {
+    if (frameTimeUs < 0) {
+        int64_t thumbNailTime = -1ll;
+        if (!trackMeta()->findInt64(kKeyThumbnailTime, &thumbNailTime)
+                || thumbNailTime < 0) {
+            thumbNailTime = 0;
+        }
+        options->setSeekTo(thumbNailTime, mSeekMode);
+    } else {
+        options->setSeekTo(frameTimeUs, mSeekMode);
+    }
+}
+
+status_t VideoFrameDecoder::onSeek(
+        int64_t frameTimeUs, MediaSource::ReadOptions *options) {
+    setSeekTo(frameTimeUs, options);
+
+    // Each extraction returns its own frame, as the caller may still hold the previous one.
+    mFrame = NULL;
+    mTargetTimeUs = -1LL;
+    mSampleDurations.clear();
+    return OK;
+}
+
 status_t VideoFrameDecoder::onInputReceived(
         const sp<MediaCodecBuffer> &codecBuffer,
         MetaDataBase &sampleMeta, bool firstSample, uint32_t *flags) {
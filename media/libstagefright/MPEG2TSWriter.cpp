@@ -443,6 +443,8 @@ bool MPEG2TSWriter::SourceInfo::eosReceived() const {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static const size_t kFileBufferSize = 64 * 1024;
+
 MPEG2TSWriter::MPEG2TSWriter(int fd)
     : mFile(fdopen(dup(fd), "wb")),
       mWriteCookie(NULL),
@@ -474,6 +476,12 @@ MPEG2TSWriter::MPEG2TSWriter(
 void MPEG2TSWriter::init() {
     CHECK(mFile != NULL || mWriteFunc != NULL);
 
+    if (mFile != NULL) {
+        // Access units are written with a single fwrite() each; use a buffer large enough
+        // that the small ones and the program tables do not each cost a write() call.
+        setvbuf(mFile, NULL, _IOFBF, kFileBufferSize);
+    }
+
     initCrcTable();
 
     mLooper = new ALooper;
@@ -826,9 +834,6 @@ void MPEG2TSWriter::writeAccessUnit(
     // reserved = b1
     // the first fragment of "buffer" follows
 
-    sp<ABuffer> buffer = new ABuffer(188);
-    memset(buffer->data(), 0xff, buffer->size());
-
     const unsigned PID = 0x1e0 + sourceIndex + 1;
 
     const unsigned continuity_counter =
@@ -855,7 +860,20 @@ void MPEG2TSWriter::writeAccessUnit(
         PES_packet_length = 0;
     }
 
-    uint8_t *ptr = buffer->data();
+    // All the TS packets of the access unit are assembled in mPacketBuffer and handed
+    // to internalWrite() at once.
+    size_t numPackets = 1;
+    if (accessUnit->size() > 188 - 18) {
+        numPackets += (accessUnit->size() - (188 - 18) + 183) / 184;
+    }
+    if (mPacketBuffer == NULL || mPacketBuffer->capacity() < numPackets * 188) {
+        mPacketBuffer = new ABuffer(numPackets * 188);
+    }
+    mPacketBuffer->setRange(0, numPackets * 188);
+    memset(mPacketBuffer->data(), 0xff, mPacketBuffer->size());
+
+    uint8_t *packet = mPacketBuffer->data();
+    uint8_t *ptr = packet;
     *ptr++ = 0x47;
     *ptr++ = 0x40 | (PID >> 8);
     *ptr++ = PID & 0xff;
@@ -883,7 +901,7 @@ void MPEG2TSWriter::writeAccessUnit(
     *ptr++ = (PTS >> 7) & 0xff;
     *ptr++ = ((PTS & 0x7f) << 1) | 1;
 
-    size_t sizeLeft = buffer->data() + buffer->size() - ptr;
+    size_t sizeLeft = packet + 188 - ptr;
     size_t copy = accessUnit->size();
     if (copy > sizeLeft) {
         copy = sizeLeft;
@@ -891,8 +909,6 @@ void MPEG2TSWriter::writeAccessUnit(
 
     memcpy(ptr, accessUnit->data(), copy);
 
-    CHECK_EQ(internalWrite(buffer->data(), buffer->size()), (ssize_t)buffer->size());
-
     size_t offset = copy;
     while (offset < accessUnit->size()) {
         bool lastAccessUnit = ((accessUnit->size() - offset) < 184);
@@ -907,12 +923,11 @@ void MPEG2TSWriter::writeAccessUnit(
         // continuity_counter = b????
         // the fragment of "buffer" follows.
 
-        memset(buffer->data(), 0xff, buffer->size());
-
         const unsigned continuity_counter =
             mSources.editItemAt(sourceIndex)->incrementContinuityCounter();
 
-        ptr = buffer->data();
+        packet += 188;
+        ptr = packet;
         *ptr++ = 0x47;
         *ptr++ = 0x00 | (PID >> 8);
         *ptr++ = PID & 0xff;
@@ -929,18 +944,20 @@ void MPEG2TSWriter::writeAccessUnit(
             }
         }
 
-        size_t sizeLeft = buffer->data() + buffer->size() - ptr;
+        size_t sizeLeft = packet + 188 - ptr;
         size_t copy = accessUnit->size() - offset;
         if (copy > sizeLeft) {
             copy = sizeLeft;
         }
 
         memcpy(ptr, accessUnit->data() + offset, copy);
-        CHECK_EQ(internalWrite(buffer->data(), buffer->size()),
-                 (ssize_t)buffer->size());
 
         offset += copy;
     }
+    CHECK_EQ(packet + 188, mPacketBuffer->data() + mPacketBuffer->size());
+
+    CHECK_EQ(internalWrite(mPacketBuffer->data(), mPacketBuffer->size()),
+             (ssize_t)mPacketBuffer->size());
 }
 
 void MPEG2TSWriter::writeTS() {
@@ -535,6 +535,7 @@ void MPEG4Writer::initInternal(int fd, bool isFirstSession) {
     mWriterThreadStarted = false;
     mSendNotify = false;
     mWriteSeekErr = false;
+    mBatchWrites = false;
     mFallocateErr = false;
     // Reset following variables for all the sessions and they will be
     // initialized in start(MetaData *param).
@@ -1770,8 +1771,42 @@ void MPEG4Writer::writeOrPostError(int fd, const void* buf, size_t count) {
     if (mWriteSeekErr == true)
         return;
 
+    if (mBatchWrites && fd == mFd) {
+        if (mBatchedWrites.size() == kMaxBatchedWrites) {
+            flushBatchedWrites();
+        }
+        if (count <= sizeof(mBatchedBytes[0])) {
+            uint8_t *copy = mBatchedBytes[mBatchedWrites.size()];
+            memcpy(copy, buf, count);
+            buf = copy;
+        }
+        mBatchedWrites.push_back({const_cast<void *>(buf), count});
+        return;
+    }
+
     auto beforeTP = std::chrono::high_resolution_clock::now();
     ssize_t bytesWritten = ::write(fd, buf, count);
+    onWriteDone(beforeTP, bytesWritten, count);
+}
+
+void MPEG4Writer::flushBatchedWrites() {
+    if (mBatchedWrites.empty()) {
+        return;
+    }
+    if (mWriteSeekErr == false) {
+        size_t count = 0;
+        for (const struct iovec &iov : mBatchedWrites) {
+            count += iov.iov_len;
+        }
+        auto beforeTP = std::chrono::high_resolution_clock::now();
+        ssize_t bytesWritten = ::writev(mFd, mBatchedWrites.data(), mBatchedWrites.size());
+        onWriteDone(beforeTP, bytesWritten, count);
+    }
+    mBatchedWrites.clear();
+}
+
+void MPEG4Writer::onWriteDone(std::chrono::high_resolution_clock::time_point beforeTP,
+                              ssize_t bytesWritten, size_t count) {
     auto afterTP = std::chrono::high_resolution_clock::now();
     auto writeDuration =
             std::chrono::duration_cast<std::chrono::microseconds>(afterTP - beforeTP).count();
@@ -1797,6 +1832,10 @@ void MPEG4Writer::writeOrPostError(int fd, const void* buf, size_t count) {
 }
 
 void MPEG4Writer::seekOrPostError(int fd, off64_t offset, int whence) {
+    if (fd == mFd) {
+        // The batched writes go before the new position.
+        flushBatchedWrites();
+    }
     if (mWriteSeekErr == true)
         return;
     off64_t resOffset = lseek64(fd, offset, whence);
@@ -2775,6 +2814,10 @@ void MPEG4Writer::writeChunkToFile(Chunk* chunk) {
     ALOGV("writeChunkToFile: %" PRId64 " from %s track",
         chunk->mTimeStampUs, chunk->mTrack->getTrackType());
 
+    // The samples are released once their batched writes are done.
+    std::vector<MediaBuffer *> writtenSamples;
+    mBatchWrites = true;
+
     int32_t isFirstSample = true;
     while (!chunk->mSamples.empty()) {
         List<MediaBuffer *>::iterator it = chunk->mSamples.begin();
@@ -2797,11 +2840,17 @@ void MPEG4Writer::writeChunkToFile(Chunk* chunk) {
             isFirstSample = false;
         }
 
-        (*it)->release();
+        writtenSamples.push_back(*it);
         (*it) = NULL;
         chunk->mSamples.erase(it);
     }
     chunk->mSamples.clear();
+
+    flushBatchedWrites();
+    mBatchWrites = false;
+    for (MediaBuffer *sample : writtenSamples) {
+        sample->release();
+    }
 }
 
 void MPEG4Writer::writeAllChunks() {
@@ -3669,18 +3718,24 @@ status_t MPEG4Writer::Track::threadEntry() {
         ++nActualFrames;
 
         // Make a deep copy of the MediaBuffer and Metadata and release
-        // the original as soon as we can
-        MediaBuffer *copy = new MediaBuffer(buffer->range_length());
-        if (sampleFileOffset != -1) {
-            copy->meta_data().setInt64(kKeySampleFileOffset, sampleFileOffset);
+        // the original as soon as we can, unless the source lets us keep it.
+        MediaBuffer *copy;
+        int32_t canBeHeld = false;
+        meta_data = new MetaData(buffer->meta_data());
+        if (sampleFileOffset == -1 && !isExif
+                && buffer->meta_data().findInt32(kKeyBufferCanBeHeld, &canBeHeld) && canBeHeld) {
+            copy = static_cast<MediaBuffer *>(buffer);
         } else {
-            memcpy(copy->data(), (uint8_t*)buffer->data() + buffer->range_offset(),
-                   buffer->range_length());
+            copy = new MediaBuffer(buffer->range_length());
+            if (sampleFileOffset != -1) {
+                copy->meta_data().setInt64(kKeySampleFileOffset, sampleFileOffset);
+            } else {
+                memcpy(copy->data(), (uint8_t*)buffer->data() + buffer->range_offset(),
+                       buffer->range_length());
+            }
+            copy->set_range(0, buffer->range_length());
+            buffer->release();
         }
-        copy->set_range(0, buffer->range_length());
-
-        meta_data = new MetaData(buffer->meta_data());
-        buffer->release();
         buffer = NULL;
         if (isExif) {
             copy->meta_data().setInt32(kKeyExifTiffOffset, tiffHdrOffset);
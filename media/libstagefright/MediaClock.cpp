@@ -42,6 +42,12 @@ MediaClock::MediaClock()
       mMaxTimeMediaUs(INT64_MAX),
       mStartingTimeMediaUs(-1),
       mPlaybackRate(1.0),
+      mAnchorSeq(0),
+      mPublishedAnchorTimeMediaUs(-1),
+      mPublishedAnchorTimeRealUs(-1),
+      mPublishedMaxTimeMediaUs(INT64_MAX),
+      mPublishedStartingTimeMediaUs(-1),
+      mPublishedPlaybackRate(1.0),
       mGeneration(0) {
     mLooper = new ALooper;
     mLooper->setName("MediaClock");
@@ -73,12 +79,14 @@ void MediaClock::reset() {
     mMaxTimeMediaUs = INT64_MAX;
     mStartingTimeMediaUs = -1;
     updateAnchorTimesAndPlaybackRate_l(-1, -1, 1.0);
+    publishAnchorState_l();
     ++mGeneration;
 }
 
 void MediaClock::setStartingTimeMedia(int64_t startingTimeMediaUs) {
     Mutex::Autolock autoLock(mLock);
     mStartingTimeMediaUs = startingTimeMediaUs;
+    publishAnchorState_l();
 }
 
 void MediaClock::clearAnchor() {
@@ -104,8 +112,9 @@ void MediaClock::updateAnchor(
         return;
     }
 
-    if (maxTimeMediaUs != -1) {
+    if (maxTimeMediaUs != -1 && maxTimeMediaUs != mMaxTimeMediaUs) {
         mMaxTimeMediaUs = maxTimeMediaUs;
+        publishAnchorState_l();
     }
     if (mAnchorTimeRealUs != -1) {
         int64_t oldNowMediaUs =
@@ -128,6 +137,7 @@ void MediaClock::updateAnchor(
 void MediaClock::updateMaxTimeMedia(int64_t maxTimeMediaUs) {
     Mutex::Autolock autoLock(mLock);
     mMaxTimeMediaUs = maxTimeMediaUs;
+    publishAnchorState_l();
 }
 
 void MediaClock::setPlaybackRate(float rate) {
@@ -135,6 +145,7 @@ void MediaClock::setPlaybackRate(float rate) {
     Mutex::Autolock autoLock(mLock);
     if (mAnchorTimeRealUs == -1) {
         mPlaybackRate = rate;
+        publishAnchorState_l();
         return;
     }
 
@@ -153,8 +164,7 @@ void MediaClock::setPlaybackRate(float rate) {
 }
 
 float MediaClock::getPlaybackRate() const {
-    Mutex::Autolock autoLock(mLock);
-    return mPlaybackRate;
+    return mPublishedPlaybackRate.load(std::memory_order_relaxed);
 }
 
 status_t MediaClock::getMediaTime(
@@ -163,23 +173,25 @@ status_t MediaClock::getMediaTime(
         return BAD_VALUE;
     }
 
-    Mutex::Autolock autoLock(mLock);
-    return getMediaTime_l(realUs, outMediaUs, allowPastMaxTime);
+    AnchorState state;
+    readAnchorState(&state);
+    return GetMediaTime(state, realUs, outMediaUs, allowPastMaxTime);
 }
 
-status_t MediaClock::getMediaTime_l(
-        int64_t realUs, int64_t *outMediaUs, bool allowPastMaxTime) const {
-    if (mAnchorTimeRealUs == -1) {
+// static
+status_t MediaClock::GetMediaTime(
+        const AnchorState &state, int64_t realUs, int64_t *outMediaUs, bool allowPastMaxTime) {
+    if (state.mAnchorTimeRealUs == -1) {
         return NO_INIT;
     }
 
-    int64_t mediaUs = mAnchorTimeMediaUs
-            + (realUs - mAnchorTimeRealUs) * (double)mPlaybackRate;
-    if (mediaUs > mMaxTimeMediaUs && !allowPastMaxTime) {
-        mediaUs = mMaxTimeMediaUs;
+    int64_t mediaUs = state.mAnchorTimeMediaUs
+            + (realUs - state.mAnchorTimeRealUs) * (double)state.mPlaybackRate;
+    if (mediaUs > state.mMaxTimeMediaUs && !allowPastMaxTime) {
+        mediaUs = state.mMaxTimeMediaUs;
     }
-    if (mediaUs < mStartingTimeMediaUs) {
-        mediaUs = mStartingTimeMediaUs;
+    if (mediaUs < state.mStartingTimeMediaUs) {
+        mediaUs = state.mStartingTimeMediaUs;
     }
     if (mediaUs < 0) {
         mediaUs = 0;
@@ -188,28 +200,78 @@ status_t MediaClock::getMediaTime_l(
     return OK;
 }
 
+status_t MediaClock::getMediaTime_l(
+        int64_t realUs, int64_t *outMediaUs, bool allowPastMaxTime) const {
+    const AnchorState state = {
+        mAnchorTimeMediaUs,
+        mAnchorTimeRealUs,
+        mMaxTimeMediaUs,
+        mStartingTimeMediaUs,
+        mPlaybackRate,
+    };
+    return GetMediaTime(state, realUs, outMediaUs, allowPastMaxTime);
+}
+
 status_t MediaClock::getRealTimeFor(
         int64_t targetMediaUs, int64_t *outRealUs) const {
     if (outRealUs == NULL) {
         return BAD_VALUE;
     }
 
-    Mutex::Autolock autoLock(mLock);
-    if (mPlaybackRate == 0.0) {
+    AnchorState state;
+    readAnchorState(&state);
+    if (state.mPlaybackRate == 0.0) {
         return NO_INIT;
     }
 
     int64_t nowUs = ALooper::GetNowUs();
     int64_t nowMediaUs;
     status_t status =
-            getMediaTime_l(nowUs, &nowMediaUs, true /* allowPastMaxTime */);
+            GetMediaTime(state, nowUs, &nowMediaUs, true /* allowPastMaxTime */);
     if (status != OK) {
         return status;
     }
-    *outRealUs = (targetMediaUs - nowMediaUs) / (double)mPlaybackRate + nowUs;
+    *outRealUs = (targetMediaUs - nowMediaUs) / (double)state.mPlaybackRate + nowUs;
     return OK;
 }
 
+void MediaClock::publishAnchorState_l() {
+    const uint32_t seq = mAnchorSeq.load(std::memory_order_relaxed);
+    mAnchorSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    mPublishedAnchorTimeMediaUs.store(mAnchorTimeMediaUs, std::memory_order_relaxed);
+    mPublishedAnchorTimeRealUs.store(mAnchorTimeRealUs, std::memory_order_relaxed);
+    mPublishedMaxTimeMediaUs.store(mMaxTimeMediaUs, std::memory_order_relaxed);
+    mPublishedStartingTimeMediaUs.store(mStartingTimeMediaUs, std::memory_order_relaxed);
+    mPublishedPlaybackRate.store(mPlaybackRate, std::memory_order_relaxed);
+
+    mAnchorSeq.store(seq + 2, std::memory_order_release);
+}
+
+void MediaClock::readAnchorState(AnchorState *state) const {
+    for (;;) {
+        const uint32_t seq = mAnchorSeq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            // An update is in progress; it only copies a few words.
+            continue;
+        }
+
+        state->mAnchorTimeMediaUs =
+                mPublishedAnchorTimeMediaUs.load(std::memory_order_relaxed);
+        state->mAnchorTimeRealUs = mPublishedAnchorTimeRealUs.load(std::memory_order_relaxed);
+        state->mMaxTimeMediaUs = mPublishedMaxTimeMediaUs.load(std::memory_order_relaxed);
+        state->mStartingTimeMediaUs =
+                mPublishedStartingTimeMediaUs.load(std::memory_order_relaxed);
+        state->mPlaybackRate = mPublishedPlaybackRate.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (mAnchorSeq.load(std::memory_order_relaxed) == seq) {
+            return;
+        }
+    }
+}
+
 void MediaClock::addTimer(const sp<AMessage> &notify, int64_t mediaTimeUs,
                           int64_t adjustRealUs) {
     Mutex::Autolock autoLock(mLock);
@@ -320,6 +382,7 @@ void MediaClock::updateAnchorTimesAndPlaybackRate_l(int64_t anchorTimeMediaUs,
         mAnchorTimeMediaUs = anchorTimeMediaUs;
         mAnchorTimeRealUs = anchorTimeRealUs;
         mPlaybackRate = playbackRate;
+        publishAnchorState_l();
         notifyDiscontinuity_l();
     }
 }
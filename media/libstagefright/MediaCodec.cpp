@@ -19,6 +19,7 @@
 #define LOG_TAG "MediaCodec"
 #include <utils/Log.h>
 
+#include <algorithm>
 #include <dlfcn.h>
 #include <inttypes.h>
 #include <random>
@@ -3000,6 +3001,57 @@ status_t MediaCodec::queueInputBuffer(
     return PostAndAwaitResponse(msg, &response);
 }
 
+status_t MediaCodec::queueInputBuffers(
+        const std::vector<InputBufferInfo> &buffers,
+        size_t *numQueued,
+        AString *errorDetailMsg) {
+    // Keeps each request well within the item limit of an AMessage.
+    constexpr size_t kMaxBuffersPerMessage = 64;
+
+    if (numQueued != NULL) {
+        *numQueued = 0;
+    }
+    if (errorDetailMsg != NULL) {
+        errorDetailMsg->clear();
+    }
+
+    size_t total = 0;
+    while (total < buffers.size()) {
+        const size_t count = std::min(buffers.size() - total, kMaxBuffersPerMessage);
+
+        // Each buffer is described by the same message as for queueInputBuffer(), so
+        // that the looper can handle it the same way, including as a leftover.
+        sp<AMessage> msg = new AMessage(kWhatQueueInputBuffers, this);
+        msg->setSize("count", count);
+        for (size_t i = 0; i < count; ++i) {
+            const InputBufferInfo &info = buffers[total + i];
+            sp<AMessage> buffer = new AMessage(kWhatQueueInputBuffer, this);
+            buffer->setSize("index", info.mIndex);
+            buffer->setSize("offset", info.mOffset);
+            buffer->setSize("size", info.mSize);
+            buffer->setInt64("timeUs", info.mPresentationTimeUs);
+            buffer->setInt32("flags", info.mFlags);
+            buffer->setPointer("errorDetailMsg", errorDetailMsg);
+            msg->setMessage(AStringPrintf("buffer-%zu", i).c_str(), buffer);
+        }
+
+        sp<AMessage> response;
+        status_t err = PostAndAwaitResponse(msg, &response);
+        size_t queued = 0;
+        if (response != NULL) {
+            response->findSize("queued", &queued);
+        }
+        total += queued;
+        if (numQueued != NULL) {
+            *numQueued = total;
+        }
+        if (err != OK) {
+            return err;
+        }
+    }
+    return OK;
+}
+
 status_t MediaCodec::queueSecureInputBuffer(
         size_t index,
         size_t offset,
@@ -5028,6 +5080,51 @@ void MediaCodec::onMessageReceived(const sp<AMessage> &msg) {
             break;
         }
 
+        case kWhatQueueInputBuffers:
+        {
+            sp<AReplyToken> replyID;
+            CHECK(msg->senderAwaitsResponse(&replyID));
+
+            if (!isExecuting()) {
+                mErrorLog.log(LOG_TAG, base::StringPrintf(
+                        "queueInputBuffers() is valid only at Executing states; currently %s",
+                        apiStateString().c_str()));
+                PostReplyWithError(replyID, INVALID_OPERATION);
+                break;
+            } else if (mFlags & kFlagStickyError) {
+                PostReplyWithError(replyID, getStickyError());
+                break;
+            }
+
+            size_t count;
+            CHECK(msg->findSize("count", &count));
+            status_t err = OK;
+            size_t queued = 0;
+            while (queued < count) {
+                sp<AMessage> buffer;
+                CHECK(msg->findMessage(
+                        AStringPrintf("buffer-%zu", queued).c_str(), &buffer));
+                if (!mLeftover.empty()) {
+                    mLeftover.push_back(buffer);
+                    size_t index;
+                    buffer->findSize("index", &index);
+                    err = handleLeftover(index);
+                } else {
+                    err = onQueueInputBuffer(buffer);
+                }
+                if (err != OK) {
+                    break;
+                }
+                ++queued;
+            }
+
+            sp<AMessage> response = new AMessage;
+            response->setInt32("err", mReleasedByResourceManager ? DEAD_OBJECT : err);
+            response->setSize("queued", queued);
+            response->postReply(replyID);
+            break;
+        }
+
         case kWhatDequeueOutputBuffer:
         {
             sp<AReplyToken> replyID;
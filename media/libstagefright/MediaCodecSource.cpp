@@ -467,6 +467,7 @@ MediaCodecSource::MediaCodecSource(
       mSetEncoderFormat(false),
       mEncoderFormat(0),
       mEncoderDataSpace(0),
+      mInputDataSpace(HAL_DATASPACE_UNKNOWN),
       mPersistentSurface(persistentSurface),
       mInputBufferTimeOffsetUs(0),
       mFirstSampleSystemTimeUs(-1LL),
@@ -764,7 +765,8 @@ status_t MediaCodecSource::feedEncoderInputBuffers() {
             if (mIsVideo) {
                 int32_t ds = 0;
                 if (mbuf->meta_data().findInt32(kKeyColorSpace, &ds)
-                        && ds != HAL_DATASPACE_UNKNOWN) {
+                        && ds != HAL_DATASPACE_UNKNOWN && ds != mInputDataSpace) {
+                    mInputDataSpace = ds;
                     android_dataspace dataspace = static_cast<android_dataspace>(ds);
                     ColorUtils::convertDataSpaceToV0(dataspace);
                     ALOGD("Updating dataspace to %x", dataspace);
@@ -1010,6 +1012,9 @@ void MediaCodecSource::onMessageReceived(const sp<AMessage> &msg) {
             if (flags & MediaCodec::BUFFER_FLAG_SYNCFRAME) {
                 mbuf->meta_data().setInt32(kKeyIsSyncFrame, true);
             }
+            // The buffer is only freed when returned, so writers can keep it instead of
+            // copying it.
+            mbuf->meta_data().setInt32(kKeyBufferCanBeHeld, true);
             memcpy(mbuf->data(), outbuf->data(), outbuf->size());
 
             {
@@ -128,6 +128,87 @@ std::shared_ptr<std::list<sp<ExtractorPlugin>>> MediaExtractorFactory::gPlugins;
 bool MediaExtractorFactory::gPluginsRegistered = false;
 bool MediaExtractorFactory::gIgnoreVersion = false;
 
+// All the sniffers read the same few places of the source, the start and for some
+// formats the end. Read those once and serve the sniffers from memory, rather than
+// have each sniffer go to the source, which is often across binder.
+class SniffCacheSource : public DataSource {
+public:
+    explicit SniffCacheSource(const sp<DataSource> &source)
+        : mSource(source),
+          mHeadSize(-1),
+          mTailOffset(-1),
+          mTailSize(0) {
+    }
+
+    virtual status_t initCheck() const {
+        return mSource->initCheck();
+    }
+
+    virtual ssize_t readAt(off64_t offset, void *data, size_t size) {
+        if (offset >= 0 && offset + size <= kHeadSize) {
+            if (mHeadSize < 0) {
+                mHeadSize = mSource->readAt(0, mHead, kHeadSize);
+            }
+            if (mHeadSize > 0 && offset + size <= (size_t)mHeadSize) {
+                memcpy(data, &mHead[offset], size);
+                return size;
+            }
+        } else if (offset >= (off64_t)kHeadSize && fillTail()
+                && offset >= mTailOffset && offset + size <= mTailOffset + mTailSize) {
+            memcpy(data, &mTail[offset - mTailOffset], size);
+            return size;
+        }
+        return mSource->readAt(offset, data, size);
+    }
+
+    virtual status_t getSize(off64_t *size) {
+        return mSource->getSize(size);
+    }
+
+    virtual uint32_t flags() {
+        return mSource->flags();
+    }
+
+    virtual String8 toString() {
+        return mSource->toString();
+    }
+
+    virtual String8 getUri() {
+        return mSource->getUri();
+    }
+
+    virtual String8 getMIMEType() const {
+        return mSource->getMIMEType();
+    }
+
+private:
+    static const size_t kHeadSize = 64 * 1024;
+    static const size_t kTailSize = 16 * 1024;
+
+    sp<DataSource> mSource;
+    uint8_t mHead[kHeadSize];
+    ssize_t mHeadSize;
+    uint8_t mTail[kTailSize];
+    off64_t mTailOffset;
+    size_t mTailSize;
+
+    // Returns whether the end of the source is cached.
+    bool fillTail() {
+        if (mTailOffset < 0) {
+            off64_t size;
+            mTailOffset = 0;
+            if (mSource->getSize(&size) == OK && size >= (off64_t)(kHeadSize + kTailSize)) {
+                ssize_t n = mSource->readAt(size - kTailSize, mTail, kTailSize);
+                if (n == (ssize_t)kTailSize) {
+                    mTailOffset = size - kTailSize;
+                    mTailSize = kTailSize;
+                }
+            }
+        }
+        return mTailSize > 0;
+    }
+};
+
 // static
 void *MediaExtractorFactory::sniff(
         const sp<DataSource> &source, float *confidence, void **meta,
@@ -144,6 +225,8 @@ void *MediaExtractorFactory::sniff(
         plugins = gPlugins;
     }
 
+    sp<DataSource> sniffSource = new SniffCacheSource(source);
+
     void *bestCreator = NULL;
     for (auto it = plugins->begin(); it != plugins->end(); ++it) {
         ALOGV("sniffing %s", (*it)->def.extractor_name);
@@ -154,10 +237,10 @@ void *MediaExtractorFactory::sniff(
         void *curCreator = NULL;
         if ((*it)->def.def_version == EXTRACTORDEF_VERSION_NDK_V1) {
             curCreator = (void*) (*it)->def.u.v2.sniff(
-                    source->wrap(), &newConfidence, &newMeta, &newFreeMeta);
+                    sniffSource->wrap(), &newConfidence, &newMeta, &newFreeMeta);
         } else if ((*it)->def.def_version == EXTRACTORDEF_VERSION_NDK_V2) {
             curCreator = (void*) (*it)->def.u.v3.sniff(
-                    source->wrap(), &newConfidence, &newMeta, &newFreeMeta);
+                    sniffSource->wrap(), &newConfidence, &newMeta, &newFreeMeta);
         }
 
         if (curCreator) {
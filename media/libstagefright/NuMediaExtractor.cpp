@@ -38,8 +38,149 @@
 #include <media/stagefright/Utils.h>
 #include <media/stagefright/FoundationUtils.h>
 
+#include <cutils/properties.h>
+
+#include <thread>
+
 namespace android {
 
+// Reads the samples of a selected track ahead of the client on a thread of its own, and
+// keeps up to |depth| of them queued. The prefetcher starts out paused; the source is only
+// read by the prefetch thread while it is resumed.
+struct NuMediaExtractor::SamplePrefetcher : public RefBase {
+    SamplePrefetcher(
+            const sp<IMediaSource> &source, size_t trackIndex, size_t maxFetchCount,
+            size_t depth);
+
+    void resume();
+
+    // Stops reading ahead and discards the queued samples. When this returns, the source
+    // is not being read by the prefetch thread.
+    void pause();
+
+    // Waits until samples are queued or the track has ended, and appends the queued samples
+    // to |samples|. Returns the final result of the track once its last sample is taken.
+    status_t dequeue(std::list<Sample> *samples);
+
+    void quit();
+
+protected:
+    virtual ~SamplePrefetcher();
+
+private:
+    const sp<IMediaSource> mSource;
+    const size_t mTrackIndex;
+    const size_t mMaxFetchCount;
+    const size_t mDepth;
+
+    Mutex mLock;
+    Condition mCondition;
+    bool mPaused;
+    bool mQuit;
+    bool mReading;
+    status_t mFinalResult;
+    std::list<Sample> mSamples;
+    std::thread mThread;
+
+    void threadLoop();
+    void releaseSamples_l();
+
+    DISALLOW_EVIL_CONSTRUCTORS(SamplePrefetcher);
+};
+
+NuMediaExtractor::SamplePrefetcher::SamplePrefetcher(
+        const sp<IMediaSource> &source, size_t trackIndex, size_t maxFetchCount, size_t depth)
+    : mSource(source),
+      mTrackIndex(trackIndex),
+      mMaxFetchCount(maxFetchCount),
+      mDepth(depth),
+      mPaused(true),
+      mQuit(false),
+      mReading(false),
+      mFinalResult(OK) {
+    mThread = std::thread(&SamplePrefetcher::threadLoop, this);
+}
+
+NuMediaExtractor::SamplePrefetcher::~SamplePrefetcher() {
+    quit();
+}
+
+void NuMediaExtractor::SamplePrefetcher::resume() {
+    Mutex::Autolock autoLock(mLock);
+    mPaused = false;
+    mCondition.broadcast();
+}
+
+void NuMediaExtractor::SamplePrefetcher::pause() {
+    Mutex::Autolock autoLock(mLock);
+    mPaused = true;
+    while (mReading) {
+        mCondition.wait(mLock);
+    }
+    releaseSamples_l();
+    mFinalResult = OK;
+}
+
+status_t NuMediaExtractor::SamplePrefetcher::dequeue(std::list<Sample> *samples) {
+    Mutex::Autolock autoLock(mLock);
+    CHECK(!mPaused);
+    while (mSamples.empty() && mFinalResult == OK) {
+        mCondition.wait(mLock);
+    }
+    samples->splice(samples->end(), mSamples);
+    mCondition.broadcast();
+    return mFinalResult;
+}
+
+void NuMediaExtractor::SamplePrefetcher::quit() {
+    {
+        Mutex::Autolock autoLock(mLock);
+        mQuit = true;
+        mCondition.broadcast();
+    }
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+    Mutex::Autolock autoLock(mLock);
+    releaseSamples_l();
+}
+
+void NuMediaExtractor::SamplePrefetcher::releaseSamples_l() {
+    for (auto it = mSamples.begin(); it != mSamples.end(); it = mSamples.erase(it)) {
+        if (it->mBuffer != NULL) {
+            it->mBuffer->release();
+        }
+    }
+}
+
+void NuMediaExtractor::SamplePrefetcher::threadLoop() {
+    Mutex::Autolock autoLock(mLock);
+    while (!mQuit) {
+        if (mPaused || mFinalResult != OK || mSamples.size() >= mDepth) {
+            mCondition.wait(mLock);
+            continue;
+        }
+
+        mReading = true;
+        mLock.unlock();
+        MediaSource::ReadOptions options;
+        std::list<Sample> samples;
+        status_t err = readTrackSamples(
+                mSource, mTrackIndex, mMaxFetchCount, &options, &samples);
+        mLock.lock();
+        mReading = false;
+
+        mSamples.splice(mSamples.end(), samples);
+        mFinalResult = err;
+        if (mPaused) {
+            // Paused for a seek while reading; the samples are from before the seek.
+            releaseSamples_l();
+            mFinalResult = OK;
+        }
+        mCondition.broadcast();
+    }
+}
+
 NuMediaExtractor::Sample::Sample()
     : mBuffer(NULL),
       mSampleTimeUs(-1LL) {
@@ -53,7 +194,8 @@ NuMediaExtractor::Sample::Sample(MediaBufferBase *buffer, int64_t timeUs)
 NuMediaExtractor::NuMediaExtractor(EntryPoint entryPoint)
     : mEntryPoint(entryPoint),
       mTotalBitrate(-1LL),
-      mDurationUs(-1LL) {
+      mDurationUs(-1LL),
+      mPrefetchDepth(property_get_int32("media.stagefright.extractor.prefetch-depth", 0)) {
 }
 
 NuMediaExtractor::~NuMediaExtractor() {
@@ -62,6 +204,9 @@ NuMediaExtractor::~NuMediaExtractor() {
     for (size_t i = 0; i < mSelectedTracks.size(); ++i) {
         TrackInfo *info = &mSelectedTracks.editItemAt(i);
 
+        if (info->mPrefetcher != NULL) {
+            info->mPrefetcher->quit();
+        }
         status_t err = info->mSource->stop();
         ALOGE_IF(err != OK, "error %d stopping track %zu", err, i);
     }
@@ -162,6 +307,11 @@ status_t NuMediaExtractor::setDataSource(const sp<DataSource> &source) {
     return initMediaExtractor(source);
 }
 
+void NuMediaExtractor::setPrefetchDepth(size_t depth) {
+    Mutex::Autolock autoLock(mLock);
+    mPrefetchDepth = depth;
+}
+
 const char* NuMediaExtractor::getName() const {
     Mutex::Autolock autoLock(mLock);
     return mImpl == nullptr ? nullptr : mName.string();
@@ -421,14 +571,22 @@ status_t NuMediaExtractor::selectTrack(size_t index,
     }
     info->mFinalResult = OK;
     releaseTrackSamples(info);
+    info->mPrefetcher.clear();
     info->mTrackFlags = 0;
 
     if (!strcasecmp(mime, MEDIA_MIMETYPE_AUDIO_VORBIS)) {
         info->mTrackFlags |= kIsVorbis;
     }
 
+    if (mPrefetchDepth > 0) {
+        info->mPrefetcher = new SamplePrefetcher(
+                source, index, info->mMaxFetchCount, mPrefetchDepth);
+    }
+
     if (startTimeUs >= 0) {
         fetchTrackSamples(info, startTimeUs, mode);
+    } else if (info->mPrefetcher != NULL) {
+        info->mPrefetcher->resume();
     }
 
     return OK;
@@ -463,6 +621,9 @@ status_t NuMediaExtractor::unselectTrack(size_t index) {
 
     releaseTrackSamples(info);
 
+    if (info->mPrefetcher != NULL) {
+        info->mPrefetcher->quit();
+    }
     CHECK_EQ((status_t)OK, info->mSource->stop());
 
     mSelectedTracks.removeAt(i);
@@ -545,26 +706,43 @@ void NuMediaExtractor::fetchTrackSamples(TrackInfo *info,
         options.setSeekTo(seekTimeUs, mode);
         info->mFinalResult = OK;
         releaseTrackSamples(info);
+        if (info->mPrefetcher != NULL) {
+            info->mPrefetcher->pause();
+        }
     } else if (info->mFinalResult != OK || !info->mSamples.empty()) {
         return;
+    } else if (info->mPrefetcher != NULL) {
+        info->mFinalResult = info->mPrefetcher->dequeue(&info->mSamples);
+        return;
+    }
+
+    info->mFinalResult = readTrackSamples(
+            info->mSource, info->mTrackIndex, info->mMaxFetchCount, &options, &info->mSamples);
+
+    if (info->mPrefetcher != NULL) {
+        info->mPrefetcher->resume();
     }
+}
 
+// static
+status_t NuMediaExtractor::readTrackSamples(
+        const sp<IMediaSource> &source, size_t trackIndex, size_t maxFetchCount,
+        MediaSource::ReadOptions *options, std::list<Sample> *samples) {
     status_t err = OK;
     Vector<MediaBufferBase *> mediaBuffers;
-    if (info->mSource->supportReadMultiple()) {
-        options.setNonBlocking();
-        err = info->mSource->readMultiple(&mediaBuffers, info->mMaxFetchCount, &options);
+    if (source->supportReadMultiple()) {
+        options->setNonBlocking();
+        err = source->readMultiple(&mediaBuffers, maxFetchCount, options);
     } else {
         MediaBufferBase *mbuf = NULL;
-        err = info->mSource->read(&mbuf, &options);
+        err = source->read(&mbuf, options);
         if (err == OK && mbuf != NULL) {
             mediaBuffers.push_back(mbuf);
         }
     }
 
-    info->mFinalResult = err;
     if (err != OK && err != ERROR_END_OF_STREAM) {
-        ALOGW("read on track %zu failed with error %d", info->mTrackIndex, err);
+        ALOGW("read on track %zu failed with error %d", trackIndex, err);
     }
 
     size_t count = mediaBuffers.size();
@@ -580,14 +758,15 @@ void NuMediaExtractor::fetchTrackSamples(TrackInfo *info,
             continue;
         }
         if (mbuf->meta_data().findInt64(kKeyTime, &timeUs)) {
-            info->mSamples.emplace_back(mbuf, timeUs);
+            samples->emplace_back(mbuf, timeUs);
         } else {
             mbuf->meta_data().dumpToLog();
-            info->mFinalResult = ERROR_MALFORMED;
+            err = ERROR_MALFORMED;
             mbuf->release();
             releaseRemaining = true;
         }
     }
+    return err;
 }
 
 status_t NuMediaExtractor::seekTo(
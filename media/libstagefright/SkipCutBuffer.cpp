@@ -75,6 +75,10 @@ void SkipCutBuffer::submit(MediaBuffer *buffer) {
         mFrontPadding -= to_drop;
     }
 
+    if (trimInPlace((char*) buffer->data(), buffer->size(), &offset, &buflen)) {
+        buffer->set_range(offset, buflen);
+        return;
+    }
 
     // append data to cutbuffer
     char *src = ((char*) buffer->data()) + offset;
@@ -108,6 +112,10 @@ void SkipCutBuffer::submitInternal(const sp<T>& buffer) {
         mFrontPadding -= to_drop;
     }
 
+    if (trimInPlace((char*) buffer->base(), buffer->capacity(), &offset, &buflen)) {
+        buffer->setRange(offset, buflen);
+        return;
+    }
 
     // append data to cutbuffer
     char *src = (char*) buffer->data();
@@ -121,6 +129,34 @@ void SkipCutBuffer::submitInternal(const sp<T>& buffer) {
     buffer->setRange(0, copied);
 }
 
+bool SkipCutBuffer::trimInPlace(char *base, size_t capacity, int32_t *offset, int32_t *length) {
+    // The output is the data held back from previous buffers followed by all
+    // but the last mBackPadding bytes of this one, and those last bytes are
+    // held back in turn. If they all come from this buffer, move them to the
+    // cutbuffer and put the held back data in front of the rest, instead of
+    // copying the whole buffer through the cutbuffer and back.
+    if (*length < mBackPadding) {
+        return false;
+    }
+    int32_t held = size();
+    int32_t keep = *length - mBackPadding;
+    int32_t start = (*offset >= held) ? *offset - held : 0;
+    if ((size_t)start + held + keep > capacity) {
+        return false;
+    }
+
+    write(base + *offset + keep, mBackPadding);
+    if (start + held != *offset) {
+        memmove(base + start + held, base + *offset, keep);
+    }
+    size_t copied = read(base + start, held);
+    CHECK_EQ(copied, (size_t)held);
+
+    *offset = start;
+    *length = held + keep;
+    return true;
+}
+
 void SkipCutBuffer::submit(const sp<ABuffer>& buffer) {
     submitInternal(buffer);
 }
@@ -191,6 +227,7 @@ size_t SkipCutBuffer::read(char *dst, size_t num) {
     if (available < int32_t(num)) {
         num = available;
     }
+    available = num;
 
     size_t copyfirst = (mCapacity - mReadHead);
     if (copyfirst > num) copyfirst = num;
@@ -234,7 +234,11 @@ void VideoRenderQualityTracker::onFrameSkipped(int64_t contentTimeUs) {
     // Frames skipped at the end of playback shouldn't be counted as skipped frames, since the
     // app could be terminating the playback. The pending count will be added to the metrics if and
     // when the next frame is rendered.
-    mPendingSkippedFrameContentTimeUsList.push_back(contentTimeUs);
+    if (mPendingSkippedFrameContentTimeUsQueue.full()) {
+        processMetricsForSkippedFrame(mPendingSkippedFrameContentTimeUsQueue.front());
+        mPendingSkippedFrameContentTimeUsQueue.pop();
+    }
+    mPendingSkippedFrameContentTimeUsQueue.push(contentTimeUs);
 }
 
 void VideoRenderQualityTracker::onFrameReleased(int64_t contentTimeUs) {
@@ -250,6 +254,12 @@ void VideoRenderQualityTracker::onFrameReleased(int64_t contentTimeUs,
     int64_t desiredRenderTimeUs = desiredRenderTimeNs / 1000;
     resetIfDiscontinuity(contentTimeUs, desiredRenderTimeUs);
     mMetrics.frameReleasedCount++;
+    // A frame that is still not rendered after so many others were released was dropped.
+    if (mNextExpectedRenderedFrameQueue.full()) {
+        const FrameInfo &oldestFrame = mNextExpectedRenderedFrameQueue.front();
+        processMetricsForDroppedFrame(oldestFrame.contentTimeUs, oldestFrame.desiredRenderTimeUs);
+        mNextExpectedRenderedFrameQueue.pop();
+    }
     mNextExpectedRenderedFrameQueue.push({contentTimeUs, desiredRenderTimeUs});
     mLastContentTimeUs = contentTimeUs;
 }
@@ -268,10 +278,10 @@ void VideoRenderQualityTracker::onFrameRendered(int64_t contentTimeUs, int64_t a
     }
     // Now that a frame has been rendered, the previously skipped frames can be processed as skipped
     // frames since the app is not skipping them to terminate playback.
-    for (int64_t contentTimeUs : mPendingSkippedFrameContentTimeUsList) {
-        processMetricsForSkippedFrame(contentTimeUs);
+    while (!mPendingSkippedFrameContentTimeUsQueue.empty()) {
+        processMetricsForSkippedFrame(mPendingSkippedFrameContentTimeUsQueue.front());
+        mPendingSkippedFrameContentTimeUsQueue.pop();
     }
-    mPendingSkippedFrameContentTimeUsList = {};
 
     // We can render a pending queued frame if it's the last frame of the video, so release it
     // immediately.
@@ -364,11 +374,11 @@ void VideoRenderQualityTracker::resetForDiscontinuity() {
     // Don't worry about tracking frame rendering times from now up until playback catches up to the
     // discontinuity. While stuttering or freezing could be found in the next few frames, the impact
     // to the user is is minimal, so better to just keep things simple and don't bother.
-    mNextExpectedRenderedFrameQueue = {};
+    mNextExpectedRenderedFrameQueue.clear();
     mTunnelFrameQueuedContentTimeUs = -1;
 
     // Ignore any frames that were skipped just prior to the discontinuity.
-    mPendingSkippedFrameContentTimeUsList = {};
+    mPendingSkippedFrameContentTimeUsQueue.clear();
 
     // All frame durations can be now ignored since all bets are off now on what the render
     // durations should be after the discontinuity.
@@ -30,7 +30,10 @@
 #include "libyuv/convert_argb.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/video_common.h"
+#include <algorithm>
 #include <functional>
+#include <thread>
+#include <vector>
 #include <sys/time.h>
 
 #define PERF_PROFILING 0
@@ -46,6 +49,12 @@
 #endif
 
 namespace android {
+
+// Frames are converted in bands of rows on concurrent threads when they have at least
+// two bands of kMinPixelsPerConvertBand pixels.
+static const size_t kMinPixelsPerConvertBand = 1920 * 1088;
+static const size_t kMaxConvertBands = 4;
+
 typedef const struct libyuv::YuvConstants LibyuvConstants;
 
 struct LibyuvConstPair {
@@ -666,32 +675,12 @@ status_t ColorConverter::convert(
 #if PERF_PROFILING
     int64_t startTimeUs = ALooper::GetNowUs();
 #endif
-    status_t err;
     switch ((int32_t)mSrcFormat) {
-        case COLOR_FormatYUV420Flexible:
-            err = convertYUVMediaImage(src, dst);
-            break;
-
         case OMX_COLOR_FormatYUV420Planar:
             if (!mSrcImage) {
                 mSrcImage = Image(CreateYUV420PlanarMediaImage2(
                         srcWidth, srcHeight, srcStride, srcHeight, 8 /*bitDepth*/));
             }
-            err = convertYUVMediaImage(src, dst);
-
-            break;
-
-        case OMX_COLOR_FormatYUV420Planar16:
-            err = convertYUV420Planar16(src, dst);
-            break;
-
-        case COLOR_FormatYUVP010:
-            err = convertYUVP010(src, dst);
-
-            break;
-
-        case OMX_COLOR_FormatCbYCrY:
-            err = convertCbYCrY(src, dst);
             break;
 
         case OMX_QCOM_COLOR_FormatYVU420SemiPlanar:
@@ -699,8 +688,6 @@ status_t ColorConverter::convert(
                 mSrcImage = Image(CreateYUV420SemiPlanarMediaImage2(
                     srcWidth, srcHeight, srcStride, srcHeight, 8 /*bitDepth*/, false));
             }
-            err = convertYUVMediaImage(src, dst);
-
             break;
 
         case OMX_COLOR_FormatYUV420SemiPlanar:
@@ -709,16 +696,25 @@ status_t ColorConverter::convert(
                 mSrcImage = Image(CreateYUV420SemiPlanarMediaImage2(
                     srcWidth, srcHeight, srcStride, srcHeight, 8 /*bitDepth*/));
             }
-            err = convertYUVMediaImage(src, dst);
-
             break;
 
         default:
-
-            CHECK(!"Should not be here. Unknown color conversion.");
             break;
     }
 
+    // Split large frames into bands of rows converted concurrently, each band holding
+    // at least kMinPixelsPerConvertBand pixels.
+    size_t numBands = std::min(
+            (src.cropWidth() * src.cropHeight()) / kMinPixelsPerConvertBand,
+            std::min((size_t)std::thread::hardware_concurrency(), kMaxConvertBands));
+
+    status_t err;
+    if (numBands > 1) {
+        err = convertInBands(src, dst, numBands);
+    } else {
+        err = convertRect(src, dst);
+    }
+
 #if PERF_PROFILING
     int64_t endTimeUs = ALooper::GetNowUs();
     ALOGD("%s image took %lld us", asString_ColorFormat(mSrcFormat,"Unknown"),
@@ -728,6 +724,87 @@ status_t ColorConverter::convert(
     return err;
 }
 
+status_t ColorConverter::convertRect(
+        const BitmapParams &src, const BitmapParams &dst) {
+    status_t err;
+    switch ((int32_t)mSrcFormat) {
+        case COLOR_FormatYUV420Flexible:
+        case OMX_COLOR_FormatYUV420Planar:
+        case OMX_QCOM_COLOR_FormatYVU420SemiPlanar:
+        case OMX_COLOR_FormatYUV420SemiPlanar:
+        case OMX_TI_COLOR_FormatYUV420PackedSemiPlanar:
+            err = convertYUVMediaImage(src, dst);
+            break;
+
+        case OMX_COLOR_FormatYUV420Planar16:
+            err = convertYUV420Planar16(src, dst);
+            break;
+
+        case COLOR_FormatYUVP010:
+            err = convertYUVP010(src, dst);
+            break;
+
+        case OMX_COLOR_FormatCbYCrY:
+            err = convertCbYCrY(src, dst);
+            break;
+
+        default:
+
+            CHECK(!"Should not be here. Unknown color conversion.");
+            break;
+    }
+    return err;
+}
+
+status_t ColorConverter::convertInBands(
+        const BitmapParams &src, const BitmapParams &dst, size_t numBands) {
+    // The clip tables are created on first use, create them before the bands
+    // start using them concurrently.
+    (void)initClip();
+    (void)initClip10Bit();
+
+    // Bands hold an even number of rows, so that all of them start on the same chroma
+    // phase as the whole crop rect.
+    size_t bandHeight = (src.cropHeight() + numBands - 1) / numBands;
+    bandHeight = (bandHeight + 1) & ~(size_t)1;
+
+    std::vector<BitmapParams> srcBands;
+    std::vector<BitmapParams> dstBands;
+    for (size_t top = 0; top < src.cropHeight(); top += bandHeight) {
+        size_t height = std::min(bandHeight, src.cropHeight() - top);
+
+        BitmapParams srcBand = src;
+        srcBand.mCropTop = src.mCropTop + top;
+        srcBand.mCropBottom = srcBand.mCropTop + height - 1;
+        srcBands.push_back(srcBand);
+
+        BitmapParams dstBand = dst;
+        dstBand.mCropTop = dst.mCropTop + top;
+        dstBand.mCropBottom = dstBand.mCropTop + height - 1;
+        dstBands.push_back(dstBand);
+    }
+
+    // Convert the first band on the calling thread.
+    std::vector<status_t> results(srcBands.size(), OK);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < srcBands.size(); ++i) {
+        threads.emplace_back([this, &srcBands, &dstBands, &results, i] {
+            results[i] = convertRect(srcBands[i], dstBands[i]);
+        });
+    }
+    results[0] = convertRect(srcBands[0], dstBands[0]);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (status_t result : results) {
+        if (result != OK) {
+            return result;
+        }
+    }
+    return OK;
+}
+
 const struct ColorConverter::Coeffs *ColorConverter::getMatrix() const {
     const bool isFullRange = mSrcColorSpace.mRange == ColorUtils::kColorRangeFull;
     const bool is10Bit = (mSrcFormat == COLOR_FormatYUVP010
@@ -29,6 +29,8 @@
 #include <ui/GraphicBuffer.h>
 #include <ui/Rect.h>
 
+#include "libyuv/planar_functions.h"
+
 namespace android {
 
 inline void initDstYUV(
@@ -41,6 +43,25 @@ inline void initDstYUV(
     *dst_u = (uint8_t *)ycbcr.cb + c_offset;
 }
 
+// Copies |rows| rows of |rowBytes| bytes from |src| to |dst|. The rows are copied at once
+// when both buffers have the same stride, as the padding between them is then the same.
+inline void copyPlane(
+        uint8_t *dst, size_t dstStride, const uint8_t *src, size_t srcStride,
+        size_t rowBytes, size_t rows) {
+    if (rows == 0) {
+        return;
+    }
+    if (dstStride == srcStride) {
+        memcpy(dst, src, (rows - 1) * srcStride + rowBytes);
+        return;
+    }
+    for (size_t y = 0; y < rows; ++y) {
+        memcpy(dst, src, rowBytes);
+        src += srcStride;
+        dst += dstStride;
+    }
+}
+
 SoftwareRenderer::SoftwareRenderer(
         const sp<ANativeWindow> &nativeWindow, int32_t rotation)
     : mColorFormat(OMX_COLOR_FormatUnused),
@@ -308,22 +329,11 @@ std::list<FrameRenderTracker::Info> SoftwareRenderer::render(
         uint8_t *dst_y, *dst_u, *dst_v;
         initDstYUV(ycbcr, mCropTop, mCropLeft, &dst_y, &dst_u, &dst_v);
 
-        for (int y = 0; y < mCropHeight; ++y) {
-            memcpy(dst_y, src_y, mCropWidth);
-
-            src_y += mStride;
-            dst_y += ycbcr.ystride;
-        }
-
-        for (int y = 0; y < (mCropHeight + 1) / 2; ++y) {
-            memcpy(dst_u, src_u, (mCropWidth + 1) / 2);
-            memcpy(dst_v, src_v, (mCropWidth + 1) / 2);
-
-            src_u += mStride / 2;
-            src_v += mStride / 2;
-            dst_u += ycbcr.cstride;
-            dst_v += ycbcr.cstride;
-        }
+        copyPlane(dst_y, ycbcr.ystride, src_y, mStride, mCropWidth, mCropHeight);
+        copyPlane(dst_u, ycbcr.cstride, src_u, mStride / 2,
+                (mCropWidth + 1) / 2, (mCropHeight + 1) / 2);
+        copyPlane(dst_v, ycbcr.cstride, src_v, mStride / 2,
+                (mCropWidth + 1) / 2, (mCropHeight + 1) / 2);
     } else if (mColorFormat == OMX_COLOR_FormatYUV420Planar16) {
         const uint8_t *src_y = (const uint8_t *)data + mCropTop * mStride + mCropLeft * 2;
         const uint8_t *src_u = (const uint8_t *)data + mStride * mHeight + mCropTop * mStride / 4;
@@ -364,33 +374,18 @@ std::list<FrameRenderTracker::Info> SoftwareRenderer::render(
         uint8_t *dst_y, *dst_u, *dst_v;
         initDstYUV(ycbcr, mCropTop, mCropLeft, &dst_y, &dst_u, &dst_v);
 
-        for (int y = 0; y < mCropHeight; ++y) {
-            memcpy(dst_y, src_y, mCropWidth);
+        copyPlane(dst_y, ycbcr.ystride, src_y, mWidth, mCropWidth, mCropHeight);
 
-            src_y += mWidth;
-            dst_y += ycbcr.ystride;
-        }
-
-        for (int y = 0; y < (mCropHeight + 1) / 2; ++y) {
-            size_t tmp = (mCropWidth + 1) / 2;
-            for (size_t x = 0; x < tmp; ++x) {
-                dst_u[x] = src_uv[2 * x];
-                dst_v[x] = src_uv[2 * x + 1];
-            }
-
-            src_uv += mWidth;
-            dst_u += ycbcr.cstride;
-            dst_v += ycbcr.cstride;
-        }
+        libyuv::SplitUVPlane(
+                src_uv, mWidth,
+                dst_u, ycbcr.cstride,
+                dst_v, ycbcr.cstride,
+                (mCropWidth + 1) / 2, (mCropHeight + 1) / 2);
     } else if (mColorFormat == OMX_COLOR_Format24bitRGB888) {
         uint8_t* srcPtr = (uint8_t*)data + mWidth * mCropTop * 3 + mCropLeft * 3;
         uint8_t* dstPtr = (uint8_t*)dst + buf->stride * mCropTop * 3 + mCropLeft * 3;
 
-        for (size_t y = 0; y < (size_t)mCropHeight; ++y) {
-            memcpy(dstPtr, srcPtr, mCropWidth * 3);
-            srcPtr += mWidth * 3;
-            dstPtr += buf->stride * 3;
-        }
+        copyPlane(dstPtr, buf->stride * 3, srcPtr, mWidth * 3, mCropWidth * 3, mCropHeight);
     } else if (mColorFormat == OMX_COLOR_Format32bitARGB8888) {
         uint8_t *srcPtr, *dstPtr;
 
@@ -409,11 +404,7 @@ std::list<FrameRenderTracker::Info> SoftwareRenderer::render(
         uint8_t* srcPtr = (uint8_t*)data + mWidth * mCropTop * 4 + mCropLeft * 4;
         uint8_t* dstPtr = (uint8_t*)dst + buf->stride * mCropTop * 4 + mCropLeft * 4;
 
-        for (size_t y = 0; y < (size_t)mCropHeight; ++y) {
-            memcpy(dstPtr, srcPtr, mCropWidth * 4);
-            srcPtr += mWidth * 4;
-            dstPtr += buf->stride * 4;
-        }
+        copyPlane(dstPtr, buf->stride * 4, srcPtr, mWidth * 4, mCropWidth * 4, mCropHeight);
     } else {
         LOG_ALWAYS_FATAL("bad color format %#x", mColorFormat);
     }
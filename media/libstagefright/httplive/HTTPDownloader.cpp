@@ -40,22 +40,35 @@ HTTPDownloader::HTTPDownloader(
         const KeyedVector<String8, String8> &headers) :
     mHTTPDataSource(new MediaHTTP(httpService->makeHTTPConnection())),
     mExtraHeaders(headers),
-    mDisconnecting(false) {
+    mDisconnecting(false),
+    mConnectedRangeOffset(0),
+    mConnectedRangeEnd(-1),
+    mConnectedReadOffset(0) {
 }
 
 void HTTPDownloader::reconnect() {
     AutoMutex _l(mLock);
     mDisconnecting = false;
+    mConnectedUrl.clear();
+    mConnectedRangeEnd = -1;
 }
 
 void HTTPDownloader::disconnect() {
     {
         AutoMutex _l(mLock);
         mDisconnecting = true;
+        mConnectedUrl.clear();
+        mConnectedRangeEnd = -1;
     }
     mHTTPDataSource->disconnect();
 }
 
+void HTTPDownloader::clearConnectedRange() {
+    AutoMutex _l(mLock);
+    mConnectedUrl.clear();
+    mConnectedRangeEnd = -1;
+}
+
 bool HTTPDownloader::isDisconnecting() {
     AutoMutex _l(mLock);
     return mDisconnecting;
@@ -89,26 +102,46 @@ ssize_t HTTPDownloader::fetchBlock(
 
     off64_t size;
 
-    if (reconnect) {
+    bool continuesConnectedRange = false;
+    if (reconnect && range_length >= 0) {
+        AutoMutex _l(mLock);
+        continuesConnectedRange = mConnectedRangeEnd >= 0
+                && mConnectedUrl == url
+                && range_offset == mConnectedReadOffset
+                && range_offset + range_length <= mConnectedRangeEnd;
+    }
+
+    if (continuesConnectedRange) {
+        // The block was requested together with the previous one; read on from the
+        // open connection.
+        ALOGV("continuing byte range at %lld from the open connection", (long long)range_offset);
+    } else if (reconnect) {
         if (!strncasecmp(url, "file://", 7)) {
+            clearConnectedRange();
             mDataSource = new FileSource(url + 7);
         } else if (strncasecmp(url, "http://", 7)
                 && strncasecmp(url, "https://", 8)) {
             return ERROR_UNSUPPORTED;
         } else {
+            int64_t connect_range_length = range_length;
+            if (range_length >= 0 && merged_range_length > range_length) {
+                connect_range_length = merged_range_length;
+            }
+
             KeyedVector<String8, String8> headers = mExtraHeaders;
-            if (range_offset > 0 || range_length >= 0) {
+            if (range_offset > 0 || connect_range_length >= 0) {
                 headers.add(
                         String8("Range"),
                         String8(
                             AStringPrintf(
                                 "bytes=%lld-%s",
                                 range_offset,
-                                range_length < 0
+                                connect_range_length < 0
                                     ? "" : AStringPrintf("%lld",
-                                            range_offset + range_length - 1).c_str()).c_str()));
+                                            range_offset + connect_range_length - 1).c_str()).c_str()));
             }
 
+            clearConnectedRange();
             status_t err = mHTTPDataSource->connect(url, &headers);
 
             if (isDisconnecting()) {
@@ -120,6 +153,13 @@ ssize_t HTTPDownloader::fetchBlock(
             }
 
             mDataSource = mHTTPDataSource;
+
+            AutoMutex _l(mLock);
+            mConnectedUrl = url;
+            mConnectedRangeOffset = range_offset;
+            mConnectedRangeEnd =
+                    connect_range_length < 0 ? -1 : range_offset + connect_range_length;
+            mConnectedReadOffset = range_offset;
         }
     }
 
@@ -131,6 +171,17 @@ ssize_t HTTPDownloader::fetchBlock(
 
     if (getSizeErr != OK) {
         size = 65536;
+    } else if (range_length >= 0 && range_length < size) {
+        // The size is that of the whole file for byte range requests.
+        size = range_length;
+    }
+
+    // Offsets of the HTTP connection are relative to the start of the range it was
+    // opened for.
+    int64_t readOffset = 0;
+    if (mDataSource == mHTTPDataSource) {
+        AutoMutex _l(mLock);
+        readOffset = range_offset - mConnectedRangeOffset;
     }
 
     sp<ABuffer> buffer = *out != NULL ? *out : new ABuffer(size);
@@ -187,7 +238,7 @@ ssize_t HTTPDownloader::fetchBlock(
         // The DataSource is responsible for informing us of error (n < 0) or eof (n == 0)
         // to help us break out of the loop.
         ssize_t n = mDataSource->readAt(
-                buffer->size(), buffer->data() + buffer->size(),
+                readOffset + buffer->size(), buffer->data() + buffer->size(),
                 maxBytesToRead);
 
         if (isDisconnecting()) {
@@ -204,6 +255,11 @@ ssize_t HTTPDownloader::fetchBlock(
 
         buffer->setRange(0, buffer->size() + (size_t)n);
         bytesRead += n;
+
+        if (mDataSource == mHTTPDataSource) {
+            AutoMutex _l(mLock);
+            mConnectedReadOffset = range_offset + buffer->size();
+        }
     }
 
     *out = buffer;
@@ -222,13 +278,15 @@ ssize_t HTTPDownloader::fetchFile(
     ssize_t err = fetchBlock(url, out, 0, -1, 0, actualUrl, true /* reconnect */);
 
     // close off the connection after use
+    clearConnectedRange();
     mHTTPDataSource->disconnect();
 
     return err;
 }
 
 sp<M3UParser> HTTPDownloader::fetchPlaylist(
-        const char *url, uint8_t *curPlaylistHash, bool *unchanged) {
+        const char *url, uint8_t *curPlaylistHash, bool *unchanged,
+        const sp<M3UParser> &previous) {
     ALOGV("fetchPlaylist '%s'", url);
 
     *unchanged = false;
@@ -265,7 +323,7 @@ sp<M3UParser> HTTPDownloader::fetchPlaylist(
 #endif
 
     sp<M3UParser> playlist =
-        new M3UParser(actualUrl.string(), buffer->data(), buffer->size());
+        new M3UParser(actualUrl.string(), buffer->data(), buffer->size(), previous);
 
     if (playlist->initCheck() != OK) {
         ALOGE("failed to parse .m3u8 playlist");
@@ -50,6 +50,11 @@ struct HTTPDownloader : public RefBase {
     //
     // For reused HTTP sources, the caller must download a file sequentially without
     // any overlaps or gaps to prevent reconnection.
+    //
+    // If merged_range_length is larger than range_length, the HTTP connection is opened
+    // for merged_range_length bytes from range_offset. A later fetch of the same url that
+    // continues exactly where the previous one ended, within that range, then reads on
+    // from the open connection even if reconnect is set.
     ssize_t fetchBlock(
             const char *url,
             sp<ABuffer> *out,
@@ -57,7 +62,8 @@ struct HTTPDownloader : public RefBase {
             int64_t range_length, /* open file for range_length (-1: entire file) */
             uint32_t block_size,  /* download block size (0: entire range) */
             String8 *actualUrl,   /* returns actual URL */
-            bool reconnect        /* force connect http */
+            bool reconnect,       /* force connect http */
+            int64_t merged_range_length = -1 /* open http for this range_length */
             );
 
     // simplified version to fetch a single file
@@ -66,9 +72,11 @@ struct HTTPDownloader : public RefBase {
             sp<ABuffer> *out,
             String8 *actualUrl = NULL);
 
-    // fetch a playlist file
+    // fetch a playlist file; items of |previous| (an earlier version of the same
+    // media playlist) are reused for the part of the playlist that is unchanged.
     sp<M3UParser> fetchPlaylist(
-            const char *url, uint8_t *curPlaylistHash, bool *unchanged);
+            const char *url, uint8_t *curPlaylistHash, bool *unchanged,
+            const sp<M3UParser> &previous = NULL);
 
 private:
     sp<HTTPBase> mHTTPDataSource;
@@ -78,6 +86,15 @@ private:
     Mutex mLock;
     bool mDisconnecting;
 
+    // The url and byte range the HTTP connection was opened for, and the offset it has
+    // been read up to. mConnectedRangeEnd is -1 unless the range can be read on from.
+    String8 mConnectedUrl;
+    int64_t mConnectedRangeOffset;
+    int64_t mConnectedRangeEnd;
+    int64_t mConnectedReadOffset;
+
+    void clearConnectedRange();
+
     DISALLOW_EVIL_CONSTRUCTORS(HTTPDownloader);
 };
 
@@ -302,6 +302,7 @@ LiveSession::LiveSession(
       mUpSwitchMark(kUpSwitchMarkUs),
       mDownSwitchMark(kDownSwitchMarkUs),
       mUpSwitchMargin(kUpSwitchMarginUs),
+      mMinBufferedDurationUs(-1LL),
       mFirstTimeUsValid(false),
       mFirstTimeUs(0),
       mLastSeekTimeUs(0),
@@ -1329,6 +1330,20 @@ float LiveSession::getAbortThreshold(
     return abortThreshold;
 }
 
+// Returns the fraction of the estimated bandwidth that the picked variant may use.
+// Be conservative (70%) to avoid overestimating and immediately switching down again,
+// unless there is enough buffered to ride out a wrong estimate; the share grows to 85%
+// as the buffer grows from the down switch mark to twice that.
+float LiveSession::getBandwidthSafetyFactor() const {
+    if (mMinBufferedDurationUs <= mDownSwitchMark) {
+        return .7f;
+    }
+    if (mMinBufferedDurationUs >= mDownSwitchMark * 2) {
+        return .85f;
+    }
+    return .7f + .15f * (mMinBufferedDurationUs - mDownSwitchMark) / mDownSwitchMark;
+}
+
 void LiveSession::addBandwidthMeasurement(size_t numBytes, int64_t delayUs) {
     mBandwidthEstimator->addBandwidthMeasurement(numBytes, delayUs);
 }
@@ -1382,10 +1397,8 @@ size_t LiveSession::getBandwidthIndex(int32_t bandwidthBps) {
 
         index = mBandwidthItems.size() - 1;
         ssize_t lowestBandwidth = getLowestValidBandwidthIndex();
+        size_t adjustedBandwidthBps = bandwidthBps * getBandwidthSafetyFactor();
         while (index > lowestBandwidth) {
-            // be conservative (70%) to avoid overestimating and immediately
-            // switching down again.
-            size_t adjustedBandwidthBps = bandwidthBps * .7f;
             const BandwidthItem &item = mBandwidthItems[index];
             if (item.mBandwidth <= adjustedBandwidthBps
                     && isBandwidthValid(item)) {
@@ -2169,6 +2182,7 @@ bool LiveSession::checkBuffering(
     size_t activeCount, underflowCount, readyCount, downCount, upCount;
     activeCount = underflowCount = readyCount = downCount = upCount =0;
     int32_t minBufferPercent = -1;
+    int64_t minBufferedDurationUs = -1;
     int64_t durationUs;
     if (getDuration(&durationUs) != OK) {
         durationUs = -1;
@@ -2215,6 +2229,9 @@ bool LiveSession::checkBuffering(
             ++readyCount;
         }
         if (!mPacketSources[i]->isFinished(0)) {
+            if (minBufferedDurationUs < 0 || bufferedDurationUs < minBufferedDurationUs) {
+                minBufferedDurationUs = bufferedDurationUs;
+            }
             if (bufferedDurationUs < kUnderflowMarkMs * 1000LL) {
                 ++underflowCount;
             }
@@ -2231,6 +2248,8 @@ bool LiveSession::checkBuffering(
         notifyBufferingUpdate(minBufferPercent);
     }
 
+    mMinBufferedDurationUs = minBufferedDurationUs;
+
     if (activeCount > 0) {
         up        = (upCount == activeCount);
         down      = (downCount > 0);
@@ -2354,7 +2373,10 @@ bool LiveSession::switchBandwidthIfNeeded(bool bufferHigh, bool bufferLow) {
         // it hasn't stabilized, use the short term to guess real bandwidth,
         // since it may be dropping too fast.
         // (note this doesn't apply to upswitch, always use longer average there)
-        if (!isStable && canSwitchDown) {
+        // With half the down switch mark or more buffered, a short dip in throughput
+        // is not followed; the buffer can absorb it.
+        bool bufferDeep = mMinBufferedDurationUs >= mDownSwitchMark / 2;
+        if (!isStable && canSwitchDown && !bufferDeep) {
             if (shortTermBps < bandwidthBps) {
                 bandwidthBps = shortTermBps;
             }
@@ -2362,12 +2384,28 @@ bool LiveSession::switchBandwidthIfNeeded(bool bufferHigh, bool bufferLow) {
 
         ssize_t bandwidthIndex = getBandwidthIndex(bandwidthBps);
 
+        // Also step down one variant at a time while the buffer is deep, rather than
+        // dropping straight to what a possibly spiky estimate sustains.
+        if (canSwitchDown && bufferDeep && bandwidthIndex < mCurBandwidthIndex - 1) {
+            ssize_t index = mCurBandwidthIndex - 1;
+            while (index > bandwidthIndex && !isBandwidthValid(mBandwidthItems[index])) {
+                --index;
+            }
+            bandwidthIndex = index;
+        }
+
         // it's possible that we're checking for canSwitchUp case, but the returned
         // bandwidthIndex is < mCurBandwidthIndex, as getBandwidthIndex() only uses 70%
         // of measured bw. In that case we don't want to do anything, since we have
         // both enough buffer and enough bw.
         if ((canSwitchUp && bandwidthIndex > mCurBandwidthIndex)
          || (canSwitchDown && bandwidthIndex < mCurBandwidthIndex)) {
+            ALOGI("switching %s: %zd => %zd, estimated %d bps (short term %d bps, "
+                    "stable %d), buffered %lld us",
+                    canSwitchUp ? "up" : "down", mCurBandwidthIndex, bandwidthIndex,
+                    mLastBandwidthBps, shortTermBps, isStable,
+                    (long long)mMinBufferedDurationUs);
+
             // if not yet prepared, just restart again with new bw index.
             // this is faster and playback experience is cleaner.
             changeConfiguration(
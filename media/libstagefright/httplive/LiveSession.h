@@ -241,6 +241,8 @@ private:
     int64_t mUpSwitchMark;
     int64_t mDownSwitchMark;
     int64_t mUpSwitchMargin;
+    // lowest buffered duration of the audio/video streams at the last buffer poll
+    int64_t mMinBufferedDurationUs;
 
     sp<AReplyToken> mDisconnectReplyID;
     sp<AReplyToken> mSeekReplyID;
@@ -272,6 +274,7 @@ private:
             ssize_t currentBWIndex, ssize_t targetBWIndex) const;
     void addBandwidthMeasurement(size_t numBytes, int64_t delayUs);
     size_t getBandwidthIndex(int32_t bandwidthBps);
+    float getBandwidthSafetyFactor() const;
     ssize_t getLowestValidBandwidthIndex() const;
     HLSTime latestMediaSegmentStartTime() const;
 
@@ -250,20 +250,21 @@ bool M3UParser::MediaGroup::getActiveURI(AString *uri, const char *baseURL) cons
 ////////////////////////////////////////////////////////////////////////////////
 
 M3UParser::M3UParser(
-        const char *baseURI, const void *data, size_t size)
+        const char *baseURI, const void *data, size_t size, const sp<M3UParser> &previous)
     : mInitCheck(NO_INIT),
       mBaseURI(baseURI),
       mIsExtM3U(false),
       mIsVariantPlaylist(false),
       mIsComplete(false),
       mIsEvent(false),
+      mCanBlockReload(false),
       mFirstSeqNumber(-1),
       mLastSeqNumber(-1),
       mTargetDurationUs(-1LL),
       mDiscontinuitySeq(0),
       mDiscontinuityCount(0),
       mSelectedIndex(-1) {
-    mInitCheck = parse(data, size);
+    mInitCheck = parse(data, size, previous);
 }
 
 M3UParser::~M3UParser() {
@@ -289,6 +290,10 @@ bool M3UParser::isEvent() const {
     return mIsEvent;
 }
 
+bool M3UParser::canBlockReload() const {
+    return mCanBlockReload;
+}
+
 size_t M3UParser::getDiscontinuitySeq() const {
     return mDiscontinuitySeq;
 }
@@ -566,7 +571,7 @@ AString M3UParser::MediaGroup::Media::makeURL(const char *baseURL) const {
     return out;
 }
 
-status_t M3UParser::parse(const void *_data, size_t size) {
+status_t M3UParser::parse(const void *_data, size_t size, const sp<M3UParser> &previous) {
     int32_t lineNo = 0;
 
     sp<AMessage> itemMeta;
@@ -575,22 +580,13 @@ status_t M3UParser::parse(const void *_data, size_t size) {
     size_t offset = 0;
     uint64_t segmentRangeOffset = 0;
     while (offset < size) {
-        size_t offsetLF = offset;
-        while (offsetLF < size && data[offsetLF] != '\n') {
-            ++offsetLF;
-        }
-
         AString line;
-        if (offsetLF > offset && data[offsetLF - 1] == '\r') {
-            line.setTo(&data[offset], offsetLF - offset - 1);
-        } else {
-            line.setTo(&data[offset], offsetLF - offset);
-        }
+        size_t nextLineOffset = readLine(data, size, offset, &line);
 
         // ALOGI("#%s#", line.c_str());
 
         if (line.empty()) {
-            offset = offsetLF + 1;
+            offset = nextLineOffset;
             continue;
         }
 
@@ -598,6 +594,17 @@ status_t M3UParser::parse(const void *_data, size_t size) {
             mIsExtM3U = true;
         }
 
+        if (previous != NULL && mIsExtM3U && !mIsVariantPlaylist && itemMeta == NULL
+                && (line.startsWith("#EXTINF")
+                        || line.startsWith("#EXT-X-PROGRAM-DATE-TIME"))) {
+            size_t nextOffset = reusePreviousItem(previous, data, size, offset);
+            if (nextOffset > 0) {
+                offset = nextOffset;
+                ++lineNo;
+                continue;
+            }
+        }
+
         if (mIsExtM3U) {
             status_t err = OK;
 
@@ -620,6 +627,13 @@ status_t M3UParser::parse(const void *_data, size_t size) {
                 mIsComplete = true;
             } else if (line.startsWith("#EXT-X-PLAYLIST-TYPE:EVENT")) {
                 mIsEvent = true;
+            } else if (line.startsWith("#EXT-X-SERVER-CONTROL")) {
+                if (mIsVariantPlaylist) {
+                    return ERROR_MALFORMED;
+                }
+                // The server holds reloads that ask for a future segment
+                // (_HLS_msn) until the segment is available.
+                mCanBlockReload = line.find("CAN-BLOCK-RELOAD=YES") >= 0;
             } else if (line.startsWith("#EXTINF")) {
                 if (mIsVariantPlaylist) {
                     return ERROR_MALFORMED;
@@ -703,7 +717,7 @@ status_t M3UParser::parse(const void *_data, size_t size) {
             itemMeta.clear();
         }
 
-        offset = offsetLF + 1;
+        offset = nextLineOffset;
         ++lineNo;
     }
 
@@ -751,6 +765,81 @@ status_t M3UParser::parse(const void *_data, size_t size) {
     return OK;
 }
 
+// Live playlists are refreshed with most of their items unchanged. If the item starting at
+// |offset| has the URI of the item with the same sequence number in |previous|, and
+// neither is tagged with more than #EXTINF (and tags ignored by the parser), the item of
+// |previous| is added instead of parsing its lines again. Returns the offset after the
+// item, or 0 if the item must be parsed.
+size_t M3UParser::reusePreviousItem(
+        const sp<M3UParser> &previous, const char *data, size_t size, size_t offset) {
+    if (previous->mInitCheck != OK || previous->mIsVariantPlaylist) {
+        return 0;
+    }
+
+    int32_t firstSeqNumber = 0;
+    if (mMeta != NULL) {
+        mMeta->findInt32("media-sequence", &firstSeqNumber);
+    }
+    int64_t index = (int64_t)firstSeqNumber + mItems.size() - previous->mFirstSeqNumber;
+    if (index < 0 || index >= (int64_t)previous->mItems.size()) {
+        return 0;
+    }
+
+    const Item &previousItem = previous->mItems.itemAt(index);
+    int64_t durationUs;
+    int32_t discontinuitySeq;
+    if (previousItem.mMeta->countEntries() != 2
+            || !previousItem.mMeta->findInt64("durationUs", &durationUs)
+            || !previousItem.mMeta->findInt32("discontinuity-sequence", &discontinuitySeq)
+            || discontinuitySeq != (int32_t)(mDiscontinuitySeq + mDiscontinuityCount)) {
+        return 0;
+    }
+
+    bool hasDuration = false;
+    while (offset < size) {
+        AString line;
+        offset = readLine(data, size, offset, &line);
+
+        if (line.empty()) {
+            continue;
+        }
+        if (line.startsWith("#EXTINF")) {
+            if (hasDuration) {
+                return 0;
+            }
+            hasDuration = true;
+        } else if (line.startsWith("#")) {
+            if (!line.startsWith("#EXT-X-PROGRAM-DATE-TIME")) {
+                return 0;
+            }
+        } else {
+            if (!hasDuration || line != previousItem.mURI) {
+                return 0;
+            }
+            mItems.push(previousItem);
+            return offset;
+        }
+    }
+    return 0;
+}
+
+// Reads the line starting at |offset| into |line|, without the line terminator, and
+// returns the offset of the next line.
+// static
+size_t M3UParser::readLine(const char *data, size_t size, size_t offset, AString *line) {
+    size_t offsetLF = offset;
+    while (offsetLF < size && data[offsetLF] != '\n') {
+        ++offsetLF;
+    }
+
+    if (offsetLF > offset && data[offsetLF - 1] == '\r') {
+        line->setTo(&data[offset], offsetLF - offset - 1);
+    } else {
+        line->setTo(&data[offset], offsetLF - offset);
+    }
+    return offsetLF + 1;
+}
+
 // static
 status_t M3UParser::parseMetaData(
         const AString &line, sp<AMessage> *meta, const char *key) {
@@ -27,7 +27,10 @@
 namespace android {
 
 struct M3UParser : public RefBase {
-    M3UParser(const char *baseURI, const void *data, size_t size);
+    // |previous| is an earlier version of the same media playlist, if any; items it
+    // already holds are taken from it instead of being parsed again.
+    M3UParser(const char *baseURI, const void *data, size_t size,
+            const sp<M3UParser> &previous = NULL);
 
     status_t initCheck() const;
 
@@ -35,6 +38,7 @@ struct M3UParser : public RefBase {
     bool isVariantPlaylist() const;
     bool isComplete() const;
     bool isEvent() const;
+    bool canBlockReload() const;
     size_t getDiscontinuitySeq() const;
     int64_t getTargetDuration() const;
     int32_t getFirstSeqNumber() const;
@@ -76,6 +80,7 @@ private:
     bool mIsVariantPlaylist;
     bool mIsComplete;
     bool mIsEvent;
+    bool mCanBlockReload;
     int32_t mFirstSeqNumber;
     int32_t mLastSeqNumber;
     int64_t mTargetDurationUs;
@@ -89,7 +94,11 @@ private:
     // Media groups keyed by group ID.
     KeyedVector<AString, sp<MediaGroup> > mMediaGroups;
 
-    status_t parse(const void *data, size_t size);
+    status_t parse(const void *data, size_t size, const sp<M3UParser> &previous);
+    size_t reusePreviousItem(
+            const sp<M3UParser> &previous, const char *data, size_t size, size_t offset);
+
+    static size_t readLine(const char *data, size_t size, size_t offset, AString *line);
 
     static status_t parseMetaData(
             const AString &line, sp<AMessage> *meta, const char *key);
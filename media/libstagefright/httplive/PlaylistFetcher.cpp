@@ -55,6 +55,8 @@ const int64_t PlaylistFetcher::kMinBufferedDurationUs = 30000000LL;
 const int64_t PlaylistFetcher::kMaxMonitorDelayUs = 3000000LL;
 // LCM of 188 (size of a TS packet) & 1k works well
 const int32_t PlaylistFetcher::kDownloadBlockSize = 47 * 1024;
+// Contiguous EXT-X-BYTERANGE segments requested with a single HTTP request
+const size_t PlaylistFetcher::kMaxMergedByteRanges = 4;
 
 struct PlaylistFetcher::DownloadState : public RefBase {
     DownloadState();
@@ -935,9 +937,20 @@ void PlaylistFetcher::onMonitorQueue() {
 
 status_t PlaylistFetcher::refreshPlaylist() {
     if (delayUsToRefreshPlaylist() <= 0) {
+        AString uri = mURI;
+        if (mPlaylist != NULL && mPlaylist->canBlockReload() && !mPlaylist->isComplete()) {
+            // Ask for the playlist with the segment after the last one we know of; the
+            // server responds as soon as it is available, instead of us polling until
+            // the playlist changes.
+            int32_t firstSeqNumberInPlaylist, lastSeqNumberInPlaylist;
+            mPlaylist->getSeqNumberRange(&firstSeqNumberInPlaylist, &lastSeqNumberInPlaylist);
+            uri.append(uri.find("?") >= 0 ? "&" : "?");
+            uri.append(AStringPrintf("_HLS_msn=%d", lastSeqNumberInPlaylist + 1).c_str());
+        }
+
         bool unchanged;
         sp<M3UParser> playlist = mHTTPDownloader->fetchPlaylist(
-                mURI.c_str(), mPlaylistHash, &unchanged);
+                uri.c_str(), mPlaylistHash, &unchanged, mPlaylist);
 
         if (playlist == NULL) {
             if (unchanged) {
@@ -1327,6 +1340,30 @@ bool PlaylistFetcher::initDownloadState(
     return true;
 }
 
+// Returns the length of the byte range from |range_offset| that covers the current segment
+// and the segments after it that continue its byte range of |uri|, up to
+// kMaxMergedByteRanges segments in all.
+int64_t PlaylistFetcher::getMergedRangeLength(
+        const AString &uri, int32_t firstSeqNumberInPlaylist,
+        int64_t range_offset, int64_t range_length) {
+    int64_t merged_range_length = range_length;
+    size_t index = mSeqNumber - firstSeqNumberInPlaylist + 1;
+    for (size_t i = 1; i < kMaxMergedByteRanges && index < mPlaylist->size(); ++i, ++index) {
+        AString nextUri;
+        sp<AMessage> nextMeta;
+        int64_t next_range_offset, next_range_length;
+        if (!mPlaylist->itemAt(index, &nextUri, &nextMeta)
+                || nextUri != uri
+                || !nextMeta->findInt64("range-offset", &next_range_offset)
+                || !nextMeta->findInt64("range-length", &next_range_length)
+                || next_range_offset != range_offset + merged_range_length) {
+            break;
+        }
+        merged_range_length += next_range_length;
+    }
+    return merged_range_length;
+}
+
 void PlaylistFetcher::onDownloadNext() {
     AString uri;
     sp<AMessage> itemMeta;
@@ -1364,6 +1401,12 @@ void PlaylistFetcher::onDownloadNext() {
         range_length = -1;
     }
 
+    int64_t merged_range_length = range_length;
+    if (connectHTTP && range_length >= 0) {
+        merged_range_length = getMergedRangeLength(
+                uri, firstSeqNumberInPlaylist, range_offset, range_length);
+    }
+
     // block-wise download
     bool shouldPause = false;
     ssize_t bytesRead;
@@ -1371,7 +1414,7 @@ void PlaylistFetcher::onDownloadNext() {
         int64_t startUs = ALooper::GetNowUs();
         bytesRead = mHTTPDownloader->fetchBlock(
                 uri.c_str(), &buffer, range_offset, range_length, kDownloadBlockSize,
-                NULL /* actualURL */, connectHTTP);
+                NULL /* actualURL */, connectHTTP, merged_range_length);
         int64_t delayUs = ALooper::GetNowUs() - startUs;
 
         if (bytesRead == ERROR_NOT_CONNECTED) {
@@ -1741,14 +1784,9 @@ status_t PlaylistFetcher::extractAndQueueAccessUnitsFromTs(const sp<ABuffer> &bu
     }
 
     size_t offset = 0;
-    while (offset + 188 <= buffer->size()) {
-        status_t err = mTSParser->feedTSPacket(buffer->data() + offset, 188);
-
-        if (err != OK) {
-            return err;
-        }
-
-        offset += 188;
+    status_t err = mTSParser->feedTSPackets(buffer->data(), buffer->size(), &offset);
+    if (err != OK) {
+        return err;
     }
     // setRange to indicate consumed bytes.
     buffer->setRange(buffer->offset() + offset, buffer->size() - offset);
@@ -1810,7 +1848,7 @@ status_t PlaylistFetcher::extractAndQueueAccessUnitsFromTs(const sp<ABuffer> &bu
         }
     }
 
-    status_t err = OK;
+    err = OK;
     for (size_t i = mPacketSources.size(); i > 0;) {
         i--;
         sp<AnotherPacketSource> packetSource = mPacketSources.valueAt(i);
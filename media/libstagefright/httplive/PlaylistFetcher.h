@@ -109,6 +109,7 @@ private:
 
     static const int64_t kMaxMonitorDelayUs;
     static const int32_t kNumSkipFrames;
+    static const size_t kMaxMergedByteRanges;
 
     static bool bufferStartsWithTsSyncByte(const sp<ABuffer>& buffer);
     static bool bufferStartsWithWebVTTMagicSequence(const sp<ABuffer>& buffer);
@@ -231,6 +232,9 @@ private:
             sp<AMessage> &itemMeta,
             int32_t &firstSeqNumberInPlaylist,
             int32_t &lastSeqNumberInPlaylist);
+    int64_t getMergedRangeLength(
+            const AString &uri, int32_t firstSeqNumberInPlaylist,
+            int64_t range_offset, int64_t range_length);
 
     // Resume a fetcher to continue until the stopping point stored in msg.
     status_t onResumeUntil(const sp<AMessage> &msg);
@@ -49,6 +49,16 @@ struct FrameDecoder : public RefBase {
 
     sp<IMemory> extractFrame(FrameRect *rect = NULL);
 
+    // Seeks to |frameTimeUs| with the seek mode given to init() and extracts the frame
+    // there, reusing the codec instead of creating a new one. Must be called after init().
+    sp<IMemory> extractFrameAtTime(int64_t frameTimeUs);
+
+    // Extracts the frames at |frameTimesUs| with a single codec session. The frames are
+    // decoded in increasing time order, and returned in |frames| in the order of
+    // |frameTimesUs|; the frames that failed to extract are NULL. Must be called after init().
+    status_t extractFrames(
+            const std::vector<int64_t> &frameTimesUs, std::vector<sp<IMemory>> *frames);
+
     static sp<IMemory> getMetadataOnly(
             const sp<MetaData> &trackMeta, int colorFormat,
             bool thumbnail = false, uint32_t bitDepth = 0);
@@ -64,6 +74,12 @@ protected:
 
     virtual status_t onExtractRect(FrameRect *rect) = 0;
 
+    // Sets up |options| to seek to |frameTimeUs| on a codec that was already used, and
+    // resets the state of the previous extraction.
+    virtual status_t onSeek(
+            int64_t frameTimeUs,
+            MediaSource::ReadOptions *options);
+
     virtual status_t onInputReceived(
             const sp<MediaCodecBuffer> &codecBuffer,
             MetaDataBase &sampleMeta,
@@ -121,6 +137,10 @@ protected:
         return (rect == NULL) ? OK : ERROR_UNSUPPORTED;
     }
 
+    virtual status_t onSeek(
+            int64_t frameTimeUs,
+            MediaSource::ReadOptions *options) override;
+
     virtual status_t onInputReceived(
             const sp<MediaCodecBuffer> &codecBuffer,
             MetaDataBase &sampleMeta,
@@ -143,6 +163,7 @@ private:
     List<int64_t> mSampleDurations;
     int64_t mDefaultSampleDurationUs;
 
+    void setSeekTo(int64_t frameTimeUs, MediaSource::ReadOptions *options);
     sp<Surface> initSurface();
     status_t captureSurface();
 };
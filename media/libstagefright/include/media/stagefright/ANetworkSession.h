@@ -73,9 +73,13 @@ struct ANetworkSession : public RefBase {
 
     status_t destroySession(int32_t sessionID);
 
+    // If "flush" is false the data is only queued, and the network thread
+    // is not woken up until the next request that is flushed. This lets
+    // callers sending a burst of datagrams pay for a single wakeup.
     status_t sendRequest(
             int32_t sessionID, const void *data, ssize_t size = -1,
-            bool timeValid = false, int64_t timeUs = -1ll);
+            bool timeValid = false, int64_t timeUs = -1ll,
+            bool flush = true);
 
     status_t switchToWebSocketMode(int32_t sessionID);
 
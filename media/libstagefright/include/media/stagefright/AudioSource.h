@@ -95,6 +95,10 @@ private:
     enum {
         kMaxBufferSize = 2048,
 
+        // Number of buffers returned by the encoder that are kept for reuse,
+        // so steady state capture does not allocate per callback.
+        kMaxPooledBuffers = 16,
+
         // After the initial mute, we raise the volume linearly
         // over kAutoRampDurationUs.
         kAutoRampDurationUs = 300000,
@@ -128,6 +132,7 @@ private:
     bool mNoMoreFramesToRead;
 
     List<MediaBuffer * > mBuffersReceived;
+    List<MediaBuffer * > mBufferPool;
 
     void trackMaxAmplitude(int16_t *data, int nSamples);
 
@@ -137,8 +142,10 @@ private:
         int32_t startFrame, int32_t rampDurationFrames,
         uint8_t *data,   size_t bytes);
 
+    MediaBuffer *acquireBuffer_l(size_t size);
     void queueInputBuffer_l(MediaBuffer *buffer, int64_t timeUs);
     void releaseQueuedFrames_l();
+    void releaseBufferPool_l();
     void waitOutstandingEncodingFrames_l();
     status_t reset();
 
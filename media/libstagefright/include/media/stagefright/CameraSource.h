@@ -19,6 +19,7 @@
 #define CAMERA_SOURCE_H_
 
 #include <deque>
+#include <vector>
 #include <media/stagefright/MediaSource.h>
 #include <media/stagefright/MediaBuffer.h>
 #include <camera/android/hardware/ICamera.h>
@@ -202,12 +203,19 @@ private:
     Condition mFrameAvailableCondition;
     Condition mFrameCompleteCondition;
     List<sp<IMemory> > mFramesReceived;
-    List<sp<IMemory> > mFramesBeingEncoded;
+    // Frames handed out by read() and not yet returned, indexed by their slot in
+    // mMemoryHeapBase so signalBufferReturned() does not have to search for them.
+    std::vector<sp<IMemory>> mFramesBeingEncoded;
+    size_t mNumFramesBeingEncoded;
     List<int64_t> mFrameTimes;
+    // True while read() is blocked on mFrameAvailableCondition.
+    bool mReaderWaiting;
 
     int64_t mFirstFrameTimeUs;
     int64_t mStopSystemTimeUs;
     int32_t mNumFramesDropped;
+    // Camera frames that never reached read() because no memory base was free.
+    int32_t mNumFramesDroppedNoMemoryBase;
     int32_t mNumGlitches;
     int64_t mGlitchDurationThresholdUs;
     bool mCollectStats;
@@ -224,6 +232,7 @@ private:
     sp<IGraphicBufferProducer> mVideoBufferProducer;
     // Memory used to send the buffers to encoder, where sp<IMemory> stores VideoNativeMetadata.
     sp<IMemoryHeap> mMemoryHeapBase;
+    size_t mMemoryBaseSize;
     List<sp<IMemory>> mMemoryBases;
     // The condition that will be signaled when there is an entry available in mMemoryBases.
     Condition mMemoryBaseAvailableCond;
@@ -240,7 +249,11 @@ private:
     // End of members protected by mBatchLock
 
     void releaseQueuedFrames();
+    // Queues a buffer item for read(). Returns false if the frame is dropped, in
+    // which case the caller must release it back to the buffer queue.
+    bool queueBufferQueueFrame(BufferItem& buffer);
     void releaseOneRecordingFrame(const sp<IMemory>& frame);
+    ssize_t frameSlot_l(const void *data) const;
     void createVideoBufferMemoryHeap(size_t size, uint32_t bufferCount);
 
     status_t init(const sp<hardware::ICamera>& camera, const sp<ICameraRecordingProxy>& proxy,
@@ -183,6 +183,14 @@ private:
             size_t *u_stride,
             size_t *v_stride) const;
 
+    // converts the crop rect of |src| on the calling thread
+    status_t convertRect(
+            const BitmapParams &src, const BitmapParams &dst);
+
+    // converts the crop rect of |src| in |numBands| bands of rows on concurrent threads
+    status_t convertInBands(
+            const BitmapParams &src, const BitmapParams &dst, size_t numBands);
+
     status_t convertYUVMediaImage(
         const BitmapParams &src, const BitmapParams &dst);
 
@@ -17,14 +17,17 @@
 #ifndef FRAME_CAPTURE_PROCESSOR_H_
 #define FRAME_CAPTURE_PROCESSOR_H_
 
+#include <vector>
+
 #include <media/stagefright/foundation/ABase.h>
 #include <media/stagefright/foundation/AHandler.h>
+#include <ui/Rect.h>
 
 namespace android {
 
 struct AMessage;
+class Fence;
 class GraphicBuffer;
-class Rect;
 
 namespace renderengine {
 class RenderEngine;
@@ -49,12 +52,26 @@ public:
                 renderengine::LayerSettings *layerSettings) = 0;
     };
 
+    struct CaptureRequest {
+        sp<Layer> layer;
+        Rect sourceCrop;
+        sp<GraphicBuffer> outBuffer;
+    };
+
     static sp<FrameCaptureProcessor> getInstance();
 
     status_t capture(
             const sp<Layer> &layer,
             const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer);
 
+    // Queues the captures of |requests| on the render thread, and returns once they are
+    // all submitted, without waiting for them to be drawn. |fences| receives a fence per
+    // request, signaled when its outBuffer is drawn. The layers must stay valid until
+    // then. Framebuffers are cached across the captures, so reusing the same out buffers
+    // for captures of equal size avoids recreating them.
+    status_t captureBatch(
+            const std::vector<CaptureRequest> &requests, std::vector<sp<Fence>> *fences);
+
 protected:
     virtual ~FrameCaptureProcessor();
     void onMessageReceived(const sp<AMessage> &msg);
@@ -65,8 +82,12 @@ private:
     enum {
         kWhatCreate,
         kWhatCapture,
+        kWhatCaptureBatch,
+        kWhatCleanup,
     };
 
+    struct CaptureBatch;
+
     static Mutex sLock;
     static sp<FrameCaptureProcessor> sInstance GUARDED_BY(sLock);
 
@@ -76,6 +97,9 @@ private:
     sp<ALooper> mLooper;
     std::unique_ptr<renderengine::RenderEngine> mRE;
     uint32_t mTextureName;
+    // Fence of the last capture of a batch, to wait for before releasing the GL
+    // resources. Only accessed on the looper thread.
+    sp<Fence> mCleanupFence;
 
     static status_t PostAndAwaitResponse(
             const sp<AMessage> &msg, sp<AMessage> *response);
@@ -89,6 +113,10 @@ private:
     status_t onCreate();
     status_t onCapture(const sp<Layer> &layer,
             const Rect &sourceCrop, const sp<GraphicBuffer> &outBuffer);
+    status_t onCaptureBatch(const sp<CaptureBatch> &batch);
+    void onCleanup();
+    status_t drawLayer(const sp<Layer> &layer, const Rect &sourceCrop,
+            const sp<GraphicBuffer> &outBuffer, bool useFramebufferCache, sp<Fence> *fence);
 
     DISALLOW_EVIL_CONSTRUCTORS(FrameCaptureProcessor);
 };
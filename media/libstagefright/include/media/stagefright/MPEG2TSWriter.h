@@ -71,6 +71,7 @@ private:
     int mPATContinuityCounter;
     int mPMTContinuityCounter;
     uint32_t mCrcTable[256];
+    sp<ABuffer> mPacketBuffer;
 
     void init();
 
@@ -19,6 +19,7 @@
 #define MPEG4_WRITER_H_
 
 #include <stdio.h>
+#include <sys/uio.h>
 
 #include <media/stagefright/MediaWriter.h>
 #include <utils/List.h>
@@ -76,6 +77,9 @@ public:
     void notifyApproachingLimit();
     virtual void setStartTimeOffsetMs(int ms) { mStartTimeOffsetMs = ms; }
     virtual int32_t getStartTimeOffsetMs() const { return mStartTimeOffsetMs; }
+    // Sets the file to continue the recording in once the current one approaches its
+    // size limit. The current file is completed (moov written) before switching, so each
+    // file is a playable segment that can be processed while the recording goes on.
     virtual status_t setNextFd(int fd);
 
 protected:
@@ -134,6 +138,18 @@ private:
                         std::greater<std::chrono::microseconds>> mWriteDurationPQ;
     const uint8_t kWriteDurationsCount = 5;
 
+    // While writeChunkToFile() runs, the writes to the file are collected here and
+    // written with one writev() per kMaxBatchedWrites, instead of a write() per sample
+    // and per NAL length prefix. Small writes are copied to mBatchedBytes, as their
+    // buffers don't outlive the call.
+    static constexpr size_t kMaxBatchedWrites = 256;
+    bool mBatchWrites;
+    std::vector<struct iovec> mBatchedWrites;
+    uint8_t mBatchedBytes[kMaxBatchedWrites][4];
+    void flushBatchedWrites();
+    void onWriteDone(std::chrono::high_resolution_clock::time_point beforeTP,
+                     ssize_t bytesWritten, size_t count);
+
     sp<ALooper> mLooper;
     sp<AHandlerReflector<MPEG4Writer> > mReflector;
 
@@ -18,6 +18,7 @@
 
 #define MEDIA_CLOCK_H_
 
+#include <atomic>
 #include <list>
 #include <media/stagefright/foundation/AHandler.h>
 #include <utils/Mutex.h>
@@ -87,11 +88,33 @@ private:
         int64_t mAdjustRealUs;
     };
 
+    // The state that media time queries depend on.
+    struct AnchorState {
+        int64_t mAnchorTimeMediaUs;
+        int64_t mAnchorTimeRealUs;
+        int64_t mMaxTimeMediaUs;
+        int64_t mStartingTimeMediaUs;
+        float mPlaybackRate;
+    };
+
+    static status_t GetMediaTime(
+            const AnchorState &state,
+            int64_t realUs,
+            int64_t *outMediaUs,
+            bool allowPastMaxTime);
+
     status_t getMediaTime_l(
             int64_t realUs,
             int64_t *outMediaUs,
             bool allowPastMaxTime) const;
 
+    // Copies the anchor state to the published copy below. Must be called with
+    // mLock held after any of the anchor state members is changed.
+    void publishAnchorState_l();
+
+    // Reads the published anchor state without taking mLock.
+    void readAnchorState(AnchorState *state) const;
+
     void processTimers_l();
 
     void updateAnchorTimesAndPlaybackRate_l(
@@ -109,6 +132,17 @@ private:
 
     float mPlaybackRate;
 
+    // Copy of the anchor state above, published with a sequence lock so that
+    // the queries, which are made several times per frame from the renderer
+    // threads, don't contend on mLock. mAnchorSeq is odd while an update is
+    // in progress. Updates are serialized by mLock.
+    std::atomic<uint32_t> mAnchorSeq;
+    std::atomic<int64_t> mPublishedAnchorTimeMediaUs;
+    std::atomic<int64_t> mPublishedAnchorTimeRealUs;
+    std::atomic<int64_t> mPublishedMaxTimeMediaUs;
+    std::atomic<int64_t> mPublishedStartingTimeMediaUs;
+    std::atomic<float> mPublishedPlaybackRate;
+
     int32_t mGeneration;
     std::list<Timer> mTimers;
     sp<AMessage> mNotify;
@@ -18,6 +18,7 @@
 
 #define MEDIA_CODEC_H_
 
+#include <deque>
 #include <list>
 #include <memory>
 #include <vector>
@@ -184,6 +185,23 @@ struct MediaCodec : public AHandler {
             uint32_t flags,
             AString *errorDetailMsg = NULL);
 
+    // An input buffer to be queued by queueInputBuffers().
+    struct InputBufferInfo {
+        size_t mIndex;
+        size_t mOffset;
+        size_t mSize;
+        int64_t mPresentationTimeUs;
+        uint32_t mFlags;
+    };
+
+    // Queues several input buffers, in order, with a single round-trip to the codec
+    // looper. Stops at the first buffer that fails to queue and returns its error;
+    // *numQueued (if not null) is set to the number of buffers queued before it.
+    status_t queueInputBuffers(
+            const std::vector<InputBufferInfo> &buffers,
+            size_t *numQueued = NULL,
+            AString *errorDetailMsg = NULL);
+
     status_t queueSecureInputBuffer(
             size_t index,
             size_t offset,
@@ -350,6 +368,7 @@ private:
         kWhatRelease                        = 'rele',
         kWhatDequeueInputBuffer             = 'deqI',
         kWhatQueueInputBuffer               = 'queI',
+        kWhatQueueInputBuffers              = 'quIs',
         kWhatDequeueOutputBuffer            = 'deqO',
         kWhatReleaseOutputBuffer            = 'relO',
         kWhatSignalEndOfInputStream         = 'eois',
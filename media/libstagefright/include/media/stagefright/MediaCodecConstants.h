@@ -772,6 +772,9 @@ inline constexpr char KEY_ALLOW_FRAME_DROP[] = "allow-frame-drop";
 inline constexpr char KEY_AUDIO_SESSION_ID[] = "audio-session-id";
 inline constexpr char KEY_BIT_RATE[] = "bitrate";
 inline constexpr char KEY_BITRATE_MODE[] = "bitrate-mode";
+inline constexpr char KEY_BUFFER_BATCH_MAX_OUTPUT_SIZE[] = "buffer-batch-max-output-size";
+inline constexpr char KEY_BUFFER_BATCH_THRESHOLD_OUTPUT_SIZE[] =
+        "buffer-batch-threshold-output-size";
 inline constexpr char KEY_CA_SESSION_ID[] = "ca-session-id";
 inline constexpr char KEY_CA_SYSTEM_ID[] = "ca-system-id";
 inline constexpr char KEY_CA_PRIVATE_DATA[] = "ca-private-data";
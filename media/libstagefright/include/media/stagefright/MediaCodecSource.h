@@ -136,6 +136,8 @@ private:
     bool mSetEncoderFormat;
     int32_t mEncoderFormat;
     int32_t mEncoderDataSpace;
+    // last input dataspace pushed to the encoder, so it is only updated on change
+    int32_t mInputDataSpace;
     sp<AMessage> mEncoderActivityNotify;
     sp<IGraphicBufferProducer> mGraphicBufferProducer;
     sp<PersistentSurface> mPersistentSurface;
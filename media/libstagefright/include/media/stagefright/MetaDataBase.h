@@ -283,6 +283,8 @@ enum {
     kKeySampleFileOffset = 'sfof', // int64_t, sample's offset in a media file.
     kKeyLastSampleIndexInChunk = 'lsic',  //int64_t, index of last sample in a chunk.
     kKeySampleTimeBeforeAppend = 'lsba', // int64_t, timestamp of last sample of a track.
+    kKeyBufferCanBeHeld  = 'bchd', // int32_t (bool), the buffer is a MediaBuffer owning its
+                                   // data, and its source does not wait for it to be returned.
 
     // DVB component tag
     kKeyDvbComponentTag = 'copt', // int32_t, component tag for DVB video/audio/subtitle
@@ -104,6 +104,11 @@ struct NuMediaExtractor : public RefBase {
 
     const char* getName() const;
 
+    // Sets the number of samples read ahead of the client for each track selected from now
+    // on, on a thread of the track's own. 0 (the default, unless overridden by the
+    // media.stagefright.extractor.prefetch-depth property) reads samples on demand.
+    void setPrefetchDepth(size_t depth);
+
 protected:
     virtual ~NuMediaExtractor();
 
@@ -123,6 +128,8 @@ private:
         int64_t mSampleTimeUs;
     };
 
+    struct SamplePrefetcher;
+
     struct TrackInfo {
         sp<IMediaSource> mSource;
         size_t mTrackIndex;
@@ -130,6 +137,7 @@ private:
         size_t mMaxFetchCount;
         status_t mFinalResult;
         std::list<Sample> mSamples;
+        sp<SamplePrefetcher> mPrefetcher;
 
         uint32_t mTrackFlags;  // bitmask of "TrackFlags"
     };
@@ -147,6 +155,7 @@ private:
     int64_t mTotalBitrate;  // in bits/sec
     int64_t mDurationUs;
     String8 mName;
+    size_t mPrefetchDepth;
 
     void setEntryPointToRemoteMediaExtractor();
 
@@ -160,6 +169,10 @@ private:
             MediaSource::ReadOptions::SeekMode mode =
                 MediaSource::ReadOptions::SEEK_CLOSEST_SYNC);
 
+    static status_t readTrackSamples(
+            const sp<IMediaSource> &source, size_t trackIndex, size_t maxFetchCount,
+            MediaSource::ReadOptions *options, std::list<Sample> *samples);
+
     void releaseTrackSamples(TrackInfo *info);
     void releaseAllTrackSamples();
 
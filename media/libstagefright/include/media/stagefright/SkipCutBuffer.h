@@ -50,6 +50,7 @@ class SkipCutBuffer: public RefBase {
  private:
     void write(const char *src, size_t num);
     size_t read(char *dst, size_t num);
+    bool trimInPlace(char *base, size_t capacity, int32_t *offset, int32_t *length);
     template <typename T>
     void submitInternal(const sp<T>& buffer);
     int32_t mSkip;
@@ -19,8 +19,7 @@
 #define VIDEO_RENDER_QUALITY_TRACKER_H_
 
 #include <assert.h>
-#include <list>
-#include <queue>
+#include <stddef.h>
 
 #include <media/stagefright/MediaHistogram.h>
 
@@ -297,6 +296,48 @@ private:
         int64_t desiredRenderTimeUs;
     };
 
+    // A first-in first-out queue of up to N items, kept in a fixed-size ring so that tracking
+    // frames does not allocate memory.
+    template<typename T, size_t N>
+    class FixedQueue {
+    public:
+        FixedQueue() : mHead(0), mSize(0) {}
+
+        bool empty() const { return mSize == 0; }
+        bool full() const { return mSize == N; }
+
+        const T &front() const {
+            assert(mSize > 0);
+            return mItems[mHead];
+        }
+
+        void push(const T &item) {
+            assert(mSize < N);
+            mItems[(mHead + mSize) % N] = item;
+            ++mSize;
+        }
+
+        void pop() {
+            assert(mSize > 0);
+            mHead = (mHead + 1) % N;
+            --mSize;
+        }
+
+        void clear() {
+            mHead = 0;
+            mSize = 0;
+        }
+
+    private:
+        T mItems[N];
+        size_t mHead;
+        size_t mSize;
+    };
+
+    // The maximum number of frames tracked while pending to be rendered or skipped. Older frames
+    // are processed as dropped or skipped when more are pending.
+    static const size_t kMaxPendingFrames = 128;
+
     // Historic tracking of frame durations
     struct FrameDurationUs {
         static const int SIZE = 5;
@@ -420,11 +461,11 @@ private:
 
     // Frames skipped at the end of playback shouldn't really be considered skipped, therefore keep
     // a list of the frames, and process them as skipped frames the next time a frame is rendered.
-    std::list<int64_t> mPendingSkippedFrameContentTimeUsList;
+    FixedQueue<int64_t, kMaxPendingFrames> mPendingSkippedFrameContentTimeUsQueue;
 
     // Since the system only signals when a frame is rendered, dropped frames are detected by
     // checking to see if the next expected frame is rendered. If not, it is considered dropped.
-    std::queue<FrameInfo> mNextExpectedRenderedFrameQueue;
+    FixedQueue<FrameInfo, kMaxPendingFrames> mNextExpectedRenderedFrameQueue;
 
     // When B-frames are present in the stream, a P-frame will be queued before the B-frame even
     // though it is rendered after. Therefore, the P-frame is held here and not inserted into
@@ -373,12 +373,19 @@ OMXNodeInstance::CallbackDispatcher::~CallbackDispatcher() {
 void OMXNodeInstance::CallbackDispatcher::post(const omx_message &msg, bool realTime) {
     Mutex::Autolock autoLock(mLock);
 
+    // The dispatcher thread only waits while the queue is empty. If it is not, the thread is
+    // already busy and will pick up this message with the others, so skip the wakeup.
+    const bool wasEmpty = mQueue.empty();
     mQueue.push_back(msg);
     if (realTime) {
-        mQueueChanged.signal();
+        if (wasEmpty) {
+            mQueueChanged.signal();
+        }
     } else if (!mHasBatchedMessages) {
         mHasBatchedMessages = true;
-        mQueueChanged.signal(); // The first non-realtime message is not batched.
+        if (wasEmpty) {
+            mQueueChanged.signal(); // The first non-realtime message is not batched.
+        }
     }
 }
 
@@ -130,9 +130,9 @@ ARTPAssembler::AssemblyStatus AAVCAssembler::addNALUnit(
 
     const int64_t startTimeMs = source->mSysAnchorTime / 1000;
     const int64_t nowTimeMs = nowTimeUs / 1000;
-    const int32_t staticJitterTimeMs = source->getStaticJitterTimeMs();
+    const int32_t staticJitterTimeMs = source->getMinJitterTimeMs();
     const int32_t baseJitterTimeMs = source->getBaseJitterTimeMs();
-    const int32_t dynamicJitterTimeMs = source->getInterArrivalJitterTimeMs();
+    const int32_t dynamicJitterTimeMs = source->getDynamicJitterTimeMs();
     const int64_t clockRate = source->mClockRate;
 
     int64_t playedTimeMs = nowTimeMs - startTimeMs;
@@ -339,7 +339,8 @@ bool AAVCAssembler::dropFramesUntilIframe(const sp<ABuffer> &buffer) {
     return false;
 }
 
-void AAVCAssembler::addSingleNALUnit(const sp<ABuffer> &buffer) {
+void AAVCAssembler::addSingleNALUnit(
+        const sp<ABuffer> &buffer, const List<sp<ABuffer> > *fragments) {
     ALOGV("addSingleNALUnit of size %zu", buffer->size());
 #if !LOG_NDEBUG
     hexdump(buffer->data(), buffer->size());
@@ -367,7 +368,17 @@ void AAVCAssembler::addSingleNALUnit(const sp<ABuffer> &buffer) {
     }
     mAccessUnitRTPTime = rtpTime;
 
-    mNALUnits.push_back(buffer);
+    NALUnit unit;
+    unit.mBuffer = buffer;
+    unit.mSize = buffer->size();
+    if (fragments != NULL) {
+        unit.mFragments = *fragments;
+        for (List<sp<ABuffer> >::const_iterator it = fragments->begin();
+             it != fragments->end(); ++it) {
+            unit.mSize += (*it)->size() - 2;
+        }
+    }
+    mNALUnits.push_back(unit);
 }
 
 bool AAVCAssembler::addSingleTimeAggregationPacket(const sp<ABuffer> &buffer) {
@@ -517,7 +528,13 @@ ARTPAssembler::AssemblyStatus AAVCAssembler::addFragmentedNALUnit(
     // header byte.
     ++totalSize;
 
-    sp<ABuffer> unit = new ABuffer(totalSize);
+    // An SPS is parsed by checkSpsUpdated(), so it is reassembled here. Other NAL units
+    // only get their header, and keep the fragments until submitAccessUnit() copies them
+    // into the access unit.
+    bool keepFragments = nalType != 0x7;
+    List<sp<ABuffer> > fragments;
+
+    sp<ABuffer> unit = new ABuffer(keepFragments ? 1 : totalSize);
     CopyTimes(unit, *queue->begin());
 
     unit->data()[0] = (nri << 5) | nalType;
@@ -534,7 +551,11 @@ ARTPAssembler::AssemblyStatus AAVCAssembler::addFragmentedNALUnit(
         hexdump(buffer->data(), buffer->size());
 #endif
 
-        memcpy(unit->data() + offset, buffer->data() + 2, buffer->size() - 2);
+        if (keepFragments) {
+            fragments.push_back(buffer);
+        } else {
+            memcpy(unit->data() + offset, buffer->data() + 2, buffer->size() - 2);
+        }
 
         buffer->meta()->findObject("source", (sp<android::RefBase>*)&source);
         buffer->meta()->findInt32("cvo", &cvo);
@@ -543,7 +564,7 @@ ARTPAssembler::AssemblyStatus AAVCAssembler::addFragmentedNALUnit(
         it = queue->erase(it);
     }
 
-    unit->setRange(0, totalSize);
+    unit->setRange(0, keepFragments ? 1 : totalSize);
 
     if (cvo >= 0) {
         unit->meta()->setInt32("cvo", cvo);
@@ -555,7 +576,7 @@ ARTPAssembler::AssemblyStatus AAVCAssembler::addFragmentedNALUnit(
         unit->meta()->setObject("source", source);
     }
 
-    addSingleNALUnit(unit);
+    addSingleNALUnit(unit, &fragments);
 
     ALOGV("successfully assembled a NAL unit from fragments.");
 
@@ -572,27 +593,34 @@ void AAVCAssembler::submitAccessUnit() {
     }
 
     size_t totalSize = 0;
-    for (List<sp<ABuffer> >::iterator it = mNALUnits.begin();
+    for (List<NALUnit>::iterator it = mNALUnits.begin();
          it != mNALUnits.end(); ++it) {
-        totalSize += 4 + (*it)->size();
+        totalSize += 4 + it->mSize;
     }
 
     sp<ABuffer> accessUnit = new ABuffer(totalSize);
     size_t offset = 0;
     int32_t cvo = -1;
-    for (List<sp<ABuffer> >::iterator it = mNALUnits.begin();
+    for (List<NALUnit>::iterator it = mNALUnits.begin();
          it != mNALUnits.end(); ++it) {
         memcpy(accessUnit->data() + offset, "\x00\x00\x00\x01", 4);
         offset += 4;
 
-        sp<ABuffer> nal = *it;
+        sp<ABuffer> nal = it->mBuffer;
         memcpy(accessUnit->data() + offset, nal->data(), nal->size());
         offset += nal->size();
 
+        for (List<sp<ABuffer> >::iterator fragment = it->mFragments.begin();
+             fragment != it->mFragments.end(); ++fragment) {
+            memcpy(accessUnit->data() + offset,
+                    (*fragment)->data() + 2, (*fragment)->size() - 2);
+            offset += (*fragment)->size() - 2;
+        }
+
         nal->meta()->findInt32("cvo", &cvo);
     }
 
-    CopyTimes(accessUnit, *mNALUnits.begin());
+    CopyTimes(accessUnit, mNALUnits.begin()->mBuffer);
 
 #if 0
     printf(mAccessUnitDamaged ? "X" : ".");
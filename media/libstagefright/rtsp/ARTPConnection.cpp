@@ -44,6 +44,11 @@ namespace android {
 
 static const size_t kMaxUDPSize = 1500;
 
+// Largest datagram receive() accepts, and the number of datagrams it takes from a
+// socket at once.
+static const size_t kMaxDatagramSize = 65536;
+static const size_t kMaxBatchedPackets = 16;
+
 static uint16_t u16at(const uint8_t *data) {
     return data[0] << 8 | data[1];
 }
@@ -75,6 +80,9 @@ struct ARTPConnection::StreamInfo {
 
     int64_t mNumRTCPPacketsReceived;
     int64_t mNumRTPPacketsReceived;
+    // RTP packets and receive() calls reading them since the last bitrate report.
+    int64_t mNumRTPPacketsInPeriod;
+    int64_t mNumRTPBatchesInPeriod;
     struct sockaddr_in mRemoteRTCPAddr;
     struct sockaddr_in6 mRemoteRTCPAddr6;
 
@@ -95,7 +103,8 @@ ARTPConnection::ARTPConnection(uint32_t flags)
       mTargetBitrate(-1),
       mRtpSockOptEcn(0),
       mIsIPv6(false),
-      mStaticJitterTimeMs(kStaticJitterTimeMs) {
+      mStaticJitterTimeMs(kStaticJitterTimeMs),
+      mAdaptiveJitterBuffer(false) {
 }
 
 ARTPConnection::~ARTPConnection() {
@@ -381,6 +390,8 @@ void ARTPConnection::onAddStream(const sp<AMessage> &msg) {
 
     info->mNumRTCPPacketsReceived = 0;
     info->mNumRTPPacketsReceived = 0;
+    info->mNumRTPPacketsInPeriod = 0;
+    info->mNumRTPBatchesInPeriod = 0;
     memset(&info->mRemoteRTCPAddr, 0, sizeof(info->mRemoteRTCPAddr));
     memset(&info->mRemoteRTCPAddr6, 0, sizeof(info->mRemoteRTCPAddr6));
 
@@ -619,31 +630,39 @@ status_t ARTPConnection::receive(StreamInfo *s, bool receiveRTP) {
 
     CHECK(!s->mIsInjected);
 
-    sp<ABuffer> buffer = new ABuffer(65536);
+    // Datagrams are received in batches into a scratch area that is reused
+    // across calls, and then copied into buffers of their actual size.
+    if (mReceiveBuffer == NULL) {
+        mReceiveBuffer = new ABuffer(kMaxBatchedPackets * kMaxDatagramSize);
+    }
 
-    struct msghdr sMsg = {};
-    struct iovec sIov[1] = {};
+    struct mmsghdr sMsgs[kMaxBatchedPackets] = {};
+    struct iovec sIovs[kMaxBatchedPackets] = {};
 
-    sIov[0].iov_base = (char *) buffer->data();
-    sIov[0].iov_len = buffer->capacity();
+    const int cMsgSize = sizeof(struct cmsghdr) + sizeof(uint8_t);
+    char bufs[kMaxBatchedPackets][CMSG_SPACE(cMsgSize)];
 
-    sMsg.msg_iov = sIov;
-    sMsg.msg_iovlen = 1;
+    for (size_t i = 0; i < kMaxBatchedPackets; ++i) {
+        sIovs[i].iov_base = (char *) mReceiveBuffer->data() + i * kMaxDatagramSize;
+        sIovs[i].iov_len = kMaxDatagramSize;
 
-    int cMsgSize = sizeof(struct cmsghdr) + sizeof(uint8_t);
-    char buf[CMSG_SPACE(cMsgSize)];
-    sMsg.msg_control = buf;
-    sMsg.msg_controllen = sizeof(buf);
-    sMsg.msg_flags = 0;
+        struct msghdr *sMsg = &sMsgs[i].msg_hdr;
+        sMsg->msg_iov = &sIovs[i];
+        sMsg->msg_iovlen = 1;
+        sMsg->msg_control = bufs[i];
+        sMsg->msg_controllen = sizeof(bufs[i]);
+        sMsg->msg_flags = 0;
+    }
 
-    ssize_t nbytes;
+    int count;
     do {
-        // Used recvmsg to get the TOS header of incoming packet
-        nbytes = recvmsg(receiveRTP ? s->mRTPSocket : s->mRTCPSocket, &sMsg, 0);
-        mCumulativeBytes += nbytes;
-    } while (nbytes < 0 && errno == EINTR);
+        // Used recvmmsg to get the TOS header of incoming packets. Only waits
+        // for the first one, the socket was reported readable.
+        count = recvmmsg(receiveRTP ? s->mRTPSocket : s->mRTCPSocket,
+                sMsgs, kMaxBatchedPackets, MSG_WAITFORONE, NULL);
+    } while (count < 0 && errno == EINTR);
 
-    if (nbytes <= 0) {
+    if (count <= 0 || sMsgs[0].msg_len == 0) {
         ALOGW("failed to recv rtp packet. cause=%s", strerror(errno));
         // ECONNREFUSED may happen in next recvfrom() calling if one of
         // outgoing packet can not be delivered to remote by using sendto()
@@ -654,19 +673,36 @@ status_t ARTPConnection::receive(StreamInfo *s, bool receiveRTP) {
         }
     }
 
-    if (nbytes > 0) {
-        handleIpHeadersIfReceived(s, sMsg);
+    if (receiveRTP) {
+        s->mNumRTPBatchesInPeriod++;
     }
 
-    buffer->setRange(0, nbytes);
+    status_t err = OK;
+    for (int i = 0; i < count; ++i) {
+        size_t nbytes = sMsgs[i].msg_len;
+        if (nbytes == 0) {
+            continue;
+        }
+        mCumulativeBytes += nbytes;
 
-    // ALOGI("received %d bytes.", buffer->size());
+        handleIpHeadersIfReceived(s, sMsgs[i].msg_hdr);
 
-    status_t err;
-    if (receiveRTP) {
-        err = parseRTP(s, buffer);
-    } else {
-        err = parseRTCP(s, buffer);
+        sp<ABuffer> buffer = new ABuffer(nbytes);
+        memcpy(buffer->data(), sIovs[i].iov_base, nbytes);
+
+        // ALOGI("received %d bytes.", buffer->size());
+
+        status_t packetErr;
+        if (receiveRTP) {
+            s->mNumRTPPacketsInPeriod++;
+            packetErr = parseRTP(s, buffer);
+        } else {
+            packetErr = parseRTCP(s, buffer);
+        }
+
+        if (packetErr != OK) {
+            err = packetErr;
+        }
     }
 
     return err;
@@ -1266,6 +1302,7 @@ sp<ARTPSource> ARTPConnection::findSource(StreamInfo *info, uint32_t srcId) {
 
         source->setSelfID(mSelfID);
         source->setStaticJitterTimeMs(mStaticJitterTimeMs);
+        source->setAdaptiveJitterBuffer(mAdaptiveJitterBuffer);
         sp<AMessage> timer = new AMessage(kWhatAlarmStream, this);
         source->setJbTimer(timer);
         info->mSources.add(srcId, source);
@@ -1291,6 +1328,10 @@ void ARTPConnection::setStaticJitterTimeMs(const uint32_t jbTimeMs) {
     mStaticJitterTimeMs = jbTimeMs;
 }
 
+void ARTPConnection::setAdaptiveJitterBuffer(bool enable) {
+    mAdaptiveJitterBuffer = enable;
+}
+
 void ARTPConnection::setTargetBitrate(int32_t targetBitrate) {
     mTargetBitrate = targetBitrate;
 }
@@ -1344,6 +1385,14 @@ void ARTPConnection::checkRxBitrate(int64_t nowUs) {
                 continue;
             }
 
+            if (timeDiff > 0 && s->mNumRTPPacketsInPeriod > 0) {
+                ALOGI("Stream %zu Rx packet rate : %lld packets/sec, %.1f packets per receive",
+                        s->mIndex, (long long)(s->mNumRTPPacketsInPeriod / timeDiff),
+                        (double)s->mNumRTPPacketsInPeriod / s->mNumRTPBatchesInPeriod);
+            }
+            s->mNumRTPPacketsInPeriod = 0;
+            s->mNumRTPBatchesInPeriod = 0;
+
             if (s->mNumRTCPPacketsReceived == 0) {
                 // We have never received any RTCP packets on this stream,
                 // we don't even know where to send a report.
@@ -40,6 +40,11 @@ namespace android {
 
 static uint32_t kSourceID = 0xdeadbeef;
 
+// Lower bound of the jitter buffer time in adaptive mode.
+static const int32_t kMinAdaptiveJitterTimeMs = 20;
+// How long the jitter buffer keeps room for retransmissions after the last recovered packet.
+static const int64_t kRetransmissionWindowHoldUs = 5000000ll;
+
 ARTPSource::ARTPSource(
         uint32_t id,
         const sp<ASessionDescription> &sessionDesc, size_t index,
@@ -61,6 +66,10 @@ ARTPSource::ARTPSource(
       mPrevNumBuffersReceivedForRR(0),
       mLatestRtpTime(0),
       mStaticJbTimeMs(kStaticJitterTimeMs),
+      mAdaptiveJb(false),
+      mAvgRetransmissionDelayUs(0),
+      mNumRecoveredPackets(0),
+      mLastRecoveryTimeUs(-1),
       mLastSrRtpTime(0),
       mLastSrNtpTime(0),
       mLastSrUpdateTimeUs(0),
@@ -352,6 +361,8 @@ bool ARTPSource::queuePacket(const sp<ABuffer> &buffer) {
 
     mQueue.insert(it, buffer);
 
+    checkRetransmittedPacket((uint16_t)seqNum, nowUs);
+
     /**
      * RFC3550 calculates the interarrival jitter time for 'ALL packets'.
      * We calculate anothor jitter only for all 'Head NAL units'
@@ -615,6 +626,7 @@ int ARTPSource::getSeqNumToNACK(List<int>& list, int size) {
         infoNACK &info_it = it->second;
         if (info_it.needToNACK) {
             info_it.needToNACK = false;
+            info_it.sentTimeUs = ALooper::GetNowUs();
             // switch LSB to MSB for sending N/W
             uint32_t FCI;
             uint8_t *temp = (uint8_t *)&FCI;
@@ -633,7 +645,7 @@ int ARTPSource::getSeqNumToNACK(List<int>& list, int size) {
 
 void ARTPSource::setSeqNumToNACK(uint16_t seqNum, uint16_t mask, uint16_t nowJitterHeadSeqNum) {
     AutoMutex _l(mMapLock);
-    infoNACK info = {seqNum, mask, nowJitterHeadSeqNum, true};
+    infoNACK info = {seqNum, mask, nowJitterHeadSeqNum, true, -1, 0};
     std::map<uint16_t, infoNACK>::iterator it;
 
     it = mNACKMap.find(seqNum);
@@ -663,6 +675,37 @@ void ARTPSource::setSeqNumToNACK(uint16_t seqNum, uint16_t mask, uint16_t nowJit
 
 }
 
+void ARTPSource::checkRetransmittedPacket(uint16_t seqNum, int64_t nowUs) {
+    AutoMutex _l(mMapLock);
+
+    std::map<uint16_t, infoNACK>::iterator it;
+    for (it = mNACKMap.begin(); it != mNACKMap.end(); it++) {
+        infoNACK &info_it = it->second;
+        if (info_it.sentTimeUs < 0) {
+            continue;
+        }
+
+        // bit 0 is seqNum itself, bit (i + 1) is bit i of the mask.
+        uint16_t offset = seqNum - info_it.seqNum;
+        if (offset > 16 || (offset > 0 && !(info_it.mask & (1 << (offset - 1))))
+                || (info_it.recovered & (1 << offset))) {
+            continue;
+        }
+
+        info_it.recovered |= (1 << offset);
+
+        int64_t delayUs = nowUs - info_it.sentTimeUs;
+        if (mNumRecoveredPackets++ == 0) {
+            mAvgRetransmissionDelayUs = delayUs;
+        } else {
+            mAvgRetransmissionDelayUs = (mAvgRetransmissionDelayUs * 15 + delayUs) / 16;
+        }
+        mLastRecoveryTimeUs = nowUs;
+        ALOGV("recovered %d by NACK after %lld us", seqNum, (long long)delayUs);
+        break;
+    }
+}
+
 uint32_t ARTPSource::getSelfID() {
     return kSourceID;
 }
@@ -692,6 +735,34 @@ void ARTPSource::setStaticJitterTimeMs(const uint32_t jbTimeMs) {
     mStaticJbTimeMs = jbTimeMs;
 }
 
+void ARTPSource::setAdaptiveJitterBuffer(bool enable) {
+    ALOGD("setAdaptiveJitterBuffer %d", enable);
+    mAdaptiveJb = enable;
+}
+
+int32_t ARTPSource::getMinJitterTimeMs() {
+    if (!mAdaptiveJb) {
+        return mStaticJbTimeMs;
+    }
+
+    int32_t minJbTimeMs = kMinAdaptiveJitterTimeMs;
+    // Leave room for retransmitted packets while NACKs recover losses.
+    if (mLastRecoveryTimeUs >= 0
+            && ALooper::GetNowUs() - mLastRecoveryTimeUs < kRetransmissionWindowHoldUs) {
+        minJbTimeMs = std::max(minJbTimeMs, (int32_t)(mAvgRetransmissionDelayUs / 1000));
+    }
+
+    return std::min(minJbTimeMs, mStaticJbTimeMs);
+}
+
+int32_t ARTPSource::getDynamicJitterTimeMs() {
+    if (!mAdaptiveJb) {
+        return getInterArrivalJitterTimeMs();
+    }
+
+    return mJitterCalc->getPeakInterArrivalJitterMs();
+}
+
 void ARTPSource::setJbTimer(const sp<AMessage> timer) {
     mJbTimer = timer;
 }
@@ -748,7 +819,10 @@ void ARTPSource::notifyPktInfo(int32_t bitrate, int64_t nowUs, bool isRegular) {
     notify->setInt32("latest-rtp-time", mLatestRtpTime);
     notify->setInt64("recv-time-us", nowUs);
     notify->setInt32("rtp-jitter-time-ms",
-            std::max(getBaseJitterTimeMs(), getStaticJitterTimeMs()));
+            std::max(getBaseJitterTimeMs(), getMinJitterTimeMs()));
+    notify->setInt32("rtp-jitter-peak-ms", mJitterCalc->getPeakInterArrivalJitterMs());
+    notify->setInt32("rtp-recovered-packets", mNumRecoveredPackets);
+    notify->setInt32("rtp-retransmission-delay-ms", (int32_t)(mAvgRetransmissionDelayUs / 1000));
     notify->setInt32("rtp-rtcpsr-time-gap-ms", (int32_t)mAvgRtpRtcpGapMs);
     notify->post();
 
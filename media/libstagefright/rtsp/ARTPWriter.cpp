@@ -30,6 +30,8 @@
 #include <media/stagefright/MetaData.h>
 #include <utils/ByteOrder.h>
 
+#include <algorithm>
+
 #include <fcntl.h>
 #include <strings.h>
 
@@ -65,6 +67,10 @@ namespace android {
 static const size_t kMaxPacketSize = 1280;
 static char kCNAME[255] = "someone@somewhere";
 
+// Sending is paced at this multiple of the encoder bitrate, to let a key frame out
+// quickly without bursting it at the link rate.
+static const int64_t kPacingRateFactor = 4;
+
 static const size_t kTrafficRecorderMaxEntries = 128;
 static const size_t kTrafficRecorderMaxTimeSpanMs = 2000;
 
@@ -216,6 +222,11 @@ void ARTPWriter::initState() {
 
     mMode = INVALID;
     mClockRate = 16000;
+
+    mNumPendingPackets = 0;
+    mPacingBytesPerSec = 0;
+    mPacingBudgetBytes = 0;
+    mLastPacingTimeUs = -1;
 }
 
 status_t ARTPWriter::addSource(const sp<MediaSource> &source) {
@@ -289,6 +300,11 @@ status_t ARTPWriter::start(MetaData * params) {
     if (params->findInt64(kKeySocketNetwork, &sockNetwork))
         updateSocketNetwork(sockNetwork);
 
+    int32_t bitrate = 0;
+    if (mSource->getFormat()->findInt32(kKeyBitRate, &bitrate) && bitrate > 0) {
+        mPacingBytesPerSec = (int64_t)bitrate * kPacingRateFactor / 8;
+    }
+
     if (!strcasecmp(mime, MEDIA_MIMETYPE_VIDEO_AVC)) {
         // rfc6184: RTP Payload Format for H.264 Video
         // The clock rate in the "a=rtpmap" line MUST be 90000.
@@ -626,23 +642,25 @@ void ARTPWriter::onSendSR(const sp<AMessage> &msg) {
     msg->post(3000000);
 }
 
-void ARTPWriter::send(const sp<ABuffer> &buffer, bool isRTCP) {
-    int sizeSockSt;
-    struct sockaddr *remAddr;
-
+struct sockaddr *ARTPWriter::getRemoteAddr(bool isRTCP, int *sizeSockSt) {
     if (mIsIPv6) {
-        sizeSockSt = sizeof(struct sockaddr_in6);
+        *sizeSockSt = sizeof(struct sockaddr_in6);
         if (isRTCP)
-            remAddr = (struct sockaddr *)&mRTCPAddr6;
+            return (struct sockaddr *)&mRTCPAddr6;
         else
-            remAddr = (struct sockaddr *)&mRTPAddr6;
+            return (struct sockaddr *)&mRTPAddr6;
     } else {
-        sizeSockSt = sizeof(struct sockaddr_in);
+        *sizeSockSt = sizeof(struct sockaddr_in);
         if (isRTCP)
-            remAddr = (struct sockaddr *)&mRTCPAddr;
+            return (struct sockaddr *)&mRTCPAddr;
         else
-            remAddr = (struct sockaddr *)&mRTPAddr;
+            return (struct sockaddr *)&mRTPAddr;
     }
+}
+
+void ARTPWriter::send(const sp<ABuffer> &buffer, bool isRTCP) {
+    int sizeSockSt;
+    struct sockaddr *remAddr = getRemoteAddr(isRTCP, &sizeSockSt);
 
     // Unseal code if moderator is needed (prevent overflow of instant bandwidth)
     // Set limit bits per period through the moderator.
@@ -672,6 +690,107 @@ void ARTPWriter::send(const sp<ABuffer> &buffer, bool isRTCP) {
 #endif
 }
 
+ARTPWriter::PendingPacket *ARTPWriter::getPendingPacket() {
+    return &mPendingPackets[mNumPendingPackets];
+}
+
+void ARTPWriter::queuePendingPacket() {
+    if (++mNumPendingPackets == kMaxBatchedPackets) {
+        sendPendingPackets();
+    }
+}
+
+void ARTPWriter::sendPendingPackets() {
+    if (mNumPendingPackets == 0) {
+        return;
+    }
+
+    int sizeSockSt;
+    struct sockaddr *remAddr = getRemoteAddr(false /* isRTCP */, &sizeSockSt);
+
+    struct mmsghdr msgs[kMaxBatchedPackets] = {};
+    struct iovec iovs[kMaxBatchedPackets][2];
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < mNumPendingPackets; ++i) {
+        PendingPacket *packet = &mPendingPackets[i];
+        iovs[i][0].iov_base = packet->mHeader;
+        iovs[i][0].iov_len = packet->mHeaderSize;
+        iovs[i][1].iov_base = (void *)packet->mPayload;
+        iovs[i][1].iov_len = packet->mPayloadSize;
+
+        msgs[i].msg_hdr.msg_name = remAddr;
+        msgs[i].msg_hdr.msg_namelen = sizeSockSt;
+        msgs[i].msg_hdr.msg_iov = iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 2;
+
+        totalBytes += packet->mHeaderSize + packet->mPayloadSize;
+    }
+
+    paceTraffic(totalBytes);
+
+    size_t numSent = 0;
+    while (numSent < mNumPendingPackets) {
+        int n = sendmmsg(mRTPSocket, &msgs[numSent], mNumPendingPackets - numSent, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ALOGW("packets can not be sent. ret=%d, remaining=%zu",
+                    n, mNumPendingPackets - numSent);
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            // Record current traffic & Print bits while last 1sec (1000ms)
+            mTrafficRec->writeBytes(msgs[numSent + i].msg_len +
+                    (mIsIPv6 ? TCPIPV6_HEADER_SIZE : TCPIPV4_HEADER_SIZE));
+        }
+        numSent += n;
+    }
+    mTrafficRec->printAccuBitsForLastPeriod(1000, 1000);
+
+#if LOG_TO_FILES
+    for (size_t i = 0; i < mNumPendingPackets; ++i) {
+        PendingPacket *packet = &mPendingPackets[i];
+
+        uint32_t ms = tolel(ALooper::GetNowUs() / 1000ll);
+        uint32_t length = tolel(packet->mHeaderSize + packet->mPayloadSize);
+        write(mRTPFd, &ms, sizeof(ms));
+        write(mRTPFd, &length, sizeof(length));
+        write(mRTPFd, packet->mHeader, packet->mHeaderSize);
+        write(mRTPFd, packet->mPayload, packet->mPayloadSize);
+    }
+#endif
+
+    mNumPendingPackets = 0;
+}
+
+void ARTPWriter::paceTraffic(size_t bytes) {
+    if (mPacingBytesPerSec <= 0) {
+        return;
+    }
+
+    // Token bucket holding up to one batch of packets.
+    const int64_t maxBudgetBytes = kMaxBatchedPackets * kMaxPacketSize;
+    int64_t nowUs = ALooper::GetNowUs();
+    if (mLastPacingTimeUs < 0) {
+        mPacingBudgetBytes = maxBudgetBytes;
+    } else {
+        mPacingBudgetBytes = std::min(maxBudgetBytes,
+                mPacingBudgetBytes + (nowUs - mLastPacingTimeUs) * mPacingBytesPerSec / 1000000ll);
+    }
+    mLastPacingTimeUs = nowUs;
+
+    mPacingBudgetBytes -= (int64_t)bytes;
+    if (mPacingBudgetBytes < 0) {
+        int64_t delayUs = -mPacingBudgetBytes * 1000000ll / mPacingBytesPerSec;
+        ALOGV("pacing %zu bytes, waiting %lld us", bytes, (long long)delayUs);
+        usleep(delayUs);
+        mPacingBudgetBytes = 0;
+        mLastPacingTimeUs = ALooper::GetNowUs();
+    }
+}
+
 void ARTPWriter::addSR(const sp<ABuffer> &buffer) {
     uint8_t *data = buffer->data() + buffer->size();
 
@@ -1135,7 +1254,8 @@ void ARTPWriter::sendHEVCData(MediaBufferBase *mediaBuf) {
                     RTP_HEADER_EXT_SIZE - RTP_FU_HEADER_SIZE - RTP_PAYLOAD_ROOM_SIZE;
             }
 
-            uint8_t *data = buffer->data();
+            PendingPacket *packet = getPendingPacket();
+            uint8_t *data = packet->mHeader;
             data[0] = 0x80;
             if (lastPacket && mRTPCVOExtMap > 0) {
                 data[0] |= 0x10;
@@ -1195,19 +1315,20 @@ void ARTPWriter::sendHEVCData(MediaBufferBase *mediaBuf) {
                 | (nalType & H265_NALU_MASK);
             ALOGV("H265 FU indicator 0x%x", data[14]);
 
-            memcpy(&data[15 + rtpExtIndex], &mediaData[offset], size);
-
-            buffer->setRange(0, 15 + rtpExtIndex + size);
-
-            send(buffer, false /* isRTCP */);
+            packet->mHeaderSize = 15 + rtpExtIndex;
+            packet->mPayload = &mediaData[offset];
+            packet->mPayloadSize = size;
+            queuePendingPacket();
 
             ++mSeqNo;
             ++mNumRTPSent;
-            mNumRTPOctetsSent += buffer->size() - (12 + rtpExtIndex);
+            mNumRTPOctetsSent += packet->mHeaderSize + size - (12 + rtpExtIndex);
 
             firstPacket = false;
             offset += size;
         }
+
+        sendPendingPackets();
     }
 }
 
@@ -1322,7 +1443,8 @@ void ARTPWriter::sendAVCData(MediaBufferBase *mediaBuf) {
                     RTP_HEADER_EXT_SIZE - RTP_FU_HEADER_SIZE - RTP_PAYLOAD_ROOM_SIZE;
             }
 
-            uint8_t *data = buffer->data();
+            PendingPacket *packet = getPendingPacket();
+            uint8_t *data = packet->mHeader;
             data[0] = 0x80;
             if (lastPacket && mRTPCVOExtMap > 0) {
                 data[0] |= 0x10;
@@ -1379,19 +1501,20 @@ void ARTPWriter::sendAVCData(MediaBufferBase *mediaBuf) {
                 | (nalType & H264_NALU_MASK);
             ALOGV("H264 FU header 0x%x", data[13]);
 
-            memcpy(&data[14 + rtpExtIndex], &mediaData[offset], size);
-
-            buffer->setRange(0, 14 + rtpExtIndex + size);
-
-            send(buffer, false /* isRTCP */);
+            packet->mHeaderSize = 14 + rtpExtIndex;
+            packet->mPayload = &mediaData[offset];
+            packet->mPayloadSize = size;
+            queuePendingPacket();
 
             ++mSeqNo;
             ++mNumRTPSent;
-            mNumRTPOctetsSent += buffer->size() - (12 + rtpExtIndex);
+            mNumRTPOctetsSent += packet->mHeaderSize + size - (12 + rtpExtIndex);
 
             firstPacket = false;
             offset += size;
         }
+
+        sendPendingPackets();
     }
 }
 
@@ -21,6 +21,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 namespace android {
 
 JitterCalc::JitterCalc(int32_t clockRate)
@@ -36,6 +38,10 @@ void JitterCalc::init(uint32_t rtpTime, int64_t arrivalTimeUs, int32_t base, int
 
     mBaseJitterUs = base;
     mInterArrivalJitterUs = inter;
+
+    mNumVariances = 0;
+    mNextVariance = 0;
+    mPeakInterArrivalJitterUs = inter;
 }
 
 void JitterCalc::putBaseData(uint32_t rtpTime, int64_t arrivalTimeUs) {
@@ -66,10 +72,29 @@ void JitterCalc::putInterArrivalData(uint32_t rtpTime, int64_t arrivalTimeUs) {
     int64_t varianceUs = diffArrivalUs - diffTimeStampUs;
     mInterArrivalJitterUs = (mInterArrivalJitterUs * 15 + abs(varianceUs)) / 16;
 
+    mVariancesUs[mNextVariance] = std::min(abs(varianceUs), (int64_t)INT32_MAX);
+    mNextVariance = (mNextVariance + 1) % kNumVariances;
+    if (mNumVariances < kNumVariances) {
+        ++mNumVariances;
+    }
+    // The percentile is not needed per packet, refresh it every few samples.
+    if (mNextVariance % 16 == 0) {
+        updatePeakInterArrivalJitter();
+    }
+
     mLastTimeStamp = rtpTime;
     mLastArrivalTimeUs = arrivalTimeUs;
 }
 
+void JitterCalc::updatePeakInterArrivalJitter() {
+    int32_t variancesUs[kNumVariances];
+    std::copy(mVariancesUs, mVariancesUs + mNumVariances, variancesUs);
+
+    size_t index = mNumVariances * 95 / 100;
+    std::nth_element(variancesUs, variancesUs + index, variancesUs + mNumVariances);
+    mPeakInterArrivalJitterUs = variancesUs[index];
+}
+
 int32_t JitterCalc::getBaseJitterMs() {
     return mBaseJitterUs / 1000;
 }
@@ -78,5 +103,9 @@ int32_t JitterCalc::getInterArrivalJitterMs() {
     return mInterArrivalJitterUs / 1000;
 }
 
+int32_t JitterCalc::getPeakInterArrivalJitterMs() {
+    return mPeakInterArrivalJitterUs / 1000;
+}
+
 }   // namespace android
 
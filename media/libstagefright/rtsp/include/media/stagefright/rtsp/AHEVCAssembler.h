@@ -53,14 +53,24 @@ private:
     uint64_t mLastIFrameProvidedAtMs;
     int32_t mWidth;
     int32_t mHeight;
-    List<sp<ABuffer> > mNALUnits;
+
+    // A NAL unit of the current access unit. mBuffer holds the whole NAL unit, or for a
+    // NAL unit received in fragmentation units, only its header, followed by the payloads
+    // of mFragments (the FU packets, with their 3 byte FU headers).
+    struct NALUnit {
+        sp<ABuffer> mBuffer;
+        List<sp<ABuffer> > mFragments;
+        size_t mSize;
+    };
+    List<NALUnit> mNALUnits;
 
     int32_t addNack(const sp<ARTPSource> &source);
     void checkSpsUpdated(const sp<ABuffer> &buffer);
     void checkIFrameProvided(const sp<ABuffer> &buffer);
     bool dropFramesUntilIframe(const sp<ABuffer> &buffer);
     AssemblyStatus addNALUnit(const sp<ARTPSource> &source);
-    void addSingleNALUnit(const sp<ABuffer> &buffer);
+    void addSingleNALUnit(
+            const sp<ABuffer> &buffer, const List<sp<ABuffer> > *fragments = NULL);
     AssemblyStatus addFragmentedNALUnit(List<sp<ABuffer> > *queue);
     bool addSingleTimeAggregationPacket(const sp<ABuffer> &buffer);
 
@@ -48,6 +48,7 @@ struct ARTPConnection : public AHandler {
 
     void setSelfID(const uint32_t selfID);
     void setStaticJitterTimeMs(const uint32_t jbTimeMs);
+    void setAdaptiveJitterBuffer(bool enable);
     void setTargetBitrate(int32_t targetBitrate);
     void setRtpSockOptEcn(int32_t sockOptEcn);
     void setIsIPv6(const char *localIp);
@@ -100,9 +101,13 @@ private:
     bool mIsIPv6;
 
     uint32_t mStaticJitterTimeMs;
+    bool mAdaptiveJitterBuffer;
 
     int32_t mCumulativeBytes;
 
+    // Scratch area receive() reads datagrams into.
+    sp<ABuffer> mReceiveBuffer;
+
     void onAddStream(const sp<AMessage> &msg);
     void onSeekStream(const sp<AMessage> &msg);
     void onRemoveStream(const sp<AMessage> &msg);
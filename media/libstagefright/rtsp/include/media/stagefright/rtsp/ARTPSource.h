@@ -82,6 +82,12 @@ struct ARTPSource : public RefBase {
     int32_t getBaseJitterTimeMs();
     int32_t getInterArrivalJitterTimeMs();
     void setStaticJitterTimeMs(const uint32_t jbTimeMs);
+    // In adaptive mode the jitter buffer follows the measured jitter and NACK recovery
+    // delay, and the static jitter time is only an upper bound of its minimum depth.
+    void setAdaptiveJitterBuffer(bool enable);
+    // Minimum depth of the jitter buffer, and the allowance for interarrival jitter on top.
+    int32_t getMinJitterTimeMs();
+    int32_t getDynamicJitterTimeMs();
     void setJbTimer(const sp<AMessage> timer);
     void setJbAlarmTime(int64_t nowTimeUs, int64_t alarmAfterUs);
 
@@ -119,6 +125,7 @@ private:
     sp<ARTPAssembler> mAssembler;
 
     int32_t mStaticJbTimeMs;
+    bool mAdaptiveJb;
     sp<JitterCalc> mJitterCalc;
     sp<AMessage> mJbTimer;
 
@@ -127,12 +134,22 @@ private:
         uint16_t mask;
         uint16_t nowJitterHeadSeqNum;
         bool    needToNACK;
+        int64_t sentTimeUs;
+        // seqNum and the packets of mask that were received after the NACK was sent.
+        uint32_t recovered;
     } infoNACK;
 
     Mutex mMapLock;
     std::map<uint16_t, infoNACK> mNACKMap;
     int getSeqNumToNACK(List<int>& list, int size);
 
+    // Average delay between a NACK and the retransmitted packet, for the packets
+    // recovered that way.
+    int64_t mAvgRetransmissionDelayUs;
+    int32_t mNumRecoveredPackets;
+    int64_t mLastRecoveryTimeUs;
+    void checkRetransmittedPacket(uint16_t seqNum, int64_t nowUs);
+
     uint32_t mLastSrRtpTime;
     uint64_t mLastSrNtpTime;
     int64_t mLastSrUpdateTimeUs;
@@ -122,6 +122,25 @@ private:
     typedef uint64_t Bytes;
     sp<TrafficRecorder<uint32_t /* Time */, Bytes> > mTrafficRec;
 
+    // Fragmentation units waiting for sendPendingPackets(), which sends them with one
+    // sendmmsg() call. The payloads point into the media buffer being sent, the headers
+    // (RTP header, CVO extension and FU headers) are built here.
+    static const size_t kMaxBatchedPackets = 16;
+    static const size_t kMaxPendingHeaderSize = 24;
+    struct PendingPacket {
+        uint8_t mHeader[kMaxPendingHeaderSize];
+        size_t mHeaderSize;
+        const uint8_t *mPayload;
+        size_t mPayloadSize;
+    };
+    PendingPacket mPendingPackets[kMaxBatchedPackets];
+    size_t mNumPendingPackets;
+
+    // Pacing of the RTP packets, see paceTraffic().
+    int64_t mPacingBytesPerSec;
+    int64_t mPacingBudgetBytes;
+    int64_t mLastPacingTimeUs;
+
     int32_t mNumSRsSent;
     int32_t mRTPCVOExtMap;
     int32_t mRTPCVODegrees;
@@ -157,7 +176,12 @@ private:
     void sendH263Data(MediaBufferBase *mediaBuf);
     void sendAMRData(MediaBufferBase *mediaBuf);
 
+    struct sockaddr *getRemoteAddr(bool isRTCP, int *sizeSockSt);
     void send(const sp<ABuffer> &buffer, bool isRTCP);
+    PendingPacket *getPendingPacket();
+    void queuePendingPacket();
+    void sendPendingPackets();
+    void paceTraffic(size_t bytes);
     void makeSocketPairAndBind(String8& localIp, int localPort, String8& remoteIp, int remotePort);
 
     void ModerateInstantTraffic(uint32_t samplePeriod, uint32_t limitBytes);
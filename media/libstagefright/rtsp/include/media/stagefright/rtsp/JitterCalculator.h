@@ -36,6 +36,15 @@ private:
     int32_t mBaseJitterUs;
     int32_t mInterArrivalJitterUs;
 
+    // Recent interarrival variances, to follow the peaks the average smooths out.
+    static const size_t kNumVariances = 128;
+    int32_t mVariancesUs[kNumVariances];
+    size_t mNumVariances;
+    size_t mNextVariance;
+    int32_t mPeakInterArrivalJitterUs;
+
+    void updatePeakInterArrivalJitter();
+
 public:
     JitterCalc(int32_t clockRate);
 
@@ -44,6 +53,8 @@ public:
     void putBaseData(uint32_t rtpTime, int64_t arrivalTimeUs);
     int32_t getBaseJitterMs();
     int32_t getInterArrivalJitterMs();
+    // 95th percentile of the recent interarrival variances.
+    int32_t getPeakInterArrivalJitterMs();
 };
 
 }   // namespace android
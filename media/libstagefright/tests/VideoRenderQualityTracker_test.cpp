@@ -423,6 +423,17 @@ TEST_F(VideoRenderQualityTrackerTest, countsRenderedFrames) {
     EXPECT_EQ(7, h.getMetrics().frameRenderedCount);
 }
 
+TEST_F(VideoRenderQualityTrackerTest, whenManyFramesArePending_countsDroppedFrames) {
+    Configuration c;
+    Helper h(16.66, c);
+    h.render({16.66, 16.66, 16.66});
+    h.drop(200); // more frames than are tracked while pending
+    h.render({16.66, 16.66, 16.66});
+    EXPECT_EQ(200, h.getMetrics().frameDroppedCount);
+    EXPECT_EQ(6, h.getMetrics().frameRenderedCount);
+    EXPECT_EQ(1, h.getMetrics().freezeDurationMsHistogram.getCount());
+}
+
 TEST_F(VideoRenderQualityTrackerTest, detectsFrameRate) {
     Configuration c;
     c.frameRateDetectionToleranceUs = 2 * 1000; // 2 ms
@@ -46,7 +46,7 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     }
 
     while (fdp.remaining_bytes()) {
-        uint8_t switchCase = fdp.ConsumeIntegralInRange<uint8_t>(0, 3);
+        uint8_t switchCase = fdp.ConsumeIntegralInRange<uint8_t>(0, 4);
         switch (switchCase) {
             case 0: {
                 int64_t frameTimeUs = fdp.ConsumeIntegral<int64_t>();
@@ -74,6 +74,15 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
                                          /*thumbnail*/ fdp.ConsumeBool());
                 break;
             }
+            case 4: {
+                std::vector<int64_t> frameTimesUs(fdp.ConsumeIntegralInRange<size_t>(0, 8));
+                for (int64_t &frameTimeUs : frameTimesUs) {
+                    frameTimeUs = fdp.ConsumeIntegral<int64_t>();
+                }
+                std::vector<sp<IMemory>> frames;
+                decoder->extractFrames(frameTimesUs, &frames);
+                break;
+            }
         }
     }
 
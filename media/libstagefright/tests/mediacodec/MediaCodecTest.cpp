@@ -443,3 +443,55 @@ TEST(MediaCodecTest, DeadWhileStoppingError) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
     looper->stop();
 }
+
+TEST(MediaCodecTest, QueueInputBuffersNotExecuting) {
+    static const AString kCodecName{"test.codec"};
+    static const AString kCodecOwner{"nobody"};
+    static const AString kMediaType{"audio/x-test"};
+
+    sp<MockCodec> mockCodec;
+    std::function<sp<CodecBase>(const AString &name, const char *owner)> getCodecBase =
+        [&mockCodec](const AString &, const char *) {
+            mockCodec = new MockCodec([](const std::shared_ptr<MockBufferChannel> &channel) {
+                // Nothing may reach the buffer channel before the codec is started.
+                EXPECT_CALL(*channel, queueInputBuffer(_)).Times(0);
+            });
+            ON_CALL(*mockCodec, initiateAllocateComponent(_))
+                .WillByDefault([mockCodec](const sp<AMessage> &) {
+                    mockCodec->callback()->onComponentAllocated(kCodecName.c_str());
+                });
+            ON_CALL(*mockCodec, initiateConfigureComponent(_))
+                .WillByDefault([mockCodec](const sp<AMessage> &msg) {
+                    mockCodec->callback()->onComponentConfigured(
+                            msg->dup(), msg->dup());
+                });
+            ON_CALL(*mockCodec, initiateShutdown(_))
+                .WillByDefault([mockCodec](bool) {
+                    mockCodec->callback()->onReleaseCompleted();
+                });
+            return mockCodec;
+        };
+
+    sp<ALooper> looper{new ALooper};
+    sp<MediaCodec> codec = SetupMediaCodec(
+            kCodecOwner, kCodecName, kMediaType, looper, getCodecBase);
+    ASSERT_NE(nullptr, codec) << "Codec must not be null";
+    ASSERT_NE(nullptr, mockCodec) << "MockCodec must not be null";
+
+    size_t numQueued = 1;
+    EXPECT_EQ(OK, codec->queueInputBuffers({}, &numQueued));
+    EXPECT_EQ(0u, numQueued);
+
+    codec->configure(new AMessage, nullptr, nullptr, 0);
+    std::vector<MediaCodec::InputBufferInfo> buffers(3);
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        buffers[i] = {i /* index */, 0 /* offset */, 16 /* size */,
+                      (int64_t)i * 1000 /* presentationTimeUs */, 0 /* flags */};
+    }
+    numQueued = 1;
+    EXPECT_EQ(INVALID_OPERATION, codec->queueInputBuffers(buffers, &numQueued));
+    EXPECT_EQ(0u, numQueued);
+
+    codec->release();
+    looper->stop();
+}
@@ -30,7 +30,6 @@
 #include <unistd.h>
 #include <errno.h>
 #include <fcntl.h>
-#include <sys/mman.h>
 
 using namespace android;
 using namespace webm;
@@ -111,25 +110,29 @@ uint8_t *WebmElement::serialize(uint64_t& size) {
 }
 
 int WebmElement::write(int fd, uint64_t& size) {
-    uint8_t buf[8];
-    size = totalSize();
-    off64_t off = ::lseek64(fd, (size - 1), SEEK_CUR) - (size - 1);
-    ::write(fd, buf, 1); // extend file
-
-    off64_t curOff = off + size;
-    off64_t alignedOff = off & ~(::sysconf(_SC_PAGE_SIZE) - 1);
-    off64_t mapSize = curOff - alignedOff;
-    off64_t pageOff = off - alignedOff;
-    void *dst = ::mmap64(NULL, mapSize, PROT_WRITE, MAP_SHARED, fd, alignedOff);
-    if (dst == MAP_FAILED) {
-        ALOGE("mmap64 failed; errno = %d", errno);
-        ALOGE("fd %d; flags: %o", fd, ::fcntl(fd, F_GETFL, 0));
-        return errno;
-    } else {
-        serializeInto((uint8_t*) dst + pageOff);
-        ::msync(dst, mapSize, MS_SYNC);
-        return ::munmap(dst, mapSize);
+    // Serialize the element into memory and write it out with plain write() calls; clusters
+    // are written one at a time, so this avoids mapping and synchronously flushing the range
+    // of the file that each of them covers.
+    uint8_t *buf = serialize(size);
+    uint8_t *cur = buf;
+    uint64_t remaining = size;
+    while (remaining > 0) {
+        ssize_t n = ::write(fd, cur, remaining);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            int err = n < 0 ? errno : ENOSPC;
+            ALOGE("write failed; errno = %d", err);
+            ALOGE("fd %d; flags: %o", fd, ::fcntl(fd, F_GETFL, 0));
+            delete[] buf;
+            return err;
+        }
+        cur += n;
+        remaining -= n;
     }
+    delete[] buf;
+    return 0;
 }
 
 //=================================================================================================
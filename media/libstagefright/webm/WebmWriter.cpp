@@ -28,6 +28,8 @@
 
 #include <utils/Errors.h>
 
+#include <errno.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -432,6 +434,11 @@ status_t WebmWriter::reset() {
     sp<WebmElement> space = new EbmlVoid(kMaxMetaSeekSize - metaSeekSize);
     space->write(mFd, spaceSize);
 
+    // Clusters are no longer synced one by one as they are written; flush the file once.
+    if (::fsync(mFd) != 0) {
+        ALOGW("(ignored) fsync err: %s(%d)", strerror(errno), errno);
+    }
+
     release();
     return err;
 }
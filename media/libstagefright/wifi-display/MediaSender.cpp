@@ -44,6 +44,9 @@ MediaSender::MediaSender(
       mGeneration(0),
       mPrevTimeUs(-1ll),
       mInitDoneCount(0),
+      mSendLatencySumUs(0ll),
+      mSendLatencyMaxUs(0ll),
+      mNumSendLatencySamples(0),
       mLogFile(NULL) {
     // mLogFile = fopen("/data/misc/log.ts", "wb");
 }
@@ -211,9 +214,19 @@ status_t MediaSender::queueAccessUnit(
         return -ERANGE;
     }
 
+    TrackInfo *info = &mTrackInfos.editItemAt(trackIndex);
+
+    if (!info->mIsAudio) {
+        updateSendLatency(accessUnit);
+    }
+
     if (mMode == MODE_TRANSPORT_STREAM) {
-        TrackInfo *info = &mTrackInfos.editItemAt(trackIndex);
-        info->mAccessUnits.push_back(accessUnit);
+        sp<ABuffer> fullAccessUnit = appendSlice(info, accessUnit);
+        if (fullAccessUnit == NULL) {
+            return OK;
+        }
+
+        info->mAccessUnits.push_back(fullAccessUnit);
 
         mTSPacketizer->extractCSDIfNecessary(info->mPacketizerTrackIndex);
 
@@ -273,8 +286,6 @@ status_t MediaSender::queueAccessUnit(
         }
     }
 
-    TrackInfo *info = &mTrackInfos.editItemAt(trackIndex);
-
     return info->mSender->queueBuffer(
             accessUnit,
             info->mIsAudio ? 96 : 97 /* packetType */,
@@ -355,6 +366,18 @@ void MediaSender::onSenderNotify(const sp<AMessage> &msg) {
             notify->setInt32("what", kWhatInformSender);
             notify->setInt64("avgLatencyUs", avgLatencyUs);
             notify->setInt64("maxLatencyUs", maxLatencyUs);
+
+            if (mNumSendLatencySamples > 0) {
+                notify->setInt64(
+                        "avgSendLatencyUs",
+                        mSendLatencySumUs / (int64_t)mNumSendLatencySamples);
+                notify->setInt64("maxSendLatencyUs", mSendLatencyMaxUs);
+
+                mSendLatencySumUs = 0ll;
+                mSendLatencyMaxUs = 0ll;
+                mNumSendLatencySamples = 0;
+            }
+
             notify->post();
             break;
         }
@@ -385,6 +408,65 @@ void MediaSender::notifyNetworkStall(size_t numBytesQueued) {
     notify->post();
 }
 
+void MediaSender::updateSendLatency(const sp<ABuffer> &accessUnit) {
+    // Media time stamps are in the ALooper::GetNowUs() time base.
+    int64_t timeUs;
+    CHECK(accessUnit->meta()->findInt64("timeUs", &timeUs));
+
+    int64_t latencyUs = ALooper::GetNowUs() - timeUs;
+    if (latencyUs < 0ll) {
+        return;
+    }
+
+    mSendLatencySumUs += latencyUs;
+    if (latencyUs > mSendLatencyMaxUs) {
+        mSendLatencyMaxUs = latencyUs;
+    }
+    ++mNumSendLatencySamples;
+}
+
+// Returns the complete access unit once its last slice has been queued, or
+// NULL while more slices of it are expected.
+sp<ABuffer> MediaSender::appendSlice(
+        TrackInfo *info, const sp<ABuffer> &slice) {
+    int32_t partial;
+    bool isPartial = slice->meta()->findInt32("partial", &partial) && partial;
+
+    if (info->mPartialAccessUnit == NULL) {
+        if (!isPartial) {
+            return slice;
+        }
+
+        info->mPartialAccessUnit = new ABuffer(slice->size());
+        info->mPartialAccessUnit->setRange(0, 0);
+        info->mPartialAccessUnit->meta()->extend(slice->meta());
+    }
+
+    sp<ABuffer> accessUnit = info->mPartialAccessUnit;
+    size_t size = accessUnit->size() + slice->size();
+    if (size > accessUnit->capacity()) {
+        sp<ABuffer> larger = new ABuffer(size * 2);
+        memcpy(larger->data(), accessUnit->data(), accessUnit->size());
+        larger->setRange(0, accessUnit->size());
+        larger->meta()->extend(accessUnit->meta());
+        accessUnit = larger;
+    }
+
+    memcpy(accessUnit->data() + accessUnit->size(),
+           slice->data(), slice->size());
+    accessUnit->setRange(0, size);
+
+    if (isPartial) {
+        info->mPartialAccessUnit = accessUnit;
+        return NULL;
+    }
+
+    info->mPartialAccessUnit.clear();
+    accessUnit->meta()->removeEntryByName("partial");
+
+    return accessUnit;
+}
+
 status_t MediaSender::packetizeAccessUnit(
         size_t trackIndex,
         sp<ABuffer> accessUnit,
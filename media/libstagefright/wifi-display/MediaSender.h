@@ -38,6 +38,10 @@ struct TSPacketizer;
 // track to RTP channel or muxing all tracks into a single RTP channel and
 // using transport stream encapsulation.
 // Optionally the (video) data is encrypted using the provided hdcp object.
+// Video access units may also be queued one or more slices at a time, with
+// "partial" set in the meta data of all but the last buffer of each frame.
+// In elementary stream mode they are sent as they arrive, in transport stream
+// mode they are reassembled into whole access units first.
 struct MediaSender : public AHandler {
     enum {
         kWhatInitDone,
@@ -90,6 +94,7 @@ private:
         uint32_t mFlags;
         sp<RTPSender> mSender;
         List<sp<ABuffer> > mAccessUnits;
+        sp<ABuffer> mPartialAccessUnit;
         ssize_t mPacketizerTrackIndex;
         bool mIsAudio;
     };
@@ -110,6 +115,12 @@ private:
 
     size_t mInitDoneCount;
 
+    // Time from capture to being handed to the RTP sender, for video slices
+    // and access units queued since the last sink latency report.
+    int64_t mSendLatencySumUs;
+    int64_t mSendLatencyMaxUs;
+    size_t mNumSendLatencySamples;
+
     FILE *mLogFile;
 
     void onSenderNotify(const sp<AMessage> &msg);
@@ -118,6 +129,9 @@ private:
     void notifyError(status_t err);
     void notifyNetworkStall(size_t numBytesQueued);
 
+    void updateSendLatency(const sp<ABuffer> &accessUnit);
+    sp<ABuffer> appendSlice(TrackInfo *info, const sp<ABuffer> &slice);
+
     status_t packetizeAccessUnit(
             size_t trackIndex,
             sp<ABuffer> accessUnit,
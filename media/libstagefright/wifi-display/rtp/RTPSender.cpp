@@ -296,7 +296,8 @@ status_t RTPSender::queueTSPackets(
                 udpPacket,
                 true /* storeInHistory */,
                 isLastPacket /* timeValid */,
-                timeUs);
+                timeUs,
+                isLastPacket /* flush */);
 
         if (err != OK) {
             return err;
@@ -313,6 +314,10 @@ status_t RTPSender::queueAVCBuffer(
 
     uint32_t rtpTime = (timeUs * 9 / 100ll);
 
+    int32_t partial;
+    bool isPartial =
+        accessUnit->meta()->findInt32("partial", &partial) && partial;
+
     List<sp<ABuffer> > packets;
 
     sp<ABuffer> out = new ABuffer(kMaxUDPPacketSize);
@@ -429,7 +434,7 @@ status_t RTPSender::queueAVCBuffer(
         dst[0] = 0x80;
 
         dst[1] = packetType;
-        if (last) {
+        if (last && !isPartial) {
             dst[1] |= 1 << 7;  // M-bit
         }
 
@@ -446,7 +451,12 @@ status_t RTPSender::queueAVCBuffer(
         dst[10] = (kSourceID >> 8) & 0xff;
         dst[11] = kSourceID & 0xff;
 
-        status_t err = sendRTPPacket(out, true /* storeInHistory */);
+        status_t err = sendRTPPacket(
+                out,
+                true /* storeInHistory */,
+                false /* timeValid */,
+                -1ll /* timeUs */,
+                last /* flush */);
 
         if (err != OK) {
             return err;
@@ -458,12 +468,12 @@ status_t RTPSender::queueAVCBuffer(
 
 status_t RTPSender::sendRTPPacket(
         const sp<ABuffer> &buffer, bool storeInHistory,
-        bool timeValid, int64_t timeUs) {
+        bool timeValid, int64_t timeUs, bool flush) {
     CHECK(mRTPConnected);
 
     status_t err = mNetSession->sendRequest(
             mRTPSessionID, buffer->data(), buffer->size(),
-            timeValid, timeUs);
+            timeValid, timeUs, flush);
 
     if (err != OK) {
         return err;
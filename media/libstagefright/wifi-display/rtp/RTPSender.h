@@ -51,6 +51,9 @@ struct RTPSender : public RTPBase, public AHandler {
               TransportMode rtcpMode,
               int32_t *outLocalRTPPort);
 
+    // For PACKETIZATION_H264 the buffer may hold only some of the slices of
+    // an access unit, in which case its meta data has "partial" set and the
+    // marker bit is left clear on its last packet.
     status_t queueBuffer(
             const sp<ABuffer> &buffer,
             uint8_t packetType,
@@ -98,7 +101,8 @@ private:
 
     status_t sendRTPPacket(
             const sp<ABuffer> &packet, bool storeInHistory,
-            bool timeValid = false, int64_t timeUs = -1ll);
+            bool timeValid = false, int64_t timeUs = -1ll,
+            bool flush = true);
 
     void onNetNotify(bool isRTP, const sp<AMessage> &msg);
 
@@ -55,7 +55,8 @@ Converter::Converter(
       mIsH264(false),
       mIsPCMAudio(false),
       mNeedToManuallyPrependSPSPPS(false),
-      mDoMoreWorkPending(false)
+      mDoMoreWorkPending(false),
+      mInPartialVideoFrame(false)
 #if ENABLE_SILENCE_DETECTION
       ,mFirstSilentFrameUs(-1ll)
       ,mInSilentMode(false)
@@ -191,6 +192,12 @@ status_t Converter::initEncoder() {
         // to recover from a lost/corrupted packet.
         mbs = (((width + 15) / 16) * ((height + 15) / 16) * 10) / 100;
         mOutputFormat->setInt32("intra-refresh-CIR-mbs", mbs);
+
+        // Ask the encoder to emit slices as soon as they are done, so they
+        // can be sent before the rest of the frame has been encoded.
+        if (GetInt32Property("media.wfd.low-latency", 0)) {
+            mOutputFormat->setInt32("low-latency", 1);
+        }
     }
 
     ALOGV("output format is '%s'", mOutputFormat->debugString(0).c_str());
@@ -765,9 +772,17 @@ status_t Converter::doMoreWork() {
                     mOutputFormat->setBuffer("csd-0", buffer);
                 }
             } else {
+                bool isFirstSlice = !mInPartialVideoFrame;
+                mInPartialVideoFrame = mIsVideo && !handle
+                        && (flags & MediaCodec::BUFFER_FLAG_PARTIAL_FRAME);
+                if (mInPartialVideoFrame) {
+                    buffer->meta()->setInt32("partial", 1);
+                }
+
                 if (mNeedToManuallyPrependSPSPPS
                         && mIsH264
                         && (mFlags & FLAG_PREPEND_CSD_IF_NECESSARY)
+                        && isFirstSlice
                         && IsIDR(buffer->data(), buffer->size())) {
                     buffer = prependCSD(buffer);
                 }
@@ -125,6 +125,10 @@ private:
 
     sp<ABuffer> mPartialAudioAU;
 
+    // True while the encoder is part way through emitting the slices of a
+    // video frame.
+    bool mInPartialVideoFrame;
+
     int32_t mPrevVideoBitrate;
 
     int32_t mNumFramesToDrop;
@@ -674,6 +674,18 @@ void WifiDisplaySource::PlaybackSession::onSinkFeedback(const sp<AMessage> &msg)
           avgLatencyUs / 1000ll,
           maxLatencyUs / 1000ll);
 
+    // The sink measures from the time a packet was sent, add the time spent
+    // before that for an estimate of the glass-to-glass latency.
+    int64_t avgSendLatencyUs, maxSendLatencyUs;
+    if (msg->findInt64("avgSendLatencyUs", &avgSendLatencyUs)
+            && msg->findInt64("maxSendLatencyUs", &maxSendLatencyUs)) {
+        ALOGI("capture to send avg. latency of %lld ms (max %lld ms), "
+              "avg. glass-to-glass latency of %lld ms",
+              avgSendLatencyUs / 1000ll,
+              maxSendLatencyUs / 1000ll,
+              (avgSendLatencyUs + avgLatencyUs) / 1000ll);
+    }
+
     if (mVideoTrackIndex >= 0) {
         const sp<Track> &videoTrack = mTracks.valueFor(mVideoTrackIndex);
         sp<Converter> converter = videoTrack->converter();
@@ -333,6 +333,8 @@ GraphicBufferSource::GraphicBufferSource() :
     mStopTimeUs(-1),
     mLastActionTimeUs(-1LL),
     mSkipFramesBeforeNs(-1LL),
+    mNumFramesDropped(0),
+    mNumFramesRepeated(0),
     mFrameRepeatIntervalUs(-1LL),
     mRepeatLastFrameGeneration(0),
     mOutstandingFrameRepeatCount(0),
@@ -419,6 +421,8 @@ status_t GraphicBufferSource::start() {
     CHECK(!mExecuting);
     mExecuting = true;
     mLastDataspace = HAL_DATASPACE_UNKNOWN;
+    mNumFramesDropped = 0;
+    mNumFramesRepeated = 0;
     ALOGV("clearing last dataSpace");
 
     // Start by loading up as many buffers as possible.  We want to do this,
@@ -471,6 +475,8 @@ status_t GraphicBufferSource::stop() {
         // We are only interested in the transition from executing->idle,
         // not loaded->idle.
         mExecuting = false;
+        ALOGD("stop: %lld frames dropped, %lld frames repeated",
+                (long long)mNumFramesDropped, (long long)mNumFramesRepeated);
     }
     return OK;
 }
@@ -570,7 +576,10 @@ status_t GraphicBufferSource::onInputBufferEmptied(codec_buffer_id bufferId, int
         CHECK(!mEndOfStreamSent);
         ALOGV("onInputBufferEmptied: buffer freed, feeding codec (available=%zu+%d, eos=%d)",
                 mAvailableBuffers.size(), mNumAvailableUnacquiredBuffers, mEndOfStream);
-        fillCodecBuffer_l();
+        // Frames that are dropped or skipped leave the codec buffer free, so keep
+        // feeding until it is used or there are no more frames pending.
+        while (fillCodecBuffer_l() && !mEndOfStreamSent && haveAvailableBuffers_l()) {
+        }
     } else if (mEndOfStream && mStopTimeUs == -1) {
         // No frames available, but EOS is pending and no stop time, so use this buffer to
         // send that.
@@ -719,6 +728,7 @@ bool GraphicBufferSource::fillCodecBuffer_l() {
         int64_t timeUs = item.mTimestampNs / 1000;
         if (mFrameDropper != NULL && mFrameDropper->shouldDrop(timeUs)) {
             ALOGV("skipping frame (%lld) to meet max framerate", static_cast<long long>(timeUs));
+            ++mNumFramesDropped;
             // set err to OK so that the skipped frame can still be saved as the lastest frame
             err = OK;
         } else {
@@ -765,6 +775,7 @@ bool GraphicBufferSource::repeatLatestBuffer_l() {
     if (err != OK) {
         return false;
     }
+    ++mNumFramesRepeated;
 
     /* repeat last frame up to kRepeatLastFrameCount times.
      * in case of static scene, a single repeat might not get rid of encoder
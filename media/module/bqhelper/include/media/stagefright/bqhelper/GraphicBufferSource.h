@@ -418,6 +418,11 @@ private:
 
     sp<FrameDropper> mFrameDropper;
 
+    // frames dropped to meet the max frame rate, and latest frames repeated
+    // since start(); logged on stop()
+    int64_t mNumFramesDropped;
+    int64_t mNumFramesRepeated;
+
     sp<ALooper> mLooper;
     sp<AHandlerReflector<GraphicBufferSource> > mReflector;
 
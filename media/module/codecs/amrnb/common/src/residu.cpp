@@ -74,6 +74,10 @@ terms listed above has been obtained from the copyright holder.
 #include "typedef.h"
 #include "cnst.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 /*----------------------------------------------------------------------------
 ; MACROS
 ; Define module specific macros here
@@ -202,6 +206,29 @@ void Residu(
 {
 
 
+#if defined(__aarch64__)
+    /*
+     *  Four outputs per iteration, one per lane, working backwards from the end like
+     *  the C version so that the filtering can still be done in place.
+     */
+    Word16 i, j;
+    Word16 *p_input_ptr = &input_ptr[input_len-4];
+    Word16 *p_residual_ptr = &residual_ptr[input_len-4];
+    int32x4_t s;
+
+    for (i = input_len >> 2; i != 0; i--)
+    {
+        s = vdupq_n_s32(0x0000800L);
+        for (j = 0; j <= M; j++)
+        {
+            s = vmlal_n_s16(s, vld1_s16(p_input_ptr - j), coef_ptr[j]);
+        }
+        vst1_s16(p_residual_ptr, vshrn_n_s32(s, 12));
+
+        p_input_ptr -= 4;
+        p_residual_ptr -= 4;
+    }
+#else
     Word16 i, j;
     Word32 s1;
     Word32 s2;
@@ -250,6 +277,7 @@ void Residu(
         *(p_residual_ptr--) = (Word16)(s4 >> 12);
 
     }
+#endif
 
     return;
 }
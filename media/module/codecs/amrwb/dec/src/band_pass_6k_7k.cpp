@@ -81,6 +81,9 @@ terms listed above has been obtained from the copyright holder.
 #include "pvamrwbdecoder_basic_op.h"
 #include "pvamrwbdecoder_acelp.h"
 #include "pvamrwbdecoder_cnst.h"
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -154,16 +157,44 @@ void band_pass_6k_7k(
 )
 {
     int16 i, j;
+#if !defined(__aarch64__)
     int32 L_tmp1;
     int32 L_tmp2;
     int32 L_tmp3;
     int32 L_tmp4;
+#endif
 
     int16 *pt_sign = signal;
 
     pv_memcpy((void *)x, (void *)mem, L_FIR*sizeof(*x));
 
 
+#if defined(__aarch64__)
+    /*
+     *  Four outputs per iteration, one per lane. |x| <= 8192 bounds the sums well
+     *  below 2^31, so fxp_mac_16by16() never saturates and plain multiply-accumulates
+     *  give the same result.
+     */
+    for (i = 0; i < lg >> 2; i++)
+    {
+        int16 *pt_x = &x[i<<2];
+        int32x4_t L_tmp;
+
+        vst1_s16(pt_x + L_FIR, vshr_n_s16(vld1_s16(pt_sign), 2));  /* gain of filter = 4 */
+
+        L_tmp = vdupq_n_s32(0x00004000);
+        L_tmp = vsubq_s32(L_tmp, vshll_n_s16(vld1_s16(pt_x + L_FIR), 5));
+        L_tmp = vsubq_s32(L_tmp, vshll_n_s16(vld1_s16(pt_x), 5));
+
+        for (j = 1; j < L_FIR; j++)
+        {
+            L_tmp = vmlal_n_s16(L_tmp, vld1_s16(pt_x + j), fir_6k_7k[j]);
+        }
+
+        vst1_s16(pt_sign, vshrn_n_s32(L_tmp, 15));
+        pt_sign += 4;
+    }
+#else
     for (i = 0; i < lg >> 2; i++)
     {
 
@@ -233,6 +264,7 @@ void band_pass_6k_7k(
         *(pt_sign++) = (int16)(L_tmp4 >> 15);
 
     }
+#endif
 
     pv_memcpy((void *)mem, (void *)(x + lg), L_FIR*sizeof(*mem));
 
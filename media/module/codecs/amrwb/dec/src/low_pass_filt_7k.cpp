@@ -77,6 +77,9 @@ terms listed above has been obtained from the copyright holder.
 #include "pvamrwbdecoder_basic_op.h"
 #include "pvamrwbdecoder_cnst.h"
 #include "pvamrwbdecoder_acelp.h"
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -147,13 +150,39 @@ void low_pass_filt_7k(
 )
 {
     int16 i, j;
+#if !defined(__aarch64__)
     int32 L_tmp1;
     int32 L_tmp2;
     int32 L_tmp3;
     int32 L_tmp4;
+#endif
 
     pv_memcpy((void *)x, (void *)mem, (L_FIR)*sizeof(*x));
 
+#if defined(__aarch64__)
+    /*
+     *  Four outputs per iteration, one per lane. The sum of the absolute values of
+     *  fir_7k[] times 2^15 is below 2^31, so fxp_mac_16by16() never saturates and plain
+     *  multiply-accumulates give the same result.
+     */
+    for (i = 0; i < lg >> 2; i++)
+    {
+        int16 *pt_x = &x[i<<2];
+        int16x4_t sig = vld1_s16(&signal[i<<2]);
+        int32x4_t L_tmp;
+
+        vst1_s16(pt_x + L_FIR, sig);
+
+        L_tmp = vmlal_n_s16(vdupq_n_s32(0x00004000), vadd_s16(vld1_s16(pt_x), sig), fir_7k[0]);
+
+        for (j = 1; j < L_FIR; j++)
+        {
+            L_tmp = vmlal_n_s16(L_tmp, vld1_s16(pt_x + j), fir_7k[j]);
+        }
+
+        vst1_s16(&signal[i<<2], vshrn_n_s32(L_tmp, 15));
+    }
+#else
     for (i = 0; i < lg >> 2; i++)
     {
         x[(i<<2) + L_FIR    ] = signal[(i<<2)];
@@ -212,6 +241,7 @@ void low_pass_filt_7k(
         signal[(i<<2)+3] = (int16)(L_tmp4 >> 15);
 
     }
+#endif
 
     pv_memcpy((void *)mem, (void *)(x + lg), (L_FIR)*sizeof(*mem));
 
@@ -77,6 +77,9 @@ terms listed above has been obtained from the copyright holder.
 #include "pvamrwbdecoder_basic_op.h"
 #include "pvamrwbdecoder_acelp.h"
 #include "pvamrwbdecoder_cnst.h"
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -281,6 +284,22 @@ int16 AmrWbInterpol(                      /* return result of interpolation */
     int32 L_sum;
     const int16 *pt_fir = fir;
 
+#if defined(__aarch64__)
+    /*
+     *  The sum of the absolute values of each fir_up[] phase times 2^15 is below 2^31,
+     *  so fxp_mac_16by16() never saturates and the taps can be summed in any order.
+     */
+    int16 *pt_x = x - nb_coef - (nb_coef << 1) + 1;
+    int32x4_t L_acc;
+
+    L_acc = vmull_s16(vld1_s16(pt_x), vld1_s16(pt_fir));
+    L_acc = vmlal_s16(L_acc, vld1_s16(pt_x + 4), vld1_s16(pt_fir + 4));
+    L_acc = vmlal_s16(L_acc, vld1_s16(pt_x + 8), vld1_s16(pt_fir + 8));
+    L_acc = vmlal_s16(L_acc, vld1_s16(pt_x + 12), vld1_s16(pt_fir + 12));
+    L_acc = vmlal_s16(L_acc, vld1_s16(pt_x + 16), vld1_s16(pt_fir + 16));
+    L_acc = vmlal_s16(L_acc, vld1_s16(pt_x + 20), vld1_s16(pt_fir + 20));
+    L_sum = vaddvq_s32(L_acc) + 0x00002000L;
+#else
     int16 tmp1, tmp2, tmp3, tmp4;
     int16 *pt_x = x - nb_coef - (nb_coef << 1) + 1;
 
@@ -333,6 +352,7 @@ int16 AmrWbInterpol(                      /* return result of interpolation */
     L_sum = fxp_mac_16by16(tmp2, *(pt_fir++), L_sum);
     L_sum = fxp_mac_16by16(tmp3, *(pt_fir++), L_sum);
     L_sum = fxp_mac_16by16(tmp4, *(pt_fir++), L_sum);
+#endif
 
 
     L_sum = shl_int32(L_sum, 2);               /* saturation can occur here */
@@ -20,6 +20,11 @@
 
 #include "FLACDecoder.h"
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <thread>
+
 #include <audio_utils/primitives.h> // float_from_i32
 #include <media/stagefright/foundation/ADebug.h>
 #include <media/stagefright/foundation/hexdump.h>
@@ -159,6 +164,150 @@ static void copyToFloat(
     }
 }
 
+namespace {
+
+// Minimum number of frames given to each thread of decodeFrames(), so that setting up a
+// decoder stays negligible compared to the decoding.
+constexpr size_t kMinFramesPerThread = 16;
+
+// CRC-8 (x^8 + x^2 + x^1 + x^0) protecting the frame headers.
+uint8_t crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Table of the CRC-16 (x^16 + x^15 + x^2 + x^0) protecting the whole frames.
+const uint16_t *crc16Table() {
+    static const std::array<uint16_t, 256> sTable = [] {
+        std::array<uint16_t, 256> table;
+        for (unsigned i = 0; i < 256; ++i) {
+            unsigned crc = i << 8;
+            for (int j = 0; j < 8; ++j) {
+                crc = (crc & 0x8000) ? ((crc << 1) ^ 0x8005) : (crc << 1);
+            }
+            table[i] = crc & 0xffff;
+        }
+        return table;
+    }();
+    return sTable.data();
+}
+
+// Returns the block size of the frame whose header starts at |data|, or 0 if there is no
+// valid frame header there.
+unsigned parseFrameHeader(const uint8_t *data, size_t len) {
+    if (len < 6 || data[0] != 0xff || (data[1] & 0xfe) != 0xf8) {
+        return 0;
+    }
+    const unsigned blockSizeCode = data[2] >> 4;
+    const unsigned sampleRateCode = data[2] & 0x0f;
+    if (blockSizeCode == 0 || sampleRateCode == 0x0f
+            || (data[3] >> 4) >= 11 /* channel assignment */
+            || ((data[3] >> 1) & 0x07) == 3 /* sample size */
+            || (data[3] & 0x01) /* reserved */) {
+        return 0;
+    }
+
+    // frame or sample number, UTF-8 coded
+    size_t pos = 4;
+    const uint8_t lead = data[pos++];
+    size_t extra = 0;
+    if (lead & 0x80) {
+        extra = 1;
+        while (extra < 7 && (lead & (0x40 >> extra))) {
+            ++extra;
+        }
+        if (extra > 6 || (lead & 0x40) == 0) {
+            return 0;
+        }
+    }
+    if (extra >= len - pos) {
+        return 0;
+    }
+    for (size_t i = 0; i < extra; ++i) {
+        if ((data[pos++] & 0xc0) != 0x80) {
+            return 0;
+        }
+    }
+
+    unsigned blockSize;
+    if (blockSizeCode == 1) {
+        blockSize = 192;
+    } else if (blockSizeCode <= 5) {
+        blockSize = 576u << (blockSizeCode - 2);
+    } else if (blockSizeCode == 6) {
+        if (pos + 1 >= len) {
+            return 0;
+        }
+        blockSize = data[pos] + 1u;
+        pos += 1;
+    } else if (blockSizeCode == 7) {
+        if (pos + 2 >= len) {
+            return 0;
+        }
+        blockSize = ((unsigned)data[pos] << 8 | data[pos + 1]) + 1u;
+        pos += 2;
+    } else {
+        blockSize = 256u << (blockSizeCode - 8);
+    }
+    if (sampleRateCode == 12) {
+        pos += 1;
+    } else if (sampleRateCode == 13 || sampleRateCode == 14) {
+        pos += 2;
+    }
+    if (pos >= len || crc8(data, pos) != data[pos]) {
+        return 0;
+    }
+    return blockSize;
+}
+
+struct FrameLocation {
+    size_t offset;
+    size_t size;
+    unsigned blockSize;
+    size_t outOffset;
+};
+
+// Locates the complete frames in |data|. A frame ends where the next valid frame header
+// starts (or at the end of the data) and its CRC-16 footer matches; bytes before the first
+// frame header are reported in |*skipped|.
+std::vector<FrameLocation> findFrames(const uint8_t *data, size_t len, size_t *skipped) {
+    std::vector<FrameLocation> frames;
+    size_t start = 0;
+    unsigned blockSize = 0;
+    while (start < len && (blockSize = parseFrameHeader(data + start, len - start)) == 0) {
+        ++start;
+    }
+    *skipped = start;
+
+    const uint16_t *table = crc16Table();
+    uint16_t crc = 0;
+    // |crc| covers data[start, q - 2)
+    for (size_t q = start + 2; start < len && q <= len; ++q) {
+        unsigned nextBlockSize = 0;
+        if (q == len || (data[q] == 0xff
+                && (nextBlockSize = parseFrameHeader(data + q, len - q)) != 0)) {
+            if (crc == ((uint16_t)data[q - 2] << 8 | data[q - 1])) {
+                frames.push_back({start, q - start, blockSize, 0});
+                start = q;
+                blockSize = nextBlockSize;
+                crc = 0;
+                ++q;  // the next frame ends at start + 2 at the earliest
+                continue;
+            }
+        }
+        crc = ((crc << 8) & 0xffff) ^ table[(crc >> 8) ^ data[q - 2]];
+    }
+    return frames;
+}
+
+}  // namespace
+
 // static
 FLACDecoder *FLACDecoder::Create() {
     FLACDecoder *decoder = new (std::nothrow) FLACDecoder();
@@ -264,6 +413,7 @@ void FLACDecoder::flush() {
     mBufferPos = 0;
     mBufferDataSize = 0;
     mStreamInfoValid = false;
+    mMetadata.clear();
     if (!FLAC__stream_decoder_reset(mDecoder)) {
         ALOGE("flush: failed to reset FLAC stream decoder");
     }
@@ -328,6 +478,7 @@ status_t FLACDecoder::parseMetadata(const uint8_t *inBuffer, size_t inBufferLen)
     }
 
     // Now we have all metadata blocks.
+    mMetadata.assign(mBuffer, mBuffer + mBufferDataSize);
     mBufferPos = 0;
     mBufferDataSize = 0;
 
@@ -415,6 +566,101 @@ status_t FLACDecoder::decodeOneFrame(const uint8_t *inBuffer, size_t inBufferLen
     return OK;
 }
 
+status_t FLACDecoder::decodeFrames(const uint8_t *inBuffer, size_t inBufferLen,
+        void *outBuffer, size_t *outBufferLen, size_t *inBufferUsed,
+        bool outputFloat, size_t numThreads) {
+    ALOGV("decodeFrames: input size(%zu)", inBufferLen);
+
+    if (!mStreamInfoValid || mMetadata.empty()) {
+        ALOGE("decodeFrames: no streaminfo metadata block");
+        return NO_INIT;
+    }
+
+    size_t used;
+    std::vector<FrameLocation> frames = findFrames(inBuffer, inBufferLen, &used);
+
+    // lay out the output of the frames that fit in the output buffer
+    const size_t sampleSize = outputFloat ? sizeof(float) : sizeof(int16_t);
+    const size_t frameSize = getChannels() * sampleSize;
+    size_t outSize = 0;
+    size_t numFrames = 0;
+    for (FrameLocation &frame : frames) {
+        if (frame.blockSize > getMaxBlockSize()) {
+            ALOGE("decodeFrames: invalid blocksize %u", frame.blockSize);
+            return ERROR_MALFORMED;
+        }
+        const size_t size = frame.blockSize * frameSize;
+        if (size > *outBufferLen - outSize) {
+            break;
+        }
+        frame.outOffset = outSize;
+        outSize += size;
+        used = frame.offset + frame.size;
+        ++numFrames;
+    }
+    frames.resize(numFrames);
+
+    if (numThreads == 0) {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    numThreads = std::max(std::min(numThreads,
+            (numFrames + kMinFramesPerThread - 1) / kMinFramesPerThread), (size_t)1);
+
+    // each thread decodes a run of consecutive frames with its own decoder
+    auto decodeRun = [&](size_t begin, size_t end) -> status_t {
+        if (begin == end) {
+            return OK;
+        }
+        std::unique_ptr<FLACDecoder> decoder(FLACDecoder::Create());
+        if (decoder == nullptr) {
+            return NO_MEMORY;
+        }
+        status_t err = decoder->parseMetadata(mMetadata.data(), mMetadata.size());
+        if (err != OK) {
+            ALOGE("decodeFrames: parseMetadata returns error %d", err);
+            return err;
+        }
+        for (size_t i = begin; i < end; ++i) {
+            const FrameLocation &frame = frames[i];
+            const size_t size = frame.blockSize * frameSize;
+            size_t decodedSize = size;
+            err = decoder->decodeOneFrame(inBuffer + frame.offset, frame.size,
+                    (uint8_t *)outBuffer + frame.outOffset, &decodedSize, outputFloat);
+            if (err != OK) {
+                return err;
+            }
+            if (decodedSize != size) {
+                ALOGE("decodeFrames: frame at %zu decoded to %zu bytes, expected %zu",
+                        frame.offset, decodedSize, size);
+                return ERROR_MALFORMED;
+            }
+        }
+        return OK;
+    };
+
+    std::vector<status_t> results(numThreads, OK);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = decodeRun(numFrames * i / numThreads, numFrames * (i + 1) / numThreads);
+        });
+    }
+    results[0] = decodeRun(0, numFrames / numThreads);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (status_t result : results) {
+        if (result != OK) {
+            return result;
+        }
+    }
+
+    ALOGV("decodeFrames: decoded %zu frames on %zu threads", numFrames, numThreads);
+    *inBufferUsed = used;
+    *outBufferLen = outSize;
+    return OK;
+}
+
 status_t FLACDecoder::addDataToBuffer(const uint8_t *inBuffer, size_t inBufferLen) {
     // mBufferPos should be no larger than mBufferDataSize
     if (inBufferLen > SIZE_MAX - (mBufferDataSize - mBufferPos)) {
@@ -21,6 +21,8 @@
 #include <utils/RefBase.h>
 #include <utils/String8.h>
 
+#include <vector>
+
 #include "FLAC/stream_decoder.h"
 
 namespace android {
@@ -42,6 +44,17 @@ public:
     status_t parseMetadata(const uint8_t *inBuffer, size_t inBufferLen);
     status_t decodeOneFrame(const uint8_t *inBuffer, size_t inBufferLen,
             void *outBuffer, size_t *outBufferLen, bool outputFloat = false);
+
+    // Decodes all the complete frames in |inBuffer| in parallel, for offline use. Frame
+    // boundaries are located with the frame sync code and verified with the header and
+    // footer CRCs, and runs of consecutive frames are decoded on up to |numThreads| threads
+    // (0 selects the number of CPUs), each with its own libFLAC decoder. Frames that do not
+    // fit in |outBuffer| and a trailing partial frame are left undecoded; on return
+    // |*inBufferUsed| is the number of input bytes consumed and |*outBufferLen| the size of
+    // the PCM written. Requires parseMetadata() to have succeeded.
+    status_t decodeFrames(const uint8_t *inBuffer, size_t inBufferLen,
+            void *outBuffer, size_t *outBufferLen, size_t *inBufferUsed,
+            bool outputFloat = false, size_t numThreads = 0);
     void flush();
     virtual ~FLACDecoder();
 
@@ -79,6 +92,8 @@ private:
     // cached when the STREAMINFO metadata is parsed by libFLAC
     FLAC__StreamMetadata_StreamInfo mStreamInfo;
     bool mStreamInfoValid;
+    // the metadata blocks, used to set up the decoders of decodeFrames()
+    std::vector<uint8_t> mMetadata;
 
     // cached when a decoded PCM block is "written" by libFLAC decoder
     bool mWriteRequested;
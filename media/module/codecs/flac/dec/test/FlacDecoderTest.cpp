@@ -19,6 +19,7 @@
 
 #include <utils/Log.h>
 #include <fstream>
+#include <memory>
 
 #include "FLACDecoder.h"
 
@@ -245,6 +246,68 @@ TEST_P(FLACDecoderTest, DecodeTest) {
     ASSERT_EQ(status, 0) << "Test Failed. Decode returned error = " << status << endl;
 }
 
+TEST_P(FLACDecoderTest, DecodeFramesTest) {
+    tuple<string /* InputFileName */, string /* InfoFileName */, bool /* outputfloat */> params =
+            GetParam();
+
+    string inputFileName = gEnv->getRes() + get<0>(params);
+    string infoFileName = gEnv->getRes() + get<1>(params);
+    bool outputFloat = get<2>(params);
+
+    vector<FrameInfo> Info;
+    getInfo(infoFileName, Info);
+
+    mEleStream.open(inputFileName, ifstream::binary);
+    ASSERT_EQ(mEleStream.is_open(), true);
+
+    // collect the metadata blocks and all the frames of the stream
+    vector<uint8_t> metadata;
+    vector<uint8_t> frames;
+    vector<int32_t> frameSizes;
+    for (const FrameInfo &info : Info) {
+        ASSERT_GE(info.bytesCount, 0) << "Size for the memory allocation is negative";
+        vector<uint8_t> &dst = (info.flags == CODEC_CONFIG_FLAG) ? metadata : frames;
+        size_t pos = dst.size();
+        dst.resize(pos + info.bytesCount);
+        mEleStream.read((char *)dst.data() + pos, info.bytesCount);
+        ASSERT_EQ(mEleStream.gcount(), info.bytesCount) << "Invalid size read";
+        if (info.flags != CODEC_CONFIG_FLAG) frameSizes.push_back(info.bytesCount);
+    }
+    ASSERT_GT(frameSizes.size(), 0) << "No frames to decode";
+
+    // decode serially as the reference
+    ASSERT_EQ(mFLACDecoder->parseMetadata(metadata.data(), metadata.size()), OK);
+    mStreamInfo = mFLACDecoder->getStreamInfo();
+    const size_t sampleSize = outputFloat ? sizeof(float) : sizeof(int16_t);
+    const size_t maxFrameOutSize = mStreamInfo.max_blocksize * mStreamInfo.channels * sampleSize;
+    vector<uint8_t> serialOut;
+    size_t pos = 0;
+    for (int32_t size : frameSizes) {
+        size_t outPos = serialOut.size();
+        size_t outSize = maxFrameOutSize;
+        serialOut.resize(outPos + outSize);
+        ASSERT_EQ(mFLACDecoder->decodeOneFrame(frames.data() + pos, size,
+                                               serialOut.data() + outPos, &outSize, outputFloat),
+                  OK);
+        serialOut.resize(outPos + outSize);
+        pos += size;
+    }
+
+    // decode in parallel and compare
+    std::unique_ptr<FLACDecoder> decoder(FLACDecoder::Create());
+    ASSERT_NE(decoder, nullptr) << "FLACDecoder Creation Failed";
+    ASSERT_EQ(decoder->parseMetadata(metadata.data(), metadata.size()), OK);
+    vector<uint8_t> parallelOut(serialOut.size());
+    size_t outSize = parallelOut.size();
+    size_t used = 0;
+    ASSERT_EQ(decoder->decodeFrames(frames.data(), frames.size(), parallelOut.data(), &outSize,
+                                    &used, outputFloat, 4 /* numThreads */),
+              OK);
+    EXPECT_EQ(used, frames.size()) << "Not all frames were decoded";
+    ASSERT_EQ(outSize, serialOut.size());
+    EXPECT_EQ(parallelOut, serialOut) << "Parallel decode differs from serial decode";
+}
+
 // TODO: Add remaining tests
 INSTANTIATE_TEST_SUITE_P(
         FLACDecoderTestAll, FLACDecoderTest,
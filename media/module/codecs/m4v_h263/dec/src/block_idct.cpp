@@ -103,6 +103,10 @@
 #include "idct.h"
 #include "motion_comp.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #define OSCL_DISABLE_WARNING_CONV_POSSIBLE_LOSS_OF_DATA
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -124,6 +128,115 @@ static void idctrow(int16 *blk, uint8 *pred, uint8 *dst, int width);
 static void idctrow_intra(int16 *blk, PIXEL *, int width);
 static void idctcol(int16 *blk);
 
+#if defined(__aarch64__) && defined(FAST_IDCT)
+/* NEON row IDCT, used for the dense blocks that need the full idctrow(). The eight rows
+   are transposed so that each vector lane carries one row through the same integer
+   stages as the C code, which keeps the output bit-exact. */
+#define NEON_IDCTROW
+
+static inline void transpose8x8_s16(int16x8_t *r)
+{
+    int16x8x2_t t0 = vtrnq_s16(r[0], r[1]);
+    int16x8x2_t t1 = vtrnq_s16(r[2], r[3]);
+    int16x8x2_t t2 = vtrnq_s16(r[4], r[5]);
+    int16x8x2_t t3 = vtrnq_s16(r[6], r[7]);
+    int32x4x2_t u0 = vtrnq_s32(vreinterpretq_s32_s16(t0.val[0]), vreinterpretq_s32_s16(t1.val[0]));
+    int32x4x2_t u1 = vtrnq_s32(vreinterpretq_s32_s16(t0.val[1]), vreinterpretq_s32_s16(t1.val[1]));
+    int32x4x2_t u2 = vtrnq_s32(vreinterpretq_s32_s16(t2.val[0]), vreinterpretq_s32_s16(t3.val[0]));
+    int32x4x2_t u3 = vtrnq_s32(vreinterpretq_s32_s16(t2.val[1]), vreinterpretq_s32_s16(t3.val[1]));
+
+    r[0] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u0.val[0]), vget_low_s32(u2.val[0])));
+    r[1] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u1.val[0]), vget_low_s32(u3.val[0])));
+    r[2] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u0.val[1]), vget_low_s32(u2.val[1])));
+    r[3] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(u1.val[1]), vget_low_s32(u3.val[1])));
+    r[4] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u0.val[0]), vget_high_s32(u2.val[0])));
+    r[5] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u1.val[0]), vget_high_s32(u3.val[0])));
+    r[6] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u0.val[1]), vget_high_s32(u2.val[1])));
+    r[7] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(u1.val[1]), vget_high_s32(u3.val[1])));
+}
+
+/* c[k] holds coefficient k of four rows; out[k] receives output pixel k (before the
+   prediction is added), saturated to 16 bits */
+static inline void idctrow4_neon(const int32x4_t *c, int16x4_t *out)
+{
+    int32x4_t x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+    x1 = vshlq_n_s32(c[4], 8);
+    x2 = c[6];
+    x3 = c[2];
+    x4 = c[1];
+    x5 = c[7];
+    x6 = c[5];
+    x7 = c[3];
+    x0 = vaddq_s32(vshlq_n_s32(c[0], 8), vdupq_n_s32(8192));
+
+    /* first stage */
+    x8 = vaddq_s32(vmulq_n_s32(vaddq_s32(x4, x5), W7), vdupq_n_s32(4));
+    x4 = vshrq_n_s32(vmlaq_n_s32(x8, x4, W1 - W7), 3);
+    x5 = vshrq_n_s32(vmlsq_n_s32(x8, x5, W1 + W7), 3);
+    x8 = vaddq_s32(vmulq_n_s32(vaddq_s32(x6, x7), W3), vdupq_n_s32(4));
+    x6 = vshrq_n_s32(vmlsq_n_s32(x8, x6, W3 - W5), 3);
+    x7 = vshrq_n_s32(vmlsq_n_s32(x8, x7, W3 + W5), 3);
+
+    /* second stage */
+    x8 = vaddq_s32(x0, x1);
+    x0 = vsubq_s32(x0, x1);
+    x1 = vaddq_s32(vmulq_n_s32(vaddq_s32(x3, x2), W6), vdupq_n_s32(4));
+    x2 = vshrq_n_s32(vmlsq_n_s32(x1, x2, W2 + W6), 3);
+    x3 = vshrq_n_s32(vmlaq_n_s32(x1, x3, W2 - W6), 3);
+    x1 = vaddq_s32(x4, x6);
+    x4 = vsubq_s32(x4, x6);
+    x6 = vaddq_s32(x5, x7);
+    x5 = vsubq_s32(x5, x7);
+
+    /* third stage */
+    x7 = vaddq_s32(x8, x3);
+    x8 = vsubq_s32(x8, x3);
+    x3 = vaddq_s32(x0, x2);
+    x0 = vsubq_s32(x0, x2);
+    x2 = vshrq_n_s32(vmlaq_n_s32(vdupq_n_s32(128), vaddq_s32(x4, x5), 181), 8);
+    x4 = vshrq_n_s32(vmlaq_n_s32(vdupq_n_s32(128), vsubq_s32(x4, x5), 181), 8);
+
+    /* fourth stage */
+    out[0] = vqmovn_s32(vshrq_n_s32(vaddq_s32(x7, x1), 14));
+    out[1] = vqmovn_s32(vshrq_n_s32(vaddq_s32(x3, x2), 14));
+    out[2] = vqmovn_s32(vshrq_n_s32(vaddq_s32(x0, x4), 14));
+    out[3] = vqmovn_s32(vshrq_n_s32(vaddq_s32(x8, x6), 14));
+    out[4] = vqmovn_s32(vshrq_n_s32(vsubq_s32(x8, x6), 14));
+    out[5] = vqmovn_s32(vshrq_n_s32(vsubq_s32(x0, x4), 14));
+    out[6] = vqmovn_s32(vshrq_n_s32(vsubq_s32(x3, x2), 14));
+    out[7] = vqmovn_s32(vshrq_n_s32(vsubq_s32(x7, x1), 14));
+}
+
+/* row IDCT of the 8x8 block into res[] (one vector per row), clearing blk */
+static inline void idctrow_neon(int16 *blk, int16x8_t *res)
+{
+    int16x8_t r[8];
+    int32x4_t lo[8], hi[8];
+    int16x4_t outlo[8], outhi[8];
+    int k;
+
+    for (k = 0; k < 8; k++)
+    {
+        r[k] = vld1q_s16(blk + (k << 3));
+        vst1q_s16(blk + (k << 3), vdupq_n_s16(0));
+    }
+    transpose8x8_s16(r);
+    for (k = 0; k < 8; k++)
+    {
+        lo[k] = vmovl_s16(vget_low_s16(r[k]));
+        hi[k] = vmovl_s16(vget_high_s16(r[k]));
+    }
+    idctrow4_neon(lo, outlo);
+    idctrow4_neon(hi, outhi);
+    for (k = 0; k < 8; k++)
+    {
+        res[k] = vcombine_s16(outlo[k], outhi[k]);
+    }
+    transpose8x8_s16(res);
+}
+#endif
+
 #ifdef FAST_IDCT
 // mapping from nz_coefs to functions to be used
 
@@ -514,6 +627,20 @@ void idctrow(
     /*----------------------------------------------------------------------------
     ; Define all local variables
     ----------------------------------------------------------------------------*/
+#ifdef NEON_IDCTROW
+    int16x8_t res[8];
+    int i;
+
+    idctrow_neon(blk, res);
+    for (i = 0; i < 8; i++)
+    {
+        /* add the prediction (pitch 16) and clip to [0, 255] */
+        int16x8_t sum = vqaddq_s16(res[i], vreinterpretq_s16_u16(vmovl_u8(vld1_u8(pred))));
+        vst1_u8(dst, vqmovun_s16(sum));
+        pred += 16;
+        dst += width;
+    }
+#else
     int32 x0, x1, x2, x3, x4, x5, x6, x7, x8;
     int i = 8;
     uint32 pred_word, dst_word;
@@ -612,6 +739,7 @@ void idctrow(
         dst_word |= (res << 24);
         *((uint32*)(dst += 4)) = dst_word; /* save 4 bytes to dst */
     }
+#endif
     /*----------------------------------------------------------------------------
     ; Return nothing or data or data pointer
     ----------------------------------------------------------------------------*/
@@ -626,6 +754,17 @@ void idctrow_intra(
     /*----------------------------------------------------------------------------
     ; Define all local variables
     ----------------------------------------------------------------------------*/
+#ifdef NEON_IDCTROW
+    int16x8_t res[8];
+    int i;
+
+    idctrow_neon(blk, res);
+    for (i = 0; i < 8; i++)
+    {
+        vst1_u8(comp, vqmovun_s16(res[i]));
+        comp += width;
+    }
+#else
     int32 x0, x1, x2, x3, x4, x5, x6, x7, x8, temp;
     int i = 8;
     int offset = width;
@@ -730,6 +869,7 @@ void idctrow_intra(
 
         blk += B_SIZE;
     }
+#endif
     /*----------------------------------------------------------------------------
     ; Return nothing or data or data pointer
     ----------------------------------------------------------------------------*/
@@ -79,6 +79,134 @@
 
 #define OSCL_DISABLE_WARNING_CONV_POSSIBLE_LOSS_OF_DATA
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+/* NEON versions of the predictors below. The loads need no alignment, so there is no
+   per-offset path, and the averages round the same way as the packed-word C code:
+   (a + b + rnd1) >> 1 for one half-pel dimension, (a + b + c + d + rnd1 + 1) >> 2 for
+   two. */
+
+int GetPredAdvancedBy0x0(
+    uint8 *prev,        /* i */
+    uint8 *pred_block,      /* i */
+    int width,      /* i */
+    int pred_width_rnd /* i */
+)
+{
+    uint    i;      /* loop variable */
+    int pred_width = pred_width_rnd >> 1;
+
+    for (i = B_SIZE; i > 0; i--)
+    {
+        vst1_u8(pred_block, vld1_u8(prev));
+        pred_block += pred_width;
+        prev += width;
+    }
+    return 1;
+}
+
+/**************************************************************************/
+int GetPredAdvancedBy0x1(
+    uint8 *prev,        /* i */
+    uint8 *pred_block,      /* i */
+    int width,      /* i */
+    int pred_width_rnd /* i */
+)
+{
+    uint    i;      /* loop variable */
+    int pred_width = pred_width_rnd >> 1;
+    uint8x8_t a, b;
+
+    if (pred_width_rnd & 1)
+    {
+        for (i = B_SIZE; i > 0; i--)
+        {
+            a = vld1_u8(prev);
+            b = vld1_u8(prev + 1);
+            vst1_u8(pred_block, vrhadd_u8(a, b));
+            pred_block += pred_width;
+            prev += width;
+        }
+    }
+    else
+    {
+        for (i = B_SIZE; i > 0; i--)
+        {
+            a = vld1_u8(prev);
+            b = vld1_u8(prev + 1);
+            vst1_u8(pred_block, vhadd_u8(a, b));
+            pred_block += pred_width;
+            prev += width;
+        }
+    }
+    return 1;
+}
+
+/**************************************************************************/
+int GetPredAdvancedBy1x0(
+    uint8 *prev,        /* i */
+    uint8 *pred_block,      /* i */
+    int width,      /* i */
+    int pred_width_rnd /* i */
+)
+{
+    uint    i;      /* loop variable */
+    int pred_width = pred_width_rnd >> 1;
+    uint8x8_t a, b;
+
+    a = vld1_u8(prev);
+    if (pred_width_rnd & 1)
+    {
+        for (i = B_SIZE; i > 0; i--)
+        {
+            b = vld1_u8(prev += width);
+            vst1_u8(pred_block, vrhadd_u8(a, b));
+            pred_block += pred_width;
+            a = b;
+        }
+    }
+    else
+    {
+        for (i = B_SIZE; i > 0; i--)
+        {
+            b = vld1_u8(prev += width);
+            vst1_u8(pred_block, vhadd_u8(a, b));
+            pred_block += pred_width;
+            a = b;
+        }
+    }
+    return 1;
+}
+
+/**************************************************************************/
+int GetPredAdvancedBy1x1(
+    uint8 *prev,        /* i */
+    uint8 *pred_block,      /* i */
+    int width,      /* i */
+    int pred_width_rnd /* i */
+)
+{
+    uint    i;      /* loop variable */
+    int pred_width = pred_width_rnd >> 1;
+    uint16x8_t rnd2 = vdupq_n_u16((pred_width_rnd & 1) + 1);
+    uint16x8_t sum0, sum1;
+
+    /* horizontal pair sums of the first row */
+    sum0 = vaddl_u8(vld1_u8(prev), vld1_u8(prev + 1));
+    for (i = B_SIZE; i > 0; i--)
+    {
+        prev += width;
+        sum1 = vaddl_u8(vld1_u8(prev), vld1_u8(prev + 1));
+        vst1_u8(pred_block, vshrn_n_u16(vaddq_u16(vaddq_u16(sum0, sum1), rnd2), 2));
+        pred_block += pred_width;
+        sum0 = sum1;
+    }
+    return 1;
+}
+
+#else
+
 int GetPredAdvancedBy0x0(
     uint8 *prev,        /* i */
     uint8 *pred_block,      /* i */
@@ -1187,4 +1315,4 @@ int GetPredAdvancedBy1x1(
     }
 }
 
-
+#endif /* __aarch64__ */
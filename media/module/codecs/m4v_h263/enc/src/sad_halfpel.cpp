@@ -32,6 +32,10 @@ Int SAD_Blk_HalfPel_C(UChar *ref,UChar *blk,Int dmin,Int width,Int rx,Int xh,Int
 #include "mp4lib_int.h"
 #include "sad_halfpel_inline.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #ifdef _SAD_STAT
 ULong num_sad_HP_MB = 0;
 ULong num_sad_HP_Blk = 0;
@@ -220,11 +224,15 @@ extern "C"
     /* One component is half-pel */
     Int SAD_MB_HalfPel_Cxhyh(UChar *ref, UChar *blk, Int dmin_rx, void *extra_info)
     {
+#if defined(__aarch64__)
+        Int i;
+#else
         Int i, j;
+        Int temp;
+#endif
         Int sad = 0;
         UChar *kk, *p1, *p2, *p3, *p4;
 //  Int sumref=0;
-        Int temp;
         Int rx = dmin_rx & 0xFFFF;
 
         OSCL_UNUSED_ARG(extra_info);
@@ -239,12 +247,22 @@ extern "C"
 
         for (i = 0; i < 16; i++)
         {
+#if defined(__aarch64__)
+            uint16x8_t lo = vaddq_u16(vaddl_u8(vld1_u8(p1), vld1_u8(p2)),
+                                      vaddl_u8(vld1_u8(p3), vld1_u8(p4)));
+            uint16x8_t hi = vaddq_u16(vaddl_u8(vld1_u8(p1 + 8), vld1_u8(p2 + 8)),
+                                      vaddl_u8(vld1_u8(p3 + 8), vld1_u8(p4 + 8)));
+            uint8x16_t pred = vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2));
+            sad += vaddlvq_u8(vabdq_u8(pred, vld1q_u8(kk)));
+            kk += 16;
+#else
             for (j = 0; j < 16; j++)
             {
 
                 temp = ((p1[j] + p2[j] + p3[j] + p4[j] + 2) >> 2) - *kk++;
                 sad += PV_ABS(temp);
             }
+#endif
 
             NUM_SAD_HP_MB();
 
@@ -261,11 +279,15 @@ extern "C"
 
     Int SAD_MB_HalfPel_Cyh(UChar *ref, UChar *blk, Int dmin_rx, void *extra_info)
     {
+#if defined(__aarch64__)
+        Int i;
+#else
         Int i, j;
+        Int temp;
+#endif
         Int sad = 0;
         UChar *kk, *p1, *p2;
 //  Int sumref=0;
-        Int temp;
         Int rx = dmin_rx & 0xFFFF;
 
         OSCL_UNUSED_ARG(extra_info);
@@ -278,12 +300,18 @@ extern "C"
 
         for (i = 0; i < 16; i++)
         {
+#if defined(__aarch64__)
+            uint8x16_t pred = vrhaddq_u8(vld1q_u8(p1), vld1q_u8(p2));
+            sad += vaddlvq_u8(vabdq_u8(pred, vld1q_u8(kk)));
+            kk += 16;
+#else
             for (j = 0; j < 16; j++)
             {
 
                 temp = ((p1[j] + p2[j] + 1) >> 1) - *kk++;
                 sad += PV_ABS(temp);
             }
+#endif
 
             NUM_SAD_HP_MB();
 
@@ -297,11 +325,15 @@ extern "C"
 
     Int SAD_MB_HalfPel_Cxh(UChar *ref, UChar *blk, Int dmin_rx, void *extra_info)
     {
+#if defined(__aarch64__)
+        Int i;
+#else
         Int i, j;
+        Int temp;
+#endif
         Int sad = 0;
         UChar *kk, *p1;
 //  Int sumref=0;
-        Int temp;
         Int rx = dmin_rx & 0xFFFF;
 
         OSCL_UNUSED_ARG(extra_info);
@@ -313,12 +345,18 @@ extern "C"
 
         for (i = 0; i < 16; i++)
         {
+#if defined(__aarch64__)
+            uint8x16_t pred = vrhaddq_u8(vld1q_u8(p1), vld1q_u8(p1 + 1));
+            sad += vaddlvq_u8(vabdq_u8(pred, vld1q_u8(kk)));
+            kk += 16;
+#else
             for (j = 0; j < 16; j++)
             {
 
                 temp = ((p1[j] + p1[j+1] + 1) >> 1) - *kk++;
                 sad += PV_ABS(temp);
             }
+#endif
 
             NUM_SAD_HP_MB();
 
@@ -23,6 +23,10 @@
 #ifndef _SAD_INLINE_H_
 #define _SAD_INLINE_H_
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -78,6 +82,31 @@ extern "C"
 #define SHIFT 8
 #include "sad_mb_offset.h"
 
+#if defined(__aarch64__)
+
+    /* NEON loads need no alignment, so all offsets of ref take the same path. The partial
+       SAD is checked against dmin after each row, as in the C version below. */
+    __inline int32 simd_sad_mb(UChar *ref, UChar *blk, Int dmin, Int lx)
+    {
+        uint32 sad = 0;
+        Int i;
+
+        for (i = 0; i < 16; i++)
+        {
+            uint8x16_t diff = vabdq_u8(vld1q_u8(ref), vld1q_u8(blk));
+            sad += vaddlvq_u8(diff);
+
+            if (sad > (uint32)dmin) /* compare with dmin */
+                break;
+
+            ref += lx;
+            blk += 16;
+        }
+
+        return sad;
+    }
+
+#else
 
     __inline int32 simd_sad_mb(UChar *ref, UChar *blk, Int dmin, Int lx)
     {
@@ -172,6 +201,8 @@ SadMBOffset1:
 
     }
 
+#endif /* __aarch64__ */
+
 #elif defined(__CC_ARM)  /* only work with arm v5 */
 
     __inline int32 SUB_SAD(int32 sad, int32 tmp, int32 tmp2)
@@ -76,6 +76,10 @@ Input
 #include "pvmp3_dec_defs.h"
 #include "pvmp3_tables.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 /*----------------------------------------------------------------------------
 ; MACROS
 ; Define module1 specific macros here
@@ -98,6 +102,53 @@ Input
 ; LOCAL STORE/BUFFER/POINTER DEFINITIONS
 ; Variable declaration - defined here and used outside this module1
 ----------------------------------------------------------------------------*/
+#if defined(__aarch64__)
+/*
+ *  fxp_mul32_Q32() on each lane: the 64-bit products are truncated to their
+ *  upper 32 bits, so that the sums below are bit exact with the C code.
+ */
+static inline int32x4_t mul32_Q32x4(int32x4_t a, int32x4_t b)
+{
+    int64x2_t lo = vmull_s32(vget_low_s32(a), vget_low_s32(b));
+    int64x2_t hi = vmull_high_s32(a, b);
+    return vcombine_s32(vshrn_n_s64(lo, 32), vshrn_n_s64(hi, 32));
+}
+
+/*
+ *  One output pair of the loop over j in pvmp3_polyphase_filter_window().
+ *  Each group of 4 window coefficients w0..w3 is applied to the samples
+ *  (a, b, c, d) = (temp1, temp3, temp2, temp4) as
+ *      sum1 += a*w0 - b*w1 + c*w2 + d*w3
+ *      sum2 += b*w0 + a*w1 - d*w2 + c*w3
+ *  so the lanes are accumulated separately and the signs applied at the end.
+ */
+__attribute__((no_sanitize("integer")))
+static inline void polyphase_window_pair(const int32 *pt_1, const int32 *pt_2,
+        const int32 *winPtr, int32 *sum1, int32 *sum2)
+{
+    static const int32 kSign1[4] = { 1, -1, 1, 1 };
+    static const int32 kSign2[4] = { 1, 1, -1, 1 };
+    int32x4_t acc1 = vdupq_n_s32(0);
+    int32x4_t acc2 = vdupq_n_s32(0);
+
+    for (int32 g = 0; g < 4; g++)
+    {
+        const int32 samples[4] = { pt_1[ SUBBANDS_NUMBER*(2*g)    ],
+                                   pt_2[ SUBBANDS_NUMBER*(15 - 2*g)],
+                                   pt_2[ SUBBANDS_NUMBER*(2*g + 1)],
+                                   pt_1[ SUBBANDS_NUMBER*(14 - 2*g)] };
+        int32x4_t x = vld1q_s32(samples);
+        int32x4_t w = vld1q_s32(winPtr + 4*g);
+        acc1 = vaddq_s32(acc1, mul32_Q32x4(x, w));
+        /* (b, a, d, c) */
+        acc2 = vaddq_s32(acc2, mul32_Q32x4(vrev64q_s32(x), w));
+    }
+
+    *sum1 += vaddvq_s32(vmulq_s32(acc1, vld1q_s32(kSign1)));
+    *sum2 += vaddvq_s32(vmulq_s32(acc2, vld1q_s32(kSign2)));
+}
+#endif
+
 /*----------------------------------------------------------------------------
 ; EXTERNAL FUNCTION REFERENCES
 ; Declare functions defined elsewhere and referenced in this module_x
@@ -127,7 +178,16 @@ void pvmp3_polyphase_filter_window(int32 *synth_buffer,
         sum1 = 0x00000020;
         sum2 = 0x00000020;
 
-
+#if defined(__aarch64__)
+        for (i = (SUBBANDS_NUMBER >> 1);
+                i < HAN_SIZE + (SUBBANDS_NUMBER >> 1);
+                i += SUBBANDS_NUMBER << 4)
+        {
+            polyphase_window_pair(&synth_buffer[ i+j], &synth_buffer[ i-j],
+                                  winPtr, &sum1, &sum2);
+            winPtr += 16;
+        }
+#else
         for (i = (SUBBANDS_NUMBER >> 1);
                 i < HAN_SIZE + (SUBBANDS_NUMBER >> 1);
                 i += SUBBANDS_NUMBER << 4)
@@ -192,6 +252,7 @@ void pvmp3_polyphase_filter_window(int32 *synth_buffer,
 
             winPtr += 16;
         }
+#endif
 
 
 
@@ -387,6 +387,7 @@ void BlockIterator::advance_l() {
             CHECK(nextCluster != NULL);
             CHECK(!nextCluster->EOS());
 
+            mExtractor->indexCluster_l(mCluster, nextCluster);
             mCluster = nextCluster;
 
             res = mCluster->Parse(pos, len);
@@ -584,7 +585,10 @@ int64_t BlockIterator::blockTimeUs() const {
 }
 
 void BlockIterator::seekwithoutcue_l(int64_t seekTimeUs, int64_t *actualFrameTimeUs) {
-    mCluster = mExtractor->mSegment->FindCluster(seekTimeUs * 1000ll);
+    mCluster = mExtractor->findClusterWithoutCues_l(seekTimeUs * 1000ll);
+    if (mCluster == NULL) {
+        mCluster = mExtractor->mSegment->FindCluster(seekTimeUs * 1000ll);
+    }
     const long status = mCluster->GetFirst(mBlockEntry);
     if (status < 0) {  // error
         ALOGE("get last blockenry failed!");
@@ -1485,6 +1489,67 @@ bool MatroskaExtractor::isLiveStreaming() const {
     return mIsLiveStreaming;
 }
 
+void MatroskaExtractor::indexCluster_l(
+        const mkvparser::Cluster *prev, const mkvparser::Cluster *next) {
+    if (mClusterIndex.empty()) {
+        const mkvparser::Cluster *first = mSegment->GetFirst();
+        if (first == NULL || first->EOS() || first->GetTime() < 0) {
+            return;
+        }
+        mClusterIndex.push_back({first->GetTime(), first});
+    }
+
+    // only extend the index with the cluster following its last one, so that it has
+    // no holes
+    if (prev == NULL || mClusterIndex.top().mCluster != prev) {
+        return;
+    }
+    const long long timeNs = next->GetTime();
+    if (timeNs < 0 || timeNs < mClusterIndex.top().mTimeNs) {
+        return;
+    }
+    mClusterIndex.push_back({timeNs, next});
+}
+
+const mkvparser::Cluster *MatroskaExtractor::findClusterWithoutCues_l(long long timeNs) {
+    indexCluster_l(NULL, NULL);
+    if (mClusterIndex.empty()) {
+        return NULL;
+    }
+
+    // Walk the cluster headers past the end of the index, without parsing their blocks.
+    while (mClusterIndex.top().mTimeNs <= timeNs) {
+        const mkvparser::Cluster *last = mClusterIndex.top().mCluster;
+        const mkvparser::Cluster *next;
+        long long pos;
+        long len;
+        if (mSegment->ParseNext(last, next, pos, len) != 0
+                || next == NULL || next->EOS()) {
+            break;
+        }
+        indexCluster_l(last, next);
+        if (mClusterIndex.top().mCluster != next) {
+            break;
+        }
+    }
+
+    // first cluster starting after timeNs
+    size_t lo = 0;
+    size_t hi = mClusterIndex.size();
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (mClusterIndex[mid].mTimeNs <= timeNs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // Blocks may have negative timecodes relative to their cluster, so start from the
+    // cluster before the last one starting at or before timeNs.
+    return mClusterIndex[lo > 1 ? lo - 2 : 0].mCluster;
+}
+
 static int bytesForSize(size_t size) {
     // use at most 28 bits (4 times 7)
     CHECK(size <= 0xfffffff);
@@ -92,6 +92,17 @@ private:
     bool mIsWebm;
     int64_t mSeekPreRollNs;
 
+    struct ClusterIndexEntry {
+        long long mTimeNs;
+        const mkvparser::Cluster *mCluster;
+    };
+    // Clusters from the first one on, in file order, as far as they have been read or
+    // walked by a seek. Used to seek in files without Cues.
+    Vector<ClusterIndexEntry> mClusterIndex;
+
+    void indexCluster_l(const mkvparser::Cluster *prev, const mkvparser::Cluster *next);
+    const mkvparser::Cluster *findClusterWithoutCues_l(long long timeNs);
+
     status_t synthesizeAVCC(TrackInfo *trackInfo, size_t index);
     status_t synthesizeMPEG2(TrackInfo *trackInfo, size_t index);
     status_t synthesizeMPEG4(TrackInfo *trackInfo, size_t index);
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//#define LOG_NDEBUG 0
+#define LOG_TAG "FrameIndexSeeker"
+#include <utils/Log.h>
+
+#include "FrameIndexSeeker.h"
+#include <media/stagefright/foundation/avc_utils.h>
+
+#include <media/stagefright/foundation/ByteUtils.h>
+
+#include <media/MediaExtractorPluginApi.h>
+#include <media/MediaExtractorPluginHelper.h>
+
+namespace android {
+
+// Mask to extract the version, layer, sampling rate and mode of a frame header; see
+// MP3Extractor.cpp.
+static const uint32_t kMask = 0xfffe0c00;
+
+// How far to look for the next frame after losing sync.
+static const off64_t kMaxResyncBytes = 128 * 1024;
+
+// static
+FrameIndexSeeker *FrameIndexSeeker::CreateFromSource(
+        DataSourceHelper *source, off64_t firstFramePos, uint32_t fixedHeader) {
+    size_t frameSize;
+    int sampleRate;
+    if (!GetMPEGAudioFrameSize(fixedHeader, &frameSize, &sampleRate) || sampleRate <= 0) {
+        return NULL;
+    }
+
+    return new FrameIndexSeeker(source, firstFramePos, fixedHeader, sampleRate);
+}
+
+FrameIndexSeeker::FrameIndexSeeker(
+        DataSourceHelper *source, off64_t firstFramePos, uint32_t fixedHeader,
+        int sampleRate)
+    : mSource(source),
+      mFixedHeader(fixedHeader),
+      mSampleRate(sampleRate),
+      mScanPos(firstFramePos),
+      mScanSamples(0),
+      mScanDone(false),
+      mBufferPos(0),
+      mBufferSize(0) {
+    mSeekPoints.push({0, firstFramePos, 0});
+}
+
+bool FrameIndexSeeker::getDuration(int64_t * /* durationUs */) {
+    // Only known once the whole file has been scanned.
+    return false;
+}
+
+int64_t FrameIndexSeeker::samplesToUs(int64_t samples) const {
+    return samples * 1000000 / mSampleRate;
+}
+
+bool FrameIndexSeeker::readHeader(off64_t pos, uint32_t *header) {
+    if (pos < mBufferPos || pos + 4 > mBufferPos + (off64_t)mBufferSize) {
+        ssize_t n = mSource->readAt(pos, mBuffer, kBufferSize);
+        if (n < 4) {
+            mBufferSize = 0;
+            return false;
+        }
+        mBufferPos = pos;
+        mBufferSize = n;
+    }
+    *header = U32_AT(&mBuffer[pos - mBufferPos]);
+    return true;
+}
+
+bool FrameIndexSeeker::getFrame(off64_t pos, size_t *frameSize, int *numSamples) {
+    uint32_t header;
+    return readHeader(pos, &header)
+            && (header & kMask) == (mFixedHeader & kMask)
+            && GetMPEGAudioFrameSize(header, frameSize, NULL, NULL, NULL, numSamples);
+}
+
+bool FrameIndexSeeker::resync(off64_t *pos) {
+    // a frame is accepted when it is followed by another one
+    for (off64_t candidate = *pos + 1; candidate < *pos + kMaxResyncBytes; ++candidate) {
+        size_t frameSize;
+        int numSamples;
+        if (!getFrame(candidate, &frameSize, &numSamples)) {
+            if (mBufferSize == 0) {
+                // end of stream or read error
+                return false;
+            }
+            continue;
+        }
+        size_t nextFrameSize;
+        if (getFrame(candidate + frameSize, &nextFrameSize, &numSamples)) {
+            ALOGV("resynced from %lld to %lld", (long long)*pos, (long long)candidate);
+            *pos = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FrameIndexSeeker::scanTo(int64_t timeUs) {
+    while (!mScanDone && samplesToUs(mScanSamples) <= timeUs) {
+        size_t frameSize;
+        int numSamples;
+        if (!getFrame(mScanPos, &frameSize, &numSamples)) {
+            if (!resync(&mScanPos)) {
+                ALOGV("frame scan stopped at %lld", (long long)mScanPos);
+                mScanDone = true;
+            }
+            continue;
+        }
+
+        if (samplesToUs(mScanSamples) >= mSeekPoints.top().mTimeUs + kSeekPointIntervalUs) {
+            mSeekPoints.push({samplesToUs(mScanSamples), mScanPos, mScanSamples});
+        }
+        mScanPos += frameSize;
+        mScanSamples += numSamples;
+    }
+}
+
+bool FrameIndexSeeker::getOffsetForTime(int64_t *timeUs, off64_t *pos) {
+    if (*timeUs < 0) {
+        *timeUs = 0;
+    }
+    scanTo(*timeUs);
+
+    // last seek point at or before the requested time
+    size_t lo = 0;
+    size_t hi = mSeekPoints.size();
+    while (lo + 1 < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (mSeekPoints[mid].mTimeUs <= *timeUs) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // walk the frames from the seek point to the one containing the requested time
+    off64_t framePos = mSeekPoints[lo].mPos;
+    int64_t samples = mSeekPoints[lo].mSamples;
+    for (;;) {
+        size_t frameSize;
+        int numSamples;
+        if (!getFrame(framePos, &frameSize, &numSamples)
+                || samplesToUs(samples + numSamples) > *timeUs
+                || framePos + (off64_t)frameSize >= mScanPos) {
+            break;
+        }
+        framePos += frameSize;
+        samples += numSamples;
+    }
+
+    *timeUs = samplesToUs(samples);
+    *pos = framePos;
+
+    ALOGV("seek to %lld us at %lld", (long long)*timeUs, (long long)*pos);
+    return true;
+}
+
+}  // namespace android
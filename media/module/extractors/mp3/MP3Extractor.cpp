@@ -20,6 +20,7 @@
 
 #include "MP3Extractor.h"
 
+#include "FrameIndexSeeker.h"
 #include "ID3.h"
 #include "VBRISeeker.h"
 #include "XINGSeeker.h"
@@ -28,6 +29,7 @@
 #include <media/stagefright/foundation/AMessage.h>
 #include <media/stagefright/foundation/avc_utils.h>
 #include <media/stagefright/foundation/ByteUtils.h>
+#include <media/stagefright/DataSourceBase.h>
 #include <media/stagefright/MediaBufferBase.h>
 #include <media/stagefright/MediaBufferGroup.h>
 #include <media/stagefright/MediaDefs.h>
@@ -310,6 +312,11 @@ MP3Extractor::MP3Extractor(
         }
         mFirstFramePos = pos;
         mFixedHeader = header;
+    } else if (mDataSource->flags() & DataSourceBase::kIsLocalFileSource) {
+        // Without a seek table, find the seek positions from the frame headers rather
+        // than from the bitrate of the first frame. This reads the file up to the seek
+        // positions, so only do it for local files.
+        mSeeker = FrameIndexSeeker::CreateFromSource(mDataSource, mFirstFramePos, mFixedHeader);
     }
 
     size_t frame_size;
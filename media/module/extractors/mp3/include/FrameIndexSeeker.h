@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAME_INDEX_SEEKER_H_
+
+#define FRAME_INDEX_SEEKER_H_
+
+#include "MP3Seeker.h"
+
+#include <utils/Vector.h>
+
+namespace android {
+
+class DataSourceHelper;
+
+// Seeker for files with neither a XING nor a VBRI header. The frame headers are scanned
+// as far as the seek requests need, keeping a seek point every kSeekPointIntervalUs, so
+// that seeks land on the exact frame even in VBR files, and seeks back into the scanned
+// part only read a few frame headers.
+struct FrameIndexSeeker : public MP3Seeker {
+    static FrameIndexSeeker *CreateFromSource(
+            DataSourceHelper *source, off64_t firstFramePos, uint32_t fixedHeader);
+
+    virtual bool getDuration(int64_t *durationUs);
+    virtual bool getOffsetForTime(int64_t *timeUs, off64_t *pos);
+
+private:
+    static const int64_t kSeekPointIntervalUs = 500000;
+    static const size_t kBufferSize = 16384;
+
+    struct SeekPoint {
+        int64_t mTimeUs;
+        off64_t mPos;
+        int64_t mSamples;
+    };
+
+    DataSourceHelper *mSource;
+    uint32_t mFixedHeader;
+    int mSampleRate;
+    Vector<SeekPoint> mSeekPoints;
+
+    // position and number of preceding samples of the next frame to scan
+    off64_t mScanPos;
+    int64_t mScanSamples;
+    bool mScanDone;
+
+    uint8_t mBuffer[kBufferSize];
+    off64_t mBufferPos;
+    size_t mBufferSize;
+
+    FrameIndexSeeker(
+            DataSourceHelper *source, off64_t firstFramePos, uint32_t fixedHeader,
+            int sampleRate);
+
+    int64_t samplesToUs(int64_t samples) const;
+    bool readHeader(off64_t pos, uint32_t *header);
+    bool getFrame(off64_t pos, size_t *frameSize, int *numSamples);
+    bool resync(off64_t *pos);
+    void scanTo(int64_t timeUs);
+
+    DISALLOW_EVIL_CONSTRUCTORS(FrameIndexSeeker);
+};
+
+}  // namespace android
+
+#endif  // FRAME_INDEX_SEEKER_H_
@@ -20,11 +20,13 @@
 #include <ctype.h>
 #include <inttypes.h>
 #include <algorithm>
+#include <list>
 #include <map>
 #include <memory>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 #include <log/log.h>
 #include <utils/Log.h>
@@ -81,6 +83,9 @@ enum {
     // maximum size of an atom. Some atoms can be bigger according to the spec,
     // but we only allow up to this size.
     kMaxAtomSize = 64 * 1024 * 1024,
+
+    // moov atoms up to this size are read with a single read and parsed from memory.
+    kMaxCachedMoovSize = 1024 * 1024,
 };
 
 class MPEG4Source : public MediaTrackHelper {
@@ -96,7 +101,8 @@ public:
                 off64_t firstMoofOffset,
                 const sp<ItemTable> &itemTable,
                 uint64_t elstShiftStartTicks,
-                uint64_t elstInitialEmptyEditTicks);
+                uint64_t elstInitialEmptyEditTicks,
+                SampleReadahead *readahead);
     virtual status_t init();
 
     virtual media_status_t start();
@@ -116,6 +122,7 @@ private:
 
     AMediaFormat *mFormat;
     DataSourceHelper *mDataSource;
+    SampleReadahead *mReadahead;
     int32_t mTimescale;
     sp<SampleTable> mSampleTable;
     uint32_t mCurrentSampleIndex;
@@ -176,6 +183,7 @@ private:
     uint64_t mElstInitialEmptyEditTicks;
 
     size_t parseNALSize(const uint8_t *data) const;
+    ssize_t readSampleData(off64_t offset, void *data, size_t size);
     status_t parseChunk(off64_t *offset);
     status_t parseTrackFragmentHeader(off64_t offset, off64_t size);
     status_t parseTrackFragmentRun(off64_t offset, off64_t size);
@@ -331,6 +339,151 @@ status_t CachedRangedDataSource::setCachedRange(off64_t offset,
     return OK;
 }
 
+// Serves the sample reads of the tracks of an extractor from a few readahead windows.
+// On a miss, the upcoming samples of all started tracks are looked up in their sample
+// tables, and those following the requested sample in the file are read with a single
+// sequential read. This avoids issuing one small read per sample, alternating between
+// the tracks, when the tracks are interleaved in small chunks or far apart in the file.
+class SampleReadahead {
+public:
+    explicit SampleReadahead(DataSourceHelper *source);
+
+    void addTrack(const sp<SampleTable> &sampleTable);
+    void removeTrack(const sp<SampleTable> &sampleTable);
+
+    // Reads sample |sampleIndex| of the track with |sampleTable|, at |offset| in the file.
+    ssize_t readSample(const sp<SampleTable> &sampleTable, uint32_t sampleIndex,
+            off64_t offset, void *data, size_t size);
+
+private:
+    static const size_t kWindowSize = 512 * 1024;
+    static const size_t kNumWindows = 3;
+    // Samples looked ahead per track on a miss.
+    static const uint32_t kMaxLookaheadSamples = 512;
+    // Largest gap between two upcoming samples that is read through.
+    static const size_t kMaxGapSize = 16 * 1024;
+
+    struct TrackInfo {
+        sp<SampleTable> mSampleTable;
+        uint32_t mNextSampleIndex;
+    };
+
+    struct Window {
+        off64_t mOffset;
+        size_t mSize;
+        std::vector<uint8_t> mData;
+    };
+
+    Mutex mLock;
+    DataSourceHelper *mSource;
+    std::vector<TrackInfo> mTracks;
+    // Most recently used first.
+    std::list<Window> mWindows;
+
+    size_t planRead_l(off64_t offset, size_t size);
+
+    SampleReadahead(const SampleReadahead &);
+    SampleReadahead &operator=(const SampleReadahead &);
+};
+
+SampleReadahead::SampleReadahead(DataSourceHelper *source)
+    : mSource(source) {
+}
+
+void SampleReadahead::addTrack(const sp<SampleTable> &sampleTable) {
+    Mutex::Autolock autoLock(mLock);
+    mTracks.push_back({sampleTable, 0});
+}
+
+void SampleReadahead::removeTrack(const sp<SampleTable> &sampleTable) {
+    Mutex::Autolock autoLock(mLock);
+    for (auto it = mTracks.begin(); it != mTracks.end(); ++it) {
+        if (it->mSampleTable == sampleTable) {
+            mTracks.erase(it);
+            break;
+        }
+    }
+    if (mTracks.empty()) {
+        mWindows.clear();
+    }
+}
+
+size_t SampleReadahead::planRead_l(off64_t offset, size_t size) {
+    // byte ranges of the upcoming samples of all tracks within the window
+    std::vector<std::pair<off64_t, off64_t>> ranges;
+    const off64_t windowEnd = offset + kWindowSize;
+    for (const TrackInfo &track : mTracks) {
+        for (uint32_t i = 0; i < kMaxLookaheadSamples; ++i) {
+            off64_t sampleOffset;
+            size_t sampleSize;
+            if (track.mSampleTable->getSampleOffsetAndSize(
+                    track.mNextSampleIndex + i, &sampleOffset, &sampleSize) != OK
+                    || sampleOffset >= windowEnd) {
+                break;
+            }
+            if (sampleOffset >= offset && (off64_t)sampleSize <= windowEnd - sampleOffset) {
+                ranges.push_back({sampleOffset, sampleOffset + sampleSize});
+            }
+        }
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    off64_t end = offset + size;
+    for (const auto &range : ranges) {
+        if (range.first > end + (off64_t)kMaxGapSize) {
+            break;
+        }
+        end = std::max(end, range.second);
+    }
+    return end - offset;
+}
+
+ssize_t SampleReadahead::readSample(const sp<SampleTable> &sampleTable, uint32_t sampleIndex,
+        off64_t offset, void *data, size_t size) {
+    Mutex::Autolock autoLock(mLock);
+
+    for (TrackInfo &track : mTracks) {
+        if (track.mSampleTable == sampleTable) {
+            track.mNextSampleIndex = sampleIndex + 1;
+            break;
+        }
+    }
+
+    for (auto it = mWindows.begin(); it != mWindows.end(); ++it) {
+        if (isInRange(it->mOffset, it->mSize, offset, size)) {
+            memcpy(data, &it->mData[offset - it->mOffset], size);
+            mWindows.splice(mWindows.begin(), mWindows, it);
+            return size;
+        }
+    }
+
+    size_t readSize = size > kWindowSize / 2 ? size : planRead_l(offset, size);
+    if (readSize == size) {
+        // nothing to coalesce with
+        return mSource->readAt(offset, data, size);
+    }
+
+    if (mWindows.size() < kNumWindows) {
+        mWindows.emplace_front();
+    } else {
+        mWindows.splice(mWindows.begin(), mWindows, std::prev(mWindows.end()));
+    }
+    Window &window = mWindows.front();
+    window.mData.resize(kWindowSize);
+    ssize_t bytesRead = mSource->readAt(offset, window.mData.data(), readSize);
+    if (bytesRead < (ssize_t)size) {
+        if (bytesRead > 0) {
+            memcpy(data, window.mData.data(), bytesRead);
+        }
+        mWindows.pop_front();
+        return bytesRead;
+    }
+    window.mOffset = offset;
+    window.mSize = bytesRead;
+    memcpy(data, window.mData.data(), size);
+    return size;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 static const bool kUseHexDump = false;
@@ -439,10 +592,12 @@ MPEG4Extractor::MPEG4Extractor(DataSourceHelper *source, const char *mime)
       mIsQT(false),
       mIsHeif(false),
       mHasMoovBox(false),
+      mMoovCached(false),
       mPreferHeif(mime != NULL && !strcasecmp(mime, MEDIA_MIMETYPE_CONTAINER_HEIF)),
       mIsAvif(false),
       mFirstTrack(NULL),
-      mLastTrack(NULL) {
+      mLastTrack(NULL),
+      mSampleReadahead(NULL) {
     ALOGV("mime=%s, mPreferHeif=%d", mime, mPreferHeif);
     mFileMetaData = AMediaFormat_new();
 }
@@ -462,6 +617,7 @@ MPEG4Extractor::~MPEG4Extractor() {
     }
     mPssh.clear();
 
+    delete mSampleReadahead;
     delete mDataSource;
     AMediaFormat_delete(mFileMetaData);
 }
@@ -997,12 +1153,28 @@ status_t MPEG4Extractor::parseChunk(off64_t *offset, int depth) {
                 mMoofOffset = *offset;
             }
 
+            // The boxes of the moov are parsed with many small reads, and the sample tables
+            // are read from it during playback, so keep a small moov in memory.
+            if (chunk_type == FOURCC("moov") && chunk_size <= kMaxCachedMoovSize) {
+                CachedRangedDataSource *cachedSource =
+                    new CachedRangedDataSource(mDataSource);
+
+                if (cachedSource->setCachedRange(
+                        *offset, chunk_size,
+                        true /* assume ownership on success */) == OK) {
+                    mDataSource = cachedSource;
+                    mMoovCached = true;
+                } else {
+                    delete cachedSource;
+                }
+            }
+
             if (chunk_type == FOURCC("stbl")) {
                 ALOGV("sampleTable chunk is %" PRIu64 " bytes long.", chunk_size);
 
-                if (mDataSource->flags()
+                if (!mMoovCached && (mDataSource->flags()
                         & (DataSourceBase::kWantsPrefetching
-                            | DataSourceBase::kIsCachingDataSource)) {
+                            | DataSourceBase::kIsCachingDataSource))) {
                     CachedRangedDataSource *cachedSource =
                         new CachedRangedDataSource(mDataSource);
 
@@ -4578,10 +4750,20 @@ MediaTrackHelper *MPEG4Extractor::getTrack(size_t index) {
     ALOGV("elst_initial_empty_edit_ticks in MediaTimeScale :%" PRIu64,
           elst_initial_empty_edit_ticks);
 
+    // The samples of the tracks of fragmented files and images are not in sample tables.
+    SampleReadahead *readahead = NULL;
+    if (mMoofOffset == 0 && itemTable == NULL && track->sampleTable != NULL) {
+        if (mSampleReadahead == NULL) {
+            mSampleReadahead = new SampleReadahead(mDataSource);
+        }
+        readahead = mSampleReadahead;
+    }
+
     MPEG4Source* source =
             new MPEG4Source(track->meta, mDataSource, track->timescale, track->sampleTable,
                             mSidxEntries, trex, mMoofOffset, itemTable,
-                            track->elst_shift_start_ticks, elst_initial_empty_edit_ticks);
+                            track->elst_shift_start_ticks, elst_initial_empty_edit_ticks,
+                            readahead);
     if (source->init() != OK) {
         delete source;
         return NULL;
@@ -5085,9 +5267,11 @@ MPEG4Source::MPEG4Source(
         off64_t firstMoofOffset,
         const sp<ItemTable> &itemTable,
         uint64_t elstShiftStartTicks,
-        uint64_t elstInitialEmptyEditTicks)
+        uint64_t elstInitialEmptyEditTicks,
+        SampleReadahead *readahead)
     : mFormat(format),
       mDataSource(dataSource),
+      mReadahead(readahead),
       mTimescale(timeScale),
       mSampleTable(sampleTable),
       mCurrentSampleIndex(0),
@@ -5297,6 +5481,10 @@ media_status_t MPEG4Source::start() {
     }
     mSrcBufferSize = max_size;
 
+    if (mReadahead != NULL) {
+        mReadahead->addTrack(mSampleTable);
+    }
+
     mStarted = true;
 
     return AMEDIA_OK;
@@ -5316,6 +5504,10 @@ media_status_t MPEG4Source::stop() {
     delete[] mSrcBuffer;
     mSrcBuffer = NULL;
 
+    if (mReadahead != NULL) {
+        mReadahead->removeTrack(mSampleTable);
+    }
+
     mStarted = false;
     mCurrentSampleIndex = 0;
 
@@ -6105,6 +6297,13 @@ size_t MPEG4Source::parseNALSize(const uint8_t *data) const {
     return 0;
 }
 
+ssize_t MPEG4Source::readSampleData(off64_t offset, void *data, size_t size) {
+    if (mReadahead != NULL) {
+        return mReadahead->readSample(mSampleTable, mCurrentSampleIndex, offset, data, size);
+    }
+    return mDataSource->readAt(offset, data, size);
+}
+
 int32_t MPEG4Source::parseHEVCLayerId(const uint8_t *data, size_t size) {
     if (data == nullptr || size < mNALLengthSize + 2) {
         return -1;
@@ -6406,7 +6605,7 @@ media_status_t MPEG4Source::read(
                 mBuffer->set_range(0, totalSize);
             } else {
                 ssize_t num_bytes_read =
-                    mDataSource->readAt(offset, (uint8_t *)mBuffer->data(), size);
+                    readSampleData(offset, (uint8_t *)mBuffer->data(), size);
 
                 if (num_bytes_read < (ssize_t)size) {
                     mBuffer->release();
@@ -6476,7 +6675,7 @@ media_status_t MPEG4Source::read(
         dstData[dstOffset++] = (uint8_t)((size >> 8) & 0xFF);
         dstData[dstOffset++] = (uint8_t)((size >> 0) & 0xFF);
 
-        ssize_t numBytesRead = mDataSource->readAt(offset, dstData + dstOffset, size);
+        ssize_t numBytesRead = readSampleData(offset, dstData + dstOffset, size);
         if (numBytesRead != (ssize_t)size) {
             mBuffer->release();
             mBuffer = NULL;
@@ -6513,7 +6712,7 @@ media_status_t MPEG4Source::read(
         ssize_t num_bytes_read = 0;
         bool mSrcBufferFitsDataToRead = size <= mSrcBufferSize;
         if (mSrcBufferFitsDataToRead) {
-          num_bytes_read = mDataSource->readAt(offset, mSrcBuffer, size);
+          num_bytes_read = readSampleData(offset, mSrcBuffer, size);
         } else {
           // We are trying to read a sample larger than the expected max sample size.
           // Fall through and let the failure be handled by the following if.
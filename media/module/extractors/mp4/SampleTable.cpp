@@ -18,6 +18,7 @@
 //#define LOG_NDEBUG 0
 #include <utils/Log.h>
 
+#include <algorithm>
 #include <limits>
 
 #include "SampleTable.h"
@@ -49,6 +50,12 @@ const uint32_t SampleTable::kSampleSizeTypeCompact = FOURCC("stz2");
 
 const off64_t kMaxOffset = std::numeric_limits<off64_t>::max();
 
+// Number of samples in each chunk of the composition time index.
+static const uint32_t kSampleTimeChunkSize = 1024;
+
+// Number of decoded chunks of the composition time index kept in memory.
+static const size_t kMaxDecodedSampleTimeChunks = 4;
+
 struct SampleTable::CompositionDeltaLookup {
     CompositionDeltaLookup();
 
@@ -129,6 +136,7 @@ SampleTable::SampleTable(DataSourceHelper *source)
       mTimeToSampleCount(0),
       mTimeToSample(NULL),
       mSampleTimeEntries(NULL),
+      mSampleTimeChunksBuilt(false),
       mCompositionTimeDeltaEntries(NULL),
       mNumCompositionTimeDeltaEntries(0),
       mCompositionDeltaLookup(new CompositionDeltaLookup),
@@ -139,6 +147,7 @@ SampleTable::SampleTable(DataSourceHelper *source)
       mSampleToChunkEntries(NULL),
       mTotalSize(0) {
     mSampleIterator = new SampleIterator(this);
+    mReadaheadIterator = new SampleIterator(this);
 }
 
 SampleTable::~SampleTable() {
@@ -162,6 +171,9 @@ SampleTable::~SampleTable() {
 
     delete mSampleIterator;
     mSampleIterator = NULL;
+
+    delete mReadaheadIterator;
+    mReadaheadIterator = NULL;
 }
 
 bool SampleTable::isValid() const {
@@ -714,9 +726,259 @@ void SampleTable::buildSampleEntriesTable() {
           CompareIncreasingTime);
 }
 
+uint64_t SampleTable::nextCompositionTime_l(SampleTimeCursor *cursor) {
+    while (cursor->mTimeToSampleIndex < mTimeToSampleCount
+            && cursor->mTimeToSampleOffset >= mTimeToSample[2 * cursor->mTimeToSampleIndex]) {
+        ++cursor->mTimeToSampleIndex;
+        cursor->mTimeToSampleOffset = 0;
+    }
+    // buildSampleTimeChunks_l() made sure that the time-to-sample table covers all samples
+    uint32_t delta = mTimeToSample[2 * cursor->mTimeToSampleIndex + 1];
+
+    int32_t compTimeDelta = 0;
+    if (mCompositionTimeDeltaEntries != NULL) {
+        while (cursor->mDeltaEntry < mNumCompositionTimeDeltaEntries
+                && cursor->mSampleIndex >= cursor->mDeltaEntrySampleIndex
+                        + (uint32_t)mCompositionTimeDeltaEntries[2 * cursor->mDeltaEntry]) {
+            cursor->mDeltaEntrySampleIndex +=
+                    (uint32_t)mCompositionTimeDeltaEntries[2 * cursor->mDeltaEntry];
+            ++cursor->mDeltaEntry;
+        }
+        if (cursor->mDeltaEntry < mNumCompositionTimeDeltaEntries) {
+            compTimeDelta = mCompositionTimeDeltaEntries[2 * cursor->mDeltaEntry + 1];
+        }
+    }
+
+    // same clamping as buildSampleEntriesTable()
+    uint64_t &sampleTime = cursor->mSampleTime;
+    if ((compTimeDelta < 0 && sampleTime <
+            (compTimeDelta == INT32_MIN ?
+                    INT32_MAX : uint32_t(-compTimeDelta)))
+            || (compTimeDelta > 0 &&
+                    sampleTime > UINT64_MAX - compTimeDelta)) {
+        ALOGE("%llu + %d would overflow, clamping",
+                (unsigned long long) sampleTime, compTimeDelta);
+        if (compTimeDelta < 0) {
+            sampleTime = 0;
+        } else {
+            sampleTime = UINT64_MAX;
+        }
+        compTimeDelta = 0;
+    }
+    uint64_t compositionTime = compTimeDelta > 0 ? sampleTime + compTimeDelta:
+            sampleTime - (-compTimeDelta);
+
+    ++cursor->mSampleIndex;
+    ++cursor->mTimeToSampleOffset;
+    if (sampleTime > UINT64_MAX - delta) {
+        ALOGE("%llu + %u would overflow, clamping",
+            (unsigned long long) sampleTime, delta);
+        sampleTime = UINT64_MAX;
+    } else {
+        sampleTime += delta;
+    }
+    return compositionTime;
+}
+
+bool SampleTable::buildSampleTimeChunks_l() {
+    if (mSampleTimeChunksBuilt) {
+        return !mSampleTimeChunks.empty();
+    }
+    mSampleTimeChunksBuilt = true;
+
+    if (mNumSampleSizes == 0) {
+        return false;
+    }
+    // Malformed files whose time-to-sample table does not cover all samples use the full
+    // table, which gives the missing samples a 0 time.
+    uint64_t numTimedSamples = 0;
+    for (uint32_t i = 0; i < mTimeToSampleCount; ++i) {
+        numTimedSamples += mTimeToSample[2 * i];
+    }
+    if (numTimedSamples < mNumSampleSizes) {
+        ALOGW("time-to-sample table covers %llu of %u samples",
+                (unsigned long long)numTimedSamples, mNumSampleSizes);
+        return false;
+    }
+
+    size_t numChunks = (mNumSampleSizes + kSampleTimeChunkSize - 1) / kSampleTimeChunkSize;
+    uint64_t indexSize = (uint64_t)numChunks * sizeof(SampleTimeChunk)
+            + (uint64_t)kMaxDecodedSampleTimeChunks * kSampleTimeChunkSize
+                    * sizeof(SampleTimeEntry);
+    if (mTotalSize + indexSize > kMaxTotalSize) {
+        ALOGE("Composition time index would make sample table too large.");
+        return false;
+    }
+    mTotalSize += indexSize;
+
+    mSampleTimeChunks.reserve(numChunks);
+    SampleTimeCursor cursor = {};
+    while (cursor.mSampleIndex < mNumSampleSizes) {
+        SampleTimeChunk chunk;
+        chunk.mStart = cursor;
+        chunk.mNumSamples = std::min(kSampleTimeChunkSize, mNumSampleSizes - cursor.mSampleIndex);
+        chunk.mMinCompositionTime = UINT64_MAX;
+        chunk.mMaxCompositionTime = 0;
+        for (uint32_t i = 0; i < chunk.mNumSamples; ++i) {
+            uint64_t compositionTime = nextCompositionTime_l(&cursor);
+            chunk.mMinCompositionTime = std::min(chunk.mMinCompositionTime, compositionTime);
+            chunk.mMaxCompositionTime = std::max(chunk.mMaxCompositionTime, compositionTime);
+        }
+        mSampleTimeChunks.push_back(chunk);
+    }
+    return true;
+}
+
+const std::vector<SampleTable::SampleTimeEntry> &SampleTable::getDecodedSampleTimeChunk_l(
+        size_t chunk) {
+    for (auto it = mDecodedSampleTimeChunks.begin(); it != mDecodedSampleTimeChunks.end(); ++it) {
+        if (it->mChunk == chunk) {
+            mDecodedSampleTimeChunks.splice(
+                    mDecodedSampleTimeChunks.begin(), mDecodedSampleTimeChunks, it);
+            return it->mEntries;
+        }
+    }
+    if (mDecodedSampleTimeChunks.size() >= kMaxDecodedSampleTimeChunks) {
+        mDecodedSampleTimeChunks.pop_back();
+    }
+    mDecodedSampleTimeChunks.emplace_front();
+    DecodedSampleTimeChunk &decoded = mDecodedSampleTimeChunks.front();
+    decoded.mChunk = chunk;
+
+    SampleTimeCursor cursor = mSampleTimeChunks[chunk].mStart;
+    decoded.mEntries.resize(mSampleTimeChunks[chunk].mNumSamples);
+    for (SampleTimeEntry &entry : decoded.mEntries) {
+        entry.mSampleIndex = cursor.mSampleIndex;
+        entry.mCompositionTime = nextCompositionTime_l(&cursor);
+    }
+    std::sort(decoded.mEntries.begin(), decoded.mEntries.end(),
+            [](const SampleTimeEntry &a, const SampleTimeEntry &b) {
+                return a.mCompositionTime < b.mCompositionTime;
+            });
+    return decoded.mEntries;
+}
+
+status_t SampleTable::findSampleAtTimeInChunks_l(
+        uint64_t req_time, uint64_t scale_num, uint64_t scale_den,
+        uint32_t *sample_index, uint32_t flags) {
+    if (flags == kFlagFrameIndex) {
+        // without composition time offsets the presentation order is the decoding order
+        if (req_time >= mNumSampleSizes) {
+            return ERROR_OUT_OF_RANGE;
+        }
+        *sample_index = req_time;
+        return OK;
+    }
+
+    auto scaleTime = [scale_num, scale_den](uint64_t time) -> uint64_t {
+        return scale_den != 0 ? (time * scale_num) / scale_den : 0;
+    };
+
+    // The samples right before and right after |req_time| in presentation order, given by a
+    // chunk and a position in the decoded chunk.
+    struct Candidate {
+        bool mValid = false;
+        uint64_t mTime = 0;
+        size_t mChunk = 0;
+        size_t mPosition = 0;
+    } before, after;
+
+    for (size_t i = 0; i < mSampleTimeChunks.size(); ++i) {
+        const SampleTimeChunk &chunk = mSampleTimeChunks[i];
+        uint64_t minTime = scaleTime(chunk.mMinCompositionTime);
+        uint64_t maxTime = scaleTime(chunk.mMaxCompositionTime);
+        if (maxTime < req_time) {
+            if (!before.mValid || maxTime > before.mTime) {
+                before = { true, maxTime, i, chunk.mNumSamples - 1u };
+            }
+        } else if (minTime > req_time) {
+            if (!after.mValid || minTime < after.mTime) {
+                after = { true, minTime, i, 0 };
+            }
+        } else {
+            const std::vector<SampleTimeEntry> &entries = getDecodedSampleTimeChunk_l(i);
+            // first entry after |req_time|
+            size_t left = 0;
+            size_t right = entries.size();
+            while (left < right) {
+                size_t center = left + (right - left) / 2;
+                if (scaleTime(entries[center].mCompositionTime) <= req_time) {
+                    left = center + 1;
+                } else {
+                    right = center;
+                }
+            }
+            if (left > 0) {
+                uint64_t time = scaleTime(entries[left - 1].mCompositionTime);
+                if (time == req_time) {
+                    *sample_index = entries[left - 1].mSampleIndex;
+                    return OK;
+                }
+                if (!before.mValid || time > before.mTime) {
+                    before = { true, time, i, left - 1 };
+                }
+            }
+            if (left < entries.size()) {
+                uint64_t time = scaleTime(entries[left].mCompositionTime);
+                if (!after.mValid || time < after.mTime) {
+                    after = { true, time, i, left };
+                }
+            }
+        }
+    }
+
+    if (!after.mValid) {
+        if (flags == kFlagAfter) {
+            return ERROR_OUT_OF_RANGE;
+        }
+        flags = kFlagBefore;
+    } else if (!before.mValid) {
+        // as with the full table, return the first sample instead of an out of range error,
+        // which would be treated as end-of-stream
+        flags = kFlagAfter;
+    }
+
+    const Candidate *result;
+    switch (flags) {
+        case kFlagBefore:
+            result = &before;
+            break;
+
+        case kFlagAfter:
+            result = &after;
+            break;
+
+        default:
+            CHECK(flags == kFlagClosest);
+            // pick closest based on timestamp. use abs_difference for safety
+            result = abs_difference(after.mTime, req_time) >
+                    abs_difference(req_time, before.mTime) ? &before : &after;
+            break;
+    }
+
+    *sample_index = getDecodedSampleTimeChunk_l(result->mChunk)[result->mPosition].mSampleIndex;
+    return OK;
+}
+
 status_t SampleTable::findSampleAtTime(
         uint64_t req_time, uint64_t scale_num, uint64_t scale_den,
         uint32_t *sample_index, uint32_t flags) {
+    {
+        Mutex::Autolock autoLock(mLock);
+        // Finding a frame by its presentation index needs every sample sorted when frames are
+        // reordered.
+        if (buildSampleTimeChunks_l()
+                && (flags != kFlagFrameIndex || mCompositionTimeDeltaEntries == NULL)) {
+            return findSampleAtTimeInChunks_l(
+                    req_time, scale_num, scale_den, sample_index, flags);
+        }
+    }
+    return findSampleAtTimeInTable(req_time, scale_num, scale_den, sample_index, flags);
+}
+
+status_t SampleTable::findSampleAtTimeInTable(
+        uint64_t req_time, uint64_t scale_num, uint64_t scale_den,
+        uint32_t *sample_index, uint32_t flags) {
     buildSampleEntriesTable();
 
     if (mSampleTimeEntries == NULL) {
@@ -1005,6 +1267,21 @@ status_t SampleTable::getMetaDataForSample(
     return OK;
 }
 
+status_t SampleTable::getSampleOffsetAndSize(
+        uint32_t sampleIndex, off64_t *offset, size_t *size) {
+    Mutex::Autolock autoLock(mLock);
+
+    status_t err;
+    if ((err = mReadaheadIterator->seekTo(sampleIndex)) != OK) {
+        return err;
+    }
+
+    *offset = mReadaheadIterator->getSampleOffset();
+    *size = mReadaheadIterator->getSampleSize();
+
+    return OK;
+}
+
 int32_t SampleTable::getCompositionTimeOffset(uint32_t sampleIndex) {
     return mCompositionDeltaLookup->getCompositionTimeOffset(sampleIndex);
 }
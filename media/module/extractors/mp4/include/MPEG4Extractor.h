@@ -33,6 +33,7 @@ namespace android {
 struct AMessage;
 struct CDataSource;
 class DataSourceHelper;
+class SampleReadahead;
 class SampleTable;
 class String8;
 namespace heif {
@@ -143,11 +144,15 @@ private:
     bool mIsQT;
     bool mIsHeif;
     bool mHasMoovBox;
+    bool mMoovCached;
     bool mPreferHeif;
     bool mIsAvif;
 
     Track *mFirstTrack, *mLastTrack;
 
+    // Shared by the tracks read from sample tables.
+    SampleReadahead *mSampleReadahead;
+
     AMediaFormat *mFileMetaData;
 
     Vector<uint32_t> mPath;
@@ -21,6 +21,9 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+#include <list>
+#include <vector>
+
 #include <media/MediaExtractorPluginHelper.h>
 #include <media/stagefright/MediaErrors.h>
 #include <utils/RefBase.h>
@@ -73,6 +76,11 @@ public:
     // call only after getMetaDataForSample has been called successfully.
     uint32_t getLastSampleIndexInChunk();
 
+    // Same as getMetaDataForSample(), but with a separate iterator, so that looking ahead
+    // of the samples being read does not move the iterator used for reading.
+    status_t getSampleOffsetAndSize(
+            uint32_t sampleIndex, off64_t *offset, size_t *size);
+
     enum {
         kFlagBefore,
         kFlagAfter,
@@ -132,6 +140,35 @@ private:
     };
     SampleTimeEntry *mSampleTimeEntries;
 
+    // Position of a sample in the time-to-sample and composition-time-to-sample tables.
+    struct SampleTimeCursor {
+        uint32_t mSampleIndex;
+        uint32_t mTimeToSampleIndex;
+        uint32_t mTimeToSampleOffset;
+        uint64_t mSampleTime;
+        size_t mDeltaEntry;
+        size_t mDeltaEntrySampleIndex;
+    };
+
+    // Index of the composition times used by findSampleAtTime(). The samples are split in
+    // decoding order into chunks, and only the composition time range of each chunk is kept.
+    // The chunks that may hold the requested time are decoded and sorted on demand.
+    struct SampleTimeChunk {
+        SampleTimeCursor mStart;
+        uint32_t mNumSamples;
+        uint64_t mMinCompositionTime;
+        uint64_t mMaxCompositionTime;
+    };
+    bool mSampleTimeChunksBuilt;
+    std::vector<SampleTimeChunk> mSampleTimeChunks;
+
+    // Recently decoded chunks, most recently used first.
+    struct DecodedSampleTimeChunk {
+        size_t mChunk;
+        std::vector<SampleTimeEntry> mEntries;
+    };
+    std::list<DecodedSampleTimeChunk> mDecodedSampleTimeChunks;
+
     int32_t *mCompositionTimeDeltaEntries;
     size_t mNumCompositionTimeDeltaEntries;
     CompositionDeltaLookup *mCompositionDeltaLookup;
@@ -142,6 +179,7 @@ private:
     size_t mLastSyncSampleIndex;
 
     SampleIterator *mSampleIterator;
+    SampleIterator *mReadaheadIterator;
 
     struct SampleToChunkEntry {
         uint32_t startChunk;
@@ -169,6 +207,16 @@ private:
     static int CompareIncreasingTime(const void *, const void *);
 
     void buildSampleEntriesTable();
+    status_t findSampleAtTimeInTable(
+            uint64_t req_time, uint64_t scale_num, uint64_t scale_den,
+            uint32_t *sample_index, uint32_t flags);
+
+    uint64_t nextCompositionTime_l(SampleTimeCursor *cursor);
+    bool buildSampleTimeChunks_l();
+    const std::vector<SampleTimeEntry> &getDecodedSampleTimeChunk_l(size_t chunk);
+    status_t findSampleAtTimeInChunks_l(
+            uint64_t req_time, uint64_t scale_num, uint64_t scale_den,
+            uint32_t *sample_index, uint32_t flags);
 
     SampleTable(const SampleTable &);
     SampleTable &operator=(const SampleTable &);
@@ -110,7 +110,8 @@ protected:
 
     struct TOCEntry {
         off64_t mPageOffset;
-        int64_t mTimeUs;
+        // granule position of the page preceding this one
+        uint64_t mPrevGranulePosition;
     };
 
     MediaBufferGroupHelper *mBufferGroup;
@@ -136,7 +137,16 @@ protected:
     AMediaFormat *mMeta;
     AMediaFormat *mFileMeta;
 
+    // Pages of the stream, in stream order. The table either covers the whole stream
+    // (mTableOfContentsComplete), or the pages read so far from the first data page up
+    // to mTableOfContentsEndOffset, ending at mTableOfContentsEndTimeUs. In the latter case
+    // only every mTableOfContentsStride'th page is kept.
     Vector<TOCEntry> mTableOfContents;
+    bool mTableOfContentsComplete;
+    off64_t mTableOfContentsEndOffset;
+    int64_t mTableOfContentsEndTimeUs;
+    size_t mTableOfContentsStride;
+    size_t mNumPagesSinceTOCEntry;
 
     int32_t mHapticChannelCount;
 
@@ -169,6 +179,11 @@ protected:
     status_t findPrevGranulePosition(off64_t pageOffset, uint64_t *granulePos);
 
     void buildTableOfContents();
+    void addPageToTableOfContents(
+            off64_t pageOffset, size_t pageSize, uint64_t granulePos,
+            uint64_t prevGranulePos);
+
+    void seekToPage(off64_t pageOffset, uint64_t prevGranulePosition);
 
     void setChannelMask(int channelCount);
 
@@ -324,6 +339,11 @@ MyOggExtractor::MyOggExtractor(
       mNumHeaders(numHeaders),
       mSeekPreRollUs(seekPreRollUs),
       mFirstDataOffset(-1),
+      mTableOfContentsComplete(false),
+      mTableOfContentsEndOffset(-1),
+      mTableOfContentsEndTimeUs(0),
+      mTableOfContentsStride(1),
+      mNumPagesSinceTOCEntry(0),
       mHapticChannelCount(0) {
     mCurrentPage.mNumSegments = 0;
     mCurrentPage.mFlags = 0;
@@ -493,7 +513,8 @@ status_t MyOggExtractor::seekToTime(int64_t timeUs) {
         timeUs = 0;
     }
 
-    if (mTableOfContents.isEmpty()) {
+    if (mTableOfContents.isEmpty()
+            || (!mTableOfContentsComplete && timeUs > mTableOfContentsEndTimeUs)) {
         // Perform approximate seeking based on avg. bitrate.
         uint64_t bps = approxBitrate();
         if (bps <= 0) {
@@ -506,33 +527,31 @@ status_t MyOggExtractor::seekToTime(int64_t timeUs) {
         return seekToOffset(pos);
     }
 
+    // Find the last page starting at or before the requested time. As the table may not
+    // hold every page, the page ending at or after it could be past the requested time.
     size_t left = 0;
     size_t right_plus_one = mTableOfContents.size();
-    while (left < right_plus_one) {
+    while (left + 1 < right_plus_one) {
         size_t center = left + (right_plus_one - left) / 2;
 
         const TOCEntry &entry = mTableOfContents.itemAt(center);
 
-        if (timeUs < entry.mTimeUs) {
+        if (timeUs < getTimeUsOfGranule(entry.mPrevGranulePosition)) {
             right_plus_one = center;
-        } else if (timeUs > entry.mTimeUs) {
-            left = center + 1;
         } else {
             left = center;
-            break;
         }
     }
 
-    if (left == mTableOfContents.size()) {
-        --left;
-    }
-
     const TOCEntry &entry = mTableOfContents.itemAt(left);
 
     ALOGV("seeking to entry %zu / %zu at offset %lld",
          left, mTableOfContents.size(), (long long)entry.mPageOffset);
 
-    return seekToOffset(entry.mPageOffset);
+    // The entry gives both the page start and the granule position preceding it, so
+    // there is no need to look for them in the stream.
+    seekToPage(entry.mPageOffset, entry.mPrevGranulePosition);
+    return OK;
 }
 
 status_t MyOggExtractor::seekToOffset(off64_t offset) {
@@ -552,8 +571,15 @@ status_t MyOggExtractor::seekToOffset(off64_t offset) {
     // We found the page we wanted to seek to, but we'll also need
     // the page preceding it to determine how many valid samples are on
     // this page.
-    findPrevGranulePosition(pageOffset, &mPrevGranulePosition);
+    uint64_t prevGranulePosition;
+    findPrevGranulePosition(pageOffset, &prevGranulePosition);
+
+    seekToPage(pageOffset, prevGranulePosition);
+    return OK;
+}
 
+void MyOggExtractor::seekToPage(off64_t pageOffset, uint64_t prevGranulePosition) {
+    mPrevGranulePosition = prevGranulePosition;
     mOffset = pageOffset;
 
     mCurrentPageSize = 0;
@@ -564,8 +590,6 @@ status_t MyOggExtractor::seekToOffset(off64_t offset) {
     mNextLaceIndex = 0;
 
     // XXX what if new page continues packet from last???
-
-    return OK;
 }
 
 ssize_t MyOggExtractor::readPage(off64_t offset, Page *page) {
@@ -949,6 +973,9 @@ media_status_t MyOggExtractor::_readNextPacket(MediaBufferHelper **out, bool cal
         }
         mFirstPacketInPage = true;
 
+        addPageToTableOfContents(
+                mOffset, n, mCurrentPage.mGranulePosition, mPrevGranulePosition);
+
         mPrevGranulePosition = mCurrentPage.mGranulePosition;
 
         mCurrentPageSize = n;
@@ -1000,6 +1027,7 @@ status_t MyOggExtractor::init() {
     }
 
     mFirstDataOffset = mOffset + mCurrentPageSize;
+    mTableOfContentsEndOffset = mFirstDataOffset;
 
     off64_t size;
     uint64_t lastGranulePosition;
@@ -1022,27 +1050,40 @@ status_t MyOggExtractor::init() {
     return AMEDIA_OK;
 }
 
+// A page on which no packet ends has no granule position.
+static const uint64_t kNoGranulePosition = UINT64_MAX;
+
+// Limit the maximum amount of RAM we spend on the table of contents.
+static const size_t kMaxTOCSize = 8192;
+
 void MyOggExtractor::buildTableOfContents() {
+    mTableOfContents.clear();
+    mTableOfContentsComplete = true;
+
     off64_t offset = mFirstDataOffset;
+    // the data starts after the last header page
+    uint64_t prevGranulePosition = mCurrentPage.mGranulePosition;
     Page page;
     ssize_t pageSize;
     while ((pageSize = readPage(offset, &page)) > 0) {
-        mTableOfContents.push();
+        if (page.mGranulePosition != kNoGranulePosition) {
+            mTableOfContents.push();
 
-        TOCEntry &entry =
-            mTableOfContents.editItemAt(mTableOfContents.size() - 1);
+            TOCEntry &entry =
+                mTableOfContents.editItemAt(mTableOfContents.size() - 1);
 
-        entry.mPageOffset = offset;
-        entry.mTimeUs = getTimeUsOfGranule(page.mGranulePosition);
+            entry.mPageOffset = offset;
+            entry.mPrevGranulePosition = prevGranulePosition;
+
+            prevGranulePosition = page.mGranulePosition;
+        }
 
         offset += (size_t)pageSize;
     }
 
-    // Limit the maximum amount of RAM we spend on the table of contents,
-    // if necessary thin out the table evenly to trim it down to maximum
+    // If necessary thin out the table evenly to trim it down to maximum
     // size.
 
-    static const size_t kMaxTOCSize = 8192;
     static const size_t kMaxNumTOCEntries = kMaxTOCSize / sizeof(TOCEntry);
 
     size_t numerator = mTableOfContents.size();
@@ -1066,6 +1107,45 @@ void MyOggExtractor::buildTableOfContents() {
     }
 }
 
+// Called for every page read; indexes the pages read in sequence from the first data page,
+// so that seeking back into the part of the stream already played does not need to rely
+// on the average bitrate.
+void MyOggExtractor::addPageToTableOfContents(
+        off64_t pageOffset, size_t pageSize, uint64_t granulePos, uint64_t prevGranulePos) {
+    if (mTableOfContentsComplete || pageOffset != mTableOfContentsEndOffset) {
+        return;
+    }
+    mTableOfContentsEndOffset = pageOffset + pageSize;
+
+    if (granulePos == kNoGranulePosition) {
+        return;
+    }
+    mTableOfContentsEndTimeUs = getTimeUsOfGranule(granulePos);
+
+    if (prevGranulePos == kNoGranulePosition || ++mNumPagesSinceTOCEntry < mTableOfContentsStride) {
+        return;
+    }
+    mNumPagesSinceTOCEntry = 0;
+
+    // When the table is full, keep every other entry and index half as many pages
+    // from now on.
+    static const size_t kMaxNumTOCEntries = kMaxTOCSize / sizeof(TOCEntry);
+    if (mTableOfContents.size() >= kMaxNumTOCEntries) {
+        Vector<TOCEntry> halfTOC;
+        halfTOC.setCapacity(kMaxNumTOCEntries);
+        for (size_t i = 0; i < mTableOfContents.size(); i += 2) {
+            halfTOC.push(mTableOfContents.itemAt(i));
+        }
+        mTableOfContents = halfTOC;
+        mTableOfContentsStride *= 2;
+    }
+
+    TOCEntry entry;
+    entry.mPageOffset = pageOffset;
+    entry.mPrevGranulePosition = prevGranulePos;
+    mTableOfContents.push(entry);
+}
+
 int32_t MyOggExtractor::getPacketBlockSize(MediaBufferHelper *buffer) {
     const uint8_t *data =
         (const uint8_t *)buffer->data() + buffer->range_offset();
@@ -37,6 +37,16 @@ bool ABitReader::fillReservoir() {
         return false;
     }
 
+    if (mSize >= 4) {
+        // refill the whole reservoir at once
+        mReservoir = ((uint32_t)mData[0] << 24) | ((uint32_t)mData[1] << 16)
+                | ((uint32_t)mData[2] << 8) | mData[3];
+        mData += 4;
+        mSize -= 4;
+        mNumBitsLeft = 32;
+        return true;
+    }
+
     mReservoir = 0;
     size_t i;
     for (i = 0; mSize > 0 && i < 4; ++i) {
@@ -74,7 +74,12 @@ int64_t ALooper::getNowUs() {
 }
 
 ALooper::ALooper()
-    : mRunningLocally(false) {
+    : mQueueDepth(0),
+      mMaxQueueDepth(0),
+      mDispatchCount(0),
+      mTotalDispatchLatencyUs(0),
+      mMaxDispatchLatencyUs(0),
+      mRunningLocally(false) {
     // clean up stale AHandlers. Doing it here instead of in the destructor avoids
     // the side effect of objects being deleted from the unregister function recursively.
     gLooperRoster.unregisterStaleHandlers();
@@ -181,21 +186,51 @@ void ALooper::post(const sp<AMessage> &msg, int64_t delayUs) {
         whenUs = getNowUs();
     }
 
-    List<Event>::iterator it = mEventQueue.begin();
-    while (it != mEventQueue.end() && (*it).mWhenUs <= whenUs) {
-        ++it;
-    }
-
     Event event;
     event.mWhenUs = whenUs;
     event.mMessage = msg;
     event.mToken = nullptr;
 
-    if (it == mEventQueue.begin()) {
+    if (insertEvent_l(event)) {
         mQueueChangedCondition.signal();
     }
+}
 
+bool ALooper::insertEvent_l(const Event &event) {
+    // Most events are posted with no or a short delay, so they belong at or near the
+    // back of the queue: search from there, after any event with the same time.
+    List<Event>::iterator it = mEventQueue.end();
+    while (it != mEventQueue.begin()) {
+        List<Event>::iterator prev = it;
+        --prev;
+        if (prev->mWhenUs <= event.mWhenUs) {
+            break;
+        }
+        it = prev;
+    }
+    const bool first = it == mEventQueue.begin();
     mEventQueue.insert(it, event);
+    if (++mQueueDepth > mMaxQueueDepth) {
+        mMaxQueueDepth = mQueueDepth;
+    }
+    return first;
+}
+
+ALooper::Stats ALooper::getStats(bool clear) {
+    Mutex::Autolock autoLock(mLock);
+    Stats stats;
+    stats.mQueueDepth = mQueueDepth;
+    stats.mMaxQueueDepth = mMaxQueueDepth;
+    stats.mDispatchCount = mDispatchCount;
+    stats.mTotalDispatchLatencyUs = mTotalDispatchLatencyUs;
+    stats.mMaxDispatchLatencyUs = mMaxDispatchLatencyUs;
+    if (clear) {
+        mMaxQueueDepth = mQueueDepth;
+        mDispatchCount = 0;
+        mTotalDispatchLatencyUs = 0;
+        mMaxDispatchLatencyUs = 0;
+    }
+    return stats;
 }
 
 status_t ALooper::postUnique(const sp<AMessage> &msg, const sp<RefBase> &token, int64_t delayUs) {
@@ -221,22 +256,17 @@ status_t ALooper::postUnique(const sp<AMessage> &msg, const sp<RefBase> &token,
     for (auto i = mEventQueue.begin(); i != mEventQueue.end();) {
         if (i->mToken == token) {
             i = mEventQueue.erase(i);
+            --mQueueDepth;
         } else {
             ++i;
         }
     }
 
-    // Find the insertion point for the rescheduled message.
-    List<Event>::iterator i = mEventQueue.begin();
-    while (i != mEventQueue.end() && i->mWhenUs <= whenUs) {
-        ++i;
-    }
-
     Event event;
     event.mWhenUs = whenUs;
     event.mMessage = msg;
     event.mToken = token;
-    mEventQueue.insert(i, event);
+    insertEvent_l(event);
 
     // If we rescheduled the event to be earlier than the first event, then we need to wake up the
     // looper earlier than it was previously scheduled to be woken up. Otherwise, it can sleep until
@@ -275,6 +305,14 @@ bool ALooper::loop() {
 
         event = *mEventQueue.begin();
         mEventQueue.erase(mEventQueue.begin());
+        --mQueueDepth;
+
+        const int64_t latencyUs = nowUs - whenUs;
+        ++mDispatchCount;
+        mTotalDispatchLatencyUs += latencyUs;
+        if (latencyUs > mMaxDispatchLatencyUs) {
+            mMaxDispatchLatencyUs = latencyUs;
+        }
     }
 
     event.mMessage->deliver();
@@ -135,12 +135,21 @@ void ALooperRoster::dump(int fd, const Vector<String16>& args) {
     size_t n = mHandlers.size();
     s.appendFormat(" %zu registered handlers:\n", n);
 
+    Vector<sp<ALooper>> loopers;
+
     for (size_t i = 0; i < n; i++) {
         s.appendFormat("  %d: ", mHandlers.keyAt(i));
         HandlerInfo &info = mHandlers.editValueAt(i);
         sp<ALooper> looper = info.mLooper.promote();
         if (looper != NULL) {
             s.append(looper->getName());
+            bool known = false;
+            for (size_t j = 0; j < loopers.size() && !known; j++) {
+                known = loopers[j] == looper;
+            }
+            if (!known) {
+                loopers.push_back(looper);
+            }
             sp<AHandler> handler = info.mHandler.promote();
             if (handler != NULL) {
                 bool deliveringMessages;
@@ -180,6 +189,20 @@ void ALooperRoster::dump(int fd, const Vector<String16>& args) {
         }
         s.append("\n");
     }
+
+    s.appendFormat(" %zu active loopers:\n", loopers.size());
+    for (size_t i = 0; i < loopers.size(); i++) {
+        const ALooper::Stats stats = loopers[i]->getStats(clear);
+        s.appendFormat("  %s: queue depth %zu (max %zu), %" PRIu64 " messages dispatched, "
+                       "dispatch latency avg %" PRId64 " us max %" PRId64 " us\n",
+                       loopers[i]->getName(),
+                       stats.mQueueDepth,
+                       stats.mMaxQueueDepth,
+                       stats.mDispatchCount,
+                       stats.mDispatchCount == 0 ? 0 :
+                               stats.mTotalDispatchLatencyUs / (int64_t)stats.mDispatchCount,
+                       stats.mMaxDispatchLatencyUs);
+    }
     (void)write(fd, s.string(), s.size());
 }
 
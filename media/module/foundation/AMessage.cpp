@@ -89,8 +89,7 @@ void AMessage::setTarget(const sp<const AHandler> &handler) {
 void AMessage::clear() {
     // Item needs to be handled delicately
     for (Item &item : mItems) {
-        delete[] item.mName;
-        item.mName = NULL;
+        item.freeName();
         freeItemValue(&item);
     }
     mItems.clear();
@@ -162,7 +161,7 @@ inline size_t AMessage::findItemIndex(const char *name, size_t len) const {
 #ifdef DUMP_STATS
         ++memchecks;
 #endif
-        if (!memcmp(mItems[i].mName, name, len)) {
+        if (!memcmp(mItems[i].name(), name, len)) {
             break;
         }
     }
@@ -179,16 +178,24 @@ inline size_t AMessage::findItemIndex(const char *name, size_t len) const {
     return i;
 }
 
-// assumes item's name was uninitialized or NULL
+// assumes item's name was uninitialized or freed
 void AMessage::Item::setName(const char *name, size_t len) {
     mNameLength = len;
-    mName = new char[len + 1];
-    memcpy((void*)mName, name, len + 1);
+    char *dst = len <= kMaxInlineNameLength ? mInlineName : (mHeapName = new char[len + 1]);
+    memcpy(dst, name, len + 1);
+}
+
+void AMessage::Item::freeName() {
+    if (mNameLength > kMaxInlineNameLength) {
+        delete[] mHeapName;
+    }
+    mNameLength = 0;
+    mInlineName[0] = '\0';
 }
 
 AMessage::Item::Item(const char *name, size_t len)
     : mType(kTypeInt32) {
-    // mName and mNameLength are initialized by setName
+    // the name and mNameLength are initialized by setName
     setName(name, len);
 }
 
@@ -202,6 +209,10 @@ AMessage::Item *AMessage::allocateItem(const char *name) {
         freeItemValue(item);
     } else {
         CHECK(mItems.size() < kMaxNumItems);
+        if (mItems.empty()) {
+            // most messages have a few items, avoid growing the vector one by one
+            mItems.reserve(kInitialNumItems);
+        }
         i = mItems.size();
         // place a 'blank' item at the end - this is of type kTypeInt32
         mItems.emplace_back(name, len);
@@ -590,65 +601,65 @@ AString AMessage::debugString(int32_t indent) const {
         switch (item.mType) {
             case kTypeInt32:
                 tmp = AStringPrintf(
-                        "int32_t %s = %d", item.mName, item.u.int32Value);
+                        "int32_t %s = %d", item.name(), item.u.int32Value);
                 break;
             case kTypeInt64:
                 tmp = AStringPrintf(
-                        "int64_t %s = %lld", item.mName, item.u.int64Value);
+                        "int64_t %s = %lld", item.name(), item.u.int64Value);
                 break;
             case kTypeSize:
                 tmp = AStringPrintf(
-                        "size_t %s = %d", item.mName, item.u.sizeValue);
+                        "size_t %s = %d", item.name(), item.u.sizeValue);
                 break;
             case kTypeFloat:
                 tmp = AStringPrintf(
-                        "float %s = %f", item.mName, item.u.floatValue);
+                        "float %s = %f", item.name(), item.u.floatValue);
                 break;
             case kTypeDouble:
                 tmp = AStringPrintf(
-                        "double %s = %f", item.mName, item.u.doubleValue);
+                        "double %s = %f", item.name(), item.u.doubleValue);
                 break;
             case kTypePointer:
                 tmp = AStringPrintf(
-                        "void *%s = %p", item.mName, item.u.ptrValue);
+                        "void *%s = %p", item.name(), item.u.ptrValue);
                 break;
             case kTypeString:
                 tmp = AStringPrintf(
                         "string %s = \"%s\"",
-                        item.mName,
+                        item.name(),
                         item.u.stringValue->c_str());
                 break;
             case kTypeObject:
                 tmp = AStringPrintf(
-                        "RefBase *%s = %p", item.mName, item.u.refValue);
+                        "RefBase *%s = %p", item.name(), item.u.refValue);
                 break;
             case kTypeBuffer:
             {
                 sp<ABuffer> buffer = static_cast<ABuffer *>(item.u.refValue);
 
                 if (buffer != NULL && buffer->data() != NULL && buffer->size() <= 64) {
-                    tmp = AStringPrintf("Buffer %s = {\n", item.mName);
+                    tmp = AStringPrintf("Buffer %s = {\n", item.name());
                     hexdump(buffer->data(), buffer->size(), indent + 4, &tmp);
                     appendIndent(&tmp, indent + 2);
                     tmp.append("}");
                 } else {
                     tmp = AStringPrintf(
-                            "Buffer *%s = %p", item.mName, buffer.get());
+                            "Buffer *%s = %p", item.name(), buffer.get());
                 }
                 break;
             }
             case kTypeMessage:
                 tmp = AStringPrintf(
                         "AMessage %s = %s",
-                        item.mName,
+                        item.name(),
                         static_cast<AMessage *>(
                             item.u.refValue)->debugString(
-                                indent + strlen(item.mName) + 14).c_str());
+                                indent + strlen(item.name()) + 14).c_str());
                 break;
             case kTypeRect:
                 tmp = AStringPrintf(
                         "Rect %s(%d, %d, %d, %d)",
-                        item.mName,
+                        item.name(),
                         item.u.rectValue.mLeft,
                         item.u.rectValue.mTop,
                         item.u.rectValue.mRight,
@@ -782,7 +793,7 @@ void AMessage::writeToParcel(Parcel *parcel) const {
     parcel->writeInt32(static_cast<int32_t>(mItems.size()));
 
     for (const Item &item : mItems) {
-        parcel->writeCString(item.mName);
+        parcel->writeCString(item.name());
         parcel->writeInt32(static_cast<int32_t>(item.mType));
 
         switch (item.mType) {
@@ -852,55 +863,55 @@ sp<AMessage> AMessage::changesFrom(const sp<const AMessage> &other, bool deep) c
     }
 
     for (const Item &item : mItems) {
-        const Item *oitem = other->findItem(item.mName, item.mType);
+        const Item *oitem = other->findItem(item.name(), item.mType);
         switch (item.mType) {
             case kTypeInt32:
                 if (oitem == NULL || item.u.int32Value != oitem->u.int32Value) {
-                    diff->setInt32(item.mName, item.u.int32Value);
+                    diff->setInt32(item.name(), item.u.int32Value);
                 }
                 break;
 
             case kTypeInt64:
                 if (oitem == NULL || item.u.int64Value != oitem->u.int64Value) {
-                    diff->setInt64(item.mName, item.u.int64Value);
+                    diff->setInt64(item.name(), item.u.int64Value);
                 }
                 break;
 
             case kTypeSize:
                 if (oitem == NULL || item.u.sizeValue != oitem->u.sizeValue) {
-                    diff->setSize(item.mName, item.u.sizeValue);
+                    diff->setSize(item.name(), item.u.sizeValue);
                 }
                 break;
 
             case kTypeFloat:
                 if (oitem == NULL || item.u.floatValue != oitem->u.floatValue) {
-                    diff->setFloat(item.mName, item.u.sizeValue);
+                    diff->setFloat(item.name(), item.u.sizeValue);
                 }
                 break;
 
             case kTypeDouble:
                 if (oitem == NULL || item.u.doubleValue != oitem->u.doubleValue) {
-                    diff->setDouble(item.mName, item.u.sizeValue);
+                    diff->setDouble(item.name(), item.u.sizeValue);
                 }
                 break;
 
             case kTypeString:
                 if (oitem == NULL || *item.u.stringValue != *oitem->u.stringValue) {
-                    diff->setString(item.mName, *item.u.stringValue);
+                    diff->setString(item.name(), *item.u.stringValue);
                 }
                 break;
 
             case kTypeRect:
                 if (oitem == NULL || memcmp(&item.u.rectValue, &oitem->u.rectValue, sizeof(Rect))) {
                     diff->setRect(
-                            item.mName, item.u.rectValue.mLeft, item.u.rectValue.mTop,
+                            item.name(), item.u.rectValue.mLeft, item.u.rectValue.mTop,
                             item.u.rectValue.mRight, item.u.rectValue.mBottom);
                 }
                 break;
 
             case kTypePointer:
                 if (oitem == NULL || item.u.ptrValue != oitem->u.ptrValue) {
-                    diff->setPointer(item.mName, item.u.ptrValue);
+                    diff->setPointer(item.name(), item.u.ptrValue);
                 }
                 break;
 
@@ -909,7 +920,7 @@ sp<AMessage> AMessage::changesFrom(const sp<const AMessage> &other, bool deep) c
                 sp<ABuffer> myBuf = static_cast<ABuffer *>(item.u.refValue);
                 if (myBuf == NULL) {
                     if (oitem == NULL || oitem->u.refValue != NULL) {
-                        diff->setBuffer(item.mName, NULL);
+                        diff->setBuffer(item.name(), NULL);
                     }
                     break;
                 }
@@ -918,7 +929,7 @@ sp<AMessage> AMessage::changesFrom(const sp<const AMessage> &other, bool deep) c
                         || myBuf->size() != oBuf->size()
                         || (!myBuf->data() ^ !oBuf->data()) // data nullness differs
                         || (myBuf->data() && memcmp(myBuf->data(), oBuf->data(), myBuf->size()))) {
-                    diff->setBuffer(item.mName, myBuf);
+                    diff->setBuffer(item.name(), myBuf);
                 }
                 break;
             }
@@ -928,7 +939,7 @@ sp<AMessage> AMessage::changesFrom(const sp<const AMessage> &other, bool deep) c
                 sp<AMessage> myMsg = static_cast<AMessage *>(item.u.refValue);
                 if (myMsg == NULL) {
                     if (oitem == NULL || oitem->u.refValue != NULL) {
-                        diff->setMessage(item.mName, NULL);
+                        diff->setMessage(item.name(), NULL);
                     }
                     break;
                 }
@@ -936,14 +947,14 @@ sp<AMessage> AMessage::changesFrom(const sp<const AMessage> &other, bool deep) c
                     oitem == NULL ? NULL : static_cast<AMessage *>(oitem->u.refValue);
                 sp<AMessage> changes = myMsg->changesFrom(oMsg, deep);
                 if (changes->countEntries()) {
-                    diff->setMessage(item.mName, deep ? changes : myMsg);
+                    diff->setMessage(item.name(), deep ? changes : myMsg);
                 }
                 break;
             }
 
             case kTypeObject:
                 if (oitem == NULL || item.u.refValue != oitem->u.refValue) {
-                    diff->setObject(item.mName, item.u.refValue);
+                    diff->setObject(item.name(), item.u.refValue);
                 }
                 break;
 
@@ -975,7 +986,7 @@ const char *AMessage::getEntryNameAt(size_t index, Type *type) const {
 
     *type = mItems[index].mType;
 
-    return mItems[index].mName;
+    return mItems[index].name();
 }
 
 AMessage::ItemData AMessage::getEntryAt(size_t index) const {
@@ -1019,15 +1030,14 @@ status_t AMessage::setEntryNameAt(size_t index, const char *name) {
     if (name == nullptr) {
         return BAD_VALUE;
     }
-    if (!strcmp(name, mItems[index].mName)) {
+    if (!strcmp(name, mItems[index].name())) {
         return OK; // name has not changed
     }
     size_t len = strlen(name);
     if (findItemIndex(name, len) < mItems.size()) {
         return ALREADY_EXISTS;
     }
-    delete[] mItems[index].mName;
-    mItems[index].mName = nullptr;
+    mItems[index].freeName();
     mItems[index].setName(name, len);
     return OK;
 }
@@ -1091,15 +1101,14 @@ status_t AMessage::removeEntryAt(size_t index) {
         return BAD_INDEX;
     }
     // delete entry data and objects
-    delete[] mItems[index].mName;
-    mItems[index].mName = nullptr;
+    mItems[index].freeName();
     freeItemValue(&mItems[index]);
 
     // swap entry with last entry and clear last entry's data
     size_t lastIndex = mItems.size() - 1;
     if (index < lastIndex) {
+        // the name moves with the item, whether it is inline or on the heap
         mItems[index] = mItems[lastIndex];
-        mItems[lastIndex].mName = nullptr;
         mItems[lastIndex].mType = kTypeInt32;
     }
     mItems.pop_back();
@@ -1137,7 +1146,7 @@ void AMessage::extend(const sp<AMessage> &other) {
     }
 
     for (size_t ix = 0; ix < other->mItems.size(); ++ix) {
-        Item *it = allocateItem(other->mItems[ix].mName);
+        Item *it = allocateItem(other->mItems[ix].name());
         if (it != nullptr) {
             ItemData data = other->getEntryAt(ix);
             setEntryAt(it - &mItems[0], data);
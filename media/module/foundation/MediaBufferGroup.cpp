@@ -17,6 +17,7 @@
 #define LOG_TAG "MediaBufferGroup"
 #include <utils/Log.h>
 
+#include <inttypes.h>
 #include <list>
 
 #include <binder/MemoryDealer.h>
@@ -41,6 +42,12 @@ struct MediaBufferGroup::InternalData {
     Condition mCondition;
     size_t mGrowthLimit;  // Do not automatically grow group larger than this.
     std::list<MediaBufferBase *> mBuffers;
+
+    // Blocking acquires currently waiting for a buffer to be returned.
+    size_t mNumWaiters = 0;
+    // Number of times an acquire waited, and the total time spent waiting.
+    size_t mNumWaits = 0;
+    nsecs_t mTotalWaitNs = 0;
 };
 
 MediaBufferGroup::MediaBufferGroup(size_t growthLimit)
@@ -102,6 +109,9 @@ void MediaBufferGroup::init(size_t buffers, size_t buffer_size, size_t growthLim
 }
 
 MediaBufferGroup::~MediaBufferGroup() {
+    ALOGD_IF(mInternal->mNumWaits > 0,
+            "waited %zu times for a free buffer, %" PRId64 " us in total",
+            mInternal->mNumWaits, mInternal->mTotalWaitNs / 1000);
     for (MediaBufferBase *buffer : mInternal->mBuffers) {
         if (buffer->refcount() != 0) {
             const int localRefcount = buffer->localRefcount();
@@ -176,8 +186,12 @@ status_t MediaBufferGroup::acquire_buffer(
             }
             if ((*it)->refcount() == 0) {
                 if (size >= requestedSize) {
-                    buffer = *it;
-                    break;
+                    // Use the smallest free buffer that fits, keeping larger
+                    // buffers for larger requests.
+                    if (buffer == nullptr || size < buffer->size()) {
+                        buffer = *it;
+                    }
+                    continue;
                 }
                 if (size < smallest) {
                     smallest = size; // always free the smallest buf
@@ -222,7 +236,12 @@ status_t MediaBufferGroup::acquire_buffer(
             return WOULD_BLOCK;
         }
         // All buffers are in use, block until one of them is returned.
+        const nsecs_t waitStartNs = systemTime();
+        ++mInternal->mNumWaiters;
         mInternal->mCondition.wait(mInternal->mLock);
+        --mInternal->mNumWaiters;
+        ++mInternal->mNumWaits;
+        mInternal->mTotalWaitNs += systemTime() - waitStartNs;
     }
     // Never gets here.
 }
@@ -233,7 +252,10 @@ size_t MediaBufferGroup::buffers() const {
 
 void MediaBufferGroup::signalBufferReturned(MediaBufferBase *) {
     Mutex::Autolock autoLock(mInternal->mLock);
-    mInternal->mCondition.signal();
+    // Most buffers are returned while no reader is blocked in acquire_buffer().
+    if (mInternal->mNumWaiters > 0) {
+        mInternal->mCondition.signal();
+    }
 }
 
 }  // namespace android
@@ -16,6 +16,7 @@
 
 //#define LOG_NDEBUG 0
 #define LOG_TAG "MetaDataBase"
+#include <algorithm>
 #include <inttypes.h>
 #include <utils/KeyedVector.h>
 #include <utils/Log.h>
@@ -51,9 +52,11 @@ private:
     uint32_t mType;
     size_t mSize;
 
+    // The reservoir holds items up to 64 bits inline, which covers the per-sample
+    // time, duration and flag keys without a heap allocation.
     union {
         void *ext_data;
-        float reservoir;
+        int64_t reservoir;
     } u;
 
     bool usesReservoir() const {
@@ -500,6 +503,15 @@ status_t MetaDataBase::writeToParcel(Parcel &parcel) {
 status_t MetaDataBase::updateFromParcel(const Parcel &parcel) {
     uint32_t numItems;
     if (parcel.readUint32(&numItems) == OK) {
+        // Reserve room for all items up front rather than growing the vector per
+        // item. Each item takes at least its key, type and size words, which bounds
+        // the count by what is left in the parcel.
+        const size_t maxItems = parcel.dataAvail() / (3 * sizeof(uint32_t));
+        const size_t capacity =
+                mInternalData->mItems.size() + std::min<size_t>(numItems, maxItems);
+        if (capacity > mInternalData->mItems.capacity()) {
+            mInternalData->mItems.setCapacity(capacity);
+        }
 
         for (size_t i = 0; i < numItems; i++) {
             int32_t key;
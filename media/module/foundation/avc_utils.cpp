@@ -28,6 +28,8 @@
 #include <media/stagefright/MetaData.h>
 #include <utils/misc.h>
 
+#include <string.h>
+
 namespace android {
 
 unsigned parseUE(ABitReader *br) {
@@ -305,11 +307,20 @@ status_t getNextNALUnit(
     size_t offset = 0;
 
     // A valid startcode consists of at least two 0x00 bytes followed by 0x01.
-    for (; offset + 2 < size; ++offset) {
-        if (data[offset + 2] == 0x01 && data[offset] == 0x00
-                && data[offset + 1] == 0x00) {
+    // Find the candidate 0x01 bytes with memchr(), which scans many bytes at a time,
+    // and only then check for the leading zeros.
+    while (offset + 2 < size) {
+        const uint8_t *one = (const uint8_t *)memchr(
+                &data[offset + 2], 0x01, size - offset - 2);
+        if (one == NULL) {
+            offset = size - 2;
+            break;
+        }
+        offset = one - data - 2;
+        if (data[offset] == 0x00 && data[offset + 1] == 0x00) {
             break;
         }
+        ++offset;
     }
     if (offset + 2 >= size) {
         *_data = &data[offset];
@@ -321,9 +332,9 @@ status_t getNextNALUnit(
     size_t startOffset = offset;
 
     for (;;) {
-        while (offset < size && data[offset] != 0x01) {
-            ++offset;
-        }
+        const uint8_t *one = offset < size
+                ? (const uint8_t *)memchr(&data[offset], 0x01, size - offset) : NULL;
+        offset = one != NULL ? one - data : size;
 
         if (offset == size) {
             if (startCodeFollows) {
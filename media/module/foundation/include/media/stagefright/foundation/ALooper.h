@@ -58,6 +58,18 @@ struct ALooper : public RefBase {
         return mName.c_str();
     }
 
+    // Event queue statistics, for dumpsys.
+    struct Stats {
+        size_t mQueueDepth;             // events currently pending
+        size_t mMaxQueueDepth;          // since the last clear
+        uint64_t mDispatchCount;        // events delivered since the last clear
+        int64_t mTotalDispatchLatencyUs;
+        int64_t mMaxDispatchLatencyUs;  // delivery time past the scheduled time
+    };
+
+    // Returns the current statistics and optionally clears them.
+    Stats getStats(bool clear = false);
+
 protected:
     // overridable by test harness
     virtual int64_t getNowUs();
@@ -78,7 +90,13 @@ private:
 
     AString mName;
 
+    // sorted by mWhenUs; events with the same time are kept in posting order
     List<Event> mEventQueue;
+    size_t mQueueDepth;             // mEventQueue.size(), which is linear
+    size_t mMaxQueueDepth;
+    uint64_t mDispatchCount;
+    int64_t mTotalDispatchLatencyUs;
+    int64_t mMaxDispatchLatencyUs;
 
     struct LooperThread;
     sp<LooperThread> mThread;
@@ -110,6 +128,9 @@ private:
 
     // END --- methods used only by AMessage
 
+    // Inserts the event in time order and returns true if it is now the first event.
+    bool insertEvent_l(const Event &event);
+
     bool loop();
 
     DISALLOW_EVIL_CONSTRUCTORS(ALooper);
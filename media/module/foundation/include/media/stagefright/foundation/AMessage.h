@@ -200,6 +200,7 @@ struct AMessage : public RefBase {
 
     size_t countEntries() const;
     static size_t maxAllowedEntries();
+    // The returned name is only valid until an entry is added, renamed or removed.
     const char *getEntryNameAt(size_t index, Type *type) const;
 
     /**
@@ -307,15 +308,29 @@ private:
             AString *stringValue;
             Rect rectValue;
         } u;
-        const char *mName;
+        // Short names, which are most of them, are stored in the item itself to avoid
+        // a heap allocation per item. The item must not be copied with its name
+        // without calling setName() on the copy.
+        enum {
+            kMaxInlineNameLength = 15
+        };
+        union {
+            char *mHeapName;
+            char mInlineName[kMaxInlineNameLength + 1];
+        };
         size_t      mNameLength;
         Type mType;
+        const char *name() const {
+            return mNameLength <= kMaxInlineNameLength ? mInlineName : mHeapName;
+        }
         void setName(const char *name, size_t len);
-        Item() : mName(nullptr), mNameLength(0), mType(kTypeInt32) { }
+        void freeName();
+        Item() : mNameLength(0), mType(kTypeInt32) { mInlineName[0] = '\0'; }
         Item(const char *name, size_t length);
     };
 
     enum {
+        kInitialNumItems = 8,
         kMaxNumItems = 256
     };
     std::vector<Item> mItems;
@@ -22,6 +22,7 @@
 #include <utils/RefBase.h>
 
 #include <media/stagefright/foundation/AMessage.h>
+#include <media/stagefright/foundation/AString.h>
 #include <media/stagefright/foundation/AHandler.h>
 #include <media/stagefright/foundation/ALooper.h>
 
@@ -75,6 +76,41 @@ TEST(AMessage_tests, countsAndLimits) {
   EXPECT_EQ(m1->maxAllowedEntries(), AMessage::maxAllowedEntries());
 }
 
+TEST(AMessage_tests, shortAndLongNames) {
+  sp<AMessage> m1 = new AMessage();
+
+  // names around the length of the inline name storage
+  const char *kNames[] = {
+      "a", "fifteen-chars-x", "sixteen-chars-xy", "a-much-longer-name-stored-on-the-heap"};
+  for (size_t i = 0; i < 4; ++i) {
+    m1->setInt32(kNames[i], i);
+  }
+  // adding many more items moves the existing ones
+  for (int32_t i = 0; i < 32; ++i) {
+    m1->setInt32(AStringPrintf("extra-%d", i).c_str(), i);
+  }
+  sp<AMessage> m2 = m1->dup();
+  m1->clear();
+  for (size_t i = 0; i < 4; ++i) {
+    int32_t value;
+    EXPECT_TRUE(m2->findInt32(kNames[i], &value)) << kNames[i];
+    EXPECT_EQ((int32_t)i, value);
+  }
+
+  // removing an entry swaps in the last one, renaming to a long name and back
+  EXPECT_EQ(OK, m2->removeEntryByName("fifteen-chars-x"));
+  EXPECT_FALSE(m2->contains("fifteen-chars-x"));
+  EXPECT_TRUE(m2->contains("extra-31"));
+  size_t index = m2->findEntryByName("a");
+  EXPECT_EQ(OK, m2->setEntryNameAt(index, "a-new-name-which-is-long"));
+  EXPECT_EQ(index, m2->findEntryByName("a-new-name-which-is-long"));
+  AMessage::Type type;
+  EXPECT_STREQ("a-new-name-which-is-long", m2->getEntryNameAt(index, &type));
+  EXPECT_EQ(OK, m2->setEntryNameAt(index, "b"));
+  EXPECT_STREQ("b", m2->getEntryNameAt(index, &type));
+  EXPECT_EQ(35, m2->countEntries());
+}
+
 TEST(AMessage_tests, settersAndGetters) {
   sp<AMessage> m1 = new AMessage();
 
@@ -234,6 +270,49 @@ TEST(AMessage_tests, deliversDelayedMessagesInSequence) {
   nanosleep(&millis100, nullptr); // just enough time for the looper thread to run
 }
 
+TEST(AMessage_tests, deliversSameTimeMessagesInPostingOrder) {
+  sp<NiceMock<MockHandler>> mockHandler = new NiceMock<MockHandler>;
+  sp<LooperWithSettableClock> looper = new LooperWithSettableClock();
+  looper->registerHandler(mockHandler);
+
+  sp<AMessage> msgIn100a = new AMessage(0, mockHandler);
+  msgIn100a->post(100);
+  sp<AMessage> msgIn100b = new AMessage(0, mockHandler);
+  msgIn100b->post(100);
+  sp<AMessage> msgIn50 = new AMessage(0, mockHandler);
+  msgIn50->post(50);
+  sp<AMessage> msgIn100c = new AMessage(0, mockHandler);
+  msgIn100c->post(100);
+
+  ALooper::Stats stats = looper->getStats();
+  EXPECT_EQ(4u, stats.mQueueDepth);
+  EXPECT_EQ(4u, stats.mMaxQueueDepth);
+  EXPECT_EQ(0u, stats.mDispatchCount);
+
+  looper->setClockUs(100);
+  {
+    InSequence inSequence;
+
+    EXPECT_CALL(*mockHandler, onMessageReceived(msgIn50)).Times(1);
+    EXPECT_CALL(*mockHandler, onMessageReceived(msgIn100a)).Times(1);
+    EXPECT_CALL(*mockHandler, onMessageReceived(msgIn100b)).Times(1);
+    EXPECT_CALL(*mockHandler, onMessageReceived(msgIn100c)).Times(1);
+  }
+  looper->start();
+  nanosleep(&millis100, nullptr); // just enough time for the looper thread to run
+
+  stats = looper->getStats(true /* clear */);
+  EXPECT_EQ(0u, stats.mQueueDepth);
+  EXPECT_EQ(4u, stats.mMaxQueueDepth);
+  EXPECT_EQ(4u, stats.mDispatchCount);
+  EXPECT_EQ(50, stats.mTotalDispatchLatencyUs);
+  EXPECT_EQ(50, stats.mMaxDispatchLatencyUs);
+
+  stats = looper->getStats();
+  EXPECT_EQ(0u, stats.mMaxQueueDepth);
+  EXPECT_EQ(0u, stats.mDispatchCount);
+}
+
 TEST(AMessage_tests, deliversDelayedUniqueMessage) {
   sp<NiceMock<MockHandler>> mockHandler = new NiceMock<MockHandler>;
   sp<LooperWithSettableClock> looper = new LooperWithSettableClock();
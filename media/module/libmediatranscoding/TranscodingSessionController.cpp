@@ -600,15 +600,17 @@ void TranscodingSessionController::removeSession_l(
         const std::shared_ptr<std::function<bool(uid_t uid)>>& keepUid) {
     ALOGV("%s: session %s", __FUNCTION__, sessionToString(sessionKey).c_str());
 
-    if (mSessionMap.count(sessionKey) == 0) {
+    auto sessionIt = mSessionMap.find(sessionKey);
+    if (sessionIt == mSessionMap.end()) {
         ALOGE("session %s doesn't exist", sessionToString(sessionKey).c_str());
         return;
     }
+    Session& session = sessionIt->second;
 
     // Remove session from uid's queue.
     bool uidQueueRemoved = false;
     std::unordered_set<uid_t> remainingUids;
-    for (uid_t uid : mSessionMap[sessionKey].allClientUids) {
+    for (uid_t uid : session.allClientUids) {
         if (keepUid != nullptr) {
             if ((*keepUid)(uid)) {
                 remainingUids.insert(uid);
@@ -644,30 +646,30 @@ void TranscodingSessionController::removeSession_l(
     }
 
     if (keepUid != nullptr) {
-        mSessionMap[sessionKey].allClientUids = remainingUids;
+        session.allClientUids = remainingUids;
         return;
     }
 
     // Clear current session.
-    if (mCurrentSession == &mSessionMap[sessionKey]) {
+    if (mCurrentSession == &session) {
         mCurrentSession = nullptr;
     }
 
-    setSessionState_l(&mSessionMap[sessionKey], finalState);
+    setSessionState_l(&session, finalState);
 
     // We can use onSessionCompleted() even for CANCELLED, because runningTime is
     // now updated by setSessionState_l().
-    for (uid_t uid : mSessionMap[sessionKey].allClientUids) {
-        mPacer->onSessionCompleted(uid, mSessionMap[sessionKey].runningTime);
+    for (uid_t uid : session.allClientUids) {
+        mPacer->onSessionCompleted(uid, session.runningTime);
     }
 
-    mSessionHistory.push_back(mSessionMap[sessionKey]);
+    mSessionHistory.push_back(session);
     if (mSessionHistory.size() > kSessionHistoryMax) {
         mSessionHistory.erase(mSessionHistory.begin());
     }
 
     // Remove session from session map.
-    mSessionMap.erase(sessionKey);
+    mSessionMap.erase(sessionIt);
 }
 
 /**
@@ -54,7 +54,7 @@ static constexpr int32_t kDefaultFrameRate = 30;
 static constexpr int32_t kDefaultCodecComplexity = 1;
 
 template <typename T>
-void VideoTrackTranscoder::BlockingQueue<T>::push(T const& value, bool front) {
+void VideoTrackTranscoder::BlockingQueue<T>::push(T value, bool front) {
     {
         std::scoped_lock lock(mMutex);
         if (mAborted) {
@@ -62,9 +62,9 @@ void VideoTrackTranscoder::BlockingQueue<T>::push(T const& value, bool front) {
         }
 
         if (front) {
-            mQueue.push_front(value);
+            mQueue.push_front(std::move(value));
         } else {
-            mQueue.push_back(value);
+            mQueue.push_back(std::move(value));
         }
     }
     mCondition.notify_one();
@@ -76,7 +76,7 @@ T VideoTrackTranscoder::BlockingQueue<T>::pop() {
     while (mQueue.empty()) {
         mCondition.wait(lock);
     }
-    T value = mQueue.front();
+    T value = std::move(mQueue.front());
     mQueue.pop_front();
     return value;
 }
@@ -133,10 +133,22 @@ struct AsyncCodecCallbackDispatch {
                 static_cast<VideoTrackTranscoder::CodecWrapper*>(userdata);
         AMediaCodecBufferInfo bufferInfo = *bufferInfoPtr;
         if (auto transcoder = wrapper->getTranscoder()) {
+            if (codec == transcoder->mDecoder) {
+                // Render decoded frames to the encoder input surface right away instead of
+                // waiting behind encoder output handling on the transcoder thread. Only the
+                // end of stream needs to be handled there.
+                if (index >= 0) {
+                    AMediaCodec_releaseOutputBuffer(codec, index, bufferInfo.size > 0);
+                }
+                if (bufferInfo.flags & AMEDIACODEC_BUFFER_FLAG_END_OF_STREAM) {
+                    transcoder->mCodecMessageQueue.push([transcoder, bufferInfo] {
+                        transcoder->transferBuffer(-1 /* bufferIndex */, bufferInfo);
+                    });
+                }
+                return;
+            }
             transcoder->mCodecMessageQueue.push([transcoder, index, codec, bufferInfo] {
-                if (codec == transcoder->mDecoder) {
-                    transcoder->transferBuffer(index, bufferInfo);
-                } else if (codec == transcoder->mEncoder->getCodec()) {
+                if (codec == transcoder->mEncoder->getCodec()) {
                     transcoder->dequeueOutputSample(index, bufferInfo);
                 }
             });
@@ -150,6 +162,12 @@ struct AsyncCodecCallbackDispatch {
             const bool isDecoder = codec == transcoder->mDecoder;
             const char* kCodecName = (isDecoder ? "Decoder" : "Encoder");
             LOG(INFO) << kCodecName << " format changed: " << AMediaFormat_toString(format);
+            if (isDecoder) {
+                // Decoded frames bypass the message queue, so forward the color information
+                // to the encoder before any frame in the new format is rendered.
+                transcoder->updateTrackFormat(format, isDecoder);
+                return;
+            }
             transcoder->mCodecMessageQueue.push([transcoder, format, isDecoder] {
                 transcoder->updateTrackFormat(format, isDecoder);
             });
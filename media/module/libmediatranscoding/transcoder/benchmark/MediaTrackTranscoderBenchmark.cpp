@@ -44,6 +44,8 @@
 #include <media/PassthroughTrackTranscoder.h>
 #include <media/VideoTrackTranscoder.h>
 
+#include <chrono>
+
 using namespace android;
 
 typedef enum {
@@ -226,6 +228,65 @@ private:
     int64_t mPtsDiff = 0;
 };
 
+/**
+ * TimedSampleReader forwards all calls to another MediaSampleReader and accumulates the time spent
+ * extracting samples, so that the benchmark can tell the extractor cost apart from the codecs.
+ */
+class TimedSampleReader : public MediaSampleReader {
+public:
+    explicit TimedSampleReader(const std::shared_ptr<MediaSampleReader>& reader)
+          : mReader(reader) {}
+
+    AMediaFormat* getFileFormat() override { return mReader->getFileFormat(); }
+
+    size_t getTrackCount() const override { return mReader->getTrackCount(); }
+
+    AMediaFormat* getTrackFormat(int trackIndex) override {
+        return mReader->getTrackFormat(trackIndex);
+    }
+
+    media_status_t selectTrack(int trackIndex) override {
+        return mReader->selectTrack(trackIndex);
+    }
+
+    media_status_t unselectTrack(int trackIndex) override {
+        return mReader->unselectTrack(trackIndex);
+    }
+
+    media_status_t setEnforceSequentialAccess(bool enforce) override {
+        return mReader->setEnforceSequentialAccess(enforce);
+    }
+
+    media_status_t getEstimatedBitrateForTrack(int trackIndex, int32_t* bitrate) override {
+        return mReader->getEstimatedBitrateForTrack(trackIndex, bitrate);
+    }
+
+    media_status_t getSampleInfoForTrack(int trackIndex, MediaSampleInfo* info) override {
+        auto start = std::chrono::steady_clock::now();
+        media_status_t status = mReader->getSampleInfoForTrack(trackIndex, info);
+        mExtractTime += std::chrono::steady_clock::now() - start;
+        return status;
+    }
+
+    media_status_t readSampleDataForTrack(int trackIndex, uint8_t* buffer,
+                                          size_t bufferSize) override {
+        auto start = std::chrono::steady_clock::now();
+        media_status_t status = mReader->readSampleDataForTrack(trackIndex, buffer, bufferSize);
+        mExtractTime += std::chrono::steady_clock::now() - start;
+        return status;
+    }
+
+    void advanceTrack(int trackIndex) override { mReader->advanceTrack(trackIndex); }
+
+    double getExtractTimeMs() const {
+        return std::chrono::duration<double, std::milli>(mExtractTime).count();
+    }
+
+private:
+    std::shared_ptr<MediaSampleReader> mReader;
+    std::chrono::steady_clock::duration mExtractTime{0};
+};
+
 static std::shared_ptr<AMediaFormat> GetDefaultTrackFormat(MediaType mediaType,
                                                            AMediaFormat* sourceFormat) {
     // Default video config.
@@ -276,15 +337,21 @@ static std::shared_ptr<MediaSampleReader> GetSampleReader(const std::string& src
 
 /**
  * Configures a MediaTrackTranscoder with an empty sample consumer so that the samples are returned
- * to the transcoder immediately.
+ * to the transcoder immediately. The arrival time of the first sample is recorded in
+ * firstSampleTime.
  */
-static void ConfigureEmptySampleConsumer(const std::shared_ptr<MediaTrackTranscoder>& transcoder,
-                                         uint32_t& sampleCount) {
-    transcoder->setSampleConsumer([&sampleCount](const std::shared_ptr<MediaSample>& sample) {
-        if (!(sample->info.flags & SAMPLE_FLAG_CODEC_CONFIG) && sample->info.size > 0) {
-            ++sampleCount;
-        }
-    });
+static void ConfigureEmptySampleConsumer(
+        const std::shared_ptr<MediaTrackTranscoder>& transcoder, uint32_t& sampleCount,
+        std::chrono::steady_clock::time_point& firstSampleTime) {
+    transcoder->setSampleConsumer(
+            [&sampleCount, &firstSampleTime](const std::shared_ptr<MediaSample>& sample) {
+                if (!(sample->info.flags & SAMPLE_FLAG_CODEC_CONFIG) && sample->info.size > 0) {
+                    if (sampleCount == 0) {
+                        firstSampleTime = std::chrono::steady_clock::now();
+                    }
+                    ++sampleCount;
+                }
+            });
 }
 
 /**
@@ -349,6 +416,9 @@ static void BenchmarkTranscoder(benchmark::State& state, const std::string& srcF
     static pthread_once_t once = PTHREAD_ONCE_INIT;
     pthread_once(&once, ABinderProcess_startThreadPool);
 
+    double totalExtractTimeMs = 0;
+    double totalFirstSampleLatencyMs = 0;
+
     for (auto _ : state) {
         std::shared_ptr<TrackTranscoderCallbacks> callbacks =
                 std::make_shared<TrackTranscoderCallbacks>();
@@ -360,11 +430,12 @@ static void BenchmarkTranscoder(benchmark::State& state, const std::string& srcF
             transcoder = std::make_shared<PassthroughTrackTranscoder>(callbacks);
         }
 
-        std::shared_ptr<MediaSampleReader> sampleReader = GetSampleReader(srcFileName, mockReader);
-        if (sampleReader == nullptr) {
+        std::shared_ptr<MediaSampleReader> sourceReader = GetSampleReader(srcFileName, mockReader);
+        if (sourceReader == nullptr) {
             state.SkipWithError("Unable to create sample reader");
             return;
         }
+        auto sampleReader = std::make_shared<TimedSampleReader>(sourceReader);
 
         if (!ConfigureSampleReader(transcoder, sampleReader, mediaType, formatEditor)) {
             state.SkipWithError("Unable to configure the transcoder");
@@ -372,8 +443,10 @@ static void BenchmarkTranscoder(benchmark::State& state, const std::string& srcF
         }
 
         uint32_t sampleCount = 0;
-        ConfigureEmptySampleConsumer(transcoder, sampleCount);
+        std::chrono::steady_clock::time_point firstSampleTime;
+        ConfigureEmptySampleConsumer(transcoder, sampleCount, firstSampleTime);
 
+        const auto startTime = std::chrono::steady_clock::now();
         if (!transcoder->start()) {
             state.SkipWithError("Unable to start the transcoder");
             return;
@@ -389,7 +462,20 @@ static void BenchmarkTranscoder(benchmark::State& state, const std::string& srcF
 
         LOG(DEBUG) << "Number of samples received: " << sampleCount;
         state.counters["FrameRate"] = benchmark::Counter(sampleCount, benchmark::Counter::kIsRate);
+
+        totalExtractTimeMs += sampleReader->getExtractTimeMs();
+        if (sampleCount > 0) {
+            totalFirstSampleLatencyMs +=
+                    std::chrono::duration<double, std::milli>(firstSampleTime - startTime).count();
+        }
     }
+
+    // Per-stage breakdown: time spent in the sample reader, and the pipeline latency until the
+    // first encoded sample comes out.
+    state.counters["ExtractTimeMs"] =
+            benchmark::Counter(totalExtractTimeMs, benchmark::Counter::kAvgIterations);
+    state.counters["FirstSampleLatencyMs"] =
+            benchmark::Counter(totalFirstSampleLatencyMs, benchmark::Counter::kAvgIterations);
 }
 
 static void BenchmarkTranscoderWithOperatingRate(benchmark::State& state,
@@ -49,11 +49,14 @@ public:
     /** Starts the muxer. */
     virtual media_status_t start() = 0;
     /**
-     * Writes sample data to a previously added track.
+     * Writes sample data to a previously added track. The call only needs to hand the sample
+     * over to the muxer; the default AMediaMuxer implementation copies it into the MPEG4
+     * writer's chunk queue, which interleaves tracks and writes whole chunks to the file on
+     * its own thread.
      * @param trackIndex Index of the track the sample data belongs to.
      * @param data The sample data.
      * @param info The sample information.
-     * @return The number of bytes written.
+     * @return AMEDIA_OK on success, or an error status.
      */
     virtual media_status_t writeSampleData(size_t trackIndex, const uint8_t* data,
                                            const AMediaCodecBufferInfo* info) = 0;
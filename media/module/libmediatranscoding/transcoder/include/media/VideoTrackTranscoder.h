@@ -51,7 +51,7 @@ private:
     template <typename T>
     class BlockingQueue {
     public:
-        void push(T const& value, bool front = false);
+        void push(T value, bool front = false);
         T pop();
         void abort();
 
@@ -43,6 +43,7 @@
 #include <utils/KeyedVector.h>
 #include <utils/Vector.h>
 
+#include <algorithm>
 #include <inttypes.h>
 
 namespace android {
@@ -77,6 +78,10 @@ struct ATSParser::Program : public RefBase {
             unsigned random_access_indicator,
             ABitReader *br, status_t *err, SyncEvent *event);
 
+    // Sets the entries of |pidToProgram| for the PIDs of the streams of this program to
+    // |programIndex|, unless another program already has them.
+    void mapStreamPIDs(int32_t *pidToProgram, int32_t programIndex) const;
+
     void signalDiscontinuity(
             DiscontinuityType type, const sp<AMessage> &extra);
 
@@ -345,6 +350,15 @@ bool ATSParser::Program::parsePID(
     return true;
 }
 
+void ATSParser::Program::mapStreamPIDs(int32_t *pidToProgram, int32_t programIndex) const {
+    for (size_t i = 0; i < mStreams.size(); ++i) {
+        unsigned pid = mStreams.keyAt(i);
+        if (pid < kNumPIDs && pidToProgram[pid] < 0) {
+            pidToProgram[pid] = programIndex;
+        }
+    }
+}
+
 void ATSParser::Program::signalDiscontinuity(
         DiscontinuityType type, const sp<AMessage> &extra) {
     int64_t mediaTimeUs;
@@ -1903,6 +1917,7 @@ ATSParser::ATSParser(uint32_t flags)
       mTimeOffsetUs(0LL),
       mLastRecoveredPTS(-1LL),
       mNumTSPacketsParsed(0),
+      mPIDToProgramValid(false),
       mNumPCRs(0) {
     mPSISections.add(0 /* PID */, new PSISection);
     mCasManager = new CasManager();
@@ -1922,6 +1937,30 @@ status_t ATSParser::feedTSPacket(const void *data, size_t size,
     return parseTS(&br, event);
 }
 
+status_t ATSParser::feedTSPackets(const void *data, size_t size, size_t *consumed) {
+    const uint8_t *packets = (const uint8_t *)data;
+    size_t offset = 0;
+    status_t err = OK;
+    while (offset + kTSPacketSize <= size) {
+        ABitReader br(packets + offset, kTSPacketSize);
+        err = parseTS(&br, NULL);
+        if (err != OK) {
+            break;
+        }
+        offset += kTSPacketSize;
+    }
+    *consumed = offset;
+    return err;
+}
+
+void ATSParser::updatePIDToProgram() {
+    std::fill(mPIDToProgram, mPIDToProgram + kNumPIDs, -1);
+    for (size_t i = 0; i < mPrograms.size(); ++i) {
+        mPrograms.itemAt(i)->mapStreamPIDs(mPIDToProgram, i);
+    }
+    mPIDToProgramValid = true;
+}
+
 status_t ATSParser::setMediaCas(const sp<ICas> &cas) {
     status_t err = mCasManager->setMediaCas(cas);
     if (err != OK) {
@@ -2099,6 +2138,9 @@ status_t ATSParser::parsePID(
         }
         ABitReader sectionBits(section->data(), section->size());
 
+        // the PAT and PMTs add programs and streams
+        mPIDToProgramValid = false;
+
         if (PID == 0) {
             parseProgramAssociationTable(&sectionBits);
         } else {
@@ -2131,21 +2173,22 @@ status_t ATSParser::parsePID(
         return OK;
     }
 
+    if (!mPIDToProgramValid) {
+        updatePIDToProgram();
+    }
+
     bool handled = false;
-    for (size_t i = 0; i < mPrograms.size(); ++i) {
+    int32_t programIndex = PID < kNumPIDs ? mPIDToProgram[PID] : -1;
+    if (programIndex >= 0) {
         status_t err;
-        if (mPrograms.editItemAt(i)->parsePID(
-                    PID, continuity_counter,
-                    payload_unit_start_indicator,
-                    transport_scrambling_control,
-                    random_access_indicator,
-                    br, &err, event)) {
-            if (err != OK) {
-                return err;
-            }
-
-            handled = true;
-            break;
+        handled = mPrograms.editItemAt(programIndex)->parsePID(
+                PID, continuity_counter,
+                payload_unit_start_indicator,
+                transport_scrambling_control,
+                random_access_indicator,
+                br, &err, event);
+        if (handled && err != OK) {
+            return err;
         }
     }
 
@@ -2233,34 +2276,42 @@ status_t ATSParser::parseAdaptationField(
 status_t ATSParser::parseTS(ABitReader *br, SyncEvent *event) {
     ALOGV("---");
 
-    unsigned sync_byte = br->getBits(8);
+    // The packet header is byte aligned, so read it directly rather than bit by bit.
+    if (br->numBitsLeft() < 32) {
+        return ERROR_MALFORMED;
+    }
+    const uint8_t *header = br->data();
+
+    unsigned sync_byte = header[0];
     if (sync_byte != 0x47u) {
         ALOGE("[error] parseTS: return error as sync_byte=0x%x", sync_byte);
         return BAD_VALUE;
     }
 
-    if (br->getBits(1)) {  // transport_error_indicator
+    if (header[1] & 0x80) {  // transport_error_indicator
         // silently ignore.
         return OK;
     }
 
-    unsigned payload_unit_start_indicator = br->getBits(1);
+    unsigned payload_unit_start_indicator = (header[1] >> 6) & 1;
     ALOGV("payload_unit_start_indicator = %u", payload_unit_start_indicator);
 
-    MY_LOGV("transport_priority = %u", br->getBits(1));
+    MY_LOGV("transport_priority = %u", (header[1] >> 5) & 1);
 
-    unsigned PID = br->getBits(13);
+    unsigned PID = ((header[1] & 0x1f) << 8) | header[2];
     ALOGV("PID = 0x%04x", PID);
 
-    unsigned transport_scrambling_control = br->getBits(2);
+    unsigned transport_scrambling_control = header[3] >> 6;
     ALOGV("transport_scrambling_control = %u", transport_scrambling_control);
 
-    unsigned adaptation_field_control = br->getBits(2);
+    unsigned adaptation_field_control = (header[3] >> 4) & 3;
     ALOGV("adaptation_field_control = %u", adaptation_field_control);
 
-    unsigned continuity_counter = br->getBits(4);
+    unsigned continuity_counter = header[3] & 0x0f;
     ALOGV("PID = 0x%04x, continuity_counter = %u", PID, continuity_counter);
 
+    br->skipBits(32);
+
     // ALOGI("PID = 0x%04x, continuity_counter = %u", PID, continuity_counter);
 
     status_t err = OK;
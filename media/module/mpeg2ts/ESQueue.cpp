@@ -1162,7 +1162,15 @@ status_t ElementaryStreamQueue::appendData(
     }
 
     size_t neededSize = (mBuffer == NULL ? 0 : mBuffer->size()) + size;
-    if (mBuffer == NULL || neededSize > mBuffer->capacity()) {
+    if (mBuffer != NULL && mBuffer->offset() > 0
+            && mBuffer->offset() + neededSize > mBuffer->capacity()
+            && neededSize <= mBuffer->capacity()) {
+        // Reclaim the space of the access units dequeued from the front of the buffer,
+        // which dequeueAccessUnitH264() leaves in place instead of moving the data left.
+        memmove(mBuffer->base(), mBuffer->data(), mBuffer->size());
+        mBuffer->setRange(0, mBuffer->size());
+    }
+    if (mBuffer == NULL || mBuffer->offset() + neededSize > mBuffer->capacity()) {
         neededSize = (neededSize + 65535) & ~65535;
 
         ALOGV("resizing buffer to size %zu", neededSize);
@@ -1179,7 +1187,7 @@ status_t ElementaryStreamQueue::appendData(
     }
 
     memcpy(mBuffer->data() + mBuffer->size(), data, size);
-    mBuffer->setRange(0, mBuffer->size() + size);
+    mBuffer->setRange(mBuffer->offset(), mBuffer->size() + size);
 
     RangeInfo info;
     info.mLength = size;
@@ -1388,11 +1396,7 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnit() {
         memcpy(accessUnit->data(), mBuffer->data(), info.mLength);
         accessUnit->meta()->setInt64("timeUs", info.mTimestampUs);
 
-        memmove(mBuffer->data(),
-                mBuffer->data() + info.mLength,
-                mBuffer->size() - info.mLength);
-
-        mBuffer->setRange(0, mBuffer->size() - info.mLength);
+        mBuffer->setRange(mBuffer->offset() + info.mLength, mBuffer->size() - info.mLength);
 
         if (mFormat == NULL) {
             mFormat = new MetaData;
@@ -2072,11 +2076,13 @@ sp<ABuffer> ElementaryStreamQueue::dequeueAccessUnitH264() {
             const NALPosition &pos = nals.itemAt(nals.size() - 1);
             size_t nextScan = pos.nalOffset + pos.nalSize;
 
-            memmove(mBuffer->data(),
-                    mBuffer->data() + nextScan,
-                    mBuffer->size() - nextScan);
-
-            mBuffer->setRange(0, mBuffer->size() - nextScan);
+            // Drop the access unit from the front of the buffer. The rest of the data is
+            // moved back by appendData() only when it runs out of space at the end.
+            if (nextScan < mBuffer->size()) {
+                mBuffer->setRange(mBuffer->offset() + nextScan, mBuffer->size() - nextScan);
+            } else {
+                mBuffer->setRange(0, 0);
+            }
 
             int64_t timeUs = fetchTimestamp(nextScan);
             if (timeUs < 0LL) {
@@ -263,43 +263,40 @@ void HlsSampleDecryptor::processAC3(uint8_t *data, size_t size) {
 
 // Unescapes data replacing occurrences of [0, 0, 3] with [0, 0] and returns the new size
 size_t HlsSampleDecryptor::unescapeStream(uint8_t *data, size_t limit) const {
-    Vector<size_t> scratchEscapePositions;
-    size_t position = 0;
-
-    while (position < limit) {
-        position = findNextUnescapeIndex(data, position, limit);
-        if (position < limit) {
-            scratchEscapePositions.add(position);
-            position += 3;
-        }
-    }
-
-    size_t scratchEscapeCount = scratchEscapePositions.size();
+    // Single in-place pass: everything before the next escape sequence is moved down
+    // to the write position, which never overtakes the read position.
     size_t escapedPosition = 0; // The position being read from.
     size_t unescapedPosition = 0; // The position being written to.
-    for (size_t i = 0; i < scratchEscapeCount; i++) {
-        size_t nextEscapePosition = scratchEscapePositions[i];
-        //TODO: add 2 and get rid of the later = 0 assignments
+
+    while (escapedPosition < limit) {
+        size_t nextEscapePosition = findNextUnescapeIndex(data, escapedPosition, limit);
         size_t copyLength = nextEscapePosition - escapedPosition;
-        memmove(data+unescapedPosition, data+escapedPosition, copyLength);
+        if (unescapedPosition != escapedPosition) {
+            memmove(data + unescapedPosition, data + escapedPosition, copyLength);
+        }
         unescapedPosition += copyLength;
-        data[unescapedPosition++] = 0;
-        data[unescapedPosition++] = 0;
-        escapedPosition += copyLength + 3;
-    }
+        escapedPosition = nextEscapePosition;
 
-    size_t unescapedLength = limit - scratchEscapeCount;
-    size_t remainingLength = unescapedLength - unescapedPosition;
-    memmove(data+unescapedPosition, data+escapedPosition, remainingLength);
+        if (nextEscapePosition < limit) {
+            data[unescapedPosition++] = 0;
+            data[unescapedPosition++] = 0;
+            escapedPosition += 3;
+        }
+    }
 
-    return unescapedLength;
+    return unescapedPosition;
 }
 
 size_t HlsSampleDecryptor::findNextUnescapeIndex(uint8_t *data, size_t offset, size_t limit) const {
-    for (size_t i = offset; i < limit - 2; i++) {
-        //TODO: speed
-        if (data[i] == 0x00 && data[i + 1] == 0x00 && data[i + 2] == 0x03) {
+    size_t i = offset;
+    while (i + 2 < limit) {
+        if (data[i + 2] > 0x03) {
+            // No escape sequence can start at i, i + 1 or i + 2.
+            i += 3;
+        } else if (data[i + 2] == 0x03 && data[i] == 0x00 && data[i + 1] == 0x00) {
             return i;
+        } else {
+            i++;
         }
     }
     return limit;
@@ -122,6 +122,11 @@ struct ATSParser : public RefBase {
     status_t feedTSPacket(
             const void *data, size_t size, SyncEvent *event = NULL);
 
+    // Feed the consecutive TS packets of a buffer into the parser, stopping at the first
+    // packet that fails to parse. |size| need not be a whole number of packets. The number
+    // of bytes of the packets parsed is returned in |consumed|.
+    status_t feedTSPackets(const void *data, size_t size, size_t *consumed);
+
     void signalDiscontinuity(
             DiscontinuityType type, const sp<AMessage> &extra);
 
@@ -215,6 +220,14 @@ private:
     // Keyed by PID
     KeyedVector<unsigned, sp<PSISection> > mPSISections;
 
+    // Index in mPrograms of the program with a stream on each PID, or -1. Rebuilt when a
+    // PSI section may have changed the programs or their streams.
+    static const size_t kNumPIDs = 8192;
+    int32_t mPIDToProgram[kNumPIDs];
+    bool mPIDToProgramValid;
+
+    void updatePIDToProgram();
+
     int64_t mAbsoluteTimeAnchorUs;
 
     bool mTimeOffsetValid;
@@ -216,6 +216,33 @@ TEST_P(Mpeg2tsUnitTest, MediaInfoTest) {
     }
 }
 
+TEST_P(Mpeg2tsUnitTest, BatchFeedTest) {
+    // feed chunks that do not end on packet boundaries
+    constexpr size_t kChunkSize = 64 * kTSPacketSize + 100;
+    uint8_t chunk[kChunkSize];
+    size_t pending = 0;
+    ssize_t numBytesRead = -1;
+
+    while ((numBytesRead = mSource->readAt(mOffset, chunk + pending, kChunkSize - pending)) > 0) {
+        mOffset += numBytesRead;
+        size_t size = pending + numBytesRead;
+        size_t consumed = 0;
+        status_t err = mParser->feedTSPackets(chunk, size, &consumed);
+        ASSERT_EQ(err, (status_t)OK) << "Unable to feed TS packets!";
+        ASSERT_EQ(consumed, size - size % kTSPacketSize) << "Not all TS packets were parsed";
+
+        pending = size - consumed;
+        memmove(chunk, chunk + consumed, pending);
+    }
+
+    ASSERT_EQ(mParser->hasSource(ATSParser::VIDEO), bool(mMediaType & kVideoPresent))
+            << "No Video packets found!";
+    ASSERT_EQ(mParser->hasSource(ATSParser::AUDIO), bool(mMediaType & kAudioPresent))
+            << "No Audio packets found!";
+    ASSERT_EQ(mParser->hasSource(ATSParser::META), bool(mMediaType & kMetaDataPresent))
+            << "No meta data found!";
+}
+
 INSTANTIATE_TEST_SUITE_P(
         infoTest, Mpeg2tsUnitTest,
         ::testing::Values(make_tuple("crowd_1920x1080_25fps_6700kbps_h264.ts", 0x01, 1),
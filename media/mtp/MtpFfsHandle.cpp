@@ -113,13 +113,18 @@ bool MtpFfsHandle::openEndpoints(bool ptp) {
 }
 
 void MtpFfsHandle::advise(int fd) {
+    // The advice values are not bit flags, so each one needs its own call.
     for (unsigned i = 0; i < NUM_IO_BUFS; i++) {
         if (posix_madvise(mIobuf[i].bufs.data(), MAX_FILE_CHUNK_SIZE,
-                POSIX_MADV_SEQUENTIAL | POSIX_MADV_WILLNEED) != 0)
+                POSIX_MADV_SEQUENTIAL) != 0 ||
+            posix_madvise(mIobuf[i].bufs.data(), MAX_FILE_CHUNK_SIZE,
+                POSIX_MADV_WILLNEED) != 0)
             PLOG(ERROR) << "Failed to madvise";
     }
-    if (posix_fadvise(fd, 0, 0,
-                POSIX_FADV_SEQUENTIAL | POSIX_FADV_NOREUSE | POSIX_FADV_WILLNEED) != 0)
+    // Sequential access doubles the readahead window for file reads. The whole
+    // file isn't prefetched with WILLNEED, as it could be larger than the page cache.
+    if (posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL) != 0 ||
+        posix_fadvise(fd, 0, 0, POSIX_FADV_NOREUSE) != 0)
         PLOG(ERROR) << "Failed to fadvise";
 }
 
@@ -90,10 +90,12 @@ void BenchmarkC2Common::waitOnInputConsumption() {
 
 void BenchmarkC2Common::handleWorkDone(std::list<std::unique_ptr<C2Work>> &workItems) {
     ALOGV("In %s", __func__);
+    nsecs_t sTime = mStats->getCurTime();
     mStats->addOutputTime();
     for (std::unique_ptr<C2Work> &work : workItems) {
         if (!work->worklets.empty()) {
             if (work->worklets.front()->output.flags != C2FrameData::FLAG_INCOMPLETE) {
+                mStats->addWorkDone(work->input.ordinal.frameIndex.peeku());
                 mEos = (work->worklets.front()->output.flags & C2FrameData::FLAG_END_OF_STREAM) !=
                        0;
                 ALOGV("WorkDone: frameID received %d , mEos : %d",
@@ -109,5 +111,6 @@ void BenchmarkC2Common::handleWorkDone(std::list<std::unique_ptr<C2Work>> &workI
             }
         }
     }
+    mStats->addCallbackTime(mStats->getTimeDiff(sTime, mStats->getCurTime()));
 }
 
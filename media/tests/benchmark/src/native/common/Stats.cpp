@@ -21,6 +21,7 @@
 #include <iostream>
 #include <stdint.h>
 #include <fstream>
+#include <sys/resource.h>
 
 #include "Stats.h"
 
@@ -93,6 +94,95 @@ void Stats::dumpStatistics(const string& operation, const string& inputReference
     out.close();
 }
 
+/**
+ * Appends the stats of the operation for a given input media to a file, as one JSON object per
+ * line. All benchmarks write the same fields, so that results can be compared across
+ * operations and over time; bump kJsonSchemaVersion when fields change meaning.
+ *
+ * Output intervals are the times between consecutive outputs, starting from the start of the
+ * operation. Work latencies are only reported by the Codec2 benchmarks, and are measured from
+ * Component::queue() to onWorkDone(), including the time spent in the component's process().
+ * CPU time and memory are those of this (client) process.
+ *
+ * \param operation      describes the operation performed on the input media
+ *                       (i.e. decode/encode/c2decode/c2encode)
+ * \param inputReference input media
+ * \param durationUs     is a duration of the input media in microseconds.
+ * \param componentName  describes the codecName.
+ * \param jsonFile       the file where the stats data is to be appended.
+ * \param mode           the operating mode: sync/async.
+ */
+void Stats::dumpJson(const string& operation, const string& inputReference, int64_t durationUs,
+                     const string& componentName, const string& jsonFile, const string& mode) {
+    ALOGV("In %s", __func__);
+    constexpr int32_t kJsonSchemaVersion = 2;
+    std::vector<nsecs_t> latencies;
+    nsecs_t callbackTimeNs;
+    {
+        std::lock_guard<std::mutex> lock(mWorkLock);
+        latencies = mWorkLatencyNs;
+        callbackTimeNs = mCallbackTimeNs;
+    }
+    if (mOutputTimer.empty() && latencies.empty()) {
+        ALOGE("No output produced");
+        return;
+    }
+    std::vector<nsecs_t> intervals;
+    intervals.reserve(mOutputTimer.size());
+    nsecs_t prevTimeNs = mStartTimeNs;
+    for (nsecs_t outputTimeNs : mOutputTimer) {
+        intervals.push_back(outputTimeNs - prevTimeNs);
+        prevTimeNs = outputTimeNs;
+    }
+    auto summary = [](std::vector<nsecs_t>& values) {
+        if (values.empty()) return string("null");
+        std::sort(values.begin(), values.end());
+        auto percentile = [&values](int32_t p) {
+            size_t idx = (values.size() * p + 99) / 100;
+            return values[idx > 0 ? idx - 1 : 0];
+        };
+        return "{\"min\": " + to_string(values.front()) +
+               ", \"p50\": " + to_string(percentile(50)) +
+               ", \"p90\": " + to_string(percentile(90)) +
+               ", \"p99\": " + to_string(percentile(99)) +
+               ", \"max\": " + to_string(values.back()) + "}";
+    };
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    const int64_t cpuTimeUs = (int64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+                              usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    const int64_t bytes = std::accumulate(mFrameSizes.begin(), mFrameSizes.end(), (int64_t)0);
+
+    string rowData = "{";
+    rowData.append("\"schemaVersion\": " + to_string(kJsonSchemaVersion) + ", ");
+    rowData.append("\"operation\": \"" + operation + "\", ");
+    rowData.append("\"input\": \"" + inputReference + "\", ");
+    rowData.append("\"component\": \"" + componentName + "\", ");
+    rowData.append("\"mode\": \"" + mode + "\", ");
+    rowData.append("\"durationUs\": " + to_string(durationUs) + ", ");
+    rowData.append("\"initTimeNs\": " + to_string(mInitTimeNs) + ", ");
+    rowData.append("\"deInitTimeNs\": " + to_string(mDeInitTimeNs) + ", ");
+    rowData.append("\"totalTimeNs\": " + to_string(getTotalTime()) + ", ");
+    rowData.append("\"outputs\": " + to_string(mOutputTimer.size()) + ", ");
+    rowData.append("\"bytes\": " + to_string(bytes) + ", ");
+    rowData.append("\"outputIntervalNs\": " + summary(intervals) + ", ");
+    rowData.append("\"works\": " + to_string(latencies.size()) + ", ");
+    rowData.append("\"workLatencyNs\": " + summary(latencies) + ", ");
+    rowData.append("\"fetchTimeNs\": " + to_string(mFetchTimeNs) + ", ");
+    rowData.append("\"queueTimeNs\": " + to_string(mQueueTimeNs) + ", ");
+    rowData.append("\"callbackTimeNs\": " + to_string(callbackTimeNs) + ", ");
+    rowData.append("\"cpuTimeUs\": " + to_string(cpuTimeUs) + ", ");
+    rowData.append("\"maxRssKb\": " + to_string(usage.ru_maxrss) + "}\n");
+
+    ofstream out(jsonFile, ios::out | ios::app);
+    if (out.bad()) {
+        ALOGE("Failed to open json stats file for writing!");
+        return;
+    }
+    out << rowData;
+    out.close();
+}
+
 /**
  * Dumps the stats of the operation for a given input media to a listener.
  *
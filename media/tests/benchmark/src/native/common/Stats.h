@@ -41,6 +41,8 @@
 
 #include <sys/time.h>
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <vector>
 
@@ -68,6 +70,14 @@ class Stats {
     std::vector<nsecs_t> mInputTimer;
     std::vector<nsecs_t> mOutputTimer;
 
+    // Codec2 per-work timings. Works are queued and returned on different threads.
+    std::mutex mWorkLock;
+    std::map<uint64_t, nsecs_t> mWorkQueueTimeNs;  // frame index => time queued
+    std::vector<nsecs_t> mWorkLatencyNs;
+    nsecs_t mFetchTimeNs = 0;     // fetching and filling input blocks
+    nsecs_t mQueueTimeNs = 0;     // in Component::queue()
+    nsecs_t mCallbackTimeNs = 0;  // in the onWorkDone() listener
+
   public:
     nsecs_t getCurTime() { return systemTime(CLOCK_MONOTONIC); }
 
@@ -83,10 +93,40 @@ class Stats {
 
     void addOutputTime() { mOutputTimer.push_back(systemTime(CLOCK_MONOTONIC)); }
 
+    void addWorkQueued(uint64_t frameIndex) {
+        std::lock_guard<std::mutex> lock(mWorkLock);
+        mWorkQueueTimeNs[frameIndex] = systemTime(CLOCK_MONOTONIC);
+    }
+
+    void addWorkDone(uint64_t frameIndex) {
+        nsecs_t now = systemTime(CLOCK_MONOTONIC);
+        std::lock_guard<std::mutex> lock(mWorkLock);
+        auto it = mWorkQueueTimeNs.find(frameIndex);
+        if (it != mWorkQueueTimeNs.end()) {
+            mWorkLatencyNs.push_back(now - it->second);
+            mWorkQueueTimeNs.erase(it);
+        }
+    }
+
+    void addFetchTime(nsecs_t timeNs) { mFetchTimeNs += timeNs; }
+
+    void addQueueTime(nsecs_t timeNs) { mQueueTimeNs += timeNs; }
+
+    void addCallbackTime(nsecs_t timeNs) {
+        std::lock_guard<std::mutex> lock(mWorkLock);
+        mCallbackTimeNs += timeNs;
+    }
+
     void reset() {
         if (!mFrameSizes.empty()) mFrameSizes.clear();
         if (!mInputTimer.empty()) mInputTimer.clear();
         if (!mOutputTimer.empty()) mOutputTimer.clear();
+        std::lock_guard<std::mutex> lock(mWorkLock);
+        mWorkQueueTimeNs.clear();
+        mWorkLatencyNs.clear();
+        mFetchTimeNs = 0;
+        mQueueTimeNs = 0;
+        mCallbackTimeNs = 0;
     }
 
     std::vector<nsecs_t> getOutputTimer() { return mOutputTimer; }
@@ -106,6 +146,10 @@ class Stats {
                         int64_t duarationUs, const string& componentName = "",
                         const string& mode = "", const string& statsFile = "");
 
+    void dumpJson(const string& operation, const string& inputReference, int64_t durationUs,
+                  const string& componentName, const string& jsonFile,
+                  const string& mode = "");
+
     void uploadMetrics(const string& operation, const string& inputReference,
                       const int64_t& durationUs, const string& componentName = "",
                       const string& mode = "");
@@ -107,6 +107,7 @@ int32_t C2Decoder::decodeFrames(uint8_t *inputBuffer, vector<AMediaCodecBufferIn
         work->input.buffers.clear();
         int size = frameInfo[mNumInputFrame].size;
         int alignedSize = ALIGN(size, PAGE_SIZE);
+        int64_t sTime = mStats->getCurTime();
         if (size) {
             std::shared_ptr<C2LinearBlock> block;
             status = mLinearPool->fetchLinearBlock(
@@ -127,11 +128,15 @@ int32_t C2Decoder::decodeFrames(uint8_t *inputBuffer, vector<AMediaCodecBufferIn
         }
         work->worklets.clear();
         work->worklets.emplace_back(new C2Worklet);
+        int64_t eTime = mStats->getCurTime();
+        mStats->addFetchTime(mStats->getTimeDiff(sTime, eTime));
 
         std::list<std::unique_ptr<C2Work>> items;
         items.push_back(std::move(work));
+        mStats->addWorkQueued(mNumInputFrame);
         // queue() invokes process() function of C2 Plugin.
         status = mComponent->queue(&items);
+        mStats->addQueueTime(mStats->getTimeDiff(eTime, mStats->getCurTime()));
         if (status != C2_OK) {
             ALOGE("queue failed");
             return status;
@@ -163,6 +168,11 @@ void C2Decoder::dumpStatistics(string inputReference, int64_t durationUs, string
     mStats->dumpStatistics(operation, inputReference, durationUs, componentName, mode, statsFile);
 }
 
+void C2Decoder::dumpJson(string inputReference, int64_t durationUs, string componentName,
+                         string jsonFile) {
+    mStats->dumpJson("c2decode", inputReference, durationUs, componentName, jsonFile, "async");
+}
+
 void C2Decoder::resetDecoder() {
     mOffset = 0;
     mNumInputFrame = 0;
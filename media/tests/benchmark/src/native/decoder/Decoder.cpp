@@ -250,6 +250,12 @@ void Decoder::dumpStatistics(string inputReference, string componentName, string
     mStats->dumpStatistics(operation, inputReference, durationUs, componentName, mode, statsFile);
 }
 
+void Decoder::dumpJson(string inputReference, string componentName, string mode,
+                       string jsonFile) {
+    int64_t durationUs = mExtractor->getClipDuration();
+    mStats->dumpJson("decode", inputReference, durationUs, componentName, jsonFile, mode);
+}
+
 void Decoder::resetDecoder() {
     if (mStats) mStats->reset();
     if (mInputBuffer) mInputBuffer = nullptr;
@@ -76,6 +76,8 @@ class Decoder : public CallBackHandle {
     void dumpStatistics(string inputReference, string componentName = "", string mode = "",
                         string statsFile = "");
 
+    void dumpJson(string inputReference, string componentName, string mode, string jsonFile);
+
   private:
     AMediaCodec *mCodec;
     AMediaFormat *mFormat;
@@ -178,6 +178,7 @@ int32_t C2Encoder::encodeFrames(ifstream &eleStream, size_t inputBufferSize) {
         }
         offset += frameSize;
 
+        int64_t sTime = mStats->getCurTime();
         if (frameSize) {
             if (mIsAudioEncoder) {
                 std::shared_ptr<C2LinearBlock> block;
@@ -223,11 +224,15 @@ int32_t C2Encoder::encodeFrames(ifstream &eleStream, size_t inputBufferSize) {
 
         work->worklets.clear();
         work->worklets.emplace_back(new (std::nothrow) C2Worklet);
+        int64_t eTime = mStats->getCurTime();
+        mStats->addFetchTime(mStats->getTimeDiff(sTime, eTime));
 
         std::list<std::unique_ptr<C2Work>> items;
         items.push_back(std::move(work));
+        mStats->addWorkQueued(mNumInputFrame);
         // queue() invokes process() function of C2 Plugin.
         status = mComponent->queue(&items);
+        mStats->addQueueTime(mStats->getTimeDiff(eTime, mStats->getCurTime()));
         if (status != C2_OK) {
             ALOGE("queue failed");
             return status;
@@ -259,6 +264,11 @@ void C2Encoder::dumpStatistics(string inputReference, int64_t durationUs, string
     mStats->dumpStatistics(operation, inputReference, durationUs, componentName, mode, statsFile);
 }
 
+void C2Encoder::dumpJson(string inputReference, int64_t durationUs, string componentName,
+                         string jsonFile) {
+    mStats->dumpJson("c2encode", inputReference, durationUs, componentName, jsonFile, "async");
+}
+
 void C2Encoder::resetEncoder() {
     mIsAudioEncoder = false;
     mNumInputFrame = 0;
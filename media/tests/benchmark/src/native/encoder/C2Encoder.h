@@ -47,6 +47,10 @@ class C2Encoder : public BenchmarkC2Common {
     void dumpStatistics(string inputReference, int64_t durationUs, string componentName,
                         string statsFile);
 
+    // Appends per-work latency percentiles and per-stage timings as a JSON line to jsonFile.
+    void dumpJson(string inputReference, int64_t durationUs, string componentName,
+                  string jsonFile);
+
     void resetEncoder();
 
   private:
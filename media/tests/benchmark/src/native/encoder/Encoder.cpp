@@ -188,6 +188,11 @@ void Encoder::dumpStatistics(string inputReference, int64_t durationUs, string c
     mStats->dumpStatistics(operation, inputReference, durationUs, componentName, mode, statsFile);
 }
 
+void Encoder::dumpJson(string inputReference, int64_t durationUs, string componentName,
+                       string mode, string jsonFile) {
+    mStats->dumpJson("encode", inputReference, durationUs, componentName, jsonFile, mode);
+}
+
 int32_t Encoder::encode(string &codecName, ifstream &eleStream, size_t eleSize, bool asyncMode,
                         encParameter encParams, char *mime) {
     ALOGV("In %s", __func__);
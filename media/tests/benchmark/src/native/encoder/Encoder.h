@@ -83,6 +83,9 @@ class Encoder : public CallBackHandle {
     void dumpStatistics(string inputReference, int64_t durationUs, string codecName = "",
                         string mode = "", string statsFile = "");
 
+    void dumpJson(string inputReference, int64_t durationUs, string codecName, string mode,
+                  string jsonFile);
+
   private:
     AMediaCodec *mCodec;
     AMediaFormat *mFormat;
@@ -40,11 +40,16 @@ class BenchmarkTestEnvironment : public ::testing::Environment {
 
     const string getStatsFile() const { return statsFile; }
 
+    void setJsonStatsFile(const string module) { jsonStatsFile = getRes() + module; }
+
+    const string getJsonStatsFile() const { return jsonStatsFile; }
+
     bool writeStatsHeader();
 
   private:
     string res;
     string statsFile;
+    string jsonStatsFile;
 };
 
 int BenchmarkTestEnvironment::initFromOptions(int argc, char **argv) {
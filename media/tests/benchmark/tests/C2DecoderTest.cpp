@@ -139,6 +139,8 @@ TEST_P(C2DecoderTest, Codec2Decode) {
                 ALOGV("codec : %s", codecName.c_str());
                 mDecoder->dumpStatistics(GetParam().first, durationUs, codecName,
                                          gEnv->getStatsFile());
+                mDecoder->dumpJson(GetParam().first, durationUs, codecName,
+                                   gEnv->getJsonStatsFile());
                 mDecoder->resetDecoder();
             }
         }
@@ -179,6 +181,7 @@ int main(int argc, char **argv) {
     int status = gEnv->initFromOptions(argc, argv);
     if (status == 0) {
         gEnv->setStatsFile("C2Decoder.csv");
+        gEnv->setJsonStatsFile("C2Decoder.json");
         status = gEnv->writeStatsHeader();
         ALOGV("Stats file = %d\n", status);
         status = RUN_ALL_TESTS();
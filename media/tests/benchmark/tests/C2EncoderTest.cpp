@@ -144,6 +144,8 @@ TEST_P(C2EncoderTest, Codec2Encode) {
                 ALOGV("codec : %s", codecName.c_str());
                 mEncoder->dumpStatistics(GetParam().first, durationUs, codecName,
                                          gEnv->getStatsFile());
+                mEncoder->dumpJson(GetParam().first, durationUs, codecName,
+                                   gEnv->getJsonStatsFile());
                 mEncoder->resetEncoder();
             }
         }
@@ -182,6 +184,7 @@ int main(int argc, char **argv) {
     int status = gEnv->initFromOptions(argc, argv);
     if (status == 0) {
         gEnv->setStatsFile("C2Encoder.csv");
+        gEnv->setJsonStatsFile("C2Encoder.json");
         status = gEnv->writeStatsHeader();
         ALOGV("Stats file = %d\n", status);
         status = RUN_ALL_TESTS();
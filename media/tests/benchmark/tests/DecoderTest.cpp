@@ -89,6 +89,8 @@ TEST_P(DecoderTest, Decode) {
         string inputReference = get<0>(params);
         decoder->dumpStatistics(inputReference, codecName, (asyncMode ? "async" : "sync"),
                                 gEnv->getStatsFile());
+        decoder->dumpJson(inputReference, codecName, (asyncMode ? "async" : "sync"),
+                          gEnv->getJsonStatsFile());
         decoder->resetDecoder();
     }
     fclose(inputFp);
@@ -183,6 +185,7 @@ int main(int argc, char **argv) {
     int status = gEnv->initFromOptions(argc, argv);
     if (status == 0) {
         gEnv->setStatsFile("Decoder.csv");
+        gEnv->setJsonStatsFile("Decoder.json");
         status = gEnv->writeStatsHeader();
         ALOGV("Stats file = %d\n", status);
         status = RUN_ALL_TESTS();
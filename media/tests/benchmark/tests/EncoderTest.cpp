@@ -142,6 +142,8 @@ TEST_P(EncoderTest, Encode) {
         string inputReference = get<0>(params);
         encoder->dumpStatistics(inputReference, extractor->getClipDuration(), codecName,
                                 (asyncMode ? "async" : "sync"), gEnv->getStatsFile());
+        encoder->dumpJson(inputReference, extractor->getClipDuration(), codecName,
+                          (asyncMode ? "async" : "sync"), gEnv->getJsonStatsFile());
         eleStream.close();
         if (outFp) fclose(outFp);
 
@@ -224,6 +226,7 @@ int main(int argc, char **argv) {
     int status = gEnv->initFromOptions(argc, argv);
     if (status == 0) {
         gEnv->setStatsFile("Encoder.csv");
+        gEnv->setJsonStatsFile("Encoder.json");
         status = gEnv->writeStatsHeader();
         ALOGV("Stats file = %d\n", status);
         status = RUN_ALL_TESTS();
@@ -226,8 +226,9 @@ std::string TimerThread::Request::toString() const {
 }
 
 void TimerThread::RequestQueue::add(std::shared_ptr<const Request> request) {
+    const auto now = std::chrono::system_clock::now();
     std::lock_guard lg(mRQMutex);
-    mRequestQueue.emplace_back(std::chrono::system_clock::now(), std::move(request));
+    mRequestQueue.emplace_back(now, std::move(request));
     if (mRequestQueue.size() > mRequestQueueMax) {
         mRequestQueue.pop_front();
     }
@@ -373,9 +374,15 @@ TimerThread::Handle TimerThread::MonitorThread::add(
         std::shared_ptr<const Request> request, TimerCallback&& func, Duration timeout) {
     std::lock_guard _l(mMutex);
     const Handle handle = getUniqueHandle_l(timeout);
-    mMonitorRequests.emplace_hint(mMonitorRequests.end(),
+    const auto it = mMonitorRequests.emplace_hint(mMonitorRequests.end(),
             handle, std::make_pair(std::move(request), std::move(func)));
-    mCond.notify_all();
+    // The monitor thread already waits for a deadline no later than the earliest
+    // request, so it only needs waking if this request is now the earliest.
+    // Requests generally share the same timeout and are appended at the end,
+    // so most adds do not wake the monitor thread.
+    if (it == mMonitorRequests.begin()) {
+        mCond.notify_all();
+    }
     return handle;
 }
 
@@ -20,8 +20,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <cstring>
 #include <iomanip>
 #include <limits>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -418,6 +420,143 @@ class FallbackAllocator {
     [[no_unique_address]] SecondaryAllocator mSecondary;
 };
 
+// An allocator which recycles deallocated blocks for later requests of the same size class.
+// This avoids creating and mapping a new block for each of a series of short lived
+// allocations of similar size, e.g. the tracks of a client repeatedly playing short sounds.
+//
+// Requests are rounded up to a size class: exact multiples of the alignment up to 4 blocks of
+// alignment, and then 4 classes per power of 2, so a block is at most 25% larger than requested.
+// Deallocated blocks are kept, zero filled on reuse, up to MaxCachedSize in total and
+// MaxCachedPerClass per size class. They remain allocated from the underlying allocator,
+// so if it fails a request, the cached blocks are released and the request is retried.
+template <typename Allocator, size_t MaxCachedSize, size_t MaxCachedPerClass = 4>
+class SizeClassPoolAllocator {
+  public:
+    struct Stats {
+        size_t hits = 0;           // requests served by a cached block
+        size_t misses = 0;         // requests passed to the underlying allocator
+        size_t flushes = 0;        // cached blocks released to satisfy a request
+        size_t cachedBlocks = 0;
+        size_t cachedSize = 0;
+        size_t allocatedSize = 0;  // of outstanding allocations
+        size_t requestedSize = 0;  // of outstanding allocations, before size class rounding
+    };
+
+    static constexpr size_t alignment() { return Allocator::alignment(); }
+
+    explicit SizeClassPoolAllocator(Allocator allocator) : mAllocator(std::move(allocator)) {}
+
+    // Default construct the underlying allocator
+    SizeClassPoolAllocator() = default;
+
+    ~SizeClassPoolAllocator() { releaseCached(); }
+
+    // Returns the size class of an alignment rounded size.
+    static constexpr size_t sizeClass(size_t size) {
+        if (size <= 4 * alignment()) return size;
+        size_t step = 1;
+        while (step <= size / 8) step <<= 1;  // step is 2^(floor(log2(size)) - 2)
+        return shared_allocator_impl::roundup(size, step);
+    }
+
+    template <typename T>
+    AllocationType allocate(T&& request) {
+        static_assert(std::is_base_of_v<BasicAllocRequest, std::decay_t<T>>);
+        const size_t requestedSize = request.size;
+        request.size = sizeClass(shared_allocator_impl::roundup(request.size, alignment()));
+        AllocationType allocation;
+        if (const auto it = mCached.find(request.size); it != mCached.end()) {
+            allocation = it->second;
+            mCached.erase(it);
+            mStats.cachedSize -= allocation->size();
+            --mStats.cachedBlocks;
+            ++mStats.hits;
+            memset(allocation->unsecurePointer(), 0, allocation->size());
+        } else {
+            ++mStats.misses;
+            allocation = mAllocator.allocate(request);
+            if (!allocation && !mCached.empty()) {
+                releaseCached();
+                ++mStats.flushes;
+                allocation = mAllocator.allocate(request);
+            }
+            if (!allocation) return {};
+        }
+        mOutstanding.insert({WeakAllocationType{allocation}, requestedSize});
+        mStats.allocatedSize += allocation->size();
+        mStats.requestedSize += requestedSize;
+        return allocation;
+    }
+
+    void deallocate(const AllocationType& allocation) {
+        if (!allocation) return;
+        const size_t size = allocation->size();
+        if (const auto it = mOutstanding.find(WeakAllocationType{allocation});
+                it != mOutstanding.end()) {
+            mStats.allocatedSize -= size;
+            mStats.requestedSize -= it->second;
+            mOutstanding.erase(it);
+        }
+        if (sizeClass(size) == size && mStats.cachedSize + size <= MaxCachedSize &&
+                mCached.count(size) < MaxCachedPerClass) {
+            mCached.insert({size, allocation});
+            mStats.cachedSize += size;
+            ++mStats.cachedBlocks;
+            return;
+        }
+        mAllocator.deallocate(allocation);
+    }
+
+    template <typename Enable = void>
+    auto deallocate_all()
+            -> std::enable_if_t<shared_allocator_impl::has_deallocate_all<Allocator>, Enable> {
+        mCached.clear();
+        mOutstanding.clear();
+        mAllocator.deallocate_all();
+        mStats.cachedBlocks = mStats.cachedSize = 0;
+        mStats.allocatedSize = mStats.requestedSize = 0;
+    }
+
+    template <typename Enable = bool>
+    auto owns(const AllocationType& allocation) const
+            -> std::enable_if_t<shared_allocator_impl::has_owns<Allocator>, Enable> {
+        return mOutstanding.count(WeakAllocationType{allocation}) > 0 &&
+               mAllocator.owns(allocation);
+    }
+
+    std::string dump() const {
+        std::ostringstream dump;
+        const size_t requests = mStats.hits + mStats.misses;
+        dump << "Size Class Pool: hits " << mStats.hits << " misses " << mStats.misses
+             << " hit rate " << std::fixed << std::setprecision(1)
+             << (requests > 0 ? mStats.hits * 100. / requests : 0.) << "% flushes "
+             << mStats.flushes << "\n  cached " << mStats.cachedBlocks << " blocks "
+             << mStats.cachedSize << " bytes, outstanding " << mStats.allocatedSize
+             << " bytes for " << mStats.requestedSize << " requested\n";
+        if constexpr (shared_allocator_impl::has_dump<Allocator>) {
+            // cached blocks are listed as allocated by the underlying allocator
+            dump << mAllocator.dump();
+        }
+        return dump.str();
+    }
+
+    Stats getStats() const { return mStats; }
+
+  private:
+    void releaseCached() {
+        for (const auto& [size, allocation] : mCached) {
+            mAllocator.deallocate(allocation);
+        }
+        mCached.clear();
+        mStats.cachedBlocks = mStats.cachedSize = 0;
+    }
+
+    [[no_unique_address]] Allocator mAllocator;
+    std::multimap<size_t, AllocationType> mCached;  // by block size
+    std::unordered_map<WeakAllocationType, size_t> mOutstanding;  // to requested size
+    Stats mStats;
+};
+
 // An allocator which is backed by a shared_ptr to an allocator, so multiple
 // allocators can share the same backing allocator (and thus the same state).
 template <typename Allocator>
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <cutils/trace.h>
+
+namespace android::mediautils {
+
+/**
+ * Async trace slices that follow a buffer through the stages of a media pipeline.
+ *
+ * A stage begins a slice when it takes a buffer and ends it when it hands the buffer
+ * on, using an id that all stages can derive for the same buffer, usually its
+ * presentation timestamp. Each stage shows up as its own async track named |name|,
+ * and slices with the same id line up across tracks, threads, and processes, so that
+ * a frame can be followed from e.g. the extractor through the decoder to render.
+ *
+ * |name| must be the same string for the begin and end of a slice. When the tag is
+ * not being traced, each call costs a single atrace_is_tag_enabled() check.
+ */
+
+// Folds a 64-bit flow id, such as a timestamp in us, into the 32-bit atrace cookie.
+inline int32_t traceFlowCookie(int64_t flowId) {
+    return static_cast<int32_t>(flowId ^ (flowId >> 32));
+}
+
+inline void traceFlowBegin(uint64_t tag, const char* name, int64_t flowId) {
+    atrace_async_begin(tag, name, traceFlowCookie(flowId));
+}
+
+inline void traceFlowEnd(uint64_t tag, const char* name, int64_t flowId) {
+    atrace_async_end(tag, name, traceFlowCookie(flowId));
+}
+
+} // namespace android::mediautils
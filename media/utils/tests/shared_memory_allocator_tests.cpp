@@ -348,3 +348,61 @@ TEST(shared_memory_allocator_tests, scoped_allocator) {
     ScopedAllocator<ValidateForwarding<0>> forwarding{};
     EXPECT_EQ(forwarding.dump(), ValidateForwarding<0>::dump_string);
 }
+
+TEST(shared_memory_allocator_tests, size_class_pool_allocator) {
+    using Pool = SizeClassPoolAllocator<MemoryHeapBaseAllocator, 4096 * 16, 2>;
+    static_assert(Pool::alignment() == MemoryHeapBaseAllocator::alignment());
+    static_assert(Pool::sizeClass(4096 * 3) == 4096 * 3);
+    static_assert(Pool::sizeClass(4096 * 5) == 4096 * 5);
+    static_assert(Pool::sizeClass(4096 * 9) == 4096 * 10);
+    static_assert(Pool::sizeClass(4096 * 17) == 4096 * 20);
+
+    Pool allocator;
+    const auto memory = allocator.allocate(BasicAllocRequest{4096 * 8 + 1});
+    validate_block(memory);
+    EXPECT_EQ(memory->size(), 4096ul * 10);
+    EXPECT_EQ(allocator.getStats().requestedSize, 4096ul * 8 + 1);
+    EXPECT_EQ(allocator.getStats().allocatedSize, 4096ul * 10);
+    allocator.deallocate(memory);
+    EXPECT_EQ(allocator.getStats().cachedBlocks, 1ul);
+    EXPECT_EQ(allocator.getStats().allocatedSize, 0ul);
+
+    // A request of the same size class reuses the block, zero filled
+    const auto memory2 = allocator.allocate(BasicAllocRequest{4096 * 10});
+    ASSERT_TRUE(memory2 != nullptr);
+    EXPECT_TRUE(memory2->getMemory() == memory->getMemory());
+    EXPECT_EQ(*(static_cast<char*>(memory2->unsecurePointer()) + 100), 0);
+    EXPECT_EQ(allocator.getStats().hits, 1ul);
+    EXPECT_EQ(allocator.getStats().misses, 1ul);
+    EXPECT_EQ(allocator.getStats().cachedBlocks, 0ul);
+
+    // A request of another size class does not
+    const auto memory3 = allocator.allocate(BasicAllocRequest{4096});
+    validate_block(memory3);
+    EXPECT_FALSE(memory3->getMemory() == memory->getMemory());
+    EXPECT_EQ(allocator.getStats().misses, 2ul);
+
+    // The pool is limited in size
+    const auto memory4 = allocator.allocate(BasicAllocRequest{4096 * 10});
+    const auto memory5 = allocator.allocate(BasicAllocRequest{4096 * 10});
+    allocator.deallocate(memory2);
+    allocator.deallocate(memory4);
+    allocator.deallocate(memory5);
+    EXPECT_EQ(allocator.getStats().cachedBlocks, 1ul);
+    EXPECT_EQ(allocator.getStats().cachedSize, 4096ul * 10);
+    EXPECT_TRUE(allocator.dump().find("hit rate") != std::string::npos);
+}
+
+TEST(shared_memory_allocator_tests, size_class_pool_allocator_flush) {
+    // Cached blocks are released when the underlying allocator is out of space
+    SizeClassPoolAllocator<PolicyAllocator<MemoryHeapBaseAllocator, SizePolicy<4096 * 4>>,
+                           4096 * 4> allocator;
+    const auto memory = allocator.allocate(BasicAllocRequest{4096 * 3});
+    validate_block(memory);
+    allocator.deallocate(memory);
+    EXPECT_EQ(allocator.getStats().cachedBlocks, 1ul);
+    const auto memory2 = allocator.allocate(BasicAllocRequest{4096 * 2});
+    validate_block(memory2);
+    EXPECT_EQ(allocator.getStats().flushes, 1ul);
+    EXPECT_EQ(allocator.getStats().cachedBlocks, 0ul);
+}
@@ -66,6 +66,8 @@ inline auto wrapWithPolicySnooping(Allocator allocator, std::string_view name) {
 constexpr inline size_t CLIENT_BOUND = 32;
 // Maximum amount of shared pools a single client can take (50%).
 constexpr inline size_t ADV_THRESHOLD_INV = 2;
+// Maximum amount of deallocated memory a client keeps for reuse by its next allocations.
+constexpr inline size_t CLIENT_POOL_SIZE = 1024 * 256;                        // 256 KiB
 
 inline auto getClientAllocator() {
     using namespace mediautils;
@@ -83,10 +85,15 @@ inline auto getClientAllocator() {
                 getSharedSmall(), "Small Shared");
     };
 
-    return ScopedAllocator{std::make_shared<
+    using ClientFallbackAllocator =
             FallbackAllocator<decltype(makeDedPool()),
-                              decltype(FallbackAllocator(makeLargeShared(), makeSmallShared()))>>(
-            makeDedPool(), FallbackAllocator{makeLargeShared(), makeSmallShared()})};
+                              decltype(FallbackAllocator(makeLargeShared(), makeSmallShared()))>;
+
+    return ScopedAllocator{
+            std::make_shared<SizeClassPoolAllocator<ClientFallbackAllocator, CLIENT_POOL_SIZE>>(
+                    ClientFallbackAllocator{makeDedPool(),
+                                            FallbackAllocator{makeLargeShared(),
+                                                              makeSmallShared()}})};
 }
 
 using ClientAllocator = decltype(getClientAllocator());
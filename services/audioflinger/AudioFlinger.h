@@ -96,9 +96,12 @@
 #include "AudioWatchdog.h"
 #include "AudioStreamOut.h"
 #include "SpdifStreamOut.h"
+#include "StateSnapshot.h"
+#include "SubmixThreadPool.h"
 #include "AudioHwDevice.h"
 #include "NBAIO_Tee.h"
 #include "ThreadMetrics.h"
+#include "ThreadStageTimes.h"
 #include "TrackMetrics.h"
 #include "AllocatorFactory.h"
 #include <android/os/IPowerManager.h>
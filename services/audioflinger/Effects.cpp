@@ -669,12 +669,30 @@ bool AudioFlinger::EffectModule::updateState() {
     return started;
 }
 
-void AudioFlinger::EffectModule::process()
+bool AudioFlinger::EffectModule::process(bool int16Input, bool keepInt16Output)
 {
     Mutex::Autolock _l(mLock);
 
+#ifdef FLOAT_EFFECT_CHAIN
+    if (int16Input && !isProcessInt16_l()) {
+        // the effect state changed since the chain checked it,
+        // restore the float output of the previous effect.
+        if (mInBuffer != 0 && mInConversionBuffer != 0) {
+            memcpy_to_float_from_i16(
+                    mInBuffer->audioBuffer()->f32,
+                    mInConversionBuffer->audioBuffer()->s16,
+                    mInChannelCountRequested * mConfig.inputCfg.buffer.frameCount);
+        }
+        int16Input = false;
+    }
+#else
+    (void)int16Input;
+    (void)keepInt16Output;
+#endif
+    bool int16OutputKept = false;
+
     if (mState == DESTROYED || mEffectInterface == 0 || mInBuffer == 0 || mOutBuffer == 0) {
-        return;
+        return int16OutputKept;
     }
 
     const uint32_t inChannelCount =
@@ -784,10 +802,12 @@ void AudioFlinger::EffectModule::process()
                         ALOGW("%s: mInConversionBuffer is null, bypassing", __func__);
                         goto data_bypass;
                     }
-                    memcpy_to_i16_from_float(
-                            mInConversionBuffer->audioBuffer()->s16,
-                            inBuffer->audioBuffer()->f32,
-                            inChannelCount * mConfig.inputCfg.buffer.frameCount);
+                    if (!int16Input) {
+                        memcpy_to_i16_from_float(
+                                mInConversionBuffer->audioBuffer()->s16,
+                                inBuffer->audioBuffer()->f32,
+                                inChannelCount * mConfig.inputCfg.buffer.frameCount);
+                    }
                     inBuffer = mInConversionBuffer;
                 }
                 if (mConfig.outputCfg.accessMode == EFFECT_BUFFER_ACCESS_ACCUMULATE) {
@@ -805,7 +825,10 @@ void AudioFlinger::EffectModule::process()
 #endif
             ret = mEffectInterface->process();
 #ifdef FLOAT_EFFECT_CHAIN
-            if (!mSupportsFloat) { // convert output int16_t back to float.
+            if (!mSupportsFloat && keepInt16Output && mInt16HandOff) {
+                // the next effect reads mOutConversionBuffer as its input.
+                int16OutputKept = true;
+            } else if (!mSupportsFloat) { // convert output int16_t back to float.
                 sp<EffectBufferHalInterface> target =
                         mOutChannelCountRequested != outChannelCount
                         ? mOutConversionBuffer : mOutBuffer;
@@ -867,6 +890,87 @@ void AudioFlinger::EffectModule::process()
             }
         }
     }
+    return int16OutputKept;
+}
+
+bool AudioFlinger::EffectModule::isProcessInt16()
+{
+    Mutex::Autolock _l(mLock);
+    return isProcessInt16_l();
+}
+
+bool AudioFlinger::EffectModule::isProcessInt16_l() const
+{
+#ifdef FLOAT_EFFECT_CHAIN
+    return mState != DESTROYED && mEffectInterface != 0 && mInBuffer != 0 && mOutBuffer != 0
+            && (mDescriptor.flags & EFFECT_FLAG_TYPE_MASK) != EFFECT_FLAG_TYPE_AUXILIARY
+            && !mSupportsFloat && mInConversionBuffer != 0
+            && isProcessEnabled() && isProcessImplemented();
+#else
+    return false;
+#endif
+}
+
+bool AudioFlinger::EffectModule::canHandOffInt16To(const sp<EffectModule>& next) const
+{
+#ifdef FLOAT_EFFECT_CHAIN
+    if (next == nullptr || mEffectInterface == 0
+            || (mDescriptor.flags & EFFECT_FLAG_TYPE_MASK) == EFFECT_FLAG_TYPE_AUXILIARY
+            || (next->mDescriptor.flags & EFFECT_FLAG_TYPE_MASK) == EFFECT_FLAG_TYPE_AUXILIARY
+            || mSupportsFloat || next->mSupportsFloat) {
+        return false;
+    }
+    // this effect must overwrite the buffer the next effect reads, and neither may
+    // adjust channels around its int16 data.
+    const uint32_t outChannelCount =
+            audio_channel_count_from_out_mask(mConfig.outputCfg.channels);
+    const uint32_t nextInChannelCount =
+            audio_channel_count_from_out_mask(next->mConfig.inputCfg.channels);
+    const size_t frameCount = mConfig.outputCfg.buffer.frameCount;
+    return mOutBuffer != 0 && mOutBuffer == next->mInBuffer
+            && mConfig.outputCfg.accessMode == EFFECT_BUFFER_ACCESS_WRITE
+            && mOutChannelCountRequested == outChannelCount
+            && next->mInChannelCountRequested == nextInChannelCount
+            && outChannelCount == nextInChannelCount
+            && frameCount == next->mConfig.inputCfg.buffer.frameCount
+            && mOutConversionBuffer != 0 && next->mInConversionBuffer != 0
+            && next->mInConversionBuffer->getSize()
+                    >= outChannelCount * frameCount * sizeof(int16_t);
+#else
+    (void)next;
+    return false;
+#endif
+}
+
+bool AudioFlinger::EffectModule::isHandingOffInt16To(const sp<EffectModule>& next) const
+{
+#ifdef FLOAT_EFFECT_CHAIN
+    return mInt16HandOff && next != nullptr && mOutConversionBuffer == next->mInConversionBuffer;
+#else
+    (void)next;
+    return false;
+#endif
+}
+
+void AudioFlinger::EffectModule::setInt16HandOff(const sp<EffectModule>& next)
+{
+#ifdef FLOAT_EFFECT_CHAIN
+    if (mEffectInterface == 0) {
+        return;
+    }
+    if (next != nullptr) {
+        mOutConversionBuffer = next->mInConversionBuffer;
+        mEffectInterface->setOutBuffer(mOutConversionBuffer);
+        mInt16HandOff = true;
+    } else if (mInt16HandOff) {
+        // allocate our own output conversion buffer again
+        mInt16HandOff = false;
+        mOutConversionBuffer.clear();
+        setOutBuffer(mOutBuffer);
+    }
+#else
+    (void)next;
+#endif
 }
 
 void AudioFlinger::EffectModule::reset_l()
@@ -2303,8 +2407,15 @@ void AudioFlinger::EffectChain::process_l()
         if (mInBuffer->audioBuffer()->raw != mOutBuffer->audioBuffer()->raw) {
             mOutBuffer->update();
         }
+        bool int16Output = false;
         for (size_t i = 0; i < size; i++) {
-            mEffects[i]->process();
+            const bool keepInt16Output = i + 1 < size
+                    && mEffects[i]->isHandingOffInt16To(mEffects[i + 1])
+                    && mEffects[i + 1]->isProcessInt16();
+            int16Output = mEffects[i]->process(int16Output, keepInt16Output);
+            if (int16Output) {
+                mInt16HandOffCount++;
+            }
         }
         mInBuffer->commit();
         if (mInBuffer->audioBuffer()->raw != mOutBuffer->audioBuffer()->raw) {
@@ -2426,10 +2537,27 @@ status_t AudioFlinger::EffectChain::addEffect_ll(const sp<EffectModule>& effect)
                 __func__, effect.get(), this, idx_insert);
     }
     effect->configure();
+    updateInt16HandOffs_l();
 
     return NO_ERROR;
 }
 
+// updateInt16HandOffs_l() must be called with EffectChain::mLock held
+void AudioFlinger::EffectChain::updateInt16HandOffs_l()
+{
+    const size_t size = mEffects.size();
+    for (size_t i = 0; i < size; i++) {
+        const sp<EffectModule> next = i + 1 < size ? mEffects[i + 1] : nullptr;
+        if (mEffects[i]->canHandOffInt16To(next)) {
+            if (!mEffects[i]->isHandingOffInt16To(next)) {
+                mEffects[i]->setInt16HandOff(next);
+            }
+        } else {
+            mEffects[i]->setInt16HandOff(nullptr);
+        }
+    }
+}
+
 std::optional<size_t> AudioFlinger::EffectChain::findVolumeControl_l(size_t from, size_t to) const {
     for (size_t i = std::min(to, mEffects.size()); i > from; i--) {
         if (mEffects[i - 1]->isVolumeControlEnabled()) {
@@ -2551,6 +2679,8 @@ size_t AudioFlinger::EffectChain::removeEffect_l(const sp<EffectModule>& effect,
                 mEffects[0]->updateAccessMode();      // reconfig if neeeded.
             }
 
+            updateInt16HandOffs_l();
+
             ALOGV("removeEffect_l() effect %p, removed from chain %p at rank %zu", effect.get(),
                     this, i);
             break;
@@ -2741,6 +2871,7 @@ NO_THREAD_SAFETY_ANALYSIS  // conditional try lock
                 (int)outBufferStr.size(), "Out buffer      ");
         result.appendFormat("\t%s   %s   %d\n",
                 inBufferStr.c_str(), outBufferStr.c_str(), mActiveTrackCnt);
+        result.appendFormat("\tInt16 hand offs: %lld\n", (long long)mInt16HandOffCount);
         write(fd, result.string(), result.size());
 
         for (size_t i = 0; i < numEffects; ++i) {
@@ -227,7 +227,12 @@ public:
                     audio_port_handle_t deviceId);
     virtual ~EffectModule();
 
-    void process();
+    // int16Input: the previous effect left its int16 output in mInConversionBuffer,
+    // see EffectChain::updateInt16HandOffs_l().
+    // keepInt16Output: the next effect will read the int16 output, so it is not
+    // converted back to float.
+    // Returns true if the int16 output was kept.
+    bool process(bool int16Input = false, bool keepInt16Output = false);
     bool updateState();
     status_t command(int32_t cmdCode,
                      const std::vector<uint8_t>& cmdData,
@@ -255,6 +260,16 @@ public:
         return mOutBuffer != 0 ? reinterpret_cast<int16_t*>(mOutBuffer->ptr()) : NULL;
     }
 
+    // Int16 hand off: when this effect and the next one in the chain both process int16,
+    // this effect's int16 output buffer is the next effect's int16 input buffer, which
+    // elides the conversion to float and back between them.
+    bool        canHandOffInt16To(const sp<EffectModule>& next) const;
+    bool        isHandingOffInt16To(const sp<EffectModule>& next) const;
+    // next is nullptr to stop handing off.
+    void        setInt16HandOff(const sp<EffectModule>& next);
+    // true if process() will run the effect engine on int16 data.
+    bool        isProcessInt16();
+
     // Updates the access mode if it is out of date.  May issue a new effect configure.
     void        updateAccessMode() {
                     if (requiredEffectBufferAccessMode() != mConfig.outputCfg.accessMode) {
@@ -307,6 +322,7 @@ private:
     }
 
     status_t setVolumeInternal(uint32_t *left, uint32_t *right, bool controller);
+    bool isProcessInt16_l() const;
 
 
     effect_config_t     mConfig;    // input and output audio configuration
@@ -329,6 +345,7 @@ private:
     sp<EffectBufferHalInterface> mOutConversionBuffer;
     uint32_t mInChannelCountRequested;
     uint32_t mOutChannelCountRequested;
+    bool    mInt16HandOff = false;  // mOutConversionBuffer is the next effect's input
 #endif
 
     class AutoLockReentrant {
@@ -681,6 +698,10 @@ private:
 
     std::optional<size_t> findVolumeControl_l(size_t from, size_t to) const;
 
+    // Sets up int16 hand offs between adjacent effects, must be called after the
+    // effect list or the buffers of the effects change.
+    void updateInt16HandOffs_l();
+
     mutable  Mutex mLock;        // mutex protecting effect list
              Vector< sp<EffectModule> > mEffects; // list of effect modules
              audio_session_t mSessionId; // audio session ID
@@ -707,6 +728,8 @@ private:
              const sp<EffectCallback> mEffectCallback;
 
              wp<EffectModule> mVolumeControlEffect;
+
+             int64_t mInt16HandOffCount = 0; // conversions to float and back elided
 };
 
 class DeviceEffectProxy : public EffectBase {
@@ -188,7 +188,6 @@ void FastMixer::updateMixerTrack(int index, Reason reason) {
         mMixer->setParameter(index, AudioMixer::VOLUME, AudioMixer::VOLUME0, &vlf);
         mMixer->setParameter(index, AudioMixer::VOLUME, AudioMixer::VOLUME1, &vrf);
 
-        mMixer->setParameter(index, AudioMixer::RESAMPLE, AudioMixer::REMOVE, nullptr);
         mMixer->setParameter(index, AudioMixer::TRACK, AudioMixer::MAIN_BUFFER,
                 (void *)mMixerBuffer);
         mMixer->setParameter(index, AudioMixer::TRACK, AudioMixer::MIXER_FORMAT,
@@ -206,6 +205,16 @@ void FastMixer::updateMixerTrack(int index, Reason reason) {
         mMixer->setParameter(index, AudioMixer::TRACK, AudioMixer::HAPTIC_MAX_AMPLITUDE,
                 (void *)(&(fastTrack->mHapticMaxAmplitude)));
 
+        // The resampler is created after the channel masks are set, so that it is
+        // configured for the final channel count.  Admission of resampling fast tracks
+        // against the cycle budget is done by the MixerThread.
+        if (fastTrack->mSampleRate != 0 && fastTrack->mSampleRate != mSampleRate) {
+            mMixer->setParameter(index, AudioMixer::RESAMPLE, AudioMixer::SAMPLE_RATE,
+                    (void *)(uintptr_t)fastTrack->mSampleRate);
+        } else {
+            mMixer->setParameter(index, AudioMixer::RESAMPLE, AudioMixer::REMOVE, nullptr);
+        }
+
         mMixer->enable(index);
         break;
     default:
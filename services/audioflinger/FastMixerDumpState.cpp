@@ -17,6 +17,8 @@
 #define LOG_TAG "FastMixerDumpState"
 //#define LOG_NDEBUG 0
 
+#include <algorithm>
+
 #include "Configuration.h"
 #ifdef FAST_THREAD_STATISTICS
 #include <audio_utils/Statistics.h>
@@ -203,4 +205,27 @@ void FastMixerDumpState::dump(int fd) const
     }
 }
 
+uint32_t FastMixerDumpState::getRecentMeanLoadNs(uint32_t maxSamples) const
+{
+#ifdef FAST_THREAD_STATISTICS
+    const uint32_t bounds = mBounds;
+    const uint32_t newestOpen = bounds & 0xFFFF;
+    const uint32_t oldestClosed = bounds >> 16;
+    uint32_t n;
+    __builtin_sub_overflow(newestOpen, oldestClosed, &n);
+    n = std::min({n & 0xFFFF, mSamplingN, maxSamples});
+    if (n == 0) {
+        return 0;
+    }
+    uint64_t sumNs = 0;
+    for (uint32_t j = 1; j <= n; ++j) {
+        sumNs += mLoadNs[(newestOpen - j) & (mSamplingN - 1)];
+    }
+    return sumNs / n;
+#else
+    (void)maxSamples;
+    return 0;
+#endif
+}
+
 }  // namespace android
@@ -67,6 +67,11 @@ struct FastMixerDumpState : FastThreadDumpState {
 
     void dump(int fd) const;    // should only be called on a stable copy, not the original
 
+    // Returns the mean CPU load per mix cycle in ns over the newest maxSamples samples,
+    // or 0 if no statistics are available.  May be called on the original,
+    // the result is then an estimate as the samples are not read atomically.
+    uint32_t getRecentMeanLoadNs(uint32_t maxSamples) const;
+
     double   mLatencyMs = 0.;   // measured latency, default of 0 if no valid timestamp read.
     uint32_t mWriteSequence;    // incremented before and after each write()
     uint32_t mFramesWritten;    // total number of frames written successfully
@@ -111,6 +111,24 @@ void AudioFlinger::MelReporter::updateMetadataForCsd(audio_io_handle_t streamHan
         return;
     }
 
+    bool shouldActivateCsd = false;
+    for (const auto& metadata : metadataVec) {
+        if (metadata.base.usage == AUDIO_USAGE_GAME || metadata.base.usage == AUDIO_USAGE_MEDIA) {
+            shouldActivateCsd = true;
+            break;
+        }
+    }
+
+    // This is called from the playback thread loop on every metadata update. Only take the
+    // AudioFlinger lock, which may be held for a long time by binder calls, if the MEL
+    // computation must be started or stopped.
+    {
+        std::lock_guard _l(mLock);
+        if (!csdStateChanges_l(streamHandle, shouldActivateCsd)) {
+            return;
+        }
+    }
+
     std::lock_guard _laf(mAudioFlinger.mLock);
     std::lock_guard _l(mLock);
     auto activeMelPatchId = activePatchStreamHandle_l(streamHandle);
@@ -119,13 +137,6 @@ void AudioFlinger::MelReporter::updateMetadataForCsd(audio_io_handle_t streamHan
         return;
     }
 
-    bool shouldActivateCsd = false;
-    for (const auto& metadata : metadataVec) {
-        if (metadata.base.usage == AUDIO_USAGE_GAME || metadata.base.usage == AUDIO_USAGE_MEDIA) {
-            shouldActivateCsd = true;
-        }
-    }
-
     auto activeMelPatchIt = mActiveMelPatches.find(activeMelPatchId.value());
     if (activeMelPatchIt != mActiveMelPatches.end()
         && shouldActivateCsd != activeMelPatchIt->second.csdActive) {
@@ -282,6 +293,18 @@ std::optional<audio_patch_handle_t> AudioFlinger::MelReporter::activePatchStream
     return std::nullopt;
 }
 
+bool AudioFlinger::MelReporter::csdStateChanges_l(audio_io_handle_t streamHandle,
+                                                  bool csdActive) {
+    auto activeMelPatchId = activePatchStreamHandle_l(streamHandle);
+    if (!activeMelPatchId) {
+        ALOGV("%s stream handle %d does not have an active patch", __func__, streamHandle);
+        return false;
+    }
+    auto activeMelPatchIt = mActiveMelPatches.find(activeMelPatchId.value());
+    return activeMelPatchIt != mActiveMelPatches.end()
+            && activeMelPatchIt->second.csdActive != csdActive;
+}
+
 bool AudioFlinger::MelReporter::useHalSoundDoseInterface_l() {
     return !mSoundDoseManager->forceUseFrameworkMel() & mUseHalSoundDoseInterface;
 }
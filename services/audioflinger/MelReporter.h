@@ -98,6 +98,9 @@ private:
     std::optional<audio_patch_handle_t>
     activePatchStreamHandle_l(audio_io_handle_t streamHandle) REQUIRES(mLock);
 
+    /** Returns true if the CSD state of the active patch for streamHandle differs. */
+    bool csdStateChanges_l(audio_io_handle_t streamHandle, bool csdActive) REQUIRES(mLock);
+
     bool useHalSoundDoseInterface_l() REQUIRES(mLock);
 
     AudioFlinger& mAudioFlinger;  // does not own the object
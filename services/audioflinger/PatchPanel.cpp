@@ -729,6 +729,21 @@ String8 AudioFlinger::PatchPanel::Patch::dump(audio_patch_handle_t myHandle) con
     double latencyMs;
     if (getLatencyMs(&latencyMs) == OK) {
         result.appendFormat("  latency: %.2lf ms", latencyMs);
+        // break down the latency of each hop of a PCM software bridge
+        auto recordTrack = mRecord.const_track();
+        auto playbackTrack = mPlayback.const_track();
+        double captureMs, playbackMs;
+        if (recordTrack.get() != nullptr && playbackTrack.get() != nullptr
+                && audio_is_linear_pcm(recordTrack->format())
+                && recordTrack->getServerLatencyMs(&captureMs) == OK
+                && playbackTrack->getServerLatencyMs(&playbackMs) == OK) {
+            result.appendFormat(" (capture %.2lf ms, patch buffer %.2lf ms, playback %.2lf ms)",
+                    captureMs, playbackTrack->bufferLatencyMs(), playbackMs);
+        }
+    }
+    if (auto recordTrack = mRecord.const_track(); recordTrack.get() != nullptr) {
+        result.appendFormat("  zero copy frames: %lld",
+                (long long)recordTrack->zeroCopyFrames());
     }
     return result;
 }
@@ -119,6 +119,9 @@ private:
 
             // used by the record thread to convert frames to proper destination format
             RecordBufferConverter              *mRecordBufferConverter;
+            // see RecordThread::convertSharedTracks()
+            bool                               mSharedConversion = false; // delivered by a group
+            bool                               mConverterStale = false;   // converted by a group
             audio_input_flags_t                mFlags;
 
             bool                               mSilenced;
@@ -158,11 +161,18 @@ public:
         return writeFrames(this, src, frameCount, frameSize);
     }
 
+    // Frames read by the RecordThread straight into the patch buffer.
+    void addZeroCopyFrames(size_t frames) { mZeroCopyFrames += frames; }
+    int64_t zeroCopyFrames() const { return mZeroCopyFrames; }
+
 protected:
     /** Write the source data into the buffer provider. @return written frame count. */
     static size_t writeFrames(AudioBufferProvider* dest, const void* src,
             size_t frameCount, size_t frameSize);
 
+private:
+    std::atomic<int64_t> mZeroCopyFrames{0};  // written by the thread loop, read by dump
+
 };  // end of PatchRecord
 
 class PassthruPatchRecord : public PatchRecord, public Source {
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_STATE_SNAPSHOT_H
+#define ANDROID_AUDIO_STATE_SNAPSHOT_H
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+
+#include <android-base/thread_annotations.h>
+
+namespace android {
+
+// StateSnapshot publishes a small, trivially copyable state from binder threads to
+// a playback thread loop, so that neither needs the thread mLock to exchange it.
+//
+// Like StateQueue, the observer must always be able to read the latest published state
+// and must never be blocked by a mutator.  Unlike StateQueue, there may be several
+// concurrent mutators (binder threads); they are serialized by a private mutex
+// which the observer never takes.
+//
+// The state is double-buffered: a mutator writes the slot that is not published, then
+// publishes it by advancing the epoch.  Each slot carries a sequence count which is odd
+// while it is being written, so an observer that raced with two successive mutations
+// detects the torn copy and retries with the newer slot.
+template <typename T>
+class StateSnapshot {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+    explicit StateSnapshot(const T& initial = T{}) : mMutable(initial) {
+        mSlots[0].value = initial;
+    }
+
+    // Mutator: applies f(T&) to the latest state and publishes the result.
+    // Returns the new epoch.
+    template <typename F>
+    uint32_t modify(F f) {
+        std::lock_guard _l(mMutatorLock);
+        f(mMutable);
+        const uint32_t epoch = mEpoch.load(std::memory_order_relaxed) + 1;
+        Slot& slot = mSlots[epoch & 1];
+        slot.seq.fetch_add(1, std::memory_order_relaxed);  // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.value = mMutable;
+        slot.seq.fetch_add(1, std::memory_order_release);  // even: slot is stable
+        mEpoch.store(epoch, std::memory_order_release);
+        return epoch;
+    }
+
+    // Observer: returns a consistent copy of the latest published state, never blocks.
+    // If epoch is not null, returns the epoch of the copy, which increases on each modify().
+    T load(uint32_t *epoch = nullptr) const {
+        for (;;) {
+            const uint32_t e = mEpoch.load(std::memory_order_acquire);
+            const Slot& slot = mSlots[e & 1];
+            const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq & 1) continue;  // being rewritten by a newer mutation
+            T value = slot.value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == seq) {
+                if (epoch != nullptr) *epoch = e;
+                return value;
+            }
+        }
+    }
+
+    // Observer: returns the epoch of the latest published state.
+    uint32_t epoch() const { return mEpoch.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq{0};
+        T value{};
+    };
+
+    Slot mSlots[2];
+    std::atomic<uint32_t> mEpoch{0};    // mSlots[mEpoch & 1] is the published slot
+
+    std::mutex mMutatorLock;
+    T mMutable GUARDED_BY(mMutatorLock); // latest state, only accessed by mutators
+};
+
+}   // namespace android
+
+#endif  // ANDROID_AUDIO_STATE_SNAPSHOT_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define LOG_TAG "SubmixThreadPool"
+//#define LOG_NDEBUG 0
+
+#include "Configuration.h"
+#include <algorithm>
+#include <string>
+#include <system/thread_defs.h>
+#include <utils/Log.h>
+#include "SubmixThreadPool.h"
+
+namespace android {
+
+SubmixThreadPool::SubmixThreadPool(const char *name, size_t helperCount)
+{
+    for (size_t i = 0; i < helperCount; ++i) {
+        sp<HelperThread> helper = sp<HelperThread>::make(this, i + 1 /* partition */);
+        const std::string threadName = std::string(name) + "_" + std::to_string(i + 1);
+        const status_t status = helper->run(threadName.c_str(), ANDROID_PRIORITY_URGENT_AUDIO);
+        if (status != NO_ERROR) {
+            ALOGW("%s: cannot start helper %s, status %d", __func__, threadName.c_str(), status);
+            break;
+        }
+        mHelpers.push_back(std::move(helper));
+    }
+}
+
+SubmixThreadPool::~SubmixThreadPool()
+{
+    for (const auto &helper : mHelpers) {
+        helper->requestExit();
+    }
+    {
+        std::lock_guard _l(mLock);
+        mExit = true;
+    }
+    mWorkCV.notify_all();
+    for (const auto &helper : mHelpers) {
+        helper->join();
+    }
+}
+
+std::vector<pid_t> SubmixThreadPool::getTids() const
+{
+    std::vector<pid_t> tids;
+    for (const auto &helper : mHelpers) {
+        tids.push_back(helper->getTid());
+    }
+    return tids;
+}
+
+void SubmixThreadPool::run(Job *job, size_t count)
+{
+    count = std::min(count, partitions());
+    if (count > 1) {
+        {
+            std::lock_guard _l(mLock);
+            mJob = job;
+            mCount = count;
+            mPending = count - 1;
+            ++mGeneration;
+        }
+        mWorkCV.notify_all();
+    }
+
+    job->mix(0);
+
+    if (count > 1) {
+        std::unique_lock ul(mLock);
+        mDoneCV.wait(ul, [this]() REQUIRES(mLock) { return mPending == 0; });
+        mJob = nullptr;
+    }
+}
+
+bool SubmixThreadPool::HelperThread::threadLoop()
+{
+    Job *job;
+    {
+        std::unique_lock ul(mPool->mLock);
+        mPool->mWorkCV.wait(ul, [this]() REQUIRES(mPool->mLock) {
+            return mPool->mExit || mPool->mGeneration != mGeneration;
+        });
+        if (mPool->mExit) return false;
+        mGeneration = mPool->mGeneration;
+        // helpers beyond the partition count of this job are idle until the next one.
+        if (mPartition >= mPool->mCount) return true;
+        job = mPool->mJob;
+    }
+
+    job->mix(mPartition);
+
+    bool done;
+    {
+        std::lock_guard _l(mPool->mLock);
+        done = --mPool->mPending == 0;
+    }
+    if (done) {
+        mPool->mDoneCV.notify_one();
+    }
+    return true;
+}
+
+}   // namespace android
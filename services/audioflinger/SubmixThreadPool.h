@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_SUBMIX_THREAD_POOL_H
+#define ANDROID_AUDIO_SUBMIX_THREAD_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <android-base/thread_annotations.h>
+#include <media/AudioMixerBase.h>
+#include <utils/Thread.h>
+
+namespace android {
+
+// A small fixed pool of helper threads used by a MixerThread to mix partitions of
+// a large track set concurrently, see AudioMixerBase::setSubmixExecutor().
+// The owner is responsible for raising the helper threads to SCHED_FIFO using getTids().
+class SubmixThreadPool : public AudioMixerBase::SubmixExecutor {
+public:
+    // Starts helperCount helper threads named "<name>_<index>".
+    SubmixThreadPool(const char *name, size_t helperCount);
+    ~SubmixThreadPool() override;
+
+    // AudioMixerBase::SubmixExecutor
+    size_t partitions() const override { return mHelpers.size() + 1; }
+    void run(Job *job, size_t count) override;
+
+    std::vector<pid_t> getTids() const;
+
+private:
+    class HelperThread : public Thread {
+    public:
+        HelperThread(SubmixThreadPool *pool, size_t partition)
+            : Thread(false /* canCallJava */), mPool(pool), mPartition(partition) {}
+    private:
+        bool threadLoop() override;
+
+        SubmixThreadPool * const mPool;
+        const size_t mPartition;      // partition mixed by this thread, never 0
+        uint64_t mGeneration = 0;     // last job generation seen
+    };
+
+    std::vector<sp<HelperThread>> mHelpers;
+
+    std::mutex mLock;
+    std::condition_variable mWorkCV;  // signaled when a job is posted or on exit
+    std::condition_variable mDoneCV;  // signaled when the last helper completes
+    Job *mJob GUARDED_BY(mLock) = nullptr;
+    size_t mCount GUARDED_BY(mLock) = 0;
+    size_t mPending GUARDED_BY(mLock) = 0;
+    uint64_t mGeneration GUARDED_BY(mLock) = 0;
+    bool mExit GUARDED_BY(mLock) = false;
+};
+
+}   // namespace android
+
+#endif  // ANDROID_AUDIO_SUBMIX_THREAD_POOL_H
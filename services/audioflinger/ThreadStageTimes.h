@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_AUDIO_THREADSTAGETIMES_H
+#define ANDROID_AUDIO_THREADSTAGETIMES_H
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+#include <android-base/stringprintf.h>
+#include <audio_utils/Statistics.h>
+#include <utils/Timers.h>
+
+namespace android {
+
+/**
+ * ThreadStageTimes records the time spent in each stage of a thread loop period.
+ *
+ * The thread loop calls beginPeriod() before the first stage, endStage() at the
+ * end of each stage and endPeriod() once the period is complete.  A period that is
+ * begun but not ended (e.g. the thread sleeps instead of writing) is discarded by the
+ * next beginPeriod().  Stages may occur in any order, or not at all.
+ *
+ * When the period is over its deadline, the overrun is attributed to the stage
+ * which took the most time, which is what dumpsys and mediametrics report.
+ *
+ * Timing is enabled at construction; when disabled each call is a single branch.
+ *
+ * The methods other than dump() and the accessors must be called from the thread loop.
+ * The statistics are internally locked, so they may be read from any thread.
+ */
+class ThreadStageTimes final {
+public:
+    enum Stage {
+        STAGE_PREPARE,  // track preparation under the thread lock
+        STAGE_MIX,      // mixing, or conversion to the client format for capture
+        STAGE_EFFECTS,  // effect chain processing
+        STAGE_IO,       // HAL write or read
+        STAGE_CNT,
+    };
+
+    // Period time histogram buckets, in quarters of the deadline.
+    // The last bucket counts the periods over the deadline.
+    static constexpr size_t kHistogramBuckets = 5;
+
+    explicit ThreadStageTimes(bool enabled) : mEnabled(enabled) {}
+
+    bool isEnabled() const { return mEnabled; }
+
+    void beginPeriod() {
+        if (!mEnabled) return;
+        mPeriodStartNs = mLastNs = systemTime();
+        for (auto& stageNs : mStageNs) stageNs = 0;
+    }
+
+    // Attributes the time since the last stage, or the period begin, to stage.
+    void endStage(Stage stage) {
+        if (!mEnabled || mPeriodStartNs == 0) return;
+        const int64_t nowNs = systemTime();
+        mStageNs[stage] += nowNs - mLastNs;
+        mLastNs = nowNs;
+    }
+
+    // Completes the period, deadlineNs is the nominal period of the thread.
+    void endPeriod(int64_t deadlineNs) {
+        if (!mEnabled || mPeriodStartNs == 0) return;
+        const int64_t periodNs = mLastNs - mPeriodStartNs;
+        mPeriodStartNs = 0;
+
+        size_t bucket = kHistogramBuckets - 1;
+        if (deadlineNs > 0 && periodNs <= deadlineNs) {
+            bucket = std::min(kHistogramBuckets - 2,
+                    (size_t)(periodNs * (kHistogramBuckets - 1) / deadlineNs));
+        }
+        size_t maxStage = 0;
+        for (size_t i = 1; i < STAGE_CNT; ++i) {
+            if (mStageNs[i] > mStageNs[maxStage]) maxStage = i;
+        }
+
+        std::lock_guard l(mLock);
+        for (size_t i = 0; i < STAGE_CNT; ++i) {
+            mStageMs[i].add(mStageNs[i] * 1e-6);
+        }
+        mPeriodMs.add(periodNs * 1e-6);
+        ++mHistogram[bucket];
+        if (bucket == kHistogramBuckets - 1) {
+            ++mOverruns[maxStage];
+        }
+    }
+
+    void reset() {
+        std::lock_guard l(mLock);
+        for (auto& stats : mStageMs) stats.reset();
+        mPeriodMs.reset();
+        for (auto& count : mHistogram) count = 0;
+        for (auto& count : mOverruns) count = 0;
+    }
+
+    // Returns the mean stage times in ms, or false if there are no statistics.
+    bool getMeanMs(double (&stageMs)[STAGE_CNT], double *periodMs) const {
+        std::lock_guard l(mLock);
+        if (mPeriodMs.getN() == 0) return false;
+        for (size_t i = 0; i < STAGE_CNT; ++i) {
+            stageMs[i] = mStageMs[i].getMean();
+        }
+        *periodMs = mPeriodMs.getMean();
+        return true;
+    }
+
+    int64_t getOverruns(Stage stage) const {
+        std::lock_guard l(mLock);
+        return mOverruns[stage];
+    }
+
+    // ioName names the STAGE_IO stage, e.g. "write" or "read".
+    std::string dump(const char *ioName) const {
+        std::lock_guard l(mLock);
+        if (mPeriodMs.getN() == 0) return {};
+        std::string result = base::StringPrintf(
+                "  Period ms stats: %s\n", mPeriodMs.toString().c_str());
+        for (size_t i = 0; i < STAGE_CNT; ++i) {
+            result.append(base::StringPrintf("    %-7s ms stats: %s overruns: %lld\n",
+                    i == STAGE_IO ? ioName : stageToString((Stage)i),
+                    mStageMs[i].toString().c_str(), (long long)mOverruns[i]));
+        }
+        result.append("  Period histogram (fraction of deadline):");
+        for (size_t i = 0; i < kHistogramBuckets; ++i) {
+            result.append(base::StringPrintf(" %s%u%%:%lld",
+                    i == kHistogramBuckets - 1 ? ">" : "<=",
+                    (unsigned)(std::min(i + 1, kHistogramBuckets - 1) * 100
+                            / (kHistogramBuckets - 1)),
+                    (long long)mHistogram[i]));
+        }
+        result.append("\n");
+        return result;
+    }
+
+    static const char *stageToString(Stage stage) {
+        switch (stage) {
+        case STAGE_PREPARE: return "prepare";
+        case STAGE_MIX:     return "mix";
+        case STAGE_EFFECTS: return "effects";
+        case STAGE_IO:      return "io";
+        default:            return "unknown";
+        }
+    }
+
+private:
+    const bool mEnabled;
+
+    // thread loop only
+    int64_t mPeriodStartNs = 0;  // 0 if no period is begun
+    int64_t mLastNs = 0;
+    int64_t mStageNs[STAGE_CNT] = {};
+
+    mutable std::mutex mLock;
+    audio_utils::Statistics<double> mStageMs[STAGE_CNT] GUARDED_BY(mLock);
+    audio_utils::Statistics<double> mPeriodMs GUARDED_BY(mLock);
+    int64_t mHistogram[kHistogramBuckets] GUARDED_BY(mLock) = {};
+    int64_t mOverruns[STAGE_CNT] GUARDED_BY(mLock) = {};
+};
+
+} // namespace android
+
+#endif // ANDROID_AUDIO_THREADSTAGETIMES_H
@@ -181,6 +181,24 @@ static const nsecs_t kOffloadStandbyDelayNs = seconds(1);
 // Direct output thread minimum sleep time in idle or active(underrun) state
 static const nsecs_t kDirectMinSleepTimeUs = 10000;
 
+// Direct and offload output thread adaptive burst sizing.
+// With the screen off and enough data buffered by the client, a write may carry up to
+// "af.direct.burst_max" HAL buffers (default 1, i.e. disabled), so that the thread wakes up
+// less often. The burst grows by one HAL buffer after kDirectBurstGrowWrites writes without
+// a latency sensitive event (seek, pause, volume change, ...), and the client must hold
+// kDirectBurstHeadroom times the new burst for it to grow.
+static const int32_t kDirectBurstMaxLimit = 8;
+static const uint32_t kDirectBurstGrowWrites = 8;
+static const uint32_t kDirectBurstHeadroom = 2;
+
+static uint32_t getDirectBurstMax()
+{
+    static const uint32_t burstMax = std::clamp(
+            property_get_int32("af.direct.burst_max", 1 /* default_value */),
+            1, kDirectBurstMaxLimit);
+    return burstMax;
+}
+
 // Minimum amount of time between checking to see if the timestamp is advancing
 // for underrun detection. If we check too frequently, we may not detect a
 // timestamp update and will falsely detect underrun.
@@ -221,6 +239,20 @@ static const enum {
 static const int kPriorityAudioApp = 2;
 static const int kPriorityFastMixer = 3;
 static const int kPriorityFastCapture = 3;
+static const int kPrioritySubmix = 2;
+
+// Parallel sub-mix of large track sets in the MixerThread, see AudioMixerBase::setSubmixExecutor().
+// The track threshold is specified by property af.mixer.submix_track_threshold, 0 disables.
+// The number of helper threads is specified by property af.mixer.submix_helpers.
+static const int kSubmixHelpersDefault = 2;
+static const int kSubmixHelpersMax = 4;
+
+// Fast tracks that are not at the sink sample rate may be resampled by the FastMixer.
+// At most af.fast_track.resample_max such tracks are admitted per MixerThread, 0 disables,
+// and only while the measured fast mixer cycle load is below
+// af.fast_track.resample_load_percent of the fast mixer period.
+static const int kFastTrackResampleMaxDefault = 2;
+static const int kFastTrackResampleLoadPercentDefault = 50;
 
 // IAudioFlinger::createTrack() has an in/out parameter 'pFrameCount' for the total size of the
 // track buffer in shared memory.  Zero on input means to use a default value.  For fast tracks,
@@ -551,6 +583,7 @@ AudioFlinger::ThreadBase::ThreadBase(const sp<AudioFlinger>& audioFlinger, audio
         mAudioFlinger(audioFlinger),
         mThreadMetrics(std::string(AMEDIAMETRICS_KEY_PREFIX_AUDIO_THREAD) + std::to_string(id),
                isOut),
+        mStageTimes(property_get_bool("af.thread.stage_timing", false /* default_value */)),
         mIsOut(isOut),
         // mSampleRate, mFrameCount, mChannelMask, mChannelCount, mFrameSize, mFormat, mBufferSize
         // are set by PlaybackThread::readOutputParameters_l() or
@@ -674,6 +707,7 @@ void AudioFlinger::ThreadBase::sendIoConfigEvent_l(audio_io_config_event_t event
     mLatencyMs.reset();
     mProcessTimeMs.reset();
     mMonopipePipeDepthStats.reset();
+    mStageTimes.reset();
     mTimestampVerifier.discontinuity(mTimestampVerifier.DISCONTINUITY_MODE_CONTINUOUS);
 
     sp<ConfigEvent> configEvent = (ConfigEvent *)new IoConfigEvent(event, pid, portId);
@@ -1047,6 +1081,11 @@ void AudioFlinger::ThreadBase::dumpBase_l(int fd, const Vector<String16>& args _
                 mLatencyMs.toString().c_str());
     }
 
+    const std::string stageTimes = mStageTimes.dump(isOutput() ? "write" : "read");
+    if (!stageTimes.empty()) {
+        dprintf(fd, "%s", stageTimes.c_str());
+    }
+
     if (mMonopipePipeDepthStats.getN() > 0) {
         dprintf(fd, "  Monopipe %s pipe depth stats: %s\n",
             isOutput() ? "write" : "read",
@@ -2040,6 +2079,18 @@ void AudioFlinger::ThreadBase::sendStatistics(bool force)
         item->setDouble(MM_PREFIX "monopipePipeDepthStats.std",
                         mMonopipePipeDepthStats.getStdDev());
     }
+    double stageMs[ThreadStageTimes::STAGE_CNT];
+    double periodMs;
+    if (mStageTimes.getMeanMs(stageMs, &periodMs)) {
+        item->setDouble(MM_PREFIX "periodMs.mean", periodMs);
+        for (size_t i = 0; i < ThreadStageTimes::STAGE_CNT; ++i) {
+            const auto stage = static_cast<ThreadStageTimes::Stage>(i);
+            const std::string name = std::string(MM_PREFIX "stage.")
+                    + ThreadStageTimes::stageToString(stage);
+            item->setDouble((name + "Ms.mean").c_str(), stageMs[i]);
+            item->setInt64((name + ".overruns").c_str(), mStageTimes.getOverruns(stage));
+        }
+    }
 
     item->selfrecord();
 }
@@ -2128,10 +2179,12 @@ AudioFlinger::PlaybackThread::PlaybackThread(const sp<AudioFlinger>& audioFlinge
     if (mOutput->audioHwDev) {
         if (mOutput->audioHwDev->canSetMasterVolume()) {
             mMasterVolume = 1.0;
+            mHalMasterVolume = true;
         }
 
         if (mOutput->audioHwDev->canSetMasterMute()) {
             mMasterMute = false;
+            mHalMasterMute = true;
         }
         mIsMsdDevice = strcmp(
                 mOutput->audioHwDev->moduleName(), AUDIO_HARDWARE_MODULE_ID_MSD) == 0;
@@ -2169,6 +2222,12 @@ AudioFlinger::PlaybackThread::PlaybackThread(const sp<AudioFlinger>& audioFlinge
     mStreamTypes[AUDIO_STREAM_PATCH].mute = false;
     mStreamTypes[AUDIO_STREAM_CALL_ASSISTANT].volume = 1.0f;
     mStreamTypes[AUDIO_STREAM_CALL_ASSISTANT].mute = false;
+
+    mVolumeStateEpoch = mVolumeState.modify([this](VolumeState& vs) {
+        std::copy(std::begin(mStreamTypes), std::end(mStreamTypes), std::begin(vs.streamTypes));
+        vs.masterVolume = mMasterVolume;
+        vs.masterMute = mMasterMute;
+    });
 }
 
 AudioFlinger::PlaybackThread::~PlaybackThread()
@@ -2410,8 +2469,8 @@ sp<AudioFlinger::PlaybackThread::Track> AudioFlinger::PlaybackThread::createTrac
                     mChannelMask != AUDIO_CHANNEL_OUT_STEREO ||
                     (channelMask == AUDIO_CHANNEL_OUT_MONO
                             /* && mChannelMask == AUDIO_CHANNEL_OUT_STEREO */)) &&
-            // hardware sample rate
-            (sampleRate == mSampleRate) &&
+            // hardware sample rate, or a resampling fast track within the fast mixer budget
+            (sampleRate == mSampleRate || isFastTrackResamplingAllowed(sampleRate)) &&
             // normal mixer has an associated fast mixer
             hasFastMixer() &&
             // there are sufficient fast track slots available
@@ -2426,7 +2485,9 @@ sp<AudioFlinger::PlaybackThread::Track> AudioFlinger::PlaybackThread::createTrac
             if (ok != 0) {
                 ALOGE("%s pthread_once failed: %d", __func__, ok);
             }
-            frameCount = max(frameCount, mFrameCount * sFastTrackMultiplier); // incl framecount 0
+            // a resampling fast track consumes sourceFramesNeeded() per fast mixer period.
+            frameCount = max(frameCount, sourceFramesNeeded(sampleRate,
+                    mFrameCount * sFastTrackMultiplier, mSampleRate)); // incl framecount 0
         }
 
         // check compatibility with audio effects.
@@ -2783,16 +2844,15 @@ uint32_t AudioFlinger::PlaybackThread::latency_l() const
     return 0;
 }
 
+// The volume setters below publish to mVolumeState without taking mLock,
+// the thread loop applies the new state at its next prepareTracks_l().
 void AudioFlinger::PlaybackThread::setMasterVolume(float value)
 {
-    Mutex::Autolock _l(mLock);
     // Don't apply master volume in SW if our HAL can do it for us.
-    if (mOutput && mOutput->audioHwDev &&
-        mOutput->audioHwDev->canSetMasterVolume()) {
-        mMasterVolume = 1.0;
-    } else {
-        mMasterVolume = value;
-    }
+    const float masterVolume = mHalMasterVolume ? 1.0f : value;
+    mVolumeState.modify([masterVolume](VolumeState& vs) {
+        vs.masterVolume = masterVolume;
+    });
 }
 
 void AudioFlinger::PlaybackThread::setMasterBalance(float balance)
@@ -2805,34 +2865,55 @@ void AudioFlinger::PlaybackThread::setMasterMute(bool muted)
     if (isDuplicating()) {
         return;
     }
-    Mutex::Autolock _l(mLock);
     // Don't apply master mute in SW if our HAL can do it for us.
-    if (mOutput && mOutput->audioHwDev &&
-        mOutput->audioHwDev->canSetMasterMute()) {
-        mMasterMute = false;
-    } else {
-        mMasterMute = muted;
-    }
+    const bool masterMute = mHalMasterMute ? false : muted;
+    mVolumeState.modify([masterMute](VolumeState& vs) {
+        vs.masterMute = masterMute;
+    });
 }
 
 void AudioFlinger::PlaybackThread::setStreamVolume(audio_stream_type_t stream, float value)
 {
-    Mutex::Autolock _l(mLock);
-    mStreamTypes[stream].volume = value;
-    broadcast_l();
+    mVolumeState.modify([stream, value](VolumeState& vs) {
+        vs.streamTypes[stream].volume = value;
+    });
+    signalVolumeChange();
 }
 
 void AudioFlinger::PlaybackThread::setStreamMute(audio_stream_type_t stream, bool muted)
 {
-    Mutex::Autolock _l(mLock);
-    mStreamTypes[stream].mute = muted;
-    broadcast_l();
+    mVolumeState.modify([stream, muted](VolumeState& vs) {
+        vs.streamTypes[stream].mute = muted;
+    });
+    signalVolumeChange();
 }
 
 float AudioFlinger::PlaybackThread::streamVolume(audio_stream_type_t stream) const
 {
-    Mutex::Autolock _l(mLock);
-    return mStreamTypes[stream].volume;
+    return mVolumeState.load().streamTypes[stream].volume;
+}
+
+void AudioFlinger::PlaybackThread::signalVolumeChange()
+{
+    // If mLock is held, the thread loop is either running and will apply the change at
+    // its next prepareTracks_l(), or another binder call is about to wake it.  Otherwise
+    // it may be sleeping, so wake it up as the previous locked setters did.
+    if (mLock.tryLock() == NO_ERROR) {
+        broadcast_l();
+        mLock.unlock();
+    }
+}
+
+// updateVolumeState_l() must be called with ThreadBase::mLock held
+void AudioFlinger::PlaybackThread::updateVolumeState_l()
+{
+    if (mVolumeState.epoch() == mVolumeStateEpoch) {
+        return;
+    }
+    const VolumeState vs = mVolumeState.load(&mVolumeStateEpoch);
+    std::copy(std::begin(vs.streamTypes), std::end(vs.streamTypes), std::begin(mStreamTypes));
+    mMasterVolume = vs.masterVolume;
+    mMasterMute = vs.masterMute;
 }
 
 void AudioFlinger::PlaybackThread::setVolumeForOutput_l(float left, float right) const
@@ -3237,7 +3318,10 @@ void AudioFlinger::PlaybackThread::readOutputParameters_l()
 
     // For sink buffer size, we use the frame size from the downstream sink to avoid problems
     // with non PCM formats for compressed music, e.g. AAC, and Offload threads.
-    const size_t sinkBufferSize = mNormalFrameCount * mFrameSize;
+    // Direct and offload threads may write several HAL buffers at once,
+    // see DirectOutputThread::updateBurst_l().
+    const size_t sinkBufferSize = mNormalFrameCount * mFrameSize
+            * ((mType == DIRECT || mType == OFFLOAD) ? getDirectBurstMax() : 1);
     (void)posix_memalign(&mSinkBuffer, 32, sinkBufferSize);
 
     // We resize the mMixerBuffer according to the requirements of the sink buffer which
@@ -4108,6 +4192,8 @@ NO_THREAD_SAFETY_ANALYSIS  // manual locking of AudioFlinger
                     continue;
                 }
             }
+            mStageTimes.beginPeriod();
+            updateVolumeState_l();
             // mMixerStatusIgnoringFastTracks is also updated internally
             mMixerStatus = prepareTracks_l(&tracksToRemove);
 
@@ -4165,6 +4251,7 @@ NO_THREAD_SAFETY_ANALYSIS  // manual locking of AudioFlinger
                 mWaitHalStartCV.broadcast();
             }
         } // mLock scope ends
+        mStageTimes.endStage(ThreadStageTimes::STAGE_PREPARE);
 
         if (mBytesRemaining == 0) {
             mCurrentWriteLength = 0;
@@ -4255,6 +4342,8 @@ NO_THREAD_SAFETY_ANALYSIS  // manual locking of AudioFlinger
                 mBytesRemaining = 0;
             }
 
+            mStageTimes.endStage(ThreadStageTimes::STAGE_MIX);
+
             // only process effects if we're going to write
             if (mSleepTimeUs == 0 && mType != OFFLOAD) {
                 for (size_t i = 0; i < effectChains.size(); i ++) {
@@ -4355,6 +4444,7 @@ NO_THREAD_SAFETY_ANALYSIS  // manual locking of AudioFlinger
 
         // enable changes in effect chain
         unlockEffectChains(effectChains);
+        mStageTimes.endStage(ThreadStageTimes::STAGE_EFFECTS);
 
         if (!metadataUpdate.playbackMetadataUpdate.empty()) {
             mAudioFlinger->mMelReporter->updateMetadataForCsd(id(),
@@ -4435,6 +4525,11 @@ NO_THREAD_SAFETY_ANALYSIS  // manual locking of AudioFlinger
                         (mMixerStatus == MIXER_DRAIN_ALL)) {
                     threadLoop_drain();
                 }
+                if (mStageTimes.isEnabled()) {
+                    mStageTimes.endStage(ThreadStageTimes::STAGE_IO);
+                    mStageTimes.endPeriod(
+                            (int64_t)mNormalFrameCount * NANOS_PER_SECOND / mSampleRate);
+                }
                 if ((mType == MIXER || mType == SPATIALIZER) && !mStandby) {
 
                     if (mThreadThrottle
@@ -4967,6 +5062,26 @@ AudioFlinger::MixerThread::MixerThread(const sp<AudioFlinger>& audioFlinger, Aud
             mNormalFrameCount);
     mAudioMixer = new AudioMixer(mNormalFrameCount, mSampleRate);
 
+    if (type == MIXER) {
+        const int32_t threshold = property_get_int32("af.mixer.submix_track_threshold", 0);
+        const int32_t helpers = std::clamp(property_get_int32("af.mixer.submix_helpers",
+                kSubmixHelpersDefault), 0, kSubmixHelpersMax);
+        if (threshold >= 2 && helpers > 0) {
+            mSubmixTrackThreshold = threshold;
+            mSubmixThreadPool = std::make_unique<SubmixThreadPool>(
+                    (std::string("AudioSubmix_") + std::to_string(id)).c_str(), helpers);
+            for (const pid_t tid : mSubmixThreadPool->getTids()) {
+                sendPrioConfigEvent(getpid(), tid, kPrioritySubmix, false /*forApp*/);
+            }
+            mAudioMixer->setSubmixExecutor(mSubmixThreadPool.get(), mSubmixTrackThreshold);
+        }
+        mFastTrackResampleMax = std::max(property_get_int32("af.fast_track.resample_max",
+                kFastTrackResampleMaxDefault), 0);
+        mFastTrackResampleLoadPercent = std::clamp(
+                property_get_int32("af.fast_track.resample_load_percent",
+                        kFastTrackResampleLoadPercentDefault), 0, 100);
+    }
+
     if (type == DUPLICATING) {
         // The Duplicating thread uses the AudioMixer and delivers data to OutputTracks
         // (downstream MixerThreads) in DuplicatingThread::threadLoop_write().
@@ -5622,6 +5737,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::MixerThread::prepareTrac
                     fastTrack->mVolumeProvider = vp;
                     fastTrack->mChannelMask = track->mChannelMask;
                     fastTrack->mFormat = track->mFormat;
+                    fastTrack->mSampleRate = track->sampleRate();
                     fastTrack->mHapticPlaybackEnabled = track->getHapticPlaybackEnabled();
                     fastTrack->mHapticIntensity = track->getHapticIntensity();
                     fastTrack->mHapticMaxAmplitude = track->getHapticMaxAmplitude();
@@ -6234,6 +6350,40 @@ void AudioFlinger::PlaybackThread::IsTimestampAdvancing::clear()
     mPreviousNs = 0;
 }
 
+// isFastTrackResamplingAllowed() must be called without ThreadBase::mLock held
+bool AudioFlinger::MixerThread::isFastTrackResamplingAllowed(uint32_t sampleRate)
+{
+    if (mFastTrackResampleMax == 0 || !hasFastMixer() || sampleRate == 0
+            || sampleRate > mSampleRate * AUDIO_RESAMPLER_DOWN_RATIO_MAX
+            || (uint64_t)sampleRate * AUDIO_RESAMPLER_UP_RATIO_MAX < mSampleRate) {
+        return false;
+    }
+
+    // The fast mixer must have measured headroom left in its period, use about 1 second
+    // of mix cycles.  The dump state is read without synchronization, which is fine for
+    // an estimate.
+    const int64_t periodNs = (int64_t)mFrameCount * NANOS_PER_SECOND / mSampleRate;
+    const uint32_t loadNs = mFastMixerDumpState.getRecentMeanLoadNs(mSampleRate / mFrameCount);
+    if (loadNs > periodNs * mFastTrackResampleLoadPercent / 100) {
+        ALOGD("%s: denied for %u Hz, fast mixer load %u ns exceeds %d%% of period %lld ns",
+                __func__, sampleRate, loadNs, mFastTrackResampleLoadPercent,
+                (long long)periodNs);
+        return false;
+    }
+
+    Mutex::Autolock _l(mLock);
+    int32_t resamplingFastTracks = 0;
+    for (const sp<Track>& track : mTracks) {
+        if (track->isFastTrack() && track->sampleRate() != mSampleRate) {
+            ++resamplingFastTracks;
+        }
+    }
+    ALOGD_IF(resamplingFastTracks >= mFastTrackResampleMax,
+            "%s: denied for %u Hz, %d resampling fast tracks",
+            __func__, sampleRate, resamplingFastTracks);
+    return resamplingFastTracks < mFastTrackResampleMax;
+}
+
 // isTrackAllowed_l() must be called with ThreadBase::mLock held
 bool AudioFlinger::MixerThread::isTrackAllowed_l(
         audio_channel_mask_t channelMask, audio_format_t format,
@@ -6314,6 +6464,9 @@ bool AudioFlinger::MixerThread::checkForNewParameter_l(const String8& keyValuePa
             readOutputParameters_l();
             delete mAudioMixer;
             mAudioMixer = new AudioMixer(mNormalFrameCount, mSampleRate);
+            if (mSubmixThreadPool != nullptr) {
+                mAudioMixer->setSubmixExecutor(mSubmixThreadPool.get(), mSubmixTrackThreshold);
+            }
             for (const auto &track : mTracks) {
                 const int trackId = track->id();
                 const status_t createStatus = mAudioMixer->create(
@@ -6340,11 +6493,17 @@ void AudioFlinger::MixerThread::dumpInternals_l(int fd, const Vector<String16>&
     PlaybackThread::dumpInternals_l(fd, args);
     dprintf(fd, "  Thread throttle time (msecs): %u\n", mThreadThrottleTimeMs);
     dprintf(fd, "  AudioMixer tracks: %s\n", mAudioMixer->trackNames().c_str());
+    if (mSubmixThreadPool != nullptr) {
+        dprintf(fd, "  Parallel sub-mix: %zu partitions above %zu tracks\n",
+                mSubmixThreadPool->partitions(), mSubmixTrackThreshold);
+    }
     dprintf(fd, "  Master mono: %s\n", mMasterMono ? "on" : "off");
     dprintf(fd, "  Master balance: %f (%s)\n", mMasterBalance.load(),
             (hasFastMixer() ? std::to_string(mFastMixer->getMasterBalance())
                             : mBalance.toString()).c_str());
     if (hasFastMixer()) {
+        dprintf(fd, "  Resampling fast tracks: max %d, fast mixer load limit %d%%\n",
+                mFastTrackResampleMax, mFastTrackResampleLoadPercent);
         dprintf(fd, "  FastMixer thread %p tid=%d", mFastMixer.get(), mFastMixer->getTid());
 
         // Make a non-atomic copy of fast mixer dump state so it won't change underneath us
@@ -6504,6 +6663,7 @@ AudioFlinger::DirectOutputThread::DirectOutputThread(const sp<AudioFlinger>& aud
         const audio_offload_info_t& offloadInfo)
     :   PlaybackThread(audioFlinger, output, id, type, systemReady)
     , mOffloadInfo(offloadInfo)
+    , mBurstMax(getDirectBurstMax())
 {
     setMasterBalance(audioFlinger->getMasterBalance_l());
 }
@@ -6517,6 +6677,47 @@ void AudioFlinger::DirectOutputThread::dumpInternals_l(int fd, const Vector<Stri
     PlaybackThread::dumpInternals_l(fd, args);
     dprintf(fd, "  Master balance: %f  Left: %f  Right: %f\n",
             mMasterBalance.load(), mMasterBalanceLeft, mMasterBalanceRight);
+    if (mBurstMax > 1) {
+        dprintf(fd, "  Adaptive burst: %u/%u HAL buffers per write, %lld resets\n",
+                mBurstCount, mBurstMax, (long long)mBurstResets);
+    }
+}
+
+// Grows or clamps the number of HAL buffers written by the next threadLoop_mix()
+// for the active track, with framesReady frames available.
+void AudioFlinger::DirectOutputThread::updateBurst_l(Track *track, size_t framesReady)
+{
+    if (mBurstMax <= 1) {
+        return;
+    }
+    // Keep single HAL buffer writes while the screen is on, and whenever the audio written
+    // ahead could not be adjusted later: volume shapers and effects process the data before
+    // the write, a draining track must not be held back.
+    const bool screenOff = AudioFlinger::mScreenState & 1;
+    if (!screenOff || mVolumeShaperActive || !mEffectChains.isEmpty()
+            || track->sharedBuffer() != 0 || track->isStopping_1()) {
+        resetBurst_l();
+        return;
+    }
+    // never write more than is available: a short burst must not be padded
+    const uint32_t available = std::max(framesReady / mFrameCount, (size_t)1);
+    if (mBurstCount > available) {
+        mBurstCount = available;
+        mBurstWrites = 0;
+    } else if (mBurstCount < mBurstMax && ++mBurstWrites >= kDirectBurstGrowWrites
+            && available >= kDirectBurstHeadroom * (mBurstCount + 1)) {
+        ++mBurstCount;
+        mBurstWrites = 0;
+    }
+}
+
+void AudioFlinger::DirectOutputThread::resetBurst_l()
+{
+    if (mBurstCount > 1) {
+        ++mBurstResets;
+    }
+    mBurstCount = 1;
+    mBurstWrites = 0;
 }
 
 void AudioFlinger::DirectOutputThread::setMasterBalance(float balance)
@@ -6591,6 +6792,8 @@ void AudioFlinger::DirectOutputThread::processVolume_l(Track *track, bool lastTr
         if (left != mLeftVolFloat || right != mRightVolFloat) {
             mLeftVolFloat = left;
             mRightVolFloat = right;
+            // audio already written is played at the previous volume
+            resetBurst_l();
 
             // Delegate volume control to effect in track effect chain if needed
             // only one effect chain can be present on DirectOutputThread, so if
@@ -6676,6 +6879,9 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::DirectOutputThread::prep
                 doHwPause = true;
                 mHwPaused = true;
             }
+            if (last) {
+                resetBurst_l();
+            }
         } else if (track->isFlushPending()) {
             track->flushAck();
             if (last) {
@@ -6748,6 +6954,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::DirectOutputThread::prep
                         mBytesRemaining = 0;
                         // Invalidate previous track to force a seek when resuming.
                         previousTrack->invalidate();
+                        resetBurst_l();
                     }
                 }
                 mPreviousTrack = track;
@@ -6755,6 +6962,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::DirectOutputThread::prep
                 // reset retry count
                 track->mRetryCount = targetRetryCount;
                 mActiveTrack = t;
+                updateBurst_l(track, framesReady);
                 mixerStatus = MIXER_TRACKS_READY;
                 if (mHwPaused) {
                     doHwResume = true;
@@ -6860,7 +7068,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::DirectOutputThread::prep
 
 void AudioFlinger::DirectOutputThread::threadLoop_mix()
 {
-    size_t frameCount = mFrameCount;
+    size_t frameCount = mFrameCount * mBurstCount;
     int8_t *curBuf = (int8_t *)mSinkBuffer;
     // output audio to hardware
     while (frameCount) {
@@ -7033,6 +7241,7 @@ void AudioFlinger::DirectOutputThread::flushHw_l()
     mOutput->flush();
     mHwPaused = false;
     mFlushPending = false;
+    resetBurst_l();
     mTimestampVerifier.discontinuity(discontinuityForStandbyOrFlush());
     mTimestamp.clear();
     mMonotonicFrameCounter.onFlush();
@@ -7249,6 +7458,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::OffloadThread::prepareTr
                 mPausedWriteLength = mCurrentWriteLength;
                 mPausedBytesRemaining = mBytesRemaining;
                 mBytesRemaining = 0;    // stop writing
+                resetBurst_l();
             }
             tracksToRemove->add(track);
         } else if (track->isFlushPending()) {
@@ -7317,6 +7527,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::OffloadThread::prepareTr
                         if (previousTrack->sessionId() != track->sessionId()) {
                             previousTrack->invalidate();
                         }
+                        resetBurst_l();
                     }
                 }
                 mPreviousTrack = track;
@@ -7327,6 +7538,7 @@ AudioFlinger::PlaybackThread::mixer_state AudioFlinger::OffloadThread::prepareTr
                     track->mRetryCount = kMaxTrackRetriesOffload;
                 }
                 mActiveTrack = t;
+                updateBurst_l(track, track->framesReady());
                 mixerStatus = MIXER_TRACKS_READY;
             }
         } else {
@@ -7874,6 +8086,8 @@ AudioFlinger::RecordThread::RecordThread(const sp<AudioFlinger>& audioFlinger,
     // mFastCaptureNBLogWriter
     , mFastTrackAvail(false)
     , mBtNrecSuspended(false)
+    , mShareConversion(property_get_bool("af.record.share_conversion", true /* default_value */))
+    , mPatchZeroCopy(property_get_bool("af.patch.zero_copy", true /* default_value */))
 {
     snprintf(mThreadName, kThreadNameLength, "AudioIn_%X", id);
     mNBLogWriter = audioFlinger->newWriter_l(kLogSize, mThreadName);
@@ -8114,6 +8328,7 @@ reacquire_wakelock:
                 goto reacquire_wakelock;
             }
 
+            mStageTimes.beginPeriod();
             bool doBroadcast = false;
             bool allStopped = true;
             for (size_t i = 0; i < size; ) {
@@ -8230,6 +8445,7 @@ reacquire_wakelock:
 
             lockEffectChains_l(effectChains);
         }
+        mStageTimes.endStage(ThreadStageTimes::STAGE_PREPARE);
 
         // thread mutex is now unlocked, mActiveTracks unknown, activeTracks.size() > 0
 
@@ -8238,6 +8454,7 @@ reacquire_wakelock:
             // thread mutex is not locked, but effect chain is locked
             effectChains[i]->process_l();
         }
+        mStageTimes.endStage(ThreadStageTimes::STAGE_EFFECTS);
 
         // Push a new fast capture state if fast capture is not already running, or cblk change
         if (mFastCapture != 0) {
@@ -8307,6 +8524,10 @@ reacquire_wakelock:
         ssize_t framesRead = 0; // not needed, remove clang-tidy warning.
         const int64_t lastIoBeginNs = systemTime(); // start IO timing
 
+        // The patch record the HAL reads directly into, if any
+        sp<RecordTrack> zeroCopyTrack = getZeroCopyPatchRecord(activeTracks, effectChains);
+        uint8_t *readBuffer = (uint8_t*)mRsmpInBuffer + rear * mFrameSize;
+
         // If an NBAIO source is present, use it to read the normal capture's data
         if (mPipeSource != 0) {
             size_t framesToRead = min(mRsmpInFramesOA - rear, mRsmpInFramesP2 / 2);
@@ -8352,19 +8573,40 @@ reacquire_wakelock:
             }
         // otherwise use the HAL / AudioStreamIn directly
         } else {
+            if (zeroCopyTrack != 0) {
+                // read into the patch buffer only if a whole HAL buffer is contiguous
+                const size_t halFrames = mBufferSize / mFrameSize;
+                zeroCopyTrack->mSink.frameCount = halFrames;
+                if (zeroCopyTrack->getNextBuffer(&zeroCopyTrack->mSink) == OK
+                        && zeroCopyTrack->mSink.frameCount == halFrames) {
+                    readBuffer = (uint8_t*)zeroCopyTrack->mSink.raw;
+                } else {
+                    zeroCopyTrack->mSink.frameCount = 0;
+                    zeroCopyTrack->releaseBuffer(&zeroCopyTrack->mSink);
+                    zeroCopyTrack.clear();
+                }
+            }
             ATRACE_BEGIN("read");
             size_t bytesRead;
-            status_t result = mSource->read(
-                    (uint8_t*)mRsmpInBuffer + rear * mFrameSize, mBufferSize, &bytesRead);
+            status_t result = mSource->read(readBuffer, mBufferSize, &bytesRead);
             ATRACE_END();
             if (result < 0) {
                 framesRead = result;
             } else {
                 framesRead = bytesRead / mFrameSize;
             }
+            if (zeroCopyTrack != 0) {
+                zeroCopyTrack->mSink.frameCount = framesRead > 0 ? framesRead : 0;
+                zeroCopyTrack->releaseBuffer(&zeroCopyTrack->mSink);
+                if (framesRead > 0) {
+                    static_cast<PatchRecord*>(zeroCopyTrack.get())->addZeroCopyFrames(
+                            framesRead);
+                }
+            }
         }
 
         const int64_t lastIoEndNs = systemTime(); // end IO timing
+        mStageTimes.endStage(ThreadStageTimes::STAGE_IO);
 
         // Update server timestamp with server stats
         // systemTime() is optional if the hardware supports timestamps.
@@ -8432,10 +8674,10 @@ reacquire_wakelock:
         mFramesRead += framesRead;
 
 #ifdef TEE_SINK
-        (void)mTee.write((uint8_t*)mRsmpInBuffer + rear * mFrameSize, framesRead);
+        (void)mTee.write(readBuffer, framesRead);
 #endif
         // If destination is non-contiguous, we now correct for reading past end of buffer.
-        {
+        if (zeroCopyTrack == 0) {
             size_t part1 = mRsmpInFramesP2 - rear;
             if ((size_t) framesRead > part1) {
                 memcpy(mRsmpInBuffer, (uint8_t*)mRsmpInBuffer + mRsmpInFramesP2 * mFrameSize,
@@ -8444,8 +8686,20 @@ reacquire_wakelock:
         }
         mRsmpInRear = audio_utils::safe_add_overflow(mRsmpInRear, (int32_t)framesRead);
 
+        if (zeroCopyTrack != 0) {
+            // the frames are already delivered, mRsmpInBuffer does not have them
+            zeroCopyTrack->mResamplerBufferProvider->setFront(mRsmpInRear);
+            endTrackPeriod(zeroCopyTrack.get(), OVERRUN_FALSE, &lastWarning);
+            goto unlock;
+        }
+
         size = activeTracks.size();
 
+        // tracks with the same client configuration are converted once for all of them
+        if (mShareConversion && size > 1) {
+            convertSharedTracks(activeTracks, &lastWarning);
+        }
+
         // loop over each active track
         for (size_t i = 0; i < size; i++) {
             activeTrack = activeTracks[i];
@@ -8454,15 +8708,20 @@ reacquire_wakelock:
             if (activeTrack->isFastTrack()) {
                 continue;
             }
+            // skip tracks already delivered by convertSharedTracks()
+            if (activeTrack->mSharedConversion) {
+                continue;
+            }
+            if (activeTrack->mConverterStale) {
+                // the converter state predates the frames converted for the track by a group
+                activeTrack->mRecordBufferConverter->reset();
+                activeTrack->mConverterStale = false;
+            }
 
             // TODO: This code probably should be moved to RecordTrack.
             // TODO: Update the activeTrack buffer converter in case of reconfigure.
 
-            enum {
-                OVERRUN_UNKNOWN,
-                OVERRUN_TRUE,
-                OVERRUN_FALSE
-            } overrun = OVERRUN_UNKNOWN;
+            overrun_state_t overrun = OVERRUN_UNKNOWN;
 
             // loop over getNextBuffer to handle circular sink
             for (;;) {
@@ -8524,72 +8783,23 @@ reacquire_wakelock:
                     overrun = OVERRUN_FALSE;
                 }
 
-                if (activeTrack->mFramesToDrop == 0) {
-                    if (framesOut > 0) {
-                        activeTrack->mSink.frameCount = framesOut;
-                        // Sanitize before releasing if the track has no access to the source data
-                        // An idle UID receives silence from non virtual devices until active
-                        if (activeTrack->isSilenced()) {
-                            memset(activeTrack->mSink.raw, 0, framesOut * activeTrack->frameSize());
-                        }
-                        activeTrack->releaseBuffer(&activeTrack->mSink);
-                    }
-                } else {
-                    // FIXME could do a partial drop of framesOut
-                    if (activeTrack->mFramesToDrop > 0) {
-                        activeTrack->mFramesToDrop -= (ssize_t)framesOut;
-                        if (activeTrack->mFramesToDrop <= 0) {
-                            activeTrack->clearSyncStartEvent();
-                        }
-                    } else {
-                        activeTrack->mFramesToDrop += framesOut;
-                        if (activeTrack->mFramesToDrop >= 0 || activeTrack->mSyncStartEvent == 0 ||
-                                activeTrack->mSyncStartEvent->isCancelled()) {
-                            ALOGW("Synced record %s, session %d, trigger session %d",
-                                  (activeTrack->mFramesToDrop >= 0) ? "timed out" : "cancelled",
-                                  activeTrack->sessionId(),
-                                  (activeTrack->mSyncStartEvent != 0) ?
-                                          activeTrack->mSyncStartEvent->triggerSession() :
-                                          AUDIO_SESSION_NONE);
-                            activeTrack->clearSyncStartEvent();
-                        }
-                    }
-                }
+                releaseConvertedFrames(activeTrack.get(), framesOut);
 
                 if (framesOut == 0) {
                     break;
                 }
             }
 
-            switch (overrun) {
-            case OVERRUN_TRUE:
-                // client isn't retrieving buffers fast enough
-                if (!activeTrack->setOverflow()) {
-                    nsecs_t now = systemTime();
-                    // FIXME should lastWarning per track?
-                    if ((now - lastWarning) > kWarningThrottleNs) {
-                        ALOGW("RecordThread: buffer overflow");
-                        lastWarning = now;
-                    }
-                }
-                break;
-            case OVERRUN_FALSE:
-                activeTrack->clearOverflow();
-                break;
-            case OVERRUN_UNKNOWN:
-                break;
-            }
-
-            // update frame information and push timestamp out
-            activeTrack->updateTrackFrameInfo(
-                    activeTrack->mServerProxy->framesReleased(),
-                    mTimestamp.mPosition[ExtendedTimestamp::LOCATION_SERVER],
-                    mSampleRate, mTimestamp);
+            endTrackPeriod(activeTrack.get(), overrun, &lastWarning);
         }
 
 unlock:
         // enable changes in effect chain
         unlockEffectChains(effectChains);
+        if (mStageTimes.isEnabled()) {
+            mStageTimes.endStage(ThreadStageTimes::STAGE_MIX);
+            mStageTimes.endPeriod((int64_t)mFrameCount * NANOS_PER_SECOND / mSampleRate);
+        }
         // effectChains doesn't need to be cleared, since it is cleared by destructor at scope end
         if (audio_has_proportional_frames(mFormat)
             && loopCount == lastLoopCountRead + 1) {
@@ -9200,6 +9410,9 @@ void AudioFlinger::RecordThread::dumpInternals_l(int fd, const Vector<String16>&
 
     dprintf(fd, "  Fast capture thread: %s\n", hasFastCapture() ? "yes" : "no");
     dprintf(fd, "  Fast track available: %s\n", mFastTrackAvail ? "yes" : "no");
+    dprintf(fd, "  Shared conversion: %s, frames converted %lld copied %lld\n",
+            mShareConversion ? "enabled" : "disabled",
+            (long long)mSharedConversionFrames, (long long)mSharedDeliveredFrames);
 
     // Make a non-atomic copy of fast capture dump state so it won't change underneath us
     // while we are dumping it.  It may be inconsistent, but it won't mutate!
@@ -9379,6 +9592,231 @@ void AudioFlinger::RecordThread::ResamplerBufferProvider::releaseBuffer(
     buffer->frameCount = 0;
 }
 
+// Returns the single active patch record which takes the input as is, so that the HAL
+// can read directly into the buffer it shares with its patch track. This skips the copy
+// through mRsmpInBuffer and the per-track conversion bookkeeping. Otherwise returns 0.
+sp<AudioFlinger::RecordThread::RecordTrack> AudioFlinger::RecordThread::getZeroCopyPatchRecord(
+        const Vector<sp<RecordTrack>>& activeTracks,
+        const Vector<sp<EffectChain>>& effectChains) const
+{
+    // mRsmpInBuffer must be filled for fast capture, effects and shared audio history
+    if (!mPatchZeroCopy || mPipeSource != 0 || mSource != mInput || !effectChains.isEmpty()
+            || activeTracks.size() != 1 || mMaxSharedAudioHistoryMs != 0) {
+        return nullptr;
+    }
+    const sp<RecordTrack>& track = activeTracks[0];
+    if (!track->isPatchTrack() || track->isFastTrack() || track->isSilenced()
+            || track->mFramesToDrop != 0
+            || track->format() != mFormat || track->channelMask() != mChannelMask
+            || track->sampleRate() != mSampleRate || track->frameSize() != mFrameSize
+            // data left in mRsmpInBuffer must be delivered first
+            || track->mResamplerBufferProvider->getFront() != mRsmpInRear) {
+        return nullptr;
+    }
+    return track;
+}
+
+// Releases framesOut frames converted to the sink of a track, or drops them
+// while the track waits for its start sync event.
+void AudioFlinger::RecordThread::releaseConvertedFrames(RecordTrack *track, size_t framesOut)
+{
+    if (track->mFramesToDrop == 0) {
+        if (framesOut > 0) {
+            track->mSink.frameCount = framesOut;
+            // Sanitize before releasing if the track has no access to the source data
+            // An idle UID receives silence from non virtual devices until active
+            if (track->isSilenced()) {
+                memset(track->mSink.raw, 0, framesOut * track->frameSize());
+            }
+            track->releaseBuffer(&track->mSink);
+        }
+    } else {
+        // FIXME could do a partial drop of framesOut
+        if (track->mFramesToDrop > 0) {
+            track->mFramesToDrop -= (ssize_t)framesOut;
+            if (track->mFramesToDrop <= 0) {
+                track->clearSyncStartEvent();
+            }
+        } else {
+            track->mFramesToDrop += framesOut;
+            if (track->mFramesToDrop >= 0 || track->mSyncStartEvent == 0 ||
+                    track->mSyncStartEvent->isCancelled()) {
+                ALOGW("Synced record %s, session %d, trigger session %d",
+                      (track->mFramesToDrop >= 0) ? "timed out" : "cancelled",
+                      track->sessionId(),
+                      (track->mSyncStartEvent != 0) ?
+                              track->mSyncStartEvent->triggerSession() :
+                              AUDIO_SESSION_NONE);
+                track->clearSyncStartEvent();
+            }
+        }
+    }
+}
+
+// Updates the overflow state and the frame information of a track at the end of a period.
+void AudioFlinger::RecordThread::endTrackPeriod(
+        RecordTrack *track, overrun_state_t overrun, nsecs_t *lastWarning)
+{
+    switch (overrun) {
+    case OVERRUN_TRUE:
+        // client isn't retrieving buffers fast enough
+        if (!track->setOverflow()) {
+            nsecs_t now = systemTime();
+            // FIXME should lastWarning per track?
+            if ((now - *lastWarning) > kWarningThrottleNs) {
+                ALOGW("RecordThread: buffer overflow");
+                *lastWarning = now;
+            }
+        }
+        break;
+    case OVERRUN_FALSE:
+        track->clearOverflow();
+        break;
+    case OVERRUN_UNKNOWN:
+        break;
+    }
+
+    // update frame information and push timestamp out
+    track->updateTrackFrameInfo(
+            track->mServerProxy->framesReleased(),
+            mTimestamp.mPosition[ExtendedTimestamp::LOCATION_SERVER],
+            mSampleRate, mTimestamp);
+}
+
+// Converts once for all the tracks which have the same client configuration and are at the
+// same position in mRsmpInBuffer, e.g. several clients capturing 16 kHz mono from a 48 kHz
+// input. The group leader converts to its sink, and the result is copied to the sinks of the
+// other tracks of the group. The group advances while the leader and at least one other track
+// can take frames; a track left with room in its sink goes on with its own converter.
+//
+// The converter of a track delivered by another track's conversion is not advanced, so it is
+// reset before the track converts on its own again, as for a track start.
+void AudioFlinger::RecordThread::convertSharedTracks(
+        const Vector<sp<RecordTrack>>& activeTracks, nsecs_t *lastWarning)
+{
+    size_t groupCount = 0;
+    for (const sp<RecordTrack>& activeTrack : activeTracks) {
+        RecordTrack* const track = activeTrack.get();
+        track->mSharedConversion = false;
+        if (track->isFastTrack() || track->isDirect() || track->isPatchTrack()) {
+            continue;
+        }
+        const int32_t front = track->mResamplerBufferProvider->getFront();
+        size_t g = 0;
+        for (; g < groupCount; ++g) {
+            const RecordTrack* const leader = mShareGroups[g][0].track;
+            if (leader->mResamplerBufferProvider->getFront() == front
+                    && leader->sampleRate() == track->sampleRate()
+                    && leader->format() == track->format()
+                    && leader->channelMask() == track->channelMask()) {
+                break;
+            }
+        }
+        if (g == groupCount) {
+            if (mShareGroups.size() == groupCount) {
+                mShareGroups.emplace_back();
+            }
+            mShareGroups[groupCount++].assign(1, {track});
+            continue;
+        }
+        std::vector<SharedConversionTrack>& group = mShareGroups[g];
+        group.push_back({track});
+        // prefer a leader whose converter is up to date
+        if (group[0].track->mConverterStale && !track->mConverterStale) {
+            std::swap(group[0], group.back());
+        }
+    }
+
+    for (size_t g = 0; g < groupCount; ++g) {
+        std::vector<SharedConversionTrack>& group = mShareGroups[g];
+        if (group.size() < 2) {
+            continue;
+        }
+        RecordTrack* const leader = group[0].track;
+        if (leader->mConverterStale) {
+            leader->mRecordBufferConverter->reset();
+            leader->mConverterStale = false;
+        }
+        for (SharedConversionTrack& member : group) {
+            member.track->mSharedConversion = true;
+            member.overrun = OVERRUN_UNKNOWN;
+            member.active = true;
+        }
+
+        // loop over getNextBuffer to handle circular sinks
+        for (;;) {
+            size_t framesOut = SIZE_MAX;
+            size_t framesIn = 0;
+            size_t activeCount = 0;
+            for (SharedConversionTrack& member : group) {
+                if (!member.active) {
+                    continue;
+                }
+                RecordTrack* const track = member.track;
+                track->mSink.frameCount = ~0;
+                const status_t status = track->getNextBuffer(&track->mSink);
+                LOG_ALWAYS_FATAL_IF((status == OK) != (track->mSink.frameCount > 0));
+                bool hasOverrun;
+                track->mResamplerBufferProvider->sync(&framesIn, &hasOverrun);
+                if (hasOverrun) {
+                    member.overrun = OVERRUN_TRUE;
+                }
+                if (track->mSink.frameCount == 0 || framesIn == 0) {
+                    member.active = false;
+                    continue;
+                }
+                framesOut = std::min(framesOut, track->mSink.frameCount);
+                ++activeCount;
+            }
+            if (!group[0].active || activeCount < 2) {
+                break;
+            }
+
+            framesOut = std::min(framesOut,
+                    destinationFramesPossible(framesIn, mSampleRate, leader->mSampleRate));
+            framesOut = leader->mRecordBufferConverter->convert(
+                    leader->mSink.raw, leader->mResamplerBufferProvider, framesOut);
+            const int32_t front = leader->mResamplerBufferProvider->getFront();
+            if (framesOut > 0) {
+                mSharedConversionFrames += framesOut;
+            }
+
+            // copy before releasing, as releasing may silence the leader sink
+            for (SharedConversionTrack& member : group) {
+                RecordTrack* const track = member.track;
+                if (!member.active || track == leader) {
+                    continue;
+                }
+                memcpy(track->mSink.raw, leader->mSink.raw, framesOut * track->frameSize());
+                track->mResamplerBufferProvider->setFront(front);
+                track->mConverterStale = true;
+                mSharedDeliveredFrames += framesOut;
+            }
+            for (SharedConversionTrack& member : group) {
+                if (!member.active) {
+                    continue;
+                }
+                if (framesOut > 0 && member.overrun == OVERRUN_UNKNOWN) {
+                    member.overrun = OVERRUN_FALSE;
+                }
+                releaseConvertedFrames(member.track, framesOut);
+            }
+            if (framesOut == 0) {
+                break;
+            }
+        }
+
+        for (const SharedConversionTrack& member : group) {
+            if (member.active) {
+                // more frames fit in the sink, the threadLoop() track loop continues
+                member.track->mSharedConversion = false;
+            } else {
+                endTrackPeriod(member.track, member.overrun, lastWarning);
+            }
+        }
+    }
+}
+
 void AudioFlinger::RecordThread::checkBtNrec()
 {
     Mutex::Autolock _l(mLock);
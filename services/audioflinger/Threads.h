@@ -646,6 +646,8 @@ protected:
 
                 const sp<AudioFlinger>  mAudioFlinger;
                 ThreadMetrics           mThreadMetrics;
+                // Per period stage timing, enabled by "af.thread.stage_timing".
+                ThreadStageTimes        mStageTimes;
                 const bool              mIsOut;
 
                 // updated by PlaybackThread::readOutputParameters_l() or
@@ -1252,7 +1254,12 @@ private:
     // PlaybackThread needs to find out if master-muted, it checks it's local
     // copy rather than the one in AudioFlinger.  This optimization saves a lock.
     bool                            mMasterMute;
-                void        setMasterMute_l(bool muted) { mMasterMute = muted; }
+                void        setMasterMute_l(bool muted) {
+                                mMasterMute = muted;
+                                mVolumeState.modify([muted](VolumeState& vs) {
+                                    vs.masterMute = muted;
+                                });
+                            }
 
                 auto discontinuityForStandbyOrFlush() const { // call on threadLoop or with lock.
                     return ((mType == DIRECT && !audio_is_linear_pcm(mFormat))
@@ -1369,9 +1376,27 @@ private:
 
     Tracks<Track>                   mTracks;
 
+    // mStreamTypes, mMasterVolume and mMasterMute are the copies applied by the thread loop.
+    // They are refreshed from mVolumeState by updateVolumeState_l() before each
+    // prepareTracks_l(), so that the binder threads setting volumes don't take mLock.
     stream_type_t                   mStreamTypes[AUDIO_STREAM_CNT];
     AudioStreamOut                  *mOutput;
 
+    struct VolumeState {
+        stream_type_t               streamTypes[AUDIO_STREAM_CNT];
+        float                       masterVolume;
+        bool                        masterMute;
+    };
+    StateSnapshot<VolumeState>      mVolumeState;
+    uint32_t                        mVolumeStateEpoch = 0;  // epoch last applied
+
+                void        updateVolumeState_l();
+                // wakes the thread loop after a volume change if mLock is available.
+                void        signalVolumeChange();
+    // set in constructor, the HAL applies master volume or mute itself.
+    bool                            mHalMasterVolume = false;
+    bool                            mHalMasterMute = false;
+
     float                           mMasterVolume;
     std::atomic<float>              mMasterBalance{};
     audio_utils::Balance            mBalance;
@@ -1455,6 +1480,11 @@ private:
 
 public:
     virtual     bool        hasFastMixer() const = 0;
+                // Returns true if a new fast track at sampleRate may be resampled by the
+                // fast mixer. Takes the thread lock.
+    virtual     bool        isFastTrackResamplingAllowed(uint32_t sampleRate __unused) {
+                                return false;
+                            }
     virtual     FastTrackUnderruns getFastTrackUnderruns(size_t fastIndex __unused) const
                                 { FastTrackUnderruns dummy; return dummy; }
                 const std::atomic<int64_t>& framesWritten() const { return mFramesWritten; }
@@ -1578,6 +1608,12 @@ private:
                 // one-time initialization, no locks required
                 sp<FastMixer>     mFastMixer;     // non-0 if there is also a fast mixer
                 sp<AudioWatchdog> mAudioWatchdog; // non-0 if there is an audio watchdog thread
+                // helper threads for the parallel sub-mix, null if disabled
+                std::unique_ptr<SubmixThreadPool> mSubmixThreadPool;
+                size_t            mSubmixTrackThreshold = 0;
+                // resampling fast tracks, see isFastTrackResamplingAllowed()
+                int32_t           mFastTrackResampleMax = 0;
+                int32_t           mFastTrackResampleLoadPercent = 0;
 
                 // contents are not guaranteed to be consistent, no locks required
                 FastMixerDumpState mFastMixerDumpState;
@@ -1594,6 +1630,7 @@ private:
                 std::atomic_bool mMasterMono;
 public:
     virtual     bool        hasFastMixer() const { return mFastMixer != 0; }
+                bool        isFastTrackResamplingAllowed(uint32_t sampleRate) override;
     virtual     FastTrackUnderruns getFastTrackUnderruns(size_t fastIndex) const {
                               ALOG_ASSERT(fastIndex < FastMixerState::sMaxFastTracks);
                               return mFastMixerDumpState.mTracks[fastIndex].mUnderruns;
@@ -1685,6 +1722,17 @@ protected:
     void processVolume_l(Track *track, bool lastTrack);
     bool isTunerStream() const { return (mOffloadInfo.content_id > 0); }
 
+    // Adaptive burst sizing: threadLoop_mix() writes mBurstCount HAL buffers at once.
+    // updateBurst_l() is called for the active track each period,
+    // resetBurst_l() on latency sensitive events.
+    void updateBurst_l(Track *track, size_t framesReady);
+    void resetBurst_l();
+
+    const uint32_t          mBurstMax;          // 1 if adaptive burst sizing is disabled
+    uint32_t                mBurstCount = 1;    // 1 <= mBurstCount <= mBurstMax
+    uint32_t                mBurstWrites = 0;   // writes since mBurstCount last changed
+    int64_t                 mBurstResets = 0;   // for dump
+
     // prepareTracks_l() tells threadLoop_mix() the name of the single active track
     sp<Track>               mActiveTrack;
 
@@ -2067,6 +2115,22 @@ private:
             int32_t getOldestFront_l();
             void    updateFronts_l(int32_t offset);
 
+            // overrun state of a track over a threadLoop() period
+            enum overrun_state_t {
+                OVERRUN_UNKNOWN,
+                OVERRUN_TRUE,
+                OVERRUN_FALSE
+            };
+
+            // threadLoop() conversion to the record tracks
+            void    releaseConvertedFrames(RecordTrack *track, size_t framesOut);
+            void    endTrackPeriod(RecordTrack *track, overrun_state_t overrun,
+                                   nsecs_t *lastWarning);
+            void    convertSharedTracks(const Vector<sp<RecordTrack>>& activeTracks,
+                                        nsecs_t *lastWarning);
+            sp<RecordTrack> getZeroCopyPatchRecord(const Vector<sp<RecordTrack>>& activeTracks,
+                                        const Vector<sp<EffectChain>>& effectChains) const;
+
             AudioStreamIn                       *mInput;
             Source                              *mSource;
             SortedVector < sp<RecordTrack> >    mTracks;
@@ -2137,6 +2201,23 @@ private:
             std::string                         mSharedAudioPackageName = {};
             int32_t                             mSharedAudioStartFrames = -1;
             audio_session_t                     mSharedAudioSessionId = AUDIO_SESSION_NONE;
+
+            // Conversion sharing, see convertSharedTracks(), accessible only within the
+            // threadLoop() except for dumpsys.
+            struct SharedConversionTrack {
+                RecordTrack        *track;
+                overrun_state_t     overrun = OVERRUN_UNKNOWN;
+                bool                active = false;  // sink has room and input is available
+            };
+            const bool                          mShareConversion;
+            // groups of tracks with the same conversion, the first track is the leader.
+            // Kept across periods to avoid allocation.
+            std::vector<std::vector<SharedConversionTrack>> mShareGroups;
+            int64_t                             mSharedConversionFrames = 0; // converted by leaders
+            int64_t                             mSharedDeliveredFrames = 0;  // copied to others
+
+            // software patch records may be read into directly, see getZeroCopyPatchRecord()
+            const bool                          mPatchZeroCopy;
 };
 
 class MmapThread : public ThreadBase
@@ -95,6 +95,13 @@ public:
         API_OUTPUT_TELEPHONY_TX, // used for playback to telephony TX path
     } output_type_t;
 
+    // A device connection state change, see setDeviceConnectionStates()
+    struct DeviceConnectionChange {
+        audio_policy_dev_state_t state;
+        android::media::audio::common::AudioPort port;
+        audio_format_t encodedFormat;
+    };
+
 public:
     virtual ~AudioPolicyInterface() {}
     //
@@ -109,6 +116,11 @@ public:
     virtual status_t setDeviceConnectionState(audio_policy_dev_state_t state,
                                               const android::media::audio::common::AudioPort& port,
                                               audio_format_t encodedFormat) = 0;
+    // indicate changes in the connection status of several devices. Routing is updated
+    // and outputs are opened or closed once, after all the changes are applied.
+    // The changes that fail are skipped and the first error is returned.
+    virtual status_t setDeviceConnectionStates(
+            const std::vector<DeviceConnectionChange>& changes) = 0;
     // retrieve a device connection status
     virtual audio_policy_dev_state_t getDeviceConnectionState(audio_devices_t device,
                                                               const char *device_address) = 0;
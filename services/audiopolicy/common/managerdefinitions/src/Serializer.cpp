@@ -17,12 +17,15 @@
 #define LOG_TAG "APM::Serializer"
 //#define LOG_NDEBUG 0
 
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <libxml/parser.h>
+#include <libxml/uri.h>
 #include <libxml/xinclude.h>
 #include <media/convert.h>
 #include <cutils/properties.h>
@@ -185,7 +188,23 @@ struct ModuleTraits : public AndroidCollectionTraits<HwModule, HwModuleCollectio
         static constexpr const char *version = "halVersion";
     };
 
-    typedef AudioPolicyConfig *PtrSerializingCtx;
+    // The devices that a module adds to the configuration. They are collected while the module
+    // is deserialized and added in module order, so modules can be deserialized concurrently.
+    struct ConfigDevices {
+        std::vector<sp<DeviceDescriptor>> attachedDevices;
+        sp<DeviceDescriptor> defaultOutputDevice;
+
+        void addTo(AudioPolicyConfig *config) const {
+            for (const auto& device : attachedDevices) {
+                config->addDevice(device);
+            }
+            if (defaultOutputDevice != 0 && config->getDefaultOutputDevice() == 0) {
+                config->setDefaultOutputDevice(defaultOutputDevice);
+                ALOGV("%s: default is %08x", __func__, defaultOutputDevice->type());
+            }
+        }
+    };
+    typedef ConfigDevices *PtrSerializingCtx;
 
     // Children: mixPortTraits, devicePortTraits, and routeTraits
     // Need to call deserialize on each child
@@ -242,6 +261,10 @@ public:
     std::variant<status_t, typename Trait::Element> deserialize(const xmlNode *cur,
             typename Trait::PtrSerializingCtx serializingContext);
 
+    // Deserializes the modules of the configuration concurrently, one thread per module.
+    status_t deserializeModules(const xmlNode *root, ModuleTraits::Collection *modules,
+            AudioPolicyConfig *config);
+
 private:
     static constexpr const char *rootName = "audioPolicyConfiguration";
     static constexpr const char *versionAttribute = "version";
@@ -312,6 +335,85 @@ const xmlNode* getReference(const xmlNode *cur, const std::string &refName)
     return NULL;
 }
 
+static constexpr const char *kXIncludeNamespace = "http://www.w3.org/2001/XInclude";
+
+// Returns the path of the file of a plain <xi:include href="..."/> element, without fallback
+// or other attributes, or an empty string for other nodes.
+std::string getXIncludePath(xmlDoc *doc, const xmlNode *cur)
+{
+    if (cur->type != XML_ELEMENT_NODE || cur->ns == NULL
+            || xmlStrcmp(cur->ns->href, reinterpret_cast<const xmlChar*>(kXIncludeNamespace))
+            || xmlStrcmp(cur->name, reinterpret_cast<const xmlChar*>("include"))) {
+        return "";
+    }
+    for (const xmlNode *child = cur->children; child != NULL; child = child->next) {
+        if (child->type == XML_ELEMENT_NODE) return "";
+    }
+    for (const xmlAttr *attr = cur->properties; attr != NULL; attr = attr->next) {
+        if (xmlStrcmp(attr->name, reinterpret_cast<const xmlChar*>("href"))) return "";
+    }
+    auto href = make_xmlUnique(xmlGetProp(cur, reinterpret_cast<const xmlChar*>("href")));
+    if (href == nullptr) return "";
+    auto base = make_xmlUnique(xmlNodeGetBase(doc, cur));
+    auto uri = make_xmlUnique(xmlBuildURI(href.get(), base.get()));
+    if (uri == nullptr) return "";
+    std::string path(reinterpret_cast<const char*>(uri.get()));
+    // Only local files are loaded here, libxml resolves the others.
+    return path.find("://") == std::string::npos ? path : "";
+}
+
+std::string dirName(const std::string& path)
+{
+    return path.substr(0, path.rfind('/') + 1);
+}
+
+void findXIncludes(xmlDoc *doc, xmlNode *cur,
+        std::vector<std::pair<xmlNode*, std::string>> *found)
+{
+    for (; cur != NULL; cur = cur->next) {
+        if (std::string path = getXIncludePath(doc, cur); !path.empty()) {
+            found->emplace_back(cur, std::move(path));
+        } else if (cur->type == XML_ELEMENT_NODE) {
+            findXIncludes(doc, cur->children, found);
+        }
+    }
+}
+
+// Parses the files included by the plain XInclude elements of the document concurrently and
+// replaces the elements by the root element of the files. The includes that are not handled
+// here, including the ones of the included files, are left to xmlXIncludeProcess().
+void loadXIncludes(xmlDoc *doc)
+{
+    std::vector<std::pair<xmlNode*, std::string>> includes;
+    findXIncludes(doc, xmlDocGetRootElement(doc), &includes);
+    if (includes.size() < 2) return;
+
+    std::vector<std::future<xmlDoc*>> includedDocs;
+    for (const auto& include : includes) {
+        includedDocs.push_back(std::async(std::launch::async, [path = include.second]() {
+            return xmlParseFile(path.c_str());
+        }));
+    }
+    for (size_t i = 0; i < includes.size(); i++) {
+        auto includedDoc = make_xmlUnique(includedDocs[i].get());
+        xmlNode *includedRoot =
+                includedDoc != nullptr ? xmlDocGetRootElement(includedDoc.get()) : NULL;
+        if (includedRoot == NULL) {
+            // Let xmlXIncludeProcess() report the error.
+            continue;
+        }
+        xmlNode *copy = xmlDocCopyNode(includedRoot, doc, 1 /*recursive*/);
+        if (copy == NULL) continue;
+        // Relative includes of the included file are resolved from its own location.
+        const std::string& path = includes[i].second;
+        if (doc->URL == NULL
+                || dirName(path) != dirName(reinterpret_cast<const char*>(doc->URL))) {
+            xmlNodeSetBase(copy, reinterpret_cast<const xmlChar*>(path.c_str()));
+        }
+        xmlFreeNode(xmlReplaceNode(includes[i].first, copy));
+    }
+}
+
 template <class Trait>
 status_t PolicySerializer::deserializeCollection(const xmlNode *cur,
         typename Trait::Collection *collection,
@@ -753,7 +855,7 @@ std::variant<status_t, ModuleTraits::Element> PolicySerializer::deserialize<Modu
                                     reinterpret_cast<const char*>(attachedDevice.get()));
                             continue;
                         }
-                        ctx->addDevice(device);
+                        ctx->attachedDevices.push_back(device);
                     }
                 }
             }
@@ -767,10 +869,8 @@ std::variant<status_t, ModuleTraits::Element> PolicySerializer::deserialize<Modu
                         reinterpret_cast<const char*>(defaultOutputDevice.get()));
                 sp<DeviceDescriptor> device = module->getDeclaredDevices().getDeviceFromTagName(
                         std::string(reinterpret_cast<const char*>(defaultOutputDevice.get())));
-                if (device != 0 && ctx->getDefaultOutputDevice() == 0) {
-                    ctx->setDefaultOutputDevice(device);
-                    ALOGV("%s: default is %08x",
-                            __func__, ctx->getDefaultOutputDevice()->type());
+                if (device != 0 && ctx->defaultOutputDevice == 0) {
+                    ctx->defaultOutputDevice = device;
                 }
             }
         }
@@ -861,6 +961,47 @@ PolicySerializer::deserialize<SurroundSoundFormatTraits>(
     return pair;
 }
 
+status_t PolicySerializer::deserializeModules(const xmlNode *root,
+        ModuleTraits::Collection *modules, AudioPolicyConfig *config)
+{
+    std::vector<const xmlNode*> moduleNodes;
+    for (const xmlNode *cur = root->xmlChildrenNode; cur != NULL; cur = cur->next) {
+        if (xmlStrcmp(cur->name, reinterpret_cast<const xmlChar*>(ModuleTraits::collectionTag))) {
+            continue;
+        }
+        for (const xmlNode *child = cur->xmlChildrenNode; child != NULL; child = child->next) {
+            if (!xmlStrcmp(child->name, reinterpret_cast<const xmlChar*>(ModuleTraits::tag))) {
+                moduleNodes.push_back(child);
+            }
+        }
+    }
+    // The document is only read while the modules are deserialized, which libxml allows
+    // from several threads.
+    const auto policy = moduleNodes.size() > 1 ? std::launch::async : std::launch::deferred;
+    std::vector<ModuleTraits::ConfigDevices> moduleDevices(moduleNodes.size());
+    std::vector<std::future<std::variant<status_t, ModuleTraits::Element>>> maybeModules;
+    for (size_t i = 0; i < moduleNodes.size(); i++) {
+        maybeModules.push_back(std::async(policy, [this, node = moduleNodes[i],
+                devices = &moduleDevices[i]]() {
+            return deserialize<ModuleTraits>(node, devices);
+        }));
+    }
+    status_t status = NO_ERROR;
+    for (size_t i = 0; i < maybeModules.size(); i++) {
+        auto maybeModule = maybeModules[i].get();
+        // Ignore modules that failed to parse, as deserializeCollection() does
+        if (maybeModule.index() != 1 || status != NO_ERROR) continue;
+        status = ModuleTraits::addElementToCollection(std::get<1>(maybeModule), modules);
+        if (status != NO_ERROR) {
+            ALOGE("%s: could not add element to %s collection", __func__,
+                    ModuleTraits::collectionTag);
+            continue;
+        }
+        moduleDevices[i].addTo(config);
+    }
+    return status;
+}
+
 status_t PolicySerializer::deserialize(const char *configFile, AudioPolicyConfig *config,
                                        bool ignoreVendorExtensions)
 {
@@ -875,6 +1016,7 @@ status_t PolicySerializer::deserialize(const char *configFile, AudioPolicyConfig
         ALOGE("%s: Could not parse %s document: empty.", __func__, configFile);
         return BAD_VALUE;
     }
+    loadXIncludes(doc.get());
     if (xmlXIncludeProcess(doc.get()) < 0) {
         ALOGE("%s: libxml failed to resolve XIncludes on %s document.", __func__, configFile);
     }
@@ -900,7 +1042,7 @@ status_t PolicySerializer::deserialize(const char *configFile, AudioPolicyConfig
     // Let's deserialize children
     // Modules
     ModuleTraits::Collection modules;
-    status_t status = deserializeCollection<ModuleTraits>(root, &modules, config);
+    status_t status = deserializeModules(root, &modules, config);
     if (status != NO_ERROR) {
         return status;
     }
@@ -924,8 +1066,10 @@ status_t PolicySerializer::deserialize(const char *configFile, AudioPolicyConfig
 		    a2dpFileName = "/system/etc/sysbta_audio_policy_configuration_7_0.xml";
 	    auto doc = make_xmlUnique(xmlParseFile(a2dpFileName));
 	    xmlNodePtr root = xmlDocGetRootElement(doc.get());
-	    auto maybeA2dpModule = deserialize<ModuleTraits>(root, config);
+	    ModuleTraits::ConfigDevices a2dpDevices;
+	    auto maybeA2dpModule = deserialize<ModuleTraits>(root, &a2dpDevices);
 	    modules.add(std::get<1>(maybeA2dpModule));
+	    a2dpDevices.addTo(config);
     }
 
     config->setHwModules(modules);
@@ -322,7 +322,7 @@ DeviceVector Engine::getDevicesForProductStrategy(product_strategy_t ps) const
 {
     DeviceVector selectedDevices = {};
     DeviceVector disabledDevices = {};
-    const auto productStrategies = getProductStrategies();
+    const auto &productStrategies = getProductStrategies();
     if (productStrategies.find(ps) == productStrategies.end()) {
         ALOGE("%s: Trying to get device on invalid strategy %d", __FUNCTION__, ps);
         return selectedDevices;
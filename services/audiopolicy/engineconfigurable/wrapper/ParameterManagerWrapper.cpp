@@ -155,7 +155,7 @@ status_t ParameterManagerWrapper::addCriterion(const std::string &name, bool isI
             ALOGE("%s; trying to apply invalid default literal value (%s)", __FUNCTION__,
                   defaultValue.c_str());
         }
-        criterion->setCriterionState(numericalValue);
+        setCriterionState(criterion, numericalValue);
     }
     return NO_ERROR;
 }
@@ -216,7 +216,7 @@ status_t ParameterManagerWrapper::setPhoneState(audio_mode_t mode)
     if (!isValueValidForCriterion(criterion, static_cast<int>(mode))) {
         return BAD_VALUE;
     }
-    criterion->setCriterionState((int)(mode));
+    setCriterionState(criterion, (int)(mode));
     applyPlatformConfiguration();
     return NO_ERROR;
 }
@@ -249,7 +249,7 @@ status_t ParameterManagerWrapper::setForceUse(audio_policy_force_use_t usage,
     if (!isValueValidForCriterion(criterion, static_cast<int>(config))) {
         return BAD_VALUE;
     }
-    criterion->setCriterionState((int)config);
+    setCriterionState(criterion, (int)config);
     applyPlatformConfiguration();
     return NO_ERROR;
 }
@@ -307,7 +307,7 @@ status_t ParameterManagerWrapper::setDeviceConnectionState(
     else {
         currentValueMask &= ~deviceAddressId;
     }
-    criterion->setCriterionState(currentValueMask);
+    setCriterionState(criterion, currentValueMask);
     return NO_ERROR;
 }
 
@@ -319,7 +319,7 @@ status_t ParameterManagerWrapper::setAvailableInputDevices(const DeviceTypeSet &
         ALOGE("%s: no criterion found for %s", __func__, gInputDeviceCriterionName);
         return DEAD_OBJECT;
     }
-    criterion->setCriterionState(convertDeviceTypesToCriterionValue(types));
+    setCriterionState(criterion, convertDeviceTypesToCriterionValue(types));
     applyPlatformConfiguration();
     return NO_ERROR;
 }
@@ -332,14 +332,30 @@ status_t ParameterManagerWrapper::setAvailableOutputDevices(const DeviceTypeSet
         ALOGE("%s: no criterion found for %s", __func__, gOutputDeviceCriterionName);
         return DEAD_OBJECT;
     }
-    criterion->setCriterionState(convertDeviceTypesToCriterionValue(types));
+    setCriterionState(criterion, convertDeviceTypesToCriterionValue(types));
     applyPlatformConfiguration();
     return NO_ERROR;
 }
 
+template <typename T>
+void ParameterManagerWrapper::setCriterionState(ISelectionCriterionInterface *criterion, T state)
+{
+    const auto previousState = criterion->getCriterionState();
+    criterion->setCriterionState(state);
+    mCriteriaChanged |= criterion->getCriterionState() != previousState;
+}
+
 void ParameterManagerWrapper::applyPlatformConfiguration()
 {
+    // The rules only depend on the criteria: if none changed, the parameter framework would
+    // evaluate all the rules only to select the configurations which are already applied.
+    if (!mCriteriaChanged) {
+        ALOGV("%s: criteria unchanged, configuration not reapplied", __func__);
+        return;
+    }
     mPfwConnector->applyConfigurations();
+    // Nothing is applied until the parameter framework is started.
+    mCriteriaChanged = !isStarted();
 }
 
 uint64_t ParameterManagerWrapper::convertDeviceTypeToCriterionValue(audio_devices_t type) const {
@@ -160,6 +160,16 @@ private:
      */
     void applyPlatformConfiguration();
 
+    /**
+     * Set the state of a criterion, and record whether it changed so that
+     * applyPlatformConfiguration() only applies the configuration when a criterion changed.
+     *
+     * @param[in] criterion to set.
+     * @param[in] state new state of the criterion.
+     */
+    template <typename T>
+    void setCriterionState(ISelectionCriterionInterface *criterion, T state);
+
      /**
      * Retrieve an element from a map by its name.
      *
@@ -205,6 +215,7 @@ private:
     bool isValueValidForCriterion(ISelectionCriterionInterface *criterion, int valueToCheck);
 
     Criteria mPolicyCriteria; /**< Policy Criterion Map. */
+    bool mCriteriaChanged = true; /**< A criterion changed since the last applied configuration. */
 
     CParameterMgrPlatformConnector *mPfwConnector; /**< Policy Parameter Manager connector. */
     ParameterMgrPlatformConnectorLogger *mPfwConnectorLogger; /**< Policy PFW logger. */
@@ -100,6 +100,30 @@ status_t AudioPolicyManager::setDeviceConnectionState(audio_policy_dev_state_t s
     return status;
 }
 
+status_t AudioPolicyManager::setDeviceConnectionStates(
+        const std::vector<DeviceConnectionChange>& changes) {
+    ALOGV("%s() %zu changes", __func__, changes.size());
+    DeviceConnectionRouting routing;
+    status_t status = NO_ERROR;
+    for (const auto& change : changes) {
+        sp<DeviceDescriptor> device;
+        status_t changeStatus = getDeviceForConnectionChange(
+                change.state, change.port, change.encodedFormat, &device);
+        if (changeStatus == NO_ERROR) {
+            changeStatus = applyDeviceConnectionState(device, change.state, routing);
+        }
+        if (changeStatus != NO_ERROR) {
+            ALOGW("%s() failed to set state %d for port %s: %d", __func__, change.state,
+                    change.port.toString().c_str(), changeStatus);
+            if (status == NO_ERROR) status = changeStatus;
+        }
+    }
+    // the changes that succeeded are kept even if others failed
+    updateRoutingForDeviceConnections(routing);
+    nextAudioPortGeneration();
+    return status;
+}
+
 status_t AudioPolicyManager::setDeviceConnectionState(audio_devices_t device,
                                                       audio_policy_dev_state_t state,
                                                       const char* device_address,
@@ -130,6 +154,17 @@ void AudioPolicyManager::broadcastDeviceConnectionState(const sp<DeviceDescripto
 status_t AudioPolicyManager::setDeviceConnectionStateInt(
         audio_policy_dev_state_t state, const android::media::audio::common::AudioPort& port,
         audio_format_t encodedFormat) {
+    sp<DeviceDescriptor> device;
+    if (status_t status = getDeviceForConnectionChange(state, port, encodedFormat, &device);
+            status != NO_ERROR) {
+        return status;
+    }
+    return setDeviceConnectionStateInt(device, state);
+}
+
+status_t AudioPolicyManager::getDeviceForConnectionChange(
+        audio_policy_dev_state_t state, const android::media::audio::common::AudioPort& port,
+        audio_format_t encodedFormat, sp<DeviceDescriptor>* device) {
     if (port.ext.getTag() != AudioPortExt::device) {
         return BAD_VALUE;
     }
@@ -145,16 +180,16 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(
     if (!audio_is_output_device(device_type) && !audio_is_input_device(device_type))
         return BAD_VALUE;
 
-    sp<DeviceDescriptor> device = mHwModules.getDeviceDescriptor(
+    *device = mHwModules.getDeviceDescriptor(
             device_type, device_address.c_str(), device_name, encodedFormat,
             state == AUDIO_POLICY_DEVICE_STATE_AVAILABLE);
-    if (device == nullptr) {
+    if (*device == nullptr) {
         return INVALID_OPERATION;
     }
     if (state == AUDIO_POLICY_DEVICE_STATE_AVAILABLE) {
-        device->setExtraAudioDescriptors(port.extraAudioDescriptors);
+        (*device)->setExtraAudioDescriptors(port.extraAudioDescriptors);
     }
-    return setDeviceConnectionStateInt(device, state);
+    return NO_ERROR;
 }
 
 status_t AudioPolicyManager::setDeviceConnectionStateInt(audio_devices_t deviceType,
@@ -174,6 +209,18 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(audio_devices_t deviceT
 
 status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescriptor> &device,
                                                          audio_policy_dev_state_t state)
+{
+    DeviceConnectionRouting routing;
+    status_t status = applyDeviceConnectionState(device, state, routing);
+    if (status == NO_ERROR) {
+        updateRoutingForDeviceConnections(routing);
+    }
+    return status;
+}
+
+status_t AudioPolicyManager::applyDeviceConnectionState(const sp<DeviceDescriptor> &device,
+                                                        audio_policy_dev_state_t state,
+                                                        DeviceConnectionRouting &routing)
 {
     // handle output devices
     if (audio_is_output_device(device->type())) {
@@ -181,11 +228,14 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescript
 
         ssize_t index = mAvailableOutputDevices.indexOf(device);
 
-        // save a copy of the opened output descriptors before any output is opened or closed
-        // by checkOutputsForDevice(). This will be needed by checkOutputForAllStrategies()
-        mPreviousOutputs = mOutputs;
+        if (!routing.outputDevicesChanged) {
+            // save a copy of the opened output descriptors before any output is opened or
+            // closed by checkOutputsForDevice(). This will be needed by
+            // checkOutputForAllStrategies()
+            mPreviousOutputs = mOutputs;
 
-        bool wasLeUnicastActive = isLeUnicastActive();
+            routing.wasLeUnicastActive = isLeUnicastActive();
+        }
 
         switch (state)
         {
@@ -219,6 +269,11 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescript
             // Populate encapsulation information when a output device is connected.
             device->setEncapsulationInfoFromHal(mpClientInterface);
 
+            // the device may have been disconnected earlier in the same set of changes
+            if (routing.disconnectedDevices.contains(device)) {
+                routing.disconnectedDevices.remove(device);
+            }
+
             // outputs should never be empty here
             ALOG_ASSERT(outputs.size() != 0, "setDeviceConnectionState():"
                     "checkOutputsForDevice() returned no outputs but status OK");
@@ -284,88 +339,20 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescript
             }
         }
 
-        auto checkCloseOutputs = [&]() {
-            // outputs must be closed after checkOutputForAllStrategies() is executed
-            if (!outputs.isEmpty()) {
-                for (audio_io_handle_t output : outputs) {
-                    sp<SwAudioOutputDescriptor> desc = mOutputs.valueFor(output);
-                    // close unused outputs after device disconnection or direct outputs that have
-                    // been opened by checkOutputsForDevice() to query dynamic parameters
-                    // "outputs" vector never contains duplicated outputs
-                    if ((state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE)
-                            || (((desc->mFlags & AUDIO_OUTPUT_FLAG_DIRECT) != 0) &&
-                                (desc->mDirectOpenCount == 0))
-                            || (((desc->mFlags & AUDIO_OUTPUT_FLAG_SPATIALIZER) != 0) &&
-                                !isOutputOnlyAvailableRouteToSomeDevice(desc))) {
-                        clearAudioSourcesForOutput(output);
-                        closeOutput(output);
-                    }
-                }
-                // check A2DP again after closing A2DP output to reset mA2dpSuspended if needed
-                return true;
-            }
-            return false;
-        };
-
-        if (doCheckForDeviceAndOutputChanges) {
-            checkForDeviceAndOutputChanges(checkCloseOutputs);
-        } else {
-            checkCloseOutputs();
-        }
-        (void)updateCallRouting(false /*fromCache*/);
-        const DeviceVector msdOutDevices = getMsdAudioOutDevices();
-        const DeviceVector activeMediaDevices =
-                mEngine->getActiveMediaDevices(mAvailableOutputDevices);
-        std::map<audio_io_handle_t, DeviceVector> outputsToReopenWithDevices;
-        for (size_t i = 0; i < mOutputs.size(); i++) {
-            sp<SwAudioOutputDescriptor> desc = mOutputs.valueAt(i);
-            if (desc->isActive() && ((mEngine->getPhoneState() != AUDIO_MODE_IN_CALL) ||
-                (desc != mPrimaryOutput))) {
-                DeviceVector newDevices = getNewOutputDevices(desc, true /*fromCache*/);
-                // do not force device change on duplicated output because if device is 0, it will
-                // also force a device 0 for the two outputs it is duplicated to which may override
-                // a valid device selection on those outputs.
-                bool force = (msdOutDevices.isEmpty() || msdOutDevices != desc->devices())
-                        && !desc->isDuplicated()
-                        && (!device_distinguishes_on_address(device->type())
-                                // always force when disconnecting (a non-duplicated device)
-                                || (state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE));
-                if (desc->mUsePreferredMixerAttributes && newDevices != desc->devices()) {
-                    // If the device is using preferred mixer attributes, the output need to reopen
-                    // with default configuration when the new selected devices are different from
-                    // current routing devices
-                    outputsToReopenWithDevices.emplace(mOutputs.keyAt(i), newDevices);
-                    continue;
-                }
-                setOutputDevices(desc, newDevices, force, 0);
-            }
-            if (!desc->isDuplicated() && desc->mProfile->hasDynamicAudioProfile() &&
-                    !activeMediaDevices.empty() && desc->devices() != activeMediaDevices &&
-                    desc->supportsDevicesForPlayback(activeMediaDevices)) {
-                // Reopen the output to query the dynamic profiles when there is not active
-                // clients or all active clients will be rerouted. Otherwise, set the flag
-                // `mPendingReopenToQueryProfiles` in the SwOutputDescriptor so that the output
-                // can be reopened to query dynamic profiles when all clients are inactive.
-                if (areAllActiveTracksRerouted(desc)) {
-                    outputsToReopenWithDevices.emplace(mOutputs.keyAt(i), activeMediaDevices);
-                } else {
-                    desc->mPendingReopenToQueryProfiles = true;
-                }
-            }
-            if (!desc->supportsDevicesForPlayback(activeMediaDevices)) {
-                // Clear the flag that previously set for re-querying profiles.
-                desc->mPendingReopenToQueryProfiles = false;
-            }
-        }
-        reopenOutputsWithDevices(outputsToReopenWithDevices);
-
+        for (audio_io_handle_t output : outputs) {
+            routing.outputs.emplace_back(output, state);
+        }
+        routing.outputDevicesChanged = true;
+        routing.checkOutputRouting |= doCheckForDeviceAndOutputChanges;
+        // do not force device change on duplicated output because if device is 0, it will
+        // also force a device 0 for the two outputs it is duplicated to which may override
+        // a valid device selection on those outputs.
+        routing.forceOutputRouting |= !device_distinguishes_on_address(device->type())
+                // always force when disconnecting (a non-duplicated device)
+                || (state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE);
         if (state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE) {
-            cleanUpForDevice(device);
+            routing.disconnectedDevices.add(device);
         }
-
-        checkLeBroadcastRoutes(wasLeUnicastActive, nullptr, 0);
-
-        mpClientInterface->onAudioPortListUpdate();
         return NO_ERROR;
     }  // end if is output device
 
@@ -398,6 +385,9 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescript
 
                 return INVALID_OPERATION;
             }
+            if (routing.disconnectedDevices.contains(device)) {
+                routing.disconnectedDevices.remove(device);
+            }
 
         } break;
 
@@ -433,27 +423,127 @@ status_t AudioPolicyManager::setDeviceConnectionStateInt(const sp<DeviceDescript
         // Propagate device availability to Engine
         setEngineDeviceConnectionState(device, state);
 
+        routing.inputDevicesChanged = true;
+        if (state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE) {
+            routing.disconnectedDevices.add(device);
+        }
+        return NO_ERROR;
+    } // end if is input device
+
+    ALOGW("%s() invalid device: %s", __func__, device->toString().c_str());
+    return BAD_VALUE;
+}
+
+void AudioPolicyManager::updateRoutingForDeviceConnections(const DeviceConnectionRouting &routing)
+{
+    if (!routing.outputDevicesChanged && !routing.inputDevicesChanged) {
+        return;
+    }
+    if (routing.inputDevicesChanged) {
         checkCloseInputs();
+    }
+    if (routing.outputDevicesChanged) {
+        auto checkCloseOutputs = [&]() {
+            // outputs must be closed after checkOutputForAllStrategies() is executed
+            if (!routing.outputs.empty()) {
+                for (const auto& [output, state] : routing.outputs) {
+                    sp<SwAudioOutputDescriptor> desc = mOutputs.valueFor(output);
+                    // an output may be reported by several changes of the same set
+                    if (desc == nullptr) continue;
+                    // close unused outputs after device disconnection or direct outputs that have
+                    // been opened by checkOutputsForDevice() to query dynamic parameters
+                    // "outputs" vector never contains duplicated outputs
+                    if ((state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE)
+                            || (((desc->mFlags & AUDIO_OUTPUT_FLAG_DIRECT) != 0) &&
+                                (desc->mDirectOpenCount == 0))
+                            || (((desc->mFlags & AUDIO_OUTPUT_FLAG_SPATIALIZER) != 0) &&
+                                !isOutputOnlyAvailableRouteToSomeDevice(desc))) {
+                        clearAudioSourcesForOutput(output);
+                        closeOutput(output);
+                    }
+                }
+                // check A2DP again after closing A2DP output to reset mA2dpSuspended if needed
+                return true;
+            }
+            return false;
+        };
+
+        if (routing.checkOutputRouting) {
+            checkForDeviceAndOutputChanges(checkCloseOutputs);
+        } else {
+            checkCloseOutputs();
+            if (routing.inputDevicesChanged) {
+                updateDevicesAndOutputs();
+            }
+        }
+    } else {
         // As the input device list can impact the output device selection, update
         // getDeviceForStrategy() cache
         updateDevicesAndOutputs();
+    }
+
+    (void)updateCallRouting(false /*fromCache*/);
+
+    if (routing.outputDevicesChanged) {
+        const DeviceVector msdOutDevices = getMsdAudioOutDevices();
+        const DeviceVector activeMediaDevices =
+                mEngine->getActiveMediaDevices(mAvailableOutputDevices);
+        std::map<audio_io_handle_t, DeviceVector> outputsToReopenWithDevices;
+        for (size_t i = 0; i < mOutputs.size(); i++) {
+            sp<SwAudioOutputDescriptor> desc = mOutputs.valueAt(i);
+            if (desc->isActive() && ((mEngine->getPhoneState() != AUDIO_MODE_IN_CALL) ||
+                (desc != mPrimaryOutput))) {
+                DeviceVector newDevices = getNewOutputDevices(desc, true /*fromCache*/);
+                bool force = (msdOutDevices.isEmpty() || msdOutDevices != desc->devices())
+                        && !desc->isDuplicated()
+                        && routing.forceOutputRouting;
+                if (desc->mUsePreferredMixerAttributes && newDevices != desc->devices()) {
+                    // If the device is using preferred mixer attributes, the output need to reopen
+                    // with default configuration when the new selected devices are different from
+                    // current routing devices
+                    outputsToReopenWithDevices.emplace(mOutputs.keyAt(i), newDevices);
+                    continue;
+                }
+                setOutputDevices(desc, newDevices, force, 0);
+            }
+            if (!desc->isDuplicated() && desc->mProfile->hasDynamicAudioProfile() &&
+                    !activeMediaDevices.empty() && desc->devices() != activeMediaDevices &&
+                    desc->supportsDevicesForPlayback(activeMediaDevices)) {
+                // Reopen the output to query the dynamic profiles when there is not active
+                // clients or all active clients will be rerouted. Otherwise, set the flag
+                // `mPendingReopenToQueryProfiles` in the SwOutputDescriptor so that the output
+                // can be reopened to query dynamic profiles when all clients are inactive.
+                if (areAllActiveTracksRerouted(desc)) {
+                    outputsToReopenWithDevices.emplace(mOutputs.keyAt(i), activeMediaDevices);
+                } else {
+                    desc->mPendingReopenToQueryProfiles = true;
+                }
+            }
+            if (!desc->supportsDevicesForPlayback(activeMediaDevices)) {
+                // Clear the flag that previously set for re-querying profiles.
+                desc->mPendingReopenToQueryProfiles = false;
+            }
+        }
+        reopenOutputsWithDevices(outputsToReopenWithDevices);
+    }
 
-        (void)updateCallRouting(false /*fromCache*/);
+    if (routing.inputDevicesChanged) {
         // Reconnect Audio Source
         for (const auto &strategy : mEngine->getOrderedProductStrategies()) {
             auto attributes = mEngine->getAllAttributesForProductStrategy(strategy).front();
             checkAudioSourceForAttributes(attributes);
         }
-        if (state == AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE) {
-            cleanUpForDevice(device);
-        }
+    }
 
-        mpClientInterface->onAudioPortListUpdate();
-        return NO_ERROR;
-    } // end if is input device
+    for (const auto& device : routing.disconnectedDevices) {
+        cleanUpForDevice(device);
+    }
 
-    ALOGW("%s() invalid device: %s", __func__, device->toString().c_str());
-    return BAD_VALUE;
+    if (routing.outputDevicesChanged) {
+        checkLeBroadcastRoutes(routing.wasLeUnicastActive, nullptr, 0);
+    }
+
+    mpClientInterface->onAudioPortListUpdate();
 }
 
 status_t AudioPolicyManager::deviceToAudioPort(audio_devices_t device, const char* device_address,
@@ -471,6 +561,7 @@ void AudioPolicyManager::setEngineDeviceConnectionState(const sp<DeviceDescripto
     if (audio_is_remote_submix_device(device->type()) && device->address() != "0") {
         return;
     }
+    invalidateOutputDevicesCache();
     mEngine->setDeviceConnectionState(device, state);
 }
 
@@ -826,6 +917,7 @@ void AudioPolicyManager::setPhoneState(audio_mode_t state)
     int oldState = mEngine->getPhoneState();
     bool wasLeUnicastActive = isLeUnicastActive();
 
+    invalidateOutputDevicesCache();
     if (mEngine->setPhoneState(state) != NO_ERROR) {
         ALOGW("setPhoneState() invalid or same state %d", state);
         return;
@@ -937,6 +1029,7 @@ void AudioPolicyManager::setForceUse(audio_policy_force_use_t usage,
         return;
     }
 
+    invalidateOutputDevicesCache();
     if (mEngine->setForceUse(usage, config) != NO_ERROR) {
         ALOGW("setForceUse() could not set force cfg %d for usage %d", config, usage);
         return;
@@ -1258,7 +1351,9 @@ status_t AudioPolicyManager::getOutputForAttrInt(
     }
     // explicit routing managed by getDeviceForStrategy in APM is now handled by engine
     // in order to let the choice of the order to future vendor engine
-    outputDevices = mEngine->getOutputDevicesForAttributes(*resultAttr, requestedDevice, false);
+    outputDevices = requestedDevice != nullptr
+            ? mEngine->getOutputDevicesForAttributes(*resultAttr, requestedDevice, false)
+            : getCachedOutputDevicesForAttributes(*resultAttr);
 
     if ((resultAttr->flags & AUDIO_FLAG_HW_AV_SYNC) != 0) {
         *flags = (audio_output_flags_t)(*flags | AUDIO_OUTPUT_FLAG_HW_AV_SYNC);
@@ -2189,6 +2284,8 @@ status_t AudioPolicyManager::startSource(const sp<SwAudioOutputDescriptor>& outp
     // cannot start playback of STREAM_TTS if any other output is being used
     uint32_t beaconMuteLatency = 0;
 
+    // The engine device selection depends on the active streams.
+    invalidateOutputDevicesCache();
     *delayMs = 0;
     audio_stream_type_t stream = client->stream();
     auto clientVolSrc = client->volumeSource();
@@ -2455,6 +2552,10 @@ status_t AudioPolicyManager::stopSource(const sp<SwAudioOutputDescriptor>& outpu
     auto clientVolSrc = client->volumeSource();
     bool wasLeUnicastActive = isLeUnicastActive();
 
+    // The engine device selection depends on streams that were recently active,
+    // see SONIFICATION_RESPECTFUL_AFTER_MUSIC_DELAY.
+    invalidateOutputDevicesCache(SONIFICATION_RESPECTFUL_AFTER_MUSIC_DELAY);
+
     handleEventForBeacon(stream == AUDIO_STREAM_TTS ? STOPPING_BEACON : STOPPING_OUTPUT);
 
     if (outputDesc->getActivityCount(clientVolSrc) > 0) {
@@ -3837,6 +3938,7 @@ status_t AudioPolicyManager::setDevicesRoleForStrategy(product_strategy_t strate
     if (!areAllDevicesSupported(devices, audio_is_output_device, __func__)) {
         return BAD_VALUE;
     }
+    invalidateOutputDevicesCache();
     status_t status = mEngine->setDevicesRoleForStrategy(strategy, role, devices);
     if (status != NO_ERROR) {
         ALOGW("Engine could not set preferred devices %s for strategy %d role %d",
@@ -3927,6 +4029,7 @@ AudioPolicyManager::removeDevicesRoleForStrategy(product_strategy_t strategy,
             devices, audio_is_output_device, __func__, /*matchAddress*/false)) {
         return BAD_VALUE;
     }
+    invalidateOutputDevicesCache();
     status_t status = mEngine->removeDevicesRoleForStrategy(strategy, role, devices);
     if (status != NO_ERROR) {
         ALOGW("Engine could not remove devices %s for strategy %d role %d",
@@ -3955,6 +4058,7 @@ status_t AudioPolicyManager::clearDevicesRoleForStrategy(product_strategy_t stra
 {
     ALOGV("%s() strategy=%d role=%d", __func__, strategy, role);
 
+    invalidateOutputDevicesCache();
     status_t status = mEngine->clearDevicesRoleForStrategy(strategy, role);
     if (status != NO_ERROR) {
         ALOGW_IF(status != NAME_NOT_FOUND,
@@ -4120,6 +4224,9 @@ void AudioPolicyManager::dump(String8 *dst) const
     dst->appendFormat(" Master mono: %s\n", mMasterMono ? "on" : "off");
     dst->appendFormat(" Communication Strategy id: %d\n", mCommunnicationStrategy);
     dst->appendFormat(" Config source: %s\n", mConfig->getSource().c_str());
+    dst->appendFormat(" Output devices cache: %zu entries, %" PRIu64 " hits, %" PRIu64
+            " misses, %" PRIu64 " invalidations\n", mOutputDevicesCache.size(),
+            mOutputDevicesCacheHits, mOutputDevicesCacheMisses, mOutputDevicesCacheInvalidations);
 
     dst->append("\n");
     mAvailableOutputDevices.dump(dst, String8("Available output"), 1);
@@ -6266,6 +6373,7 @@ void AudioPolicyManager::addOutput(audio_io_handle_t output,
                                    const sp<SwAudioOutputDescriptor>& outputDesc)
 {
     mOutputs.add(output, outputDesc);
+    invalidateOutputDevicesCache();
     applyStreamVolumes(outputDesc, DeviceTypeSet(), 0 /* delayMs */, true /* force */);
     updateMono(output); // update mono status when adding to output list
     selectOutputForMusicEffects();
@@ -6279,6 +6387,7 @@ void AudioPolicyManager::removeOutput(audio_io_handle_t output)
         mPrimaryOutput = nullptr;
     }
     mOutputs.removeItem(output);
+    invalidateOutputDevicesCache();
     selectOutputForMusicEffects();
 }
 
@@ -7232,9 +7341,46 @@ uint32_t AudioPolicyManager::setBeaconMute(bool mute) {
 void AudioPolicyManager::updateDevicesAndOutputs()
 {
     mEngine->updateDeviceSelectionCache();
+    invalidateOutputDevicesCache();
     mPreviousOutputs = mOutputs;
 }
 
+DeviceVector AudioPolicyManager::getCachedOutputDevicesForAttributes(
+        const audio_attributes_t &attr)
+{
+    if (systemTime() < mOutputDevicesCacheHoldOffUntilNs) {
+        mOutputDevicesCacheMisses++;
+        return mEngine->getOutputDevicesForAttributes(attr, nullptr, false /*fromCache*/);
+    }
+    OutputDevicesCacheKey key{attr.usage, attr.content_type, attr.source, attr.flags,
+            std::string(attr.tags)};
+    if (auto it = mOutputDevicesCache.find(key); it != mOutputDevicesCache.end()) {
+        mOutputDevicesCacheHits++;
+        return it->second;
+    }
+    mOutputDevicesCacheMisses++;
+    DeviceVector devices =
+            mEngine->getOutputDevicesForAttributes(attr, nullptr, false /*fromCache*/);
+    // Tags are chosen by apps, so bound the cache.
+    if (mOutputDevicesCache.size() >= kMaxOutputDevicesCacheEntries) {
+        mOutputDevicesCache.clear();
+    }
+    mOutputDevicesCache.emplace(std::move(key), devices);
+    return devices;
+}
+
+void AudioPolicyManager::invalidateOutputDevicesCache(uint32_t holdOffMs)
+{
+    if (!mOutputDevicesCache.empty()) {
+        mOutputDevicesCache.clear();
+        mOutputDevicesCacheInvalidations++;
+    }
+    if (holdOffMs != 0) {
+        mOutputDevicesCacheHoldOffUntilNs = std::max(mOutputDevicesCacheHoldOffUntilNs,
+                systemTime() + milliseconds(holdOffMs));
+    }
+}
+
 uint32_t AudioPolicyManager::checkDeviceMuteStrategies(const sp<AudioOutputDescriptor>& outputDesc,
                                                        const DeviceVector &prevDevices,
                                                        uint32_t delayMs)
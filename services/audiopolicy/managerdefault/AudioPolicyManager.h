@@ -18,7 +18,10 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <unordered_set>
 
 #include <stdint.h>
@@ -102,6 +105,8 @@ public:
         // AudioPolicyInterface
         virtual status_t setDeviceConnectionState(audio_policy_dev_state_t state,
                 const android::media::audio::common::AudioPort& port, audio_format_t encodedFormat);
+        virtual status_t setDeviceConnectionStates(
+                const std::vector<DeviceConnectionChange>& changes);
         virtual audio_policy_dev_state_t getDeviceConnectionState(audio_devices_t device,
                                                                               const char *device_address);
         virtual status_t handleDeviceConfigChange(audio_devices_t device,
@@ -730,6 +735,24 @@ protected:
          */
         void updateDevicesAndOutputs();
 
+        /**
+         * @brief getCachedOutputDevicesForAttributes: returns the engine device selection for
+         * the attributes, without preferred device, memoized until the next call to
+         * invalidateOutputDevicesCache().
+         * The engine selection does not depend on the session or uid, which are handled by the
+         * dynamic policies before the engine is queried.
+         */
+        DeviceVector getCachedOutputDevicesForAttributes(const audio_attributes_t &attr);
+
+        /**
+         * @brief invalidateOutputDevicesCache: must be called every time a condition that
+         * affects the engine device selection changes: connected devices, phone state,
+         * force use, device roles, opened outputs and active streams.
+         * @param holdOffMs do not cache for this long, for selections that depend on
+         * recently active streams.
+         */
+        void invalidateOutputDevicesCache(uint32_t holdOffMs = 0);
+
         // selects the most appropriate device on input for current state
         sp<DeviceDescriptor> getNewInputDevice(const sp<AudioInputDescriptor>& inputDesc);
 
@@ -982,6 +1005,16 @@ protected:
 
         std::unordered_map<uid_t, audio_flags_mask_t> mAllowedCapturePolicies;
 
+        // See getCachedOutputDevicesForAttributes().
+        using OutputDevicesCacheKey = std::tuple<audio_usage_t, audio_content_type_t,
+                audio_source_t, audio_flags_mask_t, std::string>;
+        static constexpr size_t kMaxOutputDevicesCacheEntries = 64;
+        std::map<OutputDevicesCacheKey, DeviceVector> mOutputDevicesCache;
+        nsecs_t mOutputDevicesCacheHoldOffUntilNs = 0;
+        uint64_t mOutputDevicesCacheHits = 0;
+        uint64_t mOutputDevicesCacheMisses = 0;
+        uint64_t mOutputDevicesCacheInvalidations = 0;
+
         // The map of device descriptor and formats reported by the device.
         std::map<wp<DeviceDescriptor>, FormatVector> mReportedFormatsMap;
 
@@ -1187,6 +1220,38 @@ private:
         status_t setDeviceConnectionStateInt(const sp<DeviceDescriptor> &device,
                                              audio_policy_dev_state_t state);
 
+        // Finds or creates the descriptor of the device of a connection state change.
+        status_t getDeviceForConnectionChange(audio_policy_dev_state_t state,
+                                              const android::media::audio::common::AudioPort& port,
+                                              audio_format_t encodedFormat,
+                                              sp<DeviceDescriptor>* device);
+
+        // Routing work deferred until all the changes of a set of device connection state
+        // changes are applied, so that it is done once for the set.
+        struct DeviceConnectionRouting {
+            // outputs returned by checkOutputsForDevice() and the state of their device
+            std::vector<std::pair<audio_io_handle_t, audio_policy_dev_state_t>> outputs;
+            DeviceVector disconnectedDevices;
+            bool outputDevicesChanged = false;
+            bool inputDevicesChanged = false;
+            // false if only remote submix devices of recorder dynamic policies changed
+            bool checkOutputRouting = false;
+            // force the device change when rerouting active outputs
+            bool forceOutputRouting = false;
+            bool wasLeUnicastActive = false;
+        };
+
+        // Updates device availability, the HALs and the engine for one connection state
+        // change and opens or checks the outputs or inputs for the device.
+        // Rerouting and closing unused outputs is recorded in routing.
+        status_t applyDeviceConnectionState(const sp<DeviceDescriptor> &device,
+                                            audio_policy_dev_state_t state,
+                                            DeviceConnectionRouting &routing);
+
+        // Reroutes outputs, inputs and audio sources and closes the unused outputs and inputs
+        // after the changes recorded in routing.
+        void updateRoutingForDeviceConnections(const DeviceConnectionRouting &routing);
+
         void setEngineDeviceConnectionState(const sp<DeviceDescriptor> device,
                                       audio_policy_dev_state_t state);
 
@@ -149,6 +149,38 @@ Status AudioPolicyService::setDeviceConnectionState(
     return binderStatusFromStatusT(status);
 }
 
+Status AudioPolicyService::setDeviceConnectionStates(
+        const std::vector<media::DeviceConnectionStateChange>& changesAidl) {
+    std::vector<AudioPolicyInterface::DeviceConnectionChange> changes;
+    changes.reserve(changesAidl.size());
+    for (const auto& changeAidl : changesAidl) {
+        audio_policy_dev_state_t state = VALUE_OR_RETURN_BINDER_STATUS(
+                aidl2legacy_AudioPolicyDeviceState_audio_policy_dev_state_t(changeAidl.state));
+        audio_format_t encodedFormat = VALUE_OR_RETURN_BINDER_STATUS(
+                aidl2legacy_AudioFormatDescription_audio_format_t(changeAidl.encodedFormat));
+        if (state != AUDIO_POLICY_DEVICE_STATE_AVAILABLE &&
+                state != AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE) {
+            return binderStatusFromStatusT(BAD_VALUE);
+        }
+        changes.push_back({state, changeAidl.port, encodedFormat});
+    }
+
+    if (mAudioPolicyManager == NULL) {
+        return binderStatusFromStatusT(NO_INIT);
+    }
+    if (!settingsAllowed()) {
+        return binderStatusFromStatusT(PERMISSION_DENIED);
+    }
+
+    ALOGV("setDeviceConnectionStates() %zu changes", changes.size());
+    Mutex::Autolock _l(mLock);
+    AutoCallerClear acc;
+    status_t status = mAudioPolicyManager->setDeviceConnectionStates(changes);
+    // some changes may have been applied even if others failed
+    onCheckSpatializer_l();
+    return binderStatusFromStatusT(status);
+}
+
 Status AudioPolicyService::getDeviceConnectionState(const AudioDevice& deviceAidl,
                                                     media::AudioPolicyDeviceState* _aidl_return) {
     audio_devices_t device;
@@ -66,6 +66,7 @@ static const String16 sManageAudioPolicyPermission("android.permission.MANAGE_AU
 #define IAUDIOPOLICYSERVICE_BINDER_METHOD_MACRO_LIST \
 BINDER_METHOD_ENTRY(onNewAudioModulesAvailable) \
 BINDER_METHOD_ENTRY(setDeviceConnectionState) \
+BINDER_METHOD_ENTRY(setDeviceConnectionStates) \
 BINDER_METHOD_ENTRY(getDeviceConnectionState) \
 BINDER_METHOD_ENTRY(handleDeviceConfigChange) \
 BINDER_METHOD_ENTRY(setPhoneState) \
@@ -1289,6 +1290,7 @@ status_t AudioPolicyService::onTransact(
     // make sure the following transactions come from system components
     switch (code) {
         case TRANSACTION_setDeviceConnectionState:
+        case TRANSACTION_setDeviceConnectionStates:
         case TRANSACTION_handleDeviceConfigChange:
         case TRANSACTION_setPhoneState:
 //FIXME: Allow setForceUse calls from system apps until a better use case routing API is available
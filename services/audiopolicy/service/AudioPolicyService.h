@@ -86,6 +86,8 @@ public:
             media::AudioPolicyDeviceState state,
             const android::media::audio::common::AudioPort& port,
             const AudioFormatDescription& encodedFormat) override;
+    binder::Status setDeviceConnectionStates(
+            const std::vector<media::DeviceConnectionStateChange>& changes) override;
     binder::Status getDeviceConnectionState(const AudioDevice& device,
                                             media::AudioPolicyDeviceState* _aidl_return) override;
     binder::Status handleDeviceConfigChange(
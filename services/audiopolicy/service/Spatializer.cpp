@@ -121,12 +121,6 @@ public:
     };
     static constexpr const char *kNumFramesKey = "numFrames";
     static constexpr const char *kModeKey = "mode";
-    static constexpr const char *kTranslation0Key = "translation0";
-    static constexpr const char *kTranslation1Key = "translation1";
-    static constexpr const char *kTranslation2Key = "translation2";
-    static constexpr const char *kRotation0Key = "rotation0";
-    static constexpr const char *kRotation1Key = "rotation1";
-    static constexpr const char *kRotation2Key = "rotation2";
     static constexpr const char *kLatencyModesKey = "latencyModes";
 
     class LatencyModes : public RefBase {
@@ -166,14 +160,7 @@ public:
                 }
                 } break;
             case kWhatOnHeadToStagePose: {
-                std::vector<float> headToStage(sHeadPoseKeys.size());
-                for (size_t i = 0 ; i < sHeadPoseKeys.size(); i++) {
-                    if (!msg->findFloat(sHeadPoseKeys[i], &headToStage[i])) {
-                        ALOGE("%s: Cannot find kTranslation0Key!", __func__);
-                        return;
-                    }
-                }
-                spatializer->onHeadToStagePoseMsg(headToStage);
+                spatializer->onHeadToStagePoseMsg();
                 } break;
             case kWhatOnActualModeChange: {
                 int mode;
@@ -204,15 +191,6 @@ private:
     std::once_flag mPrioritySetFlag;
 };
 
-const std::vector<const char *> Spatializer::sHeadPoseKeys = {
-    Spatializer::EngineCallbackHandler::kTranslation0Key,
-    Spatializer::EngineCallbackHandler::kTranslation1Key,
-    Spatializer::EngineCallbackHandler::kTranslation2Key,
-    Spatializer::EngineCallbackHandler::kRotation0Key,
-    Spatializer::EngineCallbackHandler::kRotation1Key,
-    Spatializer::EngineCallbackHandler::kRotation2Key,
-};
-
 // ---------------------------------------------------------------------------
 sp<Spatializer> Spatializer::create(SpatializerPolicyCallback* callback,
                                     const sp<EffectsFactoryHalInterface>& effectsFactoryHal) {
@@ -756,14 +734,24 @@ void Spatializer::onHeadToStagePose(const Pose3f& headToStage) {
             "onHeadToStagePose() called with no head tracking support!");
 
     auto vec = headToStage.toVector();
-    LOG_ALWAYS_FATAL_IF(vec.size() != sHeadPoseKeys.size(),
+    LOG_ALWAYS_FATAL_IF(vec.size() != kHeadPoseSize,
             "%s invalid head to stage vector size %zu", __func__, vec.size());
-    sp<AMessage> msg =
-            new AMessage(EngineCallbackHandler::kWhatOnHeadToStagePose, mHandler);
-    for (size_t i = 0 ; i < sHeadPoseKeys.size(); i++) {
-        msg->setFloat(sHeadPoseKeys[i], vec[i]);
+    bool wasPending;
+    {
+        std::lock_guard lock(mPendingHeadToStageLock);
+        wasPending = mPendingHeadToStage.has_value();
+        mPendingHeadToStage = std::move(vec);
+        if (wasPending) {
+            ++mCoalescedHeadToStagePoses;
+        }
+    }
+    // The pending message delivers the latest pose, so only one is posted
+    // while the handler is busy.
+    if (!wasPending) {
+        sp<AMessage> msg =
+                new AMessage(EngineCallbackHandler::kWhatOnHeadToStagePose, mHandler);
+        msg->post();
     }
-    msg->post();
 }
 
 void Spatializer::resetEngineHeadPose_l() {
@@ -777,8 +765,17 @@ void Spatializer::resetEngineHeadPose_l() {
             std::vector<SpatializerHeadTrackingMode>{SpatializerHeadTrackingMode::DISABLED});
 }
 
-void Spatializer::onHeadToStagePoseMsg(const std::vector<float>& headToStage) {
+void Spatializer::onHeadToStagePoseMsg() {
     ALOGV("%s", __func__);
+    std::vector<float> headToStage;
+    {
+        std::lock_guard lock(mPendingHeadToStageLock);
+        if (!mPendingHeadToStage.has_value()) {
+            return;
+        }
+        headToStage = std::move(*mPendingHeadToStage);
+        mPendingHeadToStage.reset();
+    }
     sp<media::ISpatializerHeadTrackingCallback> callback;
     {
         std::lock_guard lock(mLock);
@@ -1104,6 +1101,11 @@ std::string Spatializer::toString(unsigned level) const {
     base::StringAppendF(&ss, "%sEffectHandle: %p\n", prefixSpace.c_str(), mEngine.get());
     base::StringAppendF(&ss, "%sDisplayOrientation: %f\n", prefixSpace.c_str(),
                         mDisplayOrientation);
+    {
+        std::lock_guard lock(mPendingHeadToStageLock);
+        base::StringAppendF(&ss, "%sCoalescedHeadToStagePoses: %lld\n", prefixSpace.c_str(),
+                            (long long)mCoalescedHeadToStagePoses);
+    }
 
     ss.append(prefixSpace + "CommandLog:\n");
     ss += mLocalLog.dumpToString((prefixSpace + " ").c_str(), mMaxLocalLogLine);
@@ -192,7 +192,7 @@ private:
     void onHeadToStagePose(const media::Pose3f& headToStage) override;
     void onActualModeChange(media::HeadTrackingMode mode) override;
 
-    void onHeadToStagePoseMsg(const std::vector<float>& headToStage);
+    void onHeadToStagePoseMsg();
     void onActualModeChangeMsg(media::HeadTrackingMode mode);
     void onSupportedLatencyModesChangedMsg(
             audio_io_handle_t output, std::vector<audio_latency_mode_t>&& modes);
@@ -403,7 +403,15 @@ private:
     size_t mNumActiveTracks GUARDED_BY(mLock) = 0;
     std::vector<audio_latency_mode_t> mSupportedLatencyModes GUARDED_BY(mLock);
 
-    static const std::vector<const char*> sHeadPoseKeys;
+    // Size of a head to stage pose vector: translation x, y, z and rotation x, y, z.
+    static constexpr size_t kHeadPoseSize = 6;
+
+    // The latest head to stage pose from the pose controller, not yet sent to the engine.
+    // A pose received while one is pending replaces it: the engine only needs the most recent
+    // pose, and each update is a synchronous effect command.
+    mutable std::mutex mPendingHeadToStageLock;
+    std::optional<std::vector<float>> mPendingHeadToStage GUARDED_BY(mPendingHeadToStageLock);
+    int64_t mCoalescedHeadToStagePoses GUARDED_BY(mPendingHeadToStageLock) = 0;
 
     // Local log for command messages.
     static constexpr int mMaxLocalLogLine = 10;
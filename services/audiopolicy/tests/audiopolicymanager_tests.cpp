@@ -2141,6 +2141,75 @@ TEST_F(AudioPolicyManagerTestDeviceConnection, RoutingUpdate) {
     ASSERT_EQ(3, mClient->getRoutingUpdatedCounter());
 }
 
+TEST_F(AudioPolicyManagerTestDeviceConnection, SetDeviceConnectionStates) {
+    const std::vector<DeviceConnectionTestParams> devices = {
+            {AUDIO_DEVICE_OUT_HDMI, "test_out_hdmi", "audio_policy_test_out_hdmi"},
+            {AUDIO_DEVICE_OUT_BLUETOOTH_SCO, "bt_hfp_out", "00:11:22:33:44:55"},
+            {AUDIO_DEVICE_IN_HDMI, "test_in_hdmi", "audio_policy_test_in_hdmi"}};
+    auto makeChanges = [&](audio_policy_dev_state_t state) {
+        std::vector<AudioPolicyInterface::DeviceConnectionChange> changes;
+        for (const auto& [type, name, address] : devices) {
+            android::media::AudioPortFw audioPort;
+            EXPECT_EQ(NO_ERROR, mManager->deviceToAudioPort(
+                    type, address.c_str(), name.c_str(), &audioPort));
+            changes.push_back({state, audioPort.hal, AUDIO_FORMAT_DEFAULT});
+        }
+        return changes;
+    };
+
+    // Connecting a set of devices updates routing once.
+    mClient->resetRoutingUpdatedCounter();
+    const size_t portListUpdateCount = mClient->getAudioPortListUpdateCount();
+    ASSERT_EQ(NO_ERROR,
+            mManager->setDeviceConnectionStates(makeChanges(AUDIO_POLICY_DEVICE_STATE_AVAILABLE)));
+    EXPECT_EQ(1, mClient->getRoutingUpdatedCounter());
+    EXPECT_EQ(portListUpdateCount + 1, mClient->getAudioPortListUpdateCount());
+    for (const auto& [type, name, address] : devices) {
+        EXPECT_EQ(AUDIO_POLICY_DEVICE_STATE_AVAILABLE,
+                mManager->getDeviceConnectionState(type, address.c_str()));
+    }
+
+    // A change that fails does not prevent the others from being applied.
+    auto changes = makeChanges(AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE);
+    changes.push_back(changes.front());
+    EXPECT_EQ(INVALID_OPERATION, mManager->setDeviceConnectionStates(changes));
+    EXPECT_EQ(2, mClient->getRoutingUpdatedCounter());
+    for (const auto& [type, name, address] : devices) {
+        EXPECT_EQ(AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE,
+                mManager->getDeviceConnectionState(type, address.c_str()));
+    }
+}
+
+TEST_F(AudioPolicyManagerTestDeviceConnection, OutputDevicesCacheFollowsConnection) {
+    // The first call populates the cache of the engine device selection.
+    audio_port_handle_t selectedDeviceId = AUDIO_PORT_HANDLE_NONE;
+    getOutputForAttr(&selectedDeviceId, AUDIO_FORMAT_PCM_16_BIT, AUDIO_CHANNEL_OUT_STEREO,
+            k48000SamplingRate, AUDIO_OUTPUT_FLAG_NONE);
+    const audio_port_handle_t defaultDeviceId = selectedDeviceId;
+    ASSERT_NE(AUDIO_PORT_HANDLE_NONE, defaultDeviceId);
+
+    // Media must follow a newly connected device.
+    ASSERT_EQ(NO_ERROR, mManager->setDeviceConnectionState(
+            AUDIO_DEVICE_OUT_HDMI, AUDIO_POLICY_DEVICE_STATE_AVAILABLE,
+            "audio_policy_test_out_hdmi", "test_out_hdmi", AUDIO_FORMAT_DEFAULT));
+    audio_port_v7 devicePort;
+    ASSERT_TRUE(findDevicePort(AUDIO_PORT_ROLE_SINK, AUDIO_DEVICE_OUT_HDMI,
+            "audio_policy_test_out_hdmi", &devicePort));
+    selectedDeviceId = AUDIO_PORT_HANDLE_NONE;
+    getOutputForAttr(&selectedDeviceId, AUDIO_FORMAT_PCM_16_BIT, AUDIO_CHANNEL_OUT_STEREO,
+            k48000SamplingRate, AUDIO_OUTPUT_FLAG_NONE);
+    EXPECT_EQ(devicePort.id, selectedDeviceId);
+
+    // And return to the default device once it is disconnected.
+    ASSERT_EQ(NO_ERROR, mManager->setDeviceConnectionState(
+            AUDIO_DEVICE_OUT_HDMI, AUDIO_POLICY_DEVICE_STATE_UNAVAILABLE,
+            "audio_policy_test_out_hdmi", "test_out_hdmi", AUDIO_FORMAT_DEFAULT));
+    selectedDeviceId = AUDIO_PORT_HANDLE_NONE;
+    getOutputForAttr(&selectedDeviceId, AUDIO_FORMAT_PCM_16_BIT, AUDIO_CHANNEL_OUT_STEREO,
+            k48000SamplingRate, AUDIO_OUTPUT_FLAG_NONE);
+    EXPECT_EQ(defaultDeviceId, selectedDeviceId);
+}
+
 TEST_P(AudioPolicyManagerTestDeviceConnection, SetDeviceConnectionState) {
     const audio_devices_t type = std::get<0>(GetParam());
     const std::string name = std::get<1>(GetParam());
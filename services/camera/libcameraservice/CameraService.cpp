@@ -2622,6 +2622,16 @@ Status CameraService::notifySystemEvent(int32_t eventId,
                                                         std::to_string(args[0]));
             break;
         }
+        case ICameraService::EVENT_CAMERA_OPEN_HINT: {
+            if (args.size() != 1) {
+                return Status::fromExceptionCode(Status::EX_ILLEGAL_ARGUMENT,
+                    "Camera open hint requires 1 argument");
+            }
+
+            // Start up lazy HALs ahead of the actual open
+            mCameraProviderManager->notifyCameraOpenHint(std::to_string(args[0]));
+            break;
+        }
         case ICameraService::EVENT_NONE:
         default: {
             ALOGW("%s: Received invalid system event from system_server: %d", __FUNCTION__,
@@ -476,10 +476,17 @@ status_t CallbackProcessor::convertFromFlexibleYuv(int32_t previewFormat,
     // Copy Y plane, adjusting for stride
     const uint8_t *ySrc = src.data;
     uint8_t *yDst = dst;
-    for (size_t row = 0; row < src.height; row++) {
-        memcpy(yDst, ySrc, src.width);
-        ySrc += src.stride;
-        yDst += dstYStride;
+    if (src.stride == dstYStride && src.height > 0) {
+        // Same row layout, copy the whole plane at once
+        size_t ySize = dstYStride * (src.height - 1) + src.width;
+        memcpy(yDst, ySrc, ySize);
+        yDst += dstYStride * src.height;
+    } else {
+        for (size_t row = 0; row < src.height; row++) {
+            memcpy(yDst, ySrc, src.width);
+            ySrc += src.stride;
+            yDst += dstYStride;
+        }
     }
 
     // Copy/swizzle chroma planes, 4:2:0 subsampling
@@ -503,6 +510,19 @@ status_t CallbackProcessor::convertFromFlexibleYuv(int32_t previewFormat,
                 crcbDst += src.width;
                 crSrc += src.chromaStride;
             }
+        } else if (crSrc == cbSrc + 1 && src.chromaStep == 2) {
+            ALOGV("%s: Fast NV12->NV21", __FUNCTION__);
+            // Source has semiplanar CbCr chroma layout, only need to swap
+            // each chroma pair. Keep the inner loop simple so that it can be
+            // vectorized by the compiler.
+            for (size_t row = 0; row < chromaHeight; row++) {
+                for (size_t col = 0; col < chromaWidth; col++) {
+                    crcbDst[2 * col] = cbSrc[2 * col + 1];
+                    crcbDst[2 * col + 1] = cbSrc[2 * col];
+                }
+                crcbDst += chromaWidth * 2;
+                cbSrc += src.chromaStride;
+            }
         } else {
             ALOGV("%s: Generic->NV21", __FUNCTION__);
             // Generic copy, always works but not very efficient
@@ -211,7 +211,10 @@ void ZslProcessor::onResultAvailable(const CaptureResult &result) {
     // Corresponding buffer has been cleared. No need to push into mFrameList
     if (timestamp <= mLatestClearedBufferTimestamp) return;
 
-    mFrameList[mFrameListHead] = result.mMetadata;
+    ZslFrame &frame = mFrameList[mFrameListHead];
+    frame.metadata = result.mMetadata;
+    frame.timestamp = timestamp;
+    frame.isCandidate = isCandidateFrame(frame.metadata);
     mFrameListHead = (mFrameListHead + 1) % mFrameListDepth;
 }
 
@@ -482,7 +485,7 @@ status_t ZslProcessor::pushToReprocess(int32_t requestId) {
     }
 
     {
-        CameraMetadata request = mFrameList[metadataIdx];
+        CameraMetadata request = mFrameList[metadataIdx].metadata;
 
         // Verify that the frame is reasonable for reprocessing
 
@@ -754,6 +757,57 @@ bool ZslProcessor::isFixedFocusMode(uint8_t afMode) const {
     }
 }
 
+bool ZslProcessor::isCandidateFrame(const CameraMetadata &frame) const {
+    camera_metadata_ro_entry_t entry;
+    entry = frame.find(ANDROID_CONTROL_AE_STATE);
+
+    if (entry.count == 0) {
+        /**
+         * This is most likely a HAL bug. The aeState field is
+         * mandatory, so it should always be in a metadata packet.
+         */
+        ALOGW("%s: ZSL queue frame has no AE state field!",
+                __FUNCTION__);
+        return false;
+    }
+    if (entry.data.u8[0] != ANDROID_CONTROL_AE_STATE_CONVERGED &&
+            entry.data.u8[0] != ANDROID_CONTROL_AE_STATE_LOCKED) {
+        ALOGVV("%s: ZSL queue frame AE state is %d, need "
+               "full capture",  __FUNCTION__, entry.data.u8[0]);
+        return false;
+    }
+
+    entry = frame.find(ANDROID_CONTROL_AF_MODE);
+    if (entry.count == 0) {
+        ALOGW("%s: ZSL queue frame has no AF mode field!",
+                __FUNCTION__);
+        return false;
+    }
+    // Check AF state if device has focuser and focus mode isn't fixed
+    if (mHasFocuser) {
+        uint8_t afMode = entry.data.u8[0];
+        if (!isFixedFocusMode(afMode)) {
+            // Make sure the candidate frame has good focus.
+            entry = frame.find(ANDROID_CONTROL_AF_STATE);
+            if (entry.count == 0) {
+                ALOGW("%s: ZSL queue frame has no AF state field!",
+                        __FUNCTION__);
+                return false;
+            }
+            uint8_t afState = entry.data.u8[0];
+            if (afState != ANDROID_CONTROL_AF_STATE_PASSIVE_FOCUSED &&
+                    afState != ANDROID_CONTROL_AF_STATE_FOCUSED_LOCKED &&
+                    afState != ANDROID_CONTROL_AF_STATE_NOT_FOCUSED_LOCKED) {
+                ALOGVV("%s: ZSL queue frame AF state is %d is not good for capture,"
+                        " skip it", __FUNCTION__, afState);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 nsecs_t ZslProcessor::getCandidateTimestampLocked(size_t* metadataIdx) const {
     /**
      * Find the smallest timestamp we know about so far
@@ -766,72 +820,18 @@ nsecs_t ZslProcessor::getCandidateTimestampLocked(size_t* metadataIdx) const {
     size_t emptyCount = mFrameList.size();
 
     for (size_t j = 0; j < mFrameList.size(); j++) {
-        const CameraMetadata &frame = mFrameList[j];
-        if (!frame.isEmpty()) {
+        const ZslFrame &frame = mFrameList[j];
+        if (!frame.metadata.isEmpty()) {
 
             emptyCount--;
 
-            camera_metadata_ro_entry_t entry;
-            entry = frame.find(ANDROID_SENSOR_TIMESTAMP);
-            if (entry.count == 0) {
-                ALOGE("%s: Can't find timestamp in frame!",
-                        __FUNCTION__);
-                continue;
-            }
-            nsecs_t frameTimestamp = entry.data.i64[0];
-            if (minTimestamp > frameTimestamp || minTimestamp == -1) {
-
-                entry = frame.find(ANDROID_CONTROL_AE_STATE);
-
-                if (entry.count == 0) {
-                    /**
-                     * This is most likely a HAL bug. The aeState field is
-                     * mandatory, so it should always be in a metadata packet.
-                     */
-                    ALOGW("%s: ZSL queue frame has no AE state field!",
-                            __FUNCTION__);
-                    continue;
-                }
-                if (entry.data.u8[0] != ANDROID_CONTROL_AE_STATE_CONVERGED &&
-                        entry.data.u8[0] != ANDROID_CONTROL_AE_STATE_LOCKED) {
-                    ALOGVV("%s: ZSL queue frame AE state is %d, need "
-                           "full capture",  __FUNCTION__, entry.data.u8[0]);
-                    continue;
-                }
-
-                entry = frame.find(ANDROID_CONTROL_AF_MODE);
-                if (entry.count == 0) {
-                    ALOGW("%s: ZSL queue frame has no AF mode field!",
-                            __FUNCTION__);
-                    continue;
-                }
-                // Check AF state if device has focuser and focus mode isn't fixed
-                if (mHasFocuser) {
-                    uint8_t afMode = entry.data.u8[0];
-                    if (!isFixedFocusMode(afMode)) {
-                        // Make sure the candidate frame has good focus.
-                        entry = frame.find(ANDROID_CONTROL_AF_STATE);
-                        if (entry.count == 0) {
-                            ALOGW("%s: ZSL queue frame has no AF state field!",
-                                    __FUNCTION__);
-                            continue;
-                        }
-                        uint8_t afState = entry.data.u8[0];
-                        if (afState != ANDROID_CONTROL_AF_STATE_PASSIVE_FOCUSED &&
-                                afState != ANDROID_CONTROL_AF_STATE_FOCUSED_LOCKED &&
-                                afState != ANDROID_CONTROL_AF_STATE_NOT_FOCUSED_LOCKED) {
-                            ALOGVV("%s: ZSL queue frame AF state is %d is not good for capture,"
-                                    " skip it", __FUNCTION__, afState);
-                            continue;
-                        }
-                    }
-                }
-
-                minTimestamp = frameTimestamp;
+            if (frame.isCandidate &&
+                    (minTimestamp > frame.timestamp || minTimestamp == -1)) {
+                minTimestamp = frame.timestamp;
                 idx = j;
             }
 
-            ALOGVV("%s: Saw timestamp %" PRId64, __FUNCTION__, frameTimestamp);
+            ALOGVV("%s: Saw timestamp %" PRId64, __FUNCTION__, frame.timestamp);
         }
     }
 
@@ -122,10 +122,19 @@ class ZslProcessor :
         CameraMetadata frame;
     };
 
+    // Result metadata of a preview frame, along with the fields needed to pick
+    // a ZSL candidate, evaluated once when the result arrives
+    struct ZslFrame {
+        CameraMetadata metadata;
+        nsecs_t timestamp = -1;
+        // Whether the 3A state of the frame is good enough for reprocessing
+        bool isCandidate = false;
+    };
+
     static const int32_t kDefaultMaxPipelineDepth = 4;
     size_t mBufferQueueDepth;
     size_t mFrameListDepth;
-    std::vector<CameraMetadata> mFrameList;
+    std::vector<ZslFrame> mFrameList;
     size_t mFrameListHead;
 
     ZslPair mNextPair;
@@ -155,6 +164,9 @@ class ZslProcessor :
 
     nsecs_t getCandidateTimestampLocked(size_t* metadataIdx) const;
 
+    // Check whether the AE/AF state of a frame makes it a good candidate for reprocessing
+    bool isCandidateFrame(const CameraMetadata &frame) const;
+
     status_t enqueueInputBufferByTimestamp( nsecs_t timestamp,
         nsecs_t* actualTimestamp);
     status_t clearInputRingBufferLocked(nsecs_t* latestTimestamp);
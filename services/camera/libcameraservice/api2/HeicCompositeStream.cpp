@@ -815,22 +815,25 @@ bool HeicCompositeStream::getNextReadyInputLocked(int64_t *frameNumber /*out*/)
     for (auto& it : mPendingInputFrames) {
         // New input is considered to be available only if:
         // 1. input buffers are ready, or
-        // 2. App segment and muxer is created, or
-        // 3. A codec output tile is ready, and an output buffer is available.
+        // 2. App segment and capture result are ready for Exif generation, or
+        // 3. Generated App segment and muxer is created, or
+        // 4. A codec output tile is ready, and an output buffer is available.
         // This makes sure that muxer gets created only when an output tile is
         // generated, because right now we only handle 1 HEIC output buffer at a
         // time (max dequeued buffer count is 1).
-        bool appSegmentReady =
+        bool appSegmentPrepareReady =
                 (it.second.appSegmentBuffer.data != nullptr || it.second.exifError) &&
-                !it.second.appSegmentWritten && it.second.result != nullptr &&
-                it.second.muxer != nullptr;
+                it.second.appSegmentSample == nullptr && !it.second.appSegmentWritten &&
+                it.second.result != nullptr;
+        bool appSegmentReady = it.second.appSegmentSample != nullptr &&
+                !it.second.appSegmentWritten && it.second.muxer != nullptr;
         bool codecOutputReady = !it.second.codecOutputBuffers.empty();
         bool codecInputReady = (it.second.yuvBuffer.data != nullptr) &&
                 (!it.second.codecInputBuffers.empty());
         bool hasOutputBuffer = it.second.muxer != nullptr ||
                 (mDequeuedOutputBufferCnt < kMaxOutputSurfaceProducerCount);
-        if ((!it.second.error) &&
-                (appSegmentReady || (codecOutputReady && hasOutputBuffer) || codecInputReady)) {
+        if ((!it.second.error) && (appSegmentPrepareReady || appSegmentReady ||
+                (codecOutputReady && hasOutputBuffer) || codecInputReady)) {
             *frameNumber = it.first;
             if (it.second.format == nullptr && mFormat != nullptr) {
                 it.second.format = mFormat->dup();
@@ -861,20 +864,21 @@ status_t HeicCompositeStream::processInputFrame(int64_t frameNumber,
     ATRACE_CALL();
     status_t res = OK;
 
-    bool appSegmentReady =
+    bool appSegmentPrepareReady =
             (inputFrame.appSegmentBuffer.data != nullptr || inputFrame.exifError) &&
-            !inputFrame.appSegmentWritten && inputFrame.result != nullptr &&
-            inputFrame.muxer != nullptr;
+            inputFrame.appSegmentSample == nullptr && !inputFrame.appSegmentWritten &&
+            inputFrame.result != nullptr;
     bool codecOutputReady = inputFrame.codecOutputBuffers.size() > 0;
     bool codecInputReady = inputFrame.yuvBuffer.data != nullptr &&
             !inputFrame.codecInputBuffers.empty();
     bool hasOutputBuffer = inputFrame.muxer != nullptr ||
             (mDequeuedOutputBufferCnt < kMaxOutputSurfaceProducerCount);
 
-    ALOGV("%s: [%" PRId64 "]: appSegmentReady %d, codecOutputReady %d, codecInputReady %d,"
-            " dequeuedOutputBuffer %d, timestamp %" PRId64, __FUNCTION__, frameNumber,
-            appSegmentReady, codecOutputReady, codecInputReady, mDequeuedOutputBufferCnt,
-            inputFrame.timestamp);
+    ALOGV("%s: [%" PRId64 "]: appSegmentPrepareReady %d, appSegmentSample %d, "
+            "codecOutputReady %d, codecInputReady %d, dequeuedOutputBuffer %d, "
+            "timestamp %" PRId64, __FUNCTION__, frameNumber, appSegmentPrepareReady,
+            inputFrame.appSegmentSample != nullptr, codecOutputReady, codecInputReady,
+            mDequeuedOutputBufferCnt, inputFrame.timestamp);
 
     // Handle inputs for Hevc tiling
     if (codecInputReady) {
@@ -886,6 +890,19 @@ status_t HeicCompositeStream::processInputFrame(int64_t frameNumber,
         }
     }
 
+    // Generate the Exif App segments while the codec is still encoding the tiles,
+    // instead of waiting for the first output tile and the muxer.
+    if (appSegmentPrepareReady) {
+        res = prepareAppSegment(frameNumber, inputFrame);
+        if (res != OK) {
+            ALOGE("%s: Failed to prepare JPEG APP segments: %s (%d)", __FUNCTION__,
+                    strerror(-res), res);
+            return res;
+        }
+    }
+
+    bool appSegmentReady = inputFrame.appSegmentSample != nullptr &&
+            !inputFrame.appSegmentWritten && inputFrame.muxer != nullptr;
     if (!(codecOutputReady && hasOutputBuffer) && !appSegmentReady) {
         return OK;
     }
@@ -992,7 +1009,7 @@ status_t HeicCompositeStream::startMuxerForInputFrame(int64_t frameNumber, Input
     return OK;
 }
 
-status_t HeicCompositeStream::processAppSegment(int64_t frameNumber, InputFrame &inputFrame) {
+status_t HeicCompositeStream::prepareAppSegment(int64_t frameNumber, InputFrame &inputFrame) {
     size_t app1Size = 0;
     size_t appSegmentSize = 0;
     if (!inputFrame.exifError) {
@@ -1039,7 +1056,8 @@ status_t HeicCompositeStream::processAppSegment(int64_t frameNumber, InputFrame
     kExifApp1Marker[7] = static_cast<uint8_t>(newApp1Length & 0xFF);
     size_t appSegmentBufferSize = sizeof(kExifApp1Marker) +
             appSegmentSize - app1Size + newApp1Length;
-    uint8_t* appSegmentBuffer = new uint8_t[appSegmentBufferSize];
+    sp<ABuffer> aBuffer = new ABuffer(appSegmentBufferSize);
+    uint8_t* appSegmentBuffer = aBuffer->data();
     memcpy(appSegmentBuffer, kExifApp1Marker, sizeof(kExifApp1Marker));
     memcpy(appSegmentBuffer + sizeof(kExifApp1Marker), newApp1Segment, newApp1Length);
     if (appSegmentSize - app1Size > 0) {
@@ -1047,26 +1065,34 @@ status_t HeicCompositeStream::processAppSegment(int64_t frameNumber, InputFrame
                 inputFrame.appSegmentBuffer.data + app1Size, appSegmentSize - app1Size);
     }
 
-    sp<ABuffer> aBuffer = new ABuffer(appSegmentBuffer, appSegmentBufferSize);
-    auto res = inputFrame.muxer->writeSampleData(aBuffer, inputFrame.trackIndex,
-            inputFrame.timestamp, MediaCodec::BUFFER_FLAG_MUXER_DATA);
-    delete[] appSegmentBuffer;
+    ALOGV("%s: [%" PRId64 "]: appSegmentSize is %zu, width %d, height %d, app1Size %zu",
+          __FUNCTION__, frameNumber, appSegmentSize, inputFrame.appSegmentBuffer.width,
+          inputFrame.appSegmentBuffer.height, app1Size);
 
+    inputFrame.appSegmentSample = aBuffer;
+    // Release the buffer now so any pending input app segments can be processed
+    if (inputFrame.appSegmentBuffer.data != nullptr) {
+        mAppSegmentConsumer->unlockBuffer(inputFrame.appSegmentBuffer);
+        inputFrame.appSegmentBuffer.data = nullptr;
+    }
+    inputFrame.exifError = false;
+
+    return OK;
+}
+
+status_t HeicCompositeStream::processAppSegment(int64_t frameNumber, InputFrame &inputFrame) {
+    auto res = inputFrame.muxer->writeSampleData(inputFrame.appSegmentSample,
+            inputFrame.trackIndex, inputFrame.timestamp, MediaCodec::BUFFER_FLAG_MUXER_DATA);
     if (res != OK) {
         ALOGE("%s: Failed to write JPEG APP segments to muxer: %s (%d)",
                 __FUNCTION__, strerror(-res), res);
         return res;
     }
 
-    ALOGV("%s: [%" PRId64 "]: appSegmentSize is %zu, width %d, height %d, app1Size %zu",
-          __FUNCTION__, frameNumber, appSegmentSize, inputFrame.appSegmentBuffer.width,
-          inputFrame.appSegmentBuffer.height, app1Size);
+    ALOGV("%s: [%" PRId64 "]: App segments written to muxer", __FUNCTION__, frameNumber);
 
     inputFrame.appSegmentWritten = true;
-    // Release the buffer now so any pending input app segments can be processed
-    mAppSegmentConsumer->unlockBuffer(inputFrame.appSegmentBuffer);
-    inputFrame.appSegmentBuffer.data = nullptr;
-    inputFrame.exifError = false;
+    inputFrame.appSegmentSample.clear();
 
     return OK;
 }
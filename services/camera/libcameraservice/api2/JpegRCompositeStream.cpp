@@ -233,6 +233,7 @@ int64_t JpegRCompositeStream::getNextFailingInputLocked(int64_t *currentTs /*ino
 }
 
 status_t JpegRCompositeStream::processInputFrame(nsecs_t ts, const InputFrame &inputFrame) {
+    ATRACE_CALL();
     status_t res;
     sp<ANativeWindow> outputANW = mOutputSurface;
     ANativeWindowBuffer *anb;
@@ -336,6 +337,7 @@ status_t JpegRCompositeStream::processInputFrame(nsecs_t ts, const InputFrame &i
             jpeg.colorGamut = ultrahdr::ultrahdr_color_gamut::ULTRAHDR_COLORGAMUT_BT709;
         }
 
+        ATRACE_NAME("encodeJPEGR");
         res = jpegREncoder.encodeJPEGR(&p010, &jpeg, transferFunction, &jpegR);
     } else {
         const uint8_t* exifBuffer = nullptr;
@@ -355,6 +357,7 @@ status_t JpegRCompositeStream::processInputFrame(nsecs_t ts, const InputFrame &i
         exif.data = reinterpret_cast<void*>(const_cast<uint8_t*>(exifBuffer));
         exif.length = exifBufferSize;
 
+        ATRACE_NAME("encodeJPEGR");
         res = jpegREncoder.encodeJPEGR(&p010, transferFunction, &jpegR, jpegQuality, &exif);
     }
 
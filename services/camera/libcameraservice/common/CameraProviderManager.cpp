@@ -573,6 +573,37 @@ status_t CameraProviderManager::notifyUsbDeviceEvent(int32_t eventId,
     return OK;
 }
 
+status_t CameraProviderManager::notifyCameraOpenHint(const std::string &cameraId) {
+    if (!kEnableLazyHal) {
+        // Provider interfaces are held for the lifetime of the providers.
+        return OK;
+    }
+
+    ATRACE_CALL();
+    std::lock_guard<std::mutex> providerLock(mProviderLifecycleLock);
+    std::lock_guard<std::mutex> lock(mInterfaceMutex);
+
+    auto deviceInfo = findDeviceInfoLocked(cameraId);
+    if (deviceInfo == nullptr) return NAME_NOT_FOUND;
+    sp<ProviderInfo> parentProvider = deviceInfo->mParentProvider.promote();
+    if (parentProvider == nullptr) {
+        return DEAD_OBJECT;
+    }
+
+    // Start the provider without keeping a reference to it. The service manager holds the
+    // reference for at least five more seconds (see removeRef()), which covers the time
+    // until the camera open that follows the hint.
+    ALOGV("%s: Starting provider %s for camera device %s", __FUNCTION__,
+            parentProvider->mProviderName.c_str(), cameraId.c_str());
+    if (!parentProvider->successfullyStartedProviderInterface()) {
+        ALOGW("%s: Unable to start provider %s for camera device %s", __FUNCTION__,
+                parentProvider->mProviderName.c_str(), cameraId.c_str());
+        return DEAD_OBJECT;
+    }
+    IPCThreadState::self()->flushCommands();
+    return OK;
+}
+
 status_t CameraProviderManager::usbDeviceDetached(const std::string &usbDeviceId) {
     std::lock_guard<std::mutex> providerLock(mProviderLifecycleLock);
     std::lock_guard<std::mutex> interfaceLock(mInterfaceMutex);
@@ -867,13 +898,57 @@ status_t CameraProviderManager::dump(int fd, const Vector<String16>& args) {
 
 void CameraProviderManager::ProviderInfo::initializeProviderInfoCommon(
         const std::vector<std::string> &devices) {
-    for (auto& device : devices) {
-        std::string id;
-        status_t res = addDevice(device, CameraDeviceStatus::PRESENT, &id);
-        if (res != OK) {
-            ALOGE("%s: Unable to enumerate camera device '%s': %s (%d)",
-                    __FUNCTION__, device.c_str(), strerror(-res), res);
-            continue;
+    if (kEnableLazyHal || devices.size() <= 1) {
+        for (auto& device : devices) {
+            std::string id;
+            status_t res = addDevice(device, CameraDeviceStatus::PRESENT, &id);
+            if (res != OK) {
+                ALOGE("%s: Unable to enumerate camera device '%s': %s (%d)",
+                        __FUNCTION__, device.c_str(), strerror(-res), res);
+                continue;
+            }
+        }
+    } else {
+        // Fetching the static info of each device takes several binder calls to the HAL,
+        // so initialize all devices of the provider concurrently. The provider interface
+        // is held for the lifetime of the provider when lazy HALs are disabled, so device
+        // initialization doesn't touch any shared provider state.
+        struct PendingDevice {
+            std::string name;
+            std::string id;
+            std::future<std::unique_ptr<DeviceInfo>> deviceInfo;
+        };
+        std::vector<PendingDevice> pendingDevices;
+        std::set<std::pair<std::string, uint16_t>> pendingIds;
+        for (auto& device : devices) {
+            uint16_t major, minor;
+            std::string id;
+            status_t res = checkDeviceName(device, &major, &minor, &id);
+            if (res == OK && !pendingIds.emplace(id, major).second) {
+                ALOGE("%s: Device %s: ID %s is already in use for device major version %d",
+                        __FUNCTION__, device.c_str(), id.c_str(), major);
+                res = BAD_VALUE;
+            }
+            if (res != OK) {
+                ALOGE("%s: Unable to enumerate camera device '%s': %s (%d)",
+                        __FUNCTION__, device.c_str(), strerror(-res), res);
+                continue;
+            }
+            ALOGI("Enumerating new camera device: %s", device.c_str());
+            pendingDevices.push_back({device, id, std::async(std::launch::async,
+                    [this, device, id, minor]() {
+                        return initializeDeviceInfo(device, mProviderTagid, id, minor);
+                    })});
+        }
+
+        for (auto& pendingDevice : pendingDevices) {
+            std::unique_ptr<DeviceInfo> deviceInfo = pendingDevice.deviceInfo.get();
+            if (deviceInfo == nullptr) {
+                ALOGE("%s: Unable to enumerate camera device '%s': %s (%d)", __FUNCTION__,
+                        pendingDevice.name.c_str(), strerror(-BAD_VALUE), BAD_VALUE);
+                continue;
+            }
+            addDeviceInfo(std::move(deviceInfo), pendingDevice.id, CameraDeviceStatus::PRESENT);
         }
     }
 
@@ -2106,41 +2181,59 @@ status_t CameraProviderManager::ProviderInfo::addDevice(
     ALOGI("Enumerating new camera device: %s", name.c_str());
 
     uint16_t major, minor;
-    std::string type, id;
+    std::string id;
+    status_t res = checkDeviceName(name, &major, &minor, &id);
+    if (res != OK) {
+        return res;
+    }
+
+    std::unique_ptr<DeviceInfo> deviceInfo = initializeDeviceInfo(name, mProviderTagid, id, minor);
+    if (deviceInfo == nullptr) return BAD_VALUE;
+    addDeviceInfo(std::move(deviceInfo), id, initialStatus);
+
+    if (parsedId != nullptr) {
+        *parsedId = id;
+    }
+    return OK;
+}
+
+status_t CameraProviderManager::ProviderInfo::checkDeviceName(const std::string& name,
+        /*out*/ uint16_t* major, /*out*/ uint16_t* minor, /*out*/ std::string* parsedId) {
+    std::string type;
     IPCTransport transport = getIPCTransport();
 
-    status_t res = parseDeviceName(name, &major, &minor, &type, &id);
+    status_t res = parseDeviceName(name, major, minor, &type, parsedId);
     if (res != OK) {
         return res;
     }
+    const std::string& id = *parsedId;
 
     if (type != mType) {
         ALOGE("%s: Device type %s does not match provider type %s", __FUNCTION__,
                 type.c_str(), mType.c_str());
         return BAD_VALUE;
     }
-    if (mManager->isValidDeviceLocked(id, major, transport)) {
+    if (mManager->isValidDeviceLocked(id, *major, transport)) {
         ALOGE("%s: Device %s: ID %s is already in use for device major version %d", __FUNCTION__,
-                name.c_str(), id.c_str(), major);
+                name.c_str(), id.c_str(), *major);
         return BAD_VALUE;
     }
 
-    std::unique_ptr<DeviceInfo> deviceInfo;
     switch (transport) {
         case IPCTransport::HIDL:
-            switch (major) {
+            switch (*major) {
                 case 3:
                     break;
                 default:
                     ALOGE("%s: Device %s: Unsupported HIDL device HAL major version %d:",
-                          __FUNCTION__,  name.c_str(), major);
+                          __FUNCTION__,  name.c_str(), *major);
                     return BAD_VALUE;
             }
             break;
         case IPCTransport::AIDL:
-            if (major != 1) {
+            if (*major != 1) {
                 ALOGE("%s: Device %s: Unsupported AIDL device HAL major version %d:", __FUNCTION__,
-                        name.c_str(), major);
+                        name.c_str(), *major);
                 return BAD_VALUE;
             }
             break;
@@ -2149,8 +2242,11 @@ status_t CameraProviderManager::ProviderInfo::addDevice(
             return BAD_VALUE;
     }
 
-    deviceInfo = initializeDeviceInfo(name, mProviderTagid, id, minor);
-    if (deviceInfo == nullptr) return BAD_VALUE;
+    return OK;
+}
+
+void CameraProviderManager::ProviderInfo::addDeviceInfo(std::unique_ptr<DeviceInfo> deviceInfo,
+        const std::string& id, CameraDeviceStatus initialStatus) {
     deviceInfo->notifyDeviceStateChange(getDeviceState());
     deviceInfo->mStatus = initialStatus;
     bool isAPI1Compatible = deviceInfo->isAPI1Compatible();
@@ -2166,11 +2262,6 @@ status_t CameraProviderManager::ProviderInfo::addDevice(
             mUniqueAPI1CompatibleCameraIds.push_back(id);
         }
     }
-
-    if (parsedId != nullptr) {
-        *parsedId = id;
-    }
-    return OK;
 }
 
 void CameraProviderManager::ProviderInfo::removeDevice(std::string id) {
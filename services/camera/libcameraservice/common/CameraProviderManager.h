@@ -412,6 +412,12 @@ public:
 
     status_t notifyUsbDeviceEvent(int32_t eventId, const std::string &usbDeviceId);
 
+    /**
+     * Notify that the camera device is likely to be opened soon, so that a lazy camera
+     * provider can be started ahead of the open
+     */
+    status_t notifyCameraOpenHint(const std::string &cameraId);
+
     static bool isConcurrentDynamicRangeCaptureSupported(const CameraMetadata& deviceInfo,
             int64_t profile, int64_t concurrentProfile);
 
@@ -764,6 +770,14 @@ private:
                 const std::string& name, CameraDeviceStatus initialStatus,
                 /*out*/ std::string* parsedId);
 
+        // Validate a device instance name reported by the provider before initializing it
+        status_t checkDeviceName(const std::string& name,
+                /*out*/ uint16_t* major, /*out*/ uint16_t* minor, /*out*/ std::string* parsedId);
+
+        // Register an initialized device with the provider
+        void addDeviceInfo(std::unique_ptr<DeviceInfo> deviceInfo, const std::string& id,
+                CameraDeviceStatus initialStatus);
+
         void cameraDeviceStatusChangeInternal(const std::string& cameraDeviceName,
                 CameraDeviceStatus newStatus);
 
@@ -35,10 +35,12 @@
 #include <libexif/exif-data.h>
 #include <libexif/exif-system.h>
 #include <math.h>
+#include <future>
 #include <sstream>
 #include <utils/Errors.h>
 #include <utils/ExifUtils.h>
 #include <utils/Log.h>
+#include <utils/Trace.h>
 #include <xmpmeta/xmp_data.h>
 #include <xmpmeta/xmp_writer.h>
 
@@ -392,30 +394,44 @@ std::unique_ptr<dynamic_depth::DepthMap> processDepthMapFrame(DepthPhotoInputFra
     depthParams.mime = "image/jpeg";
     depthParams.depth_image_data.resize(inputFrame.mMaxJpegSize);
     depthParams.confidence_data.resize(inputFrame.mMaxJpegSize);
-    size_t actualJpegSize;
-    auto ret = encodeGrayscaleJpeg(width, height, pointsQuantized.data(),
-            depthParams.depth_image_data.data(), inputFrame.mMaxJpegSize,
-            inputFrame.mJpegQuality, exifOrientation, actualJpegSize);
+
+    // The depth and confidence maps are independent, compress the confidence map on a
+    // separate thread while the depth map is being compressed.
+    size_t actualConfidenceJpegSize = 0;
+    auto confidenceFuture = std::async(std::launch::async, [&]() {
+        ATRACE_NAME("encodeConfidenceMap");
+        return encodeGrayscaleJpeg(width, height, confidenceQuantized.data(),
+                depthParams.confidence_data.data(), inputFrame.mMaxJpegSize,
+                inputFrame.mJpegQuality, exifOrientation, actualConfidenceJpegSize);
+    });
+
+    size_t actualJpegSize = 0;
+    status_t ret;
+    {
+        ATRACE_NAME("encodeDepthMap");
+        ret = encodeGrayscaleJpeg(width, height, pointsQuantized.data(),
+                depthParams.depth_image_data.data(), inputFrame.mMaxJpegSize,
+                inputFrame.mJpegQuality, exifOrientation, actualJpegSize);
+    }
+    auto confidenceRet = confidenceFuture.get();
     if (ret != NO_ERROR) {
         ALOGE("%s: Depth map compression failed!", __FUNCTION__);
         return nullptr;
     }
     depthParams.depth_image_data.resize(actualJpegSize);
 
-    ret = encodeGrayscaleJpeg(width, height, confidenceQuantized.data(),
-            depthParams.confidence_data.data(), inputFrame.mMaxJpegSize,
-            inputFrame.mJpegQuality, exifOrientation, actualJpegSize);
-    if (ret != NO_ERROR) {
+    if (confidenceRet != NO_ERROR) {
         ALOGE("%s: Confidence map compression failed!", __FUNCTION__);
         return nullptr;
     }
-    depthParams.confidence_data.resize(actualJpegSize);
+    depthParams.confidence_data.resize(actualConfidenceJpegSize);
 
     return DepthMap::FromData(depthParams, items);
 }
 
 int processDepthPhotoFrame(DepthPhotoInputFrame inputFrame, size_t depthPhotoBufferSize,
         void* depthPhotoBuffer /*out*/, size_t* depthPhotoActualSize /*out*/) {
+    ATRACE_CALL();
     if ((inputFrame.mMainJpegBuffer == nullptr) || (inputFrame.mDepthMapBuffer == nullptr) ||
             (depthPhotoBuffer == nullptr) || (depthPhotoActualSize == nullptr)) {
         return BAD_VALUE;
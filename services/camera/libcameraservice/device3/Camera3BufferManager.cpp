@@ -18,9 +18,12 @@
 #define LOG_TAG "Camera3-BufferManager"
 #define ATRACE_TAG ATRACE_TAG_CAMERA
 
+#include <inttypes.h>
+
 #include <gui/ISurfaceComposer.h>
 #include <private/gui/ComposerService.h>
 #include <utils/Log.h>
+#include <utils/Timers.h>
 #include <utils/Trace.h>
 #include "utils/CameraTraces.h"
 #include "Camera3BufferManager.h"
@@ -242,6 +245,67 @@ status_t Camera3BufferManager::checkAndFreeBufferOnOtherStreamsLocked(
     return OK;
 }
 
+bool Camera3BufferManager::takeFreeBufferFromOtherStreamsLocked(int streamId,
+        StreamSetKey streamSetKey, GraphicBufferEntry* buffer) {
+    StreamSet &streamSet = mStreamSetMap.editValueFor(streamSetKey);
+    const StreamInfo& info = streamSet.streamInfoMap.valueFor(streamId);
+
+    // Only take over a buffer that checkAndFreeBufferOnOtherStreamsLocked() would free anyway.
+    size_t totalAllocatedBufferCount = 0;
+    for (size_t i = 0; i < streamSet.attachedBufferCountMap.size(); i++) {
+        totalAllocatedBufferCount += streamSet.attachedBufferCountMap[i];
+    }
+    if (totalAllocatedBufferCount <= streamSet.allocatedBufferWaterMark) {
+        return false;
+    }
+
+    sp<Camera3OutputStream> stream;
+    StreamId otherStreamId = CAMERA3_STREAM_ID_INVALID;
+    for (size_t i = 0; i < streamSet.streamInfoMap.size(); i++) {
+        const StreamInfo& otherInfo = streamSet.streamInfoMap[i];
+        if (otherInfo.streamId == streamId || otherInfo.width != info.width ||
+                otherInfo.height != info.height || otherInfo.format != info.format ||
+                otherInfo.combinedUsage != info.combinedUsage) {
+            continue;
+        }
+        if (streamSet.attachedBufferCountMap.valueFor(otherInfo.streamId) <=
+                streamSet.handoutBufferCountMap.valueFor(otherInfo.streamId)) {
+            continue;
+        }
+        stream = mStreamMap.valueFor(otherInfo.streamId).promote();
+        if (stream != nullptr) {
+            otherStreamId = otherInfo.streamId;
+            break;
+        }
+    }
+    if (stream == nullptr) {
+        return false;
+    }
+
+    // Need to unlock because the stream may also be calling into the buffer manager in
+    // parallel to signal buffer release, or acquire a new buffer.
+    sp<GraphicBuffer> graphicBuffer;
+    int fenceFd = -1;
+    mLock.unlock();
+    status_t res = stream->detachBuffer(&graphicBuffer, &fenceFd);
+    mLock.lock();
+    if (res != OK || graphicBuffer == nullptr) {
+        ALOGV("%s: Stream %d: unable to detach a free buffer: %s (%d)", __FUNCTION__,
+                otherStreamId, strerror(-res), res);
+        return false;
+    }
+
+    if (checkIfStreamRegisteredLocked(otherStreamId, streamSetKey)) {
+        size_t& otherAttachedBufferCount = mStreamSetMap.editValueFor(streamSetKey).
+                attachedBufferCountMap.editValueFor(otherStreamId);
+        otherAttachedBufferCount--;
+    }
+    ALOGV("Stream %d: Reusing free buffer of stream %d", streamId, otherStreamId);
+    buffer->graphicBuffer = graphicBuffer;
+    buffer->fenceFd = fenceFd;
+    return true;
+}
+
 status_t Camera3BufferManager::getBufferForStream(int streamId, int streamSetId,
         bool isMultiRes, sp<GraphicBuffer>* gb, int* fenceFd, bool noFreeBufferAtConsumer) {
     ATRACE_CALL();
@@ -283,26 +347,13 @@ status_t Camera3BufferManager::getBufferForStream(int streamId, int streamSetId,
             streamId, streamSetId, isMultiRes);
 
     if (mGrallocVersion < HARDWARE_DEVICE_API_VERSION(1,0)) {
-        const StreamInfo& info = streamSet.streamInfoMap.valueFor(streamId);
+        // Copy the stream info, as mLock may be released below.
+        const StreamInfo info = streamSet.streamInfoMap.valueFor(streamId);
         GraphicBufferEntry buffer;
         buffer.fenceFd = -1;
-        buffer.graphicBuffer = new GraphicBuffer(
-                info.width, info.height, PixelFormat(info.format), info.combinedUsage,
-                std::string("Camera3BufferManager pid [") +
-                        std::to_string(getpid()) + "]");
-        status_t res = buffer.graphicBuffer->initCheck();
-
-        ALOGV("%s: allocating a new graphic buffer (%dx%d, format 0x%x) %p with handle %p",
-                __FUNCTION__, info.width, info.height, info.format,
-                buffer.graphicBuffer.get(), buffer.graphicBuffer->handle);
-        if (res < 0) {
-            ALOGE("%s: graphic buffer allocation failed: (error %d %s) ",
-                    __FUNCTION__, res, strerror(-res));
-            return res;
-        }
-        ALOGV("%s: allocation done", __FUNCTION__);
 
-        // Increase the hand-out and attached buffer counts for tracking purposes.
+        // Increase the hand-out and attached buffer counts for tracking purposes. This is done
+        // before mLock is released, so that concurrent calls account for this buffer.
         bufferCount++;
         attachedBufferCount++;
         // Update the water mark to be the max hand-out buffer count + 1. An additional buffer is
@@ -311,6 +362,53 @@ status_t Camera3BufferManager::getBufferForStream(int streamId, int streamSetId,
         if (bufferCount + 1 > streamSet.allocatedBufferWaterMark) {
             streamSet.allocatedBufferWaterMark = bufferCount + 1;
         }
+
+        // A free buffer of another stream that is about to be freed can be used as is when the
+        // streams have the same buffer properties. Otherwise allocate a new buffer, without
+        // holding mLock since the allocation can take a while.
+        bool reused = takeFreeBufferFromOtherStreamsLocked(streamId, streamSetKey, &buffer);
+        status_t res = OK;
+        nsecs_t allocationTimeNs = 0;
+        if (!reused) {
+            mLock.unlock();
+            nsecs_t startTimeNs = systemTime();
+            buffer.graphicBuffer = new GraphicBuffer(
+                    info.width, info.height, PixelFormat(info.format), info.combinedUsage,
+                    std::string("Camera3BufferManager pid [") +
+                            std::to_string(getpid()) + "]");
+            res = buffer.graphicBuffer->initCheck();
+            allocationTimeNs = systemTime() - startTimeNs;
+            mLock.lock();
+
+            ALOGV("%s: allocating a new graphic buffer (%dx%d, format 0x%x) %p with handle %p",
+                    __FUNCTION__, info.width, info.height, info.format,
+                    buffer.graphicBuffer.get(), buffer.graphicBuffer->handle);
+        }
+
+        // The stream set map may have been modified while mLock was released.
+        if (!checkIfStreamRegisteredLocked(streamId, streamSetKey)) {
+            ALOGE("%s: stream %d was unregistered from stream set %d(%d) while getting a buffer",
+                    __FUNCTION__, streamId, streamSetId, isMultiRes);
+            return BAD_VALUE;
+        }
+        StreamSet &currentStreamSet = mStreamSetMap.editValueFor(streamSetKey);
+        if (res < 0) {
+            ALOGE("%s: graphic buffer allocation failed: (error %d %s) ",
+                    __FUNCTION__, res, strerror(-res));
+            currentStreamSet.handoutBufferCountMap.editValueFor(streamId)--;
+            currentStreamSet.attachedBufferCountMap.editValueFor(streamId)--;
+            return res;
+        }
+        if (reused) {
+            currentStreamSet.numReusedBuffers++;
+        } else {
+            ALOGV("%s: allocation done", __FUNCTION__);
+            currentStreamSet.numAllocatedBuffers++;
+            currentStreamSet.totalAllocationTimeNs += allocationTimeNs;
+            currentStreamSet.maxAllocationTimeNs =
+                    std::max(currentStreamSet.maxAllocationTimeNs, allocationTimeNs);
+        }
+
         *gb = buffer.graphicBuffer;
         *fenceFd = buffer.fenceFd;
         ALOGV("%s: get buffer (%p) with handle (%p).",
@@ -327,9 +425,11 @@ status_t Camera3BufferManager::getBufferForStream(int streamId, int streamSetId,
         }
         // Since we just allocated one new buffer above, try free one more buffer from other streams
         // to prevent total buffer count from growing
-        res = checkAndFreeBufferOnOtherStreamsLocked(streamId, streamSetKey);
-        if (res != OK) {
-            return res;
+        if (!reused) {
+            res = checkAndFreeBufferOnOtherStreamsLocked(streamId, streamSetKey);
+            if (res != OK) {
+                return res;
+            }
         }
     } else {
         // TODO: implement this.
@@ -466,6 +566,15 @@ void Camera3BufferManager::dump(int fd, [[maybe_unused]] const Vector<String16>&
                 mStreamSetMap[i].maxAllowedBufferCount);
         lines.appendFormat("          Stream set buffer count water mark: %zu\n",
                 mStreamSetMap[i].allocatedBufferWaterMark);
+        lines.appendFormat("          Allocated buffers: %zu, reused buffers: %zu\n",
+                mStreamSetMap[i].numAllocatedBuffers, mStreamSetMap[i].numReusedBuffers);
+        if (mStreamSetMap[i].numAllocatedBuffers > 0) {
+            lines.appendFormat("          Allocation time: avg %" PRId64 " us, max %" PRId64
+                    " us\n",
+                    ns2us(mStreamSetMap[i].totalAllocationTimeNs /
+                            (nsecs_t)mStreamSetMap[i].numAllocatedBuffers),
+                    ns2us(mStreamSetMap[i].maxAllocationTimeNs));
+        }
         lines.appendFormat("          Handout buffer counts:\n");
         for (size_t m = 0; m < mStreamSetMap[i].handoutBufferCountMap.size(); m++) {
             int streamId = mStreamSetMap[i].handoutBufferCountMap.keyAt(m);
@@ -284,9 +284,23 @@ private:
          */
         BufferCountMap attachedBufferCountMap;
 
+        /**
+         * Buffer statistics of this set, reported by dump(): the number of buffers allocated,
+         * the number of buffers taken over from another stream of this set instead of being
+         * allocated, and the time spent in the allocations.
+         */
+        size_t numAllocatedBuffers;
+        size_t numReusedBuffers;
+        nsecs_t totalAllocationTimeNs;
+        nsecs_t maxAllocationTimeNs;
+
         StreamSet() {
             allocatedBufferWaterMark = 0;
             maxAllowedBufferCount = 0;
+            numAllocatedBuffers = 0;
+            numReusedBuffers = 0;
+            totalAllocationTimeNs = 0;
+            maxAllocationTimeNs = 0;
         }
     };
 
@@ -324,6 +338,16 @@ private:
      * free one if so.
      */
     status_t checkAndFreeBufferOnOtherStreamsLocked(int streamId, StreamSetKey streamSetKey);
+
+    /**
+     * Check if another stream in the stream set has a free buffer that would be freed by
+     * checkAndFreeBufferOnOtherStreamsLocked(), and that can be used by this stream as is (same
+     * size, format and usage). If so, detach it from the other stream and return it, so that the
+     * caller doesn't need to allocate a new buffer. This method needs to be called with mLock
+     * held, and releases it while detaching the buffer.
+     */
+    bool takeFreeBufferFromOtherStreamsLocked(int streamId, StreamSetKey streamSetKey,
+            GraphicBufferEntry* buffer);
 };
 
 } // namespace camera3
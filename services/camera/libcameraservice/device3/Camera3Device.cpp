@@ -3098,6 +3098,9 @@ Camera3Device::RequestThread::RequestThread(wp<Camera3Device> parent,
         mDoPause(false),
         mPaused(true),
         mNotifyPipelineDrain(false),
+        mPrevClientSettingsValid(false),
+        mPrevClientRotateAndCropAuto(false),
+        mPrevClientAutoframingAuto(false),
         mFrameNumber(0),
         mLatestRequestId(NAME_NOT_FOUND),
         mCurrentAfTriggerId(0),
@@ -3812,6 +3815,17 @@ status_t Camera3Device::RequestThread::prepareHalRequests() {
                 // Request settings are all the same within one batch, so only treat the first
                 // request in a batch as new
                 !(batchedRequest && i > 0);
+        // A different request with the same settings as the latest ones sent to the HAL (a
+        // repeating burst, or a series of captures built from the same template) doesn't need
+        // to go through the mappers, and the HAL can reuse the settings it already has.
+        bool onlyRequestChanged = !triggersMixedIn &&
+                !captureRequest->mRotateAndCropChanged &&
+                !captureRequest->mAutoframingChanged &&
+                !testPatternChanged && !settingsOverrideChanged;
+        if (newRequest && onlyRequestChanged && isSameAsLatestSettings(captureRequest)) {
+            newRequest = false;
+            mPrevRequest = captureRequest;
+        }
         if (newRequest) {
             std::set<std::string> cameraIdsWithZoom;
             /**
@@ -3826,6 +3840,8 @@ status_t Camera3Device::RequestThread::prepareHalRequests() {
                 return INVALID_OPERATION;
             }
 
+            updatePrevClientSettings(captureRequest, triggersMixedIn);
+
             {
                 sp<Camera3Device> parent = mParent.promote();
                 if (parent != nullptr) {
@@ -3935,6 +3951,7 @@ status_t Camera3Device::RequestThread::prepareHalRequests() {
                             return INVALID_OPERATION;
                         }
                     }
+                    captureRequest->mSettingsPrepared = true;
                 }
             }
 
@@ -4885,6 +4902,104 @@ status_t Camera3Device::RequestThread::addFakeTriggerIds(
     return OK;
 }
 
+// Compares the entries of two metadata buffers. Sorted buffers with the same entries compare
+// equal; buffers that only differ in the order of their entries don't, which is safe since
+// this is only used to skip redundant work.
+static bool isSameMetadata(const CameraMetadata &a, const CameraMetadata &b) {
+    if (a.entryCount() != b.entryCount()) {
+        return false;
+    }
+
+    const camera_metadata_t *ma = a.getAndLock();
+    const camera_metadata_t *mb = b.getAndLock();
+    bool same = true;
+    for (size_t i = 0; same && i < a.entryCount(); i++) {
+        camera_metadata_ro_entry_t ea, eb;
+        if (get_camera_metadata_ro_entry(ma, i, &ea) != OK ||
+                get_camera_metadata_ro_entry(mb, i, &eb) != OK) {
+            same = false;
+        } else {
+            same = ea.tag == eb.tag && ea.type == eb.type && ea.count == eb.count &&
+                    memcmp(ea.data.u8, eb.data.u8,
+                            ea.count * camera_metadata_type_size[ea.type]) == 0;
+        }
+    }
+    a.unlock(ma);
+    b.unlock(mb);
+    return same;
+}
+
+static bool hasActiveTrigger(const CameraMetadata &metadata) {
+    camera_metadata_ro_entry afTrigger = metadata.find(ANDROID_CONTROL_AF_TRIGGER);
+    if (afTrigger.count > 0 && afTrigger.data.u8[0] != ANDROID_CONTROL_AF_TRIGGER_IDLE) {
+        return true;
+    }
+    camera_metadata_ro_entry pcTrigger = metadata.find(ANDROID_CONTROL_AE_PRECAPTURE_TRIGGER);
+    return pcTrigger.count > 0 &&
+            pcTrigger.data.u8[0] != ANDROID_CONTROL_AE_PRECAPTURE_TRIGGER_IDLE;
+}
+
+bool Camera3Device::RequestThread::isSameAsLatestSettings(const sp<CaptureRequest> &request) {
+    ATRACE_CALL();
+
+    // Triggers are one-shot, so a request carrying one must always be sent on its own.
+    if (mPrevRequest == nullptr ||
+            hasActiveTrigger(request->mSettingsList.begin()->metadata)) {
+        return false;
+    }
+
+    if (!request->mSettingsPrepared) {
+        // Identical client settings are prepared into identical HAL settings.
+        if (!mPrevClientSettingsValid ||
+                request->mRotateAndCropAuto != mPrevClientRotateAndCropAuto ||
+                request->mAutoframingAuto != mPrevClientAutoframingAuto ||
+                request->mSettingsList.size() != mPrevClientSettings.size()) {
+            return false;
+        }
+        auto prev = mPrevClientSettings.begin();
+        for (const auto& settings : request->mSettingsList) {
+            if (settings.cameraId != prev->first ||
+                    !isSameMetadata(settings.metadata, prev->second)) {
+                return false;
+            }
+            ++prev;
+        }
+        return true;
+    }
+
+    // The settings of a prepared request are what would be sent to the HAL.
+    Mutex::Autolock al(mLatestRequestMutex);
+    auto it = request->mSettingsList.begin();
+    if (!isSameMetadata(it->metadata, mLatestRequest) ||
+            request->mSettingsList.size() - 1 != mLatestPhysicalRequest.size()) {
+        return false;
+    }
+    for (++it; it != request->mSettingsList.end(); it++) {
+        auto latest = mLatestPhysicalRequest.find(it->cameraId);
+        if (latest == mLatestPhysicalRequest.end() ||
+                !isSameMetadata(it->metadata, latest->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Camera3Device::RequestThread::updatePrevClientSettings(const sp<CaptureRequest> &request,
+        bool triggersMixedIn) {
+    mPrevClientSettings.clear();
+    mPrevClientSettingsValid = !request->mSettingsPrepared && !triggersMixedIn &&
+            !hasActiveTrigger(request->mSettingsList.begin()->metadata);
+    if (!mPrevClientSettingsValid) {
+        return;
+    }
+
+    mPrevClientRotateAndCropAuto = request->mRotateAndCropAuto;
+    mPrevClientAutoframingAuto = request->mAutoframingAuto;
+    for (const auto& settings : request->mSettingsList) {
+        mPrevClientSettings.emplace_back(settings.cameraId, settings.metadata);
+    }
+}
+
 bool Camera3Device::RequestThread::overrideAutoRotateAndCrop(const sp<CaptureRequest> &request) {
     ATRACE_CALL();
     Mutex::Autolock l(mTriggerMutex);
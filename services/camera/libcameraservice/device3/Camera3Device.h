@@ -671,6 +671,9 @@ class Camera3Device :
         // Whether this max resolution capture request's  crop / metering region update has been
         // done.
         bool                                mUHRCropAndMeteringRegionsUpdated = false;
+        // Whether 'mSettingsList' has been prepared for the HAL (coordinate mappers and VNDK
+        // key filter applied) at least once.
+        bool                                mSettingsPrepared = false;
     };
     typedef List<sp<CaptureRequest> > RequestList;
 
@@ -1023,6 +1026,15 @@ class Camera3Device :
         // true if the current value was changed
         bool               overrideSettingsOverride(const sp<CaptureRequest> &request);
 
+        // Returns true if the settings of a request, once prepared, would be identical to the
+        // latest settings sent to the HAL, so that the HAL can be told to reuse them instead.
+        bool               isSameAsLatestSettings(const sp<CaptureRequest> &request);
+
+        // Keep a copy of the settings of a new request before they are prepared for the HAL,
+        // to be compared against the following requests that have not been prepared yet.
+        void               updatePrevClientSettings(const sp<CaptureRequest> &request,
+                                                    bool triggersMixedIn);
+
         static const nsecs_t kRequestTimeout = 50e6; // 50 ms
 
         // TODO: does this need to be adjusted for long exposure requests?
@@ -1136,6 +1148,13 @@ class Camera3Device :
         int32_t            mPrevTriggers;
         std::set<std::string> mPrevCameraIdsWithZoom;
 
+        // Settings of the latest new request as submitted by the client, i.e. before they
+        // were prepared for the HAL. Only valid if that request had not been prepared before.
+        bool               mPrevClientSettingsValid;
+        bool               mPrevClientRotateAndCropAuto;
+        bool               mPrevClientAutoframingAuto;
+        std::vector<std::pair<std::string, CameraMetadata>> mPrevClientSettings;
+
         uint32_t           mFrameNumber;
 
         mutable Mutex      mLatestRequestMutex;
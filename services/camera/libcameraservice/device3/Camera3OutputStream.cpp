@@ -532,6 +532,10 @@ void Camera3OutputStream::dump(int fd, [[maybe_unused]] const Vector<String16> &
 
     mDequeueBufferLatency.dump(fd,
         "      DequeueBuffer latency histogram:");
+
+    if (mPreviewFrameSpacer != nullptr) {
+        mPreviewFrameSpacer->dumpPacingStats(fd);
+    }
 }
 
 status_t Camera3OutputStream::setTransform(int transform, bool mayChangeMirror) {
@@ -1011,6 +1015,7 @@ status_t Camera3OutputStream::disconnectLocked() {
 
     if (mPreviewFrameSpacer != nullptr) {
         mPreviewFrameSpacer->requestExit();
+        mPreviewFrameSpacer->logPacingStats(mId);
     }
 
     ALOGV("%s: disconnecting stream %d from native window", __FUNCTION__, getId());
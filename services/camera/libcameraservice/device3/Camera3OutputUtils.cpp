@@ -228,11 +228,11 @@ void insertResultLocked(CaptureOutputStates& states, CaptureResult *result, uint
 }
 
 
-void sendPartialCaptureResult(CaptureOutputStates& states,
+// Must be called with states.outputLock held.
+void sendPartialCaptureResultLocked(CaptureOutputStates& states,
         const camera_metadata_t * partialResult,
         const CaptureResultExtras &resultExtras, uint32_t frameNumber) {
     ATRACE_CALL();
-    std::lock_guard<std::mutex> l(states.outputLock);
 
     CaptureResult captureResult;
     captureResult.mResultExtras = resultExtras;
@@ -327,6 +327,11 @@ void sendCaptureResult(
     }
 
     captureResult.mMetadata.sort();
+    // The physical camera results go through the same mappers, sort them too so that
+    // tag lookups use a binary search.
+    for (auto& physicalMetadata : captureResult.mPhysicalMetadatas) {
+        physicalMetadata.mPhysicalCameraMetadata.sort();
+    }
 
     // Check that there's a timestamp in the result metadata
     camera_metadata_entry timestamp = captureResult.mMetadata.find(ANDROID_SENSOR_TIMESTAMP);
@@ -592,6 +597,15 @@ void processCaptureResult(CaptureOutputStates& states, const camera_capture_resu
     CameraMetadata collectedPartialResult;
     bool hasInputBufferInRequest = false;
 
+    // Partial results don't need the in-flight map once their request has been updated, so
+    // they are processed after inflightLock is released. That keeps the metadata processing
+    // from blocking the request thread and the other HAL callbacks on inflightLock. The output
+    // lock is taken before inflightLock is released, so results are still queued in the order
+    // they were received.
+    bool sendPartialResult = false;
+    CaptureResultExtras partialResultExtras;
+    std::unique_lock<std::mutex> outputLock(states.outputLock, std::defer_lock);
+
     // Get shutter timestamp and resultExtras from list of in-flight requests,
     // where it was added by the shutter notification for this frame. If the
     // shutter timestamp isn't received yet, append the output buffers to the
@@ -690,9 +704,9 @@ void processCaptureResult(CaptureOutputStates& states, const camera_capture_resu
             }
 
             if (isPartialResult && request.hasCallback) {
-                // Send partial capture result
-                sendPartialCaptureResult(states, result->result, request.resultExtras,
-                        frameNumber);
+                // Send partial capture result once inflightLock is released
+                sendPartialResult = true;
+                partialResultExtras = request.resultExtras;
             }
         }
 
@@ -787,8 +801,16 @@ void processCaptureResult(CaptureOutputStates& states, const camera_capture_resu
             }
         }
         removeInFlightRequestIfReadyLocked(states, idx);
+        if (sendPartialResult) {
+            outputLock.lock();
+        }
     } // scope for states.inFlightLock
 
+    if (sendPartialResult) {
+        sendPartialCaptureResultLocked(states, result->result, partialResultExtras, frameNumber);
+        outputLock.unlock();
+    }
+
     if (result->input_buffer != NULL) {
         if (hasInputBufferInRequest) {
             Camera3Stream *stream =
@@ -144,6 +144,11 @@ void Camera3StreamSplitter::disconnect() {
     mOutputSlots.clear();
     mConsumerBufferCount.clear();
 
+    for (auto& latency : mQueueBufferLatency) {
+        latency.second.log("Output %zu queueBuffer latency histogram", latency.first);
+    }
+    mQueueBufferLatency.clear();
+
     if (mConsumer.get() != nullptr) {
         mConsumer->consumerDisconnect();
     }
@@ -271,6 +276,8 @@ status_t Camera3StreamSplitter::addOutputLocked(size_t surfaceId, const sp<Surfa
     }
     mNotifiers[gbp] = listener;
     mOutputSlots[gbp] = std::make_unique<OutputSlots>(totalBufferCount);
+    mQueueBufferLatency.erase(surfaceId);
+    mQueueBufferLatency.try_emplace(surfaceId, kQueueBufferLatencyBinSize);
 
     mMaxConsumerBuffers += maxConsumerBuffers;
     return NO_ERROR;
@@ -324,6 +331,11 @@ status_t Camera3StreamSplitter::removeOutputLocked(size_t surfaceId) {
     mOutputs[surfaceId] = nullptr;
     mOutputSurfaces[surfaceId] = nullptr;
     mOutputSlots[gbp] = nullptr;
+    auto latency = mQueueBufferLatency.find(surfaceId);
+    if (latency != mQueueBufferLatency.end()) {
+        latency->second.log("Output %zu queueBuffer latency histogram", surfaceId);
+        mQueueBufferLatency.erase(latency);
+    }
     for (const auto &id : pendingBufferIds) {
         decrementBufRefCountLocked(id, surfaceId);
     }
@@ -347,28 +359,49 @@ status_t Camera3StreamSplitter::removeOutputLocked(size_t surfaceId) {
     return res;
 }
 
-status_t Camera3StreamSplitter::outputBufferLocked(const sp<IGraphicBufferProducer>& output,
-        const BufferItem& bufferItem, size_t surfaceId) {
+status_t Camera3StreamSplitter::outputBufferLocked(const BufferItem& bufferItem,
+        const std::vector<size_t>& surfaceIds) {
     ATRACE_CALL();
-    status_t res;
+    status_t res = OK;
     IGraphicBufferProducer::QueueBufferInput queueInput(
             bufferItem.mTimestamp, bufferItem.mIsAutoTimestamp,
             bufferItem.mDataSpace, bufferItem.mCrop,
             static_cast<int32_t>(bufferItem.mScalingMode),
             bufferItem.mTransform, bufferItem.mFence);
 
-    IGraphicBufferProducer::QueueBufferOutput queueOutput;
+    struct PendingOutput {
+        size_t surfaceId;
+        sp<IGraphicBufferProducer> output;
+        int slot;
+        IGraphicBufferProducer::QueueBufferOutput queueOutput;
+        status_t res;
+        nsecs_t queueStart;
+        nsecs_t queueEnd;
+    };
+    std::vector<PendingOutput> pendingOutputs;
+    pendingOutputs.reserve(surfaceIds.size());
 
     uint64_t bufferId = bufferItem.mGraphicBuffer->getId();
     const BufferTracker& tracker = *(mBuffers[bufferId]);
-    int slot = getSlotForOutputLocked(output, tracker.getBuffer());
+    for (const auto surfaceId : surfaceIds) {
+        if (mOutputs[surfaceId] == nullptr) {
+            //Output surface got likely removed by client.
+            continue;
+        }
 
-    if (mOutputSurfaces[surfaceId] != nullptr) {
-        sp<ANativeWindow> anw = mOutputSurfaces[surfaceId];
-        camera3::Camera3Stream::queueHDRMetadata(
-                bufferItem.mGraphicBuffer->getNativeBuffer()->handle, anw, mDynamicRangeProfile);
-    } else {
-        SP_LOGE("%s: Invalid surface id: %zu!", __FUNCTION__, surfaceId);
+        PendingOutput& pending = pendingOutputs.emplace_back();
+        pending.surfaceId = surfaceId;
+        pending.output = mOutputs[surfaceId];
+        pending.slot = getSlotForOutputLocked(pending.output, tracker.getBuffer());
+
+        if (mOutputSurfaces[surfaceId] != nullptr) {
+            sp<ANativeWindow> anw = mOutputSurfaces[surfaceId];
+            camera3::Camera3Stream::queueHDRMetadata(
+                    bufferItem.mGraphicBuffer->getNativeBuffer()->handle, anw,
+                    mDynamicRangeProfile);
+        } else {
+            SP_LOGE("%s: Invalid surface id: %zu!", __FUNCTION__, surfaceId);
+        }
     }
 
     // In case the output BufferQueue has its own lock, if we hold splitter lock while calling
@@ -376,38 +409,62 @@ status_t Camera3StreamSplitter::outputBufferLocked(const sp<IGraphicBufferProduc
     // own lock calling releaseBuffer (which  will try to acquire the splitter lock), running into
     // circular lock situation.
     mMutex.unlock();
-    res = output->queueBuffer(slot, queueInput, &queueOutput);
+    for (auto& pending : pendingOutputs) {
+        pending.queueStart = systemTime();
+        pending.res = pending.output->queueBuffer(pending.slot, queueInput,
+                &pending.queueOutput);
+        pending.queueEnd = systemTime();
+    }
     mMutex.lock();
 
-    SP_LOGV("%s: Queuing buffer to buffer queue %p slot %d returns %d",
-            __FUNCTION__, output.get(), slot, res);
-    //During buffer queue 'mMutex' is not held which makes the removal of
-    //"output" possible. Check whether this is the case and return.
-    if (mOutputSlots[output] == nullptr) {
-        return res;
-    }
-    if (res != OK) {
-        if (res != NO_INIT && res != DEAD_OBJECT) {
-            SP_LOGE("Queuing buffer to output failed (%d)", res);
+    for (auto& pending : pendingOutputs) {
+        res = pending.res;
+        SP_LOGV("%s: Queuing buffer to buffer queue %p slot %d returns %d",
+                __FUNCTION__, pending.output.get(), pending.slot, res);
+        //During buffer queue 'mMutex' is not held which makes the removal of
+        //"output" possible. Check whether this is the case and move on.
+        if (mOutputSlots[pending.output] == nullptr) {
+            continue;
+        }
+
+        auto latency = mQueueBufferLatency.find(pending.surfaceId);
+        if (latency != mQueueBufferLatency.end()) {
+            latency->second.add(pending.queueStart, pending.queueEnd);
         }
-        // If we just discovered that this output has been abandoned, note
-        // that, increment the release count so that we still release this
-        // buffer eventually, and move on to the next output
-        onAbandonedLocked();
-        decrementBufRefCountLocked(bufferItem.mGraphicBuffer->getId(), surfaceId);
-        return res;
-    }
 
-    // If the queued buffer replaces a pending buffer in the async
-    // queue, no onBufferReleased is called by the buffer queue.
-    // Proactively trigger the callback to avoid buffer loss.
-    if (queueOutput.bufferReplaced) {
-        onBufferReplacedLocked(output, surfaceId);
+        if (res != OK) {
+            if (res != NO_INIT && res != DEAD_OBJECT) {
+                SP_LOGE("Queuing buffer to output failed (%d)", res);
+            }
+            // If we just discovered that this output has been abandoned, note
+            // that, increment the release count so that we still release this
+            // buffer eventually, and move on to the next output
+            onAbandonedLocked();
+            decrementBufRefCountLocked(bufferId, pending.surfaceId);
+            continue;
+        }
+
+        // If the queued buffer replaces a pending buffer in the async
+        // queue, no onBufferReleased is called by the buffer queue.
+        // Proactively trigger the callback to avoid buffer loss.
+        if (pending.queueOutput.bufferReplaced) {
+            onBufferReplacedLocked(pending.output, pending.surfaceId);
+        }
     }
 
     return res;
 }
 
+void Camera3StreamSplitter::dump(int fd) {
+    Mutex::Autolock lock(mMutex);
+
+    for (const auto& latency : mQueueBufferLatency) {
+        String8 name = String8::format("      Output %zu queueBuffer latency histogram:",
+                latency.first);
+        latency.second.dump(fd, name.string());
+    }
+}
+
 String8 Camera3StreamSplitter::getUniqueConsumerName() {
     static volatile int32_t counter = 0;
     return String8::format("Camera3StreamSplitter-%d", android_atomic_inc(&counter));
@@ -538,21 +595,10 @@ void Camera3StreamSplitter::onFrameAvailable(const BufferItem& /*item*/) {
 
     SP_LOGV("%s: BufferTracker for buffer %" PRId64 ", number of requests %zu",
            __FUNCTION__, bufferItem.mGraphicBuffer->getId(), tracker.requestedSurfaces().size());
-    for (const auto id : tracker.requestedSurfaces()) {
-
-        if (mOutputs[id] == nullptr) {
-            //Output surface got likely removed by client.
-            continue;
-        }
-
-        res = outputBufferLocked(mOutputs[id], bufferItem, id);
-        if (res != OK) {
-            SP_LOGE("%s: outputBufferLocked failed %d", __FUNCTION__, res);
-            mOnFrameAvailableRes.store(res);
-            // If we fail to send buffer to certain output, keep sending to
-            // other outputs.
-            continue;
-        }
+    // If we fail to send buffer to certain output, keep sending to other outputs.
+    res = outputBufferLocked(bufferItem, tracker.requestedSurfaces());
+    if (res != OK) {
+        SP_LOGE("%s: outputBufferLocked failed %d", __FUNCTION__, res);
     }
 
     mOnFrameAvailableRes.store(res);
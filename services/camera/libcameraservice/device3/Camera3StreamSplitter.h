@@ -30,6 +30,8 @@
 #include <utils/StrongPointer.h>
 #include <utils/Timers.h>
 
+#include "utils/LatencyHistogram.h"
+
 #define SP_LOGV(x, ...) ALOGV("[%s] " x, mConsumerName.string(), ##__VA_ARGS__)
 #define SP_LOGI(x, ...) ALOGI("[%s] " x, mConsumerName.string(), ##__VA_ARGS__)
 #define SP_LOGW(x, ...) ALOGW("[%s] " x, mConsumerName.string(), ##__VA_ARGS__)
@@ -94,6 +96,9 @@ public:
     // Disconnect the buffer queue from output surfaces.
     void disconnect();
 
+    // Dump the queueBuffer latency of each output.
+    void dump(int fd);
+
 private:
     // From IConsumerListener
     //
@@ -215,11 +220,12 @@ private:
 
     status_t removeOutputLocked(size_t surfaceId);
 
-    // Send a buffer to particular output, and increment the reference count
-    // of the buffer. If this output is abandoned, the buffer's reference count
-    // won't be incremented.
-    status_t outputBufferLocked(const sp<IGraphicBufferProducer>& output,
-            const BufferItem& bufferItem, size_t surfaceId);
+    // Send a buffer to the requested outputs. The splitter lock is released
+    // once while the buffer is queued to all the outputs, instead of once per
+    // output. If an output is abandoned, the buffer's reference count is
+    // decremented for that output. Returns the result for the last output.
+    status_t outputBufferLocked(const BufferItem& bufferItem,
+            const std::vector<size_t>& surfaceIds);
 
     // Get unique name for the buffer queue consumer
     String8 getUniqueConsumerName();
@@ -289,6 +295,10 @@ private:
     // Currently acquired input buffers
     size_t mAcquiredInputBuffers;
 
+    // Map surface ids -> queueBuffer latency of the output
+    static const int32_t kQueueBufferLatencyBinSize = 5; // in ms
+    std::unordered_map<size_t, CameraLatencyHistogram> mQueueBufferLatency;
+
     String8 mConsumerName;
 
     const bool mUseHalBufManager;
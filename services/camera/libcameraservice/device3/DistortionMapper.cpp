@@ -283,7 +283,7 @@ status_t DistortionMapper::mapRawToCorrected(int32_t *coordPairs, int coordCount
     }
 
     for (int i = 0; i < coordCount * 2; i += 2) {
-        const GridQuad *quad = findEnclosingQuad(coordPairs + i, mapperInfo->mDistortedGrid);
+        const GridQuad *quad = findEnclosingDistortedQuad(coordPairs + i, *mapperInfo);
         if (quad == nullptr) {
             ALOGE("Raw to corrected mapping failure: No quad found for (%d, %d)",
                     *(coordPairs + i), *(coordPairs + i + 1));
@@ -493,47 +493,131 @@ status_t DistortionMapper::buildGrids(DistortionMapperInfo *mapperInfo) {
         }
     }
 
+    buildDistortedGridBuckets(mapperInfo);
+
     mapperInfo->mValidGrids = true;
     return OK;
 }
 
+size_t DistortionMapper::getBucketIndex(float value, float min, float invBucketSize) {
+    float index = std::floor((value - min) * invBucketSize);
+    return static_cast<size_t>(std::clamp(index, 0.f, static_cast<float>(kGridSize - 1)));
+}
+
+void DistortionMapper::buildDistortedGridBuckets(DistortionMapperInfo *mapperInfo) {
+    const std::vector<GridQuad>& grid = mapperInfo->mDistortedGrid;
+
+    float minX = grid[0].coords[0], maxX = grid[0].coords[0];
+    float minY = grid[0].coords[1], maxY = grid[0].coords[1];
+    for (const GridQuad& quad : grid) {
+        for (size_t k = 0; k < quad.coords.size(); k += 2) {
+            minX = std::min(minX, quad.coords[k]);
+            maxX = std::max(maxX, quad.coords[k]);
+            minY = std::min(minY, quad.coords[k + 1]);
+            maxY = std::max(maxY, quad.coords[k + 1]);
+        }
+    }
+    mapperInfo->mBucketMinX = minX;
+    mapperInfo->mBucketMaxX = maxX;
+    mapperInfo->mBucketMinY = minY;
+    mapperInfo->mBucketMaxY = maxY;
+    mapperInfo->mInvBucketWidth = (maxX > minX) ? kGridSize / (maxX - minX) : 0.f;
+    mapperInfo->mInvBucketHeight = (maxY > minY) ? kGridSize / (maxY - minY) : 0.f;
+
+    auto& buckets = mapperInfo->mDistortedGridBuckets;
+    buckets.resize(kGridSize * kGridSize);
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+
+    for (size_t index = 0; index < grid.size(); index++) {
+        const GridQuad& quad = grid[index];
+        float quadMinX = quad.coords[0], quadMaxX = quad.coords[0];
+        float quadMinY = quad.coords[1], quadMaxY = quad.coords[1];
+        for (size_t k = 2; k < quad.coords.size(); k += 2) {
+            quadMinX = std::min(quadMinX, quad.coords[k]);
+            quadMaxX = std::max(quadMaxX, quad.coords[k]);
+            quadMinY = std::min(quadMinY, quad.coords[k + 1]);
+            quadMaxY = std::max(quadMaxY, quad.coords[k + 1]);
+        }
+        size_t bx0 = getBucketIndex(quadMinX, minX, mapperInfo->mInvBucketWidth);
+        size_t bx1 = getBucketIndex(quadMaxX, minX, mapperInfo->mInvBucketWidth);
+        size_t by0 = getBucketIndex(quadMinY, minY, mapperInfo->mInvBucketHeight);
+        size_t by1 = getBucketIndex(quadMaxY, minY, mapperInfo->mInvBucketHeight);
+        for (size_t by = by0; by <= by1; by++) {
+            for (size_t bx = bx0; bx <= bx1; bx++) {
+                buckets[by * kGridSize + bx].push_back(static_cast<uint16_t>(index));
+            }
+        }
+    }
+}
+
+const DistortionMapper::GridQuad* DistortionMapper::findEnclosingDistortedQuad(
+        const int32_t pt[2], const DistortionMapperInfo& mapperInfo) {
+    const float x = pt[0];
+    const float y = pt[1];
+
+    if (mapperInfo.mDistortedGridBuckets.size() == kGridSize * kGridSize &&
+            x >= mapperInfo.mBucketMinX && x <= mapperInfo.mBucketMaxX &&
+            y >= mapperInfo.mBucketMinY && y <= mapperInfo.mBucketMaxY) {
+        size_t bx = getBucketIndex(x, mapperInfo.mBucketMinX, mapperInfo.mInvBucketWidth);
+        size_t by = getBucketIndex(y, mapperInfo.mBucketMinY, mapperInfo.mInvBucketHeight);
+        for (uint16_t index : mapperInfo.mDistortedGridBuckets[by * kGridSize + bx]) {
+            const GridQuad& quad = mapperInfo.mDistortedGrid[index];
+            if (isPointInQuad(x, y, quad)) {
+                return &quad;
+            }
+        }
+    }
+
+    // Fall back to testing every quad, in case the point lies on a quad that is not
+    // convex enough for its bounding box to contain it.
+    return findEnclosingQuad(pt, mapperInfo.mDistortedGrid);
+}
+
 const DistortionMapper::GridQuad* DistortionMapper::findEnclosingQuad(
         const int32_t pt[2], const std::vector<GridQuad>& grid) {
     const float x = pt[0];
     const float y = pt[1];
 
     for (const GridQuad& quad : grid) {
-        const float &x1 = quad.coords[0];
-        const float &y1 = quad.coords[1];
-        const float &x2 = quad.coords[2];
-        const float &y2 = quad.coords[3];
-        const float &x3 = quad.coords[4];
-        const float &y3 = quad.coords[5];
-        const float &x4 = quad.coords[6];
-        const float &y4 = quad.coords[7];
-
-        // Point-in-quad test:
-
-        // Quad has corners P1-P4; if P is within the quad, then it is on the same side of all the
-        // edges (or on top of one of the edges or corners), traversed in a consistent direction.
-        // This means that the cross product of edge En = Pn->P(n+1 mod 4) and line Ep = Pn->P must
-        // have the same sign (or be zero) for all edges.
-        // For clockwise traversal, the sign should be negative or zero for Ep x En, indicating that
-        // En is to the left of Ep, or overlapping.
-        float s1 = (x - x1) * (y2 - y1) - (y - y1) * (x2 - x1);
-        if (s1 > 0) continue;
-        float s2 = (x - x2) * (y3 - y2) - (y - y2) * (x3 - x2);
-        if (s2 > 0) continue;
-        float s3 = (x - x3) * (y4 - y3) - (y - y3) * (x4 - x3);
-        if (s3 > 0) continue;
-        float s4 = (x - x4) * (y1 - y4) - (y - y4) * (x1 - x4);
-        if (s4 > 0) continue;
-
-        return &quad;
+        if (isPointInQuad(x, y, quad)) {
+            return &quad;
+        }
     }
     return nullptr;
 }
 
+bool DistortionMapper::isPointInQuad(float x, float y, const GridQuad& quad) {
+    const float &x1 = quad.coords[0];
+    const float &y1 = quad.coords[1];
+    const float &x2 = quad.coords[2];
+    const float &y2 = quad.coords[3];
+    const float &x3 = quad.coords[4];
+    const float &y3 = quad.coords[5];
+    const float &x4 = quad.coords[6];
+    const float &y4 = quad.coords[7];
+
+    // Point-in-quad test:
+
+    // Quad has corners P1-P4; if P is within the quad, then it is on the same side of all the
+    // edges (or on top of one of the edges or corners), traversed in a consistent direction.
+    // This means that the cross product of edge En = Pn->P(n+1 mod 4) and line Ep = Pn->P must
+    // have the same sign (or be zero) for all edges.
+    // For clockwise traversal, the sign should be negative or zero for Ep x En, indicating that
+    // En is to the left of Ep, or overlapping.
+    float s1 = (x - x1) * (y2 - y1) - (y - y1) * (x2 - x1);
+    if (s1 > 0) return false;
+    float s2 = (x - x2) * (y3 - y2) - (y - y2) * (x3 - x2);
+    if (s2 > 0) return false;
+    float s3 = (x - x3) * (y4 - y3) - (y - y3) * (x4 - x3);
+    if (s3 > 0) return false;
+    float s4 = (x - x4) * (y1 - y4) - (y - y4) * (x1 - x4);
+    if (s4 > 0) return false;
+
+    return true;
+}
+
 float DistortionMapper::calculateUorV(const int32_t pt[2], const GridQuad& quad, bool calculateU) {
     const float x = pt[0];
     const float y = pt[1];
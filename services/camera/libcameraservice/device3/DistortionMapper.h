@@ -155,12 +155,24 @@ class DistortionMapper : public CoordinateMapper {
 
         std::vector<GridQuad> mCorrectedGrid;
         std::vector<GridQuad> mDistortedGrid;
+
+        // Spatial index of mDistortedGrid: the bounding box of the distorted grid is split
+        // into kGridSize x kGridSize buckets, and each bucket lists, in grid order, the
+        // quads whose bounding boxes overlap it.
+        std::vector<std::vector<uint16_t>> mDistortedGridBuckets;
+        float mBucketMinX, mBucketMinY, mBucketMaxX, mBucketMaxY;
+        float mInvBucketWidth, mInvBucketHeight;
     };
 
     // Find which grid quad encloses the point; returns null if none do
     static const GridQuad* findEnclosingQuad(
             const int32_t pt[2], const std::vector<GridQuad>& grid);
 
+    // Same as above for the distorted grid, but only tests the quads listed in the
+    // bucket containing the point
+    static const GridQuad* findEnclosingDistortedQuad(
+            const int32_t pt[2], const DistortionMapperInfo& mapperInfo);
+
     // Calculate 'horizontal' interpolation coordinate for the point and the quad
     // Assumes the point P is within the quad Q.
     // Given quad with points P1-P4, and edges E12-E41, and considering the edge segments as
@@ -208,6 +220,10 @@ class DistortionMapper : public CoordinateMapper {
 
     // Utility to create reverse mapping grids
     status_t buildGrids(DistortionMapperInfo *mapperInfo);
+    static void buildDistortedGridBuckets(DistortionMapperInfo *mapperInfo);
+    static size_t getBucketIndex(float value, float min, float invBucketSize);
+
+    static bool isPointInQuad(float x, float y, const GridQuad& quad);
 
     DistortionMapperInfo mDistortionMapperInfo;
     DistortionMapperInfo mDistortionMapperInfoMaximumResolution;
@@ -95,6 +95,17 @@ void PreviewFrameSpacer::requestExit() {
     mBufferCond.signal();
 }
 
+void PreviewFrameSpacer::dumpPacingStats(int fd) const {
+    Mutex::Autolock l(mLock);
+    mPacingJitter.dump(fd, "      Preview spacer pacing jitter histogram:");
+}
+
+void PreviewFrameSpacer::logPacingStats(int streamId) {
+    Mutex::Autolock l(mLock);
+    mPacingJitter.log("Stream %d preview spacer pacing jitter histogram", streamId);
+    mPacingJitter.reset();
+}
+
 void PreviewFrameSpacer::queueBufferToClientLocked(
         const BufferHolder& bufferHolder, nsecs_t currentTime) {
     sp<Camera3OutputStream> parent = mParent.promote();
@@ -125,6 +136,13 @@ void PreviewFrameSpacer::queueBufferToClientLocked(
     }
 
     parent->onCachedBufferQueued();
+
+    // Frames after a long gap are queued right away and don't count towards pacing.
+    nsecs_t readoutInterval = bufferHolder.readoutTimestamp - mLastCameraReadoutTime;
+    if (mLastCameraPresentTime != 0 && readoutInterval < kFrameIntervalThreshold) {
+        nsecs_t presentInterval = currentTime - mLastCameraPresentTime;
+        mPacingJitter.add(0, std::abs(presentInterval - readoutInterval));
+    }
     mLastCameraPresentTime = currentTime;
     mLastCameraReadoutTime = bufferHolder.readoutTimestamp;
 }
@@ -25,6 +25,8 @@
 #include <utils/Thread.h>
 #include <utils/Timers.h>
 
+#include "utils/LatencyHistogram.h"
+
 namespace android {
 
 namespace camera3 {
@@ -59,6 +61,11 @@ class PreviewFrameSpacer : public Thread {
     bool threadLoop() override;
     void requestExit() override;
 
+    // Dump the histogram of the difference between presentation and readout intervals
+    void dumpPacingStats(int fd) const;
+    // Log and reset the pacing histogram, typically when the stream is disconnected
+    void logPacingStats(int streamId);
+
   private:
     // structure holding cached preview buffer info
     struct BufferHolder {
@@ -83,6 +90,9 @@ class PreviewFrameSpacer : public Thread {
     std::queue<BufferHolder> mPendingBuffers;
     nsecs_t mLastCameraReadoutTime = 0;
     nsecs_t mLastCameraPresentTime = 0;
+    // How far the spacing of queued buffers deviates from the camera readout spacing
+    static constexpr int32_t kPacingJitterBinSizeMs = 2;
+    CameraLatencyHistogram mPacingJitter{kPacingJitterBinSizeMs};
     static constexpr nsecs_t kWaitDuration = 5000000LL; // 50ms
     static constexpr nsecs_t kFrameIntervalThreshold = 80000000LL; // 80ms
     static constexpr nsecs_t kMaxFrameWaitTime = 10000000LL; // 10ms
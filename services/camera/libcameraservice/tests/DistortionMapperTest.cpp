@@ -348,6 +348,39 @@ TEST(DistortionMapperTest, LargeTransform) {
     RandomTransformTest(this, testActiveArray, m, /*clamp*/false, /*simple*/false);
 }
 
+// Verify that the bucketed distorted grid lookup finds the same quads as a full scan
+TEST(DistortionMapperTest, EnclosingQuadLookup) {
+    float bigDistortion[] = {0.1, -0.003, 0.004, 0.02, 0.01};
+    status_t res;
+
+    DistortionMapper m;
+    setupTestMapper(&m, bigDistortion, testICal,
+            /*activeArray*/testActiveArray,
+            /*preCorrectionActiveArray*/testPreCorrActiveArray);
+
+    // Build the grids
+    DistortionMapperInfo *mapperInfo = m.getMapperInfo();
+    int32_t coords[2] = {testActiveArray[2] / 2, testActiveArray[3] / 2};
+    res = m.mapRawToCorrected(coords, 1, mapperInfo, /*clamp*/false, /*simple*/false);
+    ASSERT_EQ(res, OK);
+
+    unsigned int seed = 1234;
+    std::default_random_engine gen(seed);
+    std::uniform_int_distribution<int> x_dist(-testPreCorrActiveArray[2] / 2,
+            testPreCorrActiveArray[2] * 3 / 2);
+    std::uniform_int_distribution<int> y_dist(-testPreCorrActiveArray[3] / 2,
+            testPreCorrActiveArray[3] * 3 / 2);
+
+    for (size_t i = 0; i < 10000; i++) {
+        int32_t pt[2] = {x_dist(gen), y_dist(gen)};
+        const DistortionMapper::GridQuad *expected =
+                DistortionMapper::findEnclosingQuad(pt, mapperInfo->mDistortedGrid);
+        const DistortionMapper::GridQuad *quad =
+                DistortionMapper::findEnclosingDistortedQuad(pt, *mapperInfo);
+        EXPECT_EQ(quad, expected) << "(" << pt[0] << "," << pt[1] << ")";
+    }
+}
+
 // Compare against values calculated by OpenCV
 // undistortPoints() method, which is the same as mapRawToCorrected
 // Ignore clamping
@@ -135,29 +135,55 @@ void TagMonitor::monitorMetadata(eventSource source, int64_t frameNumber, nsecs_
         int32_t streamId = camera3::Camera3Stream::cast(src->stream)->getId();
         outputStreamIds.emplace(streamId);
     }
+    if (mMonitoredTagList.empty()) return;
+
+    // Monitor when the stream ids change, this helps visually see what
+    // monitored metadata values are for capture requests with different
+    // stream ids. The stream ids are shared by all tags and cameras of the
+    // request, so only check them once.
     std::string emptyId;
+    if (source == REQUEST) {
+        if (inputStreamId != mLastInputStreamId) {
+            mMonitoringEvents.emplace(source, frameNumber, timestamp, camera_metadata_ro_entry_t{},
+                                      emptyId, std::unordered_set<int>(), inputStreamId);
+            mLastInputStreamId = inputStreamId;
+        }
+
+        if (outputStreamIds != mLastStreamIds) {
+            mMonitoringEvents.emplace(source, frameNumber, timestamp, camera_metadata_ro_entry_t{},
+                                      emptyId, outputStreamIds, -1);
+            mLastStreamIds = outputStreamIds;
+        }
+    }
+
+    // Look up the latest-seen values of each camera once, instead of once per tag
+    std::vector<CameraMetadata*> physicalLastValues;
+    physicalLastValues.reserve(physicalMetadata.size());
+    for (auto& m : physicalMetadata) {
+        physicalLastValues.push_back(&getLastMonitoredValues(source, m.first));
+    }
+    CameraMetadata &lastValues = getLastMonitoredValues(source, emptyId);
+
     for (auto tag : mMonitoredTagList) {
         monitorSingleMetadata(source, frameNumber, timestamp, emptyId, tag, metadata,
-                outputStreamIds, inputStreamId);
+                lastValues, outputStreamIds, inputStreamId);
 
+        size_t i = 0;
         for (auto& m : physicalMetadata) {
             monitorSingleMetadata(source, frameNumber, timestamp, m.first, tag, m.second,
-                    outputStreamIds, inputStreamId);
+                    *physicalLastValues[i++], outputStreamIds, inputStreamId);
         }
     }
 }
 
-void TagMonitor::monitorSingleMetadata(eventSource source, int64_t frameNumber, nsecs_t timestamp,
-        const std::string& cameraId, uint32_t tag, const CameraMetadata& metadata,
-        const std::unordered_set<int32_t> &outputStreamIds, int32_t inputStreamId) {
-
+CameraMetadata& TagMonitor::getLastMonitoredValues(eventSource source,
+        const std::string& cameraId) {
     CameraMetadata &lastValues = (source == REQUEST) ?
             (cameraId.empty() ? mLastMonitoredRequestValues :
                     mLastMonitoredPhysicalRequestKeys[cameraId]) :
             (cameraId.empty() ? mLastMonitoredResultValues :
                     mLastMonitoredPhysicalResultKeys[cameraId]);
 
-    camera_metadata_ro_entry entry = metadata.find(tag);
     if (lastValues.isEmpty()) {
         lastValues = CameraMetadata(mMonitoredTagList.size());
         const camera_metadata_t *metaBuffer =
@@ -166,25 +192,17 @@ void TagMonitor::monitorSingleMetadata(eventSource source, int64_t frameNumber,
                 const_cast<camera_metadata_t *> (metaBuffer), mVendorTagId);
         lastValues.unlock(metaBuffer);
     }
+    return lastValues;
+}
 
-    camera_metadata_entry lastEntry = lastValues.find(tag);
+void TagMonitor::monitorSingleMetadata(eventSource source, int64_t frameNumber, nsecs_t timestamp,
+        const std::string& cameraId, uint32_t tag, const CameraMetadata& metadata,
+        CameraMetadata& lastValues, const std::unordered_set<int32_t> &outputStreamIds,
+        int32_t inputStreamId) {
 
-    // Monitor when the stream ids change, this helps visually see what
-    // monitored metadata values are for capture requests with different
-    // stream ids.
-    if (source == REQUEST) {
-        if (inputStreamId != mLastInputStreamId) {
-            mMonitoringEvents.emplace(source, frameNumber, timestamp, camera_metadata_ro_entry_t{},
-                                      cameraId, std::unordered_set<int>(), inputStreamId);
-            mLastInputStreamId = inputStreamId;
-        }
+    camera_metadata_ro_entry entry = metadata.find(tag);
+    camera_metadata_entry lastEntry = lastValues.find(tag);
 
-        if (outputStreamIds != mLastStreamIds) {
-            mMonitoringEvents.emplace(source, frameNumber, timestamp, camera_metadata_ro_entry_t{},
-                                      cameraId, outputStreamIds, -1);
-            mLastStreamIds = outputStreamIds;
-        }
-    }
     if (entry.count > 0) {
         bool isDifferent = false;
         if (lastEntry.count > 0) {
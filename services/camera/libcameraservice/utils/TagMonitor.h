@@ -88,10 +88,14 @@ class TagMonitor {
     static String8 getEventDataString(const uint8_t* data_ptr, uint32_t tag, int type, int count,
                                       int indentation);
 
+    // Get the latest-seen values of the tracked tags for a camera, creating the
+    // metadata buffer on first use
+    CameraMetadata& getLastMonitoredValues(eventSource source, const std::string& cameraId);
+
     void monitorSingleMetadata(TagMonitor::eventSource source, int64_t frameNumber,
             nsecs_t timestamp, const std::string& cameraId, uint32_t tag,
-            const CameraMetadata& metadata, const std::unordered_set<int32_t> &outputStreamIds,
-            int32_t inputStreamId);
+            const CameraMetadata& metadata, CameraMetadata& lastValues,
+            const std::unordered_set<int32_t> &outputStreamIds, int32_t inputStreamId);
 
     std::atomic<bool> mMonitoringEnabled;
     std::mutex mMonitorMutex;
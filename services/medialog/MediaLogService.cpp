@@ -131,6 +131,16 @@ status_t MediaLogService::dump(int fd, const Vector<String16>& args __unused)
                 }
             }
             mLock.unlock();
+        } else if (!strcmp(arg0.string(), "--binary")) {
+            // raw logs for offline merging, see NBLog::ExportHeader
+            if (!dumpTryLock(mLock)) {
+                return NO_ERROR;
+            }
+            NBLog::DumpReader::dumpBinaryHeader(fd, mDumpReaders.size());
+            for (const auto &dumpReader : mDumpReaders) {
+                dumpReader->dumpBinary(fd);
+            }
+            mLock.unlock();
         } else {
             mMergeReader.dump(fd, args);
         }
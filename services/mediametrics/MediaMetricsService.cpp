@@ -300,61 +300,68 @@ status_t MediaMetricsService::dump(int fd, const Vector<String16>& args)
         }
     }
     std::stringstream result;
-    {
+    if (clear) {
         std::lock_guard _l(mLock);
+        mItemsDiscarded += (int64_t)mItems.size();
+        mItems.clear();
+        mAudioAnalytics.clear();
+    } else {
+        // Only take a snapshot of the queue under the lock, so that formatting
+        // the items does not block the binder threads submitting new ones.
+        // AudioAnalytics and the logs below have their own locks.
+        const char *prefixptr = prefix.size() > 0 ? prefix.c_str() : nullptr;
+        std::string headers;
+        std::vector<std::shared_ptr<const mediametrics::Item>> items;
+        {
+            std::lock_guard _l(mLock);
+            headers = dumpHeaders(sinceNs, prefixptr);
+            items.assign(mItems.begin(), mItems.end());
+        }
+        result << StringPrintf("Dump of the %s process:\n", kServiceName);
+        result << headers;
+        result << dumpQueue(items, sinceNs, prefixptr);
+
+        // TODO: maybe consider a better way of dumping audio analytics info.
+        const int32_t linesToDump = all ? INT32_MAX : 1000;
+        auto [ dumpString, lines ] = mAudioAnalytics.dump(linesToDump, sinceNs, prefixptr);
+        result << dumpString;
+        if (lines == linesToDump) {
+            result << "-- some lines may be truncated --\n";
+        }
 
-        if (clear) {
-            mItemsDiscarded += (int64_t)mItems.size();
-            mItems.clear();
-            mAudioAnalytics.clear();
-        } else {
-            result << StringPrintf("Dump of the %s process:\n", kServiceName);
-            const char *prefixptr = prefix.size() > 0 ? prefix.c_str() : nullptr;
-            result << dumpHeaders(sinceNs, prefixptr);
-            result << dumpQueue(sinceNs, prefixptr);
-
-            // TODO: maybe consider a better way of dumping audio analytics info.
-            const int32_t linesToDump = all ? INT32_MAX : 1000;
-            auto [ dumpString, lines ] = mAudioAnalytics.dump(linesToDump, sinceNs, prefixptr);
-            result << dumpString;
-            if (lines == linesToDump) {
-                result << "-- some lines may be truncated --\n";
-            }
-
-            const int32_t heatLinesToDump = all ? INT32_MAX : 20;
-            const auto [ heatDumpString, heatLines] =
-                    mAudioAnalytics.dumpHeatMap(heatLinesToDump);
-            result << "\n" << heatDumpString;
-            if (heatLines == heatLinesToDump) {
-                result << "-- some lines may be truncated --\n";
-            }
+        const int32_t heatLinesToDump = all ? INT32_MAX : 20;
+        const auto [ heatDumpString, heatLines] =
+                mAudioAnalytics.dumpHeatMap(heatLinesToDump);
+        result << "\n" << heatDumpString;
+        if (heatLines == heatLinesToDump) {
+            result << "-- some lines may be truncated --\n";
+        }
 
-            const int32_t healthLinesToDump = all ? INT32_MAX : 15;
-            result << "\nHealth Message Log:";
-            const auto [ healthDumpString, healthLines ] =
-                    mAudioAnalytics.dumpHealth(healthLinesToDump);
-            result << "\n" << healthDumpString;
-            if (healthLines == healthLinesToDump) {
-                result << "-- some lines may be truncated --\n";
-            }
+        const int32_t healthLinesToDump = all ? INT32_MAX : 15;
+        result << "\nHealth Message Log:";
+        const auto [ healthDumpString, healthLines ] =
+                mAudioAnalytics.dumpHealth(healthLinesToDump);
+        result << "\n" << healthDumpString;
+        if (healthLines == healthLinesToDump) {
+            result << "-- some lines may be truncated --\n";
+        }
 
-            const int32_t spatializerLinesToDump = all ? INT32_MAX : 15;
-            result << "\nSpatializer Message Log:";
-            const auto [ spatializerDumpString, spatializerLines ] =
-                    mAudioAnalytics.dumpSpatializer(spatializerLinesToDump);
-            result << "\n" << spatializerDumpString;
-            if (spatializerLines == spatializerLinesToDump) {
-                result << "-- some lines may be truncated --\n";
-            }
+        const int32_t spatializerLinesToDump = all ? INT32_MAX : 15;
+        result << "\nSpatializer Message Log:";
+        const auto [ spatializerDumpString, spatializerLines ] =
+                mAudioAnalytics.dumpSpatializer(spatializerLinesToDump);
+        result << "\n" << spatializerDumpString;
+        if (spatializerLines == spatializerLinesToDump) {
+            result << "-- some lines may be truncated --\n";
+        }
 
-            result << "\nLogSessionId:\n"
-                   << mediametrics::ValidateId::get()->dump();
+        result << "\nLogSessionId:\n"
+               << mediametrics::ValidateId::get()->dump();
 
-            // Dump the statsd atoms we sent out.
-            result << "\nStatsd atoms:\n"
-                   << mStatsdLog->dumpToString("  " /* prefix */,
-                           all ? STATSD_LOG_LINES_MAX : STATSD_LOG_LINES_DUMP);
-        }
+        // Dump the statsd atoms we sent out.
+        result << "\nStatsd atoms:\n"
+               << mStatsdLog->dumpToString("  " /* prefix */,
+                       all ? STATSD_LOG_LINES_MAX : STATSD_LOG_LINES_DUMP);
     }
     const std::string str = result.str();
     write(fd, str.c_str(), str.size());
@@ -400,14 +407,17 @@ std::string MediaMetricsService::dumpHeaders(int64_t sinceNs, const char* prefix
 }
 
 // TODO: should prefix be a set<string>?
-std::string MediaMetricsService::dumpQueue(int64_t sinceNs, const char* prefix)
+/* static */
+std::string MediaMetricsService::dumpQueue(
+        const std::vector<std::shared_ptr<const mediametrics::Item>>& items,
+        int64_t sinceNs, const char* prefix)
 {
-    if (mItems.empty()) {
+    if (items.empty()) {
         return "empty\n";
     }
     std::stringstream result;
     int slot = 0;
-    for (const auto &item : mItems) {         // TODO: consider std::lower_bound() on mItems
+    for (const auto &item : items) {          // TODO: consider std::lower_bound() on items
         if (item->getTimestamp() < sinceNs) { // sinceNs == 0 means all items shown
             continue;
         }
@@ -18,7 +18,11 @@
 
 #include <android-base/thread_annotations.h>
 #include <media/MediaMetricsItem.h>
+#include <algorithm>
+#include <map>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace android::mediametrics {
 
@@ -80,6 +84,7 @@ public:
         std::lock_guard l(mLock);
         mFilters.emplace(Trigger{ std::forward<T>(url), std::forward<U>(value) },
                 std::forward<A>(action));
+        mIndexValid = false;
     }
 
     // TODO: remove an action.
@@ -93,20 +98,77 @@ public:
     getActionsForItem(const std::shared_ptr<const mediametrics::Item>& item) {
         std::vector<Action> actions;
         std::lock_guard l(mLock);
+        if (!mIndexValid) buildIndex_l();
+
+        // Only the filters indexed by a prefix of the item key can match.
+        const std::string& itemKey = item->getKey();
+        std::vector<size_t> candidates;
+        addCandidates_l(mFiltersByKey, itemKey, &candidates);
+        addCandidates_l(mFiltersByPrefix, std::string{}, &candidates);
+        for (size_t pos = itemKey.find('.'); pos != std::string::npos;
+                pos = itemKey.find('.', pos + 1)) {
+            addCandidates_l(mFiltersByPrefix, itemKey.substr(0, pos + 1), &candidates);
+        }
 
-        for (const auto &[trigger, action] : mFilters) {
+        // Keep the order of mFilters, as without the index.
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        for (const size_t index : candidates) {
+            const auto& [trigger, action] = *mIndexedFilters[index];
             if (isWildcardMatch(trigger, item) ==
                     mediametrics::Item::RECURSIVE_WILDCARD_CHECK_MATCH_FOUND) {
                 actions.push_back(action);
             }
         }
-
-        // TODO: Optimize for prefix search and wildcarding.
-
         return actions;
     }
 
 private:
+    using FilterType = std::multimap<Trigger, Action>;
+    using IndexType = std::unordered_map<std::string, std::vector<size_t>>;
+
+    static void addCandidates_l(const IndexType& index, const std::string& key,
+            std::vector<size_t>* candidates) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            candidates->insert(candidates->end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    /**
+     * Indexes the filters by the item keys which may match them.
+     *
+     * Let L be the literal part of the url, before any '*'.
+     * An item key matching the url either ends inside L, just before a '.',
+     * or, if the url has a wildcard, starts with L.  Filters are indexed in
+     * mFiltersByKey under each such exact key, and in mFiltersByPrefix under L
+     * truncated after its last '.', which is a prefix of the item key ending
+     * with '.' (or empty).
+     *
+     * The index only selects candidates, which are then checked with the wildcard match.
+     */
+    void buildIndex_l() REQUIRES(mLock) {
+        mIndexedFilters.clear();
+        mFiltersByKey.clear();
+        mFiltersByPrefix.clear();
+        for (auto it = mFilters.cbegin(); it != mFilters.cend(); ++it) {
+            const size_t index = mIndexedFilters.size();
+            mIndexedFilters.push_back(it);
+            const std::string& url = it->first.first;
+            const size_t wildcard = url.find('*');
+            const std::string literal = url.substr(0, wildcard);
+            for (size_t pos = literal.find('.'); pos != std::string::npos;
+                    pos = literal.find('.', pos + 1)) {
+                mFiltersByKey[literal.substr(0, pos)].push_back(index);
+            }
+            if (wildcard != std::string::npos) {
+                const size_t lastDot = literal.rfind('.');
+                mFiltersByPrefix[lastDot == std::string::npos
+                        ? std::string{} : literal.substr(0, lastDot + 1)].push_back(index);
+            }
+        }
+        mIndexValid = true;
+    }
 
     static inline bool isMatch(const Trigger& trigger,
             const std::shared_ptr<const mediametrics::Item>& item) {
@@ -125,8 +187,13 @@ private:
 
     mutable std::mutex mLock;
 
-    using FilterType = std::multimap<Trigger, Action>;
     FilterType mFilters GUARDED_BY(mLock);
+
+    // Index of mFilters, rebuilt on the first query after an action is added.
+    bool mIndexValid GUARDED_BY(mLock) = false;
+    std::vector<FilterType::const_iterator> mIndexedFilters GUARDED_BY(mLock);
+    IndexType mFiltersByKey GUARDED_BY(mLock);
+    IndexType mFiltersByPrefix GUARDED_BY(mLock);
 };
 
 } // namespace android::mediametrics
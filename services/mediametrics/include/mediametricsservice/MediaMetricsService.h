@@ -100,7 +100,9 @@ private:
     bool expirations(const std::shared_ptr<const mediametrics::Item>& item) REQUIRES(mLock);
 
     // support for generating output
-    std::string dumpQueue(int64_t sinceNs, const char* prefix) REQUIRES(mLock);
+    static std::string dumpQueue(
+            const std::vector<std::shared_ptr<const mediametrics::Item>>& items,
+            int64_t sinceNs, const char* prefix);
     std::string dumpHeaders(int64_t sinceNs, const char* prefix) REQUIRES(mLock);
 
     // support statsd pushed atoms
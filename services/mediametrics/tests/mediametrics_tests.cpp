@@ -826,6 +826,50 @@ TEST(mediametrics_tests, analytics_actions) {
   ASSERT_EQ(false, action4); // audio.fl*gn*r != audio.flinger
 }
 
+TEST(mediametrics_tests, analytics_actions_index) {
+  mediametrics::AnalyticsActions analyticsActions;
+  int trackActions = 0;
+  int threadActions = 0;
+
+  analyticsActions.addAction(
+      "audio.track.*.event",
+      std::string("start"),
+      std::make_shared<mediametrics::AnalyticsActions::Function>(
+          [&](const std::shared_ptr<const android::mediametrics::Item> &) {
+            ++trackActions;
+          }));
+
+  auto trackItem = std::make_shared<mediametrics::Item>("audio.track.12");
+  (*trackItem).set("event", "start");
+  auto threadItem = std::make_shared<mediametrics::Item>("audio.thread.12");
+  (*threadItem).set("event", "start");
+
+  ASSERT_EQ((size_t)1, analyticsActions.getActionsForItem(trackItem).size());
+  ASSERT_EQ((size_t)0, analyticsActions.getActionsForItem(threadItem).size());
+
+  // An action added after a query is found as well.
+  analyticsActions.addAction(
+      "audio.thread.12.event",
+      std::string("start"),
+      std::make_shared<mediametrics::AnalyticsActions::Function>(
+          [&](const std::shared_ptr<const android::mediametrics::Item> &) {
+            ++threadActions;
+          }));
+  for (const auto& action : analyticsActions.getActionsForItem(threadItem)) {
+    action->operator()(threadItem);
+  }
+  for (const auto& action : analyticsActions.getActionsForItem(trackItem)) {
+    action->operator()(trackItem);
+  }
+  ASSERT_EQ(1, trackActions);
+  ASSERT_EQ(1, threadActions);
+
+  // A key shorter than a trigger, with the rest of the trigger as property name.
+  auto shortItem = std::make_shared<mediametrics::Item>("audio.thread");
+  (*shortItem).set("12.event", "start");
+  ASSERT_EQ((size_t)1, analyticsActions.getActionsForItem(shortItem).size());
+}
+
 TEST(mediametrics_tests, audio_analytics_permission) {
   auto item = std::make_shared<mediametrics::Item>("audio.1");
   (*item).set("one", (int32_t)1)
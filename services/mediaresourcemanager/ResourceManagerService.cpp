@@ -1034,17 +1034,30 @@ bool ResourceManagerService::getAllClients_l(int callingPid, MediaResource::Type
         Vector<std::shared_ptr<IResourceManagerClient>> *clients) {
     Vector<std::shared_ptr<IResourceManagerClient>> temp;
     PidUidVector tempIdList;
+    // The priorities are looked up from the process info service, so query the
+    // calling process once, and each owning process once rather than per client.
+    int callingPriority = -1;
+    bool callingPriorityKnown = false;
 
     for (size_t i = 0; i < mMap.size(); ++i) {
         ResourceInfos &infos = mMap.editValueAt(i);
+        bool priorityChecked = false;
         for (size_t j = 0; j < infos.size(); ++j) {
             if (hasResourceType(type, subType, infos[j].resources)) {
-                if (!isCallingPriorityHigher_l(callingPid, mMap.keyAt(i))) {
-                    // some higher/equal priority process owns the resource,
-                    // this request can't be fulfilled.
-                    ALOGE("getAllClients_l: can't reclaim resource %s from pid %d",
-                            asString(type), mMap.keyAt(i));
-                    return false;
+                if (!priorityChecked) {
+                    if (!callingPriorityKnown) {
+                        callingPriorityKnown = getPriority_l(callingPid, &callingPriority);
+                    }
+                    int priority;
+                    if (!callingPriorityKnown || !getPriority_l(mMap.keyAt(i), &priority)
+                            || callingPriority >= priority) {
+                        // some higher/equal priority process owns the resource,
+                        // this request can't be fulfilled.
+                        ALOGE("getAllClients_l: can't reclaim resource %s from pid %d",
+                                asString(type), mMap.keyAt(i));
+                        return false;
+                    }
+                    priorityChecked = true;
                 }
                 temp.push_back(infos[j].client);
                 tempIdList.emplace_back(mMap.keyAt(i), infos[j].uid);
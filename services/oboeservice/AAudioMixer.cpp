@@ -20,6 +20,7 @@
 
 #define ATRACE_TAG ATRACE_TAG_AUDIO
 
+#include <algorithm>
 #include <cstring>
 #include <utils/Trace.h>
 
@@ -42,11 +43,12 @@ void AAudioMixer::allocate(int32_t samplesPerFrame, int32_t framesPerBurst) {
 }
 
 void AAudioMixer::clear() {
-    memset(mOutputBuffer.get(), 0, mBufferSizeInBytes);
+    mFramesValid = 0;
+    mStreamsMixed = 0;
 }
 
-int32_t AAudioMixer::mix(
-        int streamIndex, const std::shared_ptr<FifoBuffer>& fifo, bool allowUnderflow) {
+int32_t AAudioMixer::mix(int streamIndex, const std::shared_ptr<FifoBuffer>& fifo,
+                         bool allowUnderflow, float *gain, float targetGain) {
     WrappingBuffer wrappingBuffer;
     float *destination = mOutputBuffer.get();
 
@@ -64,7 +66,7 @@ int32_t AAudioMixer::mix(
         ATRACE_INT(rdyText, fullFrames);
     }
 #else /* MIXER_ATRACE_ENABLED */
-    (void) trackIndex;
+    (void) streamIndex;
 #endif /* AAUDIO_MIXER_ATRACE_ENABLED */
 
     // If allowUnderflow then always advance by one burst even if we do not have the data.
@@ -78,9 +80,17 @@ int32_t AAudioMixer::mix(
         framesDesired = fullFrames; // just use what is available then stop
     }
 
+    // A silent stream only needs its read index advanced.
+    const float startGain = *gain;
+    const bool silent = startGain == 0.0f && targetGain == 0.0f;
+    // Ramp linearly over the data that is mixed, reaching the target at the end.
+    const float gainIncrement = framesDesired > 0
+            ? (targetGain - startGain) / framesDesired : 0.0f;
+
     // Mix data in one or two parts.
     int partIndex = 0;
     int32_t framesLeft = framesDesired;
+    int32_t framesMixed = 0;
     while (framesLeft > 0 && partIndex < WrappingBuffer::SIZE) {
         fifo_frames_t framesToMixFromPart = framesLeft;
         fifo_frames_t framesAvailableFromPart = wrappingBuffer.numFrames[partIndex];
@@ -88,14 +98,23 @@ int32_t AAudioMixer::mix(
             if (framesToMixFromPart > framesAvailableFromPart) {
                 framesToMixFromPart = framesAvailableFromPart;
             }
-            mixPart(destination, (float *)wrappingBuffer.data[partIndex],
-                    framesToMixFromPart);
+            if (!silent) {
+                mixPart(destination, (const float *)wrappingBuffer.data[partIndex],
+                        framesToMixFromPart, startGain + gainIncrement * framesMixed,
+                        gainIncrement, mFramesValid - framesMixed);
+            }
 
             destination += framesToMixFromPart * mSamplesPerFrame;
+            framesMixed += framesToMixFromPart;
             framesLeft -= framesToMixFromPart;
         }
         partIndex++;
     }
+    if (!silent && framesMixed > 0) {
+        mFramesValid = std::max(mFramesValid, framesMixed);
+        mStreamsMixed++;
+    }
+    *gain = targetGain;
     fifo->advanceReadIndex(framesDesired);
 
 #if AAUDIO_MIXER_ATRACE_ENABLED
@@ -105,14 +124,52 @@ int32_t AAudioMixer::mix(
     return (framesDesired - framesLeft); // framesRead
 }
 
-void AAudioMixer::mixPart(float *destination, float *source, int32_t numFrames) {
-    int32_t numSamples = numFrames * mSamplesPerFrame;
-    // TODO maybe optimize using SIMD
-    for (int sampleIndex = 0; sampleIndex < numSamples; sampleIndex++) {
-        *destination++ += *source++;
+// Frames before framesValid are accumulated into the destination, later frames are stored.
+void AAudioMixer::mixPart(float *destination, const float *source, int32_t numFrames,
+                          float gain, float gainIncrement, int32_t framesValid) {
+    float * __restrict dst = destination;
+    const float * __restrict src = source;
+    const int32_t channelCount = mSamplesPerFrame;
+    const int32_t framesToAccumulate = std::clamp(framesValid, 0, numFrames);
+    const int32_t accumulateSamples = framesToAccumulate * channelCount;
+    const int32_t numSamples = numFrames * channelCount;
+
+    if (gainIncrement == 0.0f) {
+        // These loops have no dependencies so the compiler vectorizes them.
+        if (gain == 1.0f) {
+            for (int32_t i = 0; i < accumulateSamples; i++) {
+                dst[i] += src[i];
+            }
+            memcpy(&dst[accumulateSamples], &src[accumulateSamples],
+                   (numSamples - accumulateSamples) * sizeof(float));
+        } else {
+            for (int32_t i = 0; i < accumulateSamples; i++) {
+                dst[i] += src[i] * gain;
+            }
+            for (int32_t i = accumulateSamples; i < numSamples; i++) {
+                dst[i] = src[i] * gain;
+            }
+        }
+        return;
+    }
+
+    for (int32_t frame = 0; frame < numFrames; frame++) {
+        const bool accumulate = frame < framesToAccumulate;
+        for (int32_t channel = 0; channel < channelCount; channel++) {
+            const float sample = *src++ * gain;
+            *dst = accumulate ? *dst + sample : sample;
+            dst++;
+        }
+        gain += gainIncrement;
     }
 }
 
 float *AAudioMixer::getOutputBuffer() {
+    // Silence the part of the burst that no stream wrote.
+    if (mFramesValid < mFramesPerBurst) {
+        memset(&mOutputBuffer[mFramesValid * mSamplesPerFrame], 0,
+               mBufferSizeInBytes - mFramesValid * mSamplesPerFrame * sizeof(float));
+        mFramesValid = mFramesPerBurst;
+    }
     return mOutputBuffer.get();
 }
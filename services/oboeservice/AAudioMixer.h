@@ -28,6 +28,10 @@ public:
 
     void allocate(int32_t samplesPerFrame, int32_t framesPerBurst);
 
+    /**
+     * Start a new burst. The output buffer is not cleared until getOutputBuffer()
+     * so the first stream mixed can be copied rather than accumulated.
+     */
     void clear();
 
     /**
@@ -35,23 +39,39 @@ public:
      * @param streamIndex for marking stream variables in systrace
      * @param fifo to read from
      * @param allowUnderflow if true then allow mixer to advance read index past the write index
+     * @param gain current gain of this stream, ramped towards targetGain over the burst
+     * @param targetGain gain to reach at the end of the burst
      * @return frames read from this stream
      */
     int32_t mix(int streamIndex,
                 const std::shared_ptr<android::FifoBuffer>& fifo,
-                bool allowUnderflow);
+                bool allowUnderflow,
+                float *gain,
+                float targetGain);
 
+    /**
+     * @return the mixed burst, zero filled past the data of the streams
+     */
     float *getOutputBuffer();
 
     int32_t getFramesPerBurst() const { return mFramesPerBurst; }
 
+    /**
+     * @return number of streams that contributed to the last burst, excluding silent ones
+     */
+    int32_t getStreamsMixed() const { return mStreamsMixed; }
+
 private:
-    void mixPart(float *destination, float *source, int32_t numFrames);
+    void mixPart(float *destination, const float *source, int32_t numFrames,
+                 float gain, float gainIncrement, int32_t framesValid);
 
     std::unique_ptr<float[]> mOutputBuffer;
     int32_t  mSamplesPerFrame = 0;
     int32_t  mFramesPerBurst = 0;
     int32_t  mBufferSizeInBytes = 0;
+    // Frames at the start of mOutputBuffer that hold data for the current burst.
+    int32_t  mFramesValid = 0;
+    int32_t  mStreamsMixed = 0;
 };
 
 #endif //AAUDIO_AAUDIO_MIXER_H
@@ -75,11 +75,15 @@ void *AAudioServiceEndpointCapture::callbackLoop() {
         }
 
         // Distribute data to each active stream.
+        // Every client of a shared endpoint uses the endpoint's format, any conversion is done
+        // on the client side, so this is a single burst-sized memcpy into each client FIFO.
+        // mRegisteredStreams holds a reference to each stream while the lock is held, so
+        // don't take another one per stream per burst.
         { // brackets are for lock_guard
             std::lock_guard <std::mutex> lock(mLockStreams);
             for (const auto& clientStream : mRegisteredStreams) {
                 if (clientStream->isRunning() && !clientStream->isSuspended()) {
-                    sp<AAudioServiceStreamShared> streamShared =
+                    auto streamShared =
                             static_cast<AAudioServiceStreamShared *>(clientStream.get());
                     streamShared->writeDataIfRoom(mmapFramesRead,
                                                   mDistributionBuffer.get(),
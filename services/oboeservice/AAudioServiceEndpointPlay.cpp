@@ -72,6 +72,7 @@ void *AAudioServiceEndpointPlay::callbackLoop() {
     // result might be a frame count
     while (mCallbackEnabled.load() && getStreamInternal()->isActive() && (result >= 0)) {
         // Mix data from each active stream.
+        const int64_t mixStartNanos = AudioClock::getNanoseconds();
         mMixer.clear();
 
         { // brackets are for lock_guard
@@ -112,7 +113,9 @@ void *AAudioServiceEndpointPlay::callbackLoop() {
                         int64_t positionOffset = mmapFramesWritten - clientFramesRead;
                         streamShared->setTimestampPositionOffset(positionOffset);
 
-                        int32_t framesMixed = mMixer.mix(index, fifo, allowUnderflow);
+                        int32_t framesMixed = mMixer.mix(index, fifo, allowUnderflow,
+                                streamShared->getMixerGain(),
+                                streamShared->getMixerTargetGain());
 
                         if (streamShared->isFlowing()) {
                             // Consider it an underflow if we got less than a burst
@@ -142,9 +145,11 @@ void *AAudioServiceEndpointPlay::callbackLoop() {
             }
         }
 
+        float *mixBuffer = mMixer.getOutputBuffer();
+        recordMixTime(AudioClock::getNanoseconds() - mixStartNanos, mMixer.getStreamsMixed());
+
         // Write mixer output to stream using a blocking write.
-        result = getStreamInternal()->write(mMixer.getOutputBuffer(),
-                                            getFramesPerBurst(), timeoutNanos);
+        result = getStreamInternal()->write(mixBuffer, getFramesPerBurst(), timeoutNanos);
         if (result == AAUDIO_ERROR_DISCONNECTED) {
             ALOGD("%s() write() returned AAUDIO_ERROR_DISCONNECTED", __func__);
             AAudioServiceEndpointShared::handleDisconnectRegisteredStreamsAsync();
@@ -53,11 +53,28 @@ std::string AAudioServiceEndpointShared::dump() const {
     result << ", XRuns = " << mStreamInternal->getXRunCount();
     result << "\n";
     result << "    Running Stream Count: " << mRunningStreamCount << "\n";
+    const int64_t mixBurstCount = mMixBurstCount.load();
+    if (mixBurstCount > 0) {
+        result << "    Mix Cost: mean = " << (mMixTotalNanos.load() / mixBurstCount / 1000)
+               << " usec, max = " << (mMixMaxNanos.load() / 1000)
+               << " usec, bursts = " << mixBurstCount
+               << ", streams mixed = " << mMixStreamCount << "\n";
+    }
 
     result << AAudioServiceEndpoint::dump();
     return result.str();
 }
 
+void AAudioServiceEndpointShared::recordMixTime(int64_t nanos, int32_t streamsMixed) {
+    // Only the sharing thread writes, so load and store are sufficient.
+    mMixBurstCount.store(mMixBurstCount.load() + 1);
+    mMixTotalNanos.store(mMixTotalNanos.load() + nanos);
+    if (nanos > mMixMaxNanos.load()) {
+        mMixMaxNanos.store(nanos);
+    }
+    mMixStreamCount.store(streamsMixed);
+}
+
 // Share an AudioStreamInternal.
 aaudio_result_t AAudioServiceEndpointShared::open(const aaudio::AAudioStreamRequest &request) {
     aaudio_result_t result = AAUDIO_OK;
@@ -71,12 +71,21 @@ protected:
 
     void                     handleDisconnectRegisteredStreamsAsync();
 
+    // Called by the sharing thread with the time taken to mix one burst.
+    void                     recordMixTime(int64_t nanos, int32_t streamsMixed);
+
     // An MMAP stream that is shared by multiple clients.
     android::sp<AudioStreamInternal> mStreamInternal;
 
     std::atomic<bool>        mCallbackEnabled{false};
 
     std::atomic<int>         mRunningStreamCount{0};
+
+    // Mix cost, written by the sharing thread and read by dump().
+    std::atomic<int64_t>     mMixBurstCount{0};
+    std::atomic<int64_t>     mMixTotalNanos{0};
+    std::atomic<int64_t>     mMixMaxNanos{0};
+    std::atomic<int32_t>     mMixStreamCount{0};
 };
 
 } // namespace aaudio
@@ -80,6 +80,23 @@ public:
         return mXRunCount.load();
     }
 
+    /**
+     * Set the gain applied by the endpoint mixer to this stream.
+     * The mixer ramps to the new gain over one burst.
+     */
+    void setMixerTargetGain(float gain) {
+        mMixerTargetGain.store(gain);
+    }
+
+    float getMixerTargetGain() const {
+        return mMixerTargetGain.load();
+    }
+
+    // Gain reached by the mixer at the end of the last burst, only used by the mixer thread.
+    float *getMixerGain() {
+        return &mMixerGain;
+    }
+
     const char *getTypeText() const override { return "Shared"; }
 
     // This is public so that the thread safety annotation, GUARDED_BY(),
@@ -111,6 +128,8 @@ private:
 
     std::atomic<int64_t>     mTimestampPositionOffset;
     std::atomic<int32_t>     mXRunCount;
+    std::atomic<float>       mMixerTargetGain{1.0f};
+    float                    mMixerGain = 1.0f;
 
 };
 
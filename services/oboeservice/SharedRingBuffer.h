@@ -30,9 +30,13 @@
 namespace aaudio {
 
 // Determine the placement of the counters and data in shared memory.
+// The read counter is written by the consumer and the write counter by the producer, which
+// usually run on different cores, so give each counter its own cache line, and keep both off
+// the cache lines of the data. The offsets are passed to the client in the parcelable.
+#define SHARED_RINGBUFFER_CACHE_LINE_SIZE   64
 #define SHARED_RINGBUFFER_READ_OFFSET   0
-#define SHARED_RINGBUFFER_WRITE_OFFSET  sizeof(fifo_counter_t)
-#define SHARED_RINGBUFFER_DATA_OFFSET   (SHARED_RINGBUFFER_WRITE_OFFSET + sizeof(fifo_counter_t))
+#define SHARED_RINGBUFFER_WRITE_OFFSET  SHARED_RINGBUFFER_CACHE_LINE_SIZE
+#define SHARED_RINGBUFFER_DATA_OFFSET   (2 * SHARED_RINGBUFFER_CACHE_LINE_SIZE)
 
 /**
  * Atomic FIFO that uses shared memory.